@@ -42,7 +42,8 @@ struct ObQueryFlag {
 #define OBSF_BIT_IGNORE_TRANS_STAT 1
 #define OBSF_BIT_IS_LARGE_QUERY 1
 #define OBSF_BIT_IS_SSTABLE_CUT 1
-#define OBSF_BIT_RESERVED 34
+#define OBSF_BIT_IS_BULK_READ 1
+#define OBSF_BIT_RESERVED 33
 
   static const uint64_t OBSF_MASK_SCAN_ORDER = (0x1UL << OBSF_BIT_SCAN_ORDER) - 1;
   static const uint64_t OBSF_MASK_DAILY_MERGE = (0x1UL << OBSF_BIT_DAILY_MERGE) - 1;
@@ -65,6 +66,7 @@ struct ObQueryFlag {
   static const uint64_t OBSF_MASK_IGNORE_TRANS_STAT = (0x1UL << OBSF_BIT_IGNORE_TRANS_STAT) - 1;
   static const uint64_t OBSF_MASK_IS_LARGE_QUERY = (0x1UL << OBSF_BIT_IS_LARGE_QUERY) - 1;
   static const uint64_t OBSF_MASK_IS_SSTABLE_CUT = (0x1UL << OBSF_BIT_IS_SSTABLE_CUT) - 1;
+  static const uint64_t OBSF_MASK_IS_BULK_READ = (0x1UL << OBSF_BIT_IS_BULK_READ) - 1;
 
   enum ScanOrder {
     ImplementedOrder = 0,
@@ -113,6 +115,7 @@ struct ObQueryFlag {
       uint64_t ignore_trans_stat_ : OBSF_BIT_IGNORE_TRANS_STAT;
       uint64_t is_large_query_ : OBSF_BIT_IS_LARGE_QUERY;
       uint64_t is_sstable_cut_ : OBSF_BIT_IS_SSTABLE_CUT;  // 0:sstable no need cut, 1: sstable need cut
+      uint64_t is_bulk_read_ : OBSF_BIT_IS_BULK_READ;      // 0: normal read, 1: read once, like large scan
       uint64_t reserved_ : OBSF_BIT_RESERVED;
     };
   };
@@ -232,6 +235,13 @@ struct ObQueryFlag {
   {
     return is_large_query_;
   }
+  // data read by bulk reads is unlikely to be read again, it is cached in a way that
+  // can not evict the working set of normal queries.
+  // Only set by scans, merges keep caching blocks as before
+  inline bool is_bulk_read() const
+  {
+    return is_bulk_read_;
+  }
   inline void set_not_use_row_cache()
   {
     use_row_cache_ = DoNotUseCache;
@@ -316,7 +326,7 @@ struct ObQueryFlag {
       use_bloomfilter_cache_, "multi_version_minor_merge", multi_version_minor_merge_, "is_need_feedback",
       is_need_feedback_, "use_fuse_row_cache", use_fuse_row_cache_, "use_fast_agg", use_fast_agg_,
       "iter_uncommitted_row", iter_uncommitted_row_, "ignore_trans_stat", ignore_trans_stat_, "is_large_query",
-      is_large_query_, "is_sstable_cut", is_sstable_cut_, "reserved", reserved_);
+      is_large_query_, "is_sstable_cut", is_sstable_cut_, "is_bulk_read", is_bulk_read_, "reserved", reserved_);
   OB_UNIS_VERSION(1);
 };
 
@@ -21,6 +21,7 @@ const char* ObStoreFormat::row_store_name[MAX_ROW_STORE] = {
     "flat_row_store",
     "reserved_row_store",
     "sparse_row_store",
+    "encoding_row_store",
 };
 
 const ObStoreFormatItem ObStoreFormat::store_format_items[OB_STORE_FORMAT_MAX] = {
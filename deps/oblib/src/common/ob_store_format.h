@@ -20,7 +20,14 @@
 namespace oceanbase {
 namespace common {
 
-enum ObRowStoreType { FLAT_ROW_STORE = 0, RESERVED_ROW_STORE = 1, SPARSE_ROW_STORE = 2, MAX_ROW_STORE };
+// ENCODING_ROW_STORE is only chosen by major merge for blocks of sstable, it is never set in schema
+enum ObRowStoreType {
+  FLAT_ROW_STORE = 0,
+  RESERVED_ROW_STORE = 1,
+  SPARSE_ROW_STORE = 2,
+  ENCODING_ROW_STORE = 3,
+  MAX_ROW_STORE
+};
 
 enum ObStoreFormatType {
   OB_STORE_FORMAT_INVALID = 0,
@@ -61,6 +68,10 @@ public:
   {
     return type == FLAT_ROW_STORE || type == SPARSE_ROW_STORE;
   }
+  static inline bool is_block_row_store_type_valid(const ObRowStoreType type)
+  {
+    return is_row_store_type_valid(type) || type == ENCODING_ROW_STORE;
+  }
   static inline const char* get_row_store_name(const ObRowStoreType type)
   {
     return is_row_store_type_valid(type) ? row_store_name[type] : NULL;
@@ -223,6 +223,21 @@ public:
   {
     return key_.compare_prefix(rhs.key_, cmp);
   }
+  // Order preserving normalization of a rowkey column: if the normalized values of two objs of a column
+  // are both valid and differ, the objs compare as the normalized values, otherwise the objs need to be
+  // compared. Only non-negative integers (signed or unsigned, compared by value across types) are
+  // normalized, the others are NO_NORMALIZED_VALUE.
+  static OB_INLINE uint64_t get_normalized_value(const ObObj& obj)
+  {
+    uint64_t value = NO_NORMALIZED_VALUE;
+    const ObObjTypeClass tc = obj.get_type_class();
+    if (ObIntTC == tc && obj.get_int() >= 0) {
+      value = static_cast<uint64_t>(obj.get_int()) + 1;
+    } else if (ObUIntTC == tc && obj.get_uint64() < static_cast<uint64_t>(INT64_MAX)) {
+      value = obj.get_uint64() + 1;
+    }
+    return value;
+  }
 
 public:
   inline bool operator==(const ObStoreRowkey& rhs) const
@@ -272,6 +287,7 @@ public:
   static ObObj MIN_OBJECT;
   static ObObj MAX_OBJECT;
   static ObStoreRowkey MIN_STORE_ROWKEY;
+  static const uint64_t NO_NORMALIZED_VALUE = 0;
   static ObStoreRowkey MAX_STORE_ROWKEY;
 
 private:
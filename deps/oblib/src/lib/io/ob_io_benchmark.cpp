@@ -925,6 +925,87 @@ int ObIOBenchmark::find_getevent_thread_cnt(
   return ret;
 }
 
+int ObIOBenchmark::compare_io_backends(ObIORunner& runner, const ObDiskFd& fd, const int thread_cnt)
+{
+  int ret = OB_SUCCESS;
+  int tmp_ret = OB_SUCCESS;
+  const ObIOConfig origin_conf = ObIOManager::get_instance().get_io_config();
+  ObIOBenchResult results[IO_BACKEND_MAX];
+  double cpu_us_per_io[IO_BACKEND_MAX] = {0};
+  if (!ObIOUring::is_supported()) {
+    COMMON_LOG(INFO, "io_uring is not supported, skip comparing io backends");
+  } else {
+    for (int64_t i = 0; OB_SUCC(ret) && i < IO_BACKEND_MAX; ++i) {
+      const ObIOBackend backend = static_cast<ObIOBackend>(i);
+      if (OB_FAIL(run_with_io_backend(runner, fd, thread_cnt, backend, results[i], cpu_us_per_io[i]))) {
+        COMMON_LOG(WARN, "failed to run with io backend", K(ret), K(backend), K(thread_cnt));
+      }
+    }
+    // restore the disk with the configured backend
+    if (OB_SUCCESS != (tmp_ret = ObIOManager::get_instance().set_io_config(origin_conf))) {
+      COMMON_LOG(WARN, "failed to restore io config", K(tmp_ret), K(origin_conf));
+    } else if (OB_SUCCESS != (tmp_ret = ObIOManager::get_instance().delete_disk(fd))) {
+      COMMON_LOG(WARN, "failed to delete disk", K(tmp_ret), K(fd));
+    } else if (OB_SUCCESS != (tmp_ret = ObIOManager::get_instance().add_disk(fd))) {
+      COMMON_LOG(WARN, "failed to add disk", K(tmp_ret), K(fd));
+    }
+    if (OB_SUCC(ret)) {
+      COMMON_LOG(INFO,
+          "io backend comparison",
+          K(thread_cnt),
+          "libaio",
+          results[IO_BACKEND_LIBAIO],
+          "libaio_cpu_us_per_io",
+          cpu_us_per_io[IO_BACKEND_LIBAIO],
+          "io_uring",
+          results[IO_BACKEND_IO_URING],
+          "io_uring_cpu_us_per_io",
+          cpu_us_per_io[IO_BACKEND_IO_URING]);
+    }
+  }
+  return ret;
+}
+
+int ObIOBenchmark::run_with_io_backend(ObIORunner& runner, const ObDiskFd& fd, const int thread_cnt,
+    const ObIOBackend backend, ObIOBenchResult& result, double& cpu_us_per_io)
+{
+  int ret = OB_SUCCESS;
+  // 16KB random read, the size of a micro block
+  const ObIOWorkload workload = {16 * 1024, IO_MODE_READ, false};
+  ObIOConfig io_conf = ObIOManager::get_instance().get_io_config();
+  struct rusage begin_usage;
+  struct rusage end_usage;
+  io_conf.io_backend_ = backend;
+  cpu_us_per_io = 0;
+  // the channels choose their backend when the disk is added
+  if (OB_FAIL(ObIOManager::get_instance().set_io_config(io_conf))) {
+    COMMON_LOG(WARN, "failed to set io config", K(ret), K(io_conf));
+  } else if (OB_FAIL(ObIOManager::get_instance().delete_disk(fd))) {
+    COMMON_LOG(WARN, "failed to delete disk", K(ret), K(fd));
+  } else if (OB_FAIL(ObIOManager::get_instance().add_disk(fd))) {
+    COMMON_LOG(WARN, "failed to add disk", K(ret), K(fd));
+  } else if (0 != getrusage(RUSAGE_SELF, &begin_usage)) {
+    ret = OB_ERR_SYS;
+    COMMON_LOG(WARN, "failed to get rusage", K(ret), K(errno), KERRMSG);
+  } else if (OB_FAIL(runner.run_test(thread_cnt, workload, result))) {
+    COMMON_LOG(WARN, "failed to run test", K(ret), K(thread_cnt), K(workload));
+  } else if (0 != getrusage(RUSAGE_SELF, &end_usage)) {
+    ret = OB_ERR_SYS;
+    COMMON_LOG(WARN, "failed to get rusage", K(ret), K(errno), KERRMSG);
+  } else {
+    const int64_t cpu_us = (end_usage.ru_utime.tv_sec - begin_usage.ru_utime.tv_sec) * 1000000 +
+                           (end_usage.ru_utime.tv_usec - begin_usage.ru_utime.tv_usec) +
+                           (end_usage.ru_stime.tv_sec - begin_usage.ru_stime.tv_sec) * 1000000 +
+                           (end_usage.ru_stime.tv_usec - begin_usage.ru_stime.tv_usec);
+    // the runner reports iops over its fixed bench time
+    const double io_cnt = result.iops_ * static_cast<double>(ObIORunner::BENCH_TIME_US) / 1000000;
+    cpu_us_per_io = io_cnt > 0 ? static_cast<double>(cpu_us) / io_cnt : 0;
+    COMMON_LOG(INFO, "finish running with io backend", "backend", get_io_backend_str(backend), K(result),
+        K(cpu_us), K(cpu_us_per_io));
+  }
+  return ret;
+}
+
 int ObIOBenchmark::benchmark(const char* data_dir, const int64_t file_size, const int32_t max_thread_cnt)
 {
   int ret = OB_SUCCESS;
@@ -1004,6 +1085,9 @@ int ObIOBenchmark::benchmark(const char* data_dir, const int64_t file_size, cons
       if (OB_SUCC(ret)) {
         if (OB_FAIL(result_set_[result_set_idx_].print_to_file(conf_file_))) {
           COMMON_LOG(WARN, "failed to print result to file", K(ret));
+        } else if (OB_SUCCESS != (tmp_ret = compare_io_backends(runner, fd, min_size_thread_count))) {
+          // only for reference, the result file is not affected
+          COMMON_LOG(WARN, "failed to compare io backends", K(tmp_ret));
         }
       }
     }
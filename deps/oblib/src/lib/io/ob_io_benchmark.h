@@ -127,6 +127,9 @@ private:
 };
 
 class ObIORunner : lib::ThreadPool {
+public:
+  static const int64_t BENCH_TIME_US = 4 * 1000 * 1000;  // us
+
 public:
   ObIORunner();
   virtual ~ObIORunner();
@@ -145,7 +148,6 @@ private:
   DISALLOW_COPY_AND_ASSIGN(ObIORunner);
 
 private:
-  static const int64_t BENCH_TIME_US = 4 * 1000 * 1000;  // us
   static const int64_t CHUNK_ALIGN_SIZE = 2 * 1024 * 1024;
   static const int64_t WAIT_MS = 100;
 
@@ -233,6 +235,12 @@ private:
       ObIORunner& runner, const ObDiskFd& fd, const int thread_cnt, const int64_t iops, int64_t& submit_thread_cnt);
   int find_getevent_thread_cnt(
       const int64_t throughtput, const int64_t submit_thread_cnt, int64_t& getevent_thread_cnt);
+  /*
+   * run the micro block read workload on each io backend, report iops, rt and cpu cost per io
+   */
+  int compare_io_backends(ObIORunner& runner, const ObDiskFd& fd, const int thread_cnt);
+  int run_with_io_backend(ObIORunner& runner, const ObDiskFd& fd, const int thread_cnt, const ObIOBackend backend,
+      ObIOBenchResult& result, double& cpu_us_per_io);
   int init_dev_info(const char* data_dir);
   int get_io_stat(const int32_t dev_major, const int32_t dev_minor, ObBlockIOInfo& io_info);
   int get_partition_name(const int32_t dev_major, char* partition_name);
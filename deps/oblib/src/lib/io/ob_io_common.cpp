@@ -145,6 +145,29 @@ void align_offset_size(const int64_t offset, const int64_t size, int64_t& align_
   align_size = upper_align(size + offset - align_offset, DIO_READ_ALIGN_SIZE);
 }
 
+static const char* IO_BACKEND_STR[] = {"libaio", "io_uring"};
+
+const char* get_io_backend_str(const ObIOBackend backend)
+{
+  STATIC_ASSERT(ARRAYSIZEOF(IO_BACKEND_STR) == IO_BACKEND_MAX, "io backend str len is mismatch");
+  const char* str = "unknown";
+  if (backend >= IO_BACKEND_LIBAIO && backend < IO_BACKEND_MAX) {
+    str = IO_BACKEND_STR[backend];
+  }
+  return str;
+}
+
+ObIOBackend get_io_backend_from_str(const char* str)
+{
+  ObIOBackend backend = IO_BACKEND_MAX;
+  for (int64_t i = 0; NULL != str && i < IO_BACKEND_MAX && IO_BACKEND_MAX == backend; ++i) {
+    if (0 == STRCASECMP(str, IO_BACKEND_STR[i])) {
+      backend = static_cast<ObIOBackend>(i);
+    }
+  }
+  return backend;
+}
+
 /**
  * ------------------------------------ ObIOConfig ----------------------------------
  */
@@ -163,6 +186,8 @@ void ObIOConfig::set_default_value()
   callback_thread_count_ = DEFAULT_IO_CALLBACK_THREAD_COUNT;
   large_query_io_percent_ = DEFAULT_LARGE_QUERY_IO_PERCENT;
   data_storage_io_timeout_ms_ = DEFAULT_DATA_STORAGE_IO_TIMEOUT_MS;
+  io_backend_ = IO_BACKEND_LIBAIO;
+  enable_io_uring_sqpoll_ = false;
 }
 
 bool ObIOConfig::is_valid() const
@@ -174,7 +199,7 @@ bool ObIOConfig::is_valid() const
          data_storage_error_tolerance_time_ >= data_storage_warning_tolerance_time_ && disk_io_thread_count_ > 0 &&
          disk_io_thread_count_ <= ObDisk::MAX_DISK_CHANNEL_CNT * 2 && disk_io_thread_count_ % 2 == 0 &&
          callback_thread_count_ > 0 && large_query_io_percent_ >= 0 && large_query_io_percent_ <= 100 &&
-         data_storage_io_timeout_ms_ > 0;
+         data_storage_io_timeout_ms_ > 0 && io_backend_ >= IO_BACKEND_LIBAIO && io_backend_ < IO_BACKEND_MAX;
 }
 
 void ObIOConfig::reset()
@@ -191,6 +216,8 @@ void ObIOConfig::reset()
   callback_thread_count_ = 0;
   large_query_io_percent_ = 0;
   data_storage_io_timeout_ms_ = 0;
+  io_backend_ = IO_BACKEND_LIBAIO;
+  enable_io_uring_sqpoll_ = false;
 }
 
 /**
@@ -385,7 +412,8 @@ bool ObIOQueue::ObIORequestCmp::operator()(const ObIORequest* a, const ObIOReque
 /**
  * ------------------------------------- ObIOChannel ------------------------------------
  */
-ObIOChannel::ObIOChannel() : inited_(false), context_(), submit_cnt_(0), can_submit_request_(true)
+ObIOChannel::ObIOChannel()
+    : inited_(false), context_(), submit_cnt_(0), can_submit_request_(true), backend_(IO_BACKEND_LIBAIO), ring_()
 {}
 
 ObIOChannel::~ObIOChannel()
@@ -425,8 +453,36 @@ int ObIOChannel::init(const int32_t queue_depth)
   return ret;
 }
 
+int ObIOChannel::init_io_uring(
+    const bool enable_sqpoll, const int32_t fixed_fd, const struct iovec* fixed_bufs, const int64_t fixed_buf_cnt)
+{
+  int ret = OB_SUCCESS;
+  int tmp_ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!inited_)) {
+    ret = OB_NOT_INIT;
+    COMMON_LOG(WARN, "not init", K(ret));
+  } else if (IO_BACKEND_IO_URING == backend_) {
+    ret = OB_INIT_TWICE;
+    COMMON_LOG(WARN, "io uring has been inited", K(ret));
+  } else if (OB_FAIL(ring_.init(MAX_AIO_EVENT_CNT, enable_sqpoll))) {
+    COMMON_LOG(WARN, "fail to init io uring", K(ret), K(enable_sqpoll));
+  } else {
+    // registration only saves cpu, io still works without it
+    if (fixed_fd >= 0 && OB_SUCCESS != (tmp_ret = ring_.register_file(fixed_fd))) {
+      COMMON_LOG(WARN, "fail to register file to io uring", K(tmp_ret), K(fixed_fd));
+    }
+    if (fixed_buf_cnt > 0 && OB_SUCCESS != (tmp_ret = ring_.register_buffers(fixed_bufs, fixed_buf_cnt))) {
+      COMMON_LOG(WARN, "fail to register buffers to io uring", K(tmp_ret), K(fixed_buf_cnt));
+    }
+    backend_ = IO_BACKEND_IO_URING;
+  }
+  return ret;
+}
+
 void ObIOChannel::destroy()
 {
+  ring_.destroy();
+  backend_ = IO_BACKEND_LIBAIO;
   ob_io_destroy(context_);
   MEMSET(&context_, 0, sizeof(context_));
   submit_cnt_ = 0;
@@ -504,6 +560,32 @@ int ObIOChannel::dequeue_request(ObIORequest*& req)
   return ret;
 }
 
+int ObIOChannel::dequeue_requests(ObIORequest** reqs, const int64_t max_cnt, int64_t& req_cnt)
+{
+  int ret = OB_SUCCESS;
+  ObIORequest* req = NULL;
+  req_cnt = 0;
+  if (OB_ISNULL(reqs) || max_cnt <= 0) {
+    ret = OB_INVALID_ARGUMENT;
+    COMMON_LOG(WARN, "invalid argument", K(ret), KP(reqs), K(max_cnt));
+  } else if (OB_FAIL(dequeue_request(req))) {
+    // wait for the first request as usual
+  } else {
+    reqs[req_cnt++] = req;
+    ObThreadCondGuard cond_guard(queue_cond_);
+    if (OB_SUCCESS != cond_guard.get_ret()) {
+      COMMON_LOG(ERROR, "Fail to guard queue condition", "ret", cond_guard.get_ret());
+    } else {
+      // take whatever else is due without waiting
+      while (req_cnt < max_cnt && ATOMIC_LOAD(&submit_cnt_) + req_cnt < MAX_AIO_EVENT_CNT &&
+             OB_SUCCESS == queue_.pop(req)) {
+        reqs[req_cnt++] = req;
+      }
+    }
+  }
+  return ret;
+}
+
 int64_t ObIOChannel::get_pop_wait_timeout(const int64_t queue_deadline)
 {
   const int64_t current_time = ObTimeUtility::current_time();
@@ -570,6 +652,8 @@ void ObIOChannel::submit()
     if (OB_SUCC(ret) && !can_submit_request_) {
       clear_all_requests();
     }
+  } else if (IO_BACKEND_IO_URING == backend_) {
+    submit_batch();
   } else {
     if (OB_FAIL(dequeue_request(req))) {
       if (OB_EAGAIN == ret || OB_ENTRY_NOT_EXIST == ret) {
@@ -581,26 +665,58 @@ void ObIOChannel::submit()
       ret = OB_ERR_UNEXPECTED;
       COMMON_LOG(WARN, "req is null", K(ret));
     } else {
-      MasterHolder master_holder(req->master_);
-      DiskHolder disk_holder(req->get_disk());
-      ObCurTraceId::TraceId saved_trace_id = *ObCurTraceId::get_trace_id();
-      ObCurTraceId::set(req->master_->get_trace_id());
-      req->channel_ = this;
-      int sys_ret = 0;
-      if (OB_FAIL(inner_submit(*req, sys_ret))) {
-        if (OB_CANCELED != ret) {
-          COMMON_LOG(WARN, "fail to inner submit req", K(ret), K(sys_ret));
-        }
-        req->finish(ret, sys_ret);
-      } else {
-        req->get_disk()->inc_ref();  // safe only under disk holder
-      }
-      ObCurTraceId::set(saved_trace_id);
+      submit_request(*req, true /*need_flush*/);
+    }
+  }
+}
+
+void ObIOChannel::submit_batch()
+{
+  int ret = OB_SUCCESS;
+  ObIORequest* reqs[MAX_SUBMIT_BATCH_CNT];
+  int64_t req_cnt = 0;
+  int64_t submitted = 0;
+  if (OB_FAIL(dequeue_requests(reqs, MAX_SUBMIT_BATCH_CNT, req_cnt))) {
+    if (OB_EAGAIN == ret || OB_ENTRY_NOT_EXIST == ret) {
+      ret = OB_SUCCESS;
+    } else {
+      COMMON_LOG(WARN, "Fail to pop io requests from disk, ", K(ret));
+    }
+  }
+  for (int64_t i = 0; i < req_cnt; ++i) {
+    if (OB_ISNULL(reqs[i])) {
+      COMMON_LOG(WARN, "req is null", K(i), K(req_cnt));
+    } else {
+      submit_request(*reqs[i], false /*need_flush*/);
+    }
+  }
+  // one system call for the whole batch, it also resubmits what a former failed flush left in the ring
+  if (OB_FAIL(ring_.flush(submitted))) {
+    COMMON_LOG(WARN, "fail to flush io uring", K(ret), K(req_cnt));
+  }
+}
+
+void ObIOChannel::submit_request(ObIORequest& req, const bool need_flush)
+{
+  int ret = OB_SUCCESS;
+  MasterHolder master_holder(req.master_);
+  DiskHolder disk_holder(req.get_disk());
+  ObCurTraceId::TraceId saved_trace_id = *ObCurTraceId::get_trace_id();
+  ObCurTraceId::set(req.master_->get_trace_id());
+  req.channel_ = this;
+  int sys_ret = 0;
+  if (OB_FAIL(inner_submit(req, sys_ret, need_flush))) {
+    if (OB_CANCELED != ret) {
+      COMMON_LOG(WARN, "fail to inner submit req", K(ret), K(sys_ret));
     }
+    req.finish(ret, sys_ret);
+  } else {
+    req.get_disk()->inc_ref();  // safe only under disk holder
   }
+  ObCurTraceId::set(saved_trace_id);
 }
 
-int ObIOChannel::inner_submit(ObIORequest& req, int& sys_ret)
+int ObIOChannel::inner_submit(ObIORequest& req, int& sys_ret, const bool need_flush)
 {
   int ret = OB_SUCCESS;
 #ifdef ERRSIM
@@ -622,9 +738,21 @@ int ObIOChannel::inner_submit(ObIORequest& req, int& sys_ret)
       req.io_time_.os_submit_time_ = ObTimeUtility::current_time();
       ATOMIC_INC(&submit_cnt_);
 
-      struct iocb* iocbp = &(req.iocb_);
-      if (1 != (sys_ret = ob_io_submit(context_, 1, &iocbp))) {
-        ret = OB_IO_ERROR;
+      if (IO_BACKEND_IO_URING == backend_) {
+        const bool is_read = IO_CMD_PREAD == req.iocb_.aio_lio_opcode;
+        int64_t submitted = 0;
+        int tmp_ret = OB_SUCCESS;
+        if (OB_FAIL(ring_.prep_rw(is_read, req.fd_.fd_, req.io_buf_, req.io_size_, req.io_offset_, &req))) {
+          COMMON_LOG(WARN, "fail to prepare io uring request", K(ret));
+        } else if (need_flush && OB_SUCCESS != (tmp_ret = ring_.flush(submitted))) {
+          // the request is already in the ring and goes with the next flush of the submit thread
+          COMMON_LOG(WARN, "fail to flush io uring", K(tmp_ret));
+        }
+      } else {
+        struct iocb* iocbp = &(req.iocb_);
+        if (1 != (sys_ret = ob_io_submit(context_, 1, &iocbp))) {
+          ret = OB_IO_ERROR;
+        }
       }
 
       if (OB_FAIL(ret)) {
@@ -654,6 +782,8 @@ void ObIOChannel::get_events()
   if (OB_UNLIKELY(!inited_)) {
     ret = OB_NOT_INIT;
     COMMON_LOG(WARN, "The ObIOChannel has not been inited, ", K(ret));
+  } else if (IO_BACKEND_IO_URING == backend_) {
+    get_uring_events();
   } else {
     event_cnt = ob_io_getevents(context_, 1, MAX_AIO_EVENT_CNT, events, &timeout);
   }
@@ -667,40 +797,8 @@ void ObIOChannel::get_events()
         COMMON_LOG(WARN, "req is null", K(ret));
         continue;
       }
-      const int system_errno = -static_cast<int>(events[i].res);
-      const int32_t complete_size = static_cast<int32_t>(events[i].res);
-      const int32_t res2 = static_cast<int32_t>(events[i].res2);
-
-      req->io_time_.os_return_time_ = io_finish_time;
-      if (0 == res2 && req->io_size_ == complete_size) {  // io full complete
-        COMMON_LOG(DEBUG, "Success to get io event, ", K(*req), K(complete_size), K(res2));
-        finish_flying_req(*req, OB_SUCCESS, 0);
-      } else if (0 == res2 && complete_size > 0 && complete_size < req->io_size_ &&
-                 (0 == complete_size % DIO_READ_ALIGN_SIZE)) {  // io partial complete, retry the left part
-        COMMON_LOG(WARN, "Partial execute io request, ", K(*req), K(complete_size), K(res2));
-        req->io_buf_ = req->io_buf_ + complete_size;
-        req->io_size_ -= complete_size;
-        req->io_offset_ += complete_size;
-
-        if (IO_CMD_PREAD == req->iocb_.aio_lio_opcode) {
-          io_prep_pread(&req->iocb_, req->fd_.fd_, req->io_buf_, req->io_size_, req->io_offset_);
-        } else {
-          io_prep_pwrite(&req->iocb_, req->fd_.fd_, req->io_buf_, req->io_size_, req->io_offset_);
-        }
-        req->iocb_.data = req;
-
-        int sys_ret = 0;
-        if (OB_SUCC(inner_submit(*req, sys_ret))) {
-          --finish_cnt;
-        } else {
-          finish_flying_req(*req, OB_IO_ERROR, sys_ret);
-        }
-      } else {  // io failed
-        // first print error log
-        COMMON_LOG(ERROR, "Fail to execute io request, ", K(*req), K(complete_size), K(res2));
-        // then notify
-        finish_flying_req(*req, OB_IO_ERROR, system_errno);
-      }
+      handle_event(*req, io_finish_time, static_cast<int32_t>(events[i].res), static_cast<int32_t>(events[i].res2),
+          finish_cnt);
       ATOMIC_DEC(&submit_cnt_);
     }
   }
@@ -713,6 +811,71 @@ void ObIOChannel::get_events()
   }
 }
 
+void ObIOChannel::get_uring_events()
+{
+  int ret = OB_SUCCESS;
+  static __thread ObIOUringEvent events[MAX_AIO_EVENT_CNT];
+  int64_t event_cnt = 0;
+  int32_t finish_cnt = 0;
+  ObIORequest* req = NULL;
+  if (OB_FAIL(ring_.reap(events, MAX_AIO_EVENT_CNT, AIO_TIMEOUT_NS / 1000, event_cnt))) {
+    if (REACH_TIME_INTERVAL(10 * 1000 * 1000)) {
+      COMMON_LOG(ERROR, "Fail to get io uring events, ", K(ret));
+    }
+  } else if (event_cnt > 0) {
+    const int64_t io_finish_time = ObTimeUtility::current_time();
+    finish_cnt = static_cast<int32_t>(event_cnt);
+    for (int64_t i = 0; i < event_cnt; ++i) {
+      req = reinterpret_cast<ObIORequest*>(events[i].data_);
+      if (OB_ISNULL(req)) {
+        ret = OB_ERR_UNEXPECTED;
+        COMMON_LOG(WARN, "req is null", K(ret));
+        continue;
+      }
+      // io_uring reports failure as -errno in res, there is no res2
+      handle_event(*req, io_finish_time, events[i].res_, 0 /*res2*/, finish_cnt);
+      ATOMIC_DEC(&submit_cnt_);
+    }
+  }
+}
+
+void ObIOChannel::handle_event(ObIORequest& req, const int64_t io_finish_time, const int32_t complete_size,
+    const int32_t res2, int32_t& finish_cnt)
+{
+  int ret = OB_SUCCESS;
+  const int system_errno = -complete_size;
+  req.io_time_.os_return_time_ = io_finish_time;
+  if (0 == res2 && req.io_size_ == complete_size) {  // io full complete
+    COMMON_LOG(DEBUG, "Success to get io event, ", K(req), K(complete_size), K(res2));
+    finish_flying_req(req, OB_SUCCESS, 0);
+  } else if (0 == res2 && complete_size > 0 && complete_size < req.io_size_ &&
+             (0 == complete_size % DIO_READ_ALIGN_SIZE)) {  // io partial complete, retry the left part
+    COMMON_LOG(WARN, "Partial execute io request, ", K(req), K(complete_size), K(res2));
+    req.io_buf_ = req.io_buf_ + complete_size;
+    req.io_size_ -= complete_size;
+    req.io_offset_ += complete_size;
+
+    if (IO_CMD_PREAD == req.iocb_.aio_lio_opcode) {
+      io_prep_pread(&req.iocb_, req.fd_.fd_, req.io_buf_, req.io_size_, req.io_offset_);
+    } else {
+      io_prep_pwrite(&req.iocb_, req.fd_.fd_, req.io_buf_, req.io_size_, req.io_offset_);
+    }
+    req.iocb_.data = &req;
+
+    int sys_ret = 0;
+    if (OB_SUCC(inner_submit(req, sys_ret))) {
+      --finish_cnt;
+    } else {
+      finish_flying_req(req, OB_IO_ERROR, sys_ret);
+    }
+  } else {  // io failed
+    // first print error log
+    COMMON_LOG(ERROR, "Fail to execute io request, ", K(req), K(complete_size), K(res2));
+    // then notify
+    finish_flying_req(req, OB_IO_ERROR, system_errno);
+  }
+}
+
 void ObIOChannel::cancel(ObIORequest& req)
 {
   int ret = OB_SUCCESS;
@@ -720,7 +883,9 @@ void ObIOChannel::cancel(ObIORequest& req)
   int sys_ret = 0;
   bool is_cancel = false;
 
-  if (0 != req.io_time_.os_submit_time_ && 0 == req.io_time_.os_return_time_) {
+  if (IO_BACKEND_IO_URING == backend_) {
+    // flying io of io_uring is never canceled, it finishes through get_events
+  } else if (0 != req.io_time_.os_submit_time_ && 0 == req.io_time_.os_return_time_) {
     // Note: here if ob_io_cancel failed (possibly due to kernel not supporting io_cancel),
     // neither we or the get_events thread would call control.callback_->process(),
     // as we previously set need_callback to false.
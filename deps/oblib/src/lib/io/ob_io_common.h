@@ -33,6 +33,7 @@
 #include "lib/container/ob_array.h"
 #include "lib/container/ob_array_wrap.h"
 #include "lib/worker.h"
+#include "lib/io/ob_io_uring.h"
 
 namespace oceanbase {
 namespace common {
@@ -63,6 +64,16 @@ enum ObIOMode {
 
 enum ObIOCategory { USER_IO = 0, SYS_IO = 1, PREWARM_IO = 2, LARGE_QUERY_IO = 3, MAX_IO_CATEGORY };
 
+// how the disk channels submit requests to the kernel
+enum ObIOBackend {
+  IO_BACKEND_LIBAIO = 0,
+  IO_BACKEND_IO_URING = 1,
+  IO_BACKEND_MAX,
+};
+
+const char* get_io_backend_str(const ObIOBackend backend);
+ObIOBackend get_io_backend_from_str(const char* str);
+
 class ObIORequest;
 class ObDisk;
 
@@ -118,7 +129,7 @@ public:
   TO_STRING_KV(K_(sys_io_low_percent), K_(sys_io_high_percent), K_(user_iort_up_percent), K_(cpu_high_water_level),
       K_(write_failure_detect_interval), K_(read_failure_black_list_interval), K_(data_storage_warning_tolerance_time),
       K_(data_storage_error_tolerance_time), K_(disk_io_thread_count), K_(callback_thread_count),
-      K_(large_query_io_percent), K_(data_storage_io_timeout_ms));
+      K_(large_query_io_percent), K_(data_storage_io_timeout_ms), K_(io_backend), K_(enable_io_uring_sqpoll));
 
 public:
   // schedule related
@@ -136,6 +147,9 @@ public:
   int64_t callback_thread_count_;
   int64_t large_query_io_percent_;
   int64_t data_storage_io_timeout_ms_;
+  // channel related, only take effect on disks added afterwards
+  ObIOBackend io_backend_;
+  bool enable_io_uring_sqpoll_;
 };
 
 struct ObIODesc {
@@ -344,6 +358,9 @@ public:
   ObIOChannel();
   virtual ~ObIOChannel();
   int init(const int32_t queue_depth);
+  // switch a freshly inited channel to io_uring, the channel keeps using libaio on failure
+  int init_io_uring(const bool enable_sqpoll, const int32_t fixed_fd, const struct iovec* fixed_bufs,
+      const int64_t fixed_buf_cnt);
   void destroy();
   int enqueue_request(ObIORequest& req);
   int dequeue_request(ObIORequest*& req);
@@ -355,15 +372,26 @@ public:
   {
     can_submit_request_ = false;
   }
-  TO_STRING_KV(K_(inited), K_(submit_cnt), K_(can_submit_request));
+  ObIOBackend get_backend() const
+  {
+    return backend_;
+  }
+  TO_STRING_KV(K_(inited), K_(submit_cnt), K_(can_submit_request), K_(backend));
 
 private:
-  int inner_submit(ObIORequest& req, int& sys_ret);
+  int dequeue_requests(ObIORequest** reqs, const int64_t max_cnt, int64_t& req_cnt);
+  int inner_submit(ObIORequest& req, int& sys_ret, const bool need_flush = true);
+  void submit_request(ObIORequest& req, const bool need_flush);
+  void submit_batch();
+  void get_uring_events();
+  void handle_event(ObIORequest& req, const int64_t io_finish_time, const int32_t complete_size,
+      const int32_t res2, int32_t& finish_cnt);
   void finish_flying_req(ObIORequest& req, int io_ret, int system_errno);
   int64_t get_pop_wait_timeout(const int64_t queue_deadline);
 
 private:
   static const int32_t MAX_AIO_EVENT_CNT = 512;
+  static const int32_t MAX_SUBMIT_BATCH_CNT = 32;
   static const int64_t DISK_WAIT_PERIOD_US = 1000;
   static const int64_t AIO_TIMEOUT_NS = 1000L * 10000L;  // 10ms
   static const int64_t DEFAULT_SUBMIT_WAIT_US = 10 * 1000;
@@ -373,6 +401,8 @@ private:
   ObIOQueue queue_;
   ObThreadCond queue_cond_;
   bool can_submit_request_;
+  ObIOBackend backend_;
+  ObIOUring ring_;
 };
 
 struct ObIOInfo final {
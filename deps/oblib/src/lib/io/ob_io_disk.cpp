@@ -171,6 +171,12 @@ int ObDisk::init(
         COMMON_LOG(WARN, "fail to init channel", K(ret), K(i), K(queue_depth));
       }
     }
+    if (OB_SUCC(ret)) {
+      const ObIOConfig io_conf = OB_IO_MANAGER.get_io_config();
+      if (IO_BACKEND_IO_URING == io_conf.io_backend_) {
+        init_io_uring_channels(io_conf);
+      }
+    }
 
     if (OB_SUCC(ret)) {
       real_max_channel_cnt_ = !lib::is_mini_mode() ? MAX_DISK_CHANNEL_CNT : MINI_MODE_DISK_CHANNEL_CNT;
@@ -201,6 +207,31 @@ int ObDisk::init(
   return ret;
 }
 
+void ObDisk::init_io_uring_channels(const ObIOConfig& io_conf)
+{
+  int ret = OB_SUCCESS;
+  struct iovec fixed_bufs[ObIOUring::MAX_FIXED_BUFFER_CNT];
+  int64_t fixed_buf_cnt = 0;
+  if (!ObIOUring::is_supported()) {
+    ret = OB_NOT_SUPPORTED;
+    COMMON_LOG(WARN, "io_uring is not supported, use libaio instead", K(ret), K_(fd));
+  } else if (OB_FAIL(OB_IO_MANAGER.get_resource_manager().get_allocator()->get_fixed_buffers(
+                 fixed_bufs, ObIOUring::MAX_FIXED_BUFFER_CNT, ObIOUring::MAX_FIXED_BUFFER_SIZE, fixed_buf_cnt))) {
+    COMMON_LOG(WARN, "fail to get fixed buffers, io_uring works without them", K(ret));
+    fixed_buf_cnt = 0;
+    ret = OB_SUCCESS;
+  }
+  // a channel failing to switch keeps using libaio, so does the rest
+  for (int64_t i = 0; OB_SUCC(ret) && i < MAX_DISK_CHANNEL_CNT; ++i) {
+    if (OB_FAIL(channels_[i].init_io_uring(io_conf.enable_io_uring_sqpoll_, fd_.fd_, fixed_bufs, fixed_buf_cnt))) {
+      COMMON_LOG(WARN, "fail to init io_uring channel, use libaio instead", K(ret), K(i), K_(fd));
+    }
+  }
+  if (OB_SUCC(ret)) {
+    COMMON_LOG(INFO, "succeed to init io_uring channels", K_(fd), K(fixed_buf_cnt), K(io_conf));
+  }
+}
+
 void ObDisk::destroy()
 {
   TG_STOP(tg_id_);
@@ -155,6 +155,7 @@ public:
 
 private:
   int update_request_deadline(ObIORequest& req);
+  void init_io_uring_channels(const ObIOConfig& io_conf);
 
 private:
   bool inited_;
@@ -249,6 +249,38 @@ void ObIOAllocator::destroy()
   allocator_.destroy();
 }
 
+int ObIOAllocator::get_fixed_buffers(
+    struct iovec* iovs, const int64_t max_cnt, const int64_t max_size, int64_t& cnt) const
+{
+  int ret = OB_SUCCESS;
+  char* begins[2] = {NULL, NULL};
+  int64_t sizes[2] = {0, 0};
+  cnt = 0;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    COMMON_LOG(WARN, "io allocator is not inited", K(ret));
+  } else if (OB_ISNULL(iovs) || max_cnt <= 0 || max_size <= 0) {
+    ret = OB_INVALID_ARGUMENT;
+    COMMON_LOG(WARN, "invalid argument", K(ret), KP(iovs), K(max_cnt), K(max_size));
+  } else {
+    micro_pool_.get_memory_range(begins[0], sizes[0]);
+    macro_pool_.get_memory_range(begins[1], sizes[1]);
+    for (int64_t i = 0; OB_SUCC(ret) && i < ARRAYSIZEOF(begins); ++i) {
+      for (int64_t pos = 0; OB_SUCC(ret) && pos < sizes[i]; pos += max_size) {
+        if (cnt >= max_cnt) {
+          ret = OB_SIZE_OVERFLOW;
+          COMMON_LOG(WARN, "too many fixed buffers", K(ret), K(max_cnt), K(max_size), K(i), K(sizes[i]));
+        } else {
+          iovs[cnt].iov_base = begins[i] + pos;
+          iovs[cnt].iov_len = MIN(max_size, sizes[i] - pos);
+          ++cnt;
+        }
+      }
+    }
+  }
+  return ret;
+}
+
 void* ObIOAllocator::alloc(const int64_t size)
 {
   void* ret_buf = NULL;
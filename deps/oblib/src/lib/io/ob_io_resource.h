@@ -42,6 +42,12 @@ public:
   {
     return SIZE;
   }
+  // the pool is one contiguous piece of memory
+  void get_memory_range(char*& begin, int64_t& size) const
+  {
+    begin = begin_ptr_;
+    size = is_inited_ ? capacity_ * SIZE : 0;
+  }
 
 private:
   int init_bitmap(const int64_t block_count, ObIAllocator& allocator);
@@ -68,6 +74,8 @@ public:
   void* alloc(const int64_t size);
   void free(void* ptr);
   int64_t allocated();
+  // memory of the fixed size pools, split by @max_size, for io_uring to register
+  int get_fixed_buffers(struct iovec* iovs, const int64_t max_cnt, const int64_t max_size, int64_t& cnt) const;
 
 private:
   static const int64_t MICRO_POOL_BLOCK_SIZE = 16L * 1024L + 2 * DIO_READ_ALIGN_SIZE;
@@ -0,0 +1,455 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX COMMON
+#include "lib/io/ob_io_uring.h"
+#include <poll.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/eventfd.h>
+#ifdef OB_HAS_IO_URING
+#include <linux/io_uring.h>
+#endif
+#include "lib/oblog/ob_log.h"
+#include "lib/atomic/ob_atomic.h"
+
+#ifdef OB_HAS_IO_URING
+// the syscall numbers are shared by all architectures
+#ifndef __NR_io_uring_setup
+#define __NR_io_uring_setup 425
+#endif
+#ifndef __NR_io_uring_enter
+#define __NR_io_uring_enter 426
+#endif
+#ifndef __NR_io_uring_register
+#define __NR_io_uring_register 427
+#endif
+#endif
+
+namespace oceanbase {
+namespace common {
+
+#ifdef OB_HAS_IO_URING
+static int sys_io_uring_setup(const uint32_t entries, struct io_uring_params* params)
+{
+  return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+}
+
+static int sys_io_uring_enter(const int fd, const uint32_t to_submit, const uint32_t min_complete, const uint32_t flags)
+{
+  return static_cast<int>(::syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, NULL, 0));
+}
+
+static int sys_io_uring_register(const int fd, const uint32_t opcode, const void* arg, const uint32_t nr_args)
+{
+  return static_cast<int>(::syscall(__NR_io_uring_register, fd, opcode, arg, nr_args));
+}
+
+// IORING_OP_READ and IORING_OP_WRITE are available since 5.6, use FAST_POLL(5.7) to detect a new enough kernel
+static bool is_kernel_supported(const struct io_uring_params& params)
+{
+#ifdef IORING_FEAT_FAST_POLL
+  return 0 != (params.features & IORING_FEAT_FAST_POLL);
+#else
+  UNUSED(params);
+  return false;
+#endif
+}
+#endif
+
+ObIOUring::ObIOUring()
+    : is_inited_(false),
+      is_sqpoll_(false),
+      ring_fd_(-1),
+      event_fd_(-1),
+      sq_head_(NULL),
+      sq_tail_(NULL),
+      sq_flags_(NULL),
+      sq_array_(NULL),
+      sq_mask_(0),
+      sq_entries_(0),
+      sqe_tail_(0),
+      sqes_(NULL),
+      cq_head_(NULL),
+      cq_tail_(NULL),
+      cq_mask_(0),
+      cqes_(NULL),
+      sq_ring_ptr_(MAP_FAILED),
+      sq_ring_size_(0),
+      cq_ring_ptr_(MAP_FAILED),
+      cq_ring_size_(0),
+      sqes_size_(0),
+      fixed_buf_cnt_(0),
+      fixed_fd_(-1),
+      sq_lock_()
+{
+  MEMSET(fixed_bufs_, 0, sizeof(fixed_bufs_));
+}
+
+ObIOUring::~ObIOUring()
+{
+  destroy();
+}
+
+bool ObIOUring::is_supported()
+{
+  // -1: unknown, 0: not supported, 1: supported
+  static int8_t supported = -1;
+#ifdef OB_HAS_IO_URING
+  if (supported < 0) {
+    struct io_uring_params params;
+    MEMSET(&params, 0, sizeof(params));
+    const int fd = sys_io_uring_setup(2, &params);
+    if (fd < 0) {
+      ATOMIC_STORE(&supported, 0);
+    } else {
+      ATOMIC_STORE(&supported, is_kernel_supported(params) ? 1 : 0);
+      ::close(fd);
+    }
+  }
+#else
+  supported = 0;
+#endif
+  return 1 == ATOMIC_LOAD(&supported);
+}
+
+int ObIOUring::init(const uint32_t entries, const bool enable_sqpoll)
+{
+  int ret = OB_SUCCESS;
+#ifdef OB_HAS_IO_URING
+  static const uint32_t SQ_THREAD_IDLE_MS = 10;
+  struct io_uring_params params;
+  MEMSET(&params, 0, sizeof(params));
+  if (is_inited_) {
+    ret = OB_INIT_TWICE;
+    COMMON_LOG(WARN, "io uring has been inited", K(ret));
+  } else if (0 == entries) {
+    ret = OB_INVALID_ARGUMENT;
+    COMMON_LOG(WARN, "invalid argument", K(ret), K(entries));
+  } else {
+    if (enable_sqpoll) {
+      params.flags |= IORING_SETUP_SQPOLL;
+      params.sq_thread_idle = SQ_THREAD_IDLE_MS;
+    }
+    if ((ring_fd_ = sys_io_uring_setup(entries, &params)) < 0) {
+      ret = OB_IO_ERROR;
+      COMMON_LOG(WARN, "fail to setup io uring", K(ret), K(entries), K(enable_sqpoll), K(errno), KERRMSG);
+    } else if (!is_kernel_supported(params)) {
+      ret = OB_NOT_SUPPORTED;
+      COMMON_LOG(WARN, "io uring of this kernel is too old", K(ret), "features", params.features);
+    } else {
+      sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+      cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+      sqes_size_ = params.sq_entries * sizeof(struct io_uring_sqe);
+      const int prot = PROT_READ | PROT_WRITE;
+      const int flags = MAP_SHARED | MAP_POPULATE;
+      if (MAP_FAILED == (sq_ring_ptr_ = ::mmap(NULL, sq_ring_size_, prot, flags, ring_fd_, IORING_OFF_SQ_RING)) ||
+          MAP_FAILED == (cq_ring_ptr_ = ::mmap(NULL, cq_ring_size_, prot, flags, ring_fd_, IORING_OFF_CQ_RING)) ||
+          MAP_FAILED == (sqes_ = ::mmap(NULL, sqes_size_, prot, flags, ring_fd_, IORING_OFF_SQES))) {
+        ret = OB_IO_ERROR;
+        COMMON_LOG(WARN, "fail to mmap io uring", K(ret), K(errno), KERRMSG);
+      } else if ((event_fd_ = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK)) < 0) {
+        ret = OB_IO_ERROR;
+        COMMON_LOG(WARN, "fail to create eventfd", K(ret), K(errno), KERRMSG);
+      } else if (0 != sys_io_uring_register(ring_fd_, IORING_REGISTER_EVENTFD, &event_fd_, 1)) {
+        ret = OB_IO_ERROR;
+        COMMON_LOG(WARN, "fail to register eventfd", K(ret), K(errno), KERRMSG);
+      } else {
+        char* sq = static_cast<char*>(sq_ring_ptr_);
+        char* cq = static_cast<char*>(cq_ring_ptr_);
+        sq_head_ = reinterpret_cast<uint32_t*>(sq + params.sq_off.head);
+        sq_tail_ = reinterpret_cast<uint32_t*>(sq + params.sq_off.tail);
+        sq_flags_ = reinterpret_cast<uint32_t*>(sq + params.sq_off.flags);
+        sq_array_ = reinterpret_cast<uint32_t*>(sq + params.sq_off.array);
+        sq_mask_ = *reinterpret_cast<uint32_t*>(sq + params.sq_off.ring_mask);
+        sq_entries_ = params.sq_entries;
+        sqe_tail_ = *sq_tail_;
+        cq_head_ = reinterpret_cast<uint32_t*>(cq + params.cq_off.head);
+        cq_tail_ = reinterpret_cast<uint32_t*>(cq + params.cq_off.tail);
+        cq_mask_ = *reinterpret_cast<uint32_t*>(cq + params.cq_off.ring_mask);
+        cqes_ = cq + params.cq_off.cqes;
+        is_sqpoll_ = enable_sqpoll;
+        is_inited_ = true;
+        COMMON_LOG(INFO, "succeed to init io uring", K(*this), "cq_entries", params.cq_entries);
+      }
+    }
+  }
+  if (OB_FAIL(ret)) {
+    destroy();
+  }
+#else
+  UNUSED(entries);
+  UNUSED(enable_sqpoll);
+  ret = OB_NOT_SUPPORTED;
+  COMMON_LOG(WARN, "io uring is not supported by this build", K(ret));
+#endif
+  return ret;
+}
+
+void ObIOUring::destroy()
+{
+  if (MAP_FAILED != sq_ring_ptr_) {
+    ::munmap(sq_ring_ptr_, sq_ring_size_);
+  }
+  if (MAP_FAILED != cq_ring_ptr_) {
+    ::munmap(cq_ring_ptr_, cq_ring_size_);
+  }
+  if (NULL != sqes_ && MAP_FAILED != sqes_) {
+    ::munmap(sqes_, sqes_size_);
+  }
+  if (event_fd_ >= 0) {
+    ::close(event_fd_);
+  }
+  if (ring_fd_ >= 0) {
+    ::close(ring_fd_);
+  }
+  is_sqpoll_ = false;
+  ring_fd_ = -1;
+  event_fd_ = -1;
+  sq_head_ = NULL;
+  sq_tail_ = NULL;
+  sq_flags_ = NULL;
+  sq_array_ = NULL;
+  sq_mask_ = 0;
+  sq_entries_ = 0;
+  sqe_tail_ = 0;
+  sqes_ = NULL;
+  cq_head_ = NULL;
+  cq_tail_ = NULL;
+  cq_mask_ = 0;
+  cqes_ = NULL;
+  sq_ring_ptr_ = MAP_FAILED;
+  sq_ring_size_ = 0;
+  cq_ring_ptr_ = MAP_FAILED;
+  cq_ring_size_ = 0;
+  sqes_size_ = 0;
+  fixed_buf_cnt_ = 0;
+  fixed_fd_ = -1;
+  is_inited_ = false;
+}
+
+int ObIOUring::register_buffers(const struct iovec* iovs, const int64_t count)
+{
+  int ret = OB_SUCCESS;
+#ifdef OB_HAS_IO_URING
+  if (!is_inited_) {
+    ret = OB_NOT_INIT;
+    COMMON_LOG(WARN, "io uring is not inited", K(ret));
+  } else if (OB_ISNULL(iovs) || count <= 0 || count > MAX_FIXED_BUFFER_CNT) {
+    ret = OB_INVALID_ARGUMENT;
+    COMMON_LOG(WARN, "invalid argument", K(ret), KP(iovs), K(count));
+  } else if (fixed_buf_cnt_ > 0) {
+    ret = OB_INIT_TWICE;
+    COMMON_LOG(WARN, "fixed buffers have been registered", K(ret), K_(fixed_buf_cnt));
+  } else if (0 != sys_io_uring_register(ring_fd_, IORING_REGISTER_BUFFERS, iovs, static_cast<uint32_t>(count))) {
+    // usually limited by RLIMIT_MEMLOCK
+    ret = OB_IO_ERROR;
+    COMMON_LOG(WARN, "fail to register fixed buffers", K(ret), K(count), K(errno), KERRMSG);
+  } else {
+    MEMCPY(fixed_bufs_, iovs, count * sizeof(struct iovec));
+    fixed_buf_cnt_ = count;
+  }
+#else
+  UNUSED(iovs);
+  UNUSED(count);
+  ret = OB_NOT_SUPPORTED;
+#endif
+  return ret;
+}
+
+int ObIOUring::register_file(const int32_t fd)
+{
+  int ret = OB_SUCCESS;
+#ifdef OB_HAS_IO_URING
+  if (!is_inited_) {
+    ret = OB_NOT_INIT;
+    COMMON_LOG(WARN, "io uring is not inited", K(ret));
+  } else if (fd < 0) {
+    ret = OB_INVALID_ARGUMENT;
+    COMMON_LOG(WARN, "invalid argument", K(ret), K(fd));
+  } else if (fixed_fd_ >= 0) {
+    ret = OB_INIT_TWICE;
+    COMMON_LOG(WARN, "fixed file has been registered", K(ret), K_(fixed_fd));
+  } else if (0 != sys_io_uring_register(ring_fd_, IORING_REGISTER_FILES, &fd, 1)) {
+    ret = OB_IO_ERROR;
+    COMMON_LOG(WARN, "fail to register fixed file", K(ret), K(fd), K(errno), KERRMSG);
+  } else {
+    fixed_fd_ = fd;
+  }
+#else
+  UNUSED(fd);
+  ret = OB_NOT_SUPPORTED;
+#endif
+  return ret;
+}
+
+int64_t ObIOUring::find_fixed_buffer(const char* buf, const int32_t size) const
+{
+  int64_t idx = -1;
+  for (int64_t i = 0; idx < 0 && i < fixed_buf_cnt_; ++i) {
+    const char* begin = static_cast<const char*>(fixed_bufs_[i].iov_base);
+    if (buf >= begin && buf + size <= begin + fixed_bufs_[i].iov_len) {
+      idx = i;
+    }
+  }
+  return idx;
+}
+
+int ObIOUring::prep_rw(
+    const bool is_read, const int32_t fd, char* buf, const int32_t size, const int64_t offset, void* data)
+{
+  int ret = OB_SUCCESS;
+#ifdef OB_HAS_IO_URING
+  if (!is_inited_) {
+    ret = OB_NOT_INIT;
+    COMMON_LOG(WARN, "io uring is not inited", K(ret));
+  } else if (fd < 0 || OB_ISNULL(buf) || size <= 0 || offset < 0) {
+    ret = OB_INVALID_ARGUMENT;
+    COMMON_LOG(WARN, "invalid argument", K(ret), K(fd), KP(buf), K(size), K(offset));
+  } else {
+    ObSpinLockGuard guard(sq_lock_);
+    const uint32_t head = __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+    if (sqe_tail_ - head >= sq_entries_) {
+      ret = OB_EAGAIN;
+    } else {
+      const uint32_t idx = sqe_tail_ & sq_mask_;
+      struct io_uring_sqe* sqe = static_cast<struct io_uring_sqe*>(sqes_) + idx;
+      const int64_t buf_idx = find_fixed_buffer(buf, size);
+      MEMSET(sqe, 0, sizeof(*sqe));
+      if (buf_idx >= 0) {
+        sqe->opcode = is_read ? IORING_OP_READ_FIXED : IORING_OP_WRITE_FIXED;
+        sqe->buf_index = static_cast<uint16_t>(buf_idx);
+      } else {
+        sqe->opcode = is_read ? IORING_OP_READ : IORING_OP_WRITE;
+      }
+      if (fd == fixed_fd_) {
+        sqe->fd = 0;
+        sqe->flags |= IOSQE_FIXED_FILE;
+      } else {
+        sqe->fd = fd;
+      }
+      sqe->addr = reinterpret_cast<uint64_t>(buf);
+      sqe->len = static_cast<uint32_t>(size);
+      sqe->off = static_cast<uint64_t>(offset);
+      sqe->user_data = reinterpret_cast<uint64_t>(data);
+      sq_array_[idx] = idx;
+      ++sqe_tail_;
+    }
+  }
+#else
+  UNUSED(is_read);
+  UNUSED(fd);
+  UNUSED(buf);
+  UNUSED(size);
+  UNUSED(offset);
+  UNUSED(data);
+  ret = OB_NOT_SUPPORTED;
+#endif
+  return ret;
+}
+
+int ObIOUring::flush(int64_t& submitted)
+{
+  int ret = OB_SUCCESS;
+  submitted = 0;
+#ifdef OB_HAS_IO_URING
+  if (!is_inited_) {
+    ret = OB_NOT_INIT;
+    COMMON_LOG(WARN, "io uring is not inited", K(ret));
+  } else {
+    ObSpinLockGuard guard(sq_lock_);
+    const uint32_t published_tail = *sq_tail_;
+    if (published_tail != sqe_tail_) {
+      // release makes the sqes visible before the new tail
+      __atomic_store_n(sq_tail_, sqe_tail_, __ATOMIC_RELEASE);
+    }
+    if (is_sqpoll_) {
+      submitted = sqe_tail_ - published_tail;
+      if (0 != (__atomic_load_n(sq_flags_, __ATOMIC_ACQUIRE) & IORING_SQ_NEED_WAKEUP)) {
+        if (sys_io_uring_enter(ring_fd_, 0, 0, IORING_ENTER_SQ_WAKEUP) < 0) {
+          ret = OB_IO_ERROR;
+          COMMON_LOG(WARN, "fail to wake up sq thread", K(ret), K(errno), KERRMSG);
+        }
+      }
+    } else {
+      // also resubmit what the kernel did not consume last time
+      const uint32_t pending = sqe_tail_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+      int sys_ret = 0;
+      if (pending > 0) {
+        if ((sys_ret = sys_io_uring_enter(ring_fd_, pending, 0, 0)) < 0) {
+          ret = (EAGAIN == errno || EBUSY == errno || EINTR == errno) ? OB_EAGAIN : OB_IO_ERROR;
+          COMMON_LOG(WARN, "fail to submit io uring", K(ret), K(pending), K(errno), KERRMSG);
+        } else {
+          submitted = sys_ret;
+        }
+      }
+    }
+  }
+#else
+  ret = OB_NOT_SUPPORTED;
+#endif
+  return ret;
+}
+
+int ObIOUring::reap(ObIOUringEvent* events, const int64_t max_cnt, const int64_t timeout_us, int64_t& cnt)
+{
+  int ret = OB_SUCCESS;
+  cnt = 0;
+#ifdef OB_HAS_IO_URING
+  if (!is_inited_) {
+    ret = OB_NOT_INIT;
+    COMMON_LOG(WARN, "io uring is not inited", K(ret));
+  } else if (OB_ISNULL(events) || max_cnt <= 0 || timeout_us < 0) {
+    ret = OB_INVALID_ARGUMENT;
+    COMMON_LOG(WARN, "invalid argument", K(ret), KP(events), K(max_cnt), K(timeout_us));
+  } else {
+    uint32_t head = *cq_head_;
+    uint32_t tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+    if (head == tail && timeout_us > 0) {
+      // the eventfd is signaled for every completion, a stale signal only causes an empty round
+      struct pollfd pfd;
+      pfd.fd = event_fd_;
+      pfd.events = POLLIN;
+      pfd.revents = 0;
+      const int timeout_ms = static_cast<int>(MAX(timeout_us / 1000, 1));
+      if (::poll(&pfd, 1, timeout_ms) > 0) {
+        uint64_t value = 0;
+        if (sizeof(value) != ::read(event_fd_, &value, sizeof(value))) {
+          // drained by a former round, ignore
+        }
+      }
+      tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+    }
+    const struct io_uring_cqe* cqes = static_cast<const struct io_uring_cqe*>(cqes_);
+    while (head != tail && cnt < max_cnt) {
+      const struct io_uring_cqe& cqe = cqes[head & cq_mask_];
+      events[cnt].data_ = reinterpret_cast<void*>(cqe.user_data);
+      events[cnt].res_ = cqe.res;
+      ++head;
+      ++cnt;
+    }
+    if (cnt > 0) {
+      __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+    }
+  }
+#else
+  UNUSED(events);
+  UNUSED(max_cnt);
+  UNUSED(timeout_us);
+  ret = OB_NOT_SUPPORTED;
+#endif
+  return ret;
+}
+
+}  // namespace common
+}  // namespace oceanbase
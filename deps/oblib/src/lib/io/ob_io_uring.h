@@ -0,0 +1,103 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OB_IO_URING_H
+#define OB_IO_URING_H
+
+#include <sys/uio.h>
+#include "lib/utility/ob_print_utils.h"
+#include "lib/lock/ob_spin_lock.h"
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define OB_HAS_IO_URING 1
+#endif
+#endif
+
+namespace oceanbase {
+namespace common {
+
+struct ObIOUringEvent {
+  void* data_;
+  int32_t res_;  // transferred bytes, or -errno
+  TO_STRING_KV(KP_(data), K_(res));
+};
+
+// A minimal io_uring instance driven by raw system calls, liburing is not required.
+// The submission queue can be filled by multiple threads, the completion queue must be
+// reaped by a single thread. Kernel older than 5.7 is reported as not supported.
+class ObIOUring {
+public:
+  static const int64_t MAX_FIXED_BUFFER_CNT = 16;
+  static const int64_t MAX_FIXED_BUFFER_SIZE = 1L << 30;  // kernel limit of one registered buffer
+
+public:
+  ObIOUring();
+  ~ObIOUring();
+  static bool is_supported();
+  int init(const uint32_t entries, const bool enable_sqpoll);
+  void destroy();
+  // registered buffers and fd avoid pinning pages and looking up the file for each io
+  int register_buffers(const struct iovec* iovs, const int64_t count);
+  int register_file(const int32_t fd);
+  // queue one io, it is invisible to the kernel until flush()
+  int prep_rw(const bool is_read, const int32_t fd, char* buf, const int32_t size, const int64_t offset, void* data);
+  int flush(int64_t& submitted);
+  // wait at most @timeout_us if there is no completion yet
+  int reap(ObIOUringEvent* events, const int64_t max_cnt, const int64_t timeout_us, int64_t& cnt);
+  bool is_inited() const
+  {
+    return is_inited_;
+  }
+  TO_STRING_KV(K_(is_inited), K_(ring_fd), K_(event_fd), K_(is_sqpoll), K_(sq_entries), K_(fixed_buf_cnt),
+      K_(fixed_fd));
+
+private:
+  int64_t find_fixed_buffer(const char* buf, const int32_t size) const;
+
+private:
+  bool is_inited_;
+  bool is_sqpoll_;
+  int32_t ring_fd_;
+  int32_t event_fd_;
+  // submission queue, shared with the kernel
+  uint32_t* sq_head_;
+  uint32_t* sq_tail_;
+  uint32_t* sq_flags_;
+  uint32_t* sq_array_;
+  uint32_t sq_mask_;
+  uint32_t sq_entries_;
+  uint32_t sqe_tail_;  // local tail, published on flush
+  void* sqes_;
+  // completion queue, shared with the kernel
+  uint32_t* cq_head_;
+  uint32_t* cq_tail_;
+  uint32_t cq_mask_;
+  void* cqes_;
+  void* sq_ring_ptr_;
+  int64_t sq_ring_size_;
+  void* cq_ring_ptr_;
+  int64_t cq_ring_size_;
+  int64_t sqes_size_;
+  struct iovec fixed_bufs_[MAX_FIXED_BUFFER_CNT];
+  int64_t fixed_buf_cnt_;
+  int32_t fixed_fd_;
+  ObSpinLock sq_lock_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(ObIOUring);
+};
+
+}  // namespace common
+}  // namespace oceanbase
+
+#endif  // OB_IO_URING_H
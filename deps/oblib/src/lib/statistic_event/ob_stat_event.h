@@ -710,6 +710,12 @@ STAT_EVENT_ADD_DEF(CLOG_BATCH_SUBMITTED_COUNT, "clog batch submitted count", ObS
     "clog batch submitted count", 80063, true, true)
 STAT_EVENT_ADD_DEF(CLOG_BATCH_COMMITTED_COUNT, "clog batch committed count", ObStatClassIds::CLOG,
     "clog batch committed count", 80064, true, true)
+STAT_EVENT_ADD_DEF(CLOG_WRITE_ITEM_COUNT, "clog write item count", ObStatClassIds::CLOG, "clog write item count",
+    80065, true, true)
+STAT_EVENT_ADD_DEF(ILOG_WRITE_ITEM_COUNT, "ilog write item count", ObStatClassIds::CLOG, "ilog write item count",
+    80066, true, true)
+STAT_EVENT_ADD_DEF(CLOG_WRITE_CALLBACK_TIME, "clog write callback time", ObStatClassIds::CLOG,
+    "clog write callback time", 80067, true, true)
 
 // CLOG.EXTLOG 81001 ~ 90000
 STAT_EVENT_ADD_DEF(CLOG_EXTLOG_FETCH_LOG_SIZE, "external log service fetch log size", ObStatClassIds::CLOG,
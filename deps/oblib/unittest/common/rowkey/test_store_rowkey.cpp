@@ -446,6 +446,32 @@ TEST_F(TestStoreRowkey, test_compare)
   ASSERT_LT(compare_res, 0);
 }
 
+TEST_F(TestStoreRowkey, test_normalized_value)
+{
+  ObObj objs[4];
+  objs[0].set_int(0);
+  objs[1].set_uint64(1);
+  objs[2].set_int(2);
+  objs[3].set_uint64(INT64_MAX - 1);
+  for (int64_t i = 1; i < 4; ++i) {
+    const uint64_t prev = ObStoreRowkey::get_normalized_value(objs[i - 1]);
+    const uint64_t cur = ObStoreRowkey::get_normalized_value(objs[i]);
+    ASSERT_NE(ObStoreRowkey::NO_NORMALIZED_VALUE, cur);
+    ASSERT_LT(prev, cur);
+    ASSERT_LT(objs[i - 1].compare(objs[i]), 0);
+  }
+
+  ObObj other;
+  other.set_int(-1);
+  ASSERT_EQ(ObStoreRowkey::NO_NORMALIZED_VALUE, ObStoreRowkey::get_normalized_value(other));
+  other.set_uint64(UINT64_MAX);
+  ASSERT_EQ(ObStoreRowkey::NO_NORMALIZED_VALUE, ObStoreRowkey::get_normalized_value(other));
+  other.set_varchar("1");
+  ASSERT_EQ(ObStoreRowkey::NO_NORMALIZED_VALUE, ObStoreRowkey::get_normalized_value(other));
+  other.set_null();
+  ASSERT_EQ(ObStoreRowkey::NO_NORMALIZED_VALUE, ObStoreRowkey::get_normalized_value(other));
+}
+
 int main(int argc, char** argv)
 {
   OB_LOGGER.set_log_level("INFO");
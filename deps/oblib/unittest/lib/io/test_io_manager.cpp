@@ -522,6 +522,66 @@ TEST_F(TestIOManager, multi)
   }
 }
 
+TEST_F(TestIOManager, io_uring)
+{
+  static const int64_t MULTI_CNT = 1024;
+  int ret = OB_SUCCESS;
+  ObIOInfo io_info;
+  ObIOHandle io_handle[MULTI_CNT];
+  char data[4096];
+
+  // the backend is chosen when the disk is added
+  ObIOConfig io_conf = ObIOManager::get_instance().get_io_config();
+  io_conf.io_backend_ = IO_BACKEND_IO_URING;
+  ASSERT_EQ(OB_SUCCESS, ObIOManager::get_instance().set_io_config(io_conf));
+  ASSERT_EQ(OB_SUCCESS, ObIOManager::get_instance().delete_disk(fd_));
+  ASSERT_EQ(OB_SUCCESS, ObIOManager::get_instance().add_disk(fd_));
+  ObDisk* disk = ObIOManager::get_instance().get_disk_manager().get_disk(fd_);
+  ASSERT_TRUE(NULL != disk);
+  const ObIOBackend expect_backend = ObIOUring::is_supported() ? IO_BACKEND_IO_URING : IO_BACKEND_LIBAIO;
+  for (int64_t i = 0; i < ObDisk::MAX_DISK_CHANNEL_CNT; ++i) {
+    ASSERT_EQ(expect_backend, disk->channels_[i].get_backend());
+  }
+
+  io_info.size_ = 4096;
+  io_info.io_desc_.category_ = USER_IO;
+  io_info.batch_count_ = 1;
+  ObIOPoint& io_point = io_info.io_points_[0];
+  io_point.fd_ = fd_;
+  io_point.size_ = io_info.size_;
+  io_point.write_buf_ = data;
+
+  // multi write, each block keeps its own offset
+  io_info.io_desc_.mode_ = ObIOMode::IO_MODE_WRITE;
+  for (int64_t i = 0; i < MULTI_CNT; ++i) {
+    io_point.offset_ = 4096 * i;
+    snprintf(data, sizeof(data), "test io uring %ld", i);
+    ret = ObIOManager::get_instance().aio_write(io_info, io_handle[i]);
+    ASSERT_EQ(OB_SUCCESS, ret);
+  }
+  for (int64_t i = 0; i < MULTI_CNT; ++i) {
+    ret = io_handle[i].wait();
+    ASSERT_EQ(OB_SUCCESS, ret);
+    io_handle[i].reset();
+  }
+
+  // multi read
+  io_info.io_desc_.mode_ = ObIOMode::IO_MODE_READ;
+  for (int64_t i = 0; i < MULTI_CNT; ++i) {
+    io_point.offset_ = 4096 * i;
+    ret = ObIOManager::get_instance().aio_read(io_info, io_handle[i]);
+    ASSERT_EQ(OB_SUCCESS, ret);
+  }
+  for (int64_t i = 0; i < MULTI_CNT; ++i) {
+    ret = io_handle[i].wait();
+    ASSERT_EQ(OB_SUCCESS, ret);
+    snprintf(data, sizeof(data), "test io uring %ld", i);
+    ret = strncmp(data, io_handle[i].get_buffer(), strlen(data));
+    ASSERT_EQ(0, ret);
+    io_handle[i].reset();
+  }
+}
+
 #ifdef ERRSIM
 TEST_F(TestIOManager, abnormal)
 {
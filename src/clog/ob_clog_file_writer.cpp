@@ -99,6 +99,20 @@ bool ObCLogBaseFileWriter::enough_file_space(const uint64_t write_len) const
   return enough;
 }
 
+bool ObCLogBaseFileWriter::enough_buf_space(const uint64_t write_len) const
+{
+  // padding entry is less than two align size
+  const uint64_t max_padding_size = need_align() ? 2 * align_size_ : 0;
+  return buf_write_pos_ - buf_padding_size_ + write_len + max_padding_size <= CLOG_MAX_WRITE_BUFFER_SIZE;
+}
+
+uint32_t ObCLogBaseFileWriter::get_next_append_offset() const
+{
+  // unaligned tail of the last flush is kept at buffer head
+  const uint32_t buf_start_offset = need_align() ? (uint32_t)lower_align(file_offset_, align_size_) : file_offset_;
+  return buf_start_offset + buf_write_pos_ - buf_padding_size_;
+}
+
 int ObCLogLocalFileWriter::load_file(uint32_t& file_id, uint32_t& offset, bool enable_pre_creation)
 {
   UNUSED(enable_pre_creation);
@@ -321,6 +335,9 @@ int ObCLogBaseFileWriter::append_log_entry(const char* item_buf, const uint32_t
     ret = OB_ERR_UNEXPECTED;
     CLOG_LOG(WARN, "file not start", K_(file_id), K(ret));
   } else {
+    // padding entry is only needed at the end of buffer, entries in one flush are contiguous
+    buf_write_pos_ -= buf_padding_size_;
+    buf_padding_size_ = 0;
     // copy log to memory buffer
     memcpy(aligned_data_buf_ + buf_write_pos_, item_buf, len);
     buf_write_pos_ += (uint32_t)len;
@@ -661,6 +678,7 @@ void ObCLogLocalFileWriter::truncate_buf()
     // move the tail unaligned part to head
     tail_part_start = (uint32_t)lower_align(buf_write_pos_ - buf_padding_size_, align_size_);
     buf_write_pos_ = (buf_write_pos_ - buf_padding_size_) % align_size_;
+    buf_padding_size_ = 0;
     if (buf_write_pos_ > 0) {
       memmove(aligned_data_buf_, aligned_data_buf_ + tail_part_start, buf_write_pos_);
     }
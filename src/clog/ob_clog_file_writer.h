@@ -82,7 +82,11 @@ public:
     return log_dir_;
   }
   bool enough_file_space(const uint64_t write_len) const;
-  // append log item meta and data to buffer
+  // whether one more log entry can be appended to buffer before flush
+  bool enough_buf_space(const uint64_t write_len) const;
+  // file offset of the next appended log entry, entries appended before one flush are contiguous
+  uint32_t get_next_append_offset() const;
+  // append log item meta and data to buffer, overwrite the padding entry of the previous one
   int append_log_entry(const char* item_buf, const uint32_t len);
 
 protected:
@@ -104,6 +108,7 @@ protected:
   OB_INLINE void reset_buf()
   {
     buf_write_pos_ = 0;
+    buf_padding_size_ = 0;
   }
 
 protected:
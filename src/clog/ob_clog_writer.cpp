@@ -58,7 +58,7 @@ int ObCLogWriter::init(ObCLogWriterCfg& clog_cfg)
     ret = OB_INIT_TWICE;
     CLOG_LOG(WARN, "The ObCLogWriter has been inited, ", K(ret));
   } else if (OB_UNLIKELY(!clog_cfg.is_valid()) || OB_UNLIKELY(1 != clog_cfg.base_cfg_.group_commit_min_item_cnt_) ||
-             OB_UNLIKELY(1 != clog_cfg.base_cfg_.group_commit_max_item_cnt_)) {
+             OB_UNLIKELY(clog_cfg.base_cfg_.group_commit_max_item_cnt_ > MAX_GROUP_COMMIT_ITEM_CNT)) {
     ret = OB_INVALID_ARGUMENT;
     CLOG_LOG(WARN, "Invalid argument, ", K(clog_cfg), K(ret));
   } else if (OB_FAIL(ObBaseLogWriter::init(clog_cfg.base_cfg_))) {
@@ -185,13 +185,12 @@ void ObCLogWriter::process_log_items(common::ObIBaseLogItem** items, const int64
   finish_cnt = 0;
   ObLogBlockMetaV2 block_meta;
   const int64_t block_meta_len = block_meta.get_serialize_size();
-  int64_t meta_pos = 0;
   const bool is_disk_error = ATOMIC_LOAD(&is_disk_error_);
   set_clog_writer_thread_name();
   if (OB_UNLIKELY(!is_started_)) {
     ret = OB_NOT_INIT;
     CLOG_LOG(WARN, "The ObCLogWriter has not been started, ", K(ret));
-  } else if (OB_UNLIKELY(NULL == items) || OB_UNLIKELY(item_cnt <= 0) || OB_UNLIKELY(item_cnt > 1) ||
+  } else if (OB_UNLIKELY(NULL == items) || OB_UNLIKELY(item_cnt <= 0) ||
              NULL == (item = reinterpret_cast<ObICLogItem*>(items[0])) || OB_UNLIKELY(!item->is_valid()) ||
              OB_UNLIKELY(item->get_data_len() > OB_MAX_LOG_BUFFER_SIZE)) {
     ret = OB_INVALID_ARGUMENT;
@@ -205,6 +204,9 @@ void ObCLogWriter::process_log_items(common::ObIBaseLogItem** items, const int64
     const uint64_t write_len = block_meta_len + item->get_data_len();
     const int64_t warning_value = GCONF.data_storage_warning_tolerance_time;
     ObCLogDiskErrorCB* cb = NULL;
+    ObICLogItem* group_items[MAX_GROUP_COMMIT_ITEM_CNT];
+    uint32_t group_offsets[MAX_GROUP_COMMIT_ITEM_CNT];
+    int64_t group_cnt = 0;
 
     lib::ObMutexGuard guard(file_mutex_);
     BG_NEW_CALLBACK(cb, ObCLogDiskErrorCB, this);
@@ -212,15 +214,12 @@ void ObCLogWriter::process_log_items(common::ObIBaseLogItem** items, const int64
 
     // The timestamp value in block header must be generated by the time order, so
     // call inner_switch_file first here.
-    if (need_switch_file(write_len) && OB_FAIL(inner_switch_file())) {
+    if (need_switch_file(write_len, 0) && OB_FAIL(inner_switch_file())) {
       CLOG_LOG(ERROR, "Fail to switch file, ", K(ret), K(file_writer_->get_cur_file_id()));
-    } else if (OB_FAIL(block_meta.build_serialized_block(item->get_buf() - block_meta_len,
-                   block_meta_len,
-                   item->get_buf(),
-                   item->get_data_len(),
-                   OB_DATA_BLOCK,
-                   meta_pos))) {
-      CLOG_LOG(ERROR, "build serialized block meta fail", K(ret));
+    } else if (OB_FAIL(append_item(item, block_meta_len, group_offsets[0]))) {
+      CLOG_LOG(ERROR, "append log item fail", K(ret));
+    } else {
+      group_items[group_cnt++] = item;
     }
 
     // invoke callback when fail
@@ -228,9 +227,26 @@ void ObCLogWriter::process_log_items(common::ObIBaseLogItem** items, const int64
       after_flush(item, block_meta_len, ret, file_writer_->get_cur_file_len(), finish_cnt);
     }
 
-    if (OB_SUCC(ret)) {
-      if (OB_FAIL(file_writer_->append_log_entry(item->get_buf() - block_meta_len, (uint32_t)write_len))) {
-        CLOG_LOG(ERROR, "fail to add log item to buf, ", K(ret));
+    // Group commit: append the following items to the same buffer and flush them together,
+    // the file is never switched in the middle of a group. Items left are processed by the
+    // next call of base log writer.
+    uint64_t group_len = write_len;
+    bool group_end = false;
+    for (int64_t i = 1; OB_SUCC(ret) && !group_end && i < item_cnt && group_cnt < MAX_GROUP_COMMIT_ITEM_CNT; ++i) {
+      ObICLogItem* next_item = reinterpret_cast<ObICLogItem*>(items[i]);
+      const uint64_t next_len =
+          (NULL == next_item || !next_item->is_valid()) ? 0 : block_meta_len + next_item->get_data_len();
+      if (0 == next_len || next_item->get_data_len() > OB_MAX_LOG_BUFFER_SIZE ||
+          !file_writer_->enough_buf_space(next_len) || need_switch_file(group_len + next_len, group_cnt)) {
+        // leave it as the first item of the next call
+        group_end = true;
+      } else if (OB_FAIL(append_item(next_item, block_meta_len, group_offsets[group_cnt]))) {
+        CLOG_LOG(ERROR, "append log item fail", K(ret), K(i));
+        // the failed item is taken from the queue too, it is called back with the group
+        group_items[group_cnt++] = next_item;
+      } else {
+        group_items[group_cnt++] = next_item;
+        group_len += next_len;
       }
     }
 
@@ -254,10 +270,24 @@ void ObCLogWriter::process_log_items(common::ObIBaseLogItem** items, const int64
       } while (!has_stoped() && OB_TIMEOUT == ret);
     }
 
+    if (OB_SUCC(ret) && OB_UNLIKELY(flush_start_offset != group_offsets[0])) {
+      ret = OB_ERR_UNEXPECTED;
+      CLOG_LOG(ERROR, "flush start offset mismatch", K(ret), K(flush_start_offset), K(group_offsets[0]));
+    }
+
+    // invoke callback of every item in the group when fail after any of them is appended
+    if (OB_FAIL(ret)) {
+      for (int64_t i = 0; i < group_cnt; ++i) {
+        after_flush(group_items[i], block_meta_len, ret, file_writer_->get_cur_file_len(), finish_cnt);
+      }
+    }
+
     if (OB_SUCC(ret)) {
       io_time = ObTimeUtility::current_time() - cur_time;
       // log flush succeed, invoke callback when disk sync
-      after_flush(item, block_meta_len, ret, flush_start_offset, finish_cnt);
+      for (int64_t i = 0; i < group_cnt; ++i) {
+        after_flush(group_items[i], block_meta_len, ret, group_offsets[i], finish_cnt);
+      }
       flush_time = ObTimeUtility::current_time() - cur_time - io_time;
 
       if (flush_time + io_time > 100 * 1000) {
@@ -265,6 +295,7 @@ void ObCLogWriter::process_log_items(common::ObIBaseLogItem** items, const int64
             "slow flush",
             K(flush_time),
             K(io_time),
+            K(group_cnt),
             "file_id",
             file_writer_->get_cur_file_id(),
             K(flush_start_offset),
@@ -275,9 +306,12 @@ void ObCLogWriter::process_log_items(common::ObIBaseLogItem** items, const int64
       if (CLOG_WRITE_POOL == type_) {
         EVENT_INC(CLOG_WRITE_COUNT);
         EVENT_ADD(CLOG_WRITE_TIME, io_time);
+        EVENT_ADD(CLOG_WRITE_ITEM_COUNT, group_cnt);
+        EVENT_ADD(CLOG_WRITE_CALLBACK_TIME, flush_time);
       } else if (ILOG_WRITE_POOL == type_) {
         EVENT_INC(ILOG_WRITE_COUNT);
         EVENT_ADD(ILOG_WRITE_TIME, io_time);
+        EVENT_ADD(ILOG_WRITE_ITEM_COUNT, group_cnt);
       } else {
         CLOG_LOG(ERROR, "unknown write pool type", K(type_));
       }
@@ -295,7 +329,29 @@ void ObCLogWriter::process_log_items(common::ObIBaseLogItem** items, const int64
   }
 }
 
-bool ObCLogWriter::need_switch_file(const uint64_t write_len) const
+int ObCLogWriter::append_item(ObICLogItem* item, const int64_t block_meta_len, uint32_t& file_offset)
+{
+  int ret = OB_SUCCESS;
+  ObLogBlockMetaV2 block_meta;
+  int64_t meta_pos = 0;
+  const uint64_t write_len = block_meta_len + item->get_data_len();
+  if (OB_FAIL(block_meta.build_serialized_block(item->get_buf() - block_meta_len,
+          block_meta_len,
+          item->get_buf(),
+          item->get_data_len(),
+          OB_DATA_BLOCK,
+          meta_pos))) {
+    CLOG_LOG(ERROR, "build serialized block meta fail", K(ret));
+  } else {
+    file_offset = file_writer_->get_next_append_offset();
+    if (OB_FAIL(file_writer_->append_log_entry(item->get_buf() - block_meta_len, (uint32_t)write_len))) {
+      CLOG_LOG(ERROR, "fail to add log item to buf, ", K(ret));
+    }
+  }
+  return ret;
+}
+
+bool ObCLogWriter::need_switch_file(const uint64_t write_len, const int64_t group_cnt) const
 {
   // Left space is not enough for data or info block
   uint64_t max_switch_file_limit = 0;
@@ -304,7 +360,9 @@ bool ObCLogWriter::need_switch_file(const uint64_t write_len) const
   } else {
     max_switch_file_limit = ILOG_MAX_SWITCH_FILE_LIMIT;
   }
-  return !file_writer_->enough_file_space(write_len) || (info_getter_->get_entry_cnt() > max_switch_file_limit);
+  // each appended but not flushed item may add MAX_ENTRY_CNT_PER_ITEM entries to info block
+  return !file_writer_->enough_file_space(write_len) ||
+         (info_getter_->get_entry_cnt() + group_cnt * MAX_ENTRY_CNT_PER_ITEM > max_switch_file_limit);
 }
 
 void ObCLogWriter::after_flush(ObICLogItem* item, const int64_t block_meta_len, const int err_code,
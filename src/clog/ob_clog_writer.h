@@ -93,11 +93,20 @@ public:
   // when switch leader. In this case, clog file will switch file before write to the EOF.
   static const int64_t CLOG_MAX_SWITCH_FILE_LIMIT = 44000;
   static const int64_t ILOG_MAX_SWITCH_FILE_LIMIT = 17000;
+  static const int64_t MAX_ENTRY_CNT_PER_ITEM = 5000;
+  // Max number of log items (aggregated batch buffers) written to disk by one IO. Items
+  // are appended to the write buffer contiguously and flushed together, which saves IOPS
+  // when many small batches are queued. Only items already queued are grouped, the
+  // writer never waits for more items.
+  static const int64_t MAX_GROUP_COMMIT_ITEM_CNT = 16;
 
 private:
   static const int TASK_NUM = 1024;
   void set_clog_writer_thread_name();
-  bool need_switch_file(const uint64_t write_len) const;
+  // @group_cnt is the number of items appended to buffer but not flushed yet
+  bool need_switch_file(const uint64_t write_len, const int64_t group_cnt) const;
+  // build block meta of the item and append it to write buffer, @file_offset is where it will be written
+  int append_item(ObICLogItem* item, const int64_t block_meta_len, uint32_t& file_offset);
   void after_flush(ObICLogItem* item, const int64_t block_meta_len, const int err_code, const uint32_t file_offset,
       int64_t& finish_cnt);
   int inner_switch_file();
@@ -115,7 +115,7 @@ int ObLogEnv::init(const Config& cfg, const ObAddr& self_addr, ObIInfoBlockHandl
     log_cfg.type_ = write_pool_type;
     log_cfg.use_cache_ = enable_log_cache;
     log_cfg.base_cfg_.max_buffer_item_cnt_ = DEFAULT_WRITER_MAX_BUFFER_ITEM_CNT;
-    log_cfg.base_cfg_.group_commit_max_item_cnt_ = 1;
+    log_cfg.base_cfg_.group_commit_max_item_cnt_ = ObCLogWriter::MAX_GROUP_COMMIT_ITEM_CNT;
     log_cfg.base_cfg_.group_commit_min_item_cnt_ = 1;
     log_cfg.base_cfg_.group_commit_max_wait_us_ = 1000;
 
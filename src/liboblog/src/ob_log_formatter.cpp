@@ -88,7 +88,9 @@ ObLogFormatter::ObLogFormatter() : inited_(false),
                                    hbase_util_(NULL),
                                    skip_hbase_mode_put_column_count_not_consistency_(false),
                                    enable_output_hidden_primary_key_(false),
-                                   log_entry_task_count_(0)
+                                   log_entry_task_count_(0),
+                                   rps_stat_(),
+                                   last_stat_time_(0)
 
 {
 }
@@ -149,6 +151,8 @@ int ObLogFormatter::init(const int64_t thread_num,
     skip_hbase_mode_put_column_count_not_consistency_ = skip_hbase_mode_put_column_count_not_consistency;
     enable_output_hidden_primary_key_ = enable_output_hidden_primary_key;
     log_entry_task_count_ = 0;
+    rps_stat_.reset();
+    last_stat_time_ = get_timestamp();
     inited_ = true;
     LOG_INFO("Formatter init succ", K(working_mode_), "working_mode", print_working_mode(working_mode_),
         K(thread_num), K(queue_size));
@@ -180,6 +184,8 @@ void ObLogFormatter::destroy()
   skip_hbase_mode_put_column_count_not_consistency_ = false;
   enable_output_hidden_primary_key_ = false;
   log_entry_task_count_ = 0;
+  rps_stat_.reset();
+  last_stat_time_ = 0;
 }
 
 int ObLogFormatter::start()
@@ -217,14 +223,24 @@ int ObLogFormatter::push(IStmtTask *stmt_task, volatile bool &stop_flag)
     LOG_ERROR("invalid arguments", K(stmt_task));
     ret = OB_INVALID_ARGUMENT;
   } else {
-    // Ensure that all stmt of ObLogEntryTask are pushed to the same queue
-    const uint64_t hash_value = ATOMIC_FAA(&round_value_, 1);
+    // Statements of ObLogEntryTask are pushed to the queues in batches of formatter_batch_stmt_count,
+    // so that a large log entry is formatted by several threads.
+    // Rows are linked in statement order by the thread finishing the last statement, see finish_format_
+    const int64_t batch_stmt_count = std::max(1L, TCONF.formatter_batch_stmt_count.get());
+    uint64_t hash_value = 0;
     int64_t stmt_count = 0;
 
+    // Count before pushing, the log entry may be finished before the loop ends
+    ATOMIC_INC(&log_entry_task_count_);
+
     while (OB_SUCC(ret) && NULL != stmt_task) {
       IStmtTask *next = stmt_task->get_next();
       void *push_task = static_cast<void *>(stmt_task);
 
+      if (0 == stmt_count % batch_stmt_count) {
+        hash_value = ATOMIC_FAA(&round_value_, 1);
+      }
+
       RETRY_FUNC(stop_flag, *(static_cast<ObMQThread *>(this)), push, push_task, hash_value, DATA_OP_TIMEOUT);
 
       if (OB_SUCC(ret)) {
@@ -236,10 +252,6 @@ int ObLogFormatter::push(IStmtTask *stmt_task, volatile bool &stop_flag)
         }
       }
     } // while
-
-    if (OB_SUCC(ret)) {
-      ATOMIC_INC(&log_entry_task_count_);
-    }
   }
 
   return ret;
@@ -264,6 +276,22 @@ int ObLogFormatter::get_task_count(int64_t &br_count,
   return ret;
 }
 
+void ObLogFormatter::print_stat_info()
+{
+  int64_t current_timestamp = get_timestamp();
+  int64_t local_last_stat_time = last_stat_time_;
+  int64_t delta_time = current_timestamp - local_last_stat_time;
+  // Update last statistic value
+  last_stat_time_ = current_timestamp;
+  int64_t br_count = 0;
+  int64_t log_entry_task_count = 0;
+
+  double formatter_rps = rps_stat_.calc_rps(delta_time);
+  (void)get_task_count(br_count, log_entry_task_count);
+  _LOG_INFO("[FORMATTER] [STAT] RPS=%.3lf BR=%ld LOG_TASK=%ld THREAD_NUM=%ld",
+      formatter_rps, br_count, log_entry_task_count, get_thread_num());
+}
+
 int ObLogFormatter::handle(void *data, const int64_t thread_index, volatile bool &stop_flag)
 {
   int ret = OB_SUCCESS;
@@ -517,6 +545,8 @@ int ObLogFormatter::finish_format_(PartTransTask &part_trans_task,
     const uint64_t tenant_id = part_trans_task.get_tenant_id();
 
     if (is_all_stmt_formatted) {
+      rps_stat_.do_rps_stat(stmt_num);
+
       if (OB_FAIL(redo_log_entry_task.link_row_list())) {
         if (OB_IN_STOP_STATE != ret) {
           LOG_ERROR("redo_log_entry_task link_row_list fail", KR(ret), K(redo_log_entry_task));
@@ -24,6 +24,7 @@
 #include "ob_log_hbase_mode.h"                      // ObLogHbaseUtil
 #include "ob_log_schema_getter.h"                   // DBSchemaInfo
 #include "ob_log_work_mode.h"                       // WorkingMode
+#include "ob_log_trans_stat_mgr.h"                  // TransRpsStatInfo
 
 using namespace oceanbase::logmessage;
 namespace oceanbase
@@ -57,6 +58,7 @@ public:
   virtual void mark_stop_flag() = 0;
   virtual int push(IStmtTask *task, volatile bool &stop_flag) = 0;
   virtual int get_task_count(int64_t &br_count, int64_t &log_entry_task_count) = 0;
+  virtual void print_stat_info() = 0;
 };
 
 
@@ -87,6 +89,7 @@ public:
   int push(IStmtTask *task, volatile bool &stop_flag);
   int get_task_count(int64_t &br_count,
       int64_t &log_entry_task_count);
+  void print_stat_info();
   int handle(void *data, const int64_t thread_index, volatile bool &stop_flag);
 
 public:
@@ -221,6 +224,10 @@ private:
   bool                       enable_output_hidden_primary_key_;
   int64_t                    log_entry_task_count_;
 
+  // Number of formatted statements
+  TransRpsStatInfo           rps_stat_;
+  int64_t                    last_stat_time_ CACHE_ALIGNED;
+
 private:
   DISALLOW_COPY_AND_ASSIGN(ObLogFormatter);
 };
@@ -1823,6 +1823,7 @@ void ObLogInstance::timer_routine()
         trans_ctx_mgr_->print_stat_info();
         print_trans_stat_();
         resource_collector_->print_stat_info();
+        formatter_->print_stat_info();
         data_processor_->print_stat_info();
       }
 
@@ -16,6 +16,7 @@
 #include "lib/queue/ob_link.h"                      // ObLink
 #include "lib/atomic/ob_atomic.h"                   // ATOMIC_LOAD
 #include "lib/lock/ob_small_spin_lock.h"            // ObByteLock
+#include "lib/allocator/ob_safe_arena.h"            // ObSafeArena
 #include "common/object/ob_object.h"                // ObObj
 #include "common/ob_partition_key.h"                // ObPartitionKey
 #include "common/ob_queue_thread.h"                 // ObCond
@@ -596,9 +597,9 @@ private:
   int64_t            formatted_stmt_num_;   // Number of statements that formatted
   int64_t            row_ref_cnt_;          // reference count
 
-  // Non-thread safe allocator
-  // used for Parser/Formatter
-  common::ObArenaAllocator arena_allocator_;          // allocator
+  // Thread safe allocator
+  // used for Parser/Formatter, statements of a log entry are formatted by several Formatter threads
+  common::ObSafeArena arena_allocator_;               // allocator
 
 private:
   DISALLOW_COPY_AND_ASSIGN(ObLogEntryTask);
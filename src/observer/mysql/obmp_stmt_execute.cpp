@@ -63,9 +63,11 @@ ObMPStmtExecute::ObMPStmtExecute(const ObGlobalContext& gctx)
       arraybinding_columns_(NULL),
       arraybinding_row_(NULL),
       is_arraybinding_(false),
+      is_row_arraybinding_(false),
       is_save_exception_(false),
       arraybinding_size_(0),
       arraybinding_rowcnt_(0),
+      arraybinding_row_affected_rows_(),
       is_cursor_readonly_(false),
       single_process_timestamp_(0),
       exec_start_timestamp_(0),
@@ -79,7 +81,7 @@ int ObMPStmtExecute::init_field_for_arraybinding()
 {
   int ret = OB_SUCCESS;
 
-  ObField sql_no_field, err_no_field, err_msg_field;
+  ObField sql_no_field, err_no_field, err_msg_field, affected_rows_field;
 
   OX(sql_no_field.charsetnr_ = CS_TYPE_UTF8MB4_GENERAL_CI);
   OX(sql_no_field.type_.set_type(ObIntType));
@@ -103,23 +105,35 @@ int ObMPStmtExecute::init_field_for_arraybinding()
   OZ(arraybinding_columns_->push_back(err_no_field));
   OZ(arraybinding_columns_->push_back(err_msg_field));
 
+  if (is_row_arraybinding_) {
+    OX(affected_rows_field.charsetnr_ = CS_TYPE_UTF8MB4_GENERAL_CI);
+    OX(affected_rows_field.type_.set_type(ObIntType));
+    OZ(common::ObField::get_field_mb_length(affected_rows_field.type_.get_type(),
+        affected_rows_field.accuracy_,
+        common::CS_TYPE_INVALID,
+        affected_rows_field.length_));
+    OX(affected_rows_field.cname_ = ObString("affected_rows"));
+    OZ(arraybinding_columns_->push_back(affected_rows_field));
+  }
+
   return ret;
 }
 
 int ObMPStmtExecute::init_row_for_arraybinding(ObIAllocator& alloc)
 {
   int ret = OB_SUCCESS;
-  ObObj* obj = static_cast<ObObj*>(alloc.alloc(sizeof(ObObj) * 3));
+  const int64_t column_cnt = arraybinding_columns_->count();
+  ObObj* obj = static_cast<ObObj*>(alloc.alloc(sizeof(ObObj) * column_cnt));
   if (OB_ISNULL(obj)) {
     ret = OB_ALLOCATE_MEMORY_FAILED;
     LOG_WARN("failed to alloc memory for row", K(ret));
   } else {
     ObObj* ptr = obj;
-    for (int64_t i = 0; i < 3; ++i) {
+    for (int64_t i = 0; i < column_cnt; ++i) {
       ptr = new (ptr) ObObj();
       ptr++;
     }
-    arraybinding_row_->assign(obj, 3);
+    arraybinding_row_->assign(obj, column_cnt);
   }
   return ret;
 }
@@ -130,21 +144,30 @@ int ObMPStmtExecute::init_for_arraybinding(ObIAllocator& alloc)
   if (OB_ISNULL(arraybinding_params_ = static_cast<ParamStore*>(alloc.alloc(sizeof(ParamStore))))) {
     ret = OB_ALLOCATE_MEMORY_FAILED;
     LOG_WARN("failed to allocate memory", K(ret));
-  } else if (is_save_exception_) {
-    if (OB_ISNULL(arraybinding_columns_ = static_cast<ColumnsFieldArray*>(alloc.alloc(sizeof(ColumnsFieldArray))))) {
-      ret = OB_ALLOCATE_MEMORY_FAILED;
-      LOG_WARN("failed to allocate memory", K(ret));
-    } else if (OB_ISNULL(arraybinding_row_ = static_cast<ObNewRow*>(alloc.alloc(sizeof(ObNewRow))))) {
-      ret = OB_ALLOCATE_MEMORY_FAILED;
-      LOG_WARN("failed to allocate memory", K(ret));
-    } else {
-      arraybinding_columns_ = new (arraybinding_columns_) ColumnsFieldArray(alloc, 3);
-      arraybinding_row_ = new (arraybinding_row_) ObNewRow();
-    }
+  }
+  OX(arraybinding_params_ = new (arraybinding_params_) ParamStore((ObWrapperAllocator(alloc))));
+  return ret;
+}
+
+// the columns depend on the kind of arraybinding, known once the parameter types are decoded
+int ObMPStmtExecute::init_result_for_arraybinding(ObIAllocator& alloc)
+{
+  int ret = OB_SUCCESS;
+  if (!is_save_exception_ && !is_row_arraybinding_) {
+    // no result set, only an ok packet
+  } else if (OB_ISNULL(
+                 arraybinding_columns_ = static_cast<ColumnsFieldArray*>(alloc.alloc(sizeof(ColumnsFieldArray))))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("failed to allocate memory", K(ret));
+  } else if (OB_ISNULL(arraybinding_row_ = static_cast<ObNewRow*>(alloc.alloc(sizeof(ObNewRow))))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("failed to allocate memory", K(ret));
+  } else {
+    arraybinding_columns_ = new (arraybinding_columns_) ColumnsFieldArray(alloc, ARRAYBINDING_MAX_COLUMN_CNT);
+    arraybinding_row_ = new (arraybinding_row_) ObNewRow();
     OZ(init_field_for_arraybinding());
     OZ(init_row_for_arraybinding(alloc));
   }
-  OX(arraybinding_params_ = new (arraybinding_params_) ParamStore((ObWrapperAllocator(alloc))));
   return ret;
 }
 
@@ -165,9 +188,17 @@ int ObMPStmtExecute::check_param_type_for_arraybinding(
     LOG_WARN("oci arraybinding must has parameters", K(ret));
     LOG_USER_ERROR(OB_NOT_SUPPORTED, "oci arraybinding has no parameter");
   } else {
+    // row arraybinding if the first parameter is basic type, all the others must be the same
+    is_row_arraybinding_ = param_type_infos.at(0).is_basic_type_;
     for (int64_t i = 0; OB_SUCC(ret) && i < param_type_infos.count(); ++i) {
       TypeInfo& type_info = param_type_infos.at(i);
-      if (type_info.is_basic_type_ || !type_info.is_elem_type_) {
+      if (is_row_arraybinding_) {
+        if (!type_info.is_basic_type_) {
+          ret = OB_NOT_SUPPORTED;
+          LOG_WARN("row arraybinding parameter must be basic type", K(ret), K(i));
+          LOG_USER_ERROR(OB_NOT_SUPPORTED, "row arraybinding parameter is not basic type");
+        }
+      } else if (type_info.is_basic_type_ || !type_info.is_elem_type_) {
         ret = OB_NOT_SUPPORTED;
         LOG_WARN("oci arraybinding parameter must be anonymous array", K(ret));
         LOG_USER_ERROR(OB_NOT_SUPPORTED, "oci arraybinding parameter is not anonymous array");
@@ -186,8 +217,22 @@ int ObMPStmtExecute::check_param_value_for_arraybinding(ObObjParam& param)
 
 int ObMPStmtExecute::construct_execute_param_for_arraybinding(int64_t pos)
 {
-  int ret = OB_NOT_SUPPORTED;
-  LOG_WARN("not support array binging", K(pos));
+  int ret = OB_SUCCESS;
+  if (!is_row_arraybinding_) {
+    ret = OB_NOT_SUPPORTED;
+    LOG_WARN("not support array binging", K(pos));
+  } else if (OB_ISNULL(params_) || OB_ISNULL(arraybinding_params_) ||
+             OB_UNLIKELY(pos < 0 || pos >= arraybinding_size_ ||
+                         arraybinding_params_->count() != arraybinding_size_ * params_->count())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("invalid row arraybinding params", K(ret), K(pos), K_(arraybinding_size), KP_(params));
+  } else {
+    // the parameter rows are stored one by one in arraybinding_params_
+    const int64_t param_cnt = params_->count();
+    for (int64_t i = 0; i < param_cnt; ++i) {
+      params_->at(i) = arraybinding_params_->at(pos * param_cnt + i);
+    }
+  }
   return ret;
 }
 
@@ -226,10 +271,12 @@ int ObMPStmtExecute::response_result_for_arraybinding(
     ObSQLSessionInfo& session_info, ObIArray<ObSavedException>& exception_array)
 {
   int ret = OB_SUCCESS;
-  if (exception_array.count() > 0) {
+  if (is_row_arraybinding_) {
+    OZ(response_row_result_for_arraybinding(session_info, exception_array));
+  } else if (exception_array.count() > 0) {
 
     OMPKResheader rhp;
-    rhp.set_field_count(3);
+    rhp.set_field_count(arraybinding_columns_->count());
     OZ(response_packet(rhp));
 
     for (int64_t i = 0; OB_SUCC(ret) && i < arraybinding_columns_->count(); ++i) {
@@ -266,6 +313,47 @@ int ObMPStmtExecute::response_result_for_arraybinding(
   return ret;
 }
 
+int ObMPStmtExecute::response_row_result_for_arraybinding(
+    ObSQLSessionInfo& session_info, ObIArray<ObSavedException>& exception_array)
+{
+  int ret = OB_SUCCESS;
+  const ObDataTypeCastParams dtc_params = ObBasicSessionInfo::create_dtc_params(&session_info);
+  OMPKResheader rhp;
+  rhp.set_field_count(arraybinding_columns_->count());
+  OZ(response_packet(rhp));
+  for (int64_t i = 0; OB_SUCC(ret) && i < arraybinding_columns_->count(); ++i) {
+    ObMySQLField field;
+    OZ(ObMySQLResultSet::to_mysql_field(arraybinding_columns_->at(i), field));
+    OMPKField fp(field);
+    OZ(response_packet(fp));
+  }
+  OZ(send_eof_packet_for_arraybinding(session_info));
+
+  // exceptions are saved in order of the rows
+  int64_t exception_idx = 0;
+  for (int64_t i = 0; OB_SUCC(ret) && i < arraybinding_row_affected_rows_.count(); ++i) {
+    arraybinding_row_->get_cell(0).set_int(i);
+    if (exception_idx < exception_array.count() && i == exception_array.at(exception_idx).pos_) {
+      arraybinding_row_->get_cell(1).set_int(exception_array.at(exception_idx).error_code_);
+      arraybinding_row_->get_cell(2).set_varchar(exception_array.at(exception_idx).error_msg_);
+      ++exception_idx;
+    } else {
+      arraybinding_row_->get_cell(1).set_int(0);
+      arraybinding_row_->get_cell(2).set_varchar(ObString::make_empty_string());
+    }
+    arraybinding_row_->get_cell(3).set_int(arraybinding_row_affected_rows_.at(i));
+    OMPKRow rp(ObSMRow(BINARY,
+        *arraybinding_row_,
+        dtc_params,
+        arraybinding_columns_,
+        ctx_.schema_guard_,
+        session_info.get_effective_tenant_id()));
+    OZ(response_packet(rp));
+  }
+  OZ(send_eof_packet_for_arraybinding(session_info));
+  return ret;
+}
+
 int ObMPStmtExecute::save_exception_for_arraybinding(
     int64_t pos, int error_code, ObIArray<ObSavedException>& exception_array)
 {
@@ -488,6 +576,7 @@ int ObMPStmtExecute::before_process()
 
           if (OB_SUCC(ret) && is_arraybinding_) {
             OZ(check_param_type_for_arraybinding(session, param_type_infos));
+            OZ(init_result_for_arraybinding(alloc));
           }
 
           // Step4: check input param for CallProcedure.
@@ -496,8 +585,9 @@ int ObMPStmtExecute::before_process()
               ps_session_info->get_param_type_infos().count() > 0) {
             ret = OB_NOT_SUPPORTED;
           }
-          // Step5: decode value
+          // Step5: decode value, row arraybinding has more rows of null bitmap and values till the end
           const char* params = pos;
+          const char* packet_end = pkt.get_cdata() + pkt.get_clen();
           for (int64_t i = 0; OB_SUCC(ret) && i < params_num_; ++i) {
             ObObjParam& param = is_arraybinding_ ? arraybinding_params_->at(i) : params_->at(i);
             ObObjType ob_type;
@@ -509,6 +599,9 @@ int ObMPStmtExecute::before_process()
               bool is_null = ObSMUtils::update_from_bitmap(param, bitmap, i);
               if (is_null) {
                 LOG_DEBUG("param is null", K(i), K(param));
+              } else if (is_row_arraybinding_ &&
+                         OB_FAIL(check_basic_param_value_len(param_types.at(i), params, packet_end))) {
+                LOG_WARN("row arraybinding param value is cut short", K(ret), K(i));
               } else if (OB_FAIL(parse_param_value(alloc,
                              param_types.at(i),
                              charset,
@@ -529,6 +622,21 @@ int ObMPStmtExecute::before_process()
               // OZ (check_param_value_for_arraybinding(param));
             }
           }  // for end
+          if (OB_SUCC(ret) && is_row_arraybinding_) {
+            if (OB_FAIL(decode_arraybinding_rows(alloc,
+                    param_types,
+                    charset,
+                    lib::is_oracle_mode() ? cs_server : cs_conn,
+                    session->get_nls_collation_nation(),
+                    session->get_timezone_info(),
+                    params,
+                    packet_end,
+                    *arraybinding_params_))) {
+              LOG_WARN("decode row arraybinding params failed", K(ret), K(packet_end - params));
+            } else {
+              arraybinding_size_ = arraybinding_params_->count() / params_num_;
+            }
+          }
         }
         ctx_.schema_guard_ = old_guard;
         ctx_.session_info_ = old_sess_info;
@@ -932,8 +1040,15 @@ int ObMPStmtExecute::process_execute_stmt(const ObMultiStmtItem& multi_stmt_item
           LOG_USER_ERROR(OB_NOT_SUPPORTED, "oci arraybinding has no parameters");
         }
         for (int64_t i = 0; OB_SUCC(ret) && i < arraybinding_size_; ++i) {
+          const int64_t last_rowcnt = arraybinding_rowcnt_;
           OZ(construct_execute_param_for_arraybinding(i));
           OZ(do_process_single(session, has_more_result, force_sync_resp, async_resp_used));
+          if (is_row_arraybinding_) {
+            int tmp_ret = arraybinding_row_affected_rows_.push_back(arraybinding_rowcnt_ - last_rowcnt);
+            if (OB_SUCC(ret)) {
+              ret = tmp_ret;
+            }
+          }
           if (OB_FAIL(ret)) {
             if (is_save_exception_) {
               ret = save_exception_for_arraybinding(i, ret, exception_array);
@@ -1338,6 +1453,142 @@ int ObMPStmtExecute::parse_basic_param_value(ObIAllocator& allocator, const uint
   return ret;
 }
 
+int ObMPStmtExecute::check_basic_param_value_len(const uint32_t type, const char* data, const char* end)
+{
+  int ret = OB_SUCCESS;
+  uint64_t length = 0;
+  if (OB_ISNULL(data) || OB_ISNULL(end)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(data), KP(end));
+  } else if (OB_UNLIKELY(data >= end)) {
+    ret = OB_ERR_MALFORMED_PACKET;
+  } else {
+    switch (type) {
+      case MYSQL_TYPE_TINY: {
+        length = 1;
+        break;
+      }
+      case MYSQL_TYPE_SHORT:
+      case MYSQL_TYPE_YEAR: {
+        length = 2;
+        break;
+      }
+      case MYSQL_TYPE_LONG:
+      case MYSQL_TYPE_FLOAT: {
+        length = 4;
+        break;
+      }
+      case MYSQL_TYPE_LONGLONG:
+      case MYSQL_TYPE_DOUBLE: {
+        length = 8;
+        break;
+      }
+      case MYSQL_TYPE_DATE:
+      case MYSQL_TYPE_DATETIME:
+      case MYSQL_TYPE_TIMESTAMP:
+      case MYSQL_TYPE_TIME:
+      case MYSQL_TYPE_OB_TIMESTAMP_WITH_TIME_ZONE:
+      case MYSQL_TYPE_OB_TIMESTAMP_WITH_LOCAL_TIME_ZONE:
+      case MYSQL_TYPE_OB_TIMESTAMP_NANO:
+      case MYSQL_TYPE_OB_INTERVAL_YM:
+      case MYSQL_TYPE_OB_INTERVAL_DS: {
+        // 1 byte length and the value
+        length = 1 + static_cast<uint8_t>(*data);
+        break;
+      }
+      case MYSQL_TYPE_OB_NVARCHAR2:
+      case MYSQL_TYPE_OB_NCHAR:
+      case MYSQL_TYPE_OB_RAW:
+      case MYSQL_TYPE_TINY_BLOB:
+      case MYSQL_TYPE_MEDIUM_BLOB:
+      case MYSQL_TYPE_LONG_BLOB:
+      case MYSQL_TYPE_BLOB:
+      case MYSQL_TYPE_STRING:
+      case MYSQL_TYPE_VARCHAR:
+      case MYSQL_TYPE_VAR_STRING:
+      case MYSQL_TYPE_OB_NUMBER_FLOAT:
+      case MYSQL_TYPE_NEWDECIMAL:
+      case MYSQL_TYPE_OB_UROWID:
+      case MYSQL_TYPE_ORA_BLOB:
+      case MYSQL_TYPE_ORA_CLOB: {
+        // length coded binary and the value
+        const uint8_t sentinel = static_cast<uint8_t>(*data);
+        const int64_t length_size = sentinel < 251 ? 1 : (252 == sentinel ? 3 : (253 == sentinel ? 4 : 9));
+        const char* pos = data;
+        if (OB_UNLIKELY(251 == sentinel || 255 == sentinel)) {
+          ret = OB_ERR_MALFORMED_PACKET;
+        } else if (OB_UNLIKELY(end - data < length_size)) {
+          ret = OB_ERR_MALFORMED_PACKET;
+        } else if (OB_FAIL(ObMySQLUtil::get_length(pos, length))) {
+          LOG_WARN("decode length failed", K(ret));
+        } else if (OB_UNLIKELY(length > static_cast<uint64_t>(end - pos))) {
+          ret = OB_ERR_MALFORMED_PACKET;
+        } else {
+          length += length_size;
+        }
+        break;
+      }
+      default: {
+        // not a basic type, left to parse_basic_param_value() to report
+        break;
+      }
+    }
+    if (OB_SUCC(ret) && OB_UNLIKELY(length > static_cast<uint64_t>(end - data))) {
+      ret = OB_ERR_MALFORMED_PACKET;
+    }
+    if (OB_ERR_MALFORMED_PACKET == ret) {
+      LOG_WARN("param value runs past the end of packet", K(ret), K(type), K(length), K(end - data));
+    }
+  }
+  return ret;
+}
+
+int ObMPStmtExecute::decode_arraybinding_rows(ObIAllocator& allocator, const ParamTypeArray& param_types,
+    const ObCharsetType charset, const ObCollationType cs_type, const ObCollationType ncs_type,
+    const common::ObTimeZoneInfo* tz_info, const char* data, const char* end, ParamStore& params)
+{
+  int ret = OB_SUCCESS;
+  const int64_t param_cnt = param_types.count();
+  const int64_t bitmap_size = (param_cnt + 7) / 8;
+  if (OB_ISNULL(data) || OB_ISNULL(end) || OB_UNLIKELY(param_cnt <= 0 || data > end)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(data), KP(end), K(param_cnt));
+  }
+  while (OB_SUCC(ret) && data < end) {
+    const int64_t row_start = params.count();
+    const char* bitmap = data;
+    if (OB_UNLIKELY(end - data < bitmap_size)) {
+      ret = OB_ERR_MALFORMED_PACKET;
+      LOG_WARN("null bitmap runs past the end of packet", K(ret), K(bitmap_size), K(end - data));
+    } else if (OB_FAIL(params.prepare_allocate(row_start + param_cnt))) {
+      LOG_WARN("array prepare allocate failed", K(ret), K(row_start));
+    } else {
+      data += bitmap_size;
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && i < param_cnt; ++i) {
+      ObObjParam& param = params.at(row_start + i);
+      ObObjType ob_type;
+      if (OB_FAIL(ObSMUtils::get_ob_type(ob_type, param_types.at(i)))) {
+        LOG_WARN("cast ob type from mysql type failed", K(ob_type), K(param_types.at(i)), K(ret));
+      } else {
+        param.set_type(ob_type);
+        param.set_param_meta();
+        if (ObSMUtils::update_from_bitmap(param, bitmap, i)) {
+          LOG_DEBUG("param is null", K(i), K(param));
+        } else if (OB_FAIL(check_basic_param_value_len(param_types.at(i), data, end))) {
+          LOG_WARN("row arraybinding param value is cut short", K(ret), K(row_start), K(i));
+        } else if (OB_FAIL(parse_basic_param_value(
+                       allocator, param_types.at(i), charset, cs_type, ncs_type, data, tz_info, param))) {
+          LOG_WARN("failed to parse basic param value", K(ret), K(row_start), K(i));
+        } else {
+          param.set_param_meta();
+        }
+      }
+    }
+  }
+  return ret;
+}
+
 int ObMPStmtExecute::parse_param_value(ObIAllocator& allocator, const uint32_t type, const ObCharsetType charset,
     const ObCollationType cs_type, const ObCollationType ncs_type, const char*& data,
     const common::ObTimeZoneInfo* tz_info, TypeInfo* type_info, TypeInfo* dst_type_info, ObObjParam& param, int16_t param_id)
@@ -51,6 +51,13 @@ public:
   static int parse_mysql_time_value(const char*& data, ObObj& param);
   static int parse_oracle_interval_ym_value(const char*& data, ObObj& param);
   static int parse_oracle_interval_ds_value(const char*& data, ObObj& param);
+  // Check the value of basic %type at %data does not run past %end before parse_basic_param_value().
+  static int check_basic_param_value_len(const uint32_t type, const char* data, const char* end);
+  // Decode the parameter rows of row arraybinding in [%data, %end) and append them to %params,
+  // each row is a null bitmap followed by the values. OB_ERR_MALFORMED_PACKET if a row is cut short.
+  static int decode_arraybinding_rows(ObIAllocator& allocator, const sql::ParamTypeArray& param_types,
+      const ObCharsetType charset, const ObCollationType cs_type, const ObCollationType ncs_type,
+      const common::ObTimeZoneInfo* tz_info, const char* data, const char* end, ParamStore& params);
   int64_t get_single_process_timestamp() const
   {
     return single_process_timestamp_;
@@ -152,9 +159,22 @@ protected:
 
 private:
   // for arraybinding
+  //
+  // Two kinds of arraybinding share the ARRAYBINDING_MODE flag:
+  // OCI arraybinding binds every parameter to an anonymous array (MYSQL_TYPE_COMPLEX),
+  // row arraybinding binds basic types and carries more parameter rows after the first one:
+  //   | stmt_id | flags | iteration | null bitmap | new_params_bound_flag | types | values |
+  //   | null bitmap | values | null bitmap | values | ...  (till the end of packet)
+  // All the rows come in one request and are answered in one response, but each row is still a
+  // separate execution of the cached plan, only the round trips are saved. The response of row
+  // arraybinding is a result set of (sql_no, error_code, error_message, affected_rows) for every
+  // row and an ok packet, OCI arraybinding only returns (sql_no, error_code, error_message) of
+  // the failed rows with SAVE_EXCEPTION_MODE.
+  static const int64_t ARRAYBINDING_MAX_COLUMN_CNT = 4;
   int init_field_for_arraybinding();
   int init_row_for_arraybinding(ObIAllocator& alloc);
   int init_for_arraybinding(ObIAllocator& alloc);
+  int init_result_for_arraybinding(ObIAllocator& alloc);
   int check_param_type_for_arraybinding(sql::ObSQLSessionInfo* session_info, sql::ParamTypeInfoArray& param_type_infos);
   int check_param_value_for_arraybinding(ObObjParam& param);
   int construct_execute_param_for_arraybinding(int64_t pos);
@@ -163,6 +183,8 @@ private:
   int after_do_process_for_arraybinding(ObMySQLResultSet& result);
   int response_result_for_arraybinding(
       sql::ObSQLSessionInfo& session_info, ObIArray<ObSavedException>& exception_array);
+  int response_row_result_for_arraybinding(
+      sql::ObSQLSessionInfo& session_info, ObIArray<ObSavedException>& exception_array);
   int send_eof_packet_for_arraybinding(sql::ObSQLSessionInfo& session_info);
 
   int do_process_single(
@@ -215,9 +237,11 @@ private:
   ObNewRow* arraybinding_row_;
 
   bool is_arraybinding_;
+  bool is_row_arraybinding_;
   bool is_save_exception_;
   int64_t arraybinding_size_;
   int64_t arraybinding_rowcnt_;
+  common::ObSEArray<int64_t, 16> arraybinding_row_affected_rows_;
 
   bool is_cursor_readonly_;  // cursor read only
 
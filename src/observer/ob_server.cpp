@@ -1080,6 +1080,8 @@ int ObServer::init_io()
       io_config.cpu_high_water_level_ = GCONF.sys_cpu_limit_trigger * cpu_cnt;
       io_config.disk_io_thread_count_ = GCONF.disk_io_thread_count;
       io_config.callback_thread_count_ = GCONF._io_callback_thread_count;
+      io_config.io_backend_ = get_io_backend_from_str(GCONF._io_backend.str());
+      io_config.enable_io_uring_sqpoll_ = GCONF._enable_io_uring_sqpoll;
       if (OB_FAIL(ObIOManager::get_instance().set_io_config(io_config))) {
         LOG_ERROR("config io manager fail, ", K(ret));
       } else {
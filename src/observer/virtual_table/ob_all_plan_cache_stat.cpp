@@ -270,6 +270,15 @@ int ObAllPlanCacheStat::fill_cells(ObPlanCache& plan_cache)
       case PCV_EXPIRE_BY_MEM: {
         SET_REF_HANDLE_COL(PCV_EXPIRE_BY_MEM_HANDLE);
         break;
+      }
+        // lookups and hits of the fast parser result cache
+      case FP_CACHE_ACCESS_COUNT: {
+        cells[i].set_int(plan_cache.get_fp_cache().get_access_cnt());
+        break;
+      }
+      case FP_CACHE_HIT_COUNT: {
+        cells[i].set_int(plan_cache.get_fp_cache().get_hit_cnt());
+        break;
       }
       default: {
         ret = OB_ERR_UNEXPECTED;
@@ -121,7 +121,9 @@ private:
     PCV_GET_PLAN_KEY,
     PCV_GET_PL_KEY,
     PCV_EXPIRE_BY_USED,
-    PCV_EXPIRE_BY_MEM
+    PCV_EXPIRE_BY_MEM,
+    FP_CACHE_ACCESS_COUNT,
+    FP_CACHE_HIT_COUNT
   };
 
 private:
@@ -244,6 +244,26 @@ int ObInfoSchemaKvCacheTable::inner_get_next_row(ObNewRow*& row)
             cells_[cell_idx].set_int(inst->status_.hold_size_);
             break;
           }
+          case LRU_MB_CNT: {
+            cells_[cell_idx].set_int(inst->status_.lru_mb_cnt_);
+            break;
+          }
+          case LFU_MB_CNT: {
+            cells_[cell_idx].set_int(inst->status_.lfu_mb_cnt_);
+            break;
+          }
+          case SCAN_MB_CNT: {
+            cells_[cell_idx].set_int(inst->status_.scan_mb_cnt_);
+            break;
+          }
+          case TOTAL_SCAN_PUT_CNT: {
+            cells_[cell_idx].set_int(inst->status_.total_scan_put_cnt_.value());
+            break;
+          }
+          case GHOST_HIT_CNT: {
+            cells_[cell_idx].set_int(inst->status_.ghost_hit_cnt_);
+            break;
+          }
           default: {
             ret = OB_ERR_UNEXPECTED;
             SERVER_LOG(WARN, "invalid column id", K(ret), K(cell_idx), K(output_column_ids_), K(col_id));
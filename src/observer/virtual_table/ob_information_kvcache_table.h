@@ -52,7 +52,12 @@ private:
     TOTAL_PUT_CNT,
     TOTAL_HIT_CNT,
     TOTAL_MISS_CNT,
-    HOLD_SIZE
+    HOLD_SIZE,
+    LRU_MB_CNT,
+    LFU_MB_CNT,
+    SCAN_MB_CNT,
+    TOTAL_SCAN_PUT_CNT,
+    GHOST_HIT_CNT
   };
   common::ObAddr* addr_;
   common::ObString ipstr_;
@@ -235,9 +235,9 @@ void ObKVGlobalCache::destroy()
 }
 
 int ObKVGlobalCache::put(const int64_t cache_id, const ObIKVCacheKey& key, const ObIKVCacheValue& value,
-    const ObIKVCacheValue*& pvalue, ObKVMemBlockHandle*& mb_handle, bool overwrite)
+    const ObIKVCacheValue*& pvalue, ObKVMemBlockHandle*& mb_handle, bool overwrite, const enum ObKVCachePolicy policy)
 {
-  return put(store_, cache_id, key, value, pvalue, mb_handle, overwrite);
+  return put(store_, cache_id, key, value, pvalue, mb_handle, overwrite, policy);
 }
 
 int ObKVGlobalCache::put(ObWorkingSet* working_set, const ObIKVCacheKey& key, const ObIKVCacheValue& value,
@@ -261,7 +261,8 @@ int ObKVGlobalCache::put(ObWorkingSet* working_set, const ObIKVCacheKey& key, co
 
 template <typename MBWrapper>
 int ObKVGlobalCache::put(ObIKVCacheStore<MBWrapper>& store, const int64_t cache_id, const ObIKVCacheKey& key,
-    const ObIKVCacheValue& value, const ObIKVCacheValue*& pvalue, ObKVMemBlockHandle*& mb_handle, bool overwrite)
+    const ObIKVCacheValue& value, const ObIKVCacheValue*& pvalue, ObKVMemBlockHandle*& mb_handle, bool overwrite,
+    const enum ObKVCachePolicy policy)
 {
   int ret = OB_SUCCESS;
   ObKVCacheInstKey inst_key(cache_id, key.get_tenant_id());
@@ -283,7 +284,7 @@ int ObKVGlobalCache::put(ObIKVCacheStore<MBWrapper>& store, const int64_t cache_
     COMMON_LOG(WARN, "The inst is NULL, ", K(ret));
   } else if (!overwrite && (OB_SUCC(map_.get(cache_id, key, pvalue, mb_handle)))) {
     ret = OB_ENTRY_EXIST;
-  } else if (OB_FAIL(store.store(*inst_handle.get_inst(), key, value, kvpair, mb_wrapper))) {
+  } else if (OB_FAIL(store.store(*inst_handle.get_inst(), key, value, kvpair, mb_wrapper, policy))) {
     COMMON_LOG(WARN, "Fail to store kvpair to store, ", K(ret));
   } else {
     mb_handle = mb_wrapper->get_mb_handle();
@@ -306,9 +307,10 @@ int ObKVGlobalCache::put(ObIKVCacheStore<MBWrapper>& store, const int64_t cache_
 }
 
 int ObKVGlobalCache::alloc(const int64_t cache_id, const uint64_t tenant_id, const int64_t key_size,
-    const int64_t value_size, ObKVCachePair*& kvpair, ObKVMemBlockHandle*& mb_handle, ObKVCacheInstHandle& inst_handle)
+    const int64_t value_size, ObKVCachePair*& kvpair, ObKVMemBlockHandle*& mb_handle, ObKVCacheInstHandle& inst_handle,
+    const enum ObKVCachePolicy policy)
 {
-  return alloc(store_, cache_id, tenant_id, key_size, value_size, kvpair, mb_handle, inst_handle);
+  return alloc(store_, cache_id, tenant_id, key_size, value_size, kvpair, mb_handle, inst_handle, policy);
 }
 
 int ObKVGlobalCache::alloc(ObWorkingSet* working_set, const uint64_t tenant_id, const int64_t key_size,
@@ -334,7 +336,7 @@ int ObKVGlobalCache::alloc(ObWorkingSet* working_set, const uint64_t tenant_id,
 template <typename MBWrapper>
 int ObKVGlobalCache::alloc(ObIKVCacheStore<MBWrapper>& store, const int64_t cache_id, const uint64_t tenant_id,
     const int64_t key_size, const int64_t value_size, ObKVCachePair*& kvpair, ObKVMemBlockHandle*& mb_handle,
-    ObKVCacheInstHandle& inst_handle)
+    ObKVCacheInstHandle& inst_handle, const enum ObKVCachePolicy policy)
 {
   int ret = OB_SUCCESS;
   ObKVCacheInstKey inst_key(cache_id, tenant_id);
@@ -347,7 +349,8 @@ int ObKVGlobalCache::alloc(ObIKVCacheStore<MBWrapper>& store, const int64_t cach
   } else if (OB_ISNULL(inst_handle.get_inst())) {
     ret = OB_ERR_UNEXPECTED;
     COMMON_LOG(WARN, "The inst is NULL, ", K(ret));
-  } else if (OB_FAIL(store.alloc_kvpair(*inst_handle.get_inst(), key_size, value_size, kvpair, mb_wrapper))) {
+  } else if (OB_FAIL(
+                 store.alloc_kvpair(*inst_handle.get_inst(), key_size, value_size, kvpair, mb_wrapper, policy))) {
     COMMON_LOG(WARN, "Fail to store kvpair, ", K(ret));
   } else {
     mb_handle = mb_wrapper->get_mb_handle();
@@ -525,6 +528,7 @@ void ObKVGlobalCache::deregister_cache(const int64_t cache_id)
   } else {
     lib::ObMutexGuard guard(mutex_);
     configs_[cache_id].is_valid_ = false;
+    ATOMIC_STORE(&configs_[cache_id].wash_listener_, NULL);
   }
 
   if (OB_SUCC(ret)) {
@@ -589,6 +593,21 @@ int ObKVGlobalCache::set_priority(const int64_t cache_id, const int64_t priority
   return ret;
 }
 
+int ObKVGlobalCache::set_wash_listener(const int64_t cache_id, ObIKVCacheWashListener* listener)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!inited_)) {
+    ret = OB_NOT_INIT;
+    COMMON_LOG(WARN, "The ObKVGlobalCache has not been inited, ", K(ret));
+  } else if (OB_UNLIKELY(cache_id < 0) || OB_UNLIKELY(cache_id >= MAX_CACHE_NUM)) {
+    ret = OB_INVALID_ARGUMENT;
+    COMMON_LOG(WARN, "Invalid argument, ", K(cache_id), K(ret));
+  } else {
+    ATOMIC_STORE(&configs_[cache_id].wash_listener_, listener);
+  }
+  return ret;
+}
+
 void ObKVGlobalCache::wash()
 {
   if (inited_ && !start_destory_) {
@@ -35,13 +35,14 @@ class ObKVCacheIterator;
 template <class Key, class Value>
 class ObIKVCache {
 public:
-  virtual int put(const Key& key, const Value& value, bool overwrite = true) = 0;
-  virtual int put_and_fetch(
-      const Key& key, const Value& value, const Value*& pvalue, ObKVCacheHandle& handle, bool overwrite = true) = 0;
+  virtual int put(
+      const Key& key, const Value& value, bool overwrite = true, const enum ObKVCachePolicy policy = LRU) = 0;
+  virtual int put_and_fetch(const Key& key, const Value& value, const Value*& pvalue, ObKVCacheHandle& handle,
+      bool overwrite = true, const enum ObKVCachePolicy policy = LRU) = 0;
   virtual int get(const Key& key, const Value*& pvalue, ObKVCacheHandle& handle) = 0;
   virtual int erase(const Key& key) = 0;
   virtual int alloc(const uint64_t tenant_id, const int64_t key_size, const int64_t value_size, ObKVCachePair*& kvpair,
-      ObKVCacheHandle& handle, ObKVCacheInstHandle& inst_handle) = 0;
+      ObKVCacheHandle& handle, ObKVCacheInstHandle& inst_handle, const enum ObKVCachePolicy policy = LRU) = 0;
   virtual int put_kvpair(
       ObKVCacheInstHandle& inst_handle, ObKVCachePair* kvpair, ObKVCacheHandle& handle, bool overwrite = true);
 };
@@ -54,14 +55,17 @@ public:
   int init(const char* cache_name, const int64_t priority = 1);
   void destroy();
   int set_priority(const int64_t priority);
-  virtual int put(const Key& key, const Value& value, bool overwrite = true) override;
+  // NULL to remove the listener, see ObIKVCacheWashListener
+  int set_wash_listener(ObIKVCacheWashListener* listener);
+  virtual int put(
+      const Key& key, const Value& value, bool overwrite = true, const enum ObKVCachePolicy policy = LRU) override;
   virtual int put_and_fetch(const Key& key, const Value& value, const Value*& pvalue, ObKVCacheHandle& handle,
-      bool overwrite = true) override;
+      bool overwrite = true, const enum ObKVCachePolicy policy = LRU) override;
   virtual int get(const Key& key, const Value*& pvalue, ObKVCacheHandle& handle) override;
   int get_iterator(ObKVCacheIterator& iter);
   virtual int erase(const Key& key) override;
   virtual int alloc(const uint64_t tenant_id, const int64_t key_size, const int64_t value_size, ObKVCachePair*& kvpair,
-      ObKVCacheHandle& handle, ObKVCacheInstHandle& inst_handle) override;
+      ObKVCacheHandle& handle, ObKVCacheInstHandle& inst_handle, const enum ObKVCachePolicy policy = LRU) override;
   int64_t size(const uint64_t tenant_id = OB_SYS_TENANT_ID) const;
   int64_t count(const uint64_t tenant_id = OB_SYS_TENANT_ID) const;
   int64_t get_hit_cnt(const uint64_t tenant_id = OB_SYS_TENANT_ID) const;
@@ -88,9 +92,10 @@ public:
   int init(const uint64_t tenant_id, ObKVCache<Key, Value>& cache);
   void reset();
   void destroy();
-  virtual int put(const Key& key, const Value& value, bool overwrite = true) override;
-  virtual int put_and_fetch(
-      const Key& key, const Value& value, const Value*& pvalue, ObKVCacheHandle& handle, bool overwrite = true) override;
+  virtual int put(
+      const Key& key, const Value& value, bool overwrite = true, const enum ObKVCachePolicy policy = LRU) override;
+  virtual int put_and_fetch(const Key& key, const Value& value, const Value*& pvalue, ObKVCacheHandle& handle,
+      bool overwrite = true, const enum ObKVCachePolicy policy = LRU) override;
   virtual int get(const Key& key, const Value*& pvalue, ObKVCacheHandle& handle) override;
   virtual int erase(const Key& key) override;
 
@@ -103,7 +108,7 @@ public:
     return working_set_->get_limit();
   }
   virtual int alloc(const uint64_t tenant_id, const int64_t key_size, const int64_t value_size, ObKVCachePair*& kvpair,
-      ObKVCacheHandle& handle, ObKVCacheInstHandle& inst_handle) override;
+      ObKVCacheHandle& handle, ObKVCacheInstHandle& inst_handle, const enum ObKVCachePolicy policy = LRU) override;
 
 private:
   bool inited_;
@@ -154,22 +159,25 @@ private:
   int create_working_set(const ObKVCacheInstKey& inst_key, ObWorkingSet*& working_set);
   int delete_working_set(ObWorkingSet* working_set);
   int set_priority(const int64_t cache_id, const int64_t priority);
+  int set_wash_listener(const int64_t cache_id, ObIKVCacheWashListener* listener);
   int put(const int64_t cache_id, const ObIKVCacheKey& key, const ObIKVCacheValue& value,
-      const ObIKVCacheValue*& pvalue, ObKVMemBlockHandle*& mb_handle, bool overwrite = true);
+      const ObIKVCacheValue*& pvalue, ObKVMemBlockHandle*& mb_handle, bool overwrite = true,
+      const enum ObKVCachePolicy policy = LRU);
   int put(ObWorkingSet* working_set, const ObIKVCacheKey& key, const ObIKVCacheValue& value,
       const ObIKVCacheValue*& pvalue, ObKVMemBlockHandle*& mb_handle, bool overwrite = true);
   template <typename MBWrapper>
   int put(ObIKVCacheStore<MBWrapper>& store, const int64_t cache_id, const ObIKVCacheKey& key,
       const ObIKVCacheValue& value, const ObIKVCacheValue*& pvalue, ObKVMemBlockHandle*& mb_handle,
-      bool overwrite = true);
+      bool overwrite = true, const enum ObKVCachePolicy policy = LRU);
   int alloc(const int64_t cache_id, const uint64_t tenant_id, const int64_t key_size, const int64_t value_size,
-      ObKVCachePair*& kvpair, ObKVMemBlockHandle*& mb_handle, ObKVCacheInstHandle& inst_handle);
+      ObKVCachePair*& kvpair, ObKVMemBlockHandle*& mb_handle, ObKVCacheInstHandle& inst_handle,
+      const enum ObKVCachePolicy policy = LRU);
   int alloc(ObWorkingSet* working_set, const uint64_t tenant_id, const int64_t key_size, const int64_t value_size,
       ObKVCachePair*& kvpair, ObKVMemBlockHandle*& mb_handle, ObKVCacheInstHandle& inst_handle);
   template <typename MBWrapper>
   int alloc(ObIKVCacheStore<MBWrapper>& store, const int64_t cache_id, const uint64_t tenant_id, const int64_t key_size,
       const int64_t value_size, ObKVCachePair*& kvpair, ObKVMemBlockHandle*& mb_handle,
-      ObKVCacheInstHandle& inst_handle);
+      ObKVCacheInstHandle& inst_handle, const enum ObKVCachePolicy policy = LRU);
   int get(
       const int64_t cache_id, const ObIKVCacheKey& key, const ObIKVCacheValue*& pvalue, ObKVMemBlockHandle*& mb_handle);
   int erase(const int64_t cache_id, const ObIKVCacheKey& key);
@@ -370,6 +378,19 @@ int ObKVCache<Key, Value>::set_priority(const int64_t priority)
   return ret;
 }
 
+template <class Key, class Value>
+int ObKVCache<Key, Value>::set_wash_listener(ObIKVCacheWashListener* listener)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!inited_)) {
+    ret = OB_NOT_INIT;
+    COMMON_LOG(WARN, "The ObKVCache has not been inited, ", K(ret));
+  } else if (OB_FAIL(ObKVGlobalCache::get_instance().set_wash_listener(cache_id_, listener))) {
+    COMMON_LOG(WARN, "Fail to set wash listener, ", K(ret));
+  }
+  return ret;
+}
+
 template <class Key, class Value>
 int64_t ObKVCache<Key, Value>::size(const uint64_t tenant_id) const
 {
@@ -460,7 +481,7 @@ int ObKVCache<Key, Value>::get_iterator(ObKVCacheIterator& iter)
 }
 
 template <class Key, class Value>
-int ObKVCache<Key, Value>::put(const Key& key, const Value& value, bool overwrite)
+int ObKVCache<Key, Value>::put(const Key& key, const Value& value, bool overwrite, const enum ObKVCachePolicy policy)
 {
   int ret = OB_SUCCESS;
   ObKVCacheHandle handle;
@@ -468,8 +489,8 @@ int ObKVCache<Key, Value>::put(const Key& key, const Value& value, bool overwrit
   if (OB_UNLIKELY(!inited_)) {
     ret = OB_NOT_INIT;
     COMMON_LOG(WARN, "The ObKVCache has not been inited, ", K(ret));
-  } else if (OB_FAIL(
-                 ObKVGlobalCache::get_instance().put(cache_id_, key, value, pvalue, handle.mb_handle_, overwrite))) {
+  } else if (OB_FAIL(ObKVGlobalCache::get_instance().put(
+                 cache_id_, key, value, pvalue, handle.mb_handle_, overwrite, policy))) {
     if (OB_ENTRY_EXIST != ret) {
       COMMON_LOG(WARN, "Fail to put kv to ObKVGlobalCache, ", K_(cache_id), K(ret));
     }
@@ -480,8 +501,8 @@ int ObKVCache<Key, Value>::put(const Key& key, const Value& value, bool overwrit
 }
 
 template <class Key, class Value>
-int ObKVCache<Key, Value>::put_and_fetch(
-    const Key& key, const Value& value, const Value*& pvalue, ObKVCacheHandle& handle, bool overwrite)
+int ObKVCache<Key, Value>::put_and_fetch(const Key& key, const Value& value, const Value*& pvalue,
+    ObKVCacheHandle& handle, bool overwrite, const enum ObKVCachePolicy policy)
 {
   int ret = OB_SUCCESS;
   handle.reset();
@@ -493,7 +514,8 @@ int ObKVCache<Key, Value>::put_and_fetch(
                  value,
                  reinterpret_cast<const ObIKVCacheValue*&>(pvalue),
                  handle.mb_handle_,
-                 overwrite))) {
+                 overwrite,
+                 policy))) {
     if (OB_ENTRY_EXIST != ret) {
       COMMON_LOG(WARN, "Fail to put kv to ObKVGlobalCache, ", K_(cache_id), K(ret));
     }
@@ -537,14 +559,15 @@ int ObKVCache<Key, Value>::erase(const Key& key)
 
 template <class Key, class Value>
 int ObKVCache<Key, Value>::alloc(const uint64_t tenant_id, const int64_t key_size, const int64_t value_size,
-    ObKVCachePair*& kvpair, ObKVCacheHandle& handle, ObKVCacheInstHandle& inst_handle)
+    ObKVCachePair*& kvpair, ObKVCacheHandle& handle, ObKVCacheInstHandle& inst_handle,
+    const enum ObKVCachePolicy policy)
 {
   int ret = OB_SUCCESS;
   if (OB_UNLIKELY(!inited_)) {
     ret = OB_NOT_INIT;
     COMMON_LOG(WARN, "The ObKVCache has not been inited, ", K(ret));
   } else if (OB_FAIL(ObKVGlobalCache::get_instance().alloc(
-                 cache_id_, tenant_id, key_size, value_size, kvpair, handle.mb_handle_, inst_handle))) {
+                 cache_id_, tenant_id, key_size, value_size, kvpair, handle.mb_handle_, inst_handle, policy))) {
     COMMON_LOG(WARN, "failed to alloc", K(ret));
   }
 
@@ -672,9 +695,11 @@ void ObCacheWorkingSet<Key, Value>::reset()
 }
 
 template <class Key, class Value>
-int ObCacheWorkingSet<Key, Value>::put(const Key& key, const Value& value, bool overwrite)
+int ObCacheWorkingSet<Key, Value>::put(
+    const Key& key, const Value& value, bool overwrite, const enum ObKVCachePolicy policy)
 {
   int ret = OB_SUCCESS;
+  UNUSED(policy);
   ObKVCacheHandle handle;
   const ObIKVCacheValue* pvalue = NULL;
   if (!inited_) {
@@ -692,10 +717,11 @@ int ObCacheWorkingSet<Key, Value>::put(const Key& key, const Value& value, bool
 }
 
 template <class Key, class Value>
-int ObCacheWorkingSet<Key, Value>::put_and_fetch(
-    const Key& key, const Value& value, const Value*& pvalue, ObKVCacheHandle& handle, bool overwrite)
+int ObCacheWorkingSet<Key, Value>::put_and_fetch(const Key& key, const Value& value, const Value*& pvalue,
+    ObKVCacheHandle& handle, bool overwrite, const enum ObKVCachePolicy policy)
 {
   int ret = OB_SUCCESS;
+  UNUSED(policy);
   handle.reset();
   if (!inited_) {
     ret = OB_NOT_INIT;
@@ -743,9 +769,11 @@ int ObCacheWorkingSet<Key, Value>::erase(const Key& key)
 
 template <class Key, class Value>
 int ObCacheWorkingSet<Key, Value>::alloc(const uint64_t tenant_id, const int64_t key_size, const int64_t value_size,
-    ObKVCachePair*& kvpair, ObKVCacheHandle& handle, ObKVCacheInstHandle& inst_handle)
+    ObKVCachePair*& kvpair, ObKVCacheHandle& handle, ObKVCacheInstHandle& inst_handle,
+    const enum ObKVCachePolicy policy)
 {
   int ret = common::OB_SUCCESS;
+  UNUSED(policy);
   if (!inited_) {
     ret = OB_NOT_INIT;
     COMMON_LOG(WARN, "ObCacheWorkingSet is not inited", K(ret));
@@ -108,6 +108,7 @@ int ObKVCacheMap::put(ObKVCacheInst& inst, const ObIKVCacheKey& key, const ObKVC
   Node* iter = NULL;
   Node* prev = NULL;
   bool is_overwrite = false;
+  bool is_ghost = false;
 
   if (OB_UNLIKELY(!is_inited_)) {
     ret = OB_NOT_INIT;
@@ -127,6 +128,11 @@ int ObKVCacheMap::put(ObKVCacheInst& inst, const ObIKVCacheKey& key, const ObKVC
       if (NULL != (iter = bucket_ptr)) {
         while (NULL != iter && OB_SUCC(ret)) {
           if (!store_->add_handle_ref(iter->mb_handle_, iter->seq_num_)) {
+            // The key of an expired kv-pair is gone with its memblock, the node is the ghost of
+            // this key if the hash code matches.
+            if (hash_code == iter->hash_code_ && &inst == iter->inst_) {
+              is_ghost = true;
+            }
             // remove expired kv-pairs
             internal_map_erase(prev, iter, bucket_pos);
           } else {
@@ -138,6 +144,9 @@ int ObKVCacheMap::put(ObKVCacheInst& inst, const ObIKVCacheKey& key, const ObKVC
             if (hash_code == iter->hash_code_ && key == *(iter->key_)) {
               // found the same key
               if (overwrite) {
+                if (iter->key_ != kvpair->key_) {
+                  ObKVCachePair::set_dead(iter->key_);
+                }
                 (void)ATOMIC_SAF(&iter->mb_handle_->kv_cnt_, 1);
                 (void)ATOMIC_SAF(&iter->mb_handle_->get_cnt_, iter->get_cnt_);
                 insert_node = iter;
@@ -192,6 +201,16 @@ int ObKVCacheMap::put(ObKVCacheInst& inst, const ObIKVCacheKey& key, const ObKVC
             (void)ATOMIC_AAF(&inst.status_.kv_cnt_, 1);
           }
           inst.status_.total_put_cnt_.inc();
+          if (SCAN == mb_handle->policy_) {
+            inst.status_.total_scan_put_cnt_.inc();
+          }
+          if (is_ghost) {
+            // the kv was washed not long ago and is read again, keep it one segment higher this time
+            (void)ATOMIC_AAF(&inst.status_.ghost_hit_cnt_, 1);
+            if (LFU != mb_handle->policy_ && NULL == mb_handle->working_set_) {
+              internal_data_move(insert_node, SCAN == mb_handle->policy_ ? LRU : LFU);
+            }
+          }
         }
       }
     }
@@ -342,6 +361,7 @@ int ObKVCacheMap::erase(ObKVCacheInst& inst, const ObIKVCacheKey& key)
               ObKVMemBlockHandle* mb_handle = iter->mb_handle_;
               (void)ATOMIC_SAF(&mb_handle->kv_cnt_, 1);
               (void)ATOMIC_SAF(&mb_handle->get_cnt_, iter->get_cnt_);
+              ObKVCachePair::set_dead(iter->key_);
 
               store_->de_handle_ref(iter->mb_handle_);
               internal_map_erase(prev, iter, bucket_pos);
@@ -680,6 +700,7 @@ void ObKVCacheMap::internal_data_move(Node* iter, const enum ObKVCachePolicy pol
 
   if (NULL != old_key && NULL != old_value) {
     if (OB_SUCCESS == store_->store(*iter->inst_, *old_key, *old_value, new_kvpair, new_mb_handle, policy)) {
+      ObKVCachePair::set_dead(old_key);
       (void)ATOMIC_SAF(&mb_handle->kv_cnt_, 1);
       (void)ATOMIC_SAF(&mb_handle->get_cnt_, iter->get_cnt_);
 
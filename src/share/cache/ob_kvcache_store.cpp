@@ -600,6 +600,8 @@ int ObKVCacheStore::alloc_mbhandle(
       (void)ATOMIC_AAF(&inst.status_.store_size_, block_size);
       if (LRU == policy) {
         (void)ATOMIC_AAF(&inst.status_.lru_mb_cnt_, 1);
+      } else if (SCAN == policy) {
+        (void)ATOMIC_AAF(&inst.status_.scan_mb_cnt_, 1);
       } else {
         (void)ATOMIC_AAF(&inst.status_.lfu_mb_cnt_, 1);
       }
@@ -859,10 +861,17 @@ int ObKVCacheStore::do_wash_mb(ObKVMemBlockHandle* mb_handle, void*& buf, int64_
           mb_handle->mem_block_->get_payload_size() + sizeof(ObKVStoreMemBlock));
       if (mb_handle->policy_ == LRU) {
         (void)ATOMIC_SAF(&mb_handle->inst_->status_.lru_mb_cnt_, 1);
+      } else if (mb_handle->policy_ == SCAN) {
+        (void)ATOMIC_SAF(&mb_handle->inst_->status_.scan_mb_cnt_, 1);
       } else {
         (void)ATOMIC_SAF(&mb_handle->inst_->status_.lfu_mb_cnt_, 1);
       }
     }
+    ObIKVCacheWashListener* listener = NULL;
+    if (NULL != mb_handle->inst_ && SCAN != mb_handle->policy_ && NULL != mb_handle->inst_->status_.config_ &&
+        NULL != (listener = ATOMIC_LOAD(&mb_handle->inst_->status_.config_->wash_listener_))) {
+      mb_handle->mem_block_->notify_wash(*listener);
+    }
     buf = mb_handle->mem_block_;
     mb_size = mb_handle->mem_block_->get_align_size();
     mb_handle->mem_block_->~ObKVStoreMemBlock();
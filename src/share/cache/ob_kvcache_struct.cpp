@@ -17,7 +17,7 @@ namespace common {
 /**
  * ------------------------------------------------------------ObKVCacheConfig---------------------------------------------------------
  */
-ObKVCacheConfig::ObKVCacheConfig() : is_valid_(false), priority_(0)
+ObKVCacheConfig::ObKVCacheConfig() : is_valid_(false), priority_(0), wash_listener_(NULL)
 {
   MEMSET(cache_name_, 0, MAX_CACHE_NAME_LENGTH);
 }
@@ -27,6 +27,7 @@ void ObKVCacheConfig::reset()
   is_valid_ = false;
   priority_ = 0;
   MEMSET(cache_name_, 0, MAX_CACHE_NAME_LENGTH);
+  wash_listener_ = NULL;
 }
 
 /**
@@ -56,8 +57,11 @@ void ObKVCacheStatus::reset()
   map_size_ = 0;
   lru_mb_cnt_ = 0;
   lfu_mb_cnt_ = 0;
+  scan_mb_cnt_ = 0;
   total_put_cnt_.reset();
   total_hit_cnt_.reset();
+  total_scan_put_cnt_.reset();
+  ghost_hit_cnt_ = 0;
   total_miss_cnt_ = 0;
   last_hit_cnt_ = 0;
   base_mb_score_ = 0;
@@ -100,6 +104,21 @@ void ObKVStoreMemBlock::reuse()
   atomic_pos_.pairs = 0;
 }
 
+void ObKVStoreMemBlock::notify_wash(ObIKVCacheWashListener& listener) const
+{
+  if (NULL != buffer_) {
+    int64_t pos = 0;
+    const ObKVCachePair* kvpair = NULL;
+    for (uint32_t i = 0; i < atomic_pos_.pairs; ++i) {
+      kvpair = reinterpret_cast<const ObKVCachePair*>(buffer_ + pos);
+      if (kvpair->is_alive() && NULL != kvpair->key_ && NULL != kvpair->value_) {
+        listener.on_wash(*kvpair->key_, *kvpair->value_);
+      }
+      pos += kvpair->size_;
+    }
+  }
+}
+
 int64_t ObKVStoreMemBlock::upper_align(int64_t input, int64_t align)
 {
   return (input + align - 1) & ~(align - 1);
@@ -240,6 +259,7 @@ int ObKVStoreMemBlock::alloc(
   // if has found store pos, then store the kv
   if (OB_SUCC(ret)) {
     kvpair = reinterpret_cast<ObKVCachePair*>(&(buffer_[old_atomic_pos.buffer]));
+    kvpair->magic_ = ObKVCachePair::KVPAIR_MAGIC_NUM;
     kvpair->size_ = align_kv_size;
     kvpair->key_ = reinterpret_cast<ObIKVCacheKey*>(&(buffer_[old_atomic_pos.buffer + sizeof(ObKVCachePair)]));
     kvpair->value_ =
@@ -308,7 +328,9 @@ int ObKVMemBlockHandle::alloc(
 
 void ObKVMemBlockHandle::set_full(const double base_mb_score)
 {
-  score_ += base_mb_score;
+  if (SCAN != policy_) {
+    score_ += base_mb_score;
+  }
   ATOMIC_STORE((uint32_t*)(&status_), FULL);
 }
 }  // end namespace common
@@ -54,17 +54,46 @@ public:
   virtual int deep_copy(char* buf, const int64_t buf_len, ObIKVCacheValue*& value) const = 0;
 };
 
+// Told about the live kvs of a memblock right before the memblock is washed, e.g. to keep them in a
+// slower tier. It runs in the wash path, which may be a foreground alloc, so it must only hand the kv
+// over to its own thread and never block.
+class ObIKVCacheWashListener {
+public:
+  ObIKVCacheWashListener()
+  {}
+  virtual ~ObIKVCacheWashListener()
+  {}
+  virtual void on_wash(const ObIKVCacheKey& key, const ObIKVCacheValue& value) = 0;
+};
+
 struct ObKVCachePair {
   uint32_t magic_;
   int32_t size_;
   ObIKVCacheKey* key_;
   ObIKVCacheValue* value_;
-  static const uint32_t KVPAIR_MAGIC_NUM = 0x4B564B56;  //"KVKV"
+  static const uint32_t KVPAIR_MAGIC_NUM = 0x4B564B56;       //"KVKV"
+  static const uint32_t DEAD_KVPAIR_MAGIC_NUM = 0x4B564444;  //"KVDD"
   ObKVCachePair() : magic_(KVPAIR_MAGIC_NUM), size_(0), key_(NULL), value_(NULL)
   {}
+  // false once the kv is erased, overwritten or moved to another memblock
+  inline bool is_alive() const
+  {
+    return KVPAIR_MAGIC_NUM == ATOMIC_LOAD(&magic_);
+  }
+  // %key is stored right after its pair in the memblock, see ObKVStoreMemBlock::store
+  static inline void set_dead(const ObIKVCacheKey* key)
+  {
+    ObKVCachePair* kvpair = reinterpret_cast<ObKVCachePair*>(
+        const_cast<char*>(reinterpret_cast<const char*>(key) - sizeof(ObKVCachePair)));
+    ATOMIC_STORE(&kvpair->magic_, DEAD_KVPAIR_MAGIC_NUM);
+  }
 };
 
-enum ObKVCachePolicy { LRU = 0, LFU = 1, MAX_POLICY = 2 };
+// LRU memblocks are the probationary segment of a cache, kvs hit often enough in them are moved
+// to LFU memblocks (the protected segment). SCAN memblocks hold kvs put by bulk reads, they get
+// no base score when full and hits do not move their kvs, so they are washed first unless hit.
+// A kv put again soon after being washed (a ghost hit) goes one segment higher.
+enum ObKVCachePolicy { LRU = 0, LFU = 1, SCAN = 2, MAX_POLICY = 3 };
 
 class ObKVStoreMemBlock {
 public:
@@ -76,6 +105,8 @@ public:
   static int64_t get_align_size(const int64_t key_size, const int64_t value_size);
   int store(const ObIKVCacheKey& key, const ObIKVCacheValue& value, ObKVCachePair*& kvpair);
   int alloc(const int64_t key_size, const int64_t value_size, const int64_t align_kv_size, ObKVCachePair*& kvpair);
+  // kvpairs whose key or value is NULL are skipped, alloc() users clear them if the kv is not filled
+  void notify_wash(ObIKVCacheWashListener& listener) const;
   inline int64_t get_payload_size() const
   {
     return payload_size_;
@@ -185,6 +216,7 @@ public:
   bool is_valid_;
   int64_t priority_;
   char cache_name_[MAX_CACHE_NAME_LENGTH];
+  ObIKVCacheWashListener* wash_listener_;
 };
 
 struct ObKVCacheStatus {
@@ -201,19 +233,23 @@ public:
     return ATOMIC_LOAD(&hold_size_);
   }
   void reset();
-  TO_STRING_KV(KP_(config), K_(kv_cnt), K_(store_size), K_(map_size), K_(lru_mb_cnt), K_(lfu_mb_cnt), K_(base_mb_score),
-      K_(hold_size));
+  TO_STRING_KV(KP_(config), K_(kv_cnt), K_(store_size), K_(map_size), K_(lru_mb_cnt), K_(lfu_mb_cnt), K_(scan_mb_cnt),
+      K_(ghost_hit_cnt), K_(base_mb_score), K_(hold_size));
 
   const ObKVCacheConfig* config_;
   ObPCNonAtomicCounter total_put_cnt_;
   ObPCNonAtomicCounter total_hit_cnt_;
+  ObPCNonAtomicCounter total_scan_put_cnt_;
   int64_t kv_cnt_;
   int64_t store_size_;
   int64_t lru_mb_cnt_;
   int64_t lfu_mb_cnt_;
+  int64_t scan_mb_cnt_;
   int64_t map_size_;
   int64_t last_hit_cnt_;
   int64_t total_miss_cnt_;
+  // puts of keys whose kv was washed recently, i.e. misses a larger cache would have hit
+  int64_t ghost_hit_cnt_;
   double base_mb_score_;
   // guarantee at least hold_size_ memory left in cache after wash
   int64_t hold_size_;
@@ -16,6 +16,7 @@
 #include "lib/ob_running_mode.h"
 #include "lib/utility/ob_macro_utils.h"
 #include "lib/compress/ob_compressor_pool.h"
+#include "lib/io/ob_io_common.h"
 #include "lib/resource/achunk_mgr.h"
 #include "rpc/obrpc/ob_rpc_packet.h"
 #include "common/ob_store_format.h"
@@ -264,6 +265,11 @@ bool ObConfigRpcChecksumChecker::check(const ObConfigItem& t) const
   return obrpc::get_rpc_checksum_check_level_from_string(tmp_string) != obrpc::ObRpcCheckSumCheckLevel::INVALID;
 }
 
+bool ObConfigIOBackendChecker::check(const ObConfigItem& t) const
+{
+  return common::get_io_backend_from_str(t.str()) != common::IO_BACKEND_MAX;
+}
+
 bool ObConfigMemoryLimitChecker::check(const ObConfigItem& t) const
 {
   bool is_valid = false;
@@ -322,6 +322,17 @@ private:
   DISALLOW_COPY_AND_ASSIGN(ObConfigRpcChecksumChecker);
 };
 
+class ObConfigIOBackendChecker : public ObConfigChecker {
+public:
+  ObConfigIOBackendChecker()
+  {}
+  virtual ~ObConfigIOBackendChecker(){};
+  bool check(const ObConfigItem& t) const;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(ObConfigIOBackendChecker);
+};
+
 class ObConfigMemoryLimitChecker : public ObConfigChecker {
 public:
   ObConfigMemoryLimitChecker()
@@ -5342,7 +5342,9 @@ def_table_schema(
     ('pcv_get_plan_key', 'int'),
     ('pcv_get_pl_key', 'int'),
     ('pcv_expire_by_used', 'int'),
-    ('pcv_expire_by_mem', 'int')
+    ('pcv_expire_by_mem', 'int'),
+    ('fp_cache_access_count', 'int'),
+    ('fp_cache_hit_count', 'int')
   ],
   partition_columns = ['svr_ip', 'svr_port'],
   index = {'all_virtual_plan_cache_stat_i1' :  { 'index_columns' : ['tenant_id'],
@@ -5501,6 +5503,11 @@ def_table_schema(
   ('total_hit_cnt', 'int', 'false'),
   ('total_miss_cnt', 'int', 'false'),
   ('hold_size', 'int', 'false'),
+  ('lru_mb_cnt', 'int', 'false'),
+  ('lfu_mb_cnt', 'int', 'false'),
+  ('scan_mb_cnt', 'int', 'false'),
+  ('total_scan_put_cnt', 'int', 'false'),
+  ('ghost_hit_cnt', 'int', 'false'),
   ],
   partition_columns = ['svr_ip', 'svr_port'],
 )
@@ -12108,6 +12108,16 @@ static struct ObStrErrorInit
     ORACLE_ERRNO[-OB_ERR_CTE_NEED_QUERY_BLOCKS] = 600;
     ORACLE_STR_ERROR[-OB_ERR_CTE_NEED_QUERY_BLOCKS] = "ORA-00600: internal error code, arguments: -5976, Recursive Common Table Expression should have one or more non-recursive query blocks followed by one or more recursive ones";
     ORACLE_STR_USER_ERROR[-OB_ERR_CTE_NEED_QUERY_BLOCKS] = "ORA-00600: internal error code, arguments: -5976, Recursive Common Table Expression should have one or more non-recursive query blocks followed by one or more recursive ones: %s";
+    ERROR_NAME[-OB_ERR_MALFORMED_PACKET] = "OB_ERR_MALFORMED_PACKET";
+    ERROR_CAUSE[-OB_ERR_MALFORMED_PACKET] = "Internal Error";
+    ERROR_SOLUTION[-OB_ERR_MALFORMED_PACKET] = "Contact OceanBase Support";
+    MYSQL_ERRNO[-OB_ERR_MALFORMED_PACKET] = 1835;
+    SQLSTATE[-OB_ERR_MALFORMED_PACKET] = "HY000";
+    STR_ERROR[-OB_ERR_MALFORMED_PACKET] = "Malformed communication packet";
+    STR_USER_ERROR[-OB_ERR_MALFORMED_PACKET] = "Malformed communication packet";
+    ORACLE_ERRNO[-OB_ERR_MALFORMED_PACKET] = 600;
+    ORACLE_STR_ERROR[-OB_ERR_MALFORMED_PACKET] = "ORA-00600: internal error code, arguments: -5977, Malformed communication packet";
+    ORACLE_STR_USER_ERROR[-OB_ERR_MALFORMED_PACKET] = "ORA-00600: internal error code, arguments: -5977, Malformed communication packet";
     ERROR_NAME[-OB_TRANSACTION_SET_VIOLATION] = "OB_TRANSACTION_SET_VIOLATION";
     ERROR_CAUSE[-OB_TRANSACTION_SET_VIOLATION] = "Internal Error";
     ERROR_SOLUTION[-OB_TRANSACTION_SET_VIOLATION] = "Contact OceanBase Support";
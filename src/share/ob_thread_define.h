@@ -40,6 +40,9 @@ TG_DEF(LogScan, LogScan, "", TG_STATIC, TIMER_GROUP,
 TG_DEF(ReplayEngine, ReplayEngine, "", TG_STATIC, QUEUE_THREAD, ThreadCountPair(sysconf(_SC_NPROCESSORS_ONLN), 2),
     !lib::is_mini_mode() ? (common::REPLAY_TASK_QUEUE_SIZE + 1) * OB_MAX_PARTITION_NUM_PER_SERVER
                          : (common::REPLAY_TASK_QUEUE_SIZE + 1) * OB_MINI_MODE_MAX_PARTITION_NUM_PER_SERVER)
+TG_DEF(ReplayRowPrefetch, ReplayRowPrefetch, "", TG_STATIC, QUEUE_THREAD,
+    ThreadCountPair(memtable::ObReplayRowPrefetcher::THREAD_NUM, memtable::ObReplayRowPrefetcher::MINI_MODE_THREAD_NUM),
+    memtable::ObReplayRowPrefetcher::MAX_TASK_NUM)
 TG_DEF(LogCb, LogCb, "", TG_STATIC, QUEUE_THREAD,
     ThreadCountPair(clog::ObCLogMgr::CLOG_CB_THREAD_COUNT, clog::ObCLogMgr::MINI_MODE_CLOG_CB_THREAD_COUNT),
     clog::CLOG_CB_TASK_QUEUE_SIZE)
@@ -25,6 +25,7 @@
 #include "storage/transaction/ob_gts_worker.h"
 #include "storage/replayengine/ob_log_replay_engine.h"
 #include "storage/ob_replay_status.h"
+#include "storage/memtable/ob_replay_row_prefetcher.h"
 #include "rootserver/ob_index_builder.h"
 #include "observer/ob_sstable_checksum_updater.h"
 #include "observer/ob_srv_deliver.h"
@@ -256,6 +256,10 @@ DEF_BOOL(enable_sql_operator_dump, OB_CLUSTER_PARAMETER, "True",
 DEF_CAP(_chunk_row_store_mem_limit, OB_CLUSTER_PARAMETER, "0B", "[0,]",
     "the maximum size of memory used by ChunkRowStore, 0 means follow operator's setting. Range: [0, +∞)",
     ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_STR_WITH_CHECKER(_chunk_row_store_compress_func, OB_TENANT_PARAMETER, "none", common::ObConfigCompressFuncChecker,
+    "compressor used for the data dumped to temporary file by sql operators. "
+    "Values: none, lz4_1.0, snappy_1.0, zlib_1.0, zstd_1.0, zstd_1.3.8",
+    ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_STR_WITH_CHECKER(tableapi_transport_compress_func, OB_CLUSTER_PARAMETER, "none",
     common::ObConfigCompressFuncChecker,
     "compressor used for tableAPI query result. Values: none, lz4_1.0, snappy_1.0, zlib_1.0, zstd_1.0 zstd 1.3.8",
@@ -395,6 +399,11 @@ DEF_BOOL(_px_message_compression, OB_TENANT_PARAMETER, "False",
     "Enable DTL send message with compression"
     "Value: True: enable compression False: disable compression",
     ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_px_datum_column_encode, OB_TENANT_PARAMETER, "False",
+    "Enable DTL send datum rows to remote channels in column-wise batches, "
+    "all servers of the cluster must support it. "
+    "Value: True: enable column-wise batch False: disable column-wise batch",
+    ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_INT(_px_chunklist_count_ratio, OB_CLUSTER_PARAMETER, "1", "[1, 128]",
     "the ratio of the dtl buffer manager list. Range: [1, 128]",
     ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
@@ -414,6 +423,13 @@ DEF_BOOL(_enable_filter_push_down_storage, OB_TENANT_PARAMETER, "False",
     "Enable filter push down to storage"
     "Value:  True:turned on  False: turned off",
     ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_rowsets_enabled, OB_TENANT_PARAMETER, "False",
+    "Enable vectorized (batch rows) execution for the plans which all operators support it. "
+    "Value:  True:turned on  False: turned off",
+    ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_INT(_rowsets_max_rows, OB_TENANT_PARAMETER, "256", "[1, 65535]",
+    "max row count of one batch in vectorized execution. Range: [1, 65535]",
+    ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_WORK_AREA_POLICY(workarea_size_policy, OB_TENANT_PARAMETER, "AUTO",
     "policy used to size SQL working areas (MANUAL/AUTO)",
     ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
@@ -777,6 +793,10 @@ DEF_TIME(_ob_trans_rpc_timeout, OB_CLUSTER_PARAMETER, "3s", "[0s, 3600s]",
     ObParameterAttr(Section::TRANS, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_BOOL(enable_early_lock_release, OB_TENANT_PARAMETER, "False", "enable early lock release",
     ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_hotspot_early_lock_release, OB_TENANT_PARAMETER, "False",
+    "with enable_early_lock_release on, only release row locks early while rows with many lock waiters are found. "
+    "Value: True: turned on; False: turned off",
+    ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 
 //__enable_block_receiving_clog is obsolete
 // DEF_BOOL(__enable_block_receiving_clog, OB_CLUSTER_PARAMETER, "True",
@@ -788,6 +808,10 @@ DEF_TIME(_trx_commit_retry_interval, OB_CLUSTER_PARAMETER, "200ms", "[100ms,)",
     ObParameterAttr(Section::TRANS, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_TIME(_ob_get_gts_ahead_interval, OB_CLUSTER_PARAMETER, "0s", "[0s, 1s]", "get gts ahead interval. Range: [0s, 1s]",
     ObParameterAttr(Section::TRANS, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_gts_request_batching, OB_CLUSTER_PARAMETER, "False",
+    "specifies whether a tenant keeps at most one gts request in flight, the waiters arrived meanwhile are served by "
+    "the next request sent once it returns. Value: True: enabled; False: disabled",
+    ObParameterAttr(Section::TRANS, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_BOOL(_ob_enable_log_replica_strict_recycle_mode, OB_CLUSTER_PARAMETER, "True",
     "enable log replica strict recycle mode",
     ObParameterAttr(Section::TRANS, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
@@ -871,6 +895,13 @@ DEF_INT(bf_cache_miss_count_threshold, OB_CLUSTER_PARAMETER, "100", "[0,)",
     ObParameterAttr(Section::CACHE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_INT(fuse_row_cache_priority, OB_CLUSTER_PARAMETER, "1", "[1,)", "fuse row cache priority. Range: [1, )",
     ObParameterAttr(Section::CACHE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_STR(_micro_block_disk_cache_path, OB_CLUSTER_PARAMETER, "",
+    "file on a local fast device keeping micro blocks washed out of the user block cache across restarts, "
+    "empty means disabled",
+    ObParameterAttr(Section::CACHE, Source::DEFAULT, EditLevel::STATIC_EFFECTIVE));
+DEF_CAP(_micro_block_disk_cache_size, OB_CLUSTER_PARAMETER, "64G", "[64M,)",
+    "size of the file of _micro_block_disk_cache_path. Range: [64M, )",
+    ObParameterAttr(Section::CACHE, Source::DEFAULT, EditLevel::STATIC_EFFECTIVE));
 
 // background limit config
 DEF_INT(sys_bkgd_io_low_percentage, OB_CLUSTER_PARAMETER, "0", "[0,100]",
@@ -921,6 +952,15 @@ DEF_INT_WITH_CHECKER(disk_io_thread_count, OB_CLUSTER_PARAMETER, "8", common::Ob
 DEF_INT(_io_callback_thread_count, OB_CLUSTER_PARAMETER, "8", "[1,64]",
     "The number of io callback threads. The default value is 8. Range: [1,64] in integer",
     ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_STR_WITH_CHECKER(_io_backend, OB_CLUSTER_PARAMETER, "libaio", common::ObConfigIOBackendChecker,
+    "how the data file io is submitted to the kernel. "
+    "Value: [libaio]: linux native aio; "
+    "[io_uring]: io_uring, falls back to libaio if the kernel does not support it",
+    ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::STATIC_EFFECTIVE));
+DEF_BOOL(_enable_io_uring_sqpoll, OB_CLUSTER_PARAMETER, "False",
+    "whether the io_uring backend polls the submission queue by a kernel thread. "
+    "Value: True: enabled; False: disabled",
+    ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::STATIC_EFFECTIVE));
 DEF_INT(_large_query_io_percentage, OB_CLUSTER_PARAMETER, "0", "[0,100]",
     "the max percentage of io resource for big queries. Range: [0,100] in integer. Especially, 0 means unlimited. The "
     "default value is 0.",
@@ -960,6 +1000,14 @@ DEF_BOOL(_enable_fast_commit, OB_CLUSTER_PARAMETER, "False",
     "whether to enable fast commit strategy"
     "Value:  True:turned on;  False: turned off",
     ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_micro_block_encoding, OB_CLUSTER_PARAMETER, "False",
+    "whether major merge encodes micro blocks of tables in DYNAMIC, COMPRESSED, QUERY or ARCHIVE format column-wise. "
+    "Value:  True:turned on;  False: turned off",
+    ObParameterAttr(Section::SSTABLE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_micro_block_skip_index, OB_CLUSTER_PARAMETER, "False",
+    "whether major merge stores min, max and null count of micro blocks in macro blocks to skip them in scans. "
+    "Value:  True:turned on;  False: turned off",
+    ObParameterAttr(Section::SSTABLE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_BOOL(_enable_sparse_row, OB_CLUSTER_PARAMETER, "False",
     "whether enable using sparse row in SSTable"
     "Value:  True:turned on;  False: turned off",
@@ -16,6 +16,13 @@
 #include "sql/code_generator/ob_code_generator_impl.h"
 #include "sql/code_generator/ob_static_engine_expr_cg.h"
 #include "sql/code_generator/ob_static_engine_cg.h"
+#include "sql/optimizer/ob_log_plan.h"
+#include "sql/optimizer/ob_log_table_scan.h"
+#include "sql/optimizer/ob_log_limit.h"
+#include "sql/optimizer/ob_log_sort.h"
+#include "sql/optimizer/ob_log_group_by.h"
+#include "sql/engine/ob_physical_plan.h"
+#include "observer/omt/ob_tenant_config_mgr.h"
 
 namespace oceanbase {
 namespace sql {
@@ -28,7 +35,11 @@ int ObCodeGenerator::generate(const ObLogPlan& log_plan, ObPhysicalPlan& phy_pla
       LOG_WARN("fail to generate old plan", K(ret));
     }
   } else {
-    if (OB_FAIL(generate_exprs(log_plan, phy_plan))) {
+    int64_t batch_size = 0;
+    if (OB_FAIL(detect_batch_size(log_plan, batch_size))) {
+      LOG_WARN("detect batch size failed", K(ret));
+    } else if (FALSE_IT(phy_plan.set_batch_size(batch_size))) {
+    } else if (OB_FAIL(generate_exprs(log_plan, phy_plan))) {
       LOG_WARN("fail to get all raw exprs", K(ret));
     } else if (OB_FAIL(generate_operators(log_plan, phy_plan))) {
       LOG_WARN("fail to generate plan", K(ret));
@@ -55,6 +66,7 @@ int ObCodeGenerator::generate_exprs(const ObLogPlan& log_plan, ObPhysicalPlan& p
   ObStaticEngineExprCG expr_cg(phy_plan.get_allocator(), param_store_);
   // init ctx for operator cg
   expr_cg.init_operator_cg_ctx(log_plan.get_optimizer_context().get_exec_ctx());
+  expr_cg.set_batch_size(phy_plan.get_batch_size());
   ObRawExprUniqueSet all_raw_exprs(phy_plan.get_allocator());
   if (OB_FAIL(all_raw_exprs.init())) {
     LOG_WARN("fail to create hash set", K(ret));
@@ -69,6 +81,94 @@ int ObCodeGenerator::generate_exprs(const ObLogPlan& log_plan, ObPhysicalPlan& p
   return ret;
 }
 
+int ObCodeGenerator::detect_batch_size(const ObLogPlan& log_plan, int64_t& batch_size)
+{
+  int ret = OB_SUCCESS;
+  batch_size = 0;
+  bool rowsets_enabled = false;
+  int64_t rowsets_max_rows = 0;
+  const ObSQLSessionInfo* session = log_plan.get_optimizer_context().get_session_info();
+  if (OB_ISNULL(session)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("session is NULL", K(ret));
+  } else {
+    omt::ObTenantConfigGuard tenant_config(TENANT_CONF(session->get_effective_tenant_id()));
+    if (tenant_config.is_valid()) {
+      rowsets_enabled = tenant_config->_rowsets_enabled;
+      rowsets_max_rows = tenant_config->_rowsets_max_rows;
+    }
+  }
+  // Only local plan without subplan is vectorized right now, because:
+  // 1. datum frames of remote/distributed plan are serialized in row layout.
+  // 2. subplan filter/scan operators are not converted to batch mode.
+  if (OB_SUCC(ret) && rowsets_enabled && rowsets_max_rows > 0 &&
+      OB_PHY_PLAN_LOCAL == log_plan.get_phy_plan_type()) {
+    ObSEArray<const ObLogPlan*, 4> plans;
+    bool vectorizable = true;
+    if (OB_FAIL(get_all_log_plan(&log_plan, plans))) {
+      LOG_WARN("get all log plan failed", K(ret));
+    } else if (1 != plans.count() || !log_plan.get_subplans().empty()) {
+      vectorizable = false;
+    } else if (OB_FAIL(check_vectorizable(log_plan.get_plan_root(), vectorizable))) {
+      LOG_WARN("check vectorizable failed", K(ret));
+    }
+    if (OB_SUCC(ret) && vectorizable) {
+      batch_size = rowsets_max_rows;
+    }
+    LOG_TRACE("detect batch size", K(vectorizable), K(batch_size));
+  }
+  return ret;
+}
+
+int ObCodeGenerator::check_vectorizable(const ObLogicalOperator* op, bool& vectorizable)
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(op)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("NULL operator", K(ret));
+  } else if (OB_FAIL(check_stack_overflow())) {
+    LOG_WARN("check stack overflow failed", K(ret));
+  } else {
+    switch (op->get_type()) {
+      case log_op_def::LOG_TABLE_SCAN: {
+        // only the plain table scan (PHY_TABLE_SCAN) is supported.
+        ObLogTableScan* scan = const_cast<ObLogTableScan*>(static_cast<const ObLogTableScan*>(op));
+        vectorizable = !scan->get_is_fake_cte_table() && !scan->is_sample_scan() &&
+                       !scan->get_is_multi_part_table_scan() && !scan->is_for_update() &&
+                       !is_virtual_table(scan->get_ref_table_id());
+        break;
+      }
+      case log_op_def::LOG_LIMIT: {
+        ObLogLimit* limit = const_cast<ObLogLimit*>(static_cast<const ObLogLimit*>(op));
+        vectorizable = NULL == limit->get_limit_percent() && !limit->is_fetch_with_ties();
+        break;
+      }
+      case log_op_def::LOG_SORT: {
+        ObLogSort* sort = const_cast<ObLogSort*>(static_cast<const ObLogSort*>(op));
+        vectorizable = NULL == sort->get_topn_count() && NULL == sort->get_topk_limit_count() &&
+                       0 == sort->get_prefix_pos() && !sort->is_local_merge_sort();
+        break;
+      }
+      case log_op_def::LOG_GROUP_BY: {
+        // hash group by consumes child batches and outputs batches of the group rows.
+        ObLogGroupBy* group_by = const_cast<ObLogGroupBy*>(static_cast<const ObLogGroupBy*>(op));
+        vectorizable = HASH_AGGREGATE == group_by->get_algo() && !group_by->has_rollup();
+        break;
+      }
+      default: {
+        vectorizable = false;
+        break;
+      }
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && vectorizable && i < op->get_num_of_child(); i++) {
+      if (OB_FAIL(check_vectorizable(op->get_child(i), vectorizable))) {
+        LOG_WARN("check vectorizable failed", K(ret));
+      }
+    }
+  }
+  return ret;
+}
+
 int ObCodeGenerator::generate_operators(const ObLogPlan& log_plan, ObPhysicalPlan& phy_plan)
 {
   int ret = OB_SUCCESS;
@@ -47,6 +47,13 @@ private:
   int generate_old_plan(const ObLogPlan& log_plan, ObPhysicalPlan& phy_plan);
   int generate_exprs(const ObLogPlan& log_plan, ObPhysicalPlan& phy_plan);
 
+  // Detect batch size of vectorized execution, zero is returned if vectorized execution
+  // is disabled or some operators of the plan are not supported (fallback to row mode).
+  int detect_batch_size(const ObLogPlan& log_plan, int64_t& batch_size);
+
+  // check all operators of the operator tree support get_next_batch()
+  int check_vectorizable(const ObLogicalOperator* op, bool& vectorizable);
+
   int generate_operators(const ObLogPlan& log_plan, ObPhysicalPlan& phy_plan);
 
   // get all raw exprs of logical plan (include the subplans)
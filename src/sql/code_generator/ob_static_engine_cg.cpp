@@ -429,6 +429,8 @@ int ObStaticEngineCG::generate_spec_basic(ObLogicalOperator& op, ObOpSpec& spec,
   spec.width_ = op.get_width();
   spec.plan_depth_ = op.get_plan_depth();
   spec.px_est_size_factor_ = op.get_px_est_size_factor();
+  // all operators are vectorized if the plan is vectorized.
+  spec.max_batch_size_ = phy_plan_->get_batch_size();
 
   OZ(generate_rt_exprs(op.get_startup_exprs(), spec.startup_filters_));
 
@@ -4286,6 +4288,73 @@ int ObStaticEngineCG::generate_spec(ObLogJoin& op, ObMergeJoinSpec& spec, const
   return generate_join_spec(op, spec);
 }
 
+// Generate runtime join filter of the hash join build side for the probe side, which is either
+// a table scan in the same dfo or a distributed transmit of the child dfo. The probe side is
+// reached through granule iterator and material only, and all right join keys must be output of it.
+int ObStaticEngineCG::generate_join_filter(ObLogJoin& op, ObHashJoinSpec& spec, const ObIArray<ObExpr*>& right_keys,
+    const ObIArray<ObHashFunc>& right_hash_funcs)
+{
+  int ret = OB_SUCCESS;
+  const ObJoinType join_type = op.get_join_type();
+  // right rows which do not match any left row are discarded by these joins only
+  bool can_filter = (INNER_JOIN == join_type || LEFT_OUTER_JOIN == join_type || LEFT_SEMI_JOIN == join_type ||
+                     LEFT_ANTI_JOIN == join_type || RIGHT_SEMI_JOIN == join_type);
+  for (int64_t i = 0; can_filter && i < spec.equal_join_conds_.count(); i++) {
+    // null safe equal matches nulls, which are not in filter
+    can_filter = (T_OP_EQ == spec.equal_join_conds_.at(i)->type_);
+  }
+  ObOpSpec* probe = spec.get_child(1);
+  while (can_filter && NULL != probe && (PHY_GRANULE_ITERATOR == probe->type_ || PHY_MATERIAL == probe->type_)) {
+    probe = probe->get_child(0);
+  }
+  ObJoinFilterUseInfo* use_info = NULL;
+  const ExprFixedArray* probe_output = NULL;
+  uint64_t probe_dfo_id = OB_INVALID_ID;
+  if (!can_filter || NULL == probe) {
+    // do nothing
+  } else if (PHY_TABLE_SCAN == probe->type_) {
+    ObTableScanSpec* tsc_spec = static_cast<ObTableScanSpec*>(probe);
+    if (!tsc_spec->is_vt_mapping_) {
+      use_info = &tsc_spec->join_filter_info_;
+      probe_output = &tsc_spec->output_;
+    }
+  } else if (IS_PX_RECEIVE(probe->type_) && 1 == probe->get_child_cnt() && NULL != probe->get_child(0) &&
+             PHY_PX_DIST_TRANSMIT == probe->get_child(0)->type_) {
+    ObPxDistTransmitSpec* transmit_spec = static_cast<ObPxDistTransmitSpec*>(probe->get_child(0));
+    use_info = &transmit_spec->join_filter_info_;
+    probe_output = &transmit_spec->output_;
+    probe_dfo_id = transmit_spec->get_dfo_id();
+  }
+  if (NULL != use_info && use_info->is_valid()) {
+    // one join filter for each probe side at most
+    use_info = NULL;
+  }
+  for (int64_t i = 0; NULL != use_info && i < right_keys.count(); i++) {
+    if (!has_exist_in_array(*probe_output, right_keys.at(i))) {
+      use_info = NULL;
+    }
+  }
+  if (NULL != use_info) {
+    const ObExpr* left_key = spec.all_join_keys_.at(0);
+    const ObExpr* right_key = right_keys.at(0);
+    use_info->filter_id_ = spec.id_;
+    use_info->is_global_ = (OB_INVALID_ID != probe_dfo_id);
+    if (OB_FAIL(use_info->key_exprs_.assign(right_keys))) {
+      LOG_WARN("failed to assign join filter keys", K(ret));
+    } else if (OB_FAIL(use_info->hash_funcs_.assign(right_hash_funcs))) {
+      LOG_WARN("failed to assign join filter hash funcs", K(ret));
+    } else {
+      spec.build_join_filter_ = true;
+      spec.join_filter_has_range_ = (1 == right_keys.count() &&
+                                     ObIntTC == ob_obj_type_class(left_key->datum_meta_.type_) &&
+                                     ObIntTC == ob_obj_type_class(right_key->datum_meta_.type_));
+      spec.join_filter_probe_dfo_id_ = probe_dfo_id;
+      LOG_TRACE("generate join filter", K(spec.id_), K(probe->id_), K(*use_info), K(probe_dfo_id));
+    }
+  }
+  return ret;
+}
+
 int ObStaticEngineCG::generate_join_spec(ObLogJoin& op, ObJoinSpec& spec)
 {
   int ret = OB_SUCCESS;
@@ -4461,6 +4530,8 @@ int ObStaticEngineCG::generate_join_spec(ObLogJoin& op, ObJoinSpec& spec)
           LOG_WARN("failed to append join keys", K(ret));
         } else if (OB_FAIL(append(hj_spec.all_hash_funcs_, right_hash_funcs))) {
           LOG_WARN("failed to append join keys", K(ret));
+        } else if (OB_FAIL(generate_join_filter(op, hj_spec, right_key_exprs, right_hash_funcs))) {
+          LOG_WARN("failed to generate join filter", K(ret));
         }
       }
     }
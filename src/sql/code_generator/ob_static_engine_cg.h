@@ -232,6 +232,8 @@ private:
   int generate_spec(ObLogJoin& op, ObMergeJoinSpec& spec, const bool in_root_job);
 
   int generate_join_spec(ObLogJoin& op, ObJoinSpec& spec);
+  int generate_join_filter(ObLogJoin& op, ObHashJoinSpec& spec, const common::ObIArray<ObExpr*>& right_keys,
+      const common::ObIArray<common::ObHashFunc>& right_hash_funcs);
 
   int set_optimization_info(ObLogTableScan& op, ObTableScanSpec& spec);
   int set_partition_range_info(ObLogTableScan& op, ObTableScanSpec& spec);
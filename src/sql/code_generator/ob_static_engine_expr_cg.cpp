@@ -448,7 +448,9 @@ int ObStaticEngineExprCG::cg_const_frame_layout(
 {
   const bool reserve_empty_string = true;
   const bool continuous_datum = true;
-  return cg_frame_layout(const_exprs, reserve_empty_string, continuous_datum, frame_index_pos, frame_info_arr);
+  const int64_t batch_size = 0;
+  return cg_frame_layout(
+      const_exprs, reserve_empty_string, continuous_datum, batch_size, frame_index_pos, frame_info_arr);
 }
 
 int ObStaticEngineExprCG::cg_param_frame_layout(
@@ -516,7 +518,8 @@ int ObStaticEngineExprCG::cg_dynamic_frame_layout(
 {
   const bool reserve_empty_string = true;
   const bool continuous_datum = true;
-  return cg_frame_layout(exprs, reserve_empty_string, continuous_datum, frame_index_pos, frame_info_arr);
+  const int64_t batch_size = 0;
+  return cg_frame_layout(exprs, reserve_empty_string, continuous_datum, batch_size, frame_index_pos, frame_info_arr);
 }
 
 int ObStaticEngineExprCG::cg_datum_frame_layout(
@@ -525,13 +528,19 @@ int ObStaticEngineExprCG::cg_datum_frame_layout(
   const bool reserve_empty_string = false;
   // const bool continuous_datum = false;
   const bool continuous_datum = true;
-  return cg_frame_layout(exprs, reserve_empty_string, continuous_datum, frame_index_pos, frame_info_arr);
+  // only the datum frame expressions (not const or param) has result for each row of batch.
+  return cg_frame_layout(exprs, reserve_empty_string, continuous_datum, batch_size_, frame_index_pos, frame_info_arr);
 }
 
 int ObStaticEngineExprCG::cg_frame_layout(const ObIArray<ObRawExpr*>& exprs, const bool reserve_empty_string,
-    const bool continuous_datum, int64_t& frame_index_pos, ObIArray<ObFrameInfo>& frame_info_arr)
+    const bool continuous_datum, const int64_t batch_size, int64_t& frame_index_pos,
+    ObIArray<ObFrameInfo>& frame_info_arr)
 {
   int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(batch_size < 0 || (batch_size > 0 && !continuous_datum))) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("batch result only supported in continuous datum layout", K(ret), K(batch_size), K(continuous_datum));
+  }
   int64_t start_pos = 0;
   int64_t frame_expr_cnt = 0;
   int64_t frame_size = 0;
@@ -559,8 +568,9 @@ int ObStaticEngineExprCG::cg_frame_layout(const ObIArray<ObRawExpr*>& exprs, con
   }
   for (int64_t expr_idx = 0; OB_SUCC(ret) && expr_idx < exprs.count(); expr_idx++) {
     ObExpr* rt_expr = get_rt_expr(*exprs.at(expr_idx));
-    const int64_t datum_size = DATUM_EVAL_INFO_SIZE + reserve_data_consume(*rt_expr);
-    if (frame_size + datum_size <= MAX_FRAME_SIZE) {
+    const int64_t datum_size = frame_data_consume(*rt_expr, batch_size);
+    // always put at least one expression into frame, even it exceed MAX_FRAME_SIZE.
+    if (frame_size + datum_size <= MAX_FRAME_SIZE || 0 == frame_expr_cnt) {
       frame_size += datum_size;
       frame_expr_cnt++;
     } else {
@@ -587,7 +597,7 @@ int ObStaticEngineExprCG::cg_frame_layout(const ObIArray<ObRawExpr*>& exprs, con
     int64_t expr_start_pos = tmp_frame_infos.at(idx).expr_start_pos_;
     ObArrayHelper<ObRawExpr*> frame_exprs(
         frame.expr_cnt_, const_cast<ObRawExpr**>(exprs.get_data() + expr_start_pos), frame.expr_cnt_);
-    OZ(arrange_datum_data(frame_exprs, frame, continuous_datum));
+    OZ(arrange_datum_data(frame_exprs, frame, continuous_datum, batch_size));
   }
   // init ObFrameInfo
   if (OB_SUCC(ret)) {
@@ -607,20 +617,26 @@ int ObStaticEngineExprCG::cg_frame_layout(const ObIArray<ObRawExpr*>& exprs, con
 }
 
 int ObStaticEngineExprCG::arrange_datum_data(
-    ObIArray<ObRawExpr*>& exprs, const ObFrameInfo& frame, const bool continuous_datum)
+    ObIArray<ObRawExpr*>& exprs, const ObFrameInfo& frame, const bool continuous_datum, const int64_t batch_size)
 {
   int ret = OB_SUCCESS;
   if (continuous_datum) {
-    int64_t data_off = frame.expr_cnt_ * DATUM_EVAL_INFO_SIZE;
+    // For batch result expression, the datums of all rows are continuous, followed by eval info.
+    // Reserved buffers are continuous too, and dynamic reserved buffers are located in reverse
+    // order before reserved buffers. (see ObExpr::batch_idx_mask_)
+    const int64_t row_cnt = std::max(batch_size, 1L);
+    const int64_t datum_eval_info_size = row_cnt * sizeof(ObDatum) + sizeof(ObEvalInfo);
+    int64_t data_off = frame.expr_cnt_ * datum_eval_info_size;
     for (int64_t i = 0; OB_SUCC(ret) && i < exprs.count(); i++) {
       ObExpr* e = get_rt_expr(*exprs.at(i));
       e->frame_idx_ = frame.frame_idx_;
-      e->datum_off_ = i * DATUM_EVAL_INFO_SIZE;
-      e->eval_info_off_ = e->datum_off_ + sizeof(ObDatum);
+      e->datum_off_ = i * datum_eval_info_size;
+      e->eval_info_off_ = e->datum_off_ + row_cnt * sizeof(ObDatum);
+      e->batch_idx_mask_ = batch_size > 0 ? UINT64_MAX : 0;
       const int64_t consume_size = reserve_data_consume(*e);
       if (consume_size > 0) {
-        data_off += consume_size;
-        e->res_buf_off_ = data_off - e->res_buf_len_;
+        data_off += row_cnt * consume_size;
+        e->res_buf_off_ = data_off - row_cnt * e->res_buf_len_;
       } else {
         e->res_buf_off_ = 0;
       }
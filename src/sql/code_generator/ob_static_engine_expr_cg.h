@@ -49,7 +49,7 @@ public:
   static const int64_t DATUM_EVAL_INFO_SIZE = sizeof(ObDatum) + sizeof(ObEvalInfo);
   friend class ObRawExpr;
   ObStaticEngineExprCG(common::ObIAllocator& allocator, DatumParamStore* param_store)
-      : allocator_(allocator), param_store_(param_store), op_cg_ctx_(), flying_param_cnt_(0)
+      : allocator_(allocator), param_store_(param_store), op_cg_ctx_(), flying_param_cnt_(0), batch_size_(0)
   {}
   virtual ~ObStaticEngineExprCG()
   {}
@@ -81,6 +81,13 @@ public:
     return op_cg_ctx_;
   }
 
+  // Set batch size of vectorized execution, must be called before generate().
+  // Zero means row mode (not vectorized).
+  void set_batch_size(const int64_t batch_size)
+  {
+    batch_size_ = batch_size;
+  }
+
 private:
   static ObExpr* get_rt_expr(const ObRawExpr& raw_expr);
   int construct_exprs(const common::ObIArray<ObRawExpr*>& raw_exprs, common::ObIArray<ObExpr>& rt_exprs);
@@ -128,8 +135,11 @@ private:
   int cg_datum_frame_layout(const common::ObIArray<ObRawExpr*>& exprs, int64_t& frame_index_pos,
       common::ObIArray<ObFrameInfo>& frame_info_arr);
 
+  // @param batch_size: zero for row mode, otherwise each expression has %batch_size
+  //                    datums and reserved buffers.
   int cg_frame_layout(const common::ObIArray<ObRawExpr*>& exprs, const bool reserve_empty_string,
-      const bool continuous_datum, int64_t& frame_index_pos, common::ObIArray<ObFrameInfo>& frame_info_arr);
+      const bool continuous_datum, const int64_t batch_size, int64_t& frame_index_pos,
+      common::ObIArray<ObFrameInfo>& frame_info_arr);
 
   int alloc_const_frame(const common::ObIArray<ObRawExpr*>& exprs, const common::ObIArray<ObFrameInfo>& const_frames,
       common::ObIArray<char*>& frame_ptrs);
@@ -141,7 +151,15 @@ private:
     return expr.res_buf_len_ + (need_dyn_buf && expr.res_buf_len_ > 0 ? sizeof(ObDynReserveBuf) : 0);
   }
 
-  int arrange_datum_data(common::ObIArray<ObRawExpr*>& exprs, const ObFrameInfo& frame, const bool continuous_datum);
+  // frame memory consumed by expression (datum, eval info and reserved buffer)
+  int64_t frame_data_consume(const ObExpr& expr, const int64_t batch_size)
+  {
+    const int64_t row_cnt = std::max(batch_size, 1L);
+    return row_cnt * (sizeof(ObDatum) + reserve_data_consume(expr)) + sizeof(ObEvalInfo);
+  }
+
+  int arrange_datum_data(common::ObIArray<ObRawExpr*>& exprs, const ObFrameInfo& frame, const bool continuous_datum,
+      const int64_t batch_size);
 
   int inner_generate_calculable_exprs(
       const common::ObIArray<ObHiddenColumnItem>& calculable_exprs, ObPreCalcExprFrameInfo& expr_info);
@@ -156,6 +174,8 @@ private:
   ObExprCGCtx op_cg_ctx_;
   // Count of param store in generating, for calculable expressions CG.
   int64_t flying_param_cnt_;
+  // Batch size of vectorized execution, zero for row mode.
+  int64_t batch_size_;
 };
 
 }  // end namespace sql
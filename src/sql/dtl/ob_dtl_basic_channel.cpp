@@ -523,6 +523,19 @@ int ObDtlBasicChannel::get_processed_buffer(int64_t timeout)
                     K(get_processed_buffer_cnt()),
                     K(get_recv_buffer_cnt()));
               }
+            } else if (ObDtlMsgType::PX_DATUM_COLUMN == process_buffer_->msg_type()) {
+              if (msg_reader_ != &datum_column_iter_) {
+                msg_reader_->reset();
+                msg_reader_ = &datum_column_iter_;
+              }
+              if (OB_FAIL(msg_reader_->load_buffer(*process_buffer_))) {
+                LOG_WARN("failed to init px column iter",
+                    KP(id_),
+                    K_(peer),
+                    K(ret),
+                    K(get_processed_buffer_cnt()),
+                    K(get_recv_buffer_cnt()));
+              }
             }
           }
         } else {
@@ -561,7 +574,8 @@ int ObDtlBasicChannel::process1(ObIDtlChannelProc* proc, int64_t timeout, bool&
           }
         } else if (nullptr != process_buffer_) {
           auto& buffer = process_buffer_;
-          if (ObDtlMsgType::PX_DATUM_ROW == process_buffer_->msg_type()) {
+          if (ObDtlMsgType::PX_DATUM_ROW == process_buffer_->msg_type() ||
+              ObDtlMsgType::PX_DATUM_COLUMN == process_buffer_->msg_type()) {
             if (!msg_reader_->is_inited()) {
               ret = OB_ERR_UNEXPECTED;
               LOG_WARN("px row iter is not init", K(ret));
@@ -972,6 +986,10 @@ int ObDtlBasicChannel::switch_writer(const ObDtlMsg& msg)
         msg_writer_ = &row_msg_writer_;
       } else if (DtlWriterType::CHUNK_DATUM_WRITER == msg_writer_map[px_row.get_data_type()]) {
         msg_writer_ = &datum_msg_writer_;
+        // local channels hand the buffer over without copy and interm results are stored
+        // in row format, only remote channels benefit from the column-wise batch
+        datum_msg_writer_.set_column_encode(
+            column_encode_ && !use_interm_result_ && DtlChannelType::RPC_CHANNEL == get_channel_type());
       } else {
         ret = OB_ERR_UNEXPECTED;
         LOG_WARN("unkown msg writer", K(msg.get_type()), K(px_row.get_data_type()), K(msg_writer_->type()), K(ret));
@@ -1189,7 +1207,14 @@ int ObDtlRowMsgWriter::serialize()
 
 //-----------------start ObDtlDatumMsgWrite-------------
 ObDtlDatumMsgWriter::ObDtlDatumMsgWriter()
-    : type_(CHUNK_DATUM_WRITER), write_buffer_(nullptr), block_(nullptr), write_ret_(OB_SUCCESS)
+    : type_(CHUNK_DATUM_WRITER),
+      write_buffer_(nullptr),
+      block_(nullptr),
+      write_ret_(OB_SUCCESS),
+      tenant_id_(OB_INVALID_ID),
+      column_encode_(false),
+      column_size_(0),
+      encoder_()
 {}
 
 ObDtlDatumMsgWriter::~ObDtlDatumMsgWriter()
@@ -1200,7 +1225,6 @@ ObDtlDatumMsgWriter::~ObDtlDatumMsgWriter()
 int ObDtlDatumMsgWriter::init(ObDtlLinkedBuffer* buffer, uint64_t tenant_id)
 {
   int ret = OB_SUCCESS;
-  UNUSED(tenant_id);
   if (nullptr == buffer) {
     ret = OB_ERR_UNEXPECTED;
     LOG_WARN("write buffer is null", K(ret));
@@ -1210,6 +1234,7 @@ int ObDtlDatumMsgWriter::init(ObDtlLinkedBuffer* buffer, uint64_t tenant_id)
       LOG_WARN("init shrink buffer failed", K(ret));
     } else {
       write_buffer_ = buffer;
+      tenant_id_ = tenant_id;
     }
   }
   return ret;
@@ -1246,11 +1271,37 @@ void ObDtlDatumMsgWriter::reset()
 {
   block_ = nullptr;
   write_buffer_ = nullptr;
+  column_size_ = 0;
 }
 
 int ObDtlDatumMsgWriter::serialize()
 {
-  return block_->unswizzling();
+  int ret = OB_SUCCESS;
+  if (column_encode_ && 0 == column_size_ && block_->rows() > 0) {
+    char* buf = nullptr;
+    int64_t size = 0;
+    const int64_t data_size = block_->data_size();
+    if (OB_FAIL(encoder_.prepare_buf(tenant_id_, data_size, buf))) {
+      LOG_WARN("prepare column batch buffer failed", K(ret), K(data_size));
+    } else if (OB_FAIL(encoder_.encode(block_, buf, data_size, size))) {
+      if (OB_SIZE_OVERFLOW == ret) {
+        // column-wise batch is not smaller, send in row format
+        ret = OB_SUCCESS;
+      } else {
+        LOG_WARN("encode column batch failed", K(ret));
+      }
+    } else {
+      // the BlockBuffer at the tail of the buffer is untouched since size < data_size
+      MEMCPY(write_buffer_->buf(), buf, size);
+      write_buffer_->msg_type() = ObDtlMsgType::PX_DATUM_COLUMN;
+      write_buffer_->pos() = size;
+      column_size_ = size;
+    }
+  }
+  if (OB_SUCC(ret) && 0 == column_size_) {
+    ret = block_->unswizzling();
+  }
+  return ret;
 }
 //--------------end ObDtlDatumMsgWriter---------------
 
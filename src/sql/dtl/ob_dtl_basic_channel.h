@@ -23,6 +23,7 @@
 #include "sql/dtl/ob_dtl_buf_allocator.h"
 #include "sql/dtl/ob_dtl_channel.h"
 #include "sql/dtl/ob_dtl_linked_buffer.h"
+#include "sql/dtl/ob_dtl_column_batch.h"
 #include "share/ob_scanner.h"
 #include "observer/ob_server_struct.h"
 #include "sql/dtl/ob_dtl_rpc_proxy.h"
@@ -74,6 +75,9 @@ static DtlWriterType msg_writer_map[] = {
     CONTROL_WRITER,      // DH_BARRIER_WHOLE_MSG,
     CONTROL_WRITER,      // DH_WINBUF_PIECE_MSG,
     CONTROL_WRITER,      // DH_WINBUF_WHOLE_MSG,
+    CONTROL_WRITER,      // DH_JOIN_FILTER_PIECE_MSG,
+    CONTROL_WRITER,      // DH_JOIN_FILTER_WHOLE_MSG,
+    CHUNK_DATUM_WRITER,  // PX_DATUM_COLUMN, transcoded by ObDtlDatumMsgWriter::serialize()
 };
 
 static_assert(ARRAYSIZEOF(msg_writer_map) == ObDtlMsgType::MAX, "invalid ms_writer_map size");
@@ -233,7 +237,7 @@ public:
 
   OB_INLINE int64_t used()
   {
-    return block_->data_size();
+    return column_size_ > 0 ? column_size_ : block_->data_size();
   }
   OB_INLINE int64_t rows()
   {
@@ -248,12 +252,23 @@ public:
   {
     buffer->msg_type() = ObDtlMsgType::PX_DATUM_ROW;
   }
+  // Rows are still appended to the datum block, and transcoded to PX_DATUM_COLUMN
+  // when the buffer is serialized if the column-wise batch is smaller.
+  void set_column_encode(const bool column_encode)
+  {
+    column_encode_ = column_encode;
+  }
 
 private:
   DtlWriterType type_;
   ObDtlLinkedBuffer* write_buffer_;
   ObChunkDatumStore::Block* block_;
   int write_ret_;
+  uint64_t tenant_id_;
+  bool column_encode_;
+  // size of the column-wise batch after serialize(), 0 if sent in row format
+  int64_t column_size_;
+  ObDtlColumnBatchEncoder encoder_;
 };
 
 OB_INLINE int ObDtlDatumMsgWriter::write(const ObDtlMsg& msg, ObEvalCtx* eval_ctx, const bool is_eof)
@@ -498,6 +513,7 @@ protected:
   ObDtlDatumMsgWriter datum_msg_writer_;
   ObDtlChannelEncoder* msg_writer_;
   sql::ObPxDatumRowIterator datum_row_iter_;
+  sql::ObPxDatumColumnIterator datum_column_iter_;
   sql::ObPxNewRowIterator px_row_iter_;
   sql::ObDtlMsgReader* msg_reader_;
 
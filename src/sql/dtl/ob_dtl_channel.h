@@ -249,6 +249,11 @@ public:
   {
     compressor_type_ = type;
   }
+  // send datum rows in column-wise batches, see ObDtlColumnBatch
+  void set_column_encode(const bool column_encode)
+  {
+    column_encode_ = column_encode;
+  }
 
 protected:
   common::ObThreadCond cond_;
@@ -273,6 +278,7 @@ protected:
   int64_t loop_idx_;
 
   common::ObCompressorType compressor_type_;
+  bool column_encode_;
 
 public:
   // ObDtlChannel is link base, so it add extra link
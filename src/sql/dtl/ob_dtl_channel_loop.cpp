@@ -264,6 +264,19 @@ int ObDtlChannelLoop::process_one(int64_t timeout)
   return process_base(nullptr, hinted_channel, timeout);
 }
 
+int ObDtlChannelLoop::process_one_nonblock()
+{
+  int ret = OB_SUCCESS;
+  int64_t nth_channel = OB_INVALID_INDEX_INT64;
+  if (chans_.count() == 0) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("channel hasn't set", K(ret));
+  } else {
+    ret = process_channel(nth_channel);
+  }
+  return ret;
+}
+
 int ObDtlChannelLoop::process_one_if(ObIDltChannelLoopPred* pred, int64_t timeout, int64_t& ret_channel)
 {
   int ret = OB_SUCCESS;
@@ -64,6 +64,8 @@ public:
   int process_one(int64_t timeout);
   virtual int process_one(int64_t& nth_channel, int64_t timeout);
   virtual int process_one_if(ObIDltChannelLoopPred* proc, int64_t timeout, int64_t& nth_channel);
+  // process one message if any, return OB_EAGAIN without waiting otherwise
+  int process_one_nonblock();
   ObDtlMsgType get_last_msg_type() const
   {
     return static_cast<ObDtlMsgType>(last_msg_type_);
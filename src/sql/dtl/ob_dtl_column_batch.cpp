@@ -0,0 +1,321 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_DTL
+#include "sql/dtl/ob_dtl_column_batch.h"
+#include "lib/hash_func/murmur_hash.h"
+
+namespace oceanbase {
+namespace sql {
+namespace dtl {
+using namespace common;
+
+ObDtlColumnBatchEncoder::ObDtlColumnBatchEncoder() : rows_(), refs_(), buf_(NULL), buf_size_(0)
+{
+  rows_.set_label("DtlColBatch");
+  refs_.set_label("DtlColBatch");
+}
+
+ObDtlColumnBatchEncoder::~ObDtlColumnBatchEncoder()
+{
+  destroy();
+}
+
+void ObDtlColumnBatchEncoder::destroy()
+{
+  rows_.destroy();
+  refs_.destroy();
+  if (NULL != buf_) {
+    ob_free(buf_);
+    buf_ = NULL;
+  }
+  buf_size_ = 0;
+}
+
+int ObDtlColumnBatchEncoder::prepare_buf(const uint64_t tenant_id, const int64_t size, char*& buf)
+{
+  int ret = OB_SUCCESS;
+  if (size > buf_size_) {
+    if (NULL != buf_) {
+      ob_free(buf_);
+      buf_ = NULL;
+      buf_size_ = 0;
+    }
+    ObMemAttr attr(tenant_id, "DtlColBatch");
+    if (OB_ISNULL(buf_ = static_cast<char*>(ob_malloc(size, attr)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("allocate memory failed", K(ret), K(size));
+    } else {
+      buf_size_ = size;
+    }
+  }
+  if (OB_SUCC(ret)) {
+    buf = buf_;
+  }
+  return ret;
+}
+
+int ObDtlColumnBatchEncoder::encode(ObChunkDatumStore::Block* blk, char* buf, const int64_t cap, int64_t& size)
+{
+  int ret = OB_SUCCESS;
+  int64_t col_cnt = -1;
+  rows_.reuse();
+  if (OB_ISNULL(blk) || OB_ISNULL(buf) || 0 == blk->rows()) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(blk), KP(buf));
+  } else {
+    int64_t cur_pos = 0;
+    for (int64_t i = 0; OB_SUCC(ret) && i < blk->rows(); i++) {
+      const ObChunkDatumStore::StoredRow* sr =
+          reinterpret_cast<const ObChunkDatumStore::StoredRow*>(blk->payload_ + cur_pos);
+      if (col_cnt < 0) {
+        col_cnt = sr->cnt_;
+      } else if (OB_UNLIKELY(col_cnt != sr->cnt_)) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("column count mismatch", K(ret), K(col_cnt), K(sr->cnt_));
+      }
+      if (OB_SUCC(ret) && OB_FAIL(rows_.push_back(sr))) {
+        LOG_WARN("push back failed", K(ret));
+      }
+      cur_pos += sr->row_size_;
+    }
+  }
+  if (OB_SUCC(ret)) {
+    int64_t pos = ObDtlColumnBatch::align(sizeof(ObDtlColumnBatch::Head) + sizeof(uint32_t) * col_cnt);
+    if (pos >= cap) {
+      ret = OB_SIZE_OVERFLOW;
+    } else {
+      ObDtlColumnBatch::Head* head = reinterpret_cast<ObDtlColumnBatch::Head*>(buf);
+      uint32_t* col_offsets = reinterpret_cast<uint32_t*>(buf + sizeof(*head));
+      head->magic_ = ObDtlColumnBatch::MAGIC;
+      head->col_cnt_ = static_cast<uint32_t>(col_cnt);
+      head->rows_ = static_cast<uint32_t>(rows_.count());
+      head->reserved_ = 0;
+      for (int64_t col = 0; OB_SUCC(ret) && col < col_cnt; col++) {
+        col_offsets[col] = static_cast<uint32_t>(pos);
+        ret = encode_column(col, buf, cap, pos);
+      }
+      if (OB_SUCC(ret)) {
+        size = pos;
+      }
+    }
+  }
+  return ret;
+}
+
+void ObDtlColumnBatchEncoder::build_dict(const int64_t col, int64_t& dict_cnt, int64_t& dict_data_size)
+{
+  const int64_t rows = rows_.count();
+  dict_cnt = 0;
+  dict_data_size = 0;
+  MEMSET(slots_, -1, sizeof(slots_));
+  if (OB_SUCCESS != refs_.prepare_allocate(rows)) {
+    dict_cnt = -1;
+  }
+  for (int64_t r = 0; dict_cnt >= 0 && r < rows; r++) {
+    const ObDatum& d = rows_.at(r)->cells()[col];
+    if (d.is_null()) {
+      refs_.at(r) = 0;
+    } else {
+      int64_t idx = murmurhash(d.ptr_, d.len_, 0) & (DICT_SLOT_CNT - 1);
+      while (slots_[idx] >= 0 &&
+             !(dict_[slots_[idx]]->len_ == d.len_ && 0 == MEMCMP(dict_[slots_[idx]]->ptr_, d.ptr_, d.len_))) {
+        idx = (idx + 1) & (DICT_SLOT_CNT - 1);
+      }
+      if (slots_[idx] < 0) {
+        // more than half of the values are distinct, dictionary is useless
+        if (dict_cnt >= MAX_DICT_CNT || dict_cnt > (rows >> 1)) {
+          dict_cnt = -1;
+        } else {
+          dict_[dict_cnt] = &d;
+          slots_[idx] = static_cast<int16_t>(dict_cnt++);
+          dict_data_size += d.len_;
+        }
+      }
+      if (dict_cnt >= 0) {
+        refs_.at(r) = static_cast<uint8_t>(slots_[idx]);
+      }
+    }
+  }
+}
+
+int ObDtlColumnBatchEncoder::encode_column(const int64_t col, char* buf, const int64_t cap, int64_t& pos)
+{
+  int ret = OB_SUCCESS;
+  const int64_t rows = rows_.count();
+  bool has_null = false;
+  bool is_fixed = true;
+  int64_t fixed_len = -1;
+  int64_t data_size = 0;
+  for (int64_t r = 0; r < rows; r++) {
+    const ObDatum& d = rows_.at(r)->cells()[col];
+    if (d.is_null()) {
+      has_null = true;
+    } else {
+      data_size += d.len_;
+      if (fixed_len < 0) {
+        fixed_len = d.len_;
+      } else if (fixed_len != d.len_) {
+        is_fixed = false;
+      }
+    }
+  }
+  fixed_len = std::max(fixed_len, 0L);
+  int64_t dict_cnt = -1;
+  int64_t dict_data_size = 0;
+  if (rows >= MIN_DICT_ROWS && (!is_fixed || fixed_len > 1)) {
+    build_dict(col, dict_cnt, dict_data_size);
+  }
+  const int64_t plain_size = is_fixed ? ObDtlColumnBatch::align(rows * fixed_len)
+                                      : ObDtlColumnBatch::align(sizeof(uint32_t) * (rows + 1)) +
+                                            ObDtlColumnBatch::align(data_size);
+  const int64_t dict_size = dict_cnt < 0 ? INT64_MAX
+                                         : ObDtlColumnBatch::align(sizeof(uint32_t) * (dict_cnt + 1)) +
+                                               ObDtlColumnBatch::align(dict_data_size) +
+                                               ObDtlColumnBatch::align(rows);
+  const int64_t null_size = has_null ? ObDtlColumnBatch::bitmap_size(rows) : 0;
+  if (pos + static_cast<int64_t>(sizeof(ObDtlColumnBatch::ColumnHead)) + null_size +
+          std::min(plain_size, dict_size) >= cap) {
+    ret = OB_SIZE_OVERFLOW;
+  } else {
+    ObDtlColumnBatch::ColumnHead* head = reinterpret_cast<ObDtlColumnBatch::ColumnHead*>(buf + pos);
+    pos += sizeof(*head);
+    head->has_null_ = has_null;
+    head->reserved_ = 0;
+    if (has_null) {
+      uint8_t* nulls = reinterpret_cast<uint8_t*>(buf + pos);
+      MEMSET(nulls, 0, null_size);
+      for (int64_t r = 0; r < rows; r++) {
+        if (rows_.at(r)->cells()[col].is_null()) {
+          nulls[r >> 3] |= static_cast<uint8_t>(1 << (r & 7));
+        }
+      }
+      pos += null_size;
+    }
+    if (dict_size < plain_size) {
+      head->encoding_ = ObDtlColumnBatch::DICT;
+      head->len_ = static_cast<uint32_t>(dict_cnt);
+      uint32_t* offsets = reinterpret_cast<uint32_t*>(buf + pos);
+      char* data = buf + pos + ObDtlColumnBatch::align(sizeof(uint32_t) * (dict_cnt + 1));
+      uint32_t off = 0;
+      for (int64_t i = 0; i < dict_cnt; i++) {
+        offsets[i] = off;
+        MEMCPY(data + off, dict_[i]->ptr_, dict_[i]->len_);
+        off += dict_[i]->len_;
+      }
+      offsets[dict_cnt] = off;
+      MEMCPY(data + ObDtlColumnBatch::align(off), refs_.get_data(), rows);
+      pos += dict_size;
+    } else if (is_fixed) {
+      head->encoding_ = ObDtlColumnBatch::FIXED;
+      head->len_ = static_cast<uint32_t>(fixed_len);
+      char* data = buf + pos;
+      for (int64_t r = 0; r < rows; r++) {
+        const ObDatum& d = rows_.at(r)->cells()[col];
+        if (d.is_null()) {
+          MEMSET(data + r * fixed_len, 0, fixed_len);
+        } else {
+          MEMCPY(data + r * fixed_len, d.ptr_, fixed_len);
+        }
+      }
+      pos += plain_size;
+    } else {
+      head->encoding_ = ObDtlColumnBatch::VAR;
+      head->len_ = 0;
+      uint32_t* offsets = reinterpret_cast<uint32_t*>(buf + pos);
+      char* data = buf + pos + ObDtlColumnBatch::align(sizeof(uint32_t) * (rows + 1));
+      uint32_t off = 0;
+      for (int64_t r = 0; r < rows; r++) {
+        const ObDatum& d = rows_.at(r)->cells()[col];
+        offsets[r] = off;
+        if (!d.is_null()) {
+          MEMCPY(data + off, d.ptr_, d.len_);
+          off += d.len_;
+        }
+      }
+      offsets[rows] = off;
+      pos += plain_size;
+    }
+  }
+  return ret;
+}
+
+int ObDtlColumnBatchReader::init(const char* buf, const int64_t size)
+{
+  int ret = OB_SUCCESS;
+  const ObDtlColumnBatch::Head* head = reinterpret_cast<const ObDtlColumnBatch::Head*>(buf);
+  reset();
+  if (OB_ISNULL(buf) || size < static_cast<int64_t>(sizeof(*head))) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(buf), K(size));
+  } else if (OB_UNLIKELY(ObDtlColumnBatch::MAGIC != head->magic_ ||
+                         static_cast<int64_t>(sizeof(*head) + sizeof(uint32_t) * head->col_cnt_) > size)) {
+    ret = OB_INVALID_DATA;
+    LOG_WARN("invalid column batch head", K(ret), K(head->magic_), K(head->col_cnt_), K(size));
+  } else {
+    const int64_t rows = head->rows_;
+    const uint32_t* col_offsets = reinterpret_cast<const uint32_t*>(buf + sizeof(*head));
+    for (int64_t col = 0; OB_SUCC(ret) && col < head->col_cnt_; col++) {
+      int64_t pos = col_offsets[col];
+      Column c;
+      MEMSET(&c, 0, sizeof(c));
+      if (pos + static_cast<int64_t>(sizeof(ObDtlColumnBatch::ColumnHead)) > size) {
+        ret = OB_INVALID_DATA;
+      } else {
+        const ObDtlColumnBatch::ColumnHead* ch = reinterpret_cast<const ObDtlColumnBatch::ColumnHead*>(buf + pos);
+        pos += sizeof(*ch);
+        c.encoding_ = ch->encoding_;
+        c.len_ = ch->len_;
+        if (ch->has_null_) {
+          c.nulls_ = reinterpret_cast<const uint8_t*>(buf + pos);
+          pos += ObDtlColumnBatch::bitmap_size(rows);
+        }
+        if (ObDtlColumnBatch::FIXED == c.encoding_) {
+          c.data_ = buf + pos;
+          pos += ObDtlColumnBatch::align(rows * c.len_);
+        } else if (ObDtlColumnBatch::VAR == c.encoding_ || ObDtlColumnBatch::DICT == c.encoding_) {
+          const int64_t cnt = ObDtlColumnBatch::VAR == c.encoding_ ? rows : c.len_;
+          c.offsets_ = reinterpret_cast<const uint32_t*>(buf + pos);
+          pos += ObDtlColumnBatch::align(sizeof(uint32_t) * (cnt + 1));
+          if (pos > size) {
+            ret = OB_INVALID_DATA;
+          } else {
+            c.data_ = buf + pos;
+            pos += ObDtlColumnBatch::align(c.offsets_[cnt]);
+            if (ObDtlColumnBatch::DICT == c.encoding_) {
+              c.refs_ = reinterpret_cast<const uint8_t*>(buf + pos);
+              pos += ObDtlColumnBatch::align(rows);
+            }
+          }
+        } else {
+          ret = OB_INVALID_DATA;
+        }
+      }
+      if (OB_SUCC(ret) && pos > size) {
+        ret = OB_INVALID_DATA;
+      }
+      if (OB_FAIL(ret)) {
+        LOG_WARN("invalid column", K(ret), K(col), K(pos), K(size), K(c));
+      } else if (OB_FAIL(cols_.push_back(c))) {
+        LOG_WARN("push back failed", K(ret));
+      }
+    }
+    if (OB_SUCC(ret)) {
+      rows_ = rows;
+    }
+  }
+  return ret;
+}
+
+}  // namespace dtl
+}  // namespace sql
+}  // namespace oceanbase
@@ -0,0 +1,152 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OB_DTL_COLUMN_BATCH_H
+#define OB_DTL_COLUMN_BATCH_H
+
+#include "lib/container/ob_se_array.h"
+#include "lib/container/ob_array.h"
+#include "common/object/ob_object.h"
+#include "sql/engine/basic/ob_chunk_datum_store.h"
+
+namespace oceanbase {
+namespace sql {
+namespace dtl {
+
+// Column-wise layout of a PX_DATUM_COLUMN buffer, transcoded from a ChunkDatumStore block:
+//
+//   | Head | col_offset[col_cnt] | column 0 | column 1 | ...
+//
+// Every column is 8 bytes aligned and starts with a ColumnHead, followed by the null
+// bitmap (only if the column has null) and the encoded values:
+//   FIXED: values of the same length, stored one by one (null rows take a slot too)
+//   VAR:   uint32 offset[rows + 1] | data
+//   DICT:  uint32 offset[dict_cnt + 1] | dict data | uint8 ref[rows]
+//
+// Datums are read in place by the receiver, no row is deserialized.
+struct ObDtlColumnBatch {
+  static const uint32_t MAGIC = 0x4c4f4342;  // "BCOL"
+  enum Encoding { FIXED = 0, VAR = 1, DICT = 2 };
+  struct Head {
+    uint32_t magic_;
+    uint32_t col_cnt_;
+    uint32_t rows_;
+    uint32_t reserved_;
+  };
+  struct ColumnHead {
+    uint8_t encoding_;
+    uint8_t has_null_;
+    uint16_t reserved_;
+    uint32_t len_;  // value length of FIXED, dictionary size of DICT
+  };
+  static OB_INLINE int64_t align(const int64_t size)
+  {
+    return (size + 7) & ~7L;
+  }
+  static OB_INLINE int64_t bitmap_size(const int64_t rows)
+  {
+    return align((rows + 7) >> 3);
+  }
+};
+
+class ObDtlColumnBatchEncoder {
+public:
+  static const int64_t MIN_DICT_ROWS = 16;
+  static const int64_t MAX_DICT_CNT = UINT8_MAX;
+  static const int64_t DICT_SLOT_CNT = 512;
+
+public:
+  ObDtlColumnBatchEncoder();
+  ~ObDtlColumnBatchEncoder();
+  void destroy();
+
+  // Encode the swizzled %blk into %buf, fails with OB_SIZE_OVERFLOW if the result
+  // is not smaller than %cap, the caller keeps the row format then.
+  int encode(ObChunkDatumStore::Block* blk, char* buf, const int64_t cap, int64_t& size);
+
+  // scratch buffer for encode(), kept between buffers of the same channel
+  int prepare_buf(const uint64_t tenant_id, const int64_t size, char*& buf);
+
+private:
+  int encode_column(const int64_t col, char* buf, const int64_t cap, int64_t& pos);
+  // build dictionary and refs_ of the column, %dict_cnt is -1 if too many distinct values
+  void build_dict(const int64_t col, int64_t& dict_cnt, int64_t& dict_data_size);
+
+private:
+  common::ObArray<const ObChunkDatumStore::StoredRow*> rows_;
+  common::ObArray<uint8_t> refs_;
+  const common::ObDatum* dict_[MAX_DICT_CNT];
+  int16_t slots_[DICT_SLOT_CNT];
+  char* buf_;
+  int64_t buf_size_;
+
+  DISALLOW_COPY_AND_ASSIGN(ObDtlColumnBatchEncoder);
+};
+
+class ObDtlColumnBatchReader {
+public:
+  ObDtlColumnBatchReader() : rows_(0), cols_()
+  {}
+  ~ObDtlColumnBatchReader() = default;
+  int init(const char* buf, const int64_t size);
+  void reset()
+  {
+    rows_ = 0;
+    cols_.reuse();
+  }
+  int64_t get_rows() const
+  {
+    return rows_;
+  }
+  int64_t get_col_cnt() const
+  {
+    return cols_.count();
+  }
+  OB_INLINE void get_datum(const int64_t col, const int64_t row, common::ObDatum& datum) const
+  {
+    const Column& c = cols_.at(col);
+    if (NULL != c.nulls_ && (c.nulls_[row >> 3] & (1 << (row & 7)))) {
+      datum.set_null();
+    } else if (ObDtlColumnBatch::FIXED == c.encoding_) {
+      datum.ptr_ = c.data_ + row * c.len_;
+      datum.pack_ = c.len_;
+    } else if (ObDtlColumnBatch::VAR == c.encoding_) {
+      datum.ptr_ = c.data_ + c.offsets_[row];
+      datum.pack_ = c.offsets_[row + 1] - c.offsets_[row];
+    } else {
+      const uint8_t ref = c.refs_[row];
+      datum.ptr_ = c.data_ + c.offsets_[ref];
+      datum.pack_ = c.offsets_[ref + 1] - c.offsets_[ref];
+    }
+  }
+
+private:
+  struct Column {
+    TO_STRING_KV(K_(encoding), K_(len), KP_(nulls), KP_(data));
+    uint8_t encoding_;
+    uint32_t len_;
+    const uint8_t* nulls_;
+    const char* data_;
+    const uint32_t* offsets_;
+    const uint8_t* refs_;
+  };
+  int64_t rows_;
+  common::ObSEArray<Column, 16> cols_;
+
+  DISALLOW_COPY_AND_ASSIGN(ObDtlColumnBatchReader);
+};
+
+}  // namespace dtl
+}  // namespace sql
+}  // namespace oceanbase
+
+#endif /* OB_DTL_COLUMN_BATCH_H */
@@ -61,6 +61,9 @@ int ObDtlFlowControl::init(uint64_t tenant_id, int64_t chan_cnt)
     if (tenant_config.is_valid() && true == tenant_config->_px_message_compression) {
       compressor_type_ = ObCompressorType::LZ4_COMPRESSOR;
     }
+    if (tenant_config.is_valid()) {
+      column_encode_ = tenant_config->_px_datum_column_encode;
+    }
     is_init_ = true;
     tenant_id_ = tenant_id;
     timeout_ts_ = 0;
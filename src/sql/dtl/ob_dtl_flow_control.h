@@ -86,6 +86,7 @@ public:
         timeout_ts_(0),
         communicate_flag_(0),
         compressor_type_(common::ObCompressorType::NONE_COMPRESSOR),
+        column_encode_(false),
         is_init_(false),
         block_ch_cnt_(0),
         total_memory_size_(0),
@@ -318,6 +319,10 @@ public:
   {
     return compressor_type_;
   }
+  bool is_column_encode() const
+  {
+    return column_encode_;
+  }
 
 private:
   static const int64_t THRESHOLD_SIZE = 2097152;
@@ -328,6 +333,7 @@ private:
   // mark flag for transmit,receive,qc etc
   int communicate_flag_;
   common::ObCompressorType compressor_type_;
+  bool column_encode_;
   bool is_init_;
   int64_t block_ch_cnt_;
   int64_t total_memory_size_;
@@ -2903,19 +2903,15 @@ bool ObGroupRowHashTable::compare(const ObGroupRowItem& left, const ObGroupRowIt
 
 const ObGroupRowItem* ObGroupRowHashTable::get(const ObGroupRowItem& item) const
 {
-  ObGroupRowItem* res = NULL;
-  if (OB_UNLIKELY(NULL == buckets_)) {
-    // do nothing
+  const ObGroupRowItem* res = NULL;
+  const uint64_t hash_val = item.hash();
+  if (is_int_key_ && NULL_INT_KEY_HASH != hash_val) {
+    // same hash value means the same non NULL integer key
+    auto equal = [](const ObGroupRowItem&) { return true; };
+    res = probe(hash_val, equal);
   } else {
-    const uint64_t hash_val = item.hash();
-    ObGroupRowItem* bucket = buckets_->at(hash_val & (get_bucket_num() - 1));
-    while (NULL != bucket) {
-      if (hash_val == bucket->hash() && compare(*bucket, item)) {
-        res = bucket;
-        break;
-      }
-      bucket = bucket->next();
-    }
+    auto equal = [&](const ObGroupRowItem& bucket_item) { return compare(bucket_item, item); };
+    res = probe(hash_val, equal);
   }
   return res;
 }
@@ -509,7 +509,7 @@ private:
 // Used for calc hash for columns
 class ObGroupRowItem {
 public:
-  ObGroupRowItem() : group_id_(0), group_row_ptr_(NULL), groupby_datums_hash_(0), next_(NULL)
+  ObGroupRowItem() : group_id_(0), group_row_ptr_(NULL), groupby_datums_hash_(0)
   {}
 
   ~ObGroupRowItem()
@@ -518,12 +518,8 @@ public:
   {
     return groupby_datums_hash_;
   }
-  ObGroupRowItem*& next()
-  {
-    return *reinterpret_cast<ObGroupRowItem**>(&next_);
-  };
 
-  TO_STRING_KV(K_(group_id), KPC_(group_row), K_(groupby_datums_hash), KP_(group_exprs), KP_(next));
+  TO_STRING_KV(K_(group_id), KPC_(group_row), K_(groupby_datums_hash), KP_(group_exprs));
 
 public:
   int64_t group_id_;
@@ -533,18 +529,45 @@ public:
     ExprFixedArray* group_exprs_;
   };
   uint64_t groupby_datums_hash_;
-  void* next_;
 };
 
 class ObGroupRowHashTable : public ObExtendHashTable<ObGroupRowItem> {
 public:
-  ObGroupRowHashTable() : ObExtendHashTable(), eval_ctx_(nullptr), cmp_funcs_(nullptr)
+  // Hash value of NULL key for single integer key, see calc_int_key_hash().
+  const static uint64_t NULL_INT_KEY_HASH = 99194853094755497L;
+
+  ObGroupRowHashTable() : ObExtendHashTable(), eval_ctx_(nullptr), cmp_funcs_(nullptr), is_int_key_(false)
   {}
 
   const ObGroupRowItem* get(const ObGroupRowItem& item) const;
   int init(ObIAllocator* allocator, lib::ObMemAttr& mem_attr, ObEvalCtx* eval_ctx,
       const common::ObIArray<ObCmpFunc>* cmp_funcs, ObSqlMemMgrProcessor *sql_mem_processor,
       int64_t initial_size = INITIAL_SIZE);
+  // Group by single fixed width integer key (int/uint type class). The hash value of non NULL
+  // key is calculated by a bijective mix function, so items with the same hash value are the
+  // same key and the key comparison is skipped in probing.
+  void set_int_key(const bool is_int_key)
+  {
+    is_int_key_ = is_int_key;
+  }
+  bool is_int_key() const
+  {
+    return is_int_key_;
+  }
+  // Murmur3 64 bit finalizer, which is bijective.
+  OB_INLINE static uint64_t calc_int_key_hash(const ObDatum& datum)
+  {
+    uint64_t h = NULL_INT_KEY_HASH;
+    if (!datum.is_null()) {
+      h = static_cast<uint64_t>(*datum.int_);
+      h ^= h >> 33;
+      h *= 0xff51afd7ed558ccdULL;
+      h ^= h >> 33;
+      h *= 0xc4ceb9fe1a85ec53ULL;
+      h ^= h >> 33;
+    }
+    return h;
+  }
 
 private:
   bool compare(const ObGroupRowItem& left, const ObGroupRowItem& right) const;
@@ -552,6 +575,7 @@ private:
 private:
   ObEvalCtx* eval_ctx_;
   const common::ObIArray<ObCmpFunc>* cmp_funcs_;
+  bool is_int_key_;
 };
 
 struct ObAggregateCalcFunc {
@@ -30,13 +30,31 @@ class ObRowStore;
 
 namespace sql {
 
-// Auto extended hash table, extend to double buckets size if hash table is quarter filled.
+// Auto extended open addressing hash table, extend to double buckets size if hash table is half filled.
+//
+// Buckets are probed linearly, the hash value of item is stored in bucket as tag. Buckets with
+// different hash value are skipped without touching the item, so most probes read one cache line.
 template <typename Item>
 class ObExtendHashTable {
 public:
   const static int64_t INITIAL_SIZE = 128;
-  const static int64_t SIZE_BUCKET_SCALE = 4;
+  const static int64_t SIZE_BUCKET_SCALE = 2;
   const static int64_t MAX_MEM_PERCENT = 40;
+  // Buckets are extended beyond the memory bound if the load factor exceed 3/4, linear probing
+  // degrades quickly when the table is almost full.
+  const static int64_t MAX_LOAD_PERCENT = 75;
+  // Prefetch the bucket of the key which is %PREFETCH_DISTANCE keys ahead in batched probing.
+  const static int64_t PREFETCH_DISTANCE = 8;
+
+  struct Bucket {
+    Bucket() : hash_(0), item_(NULL)
+    {}
+    TO_STRING_KV(K_(hash), KP_(item));
+
+    uint64_t hash_;
+    Item* item_;
+  };
+
   ObExtendHashTable() : initial_bucket_num_(0), size_(0), buckets_(NULL), allocator_(NULL),
   sql_mem_processor_(nullptr)
   {}
@@ -53,9 +71,21 @@ public:
   }
   // return the first item which equal to, NULL for none exist.
   const Item* get(const Item& item) const;
-  // Link item to hash table, extend buckets if needed.
+  // return the first item with hash value %hash_val and accepted by %equal (called as
+  // equal(const Item &)), NULL for none exist.
+  template <typename EQUAL>
+  const Item* probe(const uint64_t hash_val, EQUAL& equal) const;
+  // Put item to hash table, extend buckets if needed.
   // (Do not check item is exist or not)
   int set(Item& item);
+  // Issue software prefetch for the bucket of %hash_val, used by batched probing to hide the
+  // cache miss of the following keys.
+  inline void prefetch(const uint64_t hash_val) const
+  {
+    if (OB_LIKELY(NULL != buckets_)) {
+      __builtin_prefetch(&buckets_->at(hash_val & (get_bucket_num() - 1)), 0 /* read */, 1 /* low locality */);
+    }
+  }
   int64_t size() const
   {
     return size_;
@@ -106,13 +136,9 @@ public:
       SQL_ENG_LOG(WARN, "invalid null buckets", K(ret), K(buckets_));
     }
     for (int64_t i = 0; OB_SUCC(ret) && i < get_bucket_num(); i++) {
-      Item* item = buckets_->at(i);
-      while (NULL != item && OB_SUCC(ret)) {
-        if (OB_FAIL(cb(*item))) {
-          SQL_ENG_LOG(WARN, "call back failed", K(ret));
-        } else {
-          item = item->next();
-        }
+      Item* item = buckets_->at(i).item_;
+      if (NULL != item && OB_FAIL(cb(*item))) {
+        SQL_ENG_LOG(WARN, "call back failed", K(ret));
       }
     }
     return ret;
@@ -120,7 +146,7 @@ public:
 
 protected:
   DISALLOW_COPY_AND_ASSIGN(ObExtendHashTable);
-  int extend();
+  int extend(const bool force = false);
   int64_t estimate_bucket_num(
       const int64_t bucket_num,
       const int64_t max_hash_mem);
@@ -129,7 +155,7 @@ protected:
   lib::ObMemAttr mem_attr_;
   int64_t initial_bucket_num_;
   int64_t size_;
-  using BucketArray = common::ObSegmentArray<Item*, OB_MALLOC_BIG_BLOCK_SIZE, common::ModulePageAllocator>;
+  using BucketArray = common::ObSegmentArray<Bucket, OB_MALLOC_BIG_BLOCK_SIZE, common::ModulePageAllocator>;
   BucketArray* buckets_;
   common::ModulePageAllocator allocator_;
   ObSqlMemMgrProcessor *sql_mem_processor_;
@@ -142,10 +168,10 @@ int64_t ObExtendHashTable<Item>::estimate_bucket_num(
 {
   int64_t max_bound_size = max_hash_mem * MAX_MEM_PERCENT / 100;
   int64_t est_bucket_num = common::next_pow2(bucket_num);
-  int64_t est_size = est_bucket_num * sizeof(void*);
+  int64_t est_size = est_bucket_num * sizeof(Bucket);
   while (est_size > max_bound_size) {
     est_bucket_num >>= 1;
-    est_size = est_bucket_num * sizeof(void*);
+    est_size = est_bucket_num * sizeof(Bucket);
   }
   if (est_bucket_num < INITIAL_SIZE) {
     est_bucket_num = INITIAL_SIZE;
@@ -205,27 +231,39 @@ int ObExtendHashTable<Item>::resize(ObIAllocator* allocator, int64_t bucket_num,
 }
 
 template <typename Item>
-const Item* ObExtendHashTable<Item>::get(const Item& item) const
+template <typename EQUAL>
+const Item* ObExtendHashTable<Item>::probe(const uint64_t hash_val, EQUAL& equal) const
 {
   Item* res = NULL;
   if (NULL == buckets_) {
     // do nothing
   } else {
-    common::hash::hash_func<Item> hf;
-    common::hash::equal_to<Item> eqf;
-    const uint64_t hash_val = hf(item);
-    Item* bucket = buckets_->at(hash_val & (get_bucket_num() - 1));
-    while (NULL != bucket) {
-      if (hash_val == hf(*bucket) && eqf(*bucket, item)) {
-        res = bucket;
+    const int64_t mask = get_bucket_num() - 1;
+    int64_t pos = hash_val & mask;
+    // table is never full (see MAX_LOAD_PERCENT), empty bucket terminates the probing.
+    while (true) {
+      const Bucket& bucket = buckets_->at(pos);
+      if (NULL == bucket.item_) {
+        break;
+      } else if (hash_val == bucket.hash_ && equal(*bucket.item_)) {
+        res = bucket.item_;
         break;
       }
-      bucket = bucket->next();
+      pos = (pos + 1) & mask;
     }
   }
   return res;
 }
 
+template <typename Item>
+const Item* ObExtendHashTable<Item>::get(const Item& item) const
+{
+  common::hash::hash_func<Item> hf;
+  common::hash::equal_to<Item> eqf;
+  auto equal = [&](const Item& bucket_item) { return eqf(bucket_item, item); };
+  return probe(hf(item), equal);
+}
+
 template <typename Item>
 int ObExtendHashTable<Item>::set(Item& item)
 {
@@ -234,6 +272,8 @@ int ObExtendHashTable<Item>::set(Item& item)
   if (size_ * SIZE_BUCKET_SCALE >= get_bucket_num()) {
     if (OB_FAIL(extend())) {
       SQL_ENG_LOG(WARN, "extend failed", K(ret));
+    } else if ((size_ + 1) * 100 > get_bucket_num() * MAX_LOAD_PERCENT && OB_FAIL(extend(true /* force */))) {
+      SQL_ENG_LOG(WARN, "force extend failed", K(ret));
     }
   }
   if (OB_FAIL(ret)) {
@@ -242,24 +282,32 @@ int ObExtendHashTable<Item>::set(Item& item)
     ret = OB_INVALID_ARGUMENT;
     SQL_ENG_LOG(WARN, "invalid argument", K(ret), K(buckets_));
   } else {
-    Item*& bucket = buckets_->at(hf(item) & (get_bucket_num() - 1));
-    item.next() = bucket;
-    bucket = &item;
+    const uint64_t hash_val = hf(item);
+    const int64_t mask = get_bucket_num() - 1;
+    int64_t pos = hash_val & mask;
+    while (NULL != buckets_->at(pos).item_) {
+      pos = (pos + 1) & mask;
+    }
+    Bucket& bucket = buckets_->at(pos);
+    bucket.hash_ = hash_val;
+    bucket.item_ = &item;
     size_ += 1;
   }
   return ret;
 }
 
 template <typename Item>
-int ObExtendHashTable<Item>::extend()
+int ObExtendHashTable<Item>::extend(const bool force /* false */)
 {
-  common::hash::hash_func<Item> hf;
   int ret = common::OB_SUCCESS;
   int64_t pre_bucket_num = get_bucket_num();
   int64_t new_bucket_num = 0 == pre_bucket_num ?
                           (0 == initial_bucket_num_ ? INITIAL_SIZE : initial_bucket_num_)
                           : pre_bucket_num * 2;
   new_bucket_num = estimate_bucket_num(new_bucket_num, sql_mem_processor_->get_mem_bound());
+  if (force && new_bucket_num <= pre_bucket_num) {
+    new_bucket_num = pre_bucket_num * 2;
+  }
   if (new_bucket_num <= pre_bucket_num) {
   } else {
     BucketArray* new_buckets = NULL;
@@ -278,14 +326,15 @@ int ObExtendHashTable<Item>::extend()
     } else if (OB_FAIL(new_buckets->init(new_bucket_num))) {
       SQL_ENG_LOG(WARN, "resize bucket array failed", K(ret), K(new_bucket_num));
     } else {
+      const int64_t mask = new_bucket_num - 1;
       for (int64_t i = 0; i < get_bucket_num(); i++) {
-        Item* bucket = buckets_->at(i);
-        while (bucket != NULL) {
-          Item* item = bucket;
-          bucket = bucket->next();
-          Item*& new_bucket = new_buckets->at(hf(*item) & (new_bucket_num - 1));
-          item->next() = new_bucket;
-          new_bucket = item;
+        const Bucket& bucket = buckets_->at(i);
+        if (NULL != bucket.item_) {
+          int64_t pos = bucket.hash_ & mask;
+          while (NULL != new_buckets->at(pos).item_) {
+            pos = (pos + 1) & mask;
+          }
+          new_buckets->at(pos) = bucket;
         }
       }
       buckets_->destroy();
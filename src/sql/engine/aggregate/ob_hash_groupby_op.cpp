@@ -106,6 +106,10 @@ int ObHashGroupByOp::inner_open()
                    0))) {
       LOG_WARN("failed to init group store", K(ret));
     } else {
+      const ObExpr* first_group_expr = MY_SPEC.group_exprs_.count() > 0 ? MY_SPEC.group_exprs_.at(0) : NULL;
+      local_group_rows_.set_int_key(1 == MY_SPEC.group_exprs_.count() && NULL != first_group_expr &&
+                                    (ob_is_int_tc(first_group_expr->datum_meta_.type_) ||
+                                        ob_is_uint_tc(first_group_expr->datum_meta_.type_)));
       group_store_.set_dir_id(sql_mem_processor_.get_dir_id());
       group_store_.set_callback(&sql_mem_processor_);
       group_store_.set_allocator(mem_context_->get_malloc_allocator());
@@ -122,6 +126,15 @@ int ObHashGroupByOp::inner_open()
           K(sql_mem_processor_.get_mem_bound()));
     }
   }
+  if (OB_SUCC(ret) && child_->get_spec().is_vectorized() && NULL == batch_hash_vals_) {
+    const int64_t size = sizeof(*batch_hash_vals_) * child_->get_spec().max_batch_size_;
+    if (OB_ISNULL(batch_hash_vals_ = static_cast<uint64_t*>(ctx_.get_allocator().alloc(size)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("allocate memory failed", K(ret), K(size));
+    } else {
+      MEMSET(batch_hash_vals_, 0, size);
+    }
+  }
   return ret;
 }
 
@@ -274,6 +287,55 @@ int ObHashGroupByOp::inner_get_next_row()
   return ret;
 }
 
+int ObHashGroupByOp::inner_get_next_batch(const int64_t max_row_cnt)
+{
+  int ret = OB_SUCCESS;
+  ObEvalCtx::BatchInfoScopeGuard batch_info_guard(eval_ctx_);
+  batch_info_guard.set_batch_size(max_row_cnt);
+  int64_t row_cnt = 0;
+  while (OB_SUCC(ret) && row_cnt < max_row_cnt) {
+    // The group rows are released when switching to the next dumped partition or at iterate end,
+    // stop the batch before it.
+    if (row_cnt > 0 && curr_group_id_ + 1 >= local_group_rows_.size()) {
+      break;
+    }
+    batch_info_guard.set_batch_idx(row_cnt);
+    clear_evaluated_flag();
+    if (OB_FAIL(inner_get_next_row())) {
+      if (OB_ITER_END != ret) {
+        LOG_WARN("get next row failed", K(ret), K(row_cnt));
+      }
+    } else {
+      ++row_cnt;
+    }
+  }
+  if (OB_ITER_END == ret) {
+    ret = OB_SUCCESS;
+    brs_.end_ = true;
+  }
+  if (OB_SUCC(ret)) {
+    brs_.size_ = row_cnt;
+    if (row_cnt > 0) {
+      // group by exprs and aggregate results are filled row by row, mark them projected
+      FOREACH_CNT(e, MY_SPEC.group_exprs_)
+      {
+        if ((*e)->is_batch_result()) {
+          (*e)->get_eval_info(eval_ctx_).projected_ = true;
+          (*e)->get_eval_info(eval_ctx_).cnt_ = row_cnt;
+        }
+      }
+      FOREACH_CNT(aggr_info, MY_SPEC.aggr_infos_)
+      {
+        if (NULL != aggr_info->expr_ && aggr_info->expr_->is_batch_result()) {
+          aggr_info->expr_->get_eval_info(eval_ctx_).projected_ = true;
+          aggr_info->expr_->get_eval_info(eval_ctx_).cnt_ = row_cnt;
+        }
+      }
+    }
+  }
+  return ret;
+}
+
 int ObHashGroupByOp::load_data()
 {
   int ret = OB_SUCCESS;
@@ -337,9 +399,19 @@ int ObHashGroupByOp::load_data()
   bool check_dump = false;
   ObGbyBloomFilter* bloom_filter = NULL;
   const ObChunkDatumStore::StoredRow* srow = NULL;
+  // Consume the child batches directly for vectorized child, rows of dumped partition are
+  // always located at batch index zero.
+  const bool batch_input = NULL == cur_part && child_->get_spec().is_vectorized();
+  ObEvalCtx::BatchInfoScopeGuard batch_info_guard(eval_ctx_);
+  batch_info_guard.set_batch_idx(0);
+  batch_info_guard.set_batch_size(1);
+  const ObBatchRows* child_brs = NULL;
+  int64_t batch_row_idx = -1;
 
   for (int64_t loop_cnt = 0; OB_SUCC(ret); ++loop_cnt) {
-    if (NULL == cur_part) {
+    if (batch_input) {
+      ret = get_next_batch_input_row(batch_info_guard, child_brs, batch_row_idx);
+    } else if (NULL == cur_part) {
       ret = child_->get_next_row();
     } else {
       ret = row_store_iter.get_next_row(child_->get_spec().output_, eval_ctx_, &srow);
@@ -368,6 +440,8 @@ int ObHashGroupByOp::load_data()
     if (OB_SUCC(ret)) {
       if (NULL != srow) {
         curr_gr_item.groupby_datums_hash_ = *static_cast<uint64_t*>(srow->get_extra_payload());
+      } else if (batch_input) {
+        curr_gr_item.groupby_datums_hash_ = batch_hash_vals_[batch_row_idx];
       } else {
         if (OB_FAIL(calc_groupby_exprs_hash(curr_gr_item.groupby_datums_hash_))) {
           LOG_WARN("failed to get_groupby_exprs_hash", K(ret));
@@ -572,21 +646,74 @@ void ObHashGroupByOp::adjust_part_cnt(int64_t& part_cnt)
       "trace adjust part cnt", K(part_cnt), K(max_part_cnt), K(dumped_remain_mem_size), K(mem_bound), K(mem_used));
 }
 
+int ObHashGroupByOp::get_next_batch_input_row(
+    ObEvalCtx::BatchInfoScopeGuard& guard, const ObBatchRows*& child_brs, int64_t& row_idx)
+{
+  int ret = OB_SUCCESS;
+  bool got_row = false;
+  const int64_t prefetch_distance = ObGroupRowHashTable::PREFETCH_DISTANCE;
+  while (OB_SUCC(ret) && !got_row) {
+    if (NULL != child_brs && row_idx + 1 < child_brs->size_) {
+      ++row_idx;
+      if (row_idx + prefetch_distance < child_brs->size_) {
+        local_group_rows_.prefetch(batch_hash_vals_[row_idx + prefetch_distance]);
+      }
+      if (!child_brs->skip_->at(row_idx)) {
+        guard.set_batch_idx(row_idx);
+        got_row = true;
+      }
+    } else if (NULL != child_brs && child_brs->end_) {
+      ret = OB_ITER_END;
+    } else if (OB_FAIL(child_->get_next_batch(child_->get_spec().max_batch_size_, child_brs))) {
+      LOG_WARN("get next batch failed", K(ret));
+    } else {
+      // calc exprs of this operator may be projected by last batch
+      clear_evaluated_projected_flag();
+      row_idx = -1;
+      guard.set_batch_size(child_brs->size_);
+      for (int64_t i = 0; OB_SUCC(ret) && i < child_brs->size_; i++) {
+        if (child_brs->skip_->at(i)) {
+          batch_hash_vals_[i] = 0;
+        } else {
+          guard.set_batch_idx(i);
+          clear_evaluated_flag();
+          if (OB_FAIL(calc_groupby_exprs_hash(batch_hash_vals_[i]))) {
+            LOG_WARN("failed to calc groupby exprs hash", K(ret), K(i));
+          }
+        }
+      }
+      for (int64_t i = 0; OB_SUCC(ret) && i < std::min(prefetch_distance, child_brs->size_); i++) {
+        local_group_rows_.prefetch(batch_hash_vals_[i]);
+      }
+    }
+  }
+  return ret;
+}
+
 int ObHashGroupByOp::calc_groupby_exprs_hash(uint64_t& hash_value)
 {
   int ret = OB_SUCCESS;
   hash_value = 99194853094755497L;
-  for (int64_t i = 0; OB_SUCC(ret) && i < MY_SPEC.group_exprs_.count(); ++i) {
-    ObExpr* expr = MY_SPEC.group_exprs_.at(i);
+  if (local_group_rows_.is_int_key()) {
     ObDatum* result = NULL;
-    if (OB_ISNULL(expr) || OB_ISNULL(expr->basic_funcs_)) {
-      ret = OB_ERR_UNEXPECTED;
-      LOG_WARN("expr node is null", K(ret));
-    } else if (OB_FAIL(expr->eval(eval_ctx_, result))) {
+    if (OB_FAIL(MY_SPEC.group_exprs_.at(0)->eval(eval_ctx_, result))) {
       LOG_WARN("eval failed", K(ret));
     } else {
-      ObExprHashFuncType hash_func = expr->basic_funcs_->murmur_hash_;
-      hash_value = hash_func(*result, hash_value);
+      hash_value = ObGroupRowHashTable::calc_int_key_hash(*result);
+    }
+  } else {
+    for (int64_t i = 0; OB_SUCC(ret) && i < MY_SPEC.group_exprs_.count(); ++i) {
+      ObExpr* expr = MY_SPEC.group_exprs_.at(i);
+      ObDatum* result = NULL;
+      if (OB_ISNULL(expr) || OB_ISNULL(expr->basic_funcs_)) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("expr node is null", K(ret));
+      } else if (OB_FAIL(expr->eval(eval_ctx_, result))) {
+        LOG_WARN("eval failed", K(ret));
+      } else {
+        ObExprHashFuncType hash_func = expr->basic_funcs_->murmur_hash_;
+        hash_value = hash_func(*result, hash_value);
+      }
     }
   }
   return ret;
@@ -84,7 +84,8 @@ public:
         agged_dumped_cnt_(0),
         profile_(ObSqlWorkAreaType::HASH_WORK_AREA),
         sql_mem_processor_(profile_),
-        iter_end_(false)
+        iter_end_(false),
+        batch_hash_vals_(NULL)
   {}
   void reset();
   virtual int inner_open() override;
@@ -92,6 +93,9 @@ public:
   virtual int rescan() override;
   virtual int switch_iterator() override;
   virtual int inner_get_next_row() override;
+  // Output group rows in batch, the batch stops before switching to the next dumped partition,
+  // since the memory of the group rows is released then.
+  virtual int inner_get_next_batch(const int64_t max_row_cnt) override;
   virtual void destroy() override;
   int load_data();
 
@@ -146,7 +150,7 @@ public:
   }
   OB_INLINE int64_t estimate_hash_bucket_size(const int64_t bucket_cnt) const
   {
-    return next_pow2(ObGroupRowHashTable::SIZE_BUCKET_SCALE * bucket_cnt) * sizeof(void*);
+    return next_pow2(ObGroupRowHashTable::SIZE_BUCKET_SCALE * bucket_cnt) * sizeof(ObGroupRowHashTable::Bucket);
   }
   OB_INLINE int64_t estimate_hash_bucket_cnt_by_mem_size(
       const int64_t bucket_cnt, const int64_t max_mem_size, const double extra_ratio) const
@@ -158,7 +162,7 @@ public:
         mem_size >>= 1;
       }
     }
-    return (mem_size / sizeof(void*) / ObGroupRowHashTable::SIZE_BUCKET_SCALE);
+    return (mem_size / sizeof(ObGroupRowHashTable::Bucket) / ObGroupRowHashTable::SIZE_BUCKET_SCALE);
   }
   int init_group_store();
   int update_mem_status_periodically(
@@ -167,6 +171,11 @@ public:
   void calc_data_mem_ratio(const int64_t part_cnt, double& data_ratio);
   void adjust_part_cnt(int64_t& part_cnt);
   int calc_groupby_exprs_hash(uint64_t& hash_value);
+  // Get next row from child batches (vectorized child), the batch index of %guard is set to the
+  // row returned. Hash values of the whole batch are calculated when the batch fetched, so the
+  // buckets of the following rows can be prefetched while the current row is probing.
+  int get_next_batch_input_row(
+      ObEvalCtx::BatchInfoScopeGuard& guard, const ObBatchRows*& child_brs, int64_t& row_idx);
   int init_group_row_item(const ObGroupRowItem& curr_item, ObGroupRowItem*& gr_row_item);
   bool need_start_dump(const int64_t input_rows, int64_t& est_part_cnt, const bool check_dump);
   // Setup: memory entity, bloom filter, spill partitions
@@ -198,6 +207,8 @@ private:
   ObSqlWorkAreaProfile profile_;
   ObSqlMemMgrProcessor sql_mem_processor_;
   bool iter_end_;
+  // hash values of the child batch rows, for vectorized child only
+  uint64_t* batch_hash_vals_;
 };
 
 }  // end namespace sql
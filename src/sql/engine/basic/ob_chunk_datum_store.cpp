@@ -17,7 +17,9 @@
 #include "sql/engine/basic/ob_chunk_row_store.h"
 #include "lib/container/ob_se_array_iterator.h"
 #include "lib/utility/ob_tracepoint.h"
+#include "lib/compress/ob_compressor_pool.h"
 #include "share/config/ob_server_config.h"
+#include "observer/omt/ob_tenant_config_mgr.h"
 
 namespace oceanbase {
 using namespace common;
@@ -407,7 +409,12 @@ ObChunkDatumStore::ObChunkDatumStore(common::ObIAllocator* alloc /* = NULL */)
       mem_used_(0),
       allocator_(NULL == alloc ? &inner_allocator_ : alloc),
       row_extend_size_(0),
-      callback_(nullptr)
+      callback_(nullptr),
+      compressor_type_(INVALID_COMPRESSOR),
+      compressor_(NULL),
+      compress_buf_(NULL),
+      compress_buf_size_(0),
+      dump_saved_size_(0)
 {
   io_.fd_ = -1;
   io_.dir_id_ = -1;
@@ -435,6 +442,7 @@ int ObChunkDatumStore::init(int64_t mem_limit, uint64_t tenant_id /* = common::O
   min_blk_size_ = INT64_MAX;
   io_.fd_ = -1;
   row_extend_size_ = row_extend_size;
+  file_blk_sizes_.set_label(label);
   return ret;
 }
 
@@ -452,6 +460,15 @@ void ObChunkDatumStore::reset()
   }
   file_size_ = 0;
   n_block_in_file_ = 0;
+  file_blk_sizes_.reset();
+  compressor_ = NULL;
+  dump_saved_size_ = 0;
+  if (NULL != compress_buf_) {
+    callback_free(compress_buf_size_);
+    allocator_->free(compress_buf_);
+    compress_buf_ = NULL;
+    compress_buf_size_ = 0;
+  }
 
   while (!blocks_.is_empty()) {
     Block* item = blocks_.remove_first();
@@ -650,13 +667,139 @@ inline int ObChunkDatumStore::dump_one_block(BlockBuffer* item)
     LOG_WARN("unexpected: dump zero", K(item), K(item->cur_pos_));
   }
   item->block->magic_ = Block::MAGIC;
+  char* buf = item->data();
+  int64_t size = item->capacity();
   if (OB_FAIL(item->get_block()->unswizzling())) {
     LOG_WARN("convert block to copyable failed", K(ret));
-  } else if (OB_FAIL(write_file(item->data(), item->capacity()))) {
+  } else if (!is_file_open() && OB_FAIL(init_compressor())) {
+    LOG_WARN("init compressor failed", K(ret));
+  } else if (NULL != compressor_ && OB_FAIL(compress_block(item, buf, size))) {
+    LOG_WARN("compress block failed", K(ret));
+  } else if (OB_FAIL(write_file(buf, size))) {
     LOG_WARN("write block to file failed");
+  } else if (NULL != compressor_ && OB_FAIL(file_blk_sizes_.push_back(static_cast<uint32_t>(size)))) {
+    LOG_WARN("array push back failed", K(ret));
   } else {
     n_block_in_file_++;
-    LOG_DEBUG("RowStore Dumpped block", K_(item->block->rows), K_(item->cur_pos), K(item->capacity()));
+    LOG_DEBUG("RowStore Dumpped block", K_(item->block->rows), K_(item->cur_pos), K(item->capacity()), K(size));
+  }
+  return ret;
+}
+
+int ObChunkDatumStore::init_compressor()
+{
+  int ret = OB_SUCCESS;
+  ObCompressorType type = compressor_type_;
+  compressor_ = NULL;
+  if (INVALID_COMPRESSOR == type) {
+    type = NONE_COMPRESSOR;
+    omt::ObTenantConfigGuard tenant_config(TENANT_CONF(tenant_id_));
+    if (tenant_config.is_valid() && OB_FAIL(ObCompressorPool::get_instance().get_compressor_type(
+                                        tenant_config->_chunk_row_store_compress_func.str(), type))) {
+      LOG_WARN("get compressor type failed", K(ret), K_(tenant_id));
+    }
+  }
+  if (OB_SUCC(ret) && NONE_COMPRESSOR != type) {
+    if (OB_FAIL(ObCompressorPool::get_instance().get_compressor(type, compressor_))) {
+      LOG_WARN("get compressor failed", K(ret), K(type));
+    }
+  }
+  return ret;
+}
+
+// Compress the payload of block to %compress_buf_, %buf and %size are left unchanged
+// (dump the raw block) if compression doesn't save space.
+int ObChunkDatumStore::compress_block(BlockBuffer* item, char*& buf, int64_t& size)
+{
+  int ret = OB_SUCCESS;
+  const int64_t head_size = sizeof(Block) + sizeof(int64_t);
+  Block* blk = item->get_block();
+  const int64_t payload_size = item->head() - blk->payload_;
+  int64_t max_overflow_size = 0;
+  int64_t compressed_size = 0;
+  if (OB_ISNULL(compressor_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("compressor is null", K(ret));
+  } else if (OB_FAIL(compressor_->get_max_overflow_size(payload_size, max_overflow_size))) {
+    LOG_WARN("get max overflow size failed", K(ret), K(payload_size));
+  } else {
+    const int64_t buf_size = head_size + payload_size + max_overflow_size;
+    if (buf_size > compress_buf_size_) {
+      if (NULL != compress_buf_) {
+        callback_free(compress_buf_size_);
+        allocator_->free(compress_buf_);
+        compress_buf_ = NULL;
+        compress_buf_size_ = 0;
+      }
+      const int64_t alloc_size = next_pow2(buf_size);
+      if (OB_ISNULL(compress_buf_ = static_cast<char*>(alloc_blk_mem(alloc_size, true)))) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("alloc memory failed", K(ret), K(alloc_size));
+      } else {
+        compress_buf_size_ = alloc_size;
+      }
+    }
+    if (OB_FAIL(ret)) {
+    } else if (OB_FAIL(compressor_->compress(
+                   blk->payload_, payload_size, compress_buf_ + head_size, buf_size - head_size, compressed_size))) {
+      LOG_WARN("compress block failed", K(ret), K(payload_size));
+    } else if (head_size + compressed_size < size) {
+      Block* compressed_blk = new (compress_buf_) Block;
+      compressed_blk->magic_ = Block::COMPRESSED_MAGIC;
+      compressed_blk->blk_size_ = static_cast<uint32_t>(head_size + compressed_size);
+      compressed_blk->rows_ = blk->rows_;
+      *reinterpret_cast<int64_t*>(compressed_blk->payload_) = payload_size;
+      dump_saved_size_ += size - compressed_blk->blk_size_;
+      if (nullptr != callback_) {
+        callback_->dump_saved(size - compressed_blk->blk_size_);
+      }
+      buf = compress_buf_;
+      size = compressed_blk->blk_size_;
+    }
+  }
+  return ret;
+}
+
+int ObChunkDatumStore::decompress_block(const Block* file_blk, const int64_t size, Block* blk, const int64_t blk_cap)
+{
+  int ret = OB_SUCCESS;
+  const int64_t head_size = sizeof(Block) + sizeof(int64_t);
+  if (OB_ISNULL(file_blk) || OB_ISNULL(blk) || file_blk->blk_size_ != size) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(file_blk), KP(blk), K(size));
+  } else if (!file_blk->is_compressed()) {
+    if (size > blk_cap) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("block size exceed", K(ret), K(size), K(blk_cap));
+    } else {
+      MEMCPY(blk, file_blk, size);
+    }
+  } else {
+    const int64_t payload_size = *reinterpret_cast<const int64_t*>(file_blk->payload_);
+    int64_t decompressed_size = 0;
+    if (OB_ISNULL(compressor_)) {
+      ret = OB_NOT_INIT;
+      LOG_WARN("compressor is null", K(ret));
+    } else if (payload_size + static_cast<int64_t>(sizeof(Block)) > blk_cap || size < head_size) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("invalid compressed block", K(ret), K(payload_size), K(size), K(blk_cap));
+    } else if (OB_FAIL(compressor_->decompress(reinterpret_cast<const char*>(file_blk) + head_size,
+                   size - head_size,
+                   blk->payload_,
+                   blk_cap - sizeof(Block),
+                   decompressed_size))) {
+      LOG_WARN("decompress block failed", K(ret), K(size), K(payload_size));
+    } else if (decompressed_size != payload_size) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("decompressed size mismatch", K(ret), K(decompressed_size), K(payload_size));
+    } else {
+      blk->magic_ = Block::MAGIC;
+      blk->rows_ = file_blk->rows_;
+    }
+  }
+  if (OB_SUCC(ret)) {
+    // keep get_buffer() of the iterating block valid
+    blk->blk_size_ = static_cast<uint32_t>(blk_cap);
   }
   return ret;
 }
@@ -1325,7 +1468,16 @@ int ObChunkDatumStore::load_next_block(ChunkIterator& it)
   } else if (is_file_open() && !it.read_file_iter_end()) {
     LOG_DEBUG("debug read size", K(it.chunk_read_size_), K(this->max_blk_size_));
     bool enable_aio = false;
-    if (it.chunk_read_size_ > 0 && it.chunk_read_size_ >= this->max_blk_size_) {
+    if (NULL != compressor_) {
+      // blocks are variable sized in file, read one by one
+      if (OB_FAIL(load_next_compressed_block(it))) {
+        if (OB_ITER_END != ret) {
+          LOG_WARN("load next compressed block failed", K(ret));
+        } else {
+          it.set_read_file_iter_end();
+        }
+      }
+    } else if (it.chunk_read_size_ > 0 && it.chunk_read_size_ >= this->max_blk_size_) {
       if (OB_FAIL(load_next_chunk_blocks(it))) {
         LOG_WARN("RowStore iter load next chunk blocks failed", K(ret));
       }
@@ -1520,6 +1672,101 @@ int ObChunkDatumStore::load_next_block(ChunkIterator& it)
   return ret;
 }
 
+/* read next block of dump file with compressor set.
+ * The next block is read ahead asynchronously before decompressing current block,
+ * so the decompression and row iterating are overlapped with the disk reading.
+ */
+int ObChunkDatumStore::load_next_compressed_block(ChunkIterator& it)
+{
+  int ret = OB_SUCCESS;
+  const int64_t nth_blk = it.cur_nth_blk_ + 1;
+  int64_t timeout_ms = 0;
+  int64_t size = 0;
+  if (nth_blk >= file_blk_sizes_.count() || it.cur_iter_pos_ >= it.file_size_) {
+    ret = OB_ITER_END;
+  } else if (OB_FAIL(get_timeout(timeout_ms))) {
+    LOG_WARN("get timeout failed", K(ret));
+  } else {
+    size = file_blk_sizes_.at(nth_blk);
+    if (NULL == it.cur_iter_blk_) {
+      // blocks in file and the iterating block are not larger than the max block ever allocated
+      if (OB_FAIL(alloc_block_buffer(it.cur_iter_blk_, max_blk_size_, true))) {
+        LOG_WARN("alloc block failed", K(ret));
+      } else {
+        it.cur_iter_blk_buf_ = it.cur_iter_blk_->get_buffer();
+      }
+    }
+    if (OB_SUCC(ret) && NULL == it.read_buf_) {
+      it.read_buf_size_ = max_blk_size_;
+      if (OB_ISNULL(it.read_buf_ = static_cast<char*>(alloc_blk_mem(it.read_buf_size_, true))) ||
+          OB_ISNULL(it.prefetch_buf_ = static_cast<char*>(alloc_blk_mem(it.read_buf_size_, true)))) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("alloc memory failed", K(ret), K(it.read_buf_size_));
+      }
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (size > it.read_buf_size_ || size > it.file_size_ - it.cur_iter_pos_) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("unexpected block size", K(ret), K(size), K(nth_blk), K(it));
+  } else if (it.prefetch_pos_ == it.cur_iter_pos_) {
+    // already read ahead
+    if (OB_FAIL(it.next_aio_read_handle_->wait(timeout_ms))) {
+      LOG_WARN("fail to wait io finish", K(ret), K(timeout_ms));
+    } else {
+      std::swap(it.read_buf_, it.prefetch_buf_);
+      std::swap(it.cur_aio_read_handle_, it.next_aio_read_handle_);
+    }
+  } else if (OB_FAIL(read_file(
+                 it.read_buf_, size, it.cur_iter_pos_, *it.cur_aio_read_handle_, it.file_size_, it.cur_iter_pos_))) {
+    LOG_WARN("read blk info from file failed", K(ret), K_(it.cur_iter_pos));
+  }
+  if (OB_SUCC(ret)) {
+    it.prefetch_pos_ = -1;
+    const int64_t next_pos = it.cur_iter_pos_ + size;
+    if (nth_blk + 1 < file_blk_sizes_.count() && next_pos < it.file_size_) {
+      const int64_t next_size = file_blk_sizes_.at(nth_blk + 1);
+      if (next_size > it.read_buf_size_) {
+        // not read ahead, report error when reading it
+      } else if (OB_FAIL(aio_read_file(it.prefetch_buf_, next_size, next_pos, *it.next_aio_read_handle_))) {
+        LOG_WARN("read ahead next block failed", K(ret), K(next_pos), K(next_size));
+      } else {
+        it.prefetch_pos_ = next_pos;
+      }
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (OB_FAIL(decompress_block(reinterpret_cast<Block*>(it.read_buf_),
+                 size,
+                 it.cur_iter_blk_,
+                 it.cur_iter_blk_buf_->capacity()))) {
+    LOG_WARN("decompress block failed", K(ret), K(size), K(it));
+  } else if (OB_FAIL(it.cur_iter_blk_->swizzling(NULL))) {
+    LOG_WARN("swizzling failed after read block from file", K(ret), K(it));
+  } else if (0 == it.cur_iter_blk_->rows_) {
+    ret = OB_INNER_STAT_ERROR;
+    LOG_WARN("read file failed", K(ret), K(size), K(it));
+  } else {
+    it.cur_iter_pos_ += size;
+    it.cur_nth_blk_++;
+    it.cur_chunk_n_blocks_ = 1;
+    it.cur_iter_blk_->next_ = NULL;
+    it.chunk_n_rows_ = it.cur_iter_blk_->rows_;
+    LOG_TRACE("StoreRow read compressed block succ", K(size), K_(it.cur_iter_blk), K_(it.cur_iter_pos));
+  }
+  if (OB_FAIL(ret)) {
+    // rows in memory are iterated after file, free the reading buffers
+    if (NULL != it.cur_iter_blk_) {
+      callback_free(it.cur_iter_blk_buf_->mem_size());
+      allocator_->free(it.cur_iter_blk_);
+      it.cur_iter_blk_ = NULL;
+      it.cur_iter_blk_buf_ = NULL;
+    }
+    it.free_read_buf();
+  }
+  return ret;
+}
+
 int ObChunkDatumStore::get_store_row(RowIterator& it, const StoredRow*& sr)
 {
   int ret = OB_SUCCESS;
@@ -1597,7 +1844,11 @@ ObChunkDatumStore::ChunkIterator::ChunkIterator()
       chunk_read_size_(0),
       chunk_mem_(NULL),
       chunk_n_rows_(0),
-      iter_end_flag_(IterEndState::PROCESSING)
+      iter_end_flag_(IterEndState::PROCESSING),
+      read_buf_(NULL),
+      prefetch_buf_(NULL),
+      read_buf_size_(0),
+      prefetch_pos_(-1)
 {}
 
 int ObChunkDatumStore::ChunkIterator::init(ObChunkDatumStore* store, int64_t chunk_read_size)
@@ -1632,6 +1883,7 @@ void ObChunkDatumStore::ChunkIterator::reset_cursor(const int64_t file_size)
   swap_aio_read_handle_.reset();
   cur_aio_read_handle_ = &aio_read_handle_;
   next_aio_read_handle_ = &swap_aio_read_handle_;
+  free_read_buf();
 
   if (!read_file_iter_end()) {
     if (cur_iter_pos_ > 0 && NULL != store_) {
@@ -1659,6 +1911,22 @@ void ObChunkDatumStore::ChunkIterator::reset_cursor(const int64_t file_size)
   iter_end_flag_ = IterEndState::PROCESSING;
 }
 
+void ObChunkDatumStore::ChunkIterator::free_read_buf()
+{
+  if (NULL != read_buf_) {
+    store_->callback_free(read_buf_size_);
+    store_->allocator_->free(read_buf_);
+    read_buf_ = NULL;
+  }
+  if (NULL != prefetch_buf_) {
+    store_->callback_free(read_buf_size_);
+    store_->allocator_->free(prefetch_buf_);
+    prefetch_buf_ = NULL;
+  }
+  read_buf_size_ = 0;
+  prefetch_pos_ = -1;
+}
+
 void ObChunkDatumStore::ChunkIterator::reset()
 {
   reset_cursor(0);
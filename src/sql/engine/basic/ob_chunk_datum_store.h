@@ -15,6 +15,7 @@
 
 #include "share/ob_define.h"
 #include "lib/container/ob_se_array.h"
+#include "lib/compress/ob_compress_util.h"
 #include "lib/allocator/page_arena.h"
 #include "lib/utility/ob_print_utils.h"
 #include "lib/list/ob_dlist.h"
@@ -26,6 +27,9 @@
 #include "sql/engine/basic/ob_sql_mem_callback.h"
 
 namespace oceanbase {
+namespace common {
+class ObCompressor;
+}
 namespace sql {
 
 // Random access row store, support disk store.
@@ -337,6 +341,8 @@ public:
   class BlockBuffer;
   struct Block {
     static const int64_t MAGIC = 0xbc054e02d8536315;
+    // magic of compressed block in dump file, see ObChunkDatumStore::compress_block()
+    static const int64_t COMPRESSED_MAGIC = 0xbc054e02d8536316;
     static const int32_t ROW_HEAD_SIZE = sizeof(StoredRow);
     Block() : magic_(0), blk_size_(0), rows_(0)
     {}
@@ -401,6 +407,10 @@ public:
     {
       return MAGIC == magic_;
     }
+    inline bool is_compressed() const
+    {
+      return COMPRESSED_MAGIC == magic_;
+    }
     int get_store_row(int64_t& cur_pos, const StoredRow*& sr);
     inline Block* get_next() const
     {
@@ -697,10 +707,11 @@ public:
     }
 
     TO_STRING_KV(KP_(store), KP_(cur_iter_blk), KP_(cur_iter_blk_buf), K_(cur_chunk_n_blocks), K_(cur_iter_pos),
-        K_(file_size), K_(chunk_read_size), KP_(chunk_mem));
+        K_(file_size), K_(chunk_read_size), KP_(chunk_mem), K_(read_buf_size), K_(prefetch_pos));
 
   private:
     void reset_cursor(const int64_t file_size);
+    void free_read_buf();
 
   protected:
     ObChunkDatumStore* store_;
@@ -723,6 +734,12 @@ public:
     char* chunk_mem_;
     int64_t chunk_n_rows_;
     int32_t iter_end_flag_;
+    // file buffers for reading compressed blocks, the next block is read ahead into
+    // %prefetch_buf_ while current block in %read_buf_ is decompressed and iterated.
+    char* read_buf_;
+    char* prefetch_buf_;
+    int64_t read_buf_size_;
+    int64_t prefetch_pos_;  // file position of the block read ahead, -1 for none
   };
 
   class Iterator {
@@ -906,6 +923,16 @@ public:
   {
     io_.dir_id_ = dir_id;
   }
+  // Compress dumped blocks with specified compressor, it takes effect when the dump file is
+  // opened. Compressor is determined by tenant config _chunk_row_store_compress_func if not set.
+  void set_compressor_type(const common::ObCompressorType type)
+  {
+    compressor_type_ = type;
+  }
+  inline int64_t get_dump_saved_size() const
+  {
+    return dump_saved_size_;
+  }
   int alloc_dir_id();
   TO_STRING_KV(K_(tenant_id), K_(label), K_(ctx_id), K_(mem_limit), K_(row_cnt), K_(file_size));
 
@@ -942,6 +969,9 @@ private:
     mem_used_ += used;
   }
   inline int dump_one_block(BlockBuffer* item);
+  int init_compressor();
+  int compress_block(BlockBuffer* item, char*& buf, int64_t& size);
+  int decompress_block(const Block* file_blk, const int64_t size, Block* blk, const int64_t blk_cap);
 
   int write_file(void* buf, int64_t size);
   int read_file(void *buf, const int64_t size, const int64_t offset, blocksstable::ObTmpFileIOHandle &handle,
@@ -959,6 +989,7 @@ private:
   int get_store_row(RowIterator& it, const StoredRow*& sr);
   int load_next_block(ChunkIterator& it);
   int load_next_chunk_blocks(ChunkIterator& it);
+  int load_next_compressed_block(ChunkIterator& it);
   inline void callback_alloc(int64_t size)
   {
     if (callback_ != nullptr)
@@ -1008,6 +1039,19 @@ private:
   uint32_t row_extend_size_;
   ObSqlMemoryCallback* callback_;
 
+  // Compressed block in dump file:
+  //   |Block head: magic_ is COMPRESSED_MAGIC, blk_size_ is size in file|
+  //   |int64_t: size of the uncompressed payload|
+  //   |compressed payload|
+  // Blocks are not compressed if no space is saved, blocks in file are variable sized
+  // when compressor is set, the size of every dumped block is kept in %file_blk_sizes_.
+  common::ObCompressorType compressor_type_;
+  common::ObCompressor* compressor_;
+  char* compress_buf_;
+  int64_t compress_buf_size_;
+  int64_t dump_saved_size_;
+  common::ObArray<uint32_t> file_blk_sizes_;
+
   DISALLOW_COPY_AND_ASSIGN(ObChunkDatumStore);
 };
 
@@ -43,6 +43,7 @@ ObLimitOp::ObLimitOp(ObExecContext& exec_ctx, const ObOpSpec& spec, ObOpInput* i
       input_cnt_(0),
       output_cnt_(0),
       total_cnt_(0),
+      left_cnt_(0),
       is_percent_first_(false),
       pre_sort_columns_(exec_ctx.get_allocator())
 {}
@@ -79,6 +80,7 @@ int ObLimitOp::rescan()
 {
   input_cnt_ = 0;
   output_cnt_ = 0;
+  left_cnt_ = 0;
   return ObOperator::rescan();
 }
 
@@ -185,17 +187,81 @@ int ObLimitOp::inner_get_next_row()
     }
   }
   if (OB_ITER_END == ret) {
-    if (MY_SPEC.is_top_limit_) {
-      total_cnt_ = left_count + output_cnt_ + input_cnt_;
-      ObPhysicalPlanCtx* plan_ctx = NULL;
-      if (OB_ISNULL(plan_ctx = ctx_.get_physical_plan_ctx())) {
-        ret = OB_ERR_NULL_VALUE;
-        LOG_WARN("get physical plan context failed");
+    int tmp_ret = set_found_rows(left_count);
+    if (OB_SUCCESS != tmp_ret) {
+      ret = tmp_ret;
+    }
+  }
+  return ret;
+}
+
+int ObLimitOp::set_found_rows(const int64_t left_count)
+{
+  int ret = OB_SUCCESS;
+  if (MY_SPEC.is_top_limit_) {
+    total_cnt_ = left_count + output_cnt_ + input_cnt_;
+    ObPhysicalPlanCtx* plan_ctx = NULL;
+    if (OB_ISNULL(plan_ctx = ctx_.get_physical_plan_ctx())) {
+      ret = OB_ERR_NULL_VALUE;
+      LOG_WARN("get physical plan context failed");
+    } else {
+      NG_TRACE_EXT(found_rows, OB_ID(total_count), total_cnt_, OB_ID(input_count), input_cnt_);
+      plan_ctx->set_found_rows(total_cnt_);
+    }
+  }
+  return ret;
+}
+
+// Percent limit and fetch with ties are not supported in batch mode (see
+// ObCodeGenerator::check_vectorizable()), rows are skipped by offset and limit.
+int ObLimitOp::inner_get_next_batch(const int64_t max_row_cnt)
+{
+  int ret = OB_SUCCESS;
+  const ObBatchRows* child_brs = NULL;
+  if (limit_ >= 0 && output_cnt_ >= limit_) {
+    // Limit reached, count the left rows of child for SQL_CALC_FOUND_ROWS.
+    // Child is drained here instead of the batch limit reached, because the output datums
+    // of that batch will be overwritten by child.
+    bool child_end = false;
+    while (OB_SUCC(ret) && MY_SPEC.calc_found_rows_ && !child_end) {
+      if (OB_FAIL(child_->get_next_batch(max_row_cnt, child_brs))) {
+        LOG_WARN("get child next batch failed", K(ret));
+      } else {
+        left_cnt_ += child_brs->size_ - child_brs->skip_->accumulate_bit_cnt(child_brs->size_);
+        child_end = child_brs->end_;
+      }
+    }
+    if (OB_SUCC(ret)) {
+      brs_.size_ = 0;
+      brs_.end_ = true;
+    }
+  } else if (OB_FAIL(child_->get_next_batch(max_row_cnt, child_brs))) {
+    LOG_WARN("get child next batch failed", K(ret));
+  } else {
+    brs_.size_ = child_brs->size_;
+    brs_.end_ = child_brs->end_;
+    brs_.skip_->deep_copy(*child_brs->skip_, child_brs->size_);
+    for (int64_t i = 0; i < brs_.size_; i++) {
+      if (brs_.skip_->at(i)) {
+        // skipped by child
+      } else if (input_cnt_ < offset_) {
+        ++input_cnt_;
+        brs_.skip_->set(i);
+      } else if (limit_ < 0 || output_cnt_ < limit_) {
+        ++output_cnt_;
       } else {
-        NG_TRACE_EXT(found_rows, OB_ID(total_count), total_cnt_, OB_ID(input_count), input_cnt_);
-        plan_ctx->set_found_rows(total_cnt_);
+        ++left_cnt_;
+        brs_.skip_->set(i);
       }
     }
+    if (!MY_SPEC.calc_found_rows_ && limit_ >= 0 && output_cnt_ >= limit_) {
+      brs_.end_ = true;
+    }
+  }
+  if (OB_SUCC(ret) && brs_.end_) {
+    if (OB_FAIL(set_found_rows(left_cnt_))) {
+      LOG_WARN("set found rows failed", K(ret));
+    }
   }
   return ret;
 }
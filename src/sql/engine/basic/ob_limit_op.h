@@ -47,6 +47,7 @@ public:
   virtual int rescan() override;
 
   virtual int inner_get_next_row() override;
+  virtual int inner_get_next_batch(const int64_t max_row_cnt) override;
 
   virtual void destroy() override
   {
@@ -59,6 +60,8 @@ public:
 private:
   int convert_limit_percent();
   int is_row_order_by_item_value_equal(bool& is_equal);
+  // set found rows for top limit after iterate end
+  int set_found_rows(const int64_t left_count);
 
 private:
   int64_t limit_;
@@ -66,6 +69,8 @@ private:
   int64_t input_cnt_;
   int64_t output_cnt_;
   int64_t total_cnt_;
+  // rows after limit reached in batch, counted for found rows.
+  int64_t left_cnt_;
   bool is_percent_first_;
 
   ObChunkDatumStore::LastStoredRow<> pre_sort_columns_;
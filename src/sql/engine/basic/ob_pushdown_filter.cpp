@@ -41,7 +41,7 @@ OB_SERIALIZE_MEMBER(ObPushdownFilterNode, type_, n_child_, col_ids_);
 OB_SERIALIZE_MEMBER((ObPushdownAndFilterNode, ObPushdownFilterNode));
 OB_SERIALIZE_MEMBER((ObPushdownOrFilterNode, ObPushdownFilterNode));
 OB_SERIALIZE_MEMBER((ObPushdownBlackFilterNode, ObPushdownFilterNode), column_exprs_, filter_exprs_);
-OB_SERIALIZE_MEMBER((ObPushdownWhiteFilterNode, ObPushdownFilterNode));
+OB_SERIALIZE_MEMBER((ObPushdownWhiteFilterNode, ObPushdownFilterNode), op_type_, param_expr_);
 
 int ObPushdownBlackFilterNode::merge(ObIArray<ObPushdownFilterNode*>& merged_node)
 {
@@ -119,6 +119,166 @@ int ObPushdownFilterConstructor::create_black_filter_node(ObRawExpr* raw_expr, O
   return ret;
 }
 
+bool ObPushdownFilterConstructor::is_white_column_type(const ObRawExpr& column_expr)
+{
+  bool bret = false;
+  const ObObjType type = column_expr.get_result_type().get_type();
+  switch (ob_obj_type_class(type)) {
+    case ObIntTC:
+    case ObUIntTC:
+    case ObFloatTC:
+    case ObDoubleTC:
+    case ObNumberTC:
+    case ObDateTimeTC:
+    case ObDateTC:
+    case ObTimeTC:
+    case ObYearTC: {
+      bret = true;
+      break;
+    }
+    case ObStringTC: {
+      // fixed length char is padded on output, stored cells can not be compared directly
+      bret = !column_expr.get_result_type().is_fixed_len_char_type();
+      break;
+    }
+    default: {
+      break;
+    }
+  }
+  return bret;
+}
+
+bool ObPushdownFilterConstructor::is_white_mode(const ObRawExpr* raw_expr)
+{
+  bool bret = false;
+  const ObRawExpr* column_expr = nullptr;
+  const ObRawExpr* param_expr = nullptr;
+  if (OB_ISNULL(raw_expr)) {
+  } else {
+    const ObItemType type = raw_expr->get_expr_type();
+    if (T_OP_EQ == type || T_OP_NE == type || T_OP_LT == type || T_OP_LE == type || T_OP_GT == type ||
+        T_OP_GE == type) {
+      if (2 == raw_expr->get_param_count() && OB_NOT_NULL(raw_expr->get_param_expr(0)) &&
+          OB_NOT_NULL(raw_expr->get_param_expr(1))) {
+        if (raw_expr->get_param_expr(0)->is_column_ref_expr()) {
+          column_expr = raw_expr->get_param_expr(0);
+          param_expr = raw_expr->get_param_expr(1);
+        } else if (raw_expr->get_param_expr(1)->is_column_ref_expr()) {
+          column_expr = raw_expr->get_param_expr(1);
+          param_expr = raw_expr->get_param_expr(0);
+        }
+      }
+      if (OB_NOT_NULL(column_expr)) {
+        const ObExprResType& column_type = column_expr->get_result_type();
+        const ObExprResType& param_type = param_expr->get_result_type();
+        // the const side is evaluated once per execution, it must not depend on the scanned row
+        bret = param_expr->has_const_or_const_expr_flag() && !param_expr->has_flag(CNT_COLUMN) &&
+               !param_expr->has_flag(IS_EXEC_PARAM) && !param_expr->has_flag(CNT_EXEC_PARAM) &&
+               column_type.get_type() == param_type.get_type() &&
+               (!column_type.is_string_type() || column_type.get_collation_type() == param_type.get_collation_type());
+      }
+    } else if (T_OP_IS == type || T_OP_IS_NOT == type) {
+      if (3 == raw_expr->get_param_count() && OB_NOT_NULL(raw_expr->get_param_expr(0)) &&
+          OB_NOT_NULL(raw_expr->get_param_expr(1)) && raw_expr->get_param_expr(0)->is_column_ref_expr() &&
+          T_NULL == raw_expr->get_param_expr(1)->get_expr_type()) {
+        column_expr = raw_expr->get_param_expr(0);
+        // zero date matches `is null` in mysql mode, leave it to the expression
+        bret = !column_expr->get_result_type().is_datetime() && !column_expr->get_result_type().is_date();
+      }
+    }
+    if (bret) {
+      const ObColumnRefRawExpr* ref_expr = static_cast<const ObColumnRefRawExpr*>(column_expr);
+      bret = !ref_expr->is_generated_column() && is_white_column_type(*column_expr);
+    }
+  }
+  return bret;
+}
+
+int ObPushdownFilterConstructor::create_white_filter_node(ObRawExpr* raw_expr, ObPushdownFilterNode*& filter_node)
+{
+  int ret = OB_SUCCESS;
+  ObPushdownWhiteFilterNode* white_filter_node = nullptr;
+  ObRawExpr* column_expr = nullptr;
+  ObRawExpr* param_expr = nullptr;
+  ObWhiteFilterOperatorType op_type = WHITE_OP_MAX;
+  bool column_on_left = true;
+  if (OB_ISNULL(raw_expr)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("Invalid null raw expr", K(ret));
+  } else {
+    switch (raw_expr->get_expr_type()) {
+      case T_OP_EQ:
+        op_type = WHITE_OP_EQ;
+        break;
+      case T_OP_NE:
+        op_type = WHITE_OP_NE;
+        break;
+      case T_OP_LT:
+        op_type = WHITE_OP_LT;
+        break;
+      case T_OP_LE:
+        op_type = WHITE_OP_LE;
+        break;
+      case T_OP_GT:
+        op_type = WHITE_OP_GT;
+        break;
+      case T_OP_GE:
+        op_type = WHITE_OP_GE;
+        break;
+      case T_OP_IS:
+        op_type = WHITE_OP_NU;
+        break;
+      case T_OP_IS_NOT:
+        op_type = WHITE_OP_NN;
+        break;
+      default:
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("unexpected white filter expr type", K(ret), K(raw_expr->get_expr_type()));
+        break;
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (WHITE_OP_NU == op_type || WHITE_OP_NN == op_type) {
+    column_expr = raw_expr->get_param_expr(0);
+  } else if (FALSE_IT(column_on_left = raw_expr->get_param_expr(0)->is_column_ref_expr())) {
+  } else {
+    column_expr = raw_expr->get_param_expr(column_on_left ? 0 : 1);
+    param_expr = raw_expr->get_param_expr(column_on_left ? 1 : 0);
+    if (!column_on_left) {
+      // `const op column` => `column op' const`
+      if (WHITE_OP_LT == op_type) {
+        op_type = WHITE_OP_GT;
+      } else if (WHITE_OP_LE == op_type) {
+        op_type = WHITE_OP_GE;
+      } else if (WHITE_OP_GT == op_type) {
+        op_type = WHITE_OP_LT;
+      } else if (WHITE_OP_GE == op_type) {
+        op_type = WHITE_OP_LE;
+      }
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (OB_FAIL(factory_.alloc(PushdownFilterType::WHITE_FILTER, 0, filter_node))) {
+    LOG_WARN("failed t o alloc pushdown filter", K(ret));
+  } else if (OB_ISNULL(filter_node)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("white filter node is null", K(ret));
+  } else if (FALSE_IT(white_filter_node = static_cast<ObPushdownWhiteFilterNode*>(filter_node))) {
+  } else if (OB_FAIL(white_filter_node->col_ids_.init(1))) {
+    LOG_WARN("failed to init col ids", K(ret));
+  } else if (OB_FAIL(white_filter_node->col_ids_.push_back(
+                 static_cast<ObColumnRefRawExpr*>(column_expr)->get_column_id()))) {
+    LOG_WARN("failed to push back column id", K(ret));
+  } else if (nullptr != param_expr &&
+             OB_FAIL(static_cg_.generate_rt_expr(*param_expr, white_filter_node->param_expr_))) {
+    LOG_WARN("failed to generate rt expr", K(ret));
+  } else {
+    white_filter_node->op_type_ = op_type;
+    LOG_DEBUG("debug white_filter_node", K(*raw_expr), K(*white_filter_node));
+  }
+  return ret;
+}
+
 int ObPushdownFilterConstructor::merge_filter_node(
     ObPushdownFilterNode* dst, ObPushdownFilterNode* other, ObIArray<ObPushdownFilterNode*>& merged_node, bool& merged)
 {
@@ -183,12 +343,9 @@ int ObPushdownFilterConstructor::apply(ObRawExpr* raw_expr, ObPushdownFilterNode
     ret = OB_NOT_SUPPORTED;
     LOG_WARN("not supported", K(ret));
   } else if (is_white_mode(raw_expr)) {
-    // create white filter
-    // if (OB_FAIL(factory_.alloc(PushdownFilterType::WHITE, filter_node))) {
-    //   LOG_WARN("failed t o alloc pushdown filter", K(ret));
-    // }
-    ret = OB_NOT_SUPPORTED;
-    LOG_WARN("not supported", K(ret));
+    if (OB_FAIL(create_white_filter_node(raw_expr, filter_node))) {
+      LOG_WARN("failed t o alloc pushdown filter", K(ret));
+    }
   } else {
     if (OB_FAIL(create_black_filter_node(raw_expr, filter_node))) {
       LOG_WARN("failed t o alloc pushdown filter", K(ret));
@@ -545,6 +702,49 @@ int ObWhiteFilterExecutor::filter(bool& filtered)
   ret = OB_NOT_SUPPORTED;
   return ret;
 }
+
+int ObWhiteFilterExecutor::filter(const ObObj& cell, bool& filtered) const
+{
+  int ret = OB_SUCCESS;
+  int cmp = 0;
+  const ObWhiteFilterOperatorType op_type = get_op_type();
+  filtered = true;
+  if (WHITE_OP_NU == op_type) {
+    filtered = !cell.is_null();
+  } else if (WHITE_OP_NN == op_type) {
+    filtered = cell.is_null();
+  } else if (cell.is_null() || param_.is_null()) {
+    // comparison with null is never true
+  } else if (OB_FAIL(cell.compare(param_, param_.get_collation_type(), cmp))) {
+    LOG_WARN("failed to compare cell with filter param", K(ret), K(cell), K_(param));
+  } else {
+    switch (op_type) {
+      case WHITE_OP_EQ:
+        filtered = 0 != cmp;
+        break;
+      case WHITE_OP_NE:
+        filtered = 0 == cmp;
+        break;
+      case WHITE_OP_LT:
+        filtered = cmp >= 0;
+        break;
+      case WHITE_OP_LE:
+        filtered = cmp > 0;
+        break;
+      case WHITE_OP_GT:
+        filtered = cmp <= 0;
+        break;
+      case WHITE_OP_GE:
+        filtered = cmp < 0;
+        break;
+      default:
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("unexpected white filter operator", K(ret), K(op_type));
+        break;
+    }
+  }
+  return ret;
+}
 // end for test filter
 
 int ObPushdownFilterExecutor::find_evaluated_datums(
@@ -674,10 +874,24 @@ int ObWhiteFilterExecutor::init_evaluated_datums(
     ObIAllocator& alloc, const ObIArray<ObExpr*>& calc_exprs, ObEvalCtx* eval_ctx)
 {
   int ret = OB_SUCCESS;
-  UNUSED(alloc);
   UNUSED(calc_exprs);
-  UNUSED(eval_ctx);
-  ret = OB_NOT_SUPPORTED;
+  ObExpr* param_expr = static_cast<ObPushdownWhiteFilterNode&>(filter_).param_expr_;
+  ObDatum* datum = nullptr;
+  ObObj tmp_obj;
+  eval_ctx_ = eval_ctx;
+  param_.reset();
+  if (OB_ISNULL(eval_ctx)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("eval ctx is null", K(ret));
+  } else if (nullptr == param_expr) {
+    // is [not] null
+  } else if (OB_FAIL(param_expr->eval(*eval_ctx, datum))) {
+    LOG_WARN("failed to eval white filter param", K(ret));
+  } else if (OB_FAIL(datum->to_obj(tmp_obj, param_expr->obj_meta_, param_expr->obj_datum_map_))) {
+    LOG_WARN("failed to convert datum to obj", K(ret));
+  } else if (OB_FAIL(ob_write_obj(alloc, tmp_obj, param_))) {
+    LOG_WARN("failed to deep copy white filter param", K(ret), K(tmp_obj));
+  }
   return ret;
 }
 
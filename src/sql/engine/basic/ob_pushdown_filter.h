@@ -44,6 +44,19 @@ enum FilterExecutorType {
   MAX_EXECUTOR_TYPE
 };
 
+// comparison evaluated by white filter, column is always the left operand
+enum ObWhiteFilterOperatorType {
+  WHITE_OP_EQ = 0,
+  WHITE_OP_LE,
+  WHITE_OP_LT,
+  WHITE_OP_GE,
+  WHITE_OP_GT,
+  WHITE_OP_NE,
+  WHITE_OP_NU,  // is null
+  WHITE_OP_NN,  // is not null
+  WHITE_OP_MAX
+};
+
 class ObPushdownFilterUtils {
 public:
   static bool is_pushdown_storage(int32_t pd_storage_flag)
@@ -132,14 +145,26 @@ public:
   ObExpr* tmp_expr_;
 };
 
+// simple predicate `column op const` which storage can evaluate on stored cells directly,
+// the const side has exactly the same type and collation as the column.
 class ObPushdownWhiteFilterNode : public ObPushdownFilterNode {
   OB_UNIS_VERSION_V(1);
 
 public:
-  ObPushdownWhiteFilterNode(common::ObIAllocator& alloc) : ObPushdownFilterNode(alloc)
+  ObPushdownWhiteFilterNode(common::ObIAllocator& alloc)
+      : ObPushdownFilterNode(alloc), op_type_(WHITE_OP_MAX), param_expr_(nullptr)
   {}
   ~ObPushdownWhiteFilterNode()
   {}
+  OB_INLINE ObWhiteFilterOperatorType get_op_type() const
+  {
+    return op_type_;
+  }
+  INHERIT_TO_STRING_KV("ObPushdownFilterNode", ObPushdownFilterNode, K_(op_type), KP_(param_expr));
+
+public:
+  ObWhiteFilterOperatorType op_type_;
+  ObExpr* param_expr_;  // null for is [not] null
 };
 
 class ObPushdownFilterExecutor;
@@ -184,16 +209,14 @@ private:
       common::ObIArray<ObPushdownFilterNode*>& merged_node, bool& merged);
   int deduplicate_filter_node(common::ObIArray<ObPushdownFilterNode*>& filter_nodes, uint32_t& n_node);
   int create_black_filter_node(ObRawExpr* raw_expr, ObPushdownFilterNode*& filter_tree);
+  int create_white_filter_node(ObRawExpr* raw_expr, ObPushdownFilterNode*& filter_tree);
   bool can_split_or(ObRawExpr* raw_expr)
   {
     UNUSED(raw_expr);
     return false;
   }
-  bool is_white_mode(ObRawExpr* raw_expr)
-  {
-    UNUSED(raw_expr);
-    return false;
-  }
+  bool is_white_mode(const ObRawExpr* raw_expr);
+  static bool is_white_column_type(const ObRawExpr& column_expr);
 
 private:
   common::ObIAllocator* alloc_;
@@ -429,17 +452,29 @@ OB_INLINE void ObBlackFilterExecutor::clear_evaluated_datums()
 class ObWhiteFilterExecutor : public ObPushdownFilterExecutor {
 public:
   ObWhiteFilterExecutor(common::ObIAllocator& alloc, ObPushdownWhiteFilterNode& filter)
-      : ObPushdownFilterExecutor(alloc, filter)
+      : ObPushdownFilterExecutor(alloc, filter), param_(), eval_ctx_(nullptr)
   {}
   ~ObWhiteFilterExecutor()
   {}
 
   virtual int filter(bool& filtered) override;
+  // evaluate on one stored cell of the filter column, @filtered is true if the row does not qualify
+  int filter(const common::ObObj& cell, bool& filtered) const;
   virtual int init_evaluated_datums(
       common::ObIAllocator& alloc, const common::ObIArray<ObExpr*>& calc_exprs, ObEvalCtx* eval_ctx) override;
-  INHERIT_TO_STRING_KV("ObPushdownFilterExecutor", ObPushdownFilterExecutor, K_(filter));
+  OB_INLINE ObWhiteFilterOperatorType get_op_type() const
+  {
+    return static_cast<const ObPushdownWhiteFilterNode&>(filter_).get_op_type();
+  }
+  OB_INLINE const common::ObObj& get_param() const
+  {
+    return param_;
+  }
+  INHERIT_TO_STRING_KV("ObPushdownFilterExecutor", ObPushdownFilterExecutor, K_(filter), K_(param));
 
 private:
+  common::ObObj param_;  // evaluated const operand, deep copied
+  ObEvalCtx* eval_ctx_;
 };
 
 class ObAndFilterExecutor : public ObPushdownFilterExecutor {
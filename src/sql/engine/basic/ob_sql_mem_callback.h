@@ -23,6 +23,11 @@ public:
   virtual void alloc(int64_t size) = 0;
   virtual void free(int64_t size) = 0;
   virtual void dumped(int64_t size) = 0;
+  // bytes saved by compressing dumped data
+  virtual void dump_saved(int64_t size)
+  {
+    UNUSED(size);
+  }
 };
 
 }  // end namespace sql
@@ -34,6 +34,7 @@
 #include "sql/resolver/expr/ob_raw_expr_util.h"
 #include "share/ob_tenant_mgr.h"
 #include "share/ob_tenant_memstore_info_operator.h"
+#include "share/object/ob_obj_cast.h"
 #include "sql/resolver/ob_schema_checker.h"
 
 using namespace oceanbase::sql;
@@ -2289,6 +2290,54 @@ int ObInsertValueGenerator::gen_values(const ObIArray<ObString>& file_col_values
   return ret;
 }
 
+int ObInsertValueGenerator::gen_sort_key(const ObIArray<ObString>& table_column_values, ObIAllocator& allocator,
+    ObObj* key_objs, bool& is_valid) const
+{
+  int ret = OB_SUCCESS;
+  is_valid = true;
+  if (OB_ISNULL(key_objs)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && is_valid && i < sort_key_columns_.count(); ++i) {
+    const ObLoadSortKeyColumn& column = sort_key_columns_.at(i);
+    if (OB_UNLIKELY(column.value_idx_ < 0 || column.value_idx_ >= table_column_values.count())) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("invalid sort key column", K(ret), K(column));
+    } else {
+      const ObString& value = table_column_values.at(column.value_idx_);
+      ObObj& key = key_objs[i];
+      if (ObLoadDataUtils::is_null_field(value)) {
+        key.set_null();
+      } else if (ObLoadDataUtils::is_zero_field(value)) {
+        // the value is decided by the insert stmt
+        is_valid = false;
+      } else {
+        // strings are converted to the charset of the column, compared with its collation later
+        ObObj in;
+        in.set_varchar(value);
+        in.set_collation_type(ObCharset::get_system_collation());
+        ObCastCtx cast_ctx(&allocator, NULL, CM_NONE, column.meta_.get_collation_type());
+        if (OB_FAIL(ObObjCaster::to_type(
+                column.meta_.get_type(), column.meta_.get_collation_type(), cast_ctx, in, key))) {
+          // leave the error to the insert stmt
+          ret = OB_SUCCESS;
+          is_valid = false;
+        } else if (key.is_string_type() && key.get_string_ptr() == value.ptr()) {
+          // not converted, the value refers to the file buffer which is reused
+          ObString copied;
+          if (OB_FAIL(ob_write_string(allocator, value, copied))) {
+            LOG_WARN("fail to copy string", K(ret));
+          } else {
+            key.set_string(key.get_type(), copied);
+          }
+        }
+      }
+    }
+  }
+  return ret;
+}
+
 bool ObInsertValueGenerator::find_table_column_value_desc_by_column_id(const uint64_t column_id, int64_t& idx)
 {
   bool found = false;
@@ -2645,6 +2694,60 @@ int ObLoadDataSPImpl::build_insert_values_generator(
   return ret;
 }
 
+// Rows are sorted by rowkey only if all rowkey columns are int, uint or string and are taken
+// from the file directly, which can be compared without evaluating the insert stmt.
+int ObLoadDataSPImpl::build_sort_key_columns(
+    ObExecContext& ctx, const uint64_t table_id, ObInsertValueGenerator& generator)
+{
+  int ret = OB_SUCCESS;
+  ObSchemaGetterGuard* schema_guard = NULL;
+  const ObTableSchema* table_schema = NULL;
+  ObSEArray<ObLoadSortKeyColumn, 4> sort_key_columns;
+  bool can_sort = true;
+
+  if (OB_ISNULL(ctx.get_sql_ctx()) || OB_ISNULL(schema_guard = ctx.get_sql_ctx()->schema_guard_)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("sql ctx is null", K(ret), KP(ctx.get_sql_ctx()));
+  } else if (OB_FAIL(schema_guard->get_table_schema(table_id, table_schema))) {
+    LOG_WARN("fail to get table schema", K(ret), K(table_id));
+  } else if (OB_ISNULL(table_schema)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("table schema is NULL", K(ret));
+  } else {
+    const ObRowkeyInfo& rowkey_info = table_schema->get_rowkey_info();
+    for (int64_t i = 0; OB_SUCC(ret) && can_sort && i < rowkey_info.get_size(); ++i) {
+      const ObRowkeyColumn* rowkey_column = rowkey_info.get_column(i);
+      int64_t idx = OB_INVALID_INDEX_INT64;
+      if (OB_ISNULL(rowkey_column)) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("rowkey column is NULL", K(ret), K(i));
+      } else if (!generator.find_table_column_value_desc_by_column_id(rowkey_column->column_id_, idx) ||
+                 generator.get_table_column_value_descs().at(idx).is_set_values_) {
+        can_sort = false;
+      } else {
+        const ObObjTypeClass tc = rowkey_column->type_.get_type_class();
+        if (ObIntTC != tc && ObUIntTC != tc && ObStringTC != tc) {
+          can_sort = false;
+        } else {
+          ObLoadSortKeyColumn column;
+          column.value_idx_ = idx;
+          column.meta_ = rowkey_column->type_;
+          if (OB_FAIL(sort_key_columns.push_back(column))) {
+            LOG_WARN("fail to push back", K(ret));
+          }
+        }
+      }
+    }
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && can_sort && i < sort_key_columns.count(); ++i) {
+    if (OB_FAIL(generator.add_sort_key_column(sort_key_columns.at(i)))) {
+      LOG_WARN("fail to add sort key column", K(ret));
+    }
+  }
+  LOG_DEBUG("LOAD DATA sort key columns", K(table_id), K(can_sort), K(sort_key_columns));
+  return ret;
+}
+
 void ObCSVFormats::init(const ObDataInFileStruct& file_formats)
 {
   field_term_char_ = file_formats.field_term_str_.empty() ? INT64_MAX : file_formats.field_term_str_[0];
@@ -2684,6 +2787,36 @@ ObShuffleTaskHandle::~ObShuffleTaskHandle()
   }
 }
 
+bool ObLoadSortRowCompare::operator()(const ObLoadSortRow& left, const ObLoadSortRow& right)
+{
+  int& ret = ret_;
+  bool less = false;
+  int cmp = 0;
+  if (OB_FAIL(ret)) {
+    // already failed
+  } else if (left.part_id_ != right.part_id_) {
+    less = left.part_id_ < right.part_id_;
+  } else {
+    for (int64_t i = 0; OB_SUCC(ret) && 0 == cmp && i < key_columns_.count(); ++i) {
+      const ObObj& left_obj = left.key_objs_[i];
+      const ObObj& right_obj = right.key_objs_[i];
+      if (left_obj.is_null() || right_obj.is_null()) {
+        // null is the smallest in rowkey
+        cmp = static_cast<int>(right_obj.is_null()) - static_cast<int>(left_obj.is_null());
+      } else if (OB_FAIL(left_obj.compare(right_obj, key_columns_.at(i).meta_.get_collation_type(), cmp))) {
+        LOG_WARN("fail to compare rowkey", K(ret), K(i), K(left_obj), K(right_obj));
+      }
+    }
+    if (OB_FAIL(ret)) {
+    } else if (0 != cmp) {
+      less = cmp < 0;
+    } else {
+      less = left.line_num_ < right.line_num_;
+    }
+  }
+  return less;
+}
+
 int ObLoadDataSPImpl::exec_shuffle(int64_t task_id, ObShuffleTaskHandle* handle)
 {
   int ret = OB_SUCCESS;
@@ -2693,6 +2826,12 @@ int ObLoadDataSPImpl::exec_shuffle(int64_t task_id, ObShuffleTaskHandle* handle)
   ObArrayHashMap<ObPartitionKey, ObDataFrag*> part_buf_mgr;
   ObSEArray<ObString, 32> insert_values;
   int64_t parsed_line_num = 0;
+  // rows are buffered and sorted by rowkey in each partition before written to data frags,
+  // so that the insert stmts write the memtable in rowkey order
+  bool need_sort = false;
+  const int64_t sort_key_cnt = OB_ISNULL(handle) ? 0 : handle->generator.get_sort_key_column_count();
+  ObArenaAllocator sort_allocator(ObModIds::OB_SQL_LOAD_DATA);
+  ObArray<ObLoadSortRow> sort_rows;
 
   auto save_frag = [&](ObPartitionKey part_key, ObDataFrag* frag) -> bool {
     // store full frag into frag_mgr
@@ -2719,6 +2858,64 @@ int ObLoadDataSPImpl::exec_shuffle(int64_t task_id, ObShuffleTaskHandle* handle)
     return true;
   };
 
+  // get the current frag of the partition, switch to a new one if the row can not fit in
+  auto get_frag = [&](int64_t part_id, int64_t len, ObDataFrag*& frag) -> int {
+    int ret = OB_SUCCESS;
+    ObPartitionKey part_key(handle->calculator.get_table_id(), part_id, 0);
+    int temp_ret = part_buf_mgr.get(part_key, frag);
+    bool frag_exist = (OB_SUCCESS == temp_ret);
+    if (!frag_exist || len > frag->get_remain()) {
+      ObDataFrag* new_frag = NULL;
+      if (OB_FAIL(handle->datafrag_mgr.create_datafrag(new_frag, len))) {
+        LOG_WARN("fail to create data fragment", K(ret));
+      } else {
+        if (frag_exist) {
+          if (OB_UNLIKELY(!save_frag(part_key, frag))) {
+            ret = OB_ERR_UNEXPECTED;
+            LOG_WARN("fail to save frag", K(ret));
+          } else if (OB_FAIL(part_buf_mgr.update(part_key, new_frag))) {
+            // never goes here
+            LOG_ERROR("fail to install new frag", K(ret));
+          }
+        } else {
+          if (OB_FAIL(part_buf_mgr.insert(part_key, new_frag))) {
+            LOG_ERROR("fail to insert new frag", K(ret));
+          }
+        }
+        if (OB_SUCC(ret)) {
+          frag = new_frag;
+          frag->shuffle_task_id = task_id;
+        } else {
+          handle->datafrag_mgr.distory_datafrag(frag);
+        }
+      }
+    }
+    return ret;
+  };
+
+  auto write_sort_rows = [&]() -> int {
+    int ret = OB_SUCCESS;
+    ObLoadSortRowCompare compare(handle->generator.get_sort_key_columns(), ret);
+    std::sort(sort_rows.begin(), sort_rows.end(), compare);
+    if (OB_FAIL(ret)) {
+      LOG_WARN("fail to sort rows", K(ret));
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && i < sort_rows.count(); ++i) {
+      const ObLoadSortRow& row = sort_rows.at(i);
+      ObDataFrag* frag = NULL;
+      if (OB_FAIL(get_frag(row.part_id_, row.row_len_, frag))) {
+        LOG_WARN("fail to get frag", K(ret));
+      } else {
+        MEMCPY(frag->get_current(), row.row_buf_, row.row_len_);
+        frag->add_pos(row.row_len_);
+        frag->add_row_cnt(1);
+      }
+    }
+    sort_rows.reuse();
+    sort_allocator.reset();
+    return ret;
+  };
+
   ((ObArenaAllocator*)(&handle->exec_ctx.get_allocator()))->revert_tracer();
 
   if (OB_ISNULL(handle) || OB_ISNULL(handle->data_buffer) || OB_ISNULL(handle->exec_ctx.get_my_session())) {
@@ -2740,6 +2937,8 @@ int ObLoadDataSPImpl::exec_shuffle(int64_t task_id, ObShuffleTaskHandle* handle)
     expr_buffer = new (expr_buf) ObLoadFileBuffer(ObLoadFileBuffer::MAX_BUFFER_SIZE - sizeof(ObLoadFileBuffer));
     handle->parser.reuse();
     handle->parser.next_buf(handle->data_buffer->begin_ptr(), handle->data_buffer->get_data_len(), true);
+    sort_allocator.set_tenant_id(tenant_id);
+    need_sort = sort_key_cnt > 0;
     bool yield = true;
     while (OB_SUCC(ret) && yield) {
       int temp_ret = handle->parser.next_line(yield);
@@ -2782,54 +2981,70 @@ int ObLoadDataSPImpl::exec_shuffle(int64_t task_id, ObShuffleTaskHandle* handle)
         int64_t row_ser_size = len;
         OB_UNIS_ADD_LEN(row_ser_size);
 
-        ObDataFrag* frag = NULL;
-        if (OB_SUCC(ret)) {
-          ObPartitionKey part_key(handle->calculator.get_table_id(), part_id, 0);
-          int temp_ret = part_buf_mgr.get(part_key, frag);
-          bool frag_exist = (OB_SUCCESS == temp_ret);
-          if (!frag_exist || len > frag->get_remain()) {
-            ObDataFrag* new_frag = NULL;
-            if (OB_FAIL(handle->datafrag_mgr.create_datafrag(new_frag, len))) {
-              LOG_WARN("fail to create data fragment", K(ret));
-            } else {
-              if (frag_exist) {
-                if (OB_UNLIKELY(!save_frag(part_key, frag))) {
-                  ret = OB_ERR_UNEXPECTED;
-                  LOG_WARN("fail to save frag", K(ret));
-                } else if (OB_FAIL(part_buf_mgr.update(part_key, new_frag))) {
-                  // never goes here
-                  LOG_ERROR("fail to install new frag", K(ret));
-                }
-              } else {
-                if (OB_FAIL(part_buf_mgr.insert(part_key, new_frag))) {
-                  LOG_ERROR("fail to insert new frag", K(ret));
-                }
-              }
-              if (OB_SUCC(ret)) {
-                frag = new_frag;
-                frag->shuffle_task_id = task_id;
-              } else {
-                handle->datafrag_mgr.distory_datafrag(frag);
-              }
+        ObLoadSortRow sort_row;
+        if (OB_SUCC(ret) && need_sort) {
+          bool is_valid = false;
+          if (OB_ISNULL(sort_row.key_objs_ =
+                            static_cast<ObObj*>(sort_allocator.alloc(sizeof(ObObj) * sort_key_cnt)))) {
+            ret = OB_ALLOCATE_MEMORY_FAILED;
+            LOG_WARN("fail to alloc sort key", K(ret));
+          } else if (FALSE_IT(new (sort_row.key_objs_) ObObj[sort_key_cnt])) {
+          } else if (OB_FAIL(handle->generator.gen_sort_key(
+                         insert_values, sort_allocator, sort_row.key_objs_, is_valid))) {
+            LOG_WARN("fail to gen sort key", K(ret));
+          } else if (!is_valid) {
+            // write buffered rows out and give up sorting for the rest of the task
+            need_sort = false;
+            if (OB_FAIL(write_sort_rows())) {
+              LOG_WARN("fail to write sort rows", K(ret));
             }
           }
         }
 
+        char* buf = NULL;
+        int64_t buf_len = len;
+        int64_t pos = 0;
+        ObDataFrag* frag = NULL;
+        if (OB_FAIL(ret)) {
+        } else if (need_sort) {
+          if (OB_ISNULL(buf = static_cast<char*>(sort_allocator.alloc(len)))) {
+            ret = OB_ALLOCATE_MEMORY_FAILED;
+            LOG_WARN("fail to alloc sort row", K(ret), K(len));
+          }
+        } else if (OB_FAIL(get_frag(part_id, len, frag))) {
+          LOG_WARN("fail to get frag", K(ret));
+        } else {
+          buf = frag->get_current();
+          buf_len = frag->get_remain();
+        }
+
         if (OB_SUCC(ret)) {
-          char* buf = frag->get_current();
-          int64_t buf_len = frag->get_remain();
-          int64_t pos = 0;
           OB_UNIS_ENCODE(row_ser_size);
           OB_UNIS_ENCODE(cur_line_num);
           OB_UNIS_ENCODE(insert_values);
-          if (OB_SUCC(ret)) {
-            frag->add_pos(pos);
-            frag->add_row_cnt(1);
+        }
+        if (OB_FAIL(ret)) {
+        } else if (need_sort) {
+          sort_row.part_id_ = part_id;
+          sort_row.line_num_ = cur_line_num;
+          sort_row.row_buf_ = buf;
+          sort_row.row_len_ = pos;
+          if (OB_FAIL(sort_rows.push_back(sort_row))) {
+            LOG_WARN("fail to push back sort row", K(ret));
           }
+        } else {
+          frag->add_pos(pos);
+          frag->add_row_cnt(1);
         }
       }  // end if yield
     }    // end while
 
+    if (OB_SUCC(ret) && need_sort) {
+      if (OB_FAIL(write_sort_rows())) {
+        LOG_WARN("fail to write sort rows", K(ret));
+      }
+    }
+
     if (OB_SUCC(ret)) {
       if (OB_FAIL(part_buf_mgr.for_each(save_frag))) {
         LOG_WARN("fail to for each", K(ret));
@@ -4056,6 +4271,8 @@ int ObLoadDataSPImpl::ToolBox::init(ObExecContext& ctx, ObLoadDataStmt& load_stm
     LOG_WARN("fail to init data_trimer", K(ret));
   } else if (OB_FAIL(build_insert_values_generator(ctx, load_stmt, generator))) {
     LOG_WARN("fail to build insert values generator", K(ret));
+  } else if (OB_FAIL(build_sort_key_columns(ctx, load_args.table_id_, generator))) {
+    LOG_WARN("fail to build sort key columns", K(ret));
   } else if (OB_FAIL(generator.gen_insert_columns_names_buff(ctx, load_args, insert_stmt_head_buff))) {
     LOG_WARN("fail to gen insert column names buff", K(ret));
   } else if (OB_FAIL(data_frag_mgr.init(ctx, load_args.table_id_))) {
@@ -80,6 +80,47 @@ struct ObLoadTableColumnDesc {
   TO_STRING_KV(K_(column_name), K_(column_id), K_(is_set_values), K_(array_ref_idx));
 };
 
+// Rowkey column of the target table whose value is taken from the file directly.
+// Rows of a shuffle task are sorted by these columns before they are sent to insert.
+// The sorted rows still go through the insert stmts, the memtable and clog. There is
+// no direct-path load that writes SSTables here.
+struct ObLoadSortKeyColumn {
+  ObLoadSortKeyColumn() : value_idx_(common::OB_INVALID_INDEX_INT64), meta_()
+  {}
+  int64_t value_idx_;  // index in table column values
+  common::ObObjMeta meta_;
+  TO_STRING_KV(K_(value_idx), K_(meta));
+};
+
+// A parsed and serialized row waiting to be written into data frags in rowkey order
+struct ObLoadSortRow {
+  ObLoadSortRow() : part_id_(0), line_num_(0), key_objs_(NULL), row_buf_(NULL), row_len_(0)
+  {}
+  int64_t part_id_;
+  int64_t line_num_;
+  common::ObObj* key_objs_;
+  const char* row_buf_;
+  int64_t row_len_;
+  TO_STRING_KV(K_(part_id), K_(line_num), K_(row_len));
+};
+
+// Order by partition, rowkey, then line number, so that rows with duplicated rowkey
+// keep the file order which decides the result of REPLACE and IGNORE.
+// Rowkey strings are compared with the collation of the column, as the primary key does,
+// so that rows equal in the column collation (e.g. 'a' and 'A' in utf8mb4_general_ci) are
+// duplicates and stay in file order.
+class ObLoadSortRowCompare {
+public:
+  ObLoadSortRowCompare(const common::ObIArray<ObLoadSortKeyColumn>& key_columns, int& ret)
+      : key_columns_(key_columns), ret_(ret)
+  {}
+  bool operator()(const ObLoadSortRow& left, const ObLoadSortRow& right);
+
+private:
+  const common::ObIArray<ObLoadSortKeyColumn>& key_columns_;
+  int& ret_;
+};
+
 class ObInsertValueGenerator {
 public:
   int gen_values(const common::ObIArray<common::ObString>& file_col_values,
@@ -101,10 +142,26 @@ public:
   }
   bool find_table_column_value_desc_by_column_id(const uint64_t column_id, int64_t& idx);
   int gen_insert_columns_names_buff(ObExecContext& ctx, const ObLoadArgument& load_args, common::ObString& data_buff);
+  int add_sort_key_column(const ObLoadSortKeyColumn& column)
+  {
+    return sort_key_columns_.push_back(column);
+  }
+  int64_t get_sort_key_column_count() const
+  {
+    return sort_key_columns_.count();
+  }
+  const common::ObIArray<ObLoadSortKeyColumn>& get_sort_key_columns() const
+  {
+    return sort_key_columns_;
+  }
+  // @is_valid is false if any value can't be converted to the column type, rows are not sorted then
+  int gen_sort_key(const common::ObIArray<common::ObString>& table_column_values, common::ObIAllocator& allocator,
+      common::ObObj* key_objs, bool& is_valid) const;
 
 private:
   common::ObSEArray<ObLoadTableColumnDesc, 16> table_column_value_desc_;
   common::ObSEArray<ObLoadDataReplacedExprInfo, 8> exprs_ref_file_col_;
+  common::ObSEArray<ObLoadSortKeyColumn, 4> sort_key_columns_;
 };
 
 class ObPartIdCalculator {
@@ -902,6 +959,7 @@ public:
 private:
   static int build_insert_values_generator(
       ObExecContext& ctx, ObLoadDataStmt& load_stmt, ObInsertValueGenerator& generator);
+  static int build_sort_key_columns(ObExecContext& ctx, const uint64_t table_id, ObInsertValueGenerator& generator);
   static int recursively_replace_variables(
       ObExecContext& ctx, ObLoadDataStmt& load_stmt, ObInsertValueGenerator& generator, ObRawExpr*& raw_expr);
   // disallow copy
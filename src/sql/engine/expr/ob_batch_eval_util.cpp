@@ -0,0 +1,667 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_ENG
+
+#include "sql/engine/expr/ob_batch_eval_util.h"
+#include <float.h>
+#include <math.h>
+
+namespace oceanbase {
+using namespace common;
+namespace sql {
+
+template <ObCmpOp cmp_op>
+struct ObBatchCmpOp {};
+
+#define DEF_BATCH_CMP_OP(cmp_op, op)                     \
+  template <>                                            \
+  struct ObBatchCmpOp<cmp_op> {                          \
+    template <typename T>                                \
+    OB_INLINE static int64_t apply(const T l, const T r) \
+    {                                                    \
+      return l op r;                                     \
+    }                                                    \
+  };
+
+DEF_BATCH_CMP_OP(CO_EQ, ==);
+DEF_BATCH_CMP_OP(CO_LE, <=);
+DEF_BATCH_CMP_OP(CO_LT, <);
+DEF_BATCH_CMP_OP(CO_GE, >=);
+DEF_BATCH_CMP_OP(CO_GT, >);
+DEF_BATCH_CMP_OP(CO_NE, !=);
+
+#undef DEF_BATCH_CMP_OP
+
+template <typename T, ObCmpOp cmp_op>
+OB_INLINE static void batch_cmp(const void* l, const void* r, int64_t* res, const int64_t n)
+{
+  const T* __restrict lv = static_cast<const T*>(l);
+  const T* __restrict rv = static_cast<const T*>(r);
+  int64_t* __restrict rs = res;
+  for (int64_t i = 0; i < n; i++) {
+    rs[i] = ObBatchCmpOp<cmp_op>::apply(lv[i], rv[i]);
+  }
+}
+
+// Overflow is checked for all elements and accumulated without branch, let the loop vectorized.
+template <typename T>
+struct ObBatchAddOp {};
+
+template <>
+struct ObBatchAddOp<int64_t> {
+  OB_INLINE static bool apply(const int64_t* __restrict l, const int64_t* __restrict r, int64_t* __restrict res,
+      const int64_t n)
+  {
+    uint64_t overflow = 0;
+    for (int64_t i = 0; i < n; i++) {
+      const int64_t v = static_cast<int64_t>(static_cast<uint64_t>(l[i]) + static_cast<uint64_t>(r[i]));
+      res[i] = v;
+      // same sign of operands and different sign of result
+      overflow |= static_cast<uint64_t>((l[i] ^ v) & (r[i] ^ v));
+    }
+    return static_cast<int64_t>(overflow) < 0;
+  }
+};
+
+template <>
+struct ObBatchAddOp<uint64_t> {
+  OB_INLINE static bool apply(const uint64_t* __restrict l, const uint64_t* __restrict r, uint64_t* __restrict res,
+      const int64_t n)
+  {
+    uint64_t overflow = 0;
+    for (int64_t i = 0; i < n; i++) {
+      const uint64_t v = l[i] + r[i];
+      res[i] = v;
+      overflow |= (v < l[i]);
+    }
+    return 0 != overflow;
+  }
+};
+
+template <>
+struct ObBatchAddOp<double> {
+  OB_INLINE static bool apply(const double* __restrict l, const double* __restrict r, double* __restrict res,
+      const int64_t n)
+  {
+    int64_t overflow = 0;
+    for (int64_t i = 0; i < n; i++) {
+      const double v = l[i] + r[i];
+      res[i] = v;
+      overflow |= (fabs(v) > DBL_MAX);
+    }
+    return 0 != overflow;
+  }
+};
+
+template <>
+struct ObBatchAddOp<float> {
+  OB_INLINE static bool apply(const float* __restrict l, const float* __restrict r, float* __restrict res,
+      const int64_t n)
+  {
+    int32_t overflow = 0;
+    for (int64_t i = 0; i < n; i++) {
+      const float v = l[i] + r[i];
+      res[i] = v;
+      overflow |= (fabsf(v) > FLT_MAX);
+    }
+    return 0 != overflow;
+  }
+};
+
+template <typename T>
+OB_INLINE static bool batch_add(const void* l, const void* r, void* res, const int64_t n)
+{
+  return ObBatchAddOp<T>::apply(static_cast<const T*>(l), static_cast<const T*>(r), static_cast<T*>(res), n);
+}
+
+// Define the kernels for each SIMD level, the loops are the same and vectorized by compiler with
+// the instruction set enabled by target attribute.
+#define DEF_BATCH_KERNELS(level, attr)                                                        \
+  template <typename T, ObCmpOp cmp_op>                                                        \
+  attr static void batch_cmp_##level(const void* l, const void* r, int64_t* res, const int64_t n) \
+  {                                                                                            \
+    batch_cmp<T, cmp_op>(l, r, res, n);                                                        \
+  }                                                                                            \
+  template <typename T>                                                                        \
+  attr static bool batch_add_##level(const void* l, const void* r, void* res, const int64_t n) \
+  {                                                                                            \
+    return batch_add<T>(l, r, res, n);                                                         \
+  }
+
+DEF_BATCH_KERNELS(none, );
+#if defined(__x86_64__)
+DEF_BATCH_KERNELS(sse42, __attribute__((target("sse4.2"))));
+DEF_BATCH_KERNELS(avx2, __attribute__((target("avx2"))));
+#endif
+
+#undef DEF_BATCH_KERNELS
+
+static ObBatchEvalUtil::CmpKernel BATCH_CMP_KERNELS[OB_SIMD_MAX][OB_BVC_MAX][CO_MAX];
+static ObBatchEvalUtil::AddKernel BATCH_ADD_KERNELS[OB_SIMD_MAX][OB_BVC_MAX];
+
+template <typename T>
+struct ObBatchValueClassTraits {};
+#define DEF_BATCH_VALUE_CLASS_TRAITS(vc, type) \
+  template <>                                  \
+  struct ObBatchValueClassTraits<type> {       \
+    const static ObBatchValueClass value_ = vc; \
+  };
+DEF_BATCH_VALUE_CLASS_TRAITS(OB_BVC_INT64, int64_t);
+DEF_BATCH_VALUE_CLASS_TRAITS(OB_BVC_UINT64, uint64_t);
+DEF_BATCH_VALUE_CLASS_TRAITS(OB_BVC_DOUBLE, double);
+DEF_BATCH_VALUE_CLASS_TRAITS(OB_BVC_FLOAT, float);
+DEF_BATCH_VALUE_CLASS_TRAITS(OB_BVC_INT32, int32_t);
+#undef DEF_BATCH_VALUE_CLASS_TRAITS
+
+#define INIT_BATCH_CMP_KERNELS(level_id, level, type)                                            \
+  BATCH_CMP_KERNELS[level_id][ObBatchValueClassTraits<type>::value_][CO_EQ] = batch_cmp_##level<type, CO_EQ>; \
+  BATCH_CMP_KERNELS[level_id][ObBatchValueClassTraits<type>::value_][CO_LE] = batch_cmp_##level<type, CO_LE>; \
+  BATCH_CMP_KERNELS[level_id][ObBatchValueClassTraits<type>::value_][CO_LT] = batch_cmp_##level<type, CO_LT>; \
+  BATCH_CMP_KERNELS[level_id][ObBatchValueClassTraits<type>::value_][CO_GE] = batch_cmp_##level<type, CO_GE>; \
+  BATCH_CMP_KERNELS[level_id][ObBatchValueClassTraits<type>::value_][CO_GT] = batch_cmp_##level<type, CO_GT>; \
+  BATCH_CMP_KERNELS[level_id][ObBatchValueClassTraits<type>::value_][CO_NE] = batch_cmp_##level<type, CO_NE>;
+
+#define INIT_BATCH_KERNELS(level_id, level)                                                  \
+  INIT_BATCH_CMP_KERNELS(level_id, level, int64_t);                                          \
+  INIT_BATCH_CMP_KERNELS(level_id, level, uint64_t);                                         \
+  INIT_BATCH_CMP_KERNELS(level_id, level, double);                                           \
+  INIT_BATCH_CMP_KERNELS(level_id, level, float);                                            \
+  INIT_BATCH_CMP_KERNELS(level_id, level, int32_t);                                          \
+  BATCH_ADD_KERNELS[level_id][OB_BVC_INT64] = batch_add_##level<int64_t>;                    \
+  BATCH_ADD_KERNELS[level_id][OB_BVC_UINT64] = batch_add_##level<uint64_t>;                  \
+  BATCH_ADD_KERNELS[level_id][OB_BVC_DOUBLE] = batch_add_##level<double>;                    \
+  BATCH_ADD_KERNELS[level_id][OB_BVC_FLOAT] = batch_add_##level<float>;
+
+static bool init_batch_kernels()
+{
+  INIT_BATCH_KERNELS(OB_SIMD_NONE, none);
+#if defined(__x86_64__)
+  INIT_BATCH_KERNELS(OB_SIMD_SSE42, sse42);
+  INIT_BATCH_KERNELS(OB_SIMD_AVX2, avx2);
+#else
+  // no SIMD kernels for other architectures, use the default ones.
+  MEMCPY(BATCH_CMP_KERNELS[OB_SIMD_SSE42], BATCH_CMP_KERNELS[OB_SIMD_NONE], sizeof(BATCH_CMP_KERNELS[0]));
+  MEMCPY(BATCH_CMP_KERNELS[OB_SIMD_AVX2], BATCH_CMP_KERNELS[OB_SIMD_NONE], sizeof(BATCH_CMP_KERNELS[0]));
+  MEMCPY(BATCH_ADD_KERNELS[OB_SIMD_SSE42], BATCH_ADD_KERNELS[OB_SIMD_NONE], sizeof(BATCH_ADD_KERNELS[0]));
+  MEMCPY(BATCH_ADD_KERNELS[OB_SIMD_AVX2], BATCH_ADD_KERNELS[OB_SIMD_NONE], sizeof(BATCH_ADD_KERNELS[0]));
+#endif
+  return true;
+}
+
+#undef INIT_BATCH_KERNELS
+#undef INIT_BATCH_CMP_KERNELS
+
+static bool g_batch_kernels_inited = init_batch_kernels();
+
+static ObSimdLevel detect_simd_level()
+{
+  ObSimdLevel level = OB_SIMD_NONE;
+#if defined(__x86_64__)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    level = OB_SIMD_AVX2;
+  } else if (__builtin_cpu_supports("sse4.2")) {
+    level = OB_SIMD_SSE42;
+  }
+#endif
+  _OB_LOG(INFO, "batch evaluation SIMD level: %s", ObBatchEvalUtil::get_simd_level_str(level));
+  return level;
+}
+
+ObSimdLevel ObBatchEvalUtil::get_simd_level()
+{
+  static ObSimdLevel level = detect_simd_level();
+  return level;
+}
+
+const char* ObBatchEvalUtil::get_simd_level_str(const ObSimdLevel level)
+{
+  static const char* level_strs[] = {"NONE", "SSE4.2", "AVX2"};
+  static_assert(ARRAYSIZEOF(level_strs) == OB_SIMD_MAX, "unexpected size");
+  return (level >= 0 && level < OB_SIMD_MAX) ? level_strs[level] : "UNKNOWN";
+}
+
+ObBatchValueClass ObBatchEvalUtil::get_value_class(const ObObjType type)
+{
+  ObBatchValueClass vc = OB_BVC_INVALID;
+  switch (ob_obj_type_class(type)) {
+    case ObIntTC:
+    case ObDateTimeTC:
+    case ObTimeTC:
+      vc = OB_BVC_INT64;
+      break;
+    case ObUIntTC:
+      vc = OB_BVC_UINT64;
+      break;
+    case ObDoubleTC:
+      vc = OB_BVC_DOUBLE;
+      break;
+    case ObFloatTC:
+      vc = OB_BVC_FLOAT;
+      break;
+    case ObDateTC:
+      vc = OB_BVC_INT32;
+      break;
+    default:
+      vc = OB_BVC_INVALID;
+      break;
+  }
+  return vc;
+}
+
+int64_t ObBatchEvalUtil::get_value_size(const ObBatchValueClass vc)
+{
+  int64_t size = 0;
+  switch (vc) {
+    case OB_BVC_INT64:
+    case OB_BVC_UINT64:
+    case OB_BVC_DOUBLE:
+      size = 8;
+      break;
+    case OB_BVC_FLOAT:
+    case OB_BVC_INT32:
+      size = 4;
+      break;
+    default:
+      size = 0;
+      break;
+  }
+  return size;
+}
+
+ObBatchEvalUtil::CmpKernel ObBatchEvalUtil::get_cmp_kernel(
+    const ObBatchValueClass vc, const ObCmpOp cmp_op, const ObSimdLevel level)
+{
+  CmpKernel kernel = NULL;
+  if (vc > OB_BVC_INVALID && vc < OB_BVC_MAX && cmp_op >= CO_EQ && cmp_op < CO_CMP && level >= OB_SIMD_NONE &&
+      level < OB_SIMD_MAX) {
+    kernel = BATCH_CMP_KERNELS[level][vc][cmp_op];
+  }
+  return kernel;
+}
+
+ObBatchEvalUtil::AddKernel ObBatchEvalUtil::get_add_kernel(const ObBatchValueClass vc, const ObSimdLevel level)
+{
+  AddKernel kernel = NULL;
+  if (vc > OB_BVC_INVALID && vc < OB_BVC_MAX && level >= OB_SIMD_NONE && level < OB_SIMD_MAX) {
+    kernel = BATCH_ADD_KERNELS[level][vc];
+  }
+  return kernel;
+}
+
+bool ObBatchEvalUtil::is_batch_safe(const ObExpr& expr, const bool always_evaluated)
+{
+  bool safe = NULL == expr.eval_func_ || !expr.is_batch_result();
+  if (!safe && NULL != expr.eval_batch_func_) {
+    // only addition may fail in batch evaluation
+    safe = (always_evaluated || T_OP_ADD != expr.type_) && is_args_batch_safe(expr, always_evaluated);
+  }
+  return safe;
+}
+
+bool ObBatchEvalUtil::is_args_batch_safe(const ObExpr& expr, const bool always_evaluated)
+{
+  bool safe = true;
+  for (int64_t i = 0; safe && i < expr.arg_cnt_; i++) {
+    safe = is_batch_safe(*expr.args_[i], always_evaluated && is_arg_always_evaluated(expr, i));
+  }
+  return safe;
+}
+
+template <typename T>
+OB_INLINE static void gather_values(const ObDatum* datums, const ObBitVector& skip, const int64_t begin,
+    const int64_t n, T* values, ObBitVector& nulls)
+{
+  for (int64_t i = 0; i < n; i++) {
+    const ObDatum& d = datums[begin + i];
+    if (skip.at(begin + i) || d.is_null()) {
+      values[i] = 0;
+      nulls.set(i);
+    } else {
+      values[i] = *reinterpret_cast<const T*>(d.ptr_);
+    }
+  }
+}
+
+template <typename T>
+OB_INLINE static void fill_values(const ObDatum& datum, const int64_t n, T* values, ObBitVector& nulls)
+{
+  if (datum.is_null()) {
+    MEMSET(values, 0, sizeof(T) * n);
+    nulls.set_all(n);
+  } else {
+    const T v = *reinterpret_cast<const T*>(datum.ptr_);
+    for (int64_t i = 0; i < n; i++) {
+      values[i] = v;
+    }
+  }
+}
+
+void ObBatchEvalUtil::gather(const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip,
+    const ObBatchValueClass vc, const int64_t begin, const int64_t n, char* values, ObBitVector& nulls)
+{
+  nulls.reset(n);
+  if (!expr.is_batch_result()) {
+    const ObDatum& datum = expr.locate_expr_datum(ctx);
+    switch (vc) {
+      case OB_BVC_INT64:
+        fill_values(datum, n, reinterpret_cast<int64_t*>(values), nulls);
+        break;
+      case OB_BVC_UINT64:
+        fill_values(datum, n, reinterpret_cast<uint64_t*>(values), nulls);
+        break;
+      case OB_BVC_DOUBLE:
+        fill_values(datum, n, reinterpret_cast<double*>(values), nulls);
+        break;
+      case OB_BVC_FLOAT:
+        fill_values(datum, n, reinterpret_cast<float*>(values), nulls);
+        break;
+      case OB_BVC_INT32:
+        fill_values(datum, n, reinterpret_cast<int32_t*>(values), nulls);
+        break;
+      default:
+        nulls.set_all(n);
+        break;
+    }
+  } else {
+    const ObDatum* datums = expr.locate_batch_datums(ctx);
+    switch (vc) {
+      case OB_BVC_INT64:
+        gather_values(datums, skip, begin, n, reinterpret_cast<int64_t*>(values), nulls);
+        break;
+      case OB_BVC_UINT64:
+        gather_values(datums, skip, begin, n, reinterpret_cast<uint64_t*>(values), nulls);
+        break;
+      case OB_BVC_DOUBLE:
+        gather_values(datums, skip, begin, n, reinterpret_cast<double*>(values), nulls);
+        break;
+      case OB_BVC_FLOAT:
+        gather_values(datums, skip, begin, n, reinterpret_cast<float*>(values), nulls);
+        break;
+      case OB_BVC_INT32:
+        gather_values(datums, skip, begin, n, reinterpret_cast<int32_t*>(values), nulls);
+        break;
+      default:
+        nulls.set_all(n);
+        break;
+    }
+  }
+}
+
+void ObBatchEvalUtil::scatter_int(const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip, const int64_t begin,
+    const int64_t n, const int64_t* res, const ObBitVector& nulls)
+{
+  ObEvalCtx::BatchInfoScopeGuard batch_info_guard(ctx);
+  for (int64_t i = 0; i < n; i++) {
+    if (!skip.at(begin + i)) {
+      batch_info_guard.set_batch_idx(begin + i);
+      ObDatum& datum = expr.locate_datum_for_write(ctx);
+      if (nulls.at(i)) {
+        datum.set_null();
+      } else {
+        datum.set_int(res[i]);
+      }
+    }
+  }
+}
+
+void ObBatchEvalUtil::scatter(const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip,
+    const ObBatchValueClass vc, const int64_t begin, const int64_t n, const char* res, const ObBitVector& nulls)
+{
+  ObEvalCtx::BatchInfoScopeGuard batch_info_guard(ctx);
+  for (int64_t i = 0; i < n; i++) {
+    if (!skip.at(begin + i)) {
+      batch_info_guard.set_batch_idx(begin + i);
+      ObDatum& datum = expr.locate_datum_for_write(ctx);
+      if (nulls.at(i)) {
+        datum.set_null();
+      } else {
+        switch (vc) {
+          case OB_BVC_INT64:
+            datum.set_int(reinterpret_cast<const int64_t*>(res)[i]);
+            break;
+          case OB_BVC_UINT64:
+            datum.set_uint(reinterpret_cast<const uint64_t*>(res)[i]);
+            break;
+          case OB_BVC_DOUBLE:
+            datum.set_double(reinterpret_cast<const double*>(res)[i]);
+            break;
+          case OB_BVC_FLOAT:
+            datum.set_float(reinterpret_cast<const float*>(res)[i]);
+            break;
+          case OB_BVC_INT32:
+            datum.set_int32(reinterpret_cast<const int32_t*>(res)[i]);
+            break;
+          default:
+            datum.set_null();
+            break;
+        }
+      }
+    }
+  }
+}
+
+int ObBatchEvalUtil::eval_args_batch(const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size)
+{
+  int ret = OB_SUCCESS;
+  for (int64_t i = 0; OB_SUCC(ret) && i < expr.arg_cnt_; i++) {
+    if (OB_FAIL(expr.args_[i]->eval_batch(ctx, skip, size))) {
+      LOG_WARN("evaluate argument in batch failed", K(ret), K(i));
+    }
+  }
+  return ret;
+}
+
+int ObBatchEvalUtil::eval_cmp_batch(const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size,
+    const ObBatchValueClass vc, const ObCmpOp cmp_op)
+{
+  int ret = OB_SUCCESS;
+  CmpKernel kernel = get_cmp_kernel(vc, cmp_op);
+  if (OB_UNLIKELY(2 != expr.arg_cnt_) || NULL == kernel || !is_args_batch_safe(expr, true)) {
+    ret = expr.eval_batch_by_row(ctx, skip, size);
+  } else if (OB_FAIL(eval_args_batch(expr, ctx, skip, size))) {
+    LOG_WARN("evaluate arguments failed", K(ret));
+  } else {
+    ObBatchChunkBuf l_buf;
+    ObBatchChunkBuf r_buf;
+    int64_t res[CHUNK_SIZE];
+    for (int64_t begin = 0; begin < size; begin += CHUNK_SIZE) {
+      const int64_t n = std::min(size - begin, static_cast<int64_t>(CHUNK_SIZE));
+      gather(*expr.args_[0], ctx, skip, vc, begin, n, l_buf.values_, l_buf.nulls());
+      gather(*expr.args_[1], ctx, skip, vc, begin, n, r_buf.values_, r_buf.nulls());
+      l_buf.nulls().bit_or(r_buf.nulls(), n);
+      kernel(l_buf.values_, r_buf.values_, res, n);
+      scatter_int(expr, ctx, skip, begin, n, res, l_buf.nulls());
+    }
+  }
+  return ret;
+}
+
+int ObBatchEvalUtil::eval_add_batch(
+    const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size, const ObBatchValueClass vc)
+{
+  int ret = OB_SUCCESS;
+  AddKernel kernel = get_add_kernel(vc);
+  bool overflow = false;
+  if (OB_UNLIKELY(2 != expr.arg_cnt_) || NULL == kernel || !is_args_batch_safe(expr, true)) {
+    ret = expr.eval_batch_by_row(ctx, skip, size);
+  } else if (OB_FAIL(eval_args_batch(expr, ctx, skip, size))) {
+    LOG_WARN("evaluate arguments failed", K(ret));
+  } else {
+    ObBatchChunkBuf l_buf;
+    ObBatchChunkBuf r_buf;
+    char res[CHUNK_SIZE * sizeof(int64_t)] __attribute__((aligned(32)));
+    for (int64_t begin = 0; !overflow && begin < size; begin += CHUNK_SIZE) {
+      const int64_t n = std::min(size - begin, static_cast<int64_t>(CHUNK_SIZE));
+      gather(*expr.args_[0], ctx, skip, vc, begin, n, l_buf.values_, l_buf.nulls());
+      gather(*expr.args_[1], ctx, skip, vc, begin, n, r_buf.values_, r_buf.nulls());
+      l_buf.nulls().bit_or(r_buf.nulls(), n);
+      // null or skipped values are zero, never overflow.
+      overflow = kernel(l_buf.values_, r_buf.values_, res, n);
+      if (!overflow) {
+        scatter(expr, ctx, skip, vc, begin, n, res, l_buf.nulls());
+      }
+    }
+    if (overflow) {
+      // evaluate row by row to report the overflow error of the exact row.
+      ret = expr.eval_batch_by_row(ctx, skip, size);
+    }
+  }
+  return ret;
+}
+
+int ObBatchEvalUtil::eval_logical_batch(
+    const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size, const bool is_and)
+{
+  int ret = OB_SUCCESS;
+  bool batch_safe = is_args_batch_safe(expr, true);
+  for (int64_t i = 0; batch_safe && i < expr.arg_cnt_; i++) {
+    batch_safe = ob_is_int_tc(expr.args_[i]->datum_meta_.type_);
+  }
+  if (!batch_safe) {
+    ret = expr.eval_batch_by_row(ctx, skip, size);
+  } else if (OB_FAIL(eval_args_batch(expr, ctx, skip, size))) {
+    LOG_WARN("evaluate arguments failed", K(ret));
+  } else {
+    ObBatchChunkBuf arg_buf;
+    ObBatchChunkBuf res_buf;
+    // the decisive value bits of the chunk: false for AND, true for OR.
+    uint64_t decisive_bits[CHUNK_SIZE / 64];
+    const int64_t decisive_value = is_and ? 0 : 1;
+    for (int64_t begin = 0; begin < size; begin += CHUNK_SIZE) {
+      const int64_t n = std::min(size - begin, static_cast<int64_t>(CHUNK_SIZE));
+      const int64_t words = ObBitVector::word_count(n);
+      uint64_t* arg_nulls = arg_buf.null_bits_;
+      uint64_t* res_nulls = res_buf.null_bits_;
+      MEMSET(decisive_bits, 0, sizeof(decisive_bits));
+      MEMSET(res_nulls, 0, sizeof(res_buf.null_bits_));
+      for (int64_t i = 0; i < expr.arg_cnt_; i++) {
+        gather(*expr.args_[i], ctx, skip, OB_BVC_INT64, begin, n, arg_buf.values_, arg_buf.nulls());
+        const int64_t* values = arg_buf.ints();
+        for (int64_t w = 0; w < words; w++) {
+          uint64_t bits = 0;
+          const int64_t end = std::min(n, (w + 1) * 64);
+          for (int64_t j = w * 64; j < end; j++) {
+            bits |= static_cast<uint64_t>((0 != values[j]) == (0 != decisive_value)) << (j & 63);
+          }
+          decisive_bits[w] |= bits & ~arg_nulls[w];
+          res_nulls[w] |= arg_nulls[w];
+        }
+      }
+      // decisive value overrides null
+      for (int64_t w = 0; w < words; w++) {
+        res_nulls[w] &= ~decisive_bits[w];
+      }
+      int64_t* res = res_buf.ints();
+      const ObBitVector& decisive = *to_bit_vector(decisive_bits);
+      for (int64_t j = 0; j < n; j++) {
+        res[j] = decisive.at(j) ? decisive_value : !decisive_value;
+      }
+      scatter_int(expr, ctx, skip, begin, n, res, res_buf.nulls());
+    }
+  }
+  return ret;
+}
+
+int ObBatchEvalUtil::eval_between_batch(const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip,
+    const int64_t size, const ObBatchValueClass vc)
+{
+  int ret = OB_SUCCESS;
+  CmpKernel kernel = get_cmp_kernel(vc, CO_LE);
+  if (OB_UNLIKELY(3 != expr.arg_cnt_) || NULL == kernel || !is_args_batch_safe(expr, true)) {
+    ret = expr.eval_batch_by_row(ctx, skip, size);
+  } else if (OB_FAIL(eval_args_batch(expr, ctx, skip, size))) {
+    LOG_WARN("evaluate arguments failed", K(ret));
+  } else {
+    ObBatchChunkBuf val_buf;
+    ObBatchChunkBuf left_buf;
+    ObBatchChunkBuf right_buf;
+    ObBatchChunkBuf res_buf;
+    int64_t left_cmp[CHUNK_SIZE];   // left <= val
+    int64_t right_cmp[CHUNK_SIZE];  // val <= right
+    for (int64_t begin = 0; begin < size; begin += CHUNK_SIZE) {
+      const int64_t n = std::min(size - begin, static_cast<int64_t>(CHUNK_SIZE));
+      gather(*expr.args_[0], ctx, skip, vc, begin, n, val_buf.values_, val_buf.nulls());
+      gather(*expr.args_[1], ctx, skip, vc, begin, n, left_buf.values_, left_buf.nulls());
+      gather(*expr.args_[2], ctx, skip, vc, begin, n, right_buf.values_, right_buf.nulls());
+      kernel(left_buf.values_, val_buf.values_, left_cmp, n);
+      kernel(val_buf.values_, right_buf.values_, right_cmp, n);
+      ObBitVector& res_nulls = res_buf.nulls();
+      res_nulls.reset(n);
+      int32_t* res = reinterpret_cast<int32_t*>(res_buf.values_);
+      for (int64_t i = 0; i < n; i++) {
+        // null bound is treated as satisfied, see calc_between_expr()
+        const bool left_null = left_buf.nulls().at(i);
+        const bool right_null = right_buf.nulls().at(i);
+        const bool left_succ = left_null || 0 != left_cmp[i];
+        const bool right_succ = right_null || 0 != right_cmp[i];
+        res[i] = left_succ && right_succ;
+        if (val_buf.nulls().at(i) || (left_null && right_succ) || (right_null && left_succ)) {
+          res_nulls.set(i);
+        }
+      }
+      scatter(expr, ctx, skip, OB_BVC_INT32, begin, n, res_buf.values_, res_nulls);
+    }
+  }
+  return ret;
+}
+
+int ObBatchEvalUtil::eval_in_batch(const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size,
+    const ObBatchValueClass vc)
+{
+  int ret = OB_SUCCESS;
+  CmpKernel kernel = get_cmp_kernel(vc, CO_EQ);
+  bool batch_safe = 2 == expr.arg_cnt_ && NULL != kernel && is_batch_safe(*expr.args_[0], true);
+  const ObExpr* params = batch_safe ? expr.args_[1] : NULL;
+  if (batch_safe) {
+    batch_safe = params->arg_cnt_ > 0 && params->arg_cnt_ <= MAX_BATCH_IN_PARAM_CNT;
+  }
+  // parameters must be not null values which need no evaluation.
+  for (int64_t i = 0; batch_safe && i < params->arg_cnt_; i++) {
+    const ObExpr* param = params->args_[i];
+    batch_safe = NULL == param->eval_func_ && !param->is_batch_result() && !param->locate_expr_datum(ctx).is_null();
+  }
+  if (!batch_safe) {
+    ret = expr.eval_batch_by_row(ctx, skip, size);
+  } else if (OB_FAIL(expr.args_[0]->eval_batch(ctx, skip, size))) {
+    LOG_WARN("evaluate left argument failed", K(ret));
+  } else {
+    const bool is_in = T_OP_IN == expr.type_;
+    ObBatchChunkBuf left_buf;
+    ObBatchChunkBuf param_buf;
+    int64_t res[CHUNK_SIZE];
+    int64_t eq_res[CHUNK_SIZE];
+    for (int64_t begin = 0; begin < size; begin += CHUNK_SIZE) {
+      const int64_t n = std::min(size - begin, static_cast<int64_t>(CHUNK_SIZE));
+      gather(*expr.args_[0], ctx, skip, vc, begin, n, left_buf.values_, left_buf.nulls());
+      MEMSET(res, 0, sizeof(res[0]) * n);
+      for (int64_t i = 0; i < params->arg_cnt_; i++) {
+        gather(*params->args_[i], ctx, skip, vc, begin, n, param_buf.values_, param_buf.nulls());
+        kernel(left_buf.values_, param_buf.values_, eq_res, n);
+        for (int64_t j = 0; j < n; j++) {
+          res[j] |= eq_res[j];
+        }
+      }
+      if (!is_in) {
+        for (int64_t j = 0; j < n; j++) {
+          res[j] = !res[j];
+        }
+      }
+      scatter_int(expr, ctx, skip, begin, n, res, left_buf.nulls());
+    }
+  }
+  return ret;
+}
+
+}  // end namespace sql
+}  // end namespace oceanbase
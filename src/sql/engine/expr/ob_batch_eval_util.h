@@ -0,0 +1,163 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_SQL_ENGINE_EXPR_OB_BATCH_EVAL_UTIL_H_
+#define OCEANBASE_SQL_ENGINE_EXPR_OB_BATCH_EVAL_UTIL_H_
+
+#include "common/object/ob_obj_type.h"
+#include "common/object/ob_obj_compare.h"
+#include "sql/engine/expr/ob_expr.h"
+
+namespace oceanbase {
+namespace sql {
+
+// SIMD instruction set used by batch evaluation kernels, detected by cpuid at first use.
+enum ObSimdLevel {
+  OB_SIMD_NONE = 0,
+  OB_SIMD_SSE42,
+  OB_SIMD_AVX2,
+  OB_SIMD_MAX
+};
+
+// Fixed length value class of datum which batch evaluation kernels defined for.
+enum ObBatchValueClass {
+  OB_BVC_INVALID = 0,
+  OB_BVC_INT64,   // ObIntTC, ObDateTimeTC, ObTimeTC
+  OB_BVC_UINT64,  // ObUIntTC
+  OB_BVC_DOUBLE,  // ObDoubleTC
+  OB_BVC_FLOAT,   // ObFloatTC
+  OB_BVC_INT32,   // ObDateTC
+  OB_BVC_MAX
+};
+
+//
+// Batch evaluation is done chunk by chunk:
+//   1. gather argument values and null flags of CHUNK_SIZE rows to contiguous arrays.
+//   2. call the SIMD kernel of the arrays.
+//   3. set result datums of the rows not skipped.
+//
+// The datums of batch are pointers to values (maybe located in storage blocks), so gather and
+// scatter are scalar, only the kernels are vectorized.
+//
+class ObBatchEvalUtil {
+public:
+  const static int64_t CHUNK_SIZE = 256;
+
+  // res[i] = l[i] <cmp_op> r[i] ? 1 : 0
+  typedef void (*CmpKernel)(const void* l, const void* r, int64_t* res, const int64_t n);
+  // res[i] = l[i] + r[i], return true if any result overflow.
+  typedef bool (*AddKernel)(const void* l, const void* r, void* res, const int64_t n);
+
+  // SIMD level of current CPU
+  static ObSimdLevel get_simd_level();
+  static const char* get_simd_level_str(const ObSimdLevel level);
+
+  static ObBatchValueClass get_value_class(const common::ObObjType type);
+  static int64_t get_value_size(const ObBatchValueClass vc);
+
+  // Get kernels for current CPU, NULL returned if not supported.
+  static CmpKernel get_cmp_kernel(const ObBatchValueClass vc, const common::ObCmpOp cmp_op)
+  {
+    return get_cmp_kernel(vc, cmp_op, get_simd_level());
+  }
+  static AddKernel get_add_kernel(const ObBatchValueClass vc)
+  {
+    return get_add_kernel(vc, get_simd_level());
+  }
+  // Get kernels for specified SIMD level, the caller should make sure CPU supports it.
+  static CmpKernel get_cmp_kernel(const ObBatchValueClass vc, const common::ObCmpOp cmp_op, const ObSimdLevel level);
+  static AddKernel get_add_kernel(const ObBatchValueClass vc, const ObSimdLevel level);
+
+  // Arguments are evaluated in batch with the same skip bitmap as parent, without short circuit.
+  // Only column reference, const or expression with batch kernel (all arguments are batch safe
+  // too) is safe, others need to be evaluated row by row to keep the short circuit semantics.
+  // Expression may fail in batch evaluation (e.g.: add overflow) is safe only if it is always
+  // evaluated by parent in row mode, otherwise error of short circuited rows may be raised.
+  // %always_evaluated: %expr is evaluated for every row not skipped in row mode.
+  static bool is_batch_safe(const ObExpr& expr, const bool always_evaluated);
+  static bool is_args_batch_safe(const ObExpr& expr, const bool always_evaluated);
+
+  // Gather values of the chunk [begin, begin + n) to %values, set %nulls bit for null
+  // values. Skipped rows are gathered as null (value is zero), never dereferenced.
+  // %expr must be evaluated in batch, both batch result and non batch result are supported.
+  static void gather(const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip, const ObBatchValueClass vc,
+      const int64_t begin, const int64_t n, char* values, ObBitVector& nulls);
+
+  // Set int result datums of the chunk [begin, begin + n) for rows not skipped, null if
+  // %nulls bit is set.
+  static void scatter_int(const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip, const int64_t begin,
+      const int64_t n, const int64_t* res, const ObBitVector& nulls);
+
+  // Set fixed length result datums of the chunk [begin, begin + n).
+  static void scatter(const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip, const ObBatchValueClass vc,
+      const int64_t begin, const int64_t n, const char* res, const ObBitVector& nulls);
+
+  // Evaluate all arguments in batch.
+  // NOTE: batch evaluate functions are called only if the expression is evaluated for every row
+  // not skipped (by operator or batch safe parent), so %always_evaluated is true for arguments check.
+  static int eval_args_batch(const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size);
+
+  // Batch evaluate %cmp_op comparison of two arguments with value class %vc,
+  // fallback to evaluate row by row if arguments are not batch safe.
+  static int eval_cmp_batch(const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size,
+      const ObBatchValueClass vc, const common::ObCmpOp cmp_op);
+  // Batch evaluate addition of two arguments with value class %vc, evaluate row by row again
+  // if overflow detected to report the same error with row mode.
+  static int eval_add_batch(const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size,
+      const ObBatchValueClass vc);
+  // Batch evaluate AND (%is_and is true) or OR of int arguments, with three valued logic:
+  //   AND: false > null > true
+  //   OR:  true > null > false
+  static int eval_logical_batch(
+      const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size, const bool is_and);
+  // Batch evaluate `val BETWEEN left AND right` with value class %vc, same null semantics with
+  // calc_between_expr().
+  static int eval_between_batch(const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size,
+      const ObBatchValueClass vc);
+  // Batch evaluate `left [NOT] IN (c1, c2 ...)` with value class %vc, the parameters are
+  // not null const values, compared one by one.
+  static int eval_in_batch(const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size,
+      const ObBatchValueClass vc);
+
+  // Max parameter count of IN expression evaluated in batch.
+  const static int64_t MAX_BATCH_IN_PARAM_CNT = 16;
+
+private:
+  // Argument is evaluated for every row in row mode (not short circuited by previous arguments).
+  // The first argument of the expressions with batch function is always evaluated.
+  static bool is_arg_always_evaluated(const ObExpr& expr, const int64_t arg_idx)
+  {
+    return 0 == arg_idx || (T_OP_ADD == expr.type_ && !lib::is_oracle_mode());
+  }
+};
+
+// Stack buffer of one chunk values and null bitmap.
+struct ObBatchChunkBuf {
+  ObBatchChunkBuf()
+  {}
+  ObBitVector& nulls()
+  {
+    return *to_bit_vector(null_bits_);
+  }
+  int64_t* ints()
+  {
+    return reinterpret_cast<int64_t*>(values_);
+  }
+
+  char values_[ObBatchEvalUtil::CHUNK_SIZE * sizeof(int64_t)] __attribute__((aligned(32)));
+  uint64_t null_bits_[ObBatchEvalUtil::CHUNK_SIZE / 64];
+};
+
+}  // end namespace sql
+}  // end namespace oceanbase
+
+#endif  // OCEANBASE_SQL_ENGINE_EXPR_OB_BATCH_EVAL_UTIL_H_
@@ -31,7 +31,12 @@ STATIC_ASSERT(sizeof(ObPrecision) == sizeof(ObLengthSemantics), "size of ObPreci
 OB_SERIALIZE_MEMBER(ObDatumMeta, type_, cs_type_, scale_, precision_);
 
 ObEvalCtx::ObEvalCtx(ObExecContext& exec_ctx, ObArenaAllocator& res_alloc, ObArenaAllocator& tmp_alloc)
-    : frames_(exec_ctx.get_frames()), exec_ctx_(exec_ctx), expr_res_alloc_(res_alloc), tmp_alloc_(tmp_alloc)
+    : frames_(exec_ctx.get_frames()),
+      exec_ctx_(exec_ctx),
+      batch_idx_(0),
+      batch_size_(0),
+      expr_res_alloc_(res_alloc),
+      tmp_alloc_(tmp_alloc)
 
 {}
 
@@ -75,7 +80,7 @@ OB_DEF_SERIALIZE(ObExpr)
     }
   }
 
-  LST_DO_CODE(OB_UNIS_ENCODE, eval_info_off_);
+  LST_DO_CODE(OB_UNIS_ENCODE, eval_info_off_, batch_idx_mask_, ser_eval_batch_func_);
 
   return ret;
 }
@@ -112,7 +117,7 @@ OB_DEF_DESERIALIZE(ObExpr)
     }
   }
 
-  LST_DO_CODE(OB_UNIS_DECODE, eval_info_off_);
+  LST_DO_CODE(OB_UNIS_DECODE, eval_info_off_, batch_idx_mask_, ser_eval_batch_func_);
   if (0 == eval_info_off_ && OB_SUCC(ret)) {
     // compatible with 3.0, ObExprDatum::flag_ is ObEvalInfo
     eval_info_off_ = datum_off_ + sizeof(ObDatum);
@@ -153,7 +158,7 @@ OB_DEF_SERIALIZE_SIZE(ObExpr)
     OB_UNIS_ADD_LEN(extra_);
   }
 
-  LST_DO_CODE(OB_UNIS_ADD_LEN, eval_info_off_);
+  LST_DO_CODE(OB_UNIS_ADD_LEN, eval_info_off_, batch_idx_mask_, ser_eval_batch_func_);
 
   return len;
 }
@@ -166,6 +171,7 @@ ObExpr::ObExpr()
       max_length_(UINT32_MAX),
       obj_datum_map_(OBJ_DATUM_NULL),
       eval_func_(NULL),
+      eval_batch_func_(NULL),
       inner_functions_(NULL),
       inner_func_cnt_(0),
       args_(NULL),
@@ -179,7 +185,8 @@ ObExpr::ObExpr()
       res_buf_len_(0),
       expr_ctx_id_(INVALID_EXP_CTX_ID),
       extra_(0),
-      basic_funcs_(NULL)
+      basic_funcs_(NULL),
+      batch_idx_mask_(0)
 {}
 
 char* ObExpr::alloc_str_res_mem(ObEvalCtx& ctx, const int64_t size) const
@@ -189,8 +196,9 @@ char* ObExpr::alloc_str_res_mem(ObEvalCtx& ctx, const int64_t size) const
   if (OB_UNLIKELY(!ObDynReserveBuf::supported(datum_meta_.type_))) {
     LOG_ERROR("unexpected alloc string result memory called", K(size), K(*this));
   } else {
-    ObDynReserveBuf* drb =
-        reinterpret_cast<ObDynReserveBuf*>(ctx.frames_[frame_idx_] + res_buf_off_ - sizeof(ObDynReserveBuf));
+    // dynamic reserved buffers are stored in reverse order before the reserved buffers.
+    const int64_t idx = ctx.batch_idx_ & batch_idx_mask_;
+    ObDynReserveBuf* drb = reinterpret_cast<ObDynReserveBuf*>(ctx.frames_[frame_idx_] + res_buf_off_) - (idx + 1);
     if (OB_LIKELY(drb->len_ >= size)) {
       mem = drb->mem_;
     } else {
@@ -216,6 +224,39 @@ char* ObExpr::alloc_str_res_mem(ObEvalCtx& ctx, const int64_t size) const
   return mem;
 };
 
+// Clear evaluated flag of the expression tree which need evaluate for each row of batch.
+static void clear_batch_evaluated_flag(const ObExpr& expr, ObEvalCtx& ctx)
+{
+  if (NULL != expr.eval_func_ && expr.is_batch_result()) {
+    ObEvalInfo& info = expr.get_eval_info(ctx);
+    if (!info.projected_) {
+      info.clear_evaluated_flag();
+      for (int64_t i = 0; i < expr.arg_cnt_; i++) {
+        clear_batch_evaluated_flag(*expr.args_[i], ctx);
+      }
+    }
+  }
+}
+
+int ObExpr::eval_batch_by_row(ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size) const
+{
+  int ret = OB_SUCCESS;
+  ObEvalCtx::BatchInfoScopeGuard batch_info_guard(ctx);
+  batch_info_guard.set_batch_size(size);
+  ObDatum* datum = NULL;
+  for (int64_t i = 0; OB_SUCC(ret) && i < size; i++) {
+    if (skip.at(i)) {
+      continue;
+    }
+    batch_info_guard.set_batch_idx(i);
+    clear_batch_evaluated_flag(*this, ctx);
+    if (OB_FAIL(eval(ctx, datum))) {
+      LOG_WARN("expr evaluate failed", K(ret), K(i), K(*this));
+    }
+  }
+  return ret;
+}
+
 int ObExpr::eval_enumset(ObEvalCtx& ctx, const common::ObIArray<common::ObString>& str_values, const uint64_t cast_mode,
     common::ObDatum*& datum) const
 {
@@ -223,13 +264,15 @@ int ObExpr::eval_enumset(ObEvalCtx& ctx, const common::ObIArray<common::ObString
   int ret = common::OB_SUCCESS;
   char* frame = ctx.frames_[frame_idx_];
   OB_ASSERT(NULL != frame);
-  datum = (ObDatum*)(frame + datum_off_);
+  const int64_t idx = ctx.batch_idx_ & batch_idx_mask_;
+  datum = (ObDatum*)(frame + datum_off_) + idx;
   ObEvalInfo* eval_info = (ObEvalInfo*)(frame + eval_info_off_);
 
-  // do nothing for const/column reference expr or already evaluated expr
-  if (!eval_info->evaluated_) {
-    if (datum->ptr_ != frame + res_buf_off_) {
-      datum->ptr_ = frame + res_buf_off_;
+  // do nothing for const/column reference expr or already evaluated (projected) expr
+  if (!eval_info->evaluated_ && !eval_info->projected_) {
+    char* res_buf = frame + res_buf_off_ + idx * res_buf_len_;
+    if (datum->ptr_ != res_buf) {
+      datum->ptr_ = res_buf;
     }
     const common::ObObjTypeClass in_tc = args_[0]->obj_meta_.get_type_class();
     EvalEnumSetFunc eval_func;
@@ -17,6 +17,7 @@
 #include "lib/allocator/ob_allocator.h"
 #include "share/datum/ob_datum.h"
 #include "sql/engine/ob_serializable_function.h"
+#include "sql/engine/ob_bit_vector.h"
 #include "sql/parser/ob_item_type.h"
 
 namespace oceanbase {
@@ -122,6 +123,60 @@ struct ObEvalCtx {
     return tmp_alloc_;
   }
 
+  int64_t get_batch_idx() const
+  {
+    return batch_idx_;
+  }
+  int64_t get_batch_size() const
+  {
+    return batch_size_;
+  }
+  void set_batch_idx(const int64_t batch_idx)
+  {
+    batch_idx_ = batch_idx;
+  }
+  void set_batch_size(const int64_t batch_size)
+  {
+    batch_size_ = batch_size;
+  }
+
+  // Save and restore batch index/size of eval context, used when switching to row by row
+  // evaluation of batch rows, e.g.:
+  //
+  //   ObEvalCtx::BatchInfoScopeGuard guard(eval_ctx);
+  //   guard.set_batch_size(brs.size_);
+  //   for (int64_t i = 0; i < brs.size_; i++) {
+  //     guard.set_batch_idx(i);
+  //     ...
+  //   }
+  class BatchInfoScopeGuard {
+  public:
+    explicit BatchInfoScopeGuard(ObEvalCtx& eval_ctx)
+        : eval_ctx_(eval_ctx), batch_idx_(eval_ctx.batch_idx_), batch_size_(eval_ctx.batch_size_)
+    {}
+    ~BatchInfoScopeGuard()
+    {
+      eval_ctx_.batch_idx_ = batch_idx_;
+      eval_ctx_.batch_size_ = batch_size_;
+    }
+    void set_batch_idx(const int64_t batch_idx)
+    {
+      eval_ctx_.batch_idx_ = batch_idx;
+    }
+    void set_batch_size(const int64_t batch_size)
+    {
+      eval_ctx_.batch_size_ = batch_size;
+    }
+
+  private:
+    DISALLOW_COPY_AND_ASSIGN(BatchInfoScopeGuard);
+
+  private:
+    ObEvalCtx& eval_ctx_;
+    int64_t batch_idx_;
+    int64_t batch_size_;
+  };
+
 private:
   // Allocate expression result memory.
   void* alloc_expr_res(const int64_t size)
@@ -134,6 +189,11 @@ public:
   ObExecContext& exec_ctx_;
 
 private:
+  // Row index of the batch rows, the datum of batch result expression is located by it.
+  // Always zero in row mode.
+  int64_t batch_idx_;
+  // Row count of current batch
+  int64_t batch_size_;
   // Expression result allocator, never reset.
   common::ObArenaAllocator& expr_res_alloc_;
 
@@ -186,6 +246,12 @@ public:
 
   ObExpr();
   OB_INLINE int eval(ObEvalCtx& ctx, common::ObDatum*& datum) const;
+  // Evaluate the rows of batch which not skipped, results are located by batch index.
+  // Evaluate once for non batch result expression.
+  OB_INLINE int eval_batch(ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size) const;
+  // Evaluate the batch row by row with eval_func_, used when eval_batch_func_ not set or
+  // the batch function can not handle the arguments.
+  int eval_batch_by_row(ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size) const;
   int eval_enumset(ObEvalCtx& ctx, const common::ObIArray<common::ObString>& str_values, const uint64_t cast_mode,
       common::ObDatum*& datum) const;
 
@@ -196,7 +262,20 @@ public:
   ObDatum& locate_expr_datum(ObEvalCtx& ctx) const
   {
     // performance critical, do not check pointer validity.
-    return *reinterpret_cast<ObDatum*>(ctx.frames_[frame_idx_] + datum_off_);
+    return *reinterpret_cast<ObDatum*>(
+        ctx.frames_[frame_idx_] + datum_off_ + (ctx.batch_idx_ & batch_idx_mask_) * sizeof(ObDatum));
+  }
+
+  // Datum array of the batch rows, only valid for batch result expression.
+  ObDatum* locate_batch_datums(ObEvalCtx& ctx) const
+  {
+    return reinterpret_cast<ObDatum*>(ctx.frames_[frame_idx_] + datum_off_);
+  }
+
+  // Expression has one result for each row of the batch.
+  bool is_batch_result() const
+  {
+    return 0 != batch_idx_mask_;
   }
 
   ObEvalInfo& get_eval_info(ObEvalCtx& ctx) const
@@ -215,7 +294,13 @@ public:
   // Dynamic allocated memory is allocated if reserved buffer if not enough.
   char* get_str_res_mem(ObEvalCtx& ctx, const int64_t size) const
   {
-    return OB_LIKELY(size <= res_buf_len_) ? ctx.frames_[frame_idx_] + res_buf_off_ : alloc_str_res_mem(ctx, size);
+    return OB_LIKELY(size <= res_buf_len_) ? get_res_buf(ctx) : alloc_str_res_mem(ctx, size);
+  }
+
+  // Reserved result buffer of current row (located by batch index).
+  char* get_res_buf(ObEvalCtx& ctx) const
+  {
+    return ctx.frames_[frame_idx_] + res_buf_off_ + (ctx.batch_idx_ & batch_idx_mask_) * res_buf_len_;
   }
 
   // Evaluate all parameters, assign the first sizeof...(args) parameters to %args.
@@ -246,14 +331,15 @@ public:
   }
 
   TO_STRING_KV("type", get_type_name(type_), K_(datum_meta), K_(obj_meta), K_(obj_datum_map), KP_(eval_func),
-      KP_(inner_functions), K_(inner_func_cnt), K_(arg_cnt), K_(parent_cnt), K_(frame_idx), K_(datum_off),
-      K_(res_buf_off), K_(res_buf_len), K_(expr_ctx_id), K_(extra), KP(this));
+      KP_(eval_batch_func), KP_(inner_functions), K_(inner_func_cnt), K_(arg_cnt), K_(parent_cnt), K_(frame_idx), K_(datum_off),
+      K_(res_buf_off), K_(res_buf_len), K_(expr_ctx_id), K_(extra), K_(batch_idx_mask), KP(this));
 
 private:
   char* alloc_str_res_mem(ObEvalCtx& ctx, const int64_t size) const;
 
 public:
   typedef int (*EvalFunc)(const ObExpr& expr, ObEvalCtx& ctx, ObDatum& expr_datum);
+  typedef int (*EvalBatchFunc)(const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size);
   typedef int (*EvalEnumSetFunc)(const ObExpr& expr, const common::ObIArray<common::ObString>& str_values,
       const uint64_t cast_mode, ObEvalCtx& ctx, ObDatum& expr_datum);
 
@@ -275,6 +361,12 @@ public:
     // helper union member for eval_func_ serialize && deserialize
     sql::serializable_function ser_eval_func_;
   };
+  // expr batch evaluate function, evaluate rows of batch which not skipped.
+  union {
+    EvalBatchFunc eval_batch_func_;
+    // helper union member for eval_batch_func_ serialize && deserialize
+    sql::serializable_function ser_eval_batch_func_;
+  };
   // aux evaluate functions for eval_func_, array of any function pointers, which interpreted
   // by eval_func_.
   // mysql row operand use the inner function array
@@ -311,6 +403,14 @@ public:
     ObIExprExtraInfo* extra_info_;
   };
   ObExprBasicFuncs* basic_funcs_;
+  // Mask of ObEvalCtx::batch_idx_ to locate datum and reserved buffer:
+  //   0: one result for all rows (row mode, const, param ...)
+  //   UINT64_MAX: one result for each row of the batch.
+  //
+  // Memory layout of batch result expression in frame (N is batch size):
+  //   datum area:  | datum[0] ... datum[N-1] | eval info |
+  //   data area:   | dyn_buf[N-1] ... dyn_buf[0] | res_buf[0] ... res_buf[N-1] |
+  uint64_t batch_idx_mask_;
 };
 
 // helper template to access ObExpr::extra_
@@ -567,9 +667,11 @@ OB_INLINE ObDatum& ObExpr::locate_datum_for_write(ObEvalCtx& ctx) const
   // performance critical, do not check pointer validity.
   char* frame = ctx.frames_[frame_idx_];
   OB_ASSERT(NULL != frame);
-  ObDatum* expr_datum = (ObDatum*)(frame + datum_off_);
-  if (expr_datum->ptr_ != frame + res_buf_off_) {
-    expr_datum->ptr_ = frame + res_buf_off_;
+  const int64_t idx = ctx.batch_idx_ & batch_idx_mask_;
+  ObDatum* expr_datum = (ObDatum*)(frame + datum_off_) + idx;
+  char* res_buf = frame + res_buf_off_ + idx * res_buf_len_;
+  if (expr_datum->ptr_ != res_buf) {
+    expr_datum->ptr_ = res_buf;
   }
   return *expr_datum;
 }
@@ -594,13 +696,15 @@ OB_INLINE int ObExpr::eval(ObEvalCtx& ctx, common::ObDatum*& datum) const
   int ret = common::OB_SUCCESS;
   char* frame = ctx.frames_[frame_idx_];
   OB_ASSERT(NULL != frame);
-  datum = (ObDatum*)(frame + datum_off_);
+  const int64_t idx = ctx.batch_idx_ & batch_idx_mask_;
+  datum = (ObDatum*)(frame + datum_off_) + idx;
   ObEvalInfo* eval_info = (ObEvalInfo*)(frame + eval_info_off_);
 
-  // do nothing for const/column reference expr or already evaluated expr
-  if (NULL != eval_func_ && !eval_info->evaluated_) {
-    if (datum->ptr_ != frame + res_buf_off_) {
-      datum->ptr_ = frame + res_buf_off_;
+  // do nothing for const/column reference expr or already evaluated (projected) expr
+  if (NULL != eval_func_ && !eval_info->evaluated_ && !eval_info->projected_) {
+    char* res_buf = frame + res_buf_off_ + idx * res_buf_len_;
+    if (datum->ptr_ != res_buf) {
+      datum->ptr_ = res_buf;
     }
     ret = eval_func_(*this, ctx, *datum);
     if (OB_LIKELY(common::OB_SUCCESS == ret)) {
@@ -612,6 +716,29 @@ OB_INLINE int ObExpr::eval(ObEvalCtx& ctx, common::ObDatum*& datum) const
   return ret;
 }
 
+OB_INLINE int ObExpr::eval_batch(ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size) const
+{
+  int ret = common::OB_SUCCESS;
+  if (!is_batch_result()) {
+    common::ObDatum* datum = NULL;
+    ret = eval(ctx, datum);
+  } else if (NULL != eval_func_) {
+    ObEvalInfo& info = get_eval_info(ctx);
+    if (!info.projected_) {
+      if (NULL != eval_batch_func_) {
+        ret = eval_batch_func_(*this, ctx, skip, size);
+      } else {
+        ret = eval_batch_by_row(ctx, skip, size);
+      }
+      if (OB_LIKELY(common::OB_SUCCESS == ret)) {
+        info.projected_ = true;
+        info.cnt_ = size;
+      }
+    }
+  }
+  return ret;
+}
+
 OB_INLINE int ObExpr::deep_copy_datum(ObEvalCtx& ctx, const common::ObDatum& datum) const
 {
   int ret = common::OB_SUCCESS;
@@ -18,6 +18,7 @@
 #include "sql/resolver/expr/ob_raw_expr.h"
 #include "sql/engine/ob_exec_context.h"
 #include "sql/code_generator/ob_static_engine_expr_cg.h"
+#include "sql/engine/expr/ob_batch_eval_util.h"
 namespace oceanbase {
 using namespace common;
 using namespace common::number;
@@ -534,6 +535,17 @@ int ObExprAdd::cg_expr(ObExprCGCtx& op_cg_ctx, const ObRawExpr& raw_expr, ObExpr
     if (OB_ISNULL(rt_expr.eval_func_)) {
       ret = OB_INVALID_ARGUMENT;
       LOG_WARN("unexpected params type", K(ret), K(left_type), K(right_type), K(result_type));
+    } else if (T_OP_ADD == rt_expr.type_ && left_tc == right_tc && ob_obj_type_class(result_type) == left_tc) {
+      // aggregation add (T_OP_AGG_ADD) ignore double overflow, not batch evaluated.
+      if (ObExprAdd::add_int_int == rt_expr.eval_func_) {
+        rt_expr.eval_batch_func_ = ObExprAdd::add_int_int_batch;
+      } else if (ObExprAdd::add_uint_uint == rt_expr.eval_func_) {
+        rt_expr.eval_batch_func_ = ObExprAdd::add_uint_uint_batch;
+      } else if (ObExprAdd::add_float_float == rt_expr.eval_func_) {
+        rt_expr.eval_batch_func_ = ObExprAdd::add_float_float_batch;
+      } else if (ObExprAdd::add_double_double == rt_expr.eval_func_) {
+        rt_expr.eval_batch_func_ = ObExprAdd::add_double_double_batch;
+      }
     }
   }
   return ret;
@@ -688,6 +700,27 @@ int ObExprAdd::add_double_double(const ObExpr& expr, ObEvalCtx& ctx, ObDatum& ex
   return ret;
 }
 
+int ObExprAdd::add_int_int_batch(const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size)
+{
+  return ObBatchEvalUtil::eval_add_batch(expr, ctx, skip, size, OB_BVC_INT64);
+}
+
+int ObExprAdd::add_uint_uint_batch(const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size)
+{
+  return ObBatchEvalUtil::eval_add_batch(expr, ctx, skip, size, OB_BVC_UINT64);
+}
+
+int ObExprAdd::add_float_float_batch(const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size)
+{
+  return ObBatchEvalUtil::eval_add_batch(expr, ctx, skip, size, OB_BVC_FLOAT);
+}
+
+int ObExprAdd::add_double_double_batch(
+    const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size)
+{
+  return ObBatchEvalUtil::eval_add_batch(expr, ctx, skip, size, OB_BVC_DOUBLE);
+}
+
 // calc type TC is ObNumberTC
 int ObExprAdd::add_number_number(const ObExpr& expr, ObEvalCtx& ctx, ObDatum& expr_datum)
 {
@@ -112,6 +112,13 @@ public:
   static int add_double_double(const ObExpr& expr, ObEvalCtx& ctx, ObDatum& expr_datum);
   static int add_number_number(const ObExpr& expr, ObEvalCtx& ctx, ObDatum& expr_datum);
 
+  // batch evaluate functions, arguments and result have the same type class.
+  static int add_int_int_batch(const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size);
+  static int add_uint_uint_batch(const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size);
+  static int add_float_float_batch(const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size);
+  static int add_double_double_batch(
+      const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size);
+
   static int add_intervalym_intervalym(const ObExpr& expr, ObEvalCtx& ctx, ObDatum& expr_datum);
   static int add_intervalym_datetime_common(
       const ObExpr& expr, ObEvalCtx& ctx, ObDatum& expr_datum, bool interval_left);
@@ -17,6 +17,7 @@
 #include "common/object/ob_obj_compare.h"
 #include "sql/session/ob_sql_session_info.h"
 #include "sql/resolver/expr/ob_raw_expr_deduce_type.h"
+#include "sql/engine/expr/ob_batch_eval_util.h"
 namespace oceanbase {
 using namespace common;
 namespace sql {
@@ -162,6 +163,11 @@ int calc_and_exprN(const ObExpr& expr, ObEvalCtx& ctx, ObDatum& res_datum)
   return ret;
 }
 
+int calc_and_expr_batch(const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size)
+{
+  return ObBatchEvalUtil::eval_logical_batch(expr, ctx, skip, size, true);
+}
+
 int ObExprAnd::cg_expr(ObExprCGCtx& expr_cg_ctx, const ObRawExpr& raw_expr, ObExpr& rt_expr) const
 {
   int ret = OB_SUCCESS;
@@ -172,6 +178,7 @@ int ObExprAnd::cg_expr(ObExprCGCtx& expr_cg_ctx, const ObRawExpr& raw_expr, ObEx
     LOG_WARN("args_ is NULL or arg_cnt_ is invalid or raw_expr is invalid", K(ret), K(rt_expr), K(raw_expr));
   } else {
     rt_expr.eval_func_ = calc_and_exprN;
+    rt_expr.eval_batch_func_ = calc_and_expr_batch;
   }
   return ret;
 }
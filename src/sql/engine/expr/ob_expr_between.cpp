@@ -16,6 +16,7 @@
 #include "sql/engine/expr/ob_expr_less_than.h"
 #include "sql/engine/expr/ob_expr_less_equal.h"
 #include "sql/engine/expr/ob_expr_cmp_func.h"
+#include "sql/engine/expr/ob_batch_eval_util.h"
 #include "sql/session/ob_sql_session_info.h"
 
 namespace oceanbase {
@@ -89,6 +90,13 @@ int calc_between_expr(const ObExpr& expr, ObEvalCtx& ctx, ObDatum& res_datum)
   return ret;
 }
 
+int calc_between_expr_batch(const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size)
+{
+  // the value class of all arguments are the same, checked in CG.
+  return ObBatchEvalUtil::eval_between_batch(
+      expr, ctx, skip, size, ObBatchEvalUtil::get_value_class(expr.args_[0]->datum_meta_.type_));
+}
+
 int ObExprBetween::cg_expr(ObExprCGCtx& expr_cg_ctx, const ObRawExpr& raw_expr, ObExpr& rt_expr) const
 {
   // left <= val <= right
@@ -127,6 +135,11 @@ int ObExprBetween::cg_expr(ObExprCGCtx& expr_cg_ctx, const ObRawExpr& raw_expr,
       rt_expr.inner_functions_[0] = reinterpret_cast<void*>(cmp_func_1);
       rt_expr.inner_functions_[1] = reinterpret_cast<void*>(cmp_func_2);
       rt_expr.eval_func_ = calc_between_expr;
+      const ObObjTypeClass val_tc = ob_obj_type_class(val_meta.type_);
+      if (OB_BVC_INVALID != ObBatchEvalUtil::get_value_class(val_meta.type_) &&
+          val_tc == ob_obj_type_class(left_meta.type_) && val_tc == ob_obj_type_class(right_meta.type_)) {
+        rt_expr.eval_batch_func_ = calc_between_expr_batch;
+      }
     }
   }
   return ret;
@@ -17,6 +17,7 @@
 #include "share/datum/ob_datum_cmp_func_def.h"
 #include "share/datum/ob_datum_funcs.h"
 #include "sql/engine/expr/ob_expr_operator.h"
+#include "sql/engine/expr/ob_batch_eval_util.h"
 
 namespace oceanbase {
 namespace sql {
@@ -119,6 +120,14 @@ struct ObRelationalStrExprEvalFunc : public ObDatumStrCmpCore<cs_type, calc_with
   }
 };
 
+template <ObBatchValueClass vc, ObCmpOp cmp_op>
+struct ObRelationalExprEvalBatchFunc {
+  static int eval_batch(const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size)
+  {
+    return ObBatchEvalUtil::eval_cmp_batch(expr, ctx, skip, size, vc, cmp_op);
+  }
+};
+
 static ObExpr::EvalFunc EVAL_CMP_FUNCS[ObMaxType][ObMaxType][CO_MAX];
 static ObDatumCmpFuncType DATUM_CMP_FUNCS[ObMaxType][ObMaxType];
 static ObExpr::EvalFunc EVAL_STR_CMP_FUNCS[CS_TYPE_MAX][CO_MAX][2];
@@ -168,7 +177,20 @@ struct DatumStrExprCmpIniter {
   }
 };
 
+static ObExpr::EvalBatchFunc EVAL_BATCH_CMP_FUNCS[OB_BVC_MAX][CO_MAX];
+
+template <int X, int Y>
+struct ExprBatchCmpFuncIniter {
+  using EvalBatchCmp = ObRelationalExprEvalBatchFunc<static_cast<ObBatchValueClass>(X), static_cast<ObCmpOp>(Y)>;
+  static void init_array()
+  {
+    // CO_CMP is not supported
+    EVAL_BATCH_CMP_FUNCS[X][Y] = (OB_BVC_INVALID == X || CO_CMP == Y) ? NULL : &EvalBatchCmp::eval_batch;
+  }
+};
+
 int init_datum_ret = Ob2DArrayConstIniter<ObMaxType, ObMaxType, ExprCmpFuncIniter>::init();
+int init_batch_ret = Ob2DArrayConstIniter<OB_BVC_MAX, CO_MAX, ExprBatchCmpFuncIniter>::init();
 int init_str_ret = Ob2DArrayConstIniter<CS_TYPE_MAX, CO_MAX, StrExprFuncIniter>::init();
 int init_datum_str_ret = ObArrayConstIniter<CS_TYPE_MAX, DatumStrExprCmpIniter>::init();
 
@@ -212,6 +234,18 @@ DatumCmpFunc ObExprCmpFuncsHelper::get_datum_expr_cmp_func(
   return func_ptr;
 }
 
+ObExpr::EvalBatchFunc ObExprCmpFuncsHelper::get_eval_batch_expr_cmp_func(
+    const ObObjType type1, const ObObjType type2, const ObCmpOp cmp_op)
+{
+  ObExpr::EvalBatchFunc func_ptr = NULL;
+  const ObBatchValueClass vc = ObBatchEvalUtil::get_value_class(type1);
+  // same type class compared by value directly (see ObDatumCmpHelperByType), and so to the kernels.
+  if (cmp_op >= CO_EQ && cmp_op < CO_MAX && ob_obj_type_class(type1) == ob_obj_type_class(type2)) {
+    func_ptr = EVAL_BATCH_CMP_FUNCS[vc][cmp_op];
+  }
+  return func_ptr;
+}
+
 // register function serialization
 
 // EVAL_CMP_FUNCS and DATUM_CMP_FUNCS is two dimension array, need to convert to index stable
@@ -230,6 +264,10 @@ bool g_ser_datum_cmp_funcs_init =
     ObFuncSerialization::convert_NxN_array(g_ser_datum_cmp_funcs, reinterpret_cast<void**>(DATUM_CMP_FUNCS), ObMaxType);
 REG_SER_FUNC_ARRAY(OB_SFA_DATUM_CMP, g_ser_datum_cmp_funcs, sizeof(g_ser_datum_cmp_funcs) / sizeof(void*));
 
+static_assert(7 == CO_MAX && OB_BVC_MAX * 7 == sizeof(EVAL_BATCH_CMP_FUNCS) / sizeof(void*), "unexpected size");
+REG_SER_FUNC_ARRAY(
+    OB_SFA_RELATION_EXPR_EVAL_BATCH, EVAL_BATCH_CMP_FUNCS, sizeof(EVAL_BATCH_CMP_FUNCS) / sizeof(void*));
+
 static_assert(7 == CO_MAX && CS_TYPE_MAX * 7 * 2 == sizeof(EVAL_STR_CMP_FUNCS) / sizeof(void*), "unexpected size");
 REG_SER_FUNC_ARRAY(OB_SFA_RELATION_EXPR_EVAL_STR, EVAL_STR_CMP_FUNCS, sizeof(EVAL_STR_CMP_FUNCS) / sizeof(void*));
 
@@ -31,6 +31,11 @@ public:
 
   static DatumCmpFunc get_datum_expr_cmp_func(const common::ObObjType type1, const common::ObObjType type2,
       const bool is_oracle_mode, const common::ObCollationType cs_type);
+
+  // Get batch evaluate function of relational expression, only same fixed length type class
+  // is supported, return NULL if not supported.
+  static sql::ObExpr::EvalBatchFunc get_eval_batch_expr_cmp_func(
+      const common::ObObjType type1, const common::ObObjType type2, const common::ObCmpOp cmp_op);
 };
 }  // namespace sql
 }  // end namespace oceanbase
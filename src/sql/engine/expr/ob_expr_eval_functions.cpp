@@ -264,6 +264,9 @@ extern int calc_reverse_expr(const ObExpr &expr, ObEvalCtx &ctx, ObDatum &res_da
 extern int calc_instrb_expr(const ObExpr &expr, ObEvalCtx &ctx, ObDatum &res_datum);
 extern int calc_convert_expr(const ObExpr &expr, ObEvalCtx &ctx, ObDatum &res_datum);
 extern int calc_translate_using_expr(const ObExpr &, ObEvalCtx &, ObDatum &);
+extern int calc_and_expr_batch(const ObExpr &, ObEvalCtx &, const ObBitVector &, const int64_t);
+extern int calc_or_expr_batch(const ObExpr &, ObEvalCtx &, const ObBitVector &, const int64_t);
+extern int calc_between_expr_batch(const ObExpr &, ObEvalCtx &, const ObBitVector &, const int64_t);
 
 // append only, can not delete, set to NULL for mark delete
 static ObExpr::EvalFunc g_expr_eval_functions[] = {
@@ -732,5 +735,20 @@ static ObExpr::EvalFunc g_expr_eval_functions[] = {
 
 REG_SER_FUNC_ARRAY(OB_SFA_SQL_EXPR_EVAL, g_expr_eval_functions, ARRAYSIZEOF(g_expr_eval_functions));
 
+// append only, can not delete, set to NULL for mark delete
+static ObExpr::EvalBatchFunc g_expr_eval_batch_functions[] = {
+    ObExprAdd::add_int_int_batch,                      /* 0 */
+    ObExprAdd::add_uint_uint_batch,                    /* 1 */
+    ObExprAdd::add_float_float_batch,                  /* 2 */
+    ObExprAdd::add_double_double_batch,                /* 3 */
+    calc_and_expr_batch,                               /* 4 */
+    calc_or_expr_batch,                                /* 5 */
+    calc_between_expr_batch,                           /* 6 */
+    ObExprInOrNotIn::eval_in_without_row_batch         /* 7 */
+};
+
+REG_SER_FUNC_ARRAY(
+    OB_SFA_SQL_EXPR_EVAL_BATCH, g_expr_eval_batch_functions, ARRAYSIZEOF(g_expr_eval_batch_functions));
+
 }  // end namespace sql
 }  // end namespace oceanbase
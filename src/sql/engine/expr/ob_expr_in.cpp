@@ -20,6 +20,7 @@
 #include "sql/engine/expr/ob_expr_coll_pred.h"
 #include "sql/engine/expr/ob_expr_subquery_ref.h"
 #include "sql/engine/subquery/ob_subplan_filter_op.h"
+#include "sql/engine/expr/ob_batch_eval_util.h"
 
 namespace oceanbase {
 using namespace common;
@@ -1190,6 +1191,16 @@ int ObExprInOrNotIn::cg_expr_without_row(ObIAllocator& allocator, const ObRawExp
         rt_expr.eval_func_ = &ObExprInOrNotIn::eval_in_without_row_fallback;
       } else {
         rt_expr.eval_func_ = &ObExprInOrNotIn::eval_in_without_row;
+        // compare by value (no hash) in batch, only for integer values with the same type class.
+        const ObBatchValueClass vc = ObBatchEvalUtil::get_value_class(left_type);
+        bool batch = (OB_BVC_INT64 == vc || OB_BVC_UINT64 == vc || OB_BVC_INT32 == vc) &&
+                     rt_expr.inner_func_cnt_ <= ObBatchEvalUtil::MAX_BATCH_IN_PARAM_CNT;
+        for (int64_t i = 0; batch && i < rt_expr.args_[1]->arg_cnt_; i++) {
+          batch = ob_obj_type_class(left_type) == ob_obj_type_class(rt_expr.args_[1]->args_[i]->datum_meta_.type_);
+        }
+        if (batch) {
+          rt_expr.eval_batch_func_ = &ObExprInOrNotIn::eval_in_without_row_batch;
+        }
       }
     }
   }
@@ -1687,6 +1698,13 @@ int ObExprInOrNotIn::eval_in_without_row(const ObExpr& expr, ObEvalCtx& ctx, ObD
   return ret;
 }
 
+int ObExprInOrNotIn::eval_in_without_row_batch(
+    const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size)
+{
+  return ObBatchEvalUtil::eval_in_batch(
+      expr, ctx, skip, size, ObBatchEvalUtil::get_value_class(expr.args_[0]->datum_meta_.type_));
+}
+
 int ObExprInOrNotIn::eval_in_with_subquery(const ObExpr& expr, ObEvalCtx& ctx, ObDatum& expr_datum)
 {
   int ret = OB_SUCCESS;
@@ -338,6 +338,9 @@ public:
   static int eval_in_without_row(const ObExpr& expr, ObEvalCtx& ctx, ObDatum& expr_datum);
   static int eval_in_with_row_fallback(const ObExpr& expr, ObEvalCtx& ctx, ObDatum& expr_datum);
   static int eval_in_without_row_fallback(const ObExpr& expr, ObEvalCtx& ctx, ObDatum& expr_datum);
+  // batch evaluate without row, only for small int const parameters list.
+  static int eval_in_without_row_batch(
+      const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size);
   // like "select 1 from dual where (select 1, 2) in ((1,2), (3,4))"
   static int eval_in_with_subquery(const ObExpr& expr, ObEvalCtx& ctx, ObDatum& expr_datum);
   static int calc_for_row_static_engine(const ObExpr& expr, ObEvalCtx& ctx, ObDatum& expr_datum, ObExpr** l_row);
@@ -4764,6 +4764,13 @@ int ObRelationalExprOperator::cg_datum_cmp_expr(
       rt_expr.eval_func_ = ObExprCmpFuncsHelper::get_eval_expr_cmp_func(
           input_type1, input_type2, cmp_op, lib::is_oracle_mode(), cs_type);
       CK(NULL != rt_expr.eval_func_);
+      // null safe equal has different null semantics, batch evaluate plain comparison only.
+      const ObExprOperatorType type = raw_expr.get_expr_type();
+      if (OB_SUCC(ret) && (T_OP_EQ == type || T_OP_LE == type || T_OP_LT == type || T_OP_GE == type ||
+                              T_OP_GT == type || T_OP_NE == type)) {
+        rt_expr.eval_batch_func_ =
+            ObExprCmpFuncsHelper::get_eval_batch_expr_cmp_func(input_type1, input_type2, cmp_op);
+      }
     }
   }
   return ret;
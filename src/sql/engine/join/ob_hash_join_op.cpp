@@ -20,6 +20,8 @@
 #include "observer/omt/ob_tenant_config_mgr.h"
 #include "sql/engine/px/ob_px_util.h"
 #include "share/diagnosis/ob_sql_monitor_statname.h"
+#include "sql/engine/px/ob_px_sqc_proxy.h"
+#include "sql/engine/px/ob_px_sqc_handler.h"
 
 namespace oceanbase {
 using namespace omt;
@@ -31,10 +33,14 @@ ObHashJoinSpec::ObHashJoinSpec(common::ObIAllocator& alloc, const ObPhyOperatorT
       equal_join_conds_(alloc),
       all_join_keys_(alloc),
       all_hash_funcs_(alloc),
-      has_join_bf_(false)
+      has_join_bf_(false),
+      build_join_filter_(false),
+      join_filter_has_range_(false),
+      join_filter_probe_dfo_id_(OB_INVALID_ID)
 {}
 
-OB_SERIALIZE_MEMBER((ObHashJoinSpec, ObJoinSpec), equal_join_conds_, all_join_keys_, all_hash_funcs_, has_join_bf_);
+OB_SERIALIZE_MEMBER((ObHashJoinSpec, ObJoinSpec), equal_join_conds_, all_join_keys_, all_hash_funcs_, has_join_bf_,
+    build_join_filter_, join_filter_has_range_, join_filter_probe_dfo_id_);
 
 int ObHashJoinOp::PartHashJoinTable::init(ObIAllocator& alloc)
 {
@@ -148,6 +154,11 @@ ObHashJoinOp::ObHashJoinOp(ObExecContext& ctx_, const ObOpSpec& spec, ObOpInput*
       cur_right_hist_(nullptr),
       cur_probe_row_idx_(0),
       max_right_bucket_idx_(0),
+      join_filter_(),
+      join_filter_hash_funcs_(),
+      join_filter_reuse_hash_(true),
+      join_filter_ready_(false),
+      join_filter_sent_(false),
       probe_cnt_(0),
       bitset_filter_cnt_(0),
       hash_link_cnt_(0),
@@ -228,6 +239,9 @@ int ObHashJoinOp::set_hash_function(int8_t hash_join_hasher)
   if (OB_SUCC(ret)) {
     int64_t all_cnt = cur_hash_funcs->count();
     left_hash_funcs_.init(all_cnt / 2, const_cast<ObHashFunc*>(&cur_hash_funcs->at(0)), all_cnt / 2);
+    join_filter_hash_funcs_.init(
+        all_cnt / 2, const_cast<ObHashFunc*>(&MY_SPEC.all_hash_funcs_.at(0)), MY_SPEC.all_hash_funcs_.count() / 2);
+    join_filter_reuse_hash_ = (cur_hash_funcs == &MY_SPEC.all_hash_funcs_);
     right_hash_funcs_.init(all_cnt / 2,
         const_cast<ObHashFunc*>(&cur_hash_funcs->at(0) + left_hash_funcs_.count()),
         cur_hash_funcs->count() - left_hash_funcs_.count());
@@ -355,6 +369,7 @@ void ObHashJoinOp::reset_base()
 
 void ObHashJoinOp::reset()
 {
+  join_filter_ready_ = false;
   free_bloom_filter();
   clean_batch_mgr();
   part_rescan();
@@ -589,6 +604,7 @@ void ObHashJoinOp::destroy()
     DESTROY_CONTEXT(mem_context_);
     mem_context_ = NULL;
   }
+  join_filter_.reset();
   ObJoinOp::destroy();
 }
 
@@ -598,6 +614,7 @@ int ObHashJoinOp::inner_close()
   sql_mem_processor_.unregister_profile();
   reset();
   tmp_hash_funcs_.reset();
+  join_filter_.reset();
   if (batch_mgr_ != NULL) {
     batch_mgr_->~ObHashJoinBatchMgr();
     if (OB_NOT_NULL(alloc_)) {
@@ -767,6 +784,7 @@ int ObHashJoinOp::build_hash_table_for_nest_loop(int64_t& num_left_rows)
         }
         tuple = &(hash_table.all_cells_->at(cell_index));
         tuple->stored_row_ = stored_row;
+        tuple->hash_value_ = hash_value;
         tuple->next_tuple_ = hash_table.buckets_->at(bucket_id);
         hash_table.buckets_->at(bucket_id) = tuple;
         hash_table.inc_collision(bucket_id);
@@ -1121,6 +1139,7 @@ int ObHashJoinOp::build_hash_table_in_memory(int64_t& num_left_rows)
         bucket_id = get_bucket_idx(hash_value);
         tuple = &(hash_table.all_cells_->at(cell_index));
         tuple->stored_row_ = stored_row;
+        tuple->hash_value_ = hash_value;
         tuple->next_tuple_ = hash_table.buckets_->at(bucket_id);
         hash_table.buckets_->at(bucket_id) = tuple;
         hash_table.inc_collision(bucket_id);
@@ -1392,6 +1411,58 @@ int ObHashJoinOp::dump_remain_partition()
   return ret;
 }
 
+int ObHashJoinOp::insert_join_filter(const uint64_t hash_value)
+{
+  int ret = OB_SUCCESS;
+  uint64_t filter_hash = hash_value;
+  ObDatum* datum = NULL;
+  if (!join_filter_reuse_hash_ && OB_FAIL(calc_hash_value(left_join_keys_, join_filter_hash_funcs_, filter_hash))) {
+    LOG_WARN("failed to calc join filter hash value", K(ret));
+  } else if (join_filter_.has_range()) {
+    // range is only built for single integer key, null keys never match
+    if (OB_FAIL(left_join_keys_.at(0)->eval(eval_ctx_, datum))) {
+      LOG_WARN("failed to eval datum", K(ret));
+    } else if (!datum->is_null()) {
+      join_filter_.update_range(datum->get_int());
+    }
+  }
+  if (OB_SUCC(ret)) {
+    join_filter_.insert(filter_hash);
+  }
+  return ret;
+}
+
+// publish join filter after the build side is read:
+// the probe side scan in the same thread fetches it by get_join_filter(),
+// the probe side in another dfo gets the merged filter of all tasks from QC.
+int ObHashJoinOp::finish_join_filter()
+{
+  int ret = OB_SUCCESS;
+  ObPxSqcHandler* handler = ctx_.get_sqc_handler();
+  join_filter_ready_ = true;
+  if (OB_INVALID_ID == MY_SPEC.join_filter_probe_dfo_id_ || join_filter_sent_) {
+    // local filter only, or already sent before rescan
+  } else if (OB_ISNULL(handler)) {
+    // not in px, nothing to publish
+  } else {
+    ObPxSQCProxy& proxy = handler->get_sqc_proxy();
+    ObJoinFilterPieceMsg piece;
+    piece.op_id_ = MY_SPEC.id_;
+    piece.thread_id_ = GETTID();
+    piece.dfo_id_ = proxy.get_dfo_id();
+    piece.probe_dfo_id_ = MY_SPEC.join_filter_probe_dfo_id_;
+    if (OB_FAIL(piece.filter_.assign(join_filter_))) {
+      LOG_WARN("failed to assign join filter", K(ret));
+    } else if (OB_FAIL(proxy.send_dh_msg(piece, ctx_.get_physical_plan_ctx()->get_timeout_timestamp()))) {
+      LOG_WARN("failed to send join filter piece msg", K(ret));
+    } else {
+      join_filter_sent_ = true;
+      LOG_TRACE("join filter piece msg sent", K(piece));
+    }
+  }
+  return ret;
+}
+
 int ObHashJoinOp::split_partition(int64_t& num_left_rows)
 {
   int ret = OB_SUCCESS;
@@ -1405,6 +1476,10 @@ int ObHashJoinOp::split_partition(int64_t& num_left_rows)
     } else {
       row_count_on_disk = left_batch_->get_row_count_on_disk();
     }
+  } else if (MY_SPEC.build_join_filter_ && top_part_level()) {
+    if (OB_FAIL(join_filter_.init(left_->get_spec().rows_, MY_SPEC.join_filter_has_range_))) {
+      LOG_WARN("failed to init join filter", K(ret));
+    }
   }
   num_left_rows = 0;
   while (OB_SUCC(ret)) {
@@ -1417,6 +1492,8 @@ int ObHashJoinOp::split_partition(int64_t& num_left_rows)
       if (NULL == left_read_row_) {
         if (OB_FAIL(calc_hash_value(left_join_keys_, left_hash_funcs_, hash_value))) {
           LOG_WARN("get left row hash_value failed", K(ret));
+        } else if (join_filter_.is_valid() && OB_FAIL(insert_join_filter(hash_value))) {
+          LOG_WARN("failed to insert join filter", K(ret));
         }
       } else {
         hash_value = left_read_row_->get_hash_value();
@@ -1458,8 +1535,11 @@ int ObHashJoinOp::split_partition(int64_t& num_left_rows)
     ret = OB_SUCCESS;
     if (nullptr != left_batch_) {
       left_batch_->rescan();
+    } else if (join_filter_.is_valid() && OB_FAIL(finish_join_filter())) {
+      LOG_WARN("failed to finish join filter", K(ret));
     }
-    if (sql_mem_processor_.is_auto_mgr()) {
+    if (OB_FAIL(ret)) {
+    } else if (sql_mem_processor_.is_auto_mgr()) {
       // last stage for dump build table
       if (OB_FAIL(calc_basic_info())) {
         LOG_WARN("failed to calc basic info", K(ret));
@@ -1816,6 +1896,7 @@ int ObHashJoinOp::build_hash_table_for_recursive()
             }
             tuple = &(hash_table.all_cells_->at(cell_index));
             tuple->stored_row_ = const_cast<ObHashJoinStoredJoinRow*>(stored_row);
+            tuple->hash_value_ = hash_value;
             tuple->next_tuple_ = hash_table.buckets_->at(bucket_id);
             hash_table.buckets_->at(bucket_id) = tuple;
 
@@ -3201,7 +3282,7 @@ int ObHashJoinOp::read_hashrow_normal()
     }
     while (!is_matched && NULL != tuple && OB_SUCC(ret)) {
       ++hash_link_cnt_;
-      if (cur_right_hash_value_ == tuple->stored_row_->get_hash_value()) {
+      if (cur_right_hash_value_ == tuple->hash_value_) {
         ++hash_equal_cnt_;
         clear_evaluated_flag();
         if (OB_FAIL(convert_exprs(tuple->stored_row_, left_->get_spec().output_, has_fill_left_row_))) {
@@ -20,6 +20,7 @@
 #include "sql/engine/ob_sql_mem_mgr_processor.h"
 #include "lib/container/ob_2d_array.h"
 #include "sql/engine/aggregate/ob_exec_hash_struct.h"
+#include "sql/engine/px/datahub/components/ob_dh_join_filter.h"
 
 namespace oceanbase {
 namespace sql {
@@ -34,6 +35,11 @@ public:
   ExprFixedArray all_join_keys_;
   common::ObHashFuncs all_hash_funcs_;
   bool has_join_bf_;
+  // build runtime join filter for the probe side scan, see ObJoinFilterUseInfo
+  bool build_join_filter_;
+  bool join_filter_has_range_;
+  // dfo of the probe side transmit if the filter is published through datahub, OB_INVALID_ID if local only
+  uint64_t join_filter_probe_dfo_id_;
 };
 
 // hash join has no expression result overwrite problem:
@@ -70,7 +76,9 @@ private:
     // before using them. for performance.
     ObHashJoinStoredJoinRow* stored_row_;
     HashTableCell* next_tuple_;
-    TO_STRING_KV(K_(stored_row), K(static_cast<void*>(next_tuple_)));
+    // copy of the stored row's hash value, mismatched tuples are skipped without touching the row.
+    uint64_t hash_value_;
+    TO_STRING_KV(K_(stored_row), K(static_cast<void*>(next_tuple_)), K_(hash_value));
   };
   struct PartHashJoinTable {
     PartHashJoinTable()
@@ -373,6 +381,11 @@ public:
   virtual int inner_get_next_row() override;
   virtual void destroy() override;
   virtual int inner_close() override;
+  // join filter is available after all build side rows are read
+  const ObJoinFilterData* get_join_filter() const
+  {
+    return join_filter_ready_ ? &join_filter_ : NULL;
+  }
 
 private:
   void calc_cache_aware_partition_count();
@@ -417,6 +430,8 @@ private:
   int other_join_read_hashrow_func_end();
 
   int set_hash_function(int8_t hash_join_hasher);
+  int insert_join_filter(const uint64_t hash_value);
+  int finish_join_filter();
 
   int next();
   int join_end_operate();
@@ -709,6 +724,12 @@ private:
   HashJoinHistogram* cur_right_hist_;
   int64_t cur_probe_row_idx_;
   int64_t max_right_bucket_idx_;
+  // runtime join filter, the probe side hashes join keys with the murmur hash funcs of spec
+  ObJoinFilterData join_filter_;
+  common::ObArrayHelper<common::ObHashFunc> join_filter_hash_funcs_;
+  bool join_filter_reuse_hash_;
+  bool join_filter_ready_;
+  bool join_filter_sent_;  // piece msg is sent only once, not resent after rescan
 
   // statistics
   int64_t probe_cnt_;
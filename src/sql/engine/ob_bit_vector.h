@@ -0,0 +1,193 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_ENGINE_OB_BIT_VECTOR_H_
+#define OCEANBASE_ENGINE_OB_BIT_VECTOR_H_
+
+#include "lib/ob_define.h"
+#include "lib/utility/ob_print_utils.h"
+
+namespace oceanbase {
+namespace sql {
+
+// Bit vector without any member, the bit memory is located by the object address.
+// Used as skip bitmap of batch rows and null bitmap of batch datums, e.g.:
+//
+//   void* mem = alloc.alloc(ObBitVector::memory_size(batch_size));
+//   ObBitVector* skip = to_bit_vector(mem);
+//   skip->reset(batch_size);
+//
+// The caller is responsible for the bit count, no bound check inside.
+template <typename WordType>
+struct ObBitVectorImpl {
+public:
+  const static int64_t BYTES_PER_WORD = sizeof(WordType);
+  const static int64_t WORD_BITS = BYTES_PER_WORD * 8;
+  const static int64_t WORD_SHIFT = (8 == BYTES_PER_WORD) ? 6 : ((4 == BYTES_PER_WORD) ? 5 : 3);
+
+  ObBitVectorImpl() = default;
+  ~ObBitVectorImpl() = default;
+
+  OB_INLINE static int64_t word_count(const int64_t size)
+  {
+    return (size + WORD_BITS - 1) / WORD_BITS;
+  }
+
+  OB_INLINE static int64_t memory_size(const int64_t size)
+  {
+    return word_count(size) * BYTES_PER_WORD;
+  }
+
+  // reset all bits to zero
+  OB_INLINE void reset(const int64_t size)
+  {
+    MEMSET(data_, 0, memory_size(size));
+  }
+
+  // set all bits to one
+  OB_INLINE void set_all(const int64_t size);
+
+  OB_INLINE bool at(const int64_t idx) const
+  {
+    return data_[idx >> WORD_SHIFT] & (static_cast<WordType>(1) << (idx & (WORD_BITS - 1)));
+  }
+  OB_INLINE bool contain(const int64_t idx) const
+  {
+    return at(idx);
+  }
+
+  OB_INLINE void set(const int64_t idx)
+  {
+    data_[idx >> WORD_SHIFT] |= static_cast<WordType>(1) << (idx & (WORD_BITS - 1));
+  }
+
+  OB_INLINE void unset(const int64_t idx)
+  {
+    data_[idx >> WORD_SHIFT] &= ~(static_cast<WordType>(1) << (idx & (WORD_BITS - 1)));
+  }
+
+  OB_INLINE void change(const int64_t idx, const bool v)
+  {
+    if (v) {
+      set(idx);
+    } else {
+      unset(idx);
+    }
+  }
+
+  OB_INLINE void deep_copy(const ObBitVectorImpl<WordType>& src, const int64_t size)
+  {
+    MEMCPY(data_, src.data_, memory_size(size));
+  }
+
+  // this |= other
+  OB_INLINE void bit_or(const ObBitVectorImpl<WordType>& other, const int64_t size)
+  {
+    const int64_t cnt = word_count(size);
+    for (int64_t i = 0; i < cnt; i++) {
+      data_[i] |= other.data_[i];
+    }
+  }
+
+  // this &= other
+  OB_INLINE void bit_and(const ObBitVectorImpl<WordType>& other, const int64_t size)
+  {
+    const int64_t cnt = word_count(size);
+    for (int64_t i = 0; i < cnt; i++) {
+      data_[i] &= other.data_[i];
+    }
+  }
+
+  // count of the one bits in [0, size)
+  OB_INLINE int64_t accumulate_bit_cnt(const int64_t size) const;
+
+  // all bits in [0, size) are one
+  OB_INLINE bool is_all_true(const int64_t size) const
+  {
+    return size == accumulate_bit_cnt(size);
+  }
+
+  // Call %op for every zero bit index in [0, size), stop when %op return failure.
+  // Used to iterate the rows not skipped of the batch:
+  //
+  //   skip->foreach_unset(size, [&](int64_t idx) { ... return OB_SUCCESS; });
+  template <typename OP>
+  OB_INLINE int foreach_unset(const int64_t size, OP op) const;
+
+  TO_STRING_EMPTY();
+
+public:
+  WordType data_[0];
+};
+
+template <typename WordType>
+OB_INLINE void ObBitVectorImpl<WordType>::set_all(const int64_t size)
+{
+  const int64_t cnt = word_count(size);
+  MEMSET(data_, 0xFF, cnt * BYTES_PER_WORD);
+  if (0 != (size & (WORD_BITS - 1))) {
+    // clear the tail bits beyond %size, keep accumulate_bit_cnt() exact.
+    data_[cnt - 1] &= (static_cast<WordType>(1) << (size & (WORD_BITS - 1))) - 1;
+  }
+}
+
+template <typename WordType>
+OB_INLINE int64_t ObBitVectorImpl<WordType>::accumulate_bit_cnt(const int64_t size) const
+{
+  int64_t cnt = 0;
+  const int64_t full_cnt = size / WORD_BITS;
+  for (int64_t i = 0; i < full_cnt; i++) {
+    cnt += __builtin_popcountll(static_cast<uint64_t>(data_[i]));
+  }
+  if (0 != (size & (WORD_BITS - 1))) {
+    const WordType mask = (static_cast<WordType>(1) << (size & (WORD_BITS - 1))) - 1;
+    cnt += __builtin_popcountll(static_cast<uint64_t>(data_[full_cnt] & mask));
+  }
+  return cnt;
+}
+
+template <typename WordType>
+template <typename OP>
+OB_INLINE int ObBitVectorImpl<WordType>::foreach_unset(const int64_t size, OP op) const
+{
+  int ret = common::OB_SUCCESS;
+  const int64_t cnt = word_count(size);
+  for (int64_t i = 0; OB_SUCC(ret) && i < cnt; i++) {
+    WordType bits = ~data_[i];
+    if (i == cnt - 1 && 0 != (size & (WORD_BITS - 1))) {
+      bits &= (static_cast<WordType>(1) << (size & (WORD_BITS - 1))) - 1;
+    }
+    while (OB_SUCC(ret) && 0 != bits) {
+      const int64_t idx = i * WORD_BITS + __builtin_ctzll(static_cast<uint64_t>(bits));
+      ret = op(idx);
+      bits &= bits - 1;
+    }
+  }
+  return ret;
+}
+
+typedef ObBitVectorImpl<uint64_t> ObBitVector;
+
+OB_INLINE ObBitVector* to_bit_vector(void* mem)
+{
+  return static_cast<ObBitVector*>(mem);
+}
+
+OB_INLINE const ObBitVector* to_bit_vector(const void* mem)
+{
+  return static_cast<const ObBitVector*>(mem);
+}
+
+}  // end namespace sql
+}  // end namespace oceanbase
+
+#endif  // OCEANBASE_ENGINE_OB_BIT_VECTOR_H_
@@ -87,14 +87,15 @@ ObOpSpec::ObOpSpec(ObIAllocator& alloc, const ObPhyOperatorType type)
       rows_(0),
       width_(0),
       px_est_size_factor_(),
-      plan_depth_(0)
+      plan_depth_(0),
+      max_batch_size_(0)
 {}
 
 ObOpSpec::~ObOpSpec()
 {}
 
 OB_SERIALIZE_MEMBER(ObOpSpec, id_, output_, startup_filters_, filters_, calc_exprs_, cost_, rows_, width_,
-    px_est_size_factor_, plan_depth_);
+    px_est_size_factor_, plan_depth_, max_batch_size_);
 
 DEF_TO_STRING(ObOpSpec)
 {
@@ -111,7 +112,8 @@ DEF_TO_STRING(ObOpSpec)
       startup_filters_.count(),
       "calc_exprs_cnt",
       calc_exprs_.count(),
-      K_(rows));
+      K_(rows),
+      K_(max_batch_size));
   J_OBJ_END();
   return pos;
 }
@@ -369,7 +371,9 @@ ObOperator::ObOperator(ObExecContext& exec_ctx, const ObOpSpec& spec, ObOpInput*
       opened_(false),
       startup_passed_(spec_.startup_filters_.empty()),
       exch_drained_(false),
-      got_first_row_(false)
+      got_first_row_(false),
+      brs_(),
+      brs_row_idx_(0)
 {}
 
 ObOperator::~ObOperator()
@@ -449,6 +453,8 @@ int ObOperator::open()
       case OPEN_SELF_ONLY: {
         if (OB_FAIL(init_evaluated_flags())) {
           LOG_WARN("init evaluate flags failed", K(ret));
+        } else if (OB_FAIL(init_batch_rows())) {
+          LOG_WARN("init batch rows failed", K(ret));
         } else if (OB_FAIL(inner_open())) {
           if (OB_TRY_LOCK_ROW_CONFLICT != ret && OB_TRANSACTION_SET_VIOLATION != ret) {
             LOG_WARN("Open this operator failed", K(ret), "op_type", op_name());
@@ -488,6 +494,23 @@ int ObOperator::init_evaluated_flags()
   return ret;
 }
 
+int ObOperator::init_batch_rows()
+{
+  int ret = OB_SUCCESS;
+  if (spec_.is_vectorized() && NULL == brs_.skip_) {
+    void* mem = ctx_.get_allocator().alloc(ObBitVector::memory_size(spec_.max_batch_size_));
+    if (OB_ISNULL(mem)) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("allocate memory failed", K(ret), K(spec_.max_batch_size_));
+    } else {
+      brs_.skip_ = to_bit_vector(mem);
+      brs_.skip_->reset(spec_.max_batch_size_);
+      reset_batch_rows();
+    }
+  }
+  return ret;
+}
+
 // copy from ob_phy_operator.cpp
 int ObOperator::rescan()
 {
@@ -499,6 +522,7 @@ int ObOperator::rescan()
   int ret = OB_SUCCESS;
 
   startup_passed_ = spec_.startup_filters_.empty();
+  reset_batch_rows();
 
   for (int64_t i = 0; OB_SUCC(ret) && i < child_cnt_; ++i) {
     if (OB_FAIL(children_[i]->rescan())) {
@@ -522,6 +546,7 @@ int ObOperator::switch_iterator()
     ret = OB_ITER_END;
   } else {
     startup_passed_ = spec_.startup_filters_.empty();
+    reset_batch_rows();
 
     // Differ from ObPhyOperator::switch_iterator(), current binding array index is moved from
     // ObExprCtx to ObPhysicalPlanCtx, can not increase in Operator.
@@ -580,53 +605,209 @@ int ObOperator::close()
 int ObOperator::get_next_row()
 {
   int ret = OB_SUCCESS;
-  if (OB_UNLIKELY(!startup_passed_)) {
+  if (OB_UNLIKELY(spec_.is_vectorized())) {
+    // row mode consumer (e.g.: result set) of vectorized operator, iterate rows of batch.
+    if (OB_FAIL(get_next_row_from_batch())) {
+      if (OB_ITER_END != ret) {
+        LOG_WARN("get next row from batch failed", K(ret), "type", spec_.type_, "op", op_name());
+      }
+    }
+  } else {
+    if (OB_UNLIKELY(!startup_passed_)) {
+      bool filtered = false;
+      if (OB_FAIL(startup_filter(filtered))) {
+        LOG_WARN("do startup filter failed", K(ret), "op", op_name());
+      } else {
+        if (filtered) {
+          ret = OB_ITER_END;
+        } else {
+          startup_passed_ = true;
+        }
+      }
+    }
+
+    while (OB_SUCC(ret)) {
+      if (OB_FAIL(inner_get_next_row())) {
+        if (OB_ITER_END != ret) {
+          LOG_WARN("inner get next row failed", K(ret), "type", spec_.type_, "op", op_name());
+        }
+      } else {
+        if (!spec_.filters_.empty()) {
+          bool filtered = false;
+          if (OB_FAIL(filter_row(filtered))) {
+            LOG_WARN("filter row failed", K(ret), "type", spec_.type_, "op", op_name());
+          } else {
+            if (filtered) {
+              continue;
+            }
+          }
+        }
+      }
+      break;
+    }
+
+    if (OB_SUCCESS == ret) {
+      op_monitor_info_.output_row_count_++;
+      if (!got_first_row_) {
+        op_monitor_info_.first_row_time_ = oceanbase::common::ObClockGenerator::getClock();
+        ;
+        got_first_row_ = true;
+      }
+    } else if (OB_ITER_END == ret) {
+      int tmp_ret = drain_exch();
+      if (OB_SUCCESS != tmp_ret) {
+        LOG_WARN("drain exchange data failed", K(tmp_ret));
+      }
+      if (got_first_row_) {
+        op_monitor_info_.last_row_time_ = oceanbase::common::ObClockGenerator::getClock();
+      }
+    }
+  }
+  return ret;
+}
+
+int ObOperator::get_next_row_from_batch()
+{
+  int ret = OB_SUCCESS;
+  bool got_row = false;
+  while (OB_SUCC(ret) && !got_row) {
+    if (brs_row_idx_ < brs_.size_) {
+      if (!brs_.skip_->at(brs_row_idx_)) {
+        // the output datums are located by batch index of eval context.
+        eval_ctx_.set_batch_size(brs_.size_);
+        eval_ctx_.set_batch_idx(brs_row_idx_);
+        got_row = true;
+      }
+      brs_row_idx_++;
+    } else if (brs_.end_) {
+      eval_ctx_.set_batch_idx(0);
+      ret = OB_ITER_END;
+    } else {
+      const ObBatchRows* brs = NULL;
+      if (OB_FAIL(get_next_batch(spec_.max_batch_size_, brs))) {
+        LOG_WARN("get next batch failed", K(ret));
+      } else {
+        brs_row_idx_ = 0;
+      }
+    }
+  }
+  return ret;
+}
+
+int ObOperator::get_next_batch(const int64_t max_row_cnt, const ObBatchRows*& batch_rows)
+{
+  int ret = OB_SUCCESS;
+  batch_rows = &brs_;
+  if (OB_UNLIKELY(!spec_.is_vectorized() || NULL == brs_.skip_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("operator is not vectorized or not opened", K(ret), "op", op_name(), KP(brs_.skip_));
+  } else if (OB_UNLIKELY(max_row_cnt <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(max_row_cnt));
+  } else if (brs_.end_) {
+    // iterate end already
+    brs_.size_ = 0;
+  } else if (OB_UNLIKELY(!startup_passed_)) {
     bool filtered = false;
+    ObEvalCtx::BatchInfoScopeGuard guard(eval_ctx_);
+    guard.set_batch_idx(0);
+    guard.set_batch_size(1);
     if (OB_FAIL(startup_filter(filtered))) {
       LOG_WARN("do startup filter failed", K(ret), "op", op_name());
+    } else if (filtered) {
+      brs_.size_ = 0;
+      brs_.end_ = true;
     } else {
-      if (filtered) {
-        ret = OB_ITER_END;
+      startup_passed_ = true;
+    }
+  }
+
+  if (OB_SUCC(ret) && !brs_.end_) {
+    const int64_t batch_size = std::min(max_row_cnt, spec_.max_batch_size_);
+    // fetch again if all rows are filtered
+    bool all_filtered = true;
+    while (OB_SUCC(ret) && all_filtered) {
+      clear_evaluated_projected_flag();
+      brs_.size_ = 0;
+      brs_.skip_->reset(batch_size);
+      if (OB_FAIL(inner_get_next_batch(batch_size))) {
+        LOG_WARN("inner get next batch failed", K(ret), "type", spec_.type_, "op", op_name());
+      } else if (OB_UNLIKELY(brs_.size_ < 0 || brs_.size_ > batch_size)) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("invalid batch size", K(ret), K(brs_), K(batch_size), "op", op_name());
+      } else if (OB_FAIL(filter_and_project_batch())) {
+        LOG_WARN("filter and project batch failed", K(ret), "type", spec_.type_, "op", op_name());
       } else {
-        startup_passed_ = true;
+        all_filtered = !brs_.end_ && brs_.skip_->is_all_true(brs_.size_);
       }
     }
   }
 
-  while (OB_SUCC(ret)) {
-    if (OB_FAIL(inner_get_next_row())) {
-      if (OB_ITER_END != ret) {
-        LOG_WARN("inner get next row failed", K(ret), "type", spec_.type_, "op", op_name());
+  if (OB_SUCC(ret)) {
+    const int64_t row_cnt = brs_.size_ - brs_.skip_->accumulate_bit_cnt(brs_.size_);
+    op_monitor_info_.output_row_count_ += row_cnt;
+    if (row_cnt > 0 && !got_first_row_) {
+      op_monitor_info_.first_row_time_ = oceanbase::common::ObClockGenerator::getClock();
+      got_first_row_ = true;
+    }
+    if (brs_.end_) {
+      int tmp_ret = drain_exch();
+      if (OB_SUCCESS != tmp_ret) {
+        LOG_WARN("drain exchange data failed", K(tmp_ret));
+      }
+      if (got_first_row_) {
+        op_monitor_info_.last_row_time_ = oceanbase::common::ObClockGenerator::getClock();
       }
+    }
+  }
+  return ret;
+}
+
+int ObOperator::filter_and_project_batch()
+{
+  int ret = OB_SUCCESS;
+  ObEvalCtx::BatchInfoScopeGuard guard(eval_ctx_);
+  guard.set_batch_size(brs_.size_);
+  guard.set_batch_idx(0);
+  // Filters are evaluated one by one in batch, the rows filtered are skipped in the evaluation of
+  // next filter and output, the same as row mode which stops at the first false filter.
+  bool all_filtered = brs_.skip_->is_all_true(brs_.size_);
+  for (int64_t i = 0; OB_SUCC(ret) && !all_filtered && i < spec_.filters_.count(); i++) {
+    const ObExpr* e = spec_.filters_.at(i);
+    OB_ASSERT(NULL != e);
+    if (OB_FAIL(e->eval_batch(eval_ctx_, *brs_.skip_, brs_.size_))) {
+      LOG_WARN("filter evaluate failed", K(ret), "expr", *e);
     } else {
-      if (!spec_.filters_.empty()) {
-        bool filtered = false;
-        if (OB_FAIL(filter_row(filtered))) {
-          LOG_WARN("filter row failed", K(ret), "type", spec_.type_, "op", op_name());
-        } else {
-          if (filtered) {
-            continue;
+      OB_ASSERT(ob_is_int_tc(e->datum_meta_.type_));
+      if (!e->is_batch_result()) {
+        const ObDatum& datum = e->locate_expr_datum(eval_ctx_);
+        if (datum.null_ || 0 == *datum.int_) {
+          brs_.skip_->set_all(brs_.size_);
+        }
+      } else {
+        const ObDatum* datums = e->locate_batch_datums(eval_ctx_);
+        for (int64_t j = 0; j < brs_.size_; j++) {
+          if (!brs_.skip_->at(j) && (datums[j].null_ || 0 == *datums[j].int_)) {
+            brs_.skip_->set(j);
           }
         }
       }
+      all_filtered = brs_.skip_->is_all_true(brs_.size_);
     }
-    break;
   }
-
-  if (OB_SUCCESS == ret) {
-    op_monitor_info_.output_row_count_++;
-    if (!got_first_row_) {
-      op_monitor_info_.first_row_time_ = oceanbase::common::ObClockGenerator::getClock();
-      ;
-      got_first_row_ = true;
-    }
-  } else if (OB_ITER_END == ret) {
-    int tmp_ret = drain_exch();
-    if (OB_SUCCESS != tmp_ret) {
-      LOG_WARN("drain exchange data failed", K(tmp_ret));
+  for (int64_t i = 0; OB_SUCC(ret) && !all_filtered && i < spec_.output_.count(); i++) {
+    const ObExpr* e = spec_.output_.at(i);
+    if (OB_FAIL(e->eval_batch(eval_ctx_, *brs_.skip_, brs_.size_))) {
+      LOG_WARN("expr evaluate failed", K(ret), "expr", *e);
     }
-    if (got_first_row_) {
-      op_monitor_info_.last_row_time_ = oceanbase::common::ObClockGenerator::getClock();
+  }
+  // mark output projected, no need to evaluate again for this batch.
+  for (int64_t i = 0; OB_SUCC(ret) && i < spec_.output_.count(); i++) {
+    const ObExpr* e = spec_.output_.at(i);
+    if (e->is_batch_result()) {
+      ObEvalInfo& info = e->get_eval_info(eval_ctx_);
+      info.projected_ = true;
+      info.cnt_ = brs_.size_;
     }
   }
   return ret;
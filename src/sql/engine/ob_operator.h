@@ -16,6 +16,7 @@
 #include "lib/container/ob_fixed_array.h"
 #include "sql/engine/ob_phy_operator_type.h"
 #include "sql/engine/expr/ob_expr.h"
+#include "sql/engine/ob_bit_vector.h"
 #include "sql/engine/ob_operator_reg.h"
 #include "sql/engine/ob_phy_operator.h"
 #include "sql/engine/px/ob_px_op_size_factor.h"
@@ -61,6 +62,23 @@ public:
   TO_STRING_KV(K_(param_idx), K_(src), K_(dst));
 };
 
+// Batch rows of vectorized execution, returned by ObOperator::get_next_batch().
+// The datums of rows are located in the batch result expressions (see ObExpr::batch_idx_mask_),
+// row i is valid if not skipped (!skip_->at(i)).
+struct ObBatchRows {
+  ObBatchRows() : skip_(NULL), size_(0), end_(false)
+  {}
+
+  TO_STRING_KV(K_(size), K_(end));
+
+  // skip bitmap, row is filtered if bit set.
+  ObBitVector* skip_;
+  // row count of the batch (include skipped rows)
+  int64_t size_;
+  // iterate end, no more rows after this batch (rows of this batch are still valid)
+  bool end_;
+};
+
 class ObOpSpecVisitor;
 // Physical operator specification, immutable in execution.
 // (same with the old ObPhyOperator)
@@ -159,6 +177,11 @@ public:
   {
     return false;
   }
+  // get_next_batch() is used to iterate rows.
+  bool is_vectorized() const
+  {
+    return max_batch_size_ > 0;
+  }
 
   // same with ObPhyOperator to make template works.
   int32_t get_child_num() const
@@ -248,6 +271,8 @@ public:
   int64_t width_;
   PxOpSizeFactor px_est_size_factor_;
   int64_t plan_depth_;
+  // Max row count of get_next_batch(), zero for row mode (not vectorized).
+  int64_t max_batch_size_;
 
 private:
   DISALLOW_COPY_AND_ASSIGN(ObOpSpec);
@@ -308,6 +333,19 @@ public:
   virtual int get_next_row();
   virtual int inner_get_next_row() = 0;
 
+  // fetch next batch rows (for vectorized operator), at most %max_row_cnt rows returned.
+  // OB_ITER_END is never returned, iterate end is indicated by ObBatchRows::end_.
+  // Rows (not skipped) are filtered by filters_ and output_ is projected.
+  virtual int get_next_batch(const int64_t max_row_cnt, const ObBatchRows*& batch_rows);
+  // Fill %brs_ with at most %max_row_cnt rows, the skip bitmap is reset before called.
+  // Output expressions of child (or storage) should be projected, e.g.:
+  //   ObEvalInfo::projected_ set to true and the datums of all rows are filled.
+  virtual int inner_get_next_batch(const int64_t max_row_cnt)
+  {
+    UNUSED(max_row_cnt);
+    return common::OB_NOT_IMPLEMENT;
+  }
+
   // close operator, cascading close child operators
   virtual int close();
   // close operator, not including child operators.
@@ -335,6 +373,8 @@ public:
   }
 
   OB_INLINE void clear_evaluated_flag();
+  // clear both evaluated and projected flags of calc expressions, called before fetch next batch.
+  OB_INLINE void clear_evaluated_projected_flag();
 
   // filter row for storage callback.
   // clear expression evaluated flag if row filtered.
@@ -399,6 +439,22 @@ protected:
   // Drain exchange in data for PX, or producer DFO will be blocked.
   virtual int drain_exch();
 
+  // allocate skip bitmap of %brs_ for vectorized operator
+  int init_batch_rows();
+  // reset batch rows iterate status, for rescan or switch iterator.
+  void reset_batch_rows()
+  {
+    brs_.size_ = 0;
+    brs_.end_ = false;
+    brs_row_idx_ = 0;
+  }
+
+private:
+  // evaluate filters_ and output_ for rows of %brs_ in batch (see ObExpr::eval_batch()).
+  int filter_and_project_batch();
+  // get next row from batch rows, for row mode consumer of vectorized operator.
+  int get_next_row_from_batch();
+
 protected:
   const ObOpSpec& spec_;
   ObExecContext& ctx_;
@@ -426,6 +482,10 @@ protected:
   bool got_first_row_;
   // gv$sql_plan_monitor
   ObMonitorNode op_monitor_info_;
+  // batch rows for vectorized execution
+  ObBatchRows brs_;
+  // next row index of %brs_ for row mode consumer (see get_next_row_from_batch())
+  int64_t brs_row_idx_;
 
 private:
   DISALLOW_COPY_AND_ASSIGN(ObOperator);
@@ -500,6 +560,17 @@ OB_INLINE void ObOperator::clear_evaluated_flag()
   }
 }
 
+OB_INLINE void ObOperator::clear_evaluated_projected_flag()
+{
+  for (int i = 0; i < eval_infos_.count(); i++) {
+    ObEvalInfo* info = eval_infos_.at(i);
+    if (info->evaluated_ || info->projected_) {
+      info->evaluated_ = false;
+      info->projected_ = false;
+    }
+  }
+}
+
 inline int ObOperator::try_check_status()
 {
   return ((++try_check_times_) % CHECK_STATUS_TRY_TIMES == 0) ? check_status() : common::OB_SUCCESS;
@@ -33,7 +33,8 @@ typedef void (*serializable_function)(ObSerializeFuncTag&);
       OB_SFA_EXPR_STR_BASIC, OB_SFA_RELATION_EXPR_EVAL, OB_SFA_RELATION_EXPR_EVAL_STR, OB_SFA_DATUM_CMP,    \
       OB_SFA_DATUM_CMP_STR, OB_SFA_DATUM_CAST_ORACLE_IMPLICIT, OB_SFA_DATUM_CAST_ORACLE_EXPLICIT,           \
       OB_SFA_DATUM_CAST_MYSQL_IMPLICIT, OB_SFA_DATUM_CAST_MYSQL_ENUMSET_IMPLICIT, OB_SFA_SQL_EXPR_EVAL,     \
-      OB_SFA_SQL_EXPR_ABS_EVAL, OB_SFA_SQL_EXPR_NEG_EVAL, OB_SFA_MAX
+      OB_SFA_SQL_EXPR_ABS_EVAL, OB_SFA_SQL_EXPR_NEG_EVAL, OB_SFA_RELATION_EXPR_EVAL_BATCH,                  \
+      OB_SFA_SQL_EXPR_EVAL_BATCH, OB_SFA_MAX
 
 enum ObSerFuncArrayID { SER_FUNC_ARRAY_ID_ENUM };
 
@@ -131,6 +131,14 @@ public:
     }
   }
 
+  void dump_saved(int64_t size)
+  {
+    profile_.dump_saved_size_ += size;
+    if (OB_NOT_NULL(mem_callback_)) {
+      mem_callback_->dump_saved(size);
+    }
+  }
+
   void reset_delta_size()
   {
     profile_.delta_size_ = 0;
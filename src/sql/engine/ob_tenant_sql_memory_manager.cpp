@@ -1117,7 +1117,8 @@ int ObTenantSqlMemoryManager::calculate_global_bound_size_by_interval_info(
             K(cur_profile_cnt),
             K(calc_info.get_mem_target()),
             K(auto_calc),
-            K(sql_mem_callback_.get_total_dump_size()));
+            K(sql_mem_callback_.get_total_dump_size()),
+            K(sql_mem_callback_.get_total_dump_saved_size()));
       }
       if (OB_FAIL(try_push_profiles_work_area_size(calc_info.get_global_bound_size()))) {
         LOG_WARN("failed to push profiles work area size", K(ret), K(calc_info.get_global_bound_size()));
@@ -51,6 +51,7 @@ public:
         mem_used_(0),
         pre_mem_used_(0),
         dumped_size_(0),
+        dump_saved_size_(0),
         data_ratio_(0.5),
         active_time_(0),
         number_pass_(0)
@@ -238,6 +239,10 @@ public:
   {
     return dumped_size_;
   }
+  int64_t get_dump_saved_size() const
+  {
+    return dump_saved_size_;
+  }
   int64_t get_data_ratio() const
   {
     return data_ratio_;
@@ -290,6 +295,7 @@ public:
   int64_t mem_used_;
   int64_t pre_mem_used_;
   int64_t dumped_size_;
+  int64_t dump_saved_size_;  // saved by compressing dumped data
   double data_ratio_;
 
 public:
@@ -608,18 +614,20 @@ private:
 
 class ObTenantSqlMemoryCallback : public ObSqlMemoryCallback {
 public:
-  ObTenantSqlMemoryCallback() : total_alloc_size_(0), total_dump_size_(0)
+  ObTenantSqlMemoryCallback() : total_alloc_size_(0), total_dump_size_(0), total_dump_saved_size_(0)
   {}
 
 public:
   virtual void alloc(int64_t size) override;
   virtual void free(int64_t size) override;
   virtual void dumped(int64_t size) override;
+  virtual void dump_saved(int64_t size) override;
 
   void reset()
   {
     total_alloc_size_ = 0;
     total_dump_size_ = 0;
+    total_dump_saved_size_ = 0;
   }
   int64_t get_total_alloc_size() const
   {
@@ -629,10 +637,15 @@ public:
   {
     return total_dump_size_;
   }
+  int64_t get_total_dump_saved_size() const
+  {
+    return total_dump_saved_size_;
+  }
 
 private:
   int64_t total_alloc_size_;
   int64_t total_dump_size_;
+  int64_t total_dump_saved_size_;
 };
 
 class ObSqlWorkAreaInterval {
@@ -1135,6 +1148,11 @@ OB_INLINE void ObTenantSqlMemoryCallback::dumped(int64_t size)
   (ATOMIC_AAF(&total_dump_size_, size));
 }
 
+OB_INLINE void ObTenantSqlMemoryCallback::dump_saved(int64_t size)
+{
+  (ATOMIC_AAF(&total_dump_saved_size_, size));
+}
+
 }  // namespace sql
 }  // namespace oceanbase
 #endif /* OB_DTL_FC_SERVER_H */
@@ -0,0 +1,268 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_ENG
+#include "sql/engine/px/datahub/components/ob_dh_join_filter.h"
+#include "sql/engine/px/datahub/ob_dh_msg_ctx.h"
+#include "sql/engine/px/ob_dfo.h"
+#include "sql/engine/px/ob_px_util.h"
+#include "sql/engine/px/datahub/ob_dh_msg.h"
+
+using namespace oceanbase::sql;
+using namespace oceanbase::common;
+
+OB_SERIALIZE_MEMBER(ObJoinFilterUseInfo, filter_id_, is_global_, key_exprs_, hash_funcs_);
+OB_SERIALIZE_MEMBER((ObJoinFilterPieceMsg, ObDatahubPieceMsg), probe_dfo_id_, filter_);
+OB_SERIALIZE_MEMBER((ObJoinFilterWholeMsg, ObDatahubWholeMsg), filter_);
+
+ObJoinFilterData::ObJoinFilterData()
+    : bits_(OB_MALLOC_NORMAL_BLOCK_SIZE, ModulePageAllocator("PxJoinFilter")),
+      has_range_(false),
+      min_val_(INT64_MAX),
+      max_val_(INT64_MIN),
+      row_cnt_(0)
+{}
+
+int ObJoinFilterData::init(const int64_t expect_row_cnt, const bool has_range)
+{
+  int ret = OB_SUCCESS;
+  int64_t word_cnt = MIN_WORD_CNT;
+  while (word_cnt < MAX_WORD_CNT && word_cnt * 64 < expect_row_cnt * BITS_PER_ROW) {
+    word_cnt <<= 1;
+  }
+  reset();
+  if (OB_FAIL(bits_.prepare_allocate(word_cnt))) {
+    LOG_WARN("allocate bloom filter bits failed", K(ret), K(word_cnt));
+  } else {
+    MEMSET(bits_.get_data(), 0, word_cnt * sizeof(uint64_t));
+    has_range_ = has_range;
+  }
+  return ret;
+}
+
+void ObJoinFilterData::reset()
+{
+  bits_.reset();
+  has_range_ = false;
+  min_val_ = INT64_MAX;
+  max_val_ = INT64_MIN;
+  row_cnt_ = 0;
+}
+
+int ObJoinFilterData::assign(const ObJoinFilterData& other)
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(bits_.assign(other.bits_))) {
+    LOG_WARN("assign bloom filter bits failed", K(ret));
+  } else {
+    has_range_ = other.has_range_;
+    min_val_ = other.min_val_;
+    max_val_ = other.max_val_;
+    row_cnt_ = other.row_cnt_;
+  }
+  return ret;
+}
+
+int ObJoinFilterData::fold(const int64_t word_cnt)
+{
+  int ret = OB_SUCCESS;
+  const int64_t cur_cnt = bits_.count();
+  if (OB_UNLIKELY(word_cnt <= 0 || word_cnt > cur_cnt || 0 != (word_cnt & (word_cnt - 1)))) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid fold word count", K(ret), K(word_cnt), K(cur_cnt));
+  } else {
+    uint64_t* words = bits_.get_data();
+    for (int64_t i = word_cnt; i < cur_cnt; i++) {
+      words[i & (word_cnt - 1)] |= words[i];
+    }
+    while (bits_.count() > word_cnt) {
+      bits_.pop_back();
+    }
+  }
+  return ret;
+}
+
+int ObJoinFilterData::merge(const ObJoinFilterData& other)
+{
+  int ret = OB_SUCCESS;
+  if (!other.is_valid()) {
+    // nothing to merge
+  } else if (!is_valid()) {
+    if (OB_FAIL(assign(other))) {
+      LOG_WARN("assign join filter failed", K(ret));
+    }
+  } else if (OB_UNLIKELY(has_range_ != other.has_range_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("merge join filters of different kinds", K(ret), K(*this), K(other));
+  } else if (bits_.count() > other.bits_.count() && OB_FAIL(fold(other.bits_.count()))) {
+    LOG_WARN("fold join filter failed", K(ret));
+  } else {
+    const int64_t word_cnt = bits_.count();
+    uint64_t* words = bits_.get_data();
+    const uint64_t* other_words = other.bits_.get_data();
+    for (int64_t i = 0; i < other.bits_.count(); i++) {
+      words[i & (word_cnt - 1)] |= other_words[i];
+    }
+    min_val_ = std::min(min_val_, other.min_val_);
+    max_val_ = std::max(max_val_, other.max_val_);
+    row_cnt_ += other.row_cnt_;
+  }
+  return ret;
+}
+
+// bloom filter bits are copied as a whole, encoding words one by one is too slow
+OB_DEF_SERIALIZE(ObJoinFilterData)
+{
+  int ret = OB_SUCCESS;
+  const int64_t word_cnt = bits_.count();
+  LST_DO_CODE(OB_UNIS_ENCODE, has_range_, min_val_, max_val_, row_cnt_, word_cnt);
+  if (OB_SUCC(ret) && word_cnt > 0) {
+    const int64_t size = word_cnt * sizeof(uint64_t);
+    if (pos + size > buf_len) {
+      ret = OB_SIZE_OVERFLOW;
+      LOG_WARN("buffer not enough", K(ret), K(pos), K(size), K(buf_len));
+    } else {
+      MEMCPY(buf + pos, bits_.get_data(), size);
+      pos += size;
+    }
+  }
+  return ret;
+}
+
+OB_DEF_DESERIALIZE(ObJoinFilterData)
+{
+  int ret = OB_SUCCESS;
+  int64_t word_cnt = 0;
+  reset();
+  LST_DO_CODE(OB_UNIS_DECODE, has_range_, min_val_, max_val_, row_cnt_, word_cnt);
+  if (OB_SUCC(ret) && word_cnt > 0) {
+    const int64_t size = word_cnt * sizeof(uint64_t);
+    if (pos + size > data_len) {
+      ret = OB_SIZE_OVERFLOW;
+      LOG_WARN("data not enough", K(ret), K(pos), K(size), K(data_len));
+    } else if (OB_FAIL(bits_.prepare_allocate(word_cnt))) {
+      LOG_WARN("allocate bloom filter bits failed", K(ret), K(word_cnt));
+    } else {
+      MEMCPY(bits_.get_data(), buf + pos, size);
+      pos += size;
+    }
+  }
+  return ret;
+}
+
+OB_DEF_SERIALIZE_SIZE(ObJoinFilterData)
+{
+  int64_t len = 0;
+  const int64_t word_cnt = bits_.count();
+  LST_DO_CODE(OB_UNIS_ADD_LEN, has_range_, min_val_, max_val_, row_cnt_, word_cnt);
+  len += word_cnt * sizeof(uint64_t);
+  return len;
+}
+
+int ObJoinFilterProbeCtx::check(const ObJoinFilterUseInfo& info, ObEvalCtx& eval_ctx, bool& is_filtered)
+{
+  int ret = OB_SUCCESS;
+  is_filtered = false;
+  if (OB_ISNULL(filter_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("join filter not attached", K(ret));
+  } else {
+    uint64_t hash_value = ObJoinFilterData::HASH_SEED;
+    ObDatum* datum = NULL;
+    for (int64_t i = 0; OB_SUCC(ret) && !is_filtered && i < info.key_exprs_.count(); i++) {
+      if (OB_FAIL(info.key_exprs_.at(i)->eval(eval_ctx, datum))) {
+        LOG_WARN("eval join key failed", K(ret), K(i));
+      } else if (datum->is_null()) {
+        // only generated for equal join condition, null never matches
+        is_filtered = true;
+      } else if (filter_->has_range() && !filter_->in_range(datum->get_int())) {
+        is_filtered = true;
+      } else {
+        hash_value = info.hash_funcs_.at(i).hash_func_(*datum, hash_value);
+      }
+    }
+    if (OB_SUCC(ret) && !is_filtered) {
+      is_filtered = !filter_->might_contain(hash_value & ObJoinFilterData::HASH_VAL_MASK);
+    }
+    if (OB_SUCC(ret)) {
+      check_cnt_++;
+      filter_cnt_ += is_filtered;
+      if (CHECK_SAMPLE_CNT == check_cnt_ && filter_cnt_ < (check_cnt_ >> MIN_FILTER_RATIO_SHIFT)) {
+        disabled_ = true;
+        LOG_TRACE("join filter is not selective, disable it", K(info), K(*this));
+      }
+    }
+  }
+  return ret;
+}
+
+int ObJoinFilterPieceMsgListener::on_message(
+    ObJoinFilterPieceMsgCtx& ctx, common::ObIArray<ObPxSqcMeta*>& sqcs, const ObJoinFilterPieceMsg& pkt)
+{
+  int ret = OB_SUCCESS;
+  if (pkt.op_id_ != ctx.op_id_) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("unexpected piece msg", K(pkt), K(ctx));
+  } else if (ctx.received_ >= ctx.task_cnt_) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("should not receive any more pkt. already get all pkt expected", K(pkt), K(ctx));
+  } else if (OB_FAIL(ctx.whole_msg_.filter_.merge(pkt.filter_))) {
+    LOG_WARN("fail to merge join filter", K(ret));
+  } else {
+    ctx.received_++;
+    LOG_TRACE("got a join filter piece msg", "all_got", ctx.received_, "expected", ctx.task_cnt_);
+  }
+  // all piece received, send whole to the running SQCs of the probe side dfo.
+  // it's only an optimization, the probe side keeps going without the filter if
+  // the dfo is not scheduled yet or fails to receive it.
+  if (OB_SUCC(ret) && ctx.received_ == ctx.task_cnt_) {
+    ctx.whole_msg_.op_id_ = ctx.op_id_;
+    ARRAY_FOREACH_X(sqcs, idx, cnt, OB_SUCC(ret))
+    {
+      dtl::ObDtlChannel* ch = sqcs.at(idx)->get_qc_channel();
+      if (OB_ISNULL(ch)) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("null expected", K(ret));
+      } else if (OB_FAIL(ch->send(ctx.whole_msg_, ctx.timeout_ts_))) {
+        LOG_WARN("fail push data to channel", K(ret));
+      } else if (OB_FAIL(ch->flush(true, false))) {
+        LOG_WARN("fail flush dtl data", K(ret));
+      } else {
+        LOG_DEBUG("dispatched join filter whole msg", K(idx), K(cnt), K(ctx.whole_msg_), K(*ch));
+      }
+    }
+    if (OB_SUCC(ret) && OB_FAIL(ObPxChannelUtil::sqcs_channles_asyn_wait(sqcs))) {
+      LOG_WARN("failed to wait response", K(ret));
+    }
+    ctx.whole_msg_.reset();
+  }
+  return ret;
+}
+
+int ObJoinFilterPieceMsgCtx::alloc_piece_msg_ctx(
+    const ObJoinFilterPieceMsg& pkt, ObExecContext& ctx, int64_t task_cnt, ObPieceMsgCtx*& msg_ctx)
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(ctx.get_physical_plan_ctx())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("physical plan ctx is null", K(ret));
+  } else {
+    void* buf = ctx.get_allocator().alloc(sizeof(ObJoinFilterPieceMsgCtx));
+    if (OB_ISNULL(buf)) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+    } else {
+      msg_ctx = new (buf)
+          ObJoinFilterPieceMsgCtx(pkt.op_id_, task_cnt, ctx.get_physical_plan_ctx()->get_timeout_timestamp());
+    }
+  }
+  return ret;
+}
@@ -0,0 +1,258 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef __OB_SQL_ENG_PX_DH_JOIN_FILTER_H__
+#define __OB_SQL_ENG_PX_DH_JOIN_FILTER_H__
+
+#include "sql/engine/px/datahub/ob_dh_msg.h"
+#include "sql/engine/px/datahub/ob_dh_dtl_proc.h"
+#include "sql/engine/px/datahub/ob_dh_msg_ctx.h"
+#include "sql/engine/px/datahub/ob_dh_msg_provider.h"
+#include "sql/engine/ob_operator.h"
+#include "share/datum/ob_datum_funcs.h"
+
+namespace oceanbase {
+namespace sql {
+
+class ObJoinFilterPieceMsg;
+class ObJoinFilterWholeMsg;
+typedef ObPieceMsgP<ObJoinFilterPieceMsg> ObJoinFilterPieceMsgP;
+typedef ObWholeMsgP<ObJoinFilterWholeMsg> ObJoinFilterWholeMsgP;
+class ObJoinFilterPieceMsgListener;
+class ObJoinFilterPieceMsgCtx;
+
+// Runtime join filter built from the hash join build side: a bloom filter of the
+// join key hash values, plus the [min, max] range of the key if it is a single integer.
+//
+// The bloom filter size is always a power of two words and the bit index is the low bits
+// of the hash value, so filters of different sizes can be merged by folding the larger one.
+class ObJoinFilterData {
+  OB_UNIS_VERSION(1);
+
+public:
+  static const int64_t BITS_PER_ROW = 8;
+  static const int64_t HASH_CNT = 3;
+  static const int64_t MIN_WORD_CNT = 16;        // 1K bits
+  static const int64_t MAX_WORD_CNT = 1L << 18;  // 16M bits, 2MB
+  // same seed and mask as hash join, the build side hash value can be reused
+  static const int64_t HASH_SEED = 16777213;
+  static const uint64_t HASH_VAL_MASK = UINT64_MAX >> 1;
+
+public:
+  ObJoinFilterData();
+  ~ObJoinFilterData() = default;
+  int init(const int64_t expect_row_cnt, const bool has_range);
+  void reset();
+  int assign(const ObJoinFilterData& other);
+  int merge(const ObJoinFilterData& other);
+  bool is_valid() const
+  {
+    return bits_.count() > 0;
+  }
+  OB_INLINE void insert(const uint64_t hash)
+  {
+    uint64_t* words = bits_.get_data();
+    const uint64_t mask = (static_cast<uint64_t>(bits_.count()) << 6) - 1;
+    const uint64_t delta = (hash >> 32) | 1;
+    uint64_t h = hash;
+    for (int64_t i = 0; i < HASH_CNT; i++, h += delta) {
+      words[(h & mask) >> 6] |= 1UL << (h & 63);
+    }
+    row_cnt_++;
+  }
+  OB_INLINE bool might_contain(const uint64_t hash) const
+  {
+    bool contain = true;
+    const uint64_t* words = bits_.get_data();
+    const uint64_t mask = (static_cast<uint64_t>(bits_.count()) << 6) - 1;
+    const uint64_t delta = (hash >> 32) | 1;
+    uint64_t h = hash;
+    for (int64_t i = 0; contain && i < HASH_CNT; i++, h += delta) {
+      contain = 0 != (words[(h & mask) >> 6] & (1UL << (h & 63)));
+    }
+    return contain;
+  }
+  OB_INLINE void update_range(const int64_t v)
+  {
+    min_val_ = std::min(min_val_, v);
+    max_val_ = std::max(max_val_, v);
+  }
+  OB_INLINE bool in_range(const int64_t v) const
+  {
+    return v >= min_val_ && v <= max_val_;
+  }
+  bool has_range() const
+  {
+    return has_range_;
+  }
+  int64_t get_row_cnt() const
+  {
+    return row_cnt_;
+  }
+  int64_t get_word_cnt() const
+  {
+    return bits_.count();
+  }
+  TO_STRING_KV("word_cnt", bits_.count(), K_(has_range), K_(min_val), K_(max_val), K_(row_cnt));
+
+private:
+  int fold(const int64_t word_cnt);
+
+private:
+  common::ObSEArray<uint64_t, 1> bits_;
+  bool has_range_;
+  int64_t min_val_;
+  int64_t max_val_;
+  int64_t row_cnt_;
+
+  DISALLOW_COPY_AND_ASSIGN(ObJoinFilterData);
+};
+
+// Join filter consumer description, generated into the probe side table scan or transmit.
+struct ObJoinFilterUseInfo {
+  OB_UNIS_VERSION(1);
+
+public:
+  ObJoinFilterUseInfo(common::ObIAllocator& alloc)
+      : filter_id_(common::OB_INVALID_ID), is_global_(false), key_exprs_(alloc), hash_funcs_(alloc)
+  {}
+  bool is_valid() const
+  {
+    return common::OB_INVALID_ID != filter_id_;
+  }
+  TO_STRING_KV(K_(filter_id), K_(is_global), K_(key_exprs));
+
+  uint64_t filter_id_;  // operator id of the hash join which builds the filter
+  bool is_global_;      // filter is merged and published by QC through datahub
+  ExprFixedArray key_exprs_;
+  common::ObHashFuncs hash_funcs_;
+};
+
+// Probe side runtime of a join filter. The filter is attached lazily since the build side
+// may not be finished when the first probe row arrives, rows pass through until then.
+class ObJoinFilterProbeCtx {
+public:
+  // stop checking if less than 1/16 rows are filtered after the first CHECK_SAMPLE_CNT rows
+  static const int64_t CHECK_SAMPLE_CNT = 4096;
+  static const int64_t MIN_FILTER_RATIO_SHIFT = 4;
+
+public:
+  ObJoinFilterProbeCtx() : filter_(NULL), check_cnt_(0), filter_cnt_(0), disabled_(false)
+  {}
+  void reset()
+  {
+    filter_ = NULL;
+    check_cnt_ = 0;
+    filter_cnt_ = 0;
+    disabled_ = false;
+  }
+  bool is_attached() const
+  {
+    return NULL != filter_;
+  }
+  bool is_active() const
+  {
+    return NULL != filter_ && !disabled_;
+  }
+  void attach(const ObJoinFilterData* filter)
+  {
+    filter_ = filter;
+  }
+  int check(const ObJoinFilterUseInfo& info, ObEvalCtx& eval_ctx, bool& is_filtered);
+  TO_STRING_KV(KP_(filter), K_(check_cnt), K_(filter_cnt), K_(disabled));
+
+private:
+  const ObJoinFilterData* filter_;
+  int64_t check_cnt_;
+  int64_t filter_cnt_;
+  bool disabled_;
+};
+
+class ObJoinFilterPieceMsg : public ObDatahubPieceMsg<dtl::ObDtlMsgType::DH_JOIN_FILTER_PIECE_MSG> {
+  OB_UNIS_VERSION_V(1);
+
+public:
+  using PieceMsgListener = ObJoinFilterPieceMsgListener;
+  using PieceMsgCtx = ObJoinFilterPieceMsgCtx;
+
+public:
+  ObJoinFilterPieceMsg() : probe_dfo_id_(common::OB_INVALID_ID), filter_()
+  {}
+  ~ObJoinFilterPieceMsg() = default;
+  void reset()
+  {
+    filter_.reset();
+  }
+  INHERIT_TO_STRING_KV("meta", ObDatahubPieceMsg<dtl::ObDtlMsgType::DH_JOIN_FILTER_PIECE_MSG>, K_(op_id),
+      K_(probe_dfo_id), K_(filter));
+
+public:
+  uint64_t probe_dfo_id_;  // dfo of the probe side transmit, the whole msg is sent to it
+  ObJoinFilterData filter_;
+  DISALLOW_COPY_AND_ASSIGN(ObJoinFilterPieceMsg);
+};
+
+class ObJoinFilterWholeMsg : public ObDatahubWholeMsg<dtl::ObDtlMsgType::DH_JOIN_FILTER_WHOLE_MSG> {
+  OB_UNIS_VERSION_V(1);
+
+public:
+  using WholeMsgProvider = ObWholeMsgProvider<ObJoinFilterWholeMsg>;
+
+public:
+  ObJoinFilterWholeMsg() : filter_()
+  {}
+  ~ObJoinFilterWholeMsg() = default;
+  int assign(const ObJoinFilterWholeMsg& other)
+  {
+    op_id_ = other.op_id_;
+    return filter_.assign(other.filter_);
+  }
+  void reset()
+  {
+    filter_.reset();
+  }
+  VIRTUAL_TO_STRING_KV(K_(op_id), K_(filter));
+  ObJoinFilterData filter_;
+};
+
+class ObJoinFilterPieceMsgCtx : public ObPieceMsgCtx {
+public:
+  ObJoinFilterPieceMsgCtx(uint64_t op_id, int64_t task_cnt, int64_t timeout_ts)
+      : ObPieceMsgCtx(op_id, task_cnt, timeout_ts), received_(0), whole_msg_()
+  {}
+  ~ObJoinFilterPieceMsgCtx() = default;
+  INHERIT_TO_STRING_KV("meta", ObPieceMsgCtx, K_(received));
+  static int alloc_piece_msg_ctx(
+      const ObJoinFilterPieceMsg& pkt, ObExecContext& ctx, int64_t task_cnt, ObPieceMsgCtx*& msg_ctx);
+  int received_;
+  ObJoinFilterWholeMsg whole_msg_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(ObJoinFilterPieceMsgCtx);
+};
+
+class ObJoinFilterPieceMsgListener {
+public:
+  ObJoinFilterPieceMsgListener() = default;
+  ~ObJoinFilterPieceMsgListener() = default;
+  // @sqcs are the running sqcs of the probe side dfo
+  static int on_message(
+      ObJoinFilterPieceMsgCtx& ctx, common::ObIArray<ObPxSqcMeta*>& sqcs, const ObJoinFilterPieceMsg& pkt);
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(ObJoinFilterPieceMsgListener);
+};
+
+}  // namespace sql
+}  // namespace oceanbase
+#endif /* __OB_SQL_ENG_PX_DH_JOIN_FILTER_H__ */
+//// end of header file
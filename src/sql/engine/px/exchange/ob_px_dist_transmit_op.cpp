@@ -16,6 +16,7 @@
 #include "sql/engine/ob_physical_plan.h"
 #include "sql/engine/ob_exec_context.h"
 #include "sql/engine/px/ob_px_util.h"
+#include "sql/engine/px/ob_px_sqc_handler.h"
 
 namespace oceanbase {
 using namespace common;
@@ -23,7 +24,31 @@ namespace sql {
 
 OB_SERIALIZE_MEMBER((ObPxDistTransmitOpInput, ObPxTransmitOpInput));
 
-OB_SERIALIZE_MEMBER((ObPxDistTransmitSpec, ObPxTransmitSpec), dist_exprs_, dist_hash_funcs_);
+OB_SERIALIZE_MEMBER((ObPxDistTransmitSpec, ObPxTransmitSpec), dist_exprs_, dist_hash_funcs_, join_filter_info_);
+
+int ObPxDistTransmitSpec::register_to_datahub(ObExecContext& ctx) const
+{
+  int ret = OB_SUCCESS;
+  if (join_filter_info_.is_valid() && join_filter_info_.is_global_) {
+    if (OB_ISNULL(ctx.get_sqc_handler())) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("null unexpected", K(ret));
+    } else {
+      void* buf = ctx.get_allocator().alloc(sizeof(ObJoinFilterWholeMsg::WholeMsgProvider));
+      if (OB_ISNULL(buf)) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+      } else {
+        // whole msg is keyed by the hash join which builds the filter
+        ObJoinFilterWholeMsg::WholeMsgProvider* provider = new (buf) ObJoinFilterWholeMsg::WholeMsgProvider();
+        ObSqcCtx& sqc_ctx = ctx.get_sqc_handler()->get_sqc_ctx();
+        if (OB_FAIL(sqc_ctx.add_whole_msg_provider(join_filter_info_.filter_id_, *provider))) {
+          LOG_WARN("fail add whole msg provider", K(ret));
+        }
+      }
+    }
+  }
+  return ret;
+}
 
 int ObPxDistTransmitOp::inner_open()
 {
@@ -290,5 +315,47 @@ int ObPxDistTransmitOp::inner_close()
   return ObPxTransmitOp::inner_close();
 }
 
+int ObPxDistTransmitOp::filter_row(bool& is_filtered)
+{
+  int ret = OB_SUCCESS;
+  is_filtered = false;
+  if (!MY_SPEC.join_filter_info_.is_valid() || !MY_SPEC.join_filter_info_.is_global_) {
+    // no join filter
+  } else if (!join_filter_ctx_.is_attached() && 0 == (join_filter_wait_rows_++ % JOIN_FILTER_POLL_INTERVAL) &&
+             OB_FAIL(fetch_join_filter())) {
+    LOG_WARN("fail to fetch join filter", K(ret));
+  } else if (join_filter_ctx_.is_active() &&
+             OB_FAIL(join_filter_ctx_.check(MY_SPEC.join_filter_info_, eval_ctx_, is_filtered))) {
+    LOG_WARN("fail to check join filter", K(ret));
+  }
+  return ret;
+}
+
+// rows are sent without filtering until the whole msg arrives, never wait for it.
+int ObPxDistTransmitOp::fetch_join_filter()
+{
+  int ret = OB_SUCCESS;
+  const ObJoinFilterWholeMsg* whole = NULL;
+  ObPxSqcHandler* handler = ctx_.get_sqc_handler();
+  if (OB_ISNULL(handler)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("null unexpected", K(ret));
+  } else if (OB_FAIL(handler->get_sqc_proxy().get_dh_msg_nonblock(
+                 MY_SPEC.join_filter_info_.filter_id_, whole, ctx_.get_physical_plan_ctx()->get_timeout_timestamp()))) {
+    if (OB_EAGAIN == ret) {
+      ret = OB_SUCCESS;
+    } else {
+      LOG_WARN("fail get join filter whole msg", K(ret));
+    }
+  } else if (OB_ISNULL(whole)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("whole msg is unexpected", K(ret));
+  } else if (whole->filter_.is_valid()) {
+    join_filter_ctx_.attach(&whole->filter_);
+    LOG_TRACE("join filter attached", K(join_filter_wait_rows_), K(*whole));
+  }
+  return ret;
+}
+
 }  // end namespace sql
 }  // end namespace oceanbase
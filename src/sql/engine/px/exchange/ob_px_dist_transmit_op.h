@@ -14,6 +14,7 @@
 #define OCEANBASE_ENGINE_PX_EXCHANGE_OB_PX_DIST_TRANSMIT_OP_H_
 
 #include "ob_px_transmit_op.h"
+#include "sql/engine/px/datahub/components/ob_dh_join_filter.h"
 
 namespace oceanbase {
 namespace sql {
@@ -33,18 +34,21 @@ class ObPxDistTransmitSpec : public ObPxTransmitSpec {
 
 public:
   ObPxDistTransmitSpec(common::ObIAllocator& alloc, const ObPhyOperatorType type)
-      : ObPxTransmitSpec(alloc, type), dist_exprs_(alloc), dist_hash_funcs_(alloc)
+      : ObPxTransmitSpec(alloc, type), dist_exprs_(alloc), dist_hash_funcs_(alloc), join_filter_info_(alloc)
   {}
   ~ObPxDistTransmitSpec()
   {}
+  virtual int register_to_datahub(ObExecContext& ctx) const override;
   ExprFixedArray dist_exprs_;
   common::ObHashFuncs dist_hash_funcs_;
+  // runtime join filter built by the hash join of the consumer dfo, published by QC
+  ObJoinFilterUseInfo join_filter_info_;
 };
 
 class ObPxDistTransmitOp : public ObPxTransmitOp {
 public:
   ObPxDistTransmitOp(ObExecContext& exec_ctx, const ObOpSpec& spec, ObOpInput* input)
-      : ObPxTransmitOp(exec_ctx, spec, input)
+      : ObPxTransmitOp(exec_ctx, spec, input), join_filter_ctx_(), join_filter_wait_rows_(0)
   {}
   virtual ~ObPxDistTransmitOp()
   {}
@@ -63,13 +67,23 @@ public:
 
   virtual int do_transmit() override;
 
+protected:
+  virtual int filter_row(bool& is_filtered) override;
+
 private:
+  // poll the join filter whole msg every JOIN_FILTER_POLL_INTERVAL rows until it arrives
+  static const int64_t JOIN_FILTER_POLL_INTERVAL = 1024;
+  int fetch_join_filter();
   int do_hash_dist();
   int do_bc2host_dist();
   int do_random_dist();
   int do_broadcast_dist();
   int do_sm_broadcast_dist();
   int do_sm_pkey_hash_dist();
+
+private:
+  ObJoinFilterProbeCtx join_filter_ctx_;
+  int64_t join_filter_wait_rows_;
 };
 
 }  // end namespace sql
@@ -229,6 +229,7 @@ int ObPxTransmitOp::init_channel(ObPxTransmitOpInput& trans_input)
         ch->set_audit(enable_audit);
         ch->set_interm_result(use_interm_result);
         ch->set_compression_type(dfc_.get_compressor_type());
+        ch->set_column_encode(dfc_.is_column_encode() && !use_interm_result);
       }
       LOG_TRACE("Transmit channel", K(ch), KP(ch->get_id()), K(ch->get_peer()));
     }
@@ -493,6 +494,17 @@ int ObPxTransmitOp::next_row()
   } else {
     ret = ObOperator::get_next_row();
   }
+  bool is_filtered = false;
+  while (OB_SUCC(ret)) {
+    if (OB_FAIL(filter_row(is_filtered))) {
+      LOG_WARN("fail to filter row", K(ret));
+    } else if (!is_filtered) {
+      break;
+    } else {
+      clear_evaluated_flag();
+      ret = ObOperator::get_next_row();
+    }
+  }
   return ret;
 }
 
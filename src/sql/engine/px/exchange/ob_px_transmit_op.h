@@ -122,6 +122,12 @@ protected:
       ObPxTaskChSet& ch_set, common::ObIArray<dtl::ObDtlChannel*>& channels, dtl::ObDtlFlowControl* dfc = nullptr);
   int send_rows(ObSliceIdxCalc& slice_calc);
   int broadcast_rows(ObSliceIdxCalc& slice_calc);
+  // rows filtered are not sent, e.g. rows which can not pass the runtime join filter
+  virtual int filter_row(bool& is_filtered)
+  {
+    is_filtered = false;
+    return common::OB_SUCCESS;
+  }
 
 private:
   int update_row(int partition_id_column_idx, int64_t partition_id);
@@ -352,3 +352,89 @@ void ObPxDatumRowIterator::reset()
   is_inited_ = false;
 }
 //-------- end ObPxDatumRowIterator --------
+
+//-------- start ObPxDatumColumnIterator --------
+ObPxDatumColumnIterator::ObPxDatumColumnIterator()
+    : is_eof_(false), is_iter_end_(false), cur_row_(0), reader_(), is_inited_(false)
+{}
+
+ObPxDatumColumnIterator::~ObPxDatumColumnIterator()
+{
+  reset();
+}
+
+void ObPxDatumColumnIterator::set_iterator_end()
+{
+  if (is_eof_) {
+    is_iter_end_ = true;
+  }
+}
+
+void ObPxDatumColumnIterator::set_end()
+{
+  is_iter_end_ = true;
+  is_eof_ = true;
+}
+
+int ObPxDatumColumnIterator::load_buffer(const dtl::ObDtlLinkedBuffer& buffer)
+{
+  int ret = OB_SUCCESS;
+  reset();
+  if (OB_FAIL(reader_.init(buffer.buf(), buffer.size()))) {
+    LOG_WARN("init column batch reader failed", K(ret), K(buffer.size()));
+  } else {
+    is_eof_ = buffer.is_eof();
+    is_inited_ = true;
+  }
+  return ret;
+}
+
+int ObPxDatumColumnIterator::get_next_row(const ObIArray<ObExpr*>& exprs, ObEvalCtx& eval_ctx)
+{
+  int ret = OB_SUCCESS;
+  if (is_iter_end_) {
+    if (!is_eof_) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("row store is not eof", K(ret));
+    } else {
+      ret = OB_ITER_END;
+    }
+  } else if (!is_inited_) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("row store is not init", K(ret));
+  } else if (!has_next()) {
+    ret = OB_ITER_END;
+  } else if (OB_UNLIKELY(exprs.count() != reader_.get_col_cnt())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("datum count mismatch", K(ret), K(exprs.count()), K(reader_.get_col_cnt()));
+  } else {
+    for (int64_t i = 0; i < exprs.count(); i++) {
+      reader_.get_datum(i, cur_row_, exprs.at(i)->locate_expr_datum(eval_ctx));
+      exprs.at(i)->get_eval_info(eval_ctx).evaluated_ = true;
+    }
+    cur_row_++;
+  }
+  if (OB_FAIL(ret)) {
+    if (OB_ITER_END == ret) {
+      if (!is_eof_) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("expect eof", K(ret));
+      }
+      LOG_TRACE("iterator end from px column batch", K(ret), K(is_eof_));
+      reset();
+    } else {
+      LOG_WARN("trace get row from column batch", K(ret), K(is_eof_));
+    }
+  }
+  return ret;
+}
+
+void ObPxDatumColumnIterator::reset()
+{
+  reader_.reset();
+  cur_row_ = 0;
+  is_eof_ = false;
+  is_iter_end_ = false;
+  is_inited_ = false;
+}
+//-------- end ObPxDatumColumnIterator --------
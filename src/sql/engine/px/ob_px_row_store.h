@@ -20,6 +20,7 @@
 #include "sql/dtl/ob_dtl_msg_type.h"
 #include "sql/dtl/ob_dtl_processor.h"
 #include "sql/dtl/ob_dtl_linked_buffer.h"
+#include "sql/dtl/ob_dtl_column_batch.h"
 #include "sql/engine/basic/ob_chunk_row_store.h"
 #include "sql/engine/basic/ob_chunk_datum_store.h"
 
@@ -161,6 +162,50 @@ private:
   bool is_inited_;
 };
 
+// Reader of PX_DATUM_COLUMN buffer, expr datums point to the column data in the buffer directly.
+class ObPxDatumColumnIterator : public ObDtlMsgReader {
+public:
+  ObPxDatumColumnIterator();
+  virtual ~ObPxDatumColumnIterator();
+
+  int get_next_row(const ObIArray<ObExpr*>& exprs, ObEvalCtx& eval_ctx) override;
+  int get_next_row(common::ObNewRow& row) override
+  {
+    UNUSED(row);
+    return common::OB_ERR_UNEXPECTED;
+  }
+  void reset() override;
+
+  bool is_inited() override
+  {
+    return is_inited_;
+  }
+  bool has_next() override
+  {
+    return cur_row_ < reader_.get_rows();
+  }
+  bool is_eof()
+  {
+    return is_eof_;
+  }
+
+  bool is_iter_end() override
+  {
+    return is_iter_end_;
+  }
+
+  void set_iterator_end() override;
+  int load_buffer(const dtl::ObDtlLinkedBuffer& buffer) override;
+  void set_end() override;
+
+private:
+  bool is_eof_;
+  bool is_iter_end_;
+  int64_t cur_row_;
+  dtl::ObDtlColumnBatchReader reader_;
+  bool is_inited_;
+};
+
 class ObPxNewRow : public dtl::ObDtlMsgTemp<dtl::ObDtlMsgType::PX_NEW_ROW> {
   OB_UNIS_VERSION_V(1);
 
@@ -34,6 +34,7 @@
 #include "sql/engine/px/ob_px_sqc_async_proxy.h"
 #include "sql/engine/px/datahub/ob_dh_dtl_proc.h"
 #include "sql/engine/px/datahub/components/ob_dh_winbuf.h"
+#include "sql/engine/px/datahub/components/ob_dh_join_filter.h"
 
 namespace oceanbase {
 using namespace common;
@@ -353,6 +354,52 @@ int ObPxMsgProc::on_piece_msg(ObExecContext& ctx, const ObWinbufPieceMsg& pkt)
   return proc.on_piece_msg(coord_info_, ctx, pkt);
 }
 
+// Pieces come from the hash join dfo, but the merged filter is sent to the probe side dfo.
+// Only the SQCs which are running can receive it, the filter is an optimization only.
+int ObPxMsgProc::on_piece_msg(ObExecContext& ctx, const ObJoinFilterPieceMsg& pkt)
+{
+  int ret = OB_SUCCESS;
+  ObArray<ObPxSqcMeta*> sqcs;
+  ObArray<ObPxSqcMeta*> running_sqcs;
+  ObDfo* dfo = nullptr;
+  ObDfo* probe_dfo = nullptr;
+  ObPieceMsgCtx* piece_ctx = nullptr;
+  if (OB_FAIL(coord_info_.dfo_mgr_.find_dfo_edge(pkt.dfo_id_, dfo))) {
+    LOG_WARN("fail find dfo", K(pkt), K(ret));
+  } else if (OB_FAIL(coord_info_.dfo_mgr_.find_dfo_edge(pkt.probe_dfo_id_, probe_dfo))) {
+    LOG_WARN("fail find probe dfo", K(pkt), K(ret));
+  } else if (OB_ISNULL(dfo) || OB_ISNULL(probe_dfo)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("NULL ptr", KP(dfo), KP(probe_dfo), K(pkt), K(ret));
+  } else if (OB_FAIL(coord_info_.piece_msg_ctx_mgr_.find_piece_ctx(pkt.op_id_, piece_ctx))) {
+    if (OB_ENTRY_NOT_EXIST != ret) {
+      LOG_WARN("fail get ctx", K(pkt), K(ret));
+    } else if (OB_FAIL(ObJoinFilterPieceMsgCtx::alloc_piece_msg_ctx(
+                   pkt, ctx, dfo->get_total_task_count(), piece_ctx))) {
+      LOG_WARN("fail to alloc piece msg", K(ret));
+    } else if (OB_FAIL(coord_info_.piece_msg_ctx_mgr_.add_piece_ctx(piece_ctx))) {
+      LOG_WARN("fail add join filter piece ctx", K(ret));
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (OB_FAIL(probe_dfo->get_sqcs(sqcs))) {
+    LOG_WARN("fail get qc-sqc channel for QC", K(ret));
+  } else {
+    for (int64_t i = 0; OB_SUCC(ret) && i < sqcs.count(); i++) {
+      ObPxSqcMeta* sqc = sqcs.at(i);
+      if (sqc->is_thread_inited() && !sqc->is_thread_finish() && NULL != sqc->get_qc_channel() &&
+          OB_FAIL(running_sqcs.push_back(sqc))) {
+        LOG_WARN("array push back failed", K(ret));
+      }
+    }
+    if (OB_SUCC(ret) && OB_FAIL(ObJoinFilterPieceMsgListener::on_message(
+                            *static_cast<ObJoinFilterPieceMsgCtx*>(piece_ctx), running_sqcs, pkt))) {
+      LOG_WARN("fail process piece msg", K(pkt), K(ret));
+    }
+  }
+  return ret;
+}
+
 int ObPxMsgProc::on_eof_row(ObExecContext& ctx)
 {
   int ret = OB_SUCCESS;
@@ -590,5 +637,13 @@ int ObPxTerminateMsgProc::on_piece_msg(ObExecContext& ctx, const ObWinbufPieceMs
   return ret;
 }
 
+int ObPxTerminateMsgProc::on_piece_msg(ObExecContext& ctx, const ObJoinFilterPieceMsg& pkt)
+{
+  int ret = common::OB_SUCCESS;
+  UNUSED(ctx);
+  UNUSED(pkt);
+  return ret;
+}
+
 }  // end namespace sql
 }  // end namespace oceanbase
@@ -76,6 +76,7 @@ int ObPxSQCProxy::setup_loop_proc(ObSqcCtx& sqc_ctx) const
         .register_processor(sqc_ctx.transmit_data_ch_msg_proc_)
         .register_processor(sqc_ctx.barrier_whole_msg_proc_)
         .register_processor(sqc_ctx.winbuf_whole_msg_proc_)
+        .register_processor(sqc_ctx.join_filter_whole_msg_proc_)
         .register_interrupt_processor(sqc_ctx.interrupt_proc_);
   }
   return ret;
@@ -128,6 +129,20 @@ int ObPxSQCProxy::process_dtl_msg(int64_t timeout_ts)
   return ret;
 }
 
+int ObPxSQCProxy::process_dtl_msg_nonblock()
+{
+  int ret = OB_SUCCESS;
+  while (OB_SUCC(sqc_ctx_.msg_loop_.process_one_nonblock())) {
+    // next loop
+  }
+  if (OB_EAGAIN == ret) {
+    ret = OB_SUCCESS;
+  } else {
+    LOG_WARN("leader fail process dtl msg", K(ret));
+  }
+  return ret;
+}
+
 int ObPxSQCProxy::do_process_dtl_msg(int64_t timeout_ts)
 {
   int ret = OB_SUCCESS;
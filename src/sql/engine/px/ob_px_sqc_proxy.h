@@ -74,6 +74,12 @@ public:
   // for peek datahub whole msg
   template <class PieceMsg, class WholeMsg>
   int get_dh_msg(uint64_t op_id, const PieceMsg& piece, const WholeMsg*& whole, int64_t timeout_ts);
+  // send piece msg only, for the operators which do not wait for the whole msg
+  template <class PieceMsg>
+  int send_dh_msg(const PieceMsg& piece, int64_t timeout_ts);
+  // return OB_EAGAIN immediately if the whole msg is not arrived yet
+  template <class WholeMsg>
+  int get_dh_msg_nonblock(uint64_t op_id, const WholeMsg*& whole, int64_t timeout_ts);
 
   int report_task_finish_status(int64_t task_idx, int rc);
 
@@ -111,6 +117,7 @@ private:
   /* functions */
   int setup_loop_proc(ObSqcCtx& sqc_ctx) const;
   int process_dtl_msg(int64_t timeout_ts);
+  int process_dtl_msg_nonblock();
   int do_process_dtl_msg(int64_t timeout_ts);
   int link_sqc_qc_channel(ObPxRpcInitSqcArgs& sqc_arg);
   int unlink_sqc_qc_channel(ObPxRpcInitSqcArgs& sqc_arg);
@@ -136,21 +143,9 @@ int ObPxSQCProxy::get_dh_msg(uint64_t op_id, const PieceMsg& piece, const WholeM
   if (OB_FAIL(get_whole_msg_provider(op_id, provider))) {
     SQL_LOG(WARN, "fail get provider", K(ret));
   } else {
-    {
-      ObLockGuard<ObSpinLock> lock_guard(dtl_lock_);
-      // TODO: LOCK sqc channel
-      dtl::ObDtlChannel* ch = sqc_arg_.sqc_.get_sqc_channel();
-      if (OB_ISNULL(ch)) {
-        ret = common::OB_ERR_UNEXPECTED;
-        SQL_LOG(WARN, "empty channel", K(ret));
-      } else if (OB_FAIL(ch->send(piece, timeout_ts))) {
-        SQL_LOG(WARN, "fail push data to channel", K(ret));
-      } else if (OB_FAIL(ch->flush())) {
-        SQL_LOG(WARN, "fail flush dtl data", K(ret));
-      }
-    }
-
-    if (OB_SUCC(ret)) {
+    if (OB_FAIL(send_dh_msg(piece, timeout_ts))) {
+      SQL_LOG(WARN, "fail send piece msg", K(ret));
+    } else {
       typename WholeMsg::WholeMsgProvider* p = static_cast<typename WholeMsg::WholeMsgProvider*>(provider);
       int64_t wait_count = 0;
       do {
@@ -180,6 +175,54 @@ int ObPxSQCProxy::get_dh_msg(uint64_t op_id, const PieceMsg& piece, const WholeM
   return ret;
 }
 
+template <class PieceMsg>
+int ObPxSQCProxy::send_dh_msg(const PieceMsg& piece, int64_t timeout_ts)
+{
+  int ret = common::OB_SUCCESS;
+  ObLockGuard<ObSpinLock> lock_guard(dtl_lock_);
+  // TODO: LOCK sqc channel
+  dtl::ObDtlChannel* ch = sqc_arg_.sqc_.get_sqc_channel();
+  if (OB_ISNULL(ch)) {
+    ret = common::OB_ERR_UNEXPECTED;
+    SQL_LOG(WARN, "empty channel", K(ret));
+  } else if (OB_FAIL(ch->send(piece, timeout_ts))) {
+    SQL_LOG(WARN, "fail push data to channel", K(ret));
+  } else if (OB_FAIL(ch->flush())) {
+    SQL_LOG(WARN, "fail flush dtl data", K(ret));
+  }
+  return ret;
+}
+
+template <class WholeMsg>
+int ObPxSQCProxy::get_dh_msg_nonblock(uint64_t op_id, const WholeMsg*& whole, int64_t timeout_ts)
+{
+  int ret = common::OB_SUCCESS;
+  ObPxDatahubDataProvider* provider = nullptr;
+  const dtl::ObDtlMsg* msg = nullptr;
+  if (OB_FAIL(get_whole_msg_provider(op_id, provider))) {
+    SQL_LOG(WARN, "fail get provider", K(ret));
+  } else {
+    {
+      // someone else is processing messages if the token is not held
+      ObSqcLeaderTokenGuard guard(leader_token_lock_);
+      if (guard.hold_token()) {
+        ret = process_dtl_msg_nonblock();
+      }
+    }
+    if (OB_FAIL(ret)) {
+      SQL_LOG(WARN, "fail process dtl msg", K(ret));
+    } else if (OB_FAIL(static_cast<typename WholeMsg::WholeMsgProvider*>(provider)->get_msg_nonblock(
+                   msg, timeout_ts))) {
+      if (common::OB_EAGAIN != ret) {
+        SQL_LOG(WARN, "fail get msg", K(timeout_ts), K(ret));
+      }
+    } else {
+      whole = static_cast<const WholeMsg*>(msg);
+    }
+  }
+  return ret;
+}
+
 }  // namespace sql
 }  // namespace oceanbase
 #endif /* __OB_SQL_PX_SQC_PROXY_H__ */
@@ -246,57 +246,70 @@ int ObSortOp::topn_sort_next()
   return ret;
 }
 
+int ObSortOp::init_and_sort()
+{
+  int ret = OB_SUCCESS;
+  // The name 'get_effective_tenant_id()' is really confusing. Here what we want is to account
+  // the resource usage(memory usage in this case) to a 'real' tenant rather than billing
+  // the innocent DEFAULT tenant. We should think about changing the name of this function.
+  int64_t row_count = MY_SPEC.rows_;
+  const int64_t tenant_id = ctx_.get_my_session()->get_effective_tenant_id();
+  is_first_ = false;
+  if (OB_FAIL(ObPxEstimateSizeUtil::get_px_size(&ctx_, MY_SPEC.px_est_size_factor_, MY_SPEC.rows_, row_count))) {
+    LOG_WARN("failed to get px size", K(ret));
+  } else if (NULL != MY_SPEC.topn_expr_ || NULL != MY_SPEC.topk_limit_expr_) {  // topn sort
+    OZ(topn_sort_.init(
+        tenant_id, MY_SPEC.prefix_pos_, &MY_SPEC.sort_collations_, &MY_SPEC.sort_cmp_funs_, &eval_ctx_));
+    OZ(topn_sort_.enable_normalized_key(MY_SPEC.all_exprs_));
+    read_func_ = &ObSortOp::topn_sort_next;
+    topn_sort_.set_fetch_with_ties(MY_SPEC.is_fetch_with_ties_);
+  } else if (MY_SPEC.prefix_pos_ > 0) {
+    OZ(prefix_sort_impl_.init(tenant_id,
+        MY_SPEC.prefix_pos_,
+        MY_SPEC.all_exprs_,
+        &MY_SPEC.sort_collations_,
+        &MY_SPEC.sort_cmp_funs_,
+        &eval_ctx_,
+        child_,
+        this,
+        ctx_,
+        sort_row_count_));
+    read_func_ = &ObSortOp::prefix_sort_impl_next;
+    prefix_sort_impl_.set_input_rows(row_count);
+    prefix_sort_impl_.set_input_width(MY_SPEC.width_);
+    prefix_sort_impl_.set_operator_type(MY_SPEC.type_);
+    prefix_sort_impl_.set_operator_id(MY_SPEC.id_);
+    prefix_sort_impl_.set_exec_ctx(&ctx_);
+  } else {
+    OZ(sort_impl_.init(
+        tenant_id, &MY_SPEC.sort_collations_, &MY_SPEC.sort_cmp_funs_, &eval_ctx_, MY_SPEC.is_local_merge_sort_));
+    OZ(sort_impl_.enable_normalized_key(MY_SPEC.all_exprs_));
+    read_func_ = &ObSortOp::sort_impl_next;
+    sort_impl_.set_input_rows(row_count);
+    sort_impl_.set_input_width(MY_SPEC.width_);
+    sort_impl_.set_operator_type(MY_SPEC.type_);
+    sort_impl_.set_operator_id(MY_SPEC.id_);
+    sort_impl_.set_exec_ctx(&ctx_);
+  }
+  if (OB_SUCC(ret)) {
+    if (OB_FAIL(process_sort())) {  // process sort
+      if (OB_ITER_END != ret) {
+        LOG_WARN("process sort failed", K(ret));
+      }
+    }
+  }
+  return ret;
+}
+
 int ObSortOp::inner_get_next_row()
 {
   int ret = OB_SUCCESS;
   if (OB_UNLIKELY(iter_end_)) {
     ret = OB_ITER_END;
   } else if (is_first_) {
-    // The name 'get_effective_tenant_id()' is really confusing. Here what we want is to account
-    // the resource usage(memory usage in this case) to a 'real' tenant rather than billing
-    // the innocent DEFAULT tenant. We should think about changing the name of this function.
-    int64_t row_count = MY_SPEC.rows_;
-    const int64_t tenant_id = ctx_.get_my_session()->get_effective_tenant_id();
-    is_first_ = false;
-    if (OB_FAIL(ObPxEstimateSizeUtil::get_px_size(&ctx_, MY_SPEC.px_est_size_factor_, MY_SPEC.rows_, row_count))) {
-      LOG_WARN("failed to get px size", K(ret));
-    } else if (NULL != MY_SPEC.topn_expr_ || NULL != MY_SPEC.topk_limit_expr_) {  // topn sort
-      OZ(topn_sort_.init(
-          tenant_id, MY_SPEC.prefix_pos_, &MY_SPEC.sort_collations_, &MY_SPEC.sort_cmp_funs_, &eval_ctx_));
-      read_func_ = &ObSortOp::topn_sort_next;
-      topn_sort_.set_fetch_with_ties(MY_SPEC.is_fetch_with_ties_);
-    } else if (MY_SPEC.prefix_pos_ > 0) {
-      OZ(prefix_sort_impl_.init(tenant_id,
-          MY_SPEC.prefix_pos_,
-          MY_SPEC.all_exprs_,
-          &MY_SPEC.sort_collations_,
-          &MY_SPEC.sort_cmp_funs_,
-          &eval_ctx_,
-          child_,
-          this,
-          ctx_,
-          sort_row_count_));
-      read_func_ = &ObSortOp::prefix_sort_impl_next;
-      prefix_sort_impl_.set_input_rows(row_count);
-      prefix_sort_impl_.set_input_width(MY_SPEC.width_);
-      prefix_sort_impl_.set_operator_type(MY_SPEC.type_);
-      prefix_sort_impl_.set_operator_id(MY_SPEC.id_);
-      prefix_sort_impl_.set_exec_ctx(&ctx_);
-    } else {
-      OZ(sort_impl_.init(
-          tenant_id, &MY_SPEC.sort_collations_, &MY_SPEC.sort_cmp_funs_, &eval_ctx_, MY_SPEC.is_local_merge_sort_));
-      read_func_ = &ObSortOp::sort_impl_next;
-      sort_impl_.set_input_rows(row_count);
-      sort_impl_.set_input_width(MY_SPEC.width_);
-      sort_impl_.set_operator_type(MY_SPEC.type_);
-      sort_impl_.set_operator_id(MY_SPEC.id_);
-      sort_impl_.set_exec_ctx(&ctx_);
-    }
-    if (OB_SUCC(ret)) {
-      if (OB_FAIL(process_sort())) {  // process sort
-        if (OB_ITER_END != ret) {
-          LOG_WARN("process sort failed", K(ret));
-        }
+    if (OB_FAIL(init_and_sort())) {
+      if (OB_ITER_END != ret) {
+        LOG_WARN("init and sort failed", K(ret));
       }
     }
   }
@@ -318,5 +331,65 @@ int ObSortOp::inner_get_next_row()
   return ret;
 }
 
+// Only plain sort (no topn, no prefix sort, no local merge sort) is vectorized, see
+// ObCodeGenerator::check_vectorizable(). Child rows are added row by row, sorted rows
+// are projected to the batch datums of %all_exprs_.
+int ObSortOp::inner_get_next_batch(const int64_t max_row_cnt)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(iter_end_)) {
+    brs_.size_ = 0;
+    brs_.end_ = true;
+  } else if (is_first_) {
+    if (OB_FAIL(init_and_sort())) {
+      if (OB_ITER_END != ret) {
+        LOG_WARN("init and sort failed", K(ret));
+      }
+    }
+  }
+
+  if (OB_SUCC(ret) && !iter_end_) {
+    // Do not read beyond the last row, the sort implementation release the memory of the
+    // returned rows at iterate end. The dumped rows are only valid until next read.
+    const int64_t left_cnt = sort_row_count_ - ret_row_count_;
+    const int64_t row_cnt = std::max(std::min(sort_impl_.is_dumped() ? 1 : max_row_cnt, left_cnt), int64_t(0));
+    ObEvalCtx::BatchInfoScopeGuard batch_info_guard(eval_ctx_);
+    batch_info_guard.set_batch_size(row_cnt);
+    int64_t idx = 0;
+    for (; OB_SUCC(ret) && idx < row_cnt; idx++) {
+      batch_info_guard.set_batch_idx(idx);
+      clear_evaluated_flag();
+      if (OB_FAIL((this->*read_func_)())) {
+        LOG_WARN("get next row failed", K(ret), K(idx), K(row_cnt), K(sort_row_count_), K(ret_row_count_));
+      } else {
+        ++ret_row_count_;
+      }
+    }
+    if (OB_SUCC(ret)) {
+      brs_.size_ = idx;
+      brs_.end_ = (0 == row_cnt);
+      if (brs_.end_) {
+        iter_end_ = true;
+        reset();
+      } else {
+        FOREACH_CNT(e, MY_SPEC.all_exprs_)
+        {
+          if ((*e)->is_batch_result()) {
+            (*e)->get_eval_info(eval_ctx_).projected_ = true;
+            (*e)->get_eval_info(eval_ctx_).cnt_ = idx;
+          }
+        }
+      }
+    }
+  } else if (OB_ITER_END == ret) {
+    ret = OB_SUCCESS;
+    iter_end_ = true;
+    reset();
+    brs_.size_ = 0;
+    brs_.end_ = true;
+  }
+  return ret;
+}
+
 }  // end namespace sql
 }  // end namespace oceanbase
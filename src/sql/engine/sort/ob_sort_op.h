@@ -60,6 +60,7 @@ public:
   virtual int inner_open() override;
   virtual int rescan() override;
   virtual int inner_get_next_row() override;
+  virtual int inner_get_next_batch(const int64_t max_row_cnt) override;
   virtual void destroy() override;
   virtual int inner_close() override;
 
@@ -89,6 +90,8 @@ private:
   int get_int_value(const ObExpr* in_val, int64_t& out_val);
   int get_topn_count(int64_t& topn_cnt);
   int process_sort();
+  // init sort implementation and sort all rows of child.
+  int init_and_sort();
 
 private:
   ObSortOpImpl sort_impl_;
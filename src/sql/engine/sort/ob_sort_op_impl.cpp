@@ -15,11 +15,191 @@
 #include "ob_sort_op_impl.h"
 #include "sql/engine/ob_operator.h"
 #include "sql/engine/ob_tenant_sql_memory_manager.h"
+#include "common/object/ob_obj_compare.h"
 
 namespace oceanbase {
 using namespace common;
 namespace sql {
 
+/*********************************** start ObSortKeyNormalizer ******************************/
+int ObSortKeyNormalizer::init(const ObIArray<ObSortFieldCollation>& sort_collations, const ObIArray<ObExpr*>& exprs)
+{
+  int ret = OB_SUCCESS;
+  int64_t key_len = 0;
+  bool is_complete = true;
+  reset();
+  for (int64_t i = 0; OB_SUCC(ret) && is_complete && key_len < KEY_LEN && i < sort_collations.count(); i++) {
+    const ObSortFieldCollation& sort_collation = sort_collations.at(i);
+    if (OB_UNLIKELY(sort_collation.field_idx_ >= exprs.count()) || OB_ISNULL(exprs.at(sort_collation.field_idx_))) {
+      ret = OB_INVALID_ARGUMENT;
+      LOG_WARN("invalid sort column", K(ret), K(sort_collation), K(exprs.count()));
+    } else {
+      const ObDatumMeta& meta = exprs.at(sort_collation.field_idx_)->datum_meta_;
+      Column col;
+      col.field_idx_ = sort_collation.field_idx_;
+      col.cs_type_ = meta.cs_type_;
+      col.asc_ = sort_collation.is_ascending_;
+      col.null_first_ = (NULL_FIRST == sort_collation.null_pos_);
+      int64_t value_len = 0;
+      bool supported = true;
+      switch (ob_obj_type_class(meta.type_)) {
+        case ObIntTC:
+        case ObDateTimeTC:
+        case ObTimeTC:
+          col.kind_ = KIND_INT;
+          value_len = sizeof(int64_t);
+          break;
+        case ObUIntTC:
+          col.kind_ = KIND_UINT;
+          value_len = sizeof(uint64_t);
+          break;
+        case ObDateTC:
+          col.kind_ = KIND_DATE;
+          value_len = sizeof(int32_t);
+          break;
+        case ObYearTC:
+          col.kind_ = KIND_YEAR;
+          value_len = sizeof(uint8_t);
+          break;
+        case ObStringTC: {
+          // strings are compared with trailing spaces (strnncoll) or padded with spaces (strnncollsp),
+          // binary collation always compare with trailing spaces.
+          const bool end_space = CS_TYPE_BINARY == meta.cs_type_ ||
+                                 is_calc_with_end_space(meta.type_, meta.type_, lib::is_oracle_mode(),
+                                     meta.cs_type_, meta.cs_type_);
+          col.pad_ = end_space ? 0 : ' ';
+          value_len = KEY_LEN;
+          if (CS_TYPE_BINARY == meta.cs_type_ || CS_TYPE_UTF8MB4_BIN == meta.cs_type_) {
+            col.kind_ = KIND_BINARY_STR;
+          } else if (CS_TYPE_UTF8MB4_GENERAL_CI == meta.cs_type_) {
+            col.kind_ = KIND_WEIGHT_STR;
+          } else {
+            supported = false;
+          }
+          break;
+        }
+        default:
+          supported = false;
+          break;
+      }
+      if (!supported) {
+        is_complete = false;
+      } else if (OB_FAIL(columns_.push_back(col))) {
+        LOG_WARN("array push back failed", K(ret));
+      } else {
+        key_len += 1 + value_len;
+      }
+    }
+  }
+  if (OB_SUCC(ret)) {
+    key_len_ = std::min(key_len, KEY_LEN);
+    is_complete_ = is_complete && key_len <= KEY_LEN && columns_.count() == sort_collations.count();
+    LOG_TRACE("init sort key normalizer", K(*this));
+  } else {
+    reset();
+  }
+  return ret;
+}
+
+int64_t ObSortKeyNormalizer::encode_column(
+    const Column& col, const ObDatum& datum, uint8_t* buf, int64_t len, bool& is_valid) const
+{
+  // enough for the longest weight string of the key: (KEY_LEN - 1) weight bytes and a truncated character
+  uint8_t col_buf[KEY_LEN * 2];
+  int64_t col_len = 1;
+  MEMSET(col_buf, 0, sizeof(col_buf));
+  col_buf[0] = datum.is_null() != col.null_first_ ? 1 : 0;
+  switch (col.kind_) {
+    case KIND_INT:
+    case KIND_UINT: {
+      uint64_t v = 0;
+      if (!datum.is_null()) {
+        v = KIND_INT == col.kind_ ? static_cast<uint64_t>(datum.get_int()) ^ (1UL << 63) : datum.get_uint64();
+      }
+      for (int64_t i = 0; i < 8; i++) {
+        col_buf[col_len++] = static_cast<uint8_t>(v >> (56 - i * 8));
+      }
+      break;
+    }
+    case KIND_DATE: {
+      const uint32_t v = datum.is_null() ? 0 : (static_cast<uint32_t>(datum.get_date()) ^ (1U << 31));
+      for (int64_t i = 0; i < 4; i++) {
+        col_buf[col_len++] = static_cast<uint8_t>(v >> (24 - i * 8));
+      }
+      break;
+    }
+    case KIND_YEAR: {
+      col_buf[col_len++] = datum.is_null() ? 0 : datum.get_year();
+      break;
+    }
+    case KIND_BINARY_STR:
+    case KIND_WEIGHT_STR: {
+      int64_t str_len = 0;
+      if (!datum.is_null()) {
+        const ObString str = datum.get_string();
+        if (KIND_BINARY_STR == col.kind_) {
+          str_len = std::min(static_cast<int64_t>(str.length()), len - 1);
+          MEMCPY(col_buf + 1, str.ptr(), str_len);
+        } else {
+          bool is_valid_unicode = true;
+          str_len = ObCharset::sortkey(col.cs_type_, str.ptr(), str.length(), reinterpret_cast<char*>(col_buf + 1),
+              sizeof(col_buf) - 1, is_valid_unicode);
+          is_valid = is_valid_unicode;
+        }
+      }
+      if (str_len < len - 1) {
+        MEMSET(col_buf + 1 + str_len, datum.is_null() ? 0 : col.pad_, len - 1 - str_len);
+      }
+      col_len = len;
+      break;
+    }
+    default:
+      break;
+  }
+  col_len = std::min(col_len, len);
+  if (!col.asc_) {
+    for (int64_t i = 0; i < col_len; i++) {
+      col_buf[i] = ~col_buf[i];
+    }
+  }
+  MEMCPY(buf, col_buf, col_len);
+  return col_len;
+}
+
+void ObSortKeyNormalizer::encode(const ObDatum* cells, Key& key, bool& is_valid) const
+{
+  uint8_t buf[KEY_LEN];
+  int64_t pos = 0;
+  is_valid = true;
+  MEMSET(buf, 0, sizeof(buf));
+  for (int64_t i = 0; is_valid && pos < key_len_ && i < columns_.count(); i++) {
+    const Column& col = columns_.at(i);
+    pos += encode_column(col, cells[col.field_idx_], buf + pos, key_len_ - pos, is_valid);
+  }
+  load_key(buf, key);
+}
+
+int ObSortKeyNormalizer::encode(const ObIArray<ObExpr*>& exprs, ObEvalCtx& eval_ctx, Key& key, bool& is_valid) const
+{
+  int ret = OB_SUCCESS;
+  uint8_t buf[KEY_LEN];
+  int64_t pos = 0;
+  ObDatum* datum = NULL;
+  is_valid = true;
+  MEMSET(buf, 0, sizeof(buf));
+  for (int64_t i = 0; OB_SUCC(ret) && is_valid && pos < key_len_ && i < columns_.count(); i++) {
+    const Column& col = columns_.at(i);
+    if (OB_FAIL(exprs.at(col.field_idx_)->eval(eval_ctx, datum))) {
+      LOG_WARN("failed to eval expr", K(ret));
+    } else {
+      pos += encode_column(col, *datum, buf + pos, key_len_ - pos, is_valid);
+    }
+  }
+  load_key(buf, key);
+  return ret;
+}
+/*********************************** end ObSortKeyNormalizer ********************************/
+
 /************************************* start ObSortOpImpl *********************************/
 ObSortOpImpl::Compare::Compare() : ret_(OB_SUCCESS), sort_collations_(nullptr), sort_cmp_funs_(nullptr)
 {}
@@ -245,6 +425,18 @@ void ObSortOpImpl::reuse()
   }
 }
 
+int ObSortOpImpl::enable_normalized_key(const ObIArray<ObExpr*>& exprs)
+{
+  int ret = OB_SUCCESS;
+  if (!is_inited()) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_FAIL(key_normalizer_.init(*sort_collations_, exprs))) {
+    LOG_WARN("init sort key normalizer failed", K(ret));
+  }
+  return ret;
+}
+
 void ObSortOpImpl::unregister_profile()
 {
   sql_mem_processor_.unregister_profile();
@@ -262,6 +454,7 @@ void ObSortOpImpl::reset()
   sorted_ = false;
   got_first_row_ = false;
   comp_.reset();
+  key_normalizer_.reset();
   if (NULL != mem_context_) {
     if (NULL != imms_heap_) {
       imms_heap_->~IMMSHeap();
@@ -826,8 +1019,15 @@ int ObSortOpImpl::sort_inmem_data()
           }
         }
       }
-      std::sort(&rows_.at(begin), &rows_.at(0) + rows_.count(), CopyableComparer(comp_));
-      if (OB_SUCCESS != comp_.ret_) {
+      bool sorted = false;
+      if (key_normalizer_.is_enabled() && rows_.count() - begin >= ObSortKeyNormalizer::RADIX_SORT_MIN_ROW_CNT &&
+          OB_FAIL(normalized_sort(begin, sorted))) {
+        LOG_WARN("normalized sort failed", K(ret));
+      } else if (!sorted) {
+        std::sort(&rows_.at(begin), &rows_.at(0) + rows_.count(), CopyableComparer(comp_));
+      }
+      if (OB_FAIL(ret)) {
+      } else if (OB_SUCCESS != comp_.ret_) {
         ret = comp_.ret_;
         LOG_WARN("compare failed", K(ret));
       }
@@ -870,6 +1070,43 @@ int ObSortOpImpl::sort_inmem_data()
   return ret;
 }
 
+// Sort rows_[begin, count) by normalized key, %sorted is false if any row can not be encoded
+// or no memory for the keys, the caller should sort by compare functions then.
+int ObSortOpImpl::normalized_sort(const int64_t begin, bool& sorted)
+{
+  int ret = OB_SUCCESS;
+  sorted = false;
+  const int64_t cnt = rows_.count() - begin;
+  ObIAllocator& alloc = mem_context_->get_malloc_allocator();
+  ObSortKeyNormalizer::Item* items = NULL;
+  if (cnt <= 0) {
+    // do nothing
+  } else if (OB_ISNULL(items = static_cast<ObSortKeyNormalizer::Item*>(
+                           alloc.alloc(sizeof(ObSortKeyNormalizer::Item) * cnt * 2)))) {
+    LOG_TRACE("no memory for normalized keys, sort by compare functions", K(cnt));
+  } else {
+    bool is_valid = true;
+    for (int64_t i = 0; is_valid && i < cnt; i++) {
+      ObChunkDatumStore::StoredRow* sr = rows_.at(begin + i);
+      if (OB_ISNULL(sr)) {
+        is_valid = false;
+      } else {
+        key_normalizer_.encode(sr->cells(), items[i].key_, is_valid);
+        items[i].row_ = sr;
+      }
+    }
+    if (is_valid) {
+      key_normalizer_.sort(items, items + cnt, cnt, comp_);
+      for (int64_t i = 0; i < cnt; i++) {
+        rows_.at(begin + i) = items[i].row_;
+      }
+      sorted = true;
+    }
+    alloc.free(items);
+  }
+  return ret;
+}
+
 int ObSortOpImpl::sort()
 {
   int ret = OB_SUCCESS;
@@ -1062,6 +1299,8 @@ int ObPrefixSortImpl::init(const int64_t tenant_id, const int64_t prefix_pos,
     sort_row_count_ = &sort_row_cnt;
     if (OB_FAIL(ObSortOpImpl::init(tenant_id, &base_sort_collations_, &base_sort_cmp_funs_, eval_ctx))) {
       LOG_WARN("sort impl init failed", K(ret));
+    } else if (OB_FAIL(enable_normalized_key(all_exprs))) {
+      LOG_WARN("enable normalized key failed", K(ret));
     } else if (OB_FAIL(next_prefix_row_store_.init(mem_context_->get_malloc_allocator(), all_exprs.count()))) {
       LOG_WARN("failed to init next prefix row store", K(ret));
     } else if (OB_FAIL(fetch_rows(all_exprs))) {
@@ -1329,6 +1568,7 @@ void ObInMemoryTopnSortImpl::reset()
   sort_collations_ = nullptr;
   sort_cmp_funs_ = nullptr;
   eval_ctx_ = nullptr;
+  key_normalizer_.reset();
   heap_.reset();
   cur_alloc_.reset();
   is_fetch_with_ties_ = false;
@@ -1369,6 +1609,18 @@ int ObInMemoryTopnSortImpl::init(const int64_t tenant_id, const int64_t prefix_p
   return ret;
 }
 
+int ObInMemoryTopnSortImpl::enable_normalized_key(const common::ObIArray<ObExpr*>& exprs)
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(sort_collations_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_FAIL(key_normalizer_.init(*sort_collations_, exprs))) {
+    LOG_WARN("init sort key normalizer failed", K(ret));
+  }
+  return ret;
+}
+
 int ObInMemoryTopnSortImpl::check_block_row(
     const common::ObIArray<ObExpr*>& exprs, const SortStoredRow* last_row, bool& is_cur_block)
 {
@@ -1440,6 +1692,7 @@ int ObInMemoryTopnSortImpl::add_row(const common::ObIArray<ObExpr*>& exprs, bool
         if (OB_FAIL(new_row->copy_datums(
                 exprs, *eval_ctx_, buf + pos, buffer_len - STORE_ROW_HEADER_SIZE, row_size, STORE_ROW_EXTRA_SIZE))) {
           LOG_WARN("failed to deep copy row", K(ret), K(buffer_len));
+        } else if (FALSE_IT(set_row_key(*new_row))) {
         } else if (OB_FAIL(heap_.push(new_row))) {
           LOG_WARN("failed to push back row", K(ret), K(buffer_len));
         } else {
@@ -1463,7 +1716,10 @@ int ObInMemoryTopnSortImpl::adjust_topn_heap(const common::ObIArray<ObExpr*>& ex
     ret = OB_ERR_UNEXPECTED;
     LOG_WARN("unexpected error.top of the heap is NULL", K(ret), K(topn_sort_array_pos_), K(heap_.count()));
   } else if (!heap_.empty()) {
-    if (cmp_(&exprs, heap_.top(), *eval_ctx_)) {
+    bool less = false;
+    if (OB_FAIL(less_than_top(exprs, less))) {
+      LOG_WARN("failed to compare with heap top", K(ret));
+    } else if (less) {
       SortStoredRow* new_row = NULL;
       SortStoredRow* dt_row = heap_.top();
       char* buf = NULL;
@@ -1493,6 +1749,7 @@ int ObInMemoryTopnSortImpl::adjust_topn_heap(const common::ObIArray<ObExpr*>& ex
         if (OB_FAIL(new_row->copy_datums(
                 exprs, *eval_ctx_, buf + pos, buffer_len - STORE_ROW_HEADER_SIZE, row_size, STORE_ROW_EXTRA_SIZE))) {
           LOG_WARN("failed to deep copy row", K(ret), K(buffer_len), K(row_size));
+        } else if (FALSE_IT(set_row_key(*new_row))) {
         } else if (OB_FAIL(heap_.replace_top(new_row))) {
           LOG_WARN("failed to replace top", K(ret));
         } else {
@@ -1502,13 +1759,51 @@ int ObInMemoryTopnSortImpl::adjust_topn_heap(const common::ObIArray<ObExpr*>& ex
           //   K(buffer_len), K(row_size), K(new_row->get_max_size()));
         }
       }
-    } else {
-      ret = cmp_.ret_;
     }
   }
   return ret;
 }
 
+void ObInMemoryTopnSortImpl::set_row_key(SortStoredRow& sr)
+{
+  ObSortKeyNormalizer::Key key;
+  bool is_valid = false;
+  if (key_normalizer_.is_enabled()) {
+    key_normalizer_.encode(sr.cells(), key, is_valid);
+  }
+  sr.set_key(key, is_valid);
+}
+
+// Most rows are not less than the heap top once the heap is full, compare the normalized keys
+// first to reject them without calling the compare functions.
+int ObInMemoryTopnSortImpl::less_than_top(const common::ObIArray<ObExpr*>& exprs, bool& less)
+{
+  int ret = OB_SUCCESS;
+  const SortStoredRow* top = heap_.top();
+  bool decided = false;
+  less = false;
+  if (key_normalizer_.is_enabled() && top->get_extra_info().key_valid_) {
+    ObSortKeyNormalizer::Key key;
+    bool is_valid = false;
+    const ObSortKeyNormalizer::Key& top_key = top->get_extra_info().key_;
+    if (OB_FAIL(key_normalizer_.encode(exprs, *eval_ctx_, key, is_valid))) {
+      LOG_WARN("failed to encode normalized key", K(ret));
+    } else if (!is_valid) {
+      // compare by compare functions
+    } else if (key < top_key) {
+      less = true;
+      decided = true;
+    } else if (top_key < key || key_normalizer_.is_complete()) {
+      decided = true;
+    }
+  }
+  if (OB_SUCC(ret) && !decided) {
+    less = cmp_(&exprs, top, *eval_ctx_);
+    ret = cmp_.ret_;
+  }
+  return ret;
+}
+
 int ObInMemoryTopnSortImpl::sort_rows()
 {
   int ret = OB_SUCCESS;
@@ -1520,7 +1815,29 @@ int ObInMemoryTopnSortImpl::sort_rows()
   } else {
     LOG_DEBUG("in memory topn sort check topn heap", K_(heap));
     SortStoredRow** first_row = &heap_.top();
-    std::sort(first_row, first_row + heap_.count(), ObSortOpImpl::CopyableComparer(cmp_));
+    const int64_t cnt = heap_.count();
+    ObSortKeyNormalizer::Item* items = NULL;
+    bool is_valid = key_normalizer_.is_enabled() && cnt >= ObSortKeyNormalizer::RADIX_SORT_MIN_ROW_CNT;
+    for (int64_t i = 0; is_valid && i < cnt; i++) {
+      is_valid = first_row[i]->get_extra_info().key_valid_;
+    }
+    if (is_valid && OB_NOT_NULL(items = static_cast<ObSortKeyNormalizer::Item*>(
+                                    cur_alloc_.alloc(sizeof(ObSortKeyNormalizer::Item) * cnt * 2)))) {
+      for (int64_t i = 0; i < cnt; i++) {
+        items[i].key_ = first_row[i]->get_extra_info().key_;
+        items[i].row_ = first_row[i];
+      }
+      key_normalizer_.sort(items, items + cnt, cnt, cmp_);
+      for (int64_t i = 0; i < cnt; i++) {
+        first_row[i] = static_cast<SortStoredRow*>(items[i].row_);
+      }
+    } else {
+      std::sort(first_row, first_row + cnt, ObSortOpImpl::CopyableComparer(cmp_));
+    }
+    if (OB_SUCCESS != cmp_.ret_) {
+      ret = cmp_.ret_;
+      LOG_WARN("compare failed", K(ret));
+    }
   }
   return ret;
 }
@@ -35,6 +35,167 @@ private:
   DISALLOW_COPY_AND_ASSIGN(ObSortOpChunk);
 };
 
+/*
+ * Normalized sort key: memcmp comparable encoding of the leading sort columns, so that
+ * most comparisons are done by comparing two integers instead of calling the compare
+ * function of each sort column.
+ *
+ * Each encoded column is a null flag byte followed by the value bytes, all bytes of the
+ * column are inverted for descending order. Integers are big endian with the sign bit
+ * flipped, strings are the collation weights padded with the same byte the compare function
+ * implicitly pads with. Encoding stops at the first column which can not be encoded or does
+ * not fit in the key, rows with the same key are compared by the compare functions then.
+ */
+class ObSortKeyNormalizer {
+public:
+  static const int64_t KEY_LEN = 16;
+  // sort rows by std::sort with the normalized key for small buckets
+  static const int64_t RADIX_SORT_MIN_ROW_CNT = 64;
+
+  struct Key {
+    Key() : hi_(0), lo_(0)
+    {}
+    OB_INLINE bool operator<(const Key& other) const
+    {
+      return hi_ < other.hi_ || (hi_ == other.hi_ && lo_ < other.lo_);
+    }
+    OB_INLINE bool operator==(const Key& other) const
+    {
+      return hi_ == other.hi_ && lo_ == other.lo_;
+    }
+    OB_INLINE uint8_t byte_at(const int64_t idx) const
+    {
+      return static_cast<uint8_t>((idx < 8 ? hi_ : lo_) >> (56 - ((idx & 7) << 3)));
+    }
+    TO_STRING_KV(K_(hi), K_(lo));
+
+    uint64_t hi_;
+    uint64_t lo_;
+  };
+
+  struct Item {
+    Key key_;
+    ObChunkDatumStore::StoredRow* row_;
+  };
+
+public:
+  ObSortKeyNormalizer() : columns_(), key_len_(0), is_complete_(false)
+  {}
+  // @exprs: row exprs, the type of sort column is exprs.at(field_idx_)
+  int init(const ObIArray<ObSortFieldCollation>& sort_collations, const common::ObIArray<ObExpr*>& exprs);
+  void reset()
+  {
+    columns_.reset();
+    key_len_ = 0;
+    is_complete_ = false;
+  }
+  bool is_enabled() const
+  {
+    return key_len_ > 0;
+  }
+  // all sort columns are encoded exactly, rows with the same key are equal
+  bool is_complete() const
+  {
+    return is_complete_;
+  }
+  // @is_valid: false if the row can not be encoded (e.g.: invalid unicode string), the rows must be
+  // compared by compare functions.
+  void encode(const ObDatum* cells, Key& key, bool& is_valid) const;
+  int encode(const common::ObIArray<ObExpr*>& exprs, ObEvalCtx& eval_ctx, Key& key, bool& is_valid) const;
+
+  // MSD radix sort of %items by normalized key, rows with same key are sorted by %less.
+  // %tmp is buffer of the same count as %items.
+  template <typename Less>
+  void sort(Item* items, Item* tmp, const int64_t cnt, Less& less) const
+  {
+    radix_sort(items, tmp, cnt, 0, less);
+  }
+  TO_STRING_KV(K_(columns), K_(key_len), K_(is_complete));
+
+private:
+  enum ColumnKind {
+    KIND_INT = 0,
+    KIND_UINT,
+    KIND_DATE,
+    KIND_YEAR,
+    KIND_BINARY_STR,  // compare bytes directly
+    KIND_WEIGHT_STR,  // compare collation weights
+  };
+  struct Column {
+    Column() : field_idx_(0), kind_(KIND_INT), cs_type_(common::CS_TYPE_INVALID), pad_(0), asc_(true), null_first_(true)
+    {}
+    TO_STRING_KV(K_(field_idx), K_(kind), K_(cs_type), K_(pad), K_(asc), K_(null_first));
+
+    int64_t field_idx_;
+    ColumnKind kind_;
+    common::ObCollationType cs_type_;
+    uint8_t pad_;
+    bool asc_;
+    bool null_first_;
+  };
+
+  int64_t encode_column(const Column& col, const ObDatum& datum, uint8_t* buf, int64_t len, bool& is_valid) const;
+  static OB_INLINE void load_key(const uint8_t* buf, Key& key)
+  {
+    key.hi_ = 0;
+    key.lo_ = 0;
+    for (int64_t i = 0; i < 8; i++) {
+      key.hi_ = (key.hi_ << 8) | buf[i];
+      key.lo_ = (key.lo_ << 8) | buf[i + 8];
+    }
+  }
+  template <typename Less>
+  void radix_sort(Item* items, Item* tmp, const int64_t cnt, const int64_t byte_idx, Less& less) const;
+
+private:
+  common::ObSEArray<Column, 4> columns_;
+  int64_t key_len_;
+  bool is_complete_;
+};
+
+template <typename Less>
+void ObSortKeyNormalizer::radix_sort(
+    Item* items, Item* tmp, const int64_t cnt, const int64_t byte_idx, Less& less) const
+{
+  if (cnt <= 1) {
+    // do nothing
+  } else if (byte_idx >= key_len_) {
+    // all keys are the same
+    if (!is_complete_) {
+      std::sort(items, items + cnt, [&](const Item& l, const Item& r) { return less(l.row_, r.row_); });
+    }
+  } else if (cnt < RADIX_SORT_MIN_ROW_CNT) {
+    std::sort(items, items + cnt, [&](const Item& l, const Item& r) {
+      return l.key_ < r.key_ || (!is_complete_ && l.key_ == r.key_ && less(l.row_, r.row_));
+    });
+  } else {
+    // bucket counts, then the begin position of each bucket, which becomes the end position after scatter
+    int64_t offsets[UINT8_MAX + 2];
+    MEMSET(offsets, 0, sizeof(offsets));
+    for (int64_t i = 0; i < cnt; i++) {
+      offsets[items[i].key_.byte_at(byte_idx) + 1] += 1;
+    }
+    if (cnt == offsets[items[0].key_.byte_at(byte_idx) + 1]) {
+      // only one bucket, go to the next byte directly
+      radix_sort(items, tmp, cnt, byte_idx + 1, less);
+    } else {
+      for (int64_t i = 1; i <= UINT8_MAX + 1; i++) {
+        offsets[i] += offsets[i - 1];
+      }
+      for (int64_t i = 0; i < cnt; i++) {
+        tmp[offsets[items[i].key_.byte_at(byte_idx)]++] = items[i];
+      }
+      MEMCPY(items, tmp, sizeof(Item) * cnt);
+      for (int64_t i = 0; i <= UINT8_MAX; i++) {
+        const int64_t begin = 0 == i ? 0 : offsets[i - 1];
+        if (offsets[i] - begin > 1) {
+          radix_sort(items + begin, tmp + begin, offsets[i] - begin, byte_idx + 1, less);
+        }
+      }
+    }
+  }
+}
+
 /*
  * Sort rows, do in memory sort if memory can hold all rows, otherwise do disk sort.
  * Prefix sorting is not supported it can be implemented by by simply wrapping ObSortOpImpl.
@@ -133,6 +294,12 @@ public:
     return inited_;
   }
 
+  // Rows are dumped to disk, the row returned by get_next_row() is valid only until the next call.
+  bool is_dumped() const
+  {
+    return !sort_chunks_.is_empty();
+  }
+
   void set_input_rows(int64_t input_rows)
   {
     input_rows_ = input_rows;
@@ -158,6 +325,10 @@ public:
 
   void unregister_profile();
 
+  // Sort in-memory rows by normalized key of the leading sort columns if possible,
+  // must be called after init().
+  int enable_normalized_key(const common::ObIArray<ObExpr*>& exprs);
+
   class Compare {
   public:
     Compare();
@@ -247,6 +418,7 @@ protected:
     return rows_.count() > datum_store_.get_row_cnt();
   }
   int sort_inmem_data();
+  int normalized_sort(const int64_t begin, bool& sorted);
   int do_dump();
   template <typename Input>
   int build_chunk(const int64_t level, Input& input);
@@ -309,6 +481,7 @@ protected:
   ObPhyOperatorType op_type_;
   uint64_t op_id_;
   ObExecContext* exec_ctx_;
+  ObSortKeyNormalizer key_normalizer_;
 };
 
 class ObPrefixSortImpl : public ObSortOpImpl {
@@ -400,6 +573,8 @@ public:
       const ObIArray<ObSortCmpFunc>* sort_cmp_funs, ObEvalCtx* eval_ctx);
   virtual void reset();
   virtual void reuse();
+  // compare rows with heap top by normalized key first if possible, must be called after init().
+  int enable_normalized_key(const common::ObIArray<ObExpr*>& exprs);
   virtual int add_row(const common::ObIArray<ObExpr*>& exprs, bool& need_sort);
   virtual int sort_rows();
   virtual int get_next_row(const common::ObIArray<ObExpr*>& exprs);
@@ -435,6 +610,8 @@ private:
   struct SortStoredRow : public ObChunkDatumStore::StoredRow {
     struct ExtraInfo {
       uint64_t max_size_;
+      uint64_t key_valid_;
+      ObSortKeyNormalizer::Key key_;
     };
     ExtraInfo& get_extra_info()
     {
@@ -455,10 +632,17 @@ private:
     {
       get_extra_info().max_size_ = max_size;
     }
+    inline void set_key(const ObSortKeyNormalizer::Key& key, const bool is_valid)
+    {
+      get_extra_info().key_ = key;
+      get_extra_info().key_valid_ = is_valid;
+    }
   };
 
 private:
   int adjust_topn_heap(const common::ObIArray<ObExpr*>& exprs);
+  void set_row_key(SortStoredRow& sr);
+  int less_than_top(const common::ObIArray<ObExpr*>& exprs, bool& less);
   int convert_row(const SortStoredRow* sr, const common::ObIArray<ObExpr*>& exprs);
   int check_block_row(const common::ObIArray<ObExpr*>& exprs, const SortStoredRow* last_row, bool& is_cur_block);
   bool has_prefix_pos()
@@ -468,7 +652,7 @@ private:
 
 private:
   static const int64_t STORE_ROW_HEADER_SIZE = sizeof(SortStoredRow);
-  static const int64_t STORE_ROW_EXTRA_SIZE = sizeof(uint64_t);
+  static const int64_t STORE_ROW_EXTRA_SIZE = sizeof(SortStoredRow::ExtraInfo);
   // data members
   int64_t prefix_pos_;
   int64_t topn_cnt_;
@@ -480,6 +664,7 @@ private:
   const ObIArray<ObSortCmpFunc>* sort_cmp_funs_;
   ObEvalCtx* eval_ctx_;
   ObSortOpImpl::Compare cmp_;
+  ObSortKeyNormalizer key_normalizer_;
   common::ObArenaAllocator cur_alloc_;  // deep copy current block row
   common::ObBinaryHeap<SortStoredRow*, ObSortOpImpl::Compare> heap_;
   DISALLOW_COPY_AND_ASSIGN(ObInMemoryTopnSortImpl);
@@ -499,6 +499,7 @@ int ObTableScan::prepare_scan_param(ObExecContext& ctx) const
     scan_ctx->scan_param_.timeout_ = plan_ctx->get_ps_timeout_timestamp();
     scan_ctx->scan_param_.scan_flag_.flag_ = flags_;
     scan_ctx->scan_param_.scan_flag_.is_large_query_ = plan_ctx->is_large_query();
+    scan_ctx->scan_param_.scan_flag_.is_bulk_read_ = plan_ctx->is_large_query();
     set_cache_stat(plan_ctx->get_phy_plan()->stat_, scan_ctx->scan_param_);
     scan_ctx->scan_param_.reserved_cell_count_ = column_count_;
     // Storage engine convention: if for_update_wait_us_>0,
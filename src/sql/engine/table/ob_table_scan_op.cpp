@@ -20,6 +20,7 @@
 #include "storage/ob_table_scan_iterator.h"
 #include "observer/ob_server_struct.h"
 #include "observer/ob_server.h"
+#include "sql/engine/join/ob_hash_join_op.h"
 
 namespace oceanbase {
 using namespace common;
@@ -226,7 +227,8 @@ ObTableScanSpec::ObTableScanSpec(ObIAllocator& alloc, const ObPhyOperatorType ty
       batch_scan_flag_(false),
       pd_storage_flag_(false),
       pd_storage_filters_(alloc),
-      pd_storage_index_back_filters_(alloc)
+      pd_storage_index_back_filters_(alloc),
+      join_filter_info_(alloc)
 {}
 
 OB_SERIALIZE_MEMBER((ObTableScanSpec, ObOpSpec), ref_table_id_, index_id_, table_location_key_, is_index_global_,
@@ -239,7 +241,7 @@ OB_SERIALIZE_MEMBER((ObTableScanSpec, ObOpSpec), ref_table_id_, index_id_, table
     gi_above_, expected_part_id_, need_scn_, batch_scan_flag_, part_dep_cols_, subpart_dep_cols_, is_vt_mapping_,
     use_real_tenant_id_, has_tenant_id_col_, vt_table_id_, real_schema_version_, mapping_exprs_, output_row_types_,
     key_types_, key_with_tenant_ids_, has_extra_tenant_ids_, org_output_column_ids_, pd_storage_flag_,
-    pd_storage_filters_, pd_storage_index_back_filters_);
+    pd_storage_filters_, pd_storage_index_back_filters_, join_filter_info_);
 
 DEF_TO_STRING(ObTableScanSpec)
 {
@@ -452,7 +454,11 @@ ObTableScanOp::ObTableScanOp(ObExecContext& exec_ctx, const ObOpSpec& spec, ObOp
           exec_ctx.get_my_session()->get_effective_tenant_id()),
       filter_executor_(nullptr),
       index_back_filter_executor_(nullptr),
-      cur_trace_id_(nullptr)
+      cur_trace_id_(nullptr),
+      batch_datums_(NULL),
+      batch_alloc_(ObModIds::OB_SQL_TABLE_SCAN_CTX, OB_MALLOC_NORMAL_BLOCK_SIZE,
+          exec_ctx.get_my_session()->get_effective_tenant_id()),
+      join_filter_ctx_()
 {
   scan_param_.partition_guard_ = &partition_guard_;
 }
@@ -529,6 +535,8 @@ int ObTableScanOp::prepare_scan_param()
                                 : MY_SPEC.index_id_;
     scan_param_.timeout_ = plan_ctx->get_ps_timeout_timestamp();
     scan_param_.scan_flag_.flag_ = MY_SPEC.flags_;
+    scan_param_.scan_flag_.is_large_query_ = plan_ctx->is_large_query();
+    scan_param_.scan_flag_.is_bulk_read_ = plan_ctx->is_large_query();
     set_cache_stat(plan_ctx->get_phy_plan()->stat_, scan_param_);
     scan_param_.reserved_cell_count_ = MY_SPEC.output_column_ids_.count();
     scan_param_.for_update_ = MY_SPEC.for_update_;
@@ -840,6 +848,8 @@ int ObTableScanOp::inner_open()
   MY_INPUT.set_location_idx(0);
   if (OB_FAIL(init_old_expr_ctx())) {
     LOG_WARN("init old expr ctx failed", K(ret));
+  } else if (OB_FAIL(init_batch_datums())) {
+    LOG_WARN("init batch datums failed", K(ret));
   } else if (OB_FAIL(init_table_allocator())) {
     LOG_WARN("init table allocator failed", K(ret));
   } else if (OB_UNLIKELY(partition_list_is_empty(task_exec_ctx.get_table_locations()))) {
@@ -868,6 +878,19 @@ int ObTableScanOp::inner_open()
   return ret;
 }
 
+int ObTableScanOp::init_batch_datums()
+{
+  int ret = OB_SUCCESS;
+  if (MY_SPEC.is_vectorized() && !MY_SPEC.storage_output_.empty() && NULL == batch_datums_) {
+    const int64_t size = sizeof(ObDatum) * MY_SPEC.storage_output_.count() * MY_SPEC.max_batch_size_;
+    if (OB_ISNULL(batch_datums_ = static_cast<ObDatum*>(ctx_.get_allocator().alloc(size)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("allocate memory failed", K(ret), K(size));
+    }
+  }
+  return ret;
+}
+
 int ObTableScanOp::init_old_expr_ctx()
 {
   int ret = OB_SUCCESS;
@@ -949,6 +972,7 @@ int ObTableScanOp::inner_close()
 void ObTableScanOp::destroy()
 {
   expr_ctx_alloc_.reset();
+  batch_alloc_.reset();
   row2exprs_projector_.destroy();
   scan_param_.destroy_schema_guard();
   schema_guard_.~ObSchemaGetterGuard();
@@ -1047,6 +1071,11 @@ int ObTableScanOp::rescan()
   } else {
     ret = rt_rescan();
   }
+  if (OB_SUCC(ret)) {
+    reset_batch_rows();
+    // the hash join rebuilds its filter on rescan
+    join_filter_ctx_.reset();
+  }
   return ret;
 }
 
@@ -1246,6 +1275,7 @@ int ObTableScanOp::switch_iterator()
   if (OB_SUCC(ret)) {
     startup_passed_ = MY_SPEC.startup_filters_.empty();
     iter_end_ = false;
+    reset_batch_rows();
   }
   return ret;
 }
@@ -1327,12 +1357,43 @@ int ObTableScanOp::group_rescan()
 int ObTableScanOp::get_next_row_with_mode()
 {
   int ret = OB_SUCCESS;
-  if (MY_SPEC.is_vt_mapping_) {
-    // switch to mysql mode
-    CompatModeGuard g(ObWorker::CompatMode::MYSQL);
-    ret = result_->get_next_row();
-  } else {
-    ret = result_->get_next_row();
+  bool is_filtered = false;
+  do {
+    if (MY_SPEC.is_vt_mapping_) {
+      // switch to mysql mode
+      CompatModeGuard g(ObWorker::CompatMode::MYSQL);
+      ret = result_->get_next_row();
+    } else {
+      ret = result_->get_next_row();
+    }
+    if (OB_SUCC(ret) && MY_SPEC.join_filter_info_.is_valid() && OB_FAIL(check_join_filter(is_filtered))) {
+      LOG_WARN("failed to check join filter", K(ret));
+    }
+  } while (OB_SUCC(ret) && is_filtered);
+  return ret;
+}
+
+// rows which can not be joined are skipped before returned to the hash join
+int ObTableScanOp::check_join_filter(bool& is_filtered)
+{
+  int ret = OB_SUCCESS;
+  is_filtered = false;
+  if (!join_filter_ctx_.is_attached()) {
+    ObOperatorKit* kit = ctx_.get_operator_kit(MY_SPEC.join_filter_info_.filter_id_);
+    if (OB_ISNULL(kit) || OB_ISNULL(kit->op_) || OB_UNLIKELY(PHY_HASH_JOIN != kit->op_->get_spec().type_)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("join filter builder not found", K(ret), K(MY_SPEC.join_filter_info_));
+    } else {
+      // NULL if the build side is not finished yet
+      join_filter_ctx_.attach(static_cast<ObHashJoinOp*>(kit->op_)->get_join_filter());
+    }
+  }
+  if (OB_SUCC(ret) && join_filter_ctx_.is_active()) {
+    if (OB_FAIL(join_filter_ctx_.check(MY_SPEC.join_filter_info_, eval_ctx_, is_filtered))) {
+      LOG_WARN("failed to check join filter", K(ret));
+    } else if (is_filtered) {
+      clear_evaluated_flag();
+    }
   }
   return ret;
 }
@@ -1400,6 +1461,61 @@ int ObTableScanOp::inner_get_next_row()
   return ret;
 }
 
+int ObTableScanOp::inner_get_next_batch(const int64_t max_row_cnt)
+{
+  int ret = OB_SUCCESS;
+  const ExprFixedArray& exprs = MY_SPEC.storage_output_;
+  int64_t row_cnt = 0;
+  bool iter_end = false;
+  batch_alloc_.reuse();
+  for (int64_t i = 0; i < exprs.count(); i++) {
+    // virtual column may be evaluated in storage, make sure it's not skipped.
+    exprs.at(i)->get_eval_info(eval_ctx_).projected_ = false;
+  }
+  {
+    // Storage project row to the datums of batch index 0 (datums are cached in
+    // row2exprs_projector_), deep copy to the columnar datums after each row fetched.
+    ObEvalCtx::BatchInfoScopeGuard guard(eval_ctx_);
+    guard.set_batch_idx(0);
+    guard.set_batch_size(1);
+    ObDatum* datum = NULL;
+    while (OB_SUCC(ret) && !iter_end && row_cnt < max_row_cnt) {
+      if (OB_FAIL(inner_get_next_row())) {
+        if (OB_ITER_END != ret) {
+          LOG_WARN("get next row failed", K(ret));
+        } else {
+          ret = OB_SUCCESS;
+          iter_end = true;
+        }
+      } else {
+        for (int64_t i = 0; OB_SUCC(ret) && i < exprs.count(); i++) {
+          ObDatum& dst = batch_datums_[i * MY_SPEC.max_batch_size_ + row_cnt];
+          if (OB_FAIL(exprs.at(i)->eval(eval_ctx_, datum))) {
+            LOG_WARN("expr evaluate failed", K(ret), K(i));
+          } else if (OB_FAIL(dst.deep_copy(*datum, batch_alloc_))) {
+            LOG_WARN("deep copy datum failed", K(ret), K(i));
+          }
+        }
+        row_cnt++;
+      }
+    }
+  }
+  if (OB_SUCC(ret)) {
+    // project columnar datums to the batch result expressions
+    for (int64_t i = 0; i < exprs.count(); i++) {
+      ObExpr* e = exprs.at(i);
+      const ObDatum* src = batch_datums_ + i * MY_SPEC.max_batch_size_;
+      MEMCPY(e->locate_batch_datums(eval_ctx_), src, sizeof(ObDatum) * row_cnt);
+      ObEvalInfo& info = e->get_eval_info(eval_ctx_);
+      info.projected_ = true;
+      info.cnt_ = row_cnt;
+    }
+    brs_.size_ = row_cnt;
+    brs_.end_ = iter_end;
+  }
+  return ret;
+}
+
 int ObTableScanOp::calc_expr_int_value(const ObExpr& expr, int64_t& retval, bool& is_null_value)
 {
   int ret = OB_SUCCESS;
@@ -24,6 +24,7 @@
 #include "share/ob_i_sql_expression.h"
 #include "sql/ob_sql_mock_schema_utils.h"
 #include "sql/engine/basic/ob_pushdown_filter.h"
+#include "sql/engine/px/datahub/components/ob_dh_join_filter.h"
 
 namespace oceanbase {
 namespace common {
@@ -237,6 +238,8 @@ public:
   int32_t pd_storage_flag_;
   ObPushdownFilter pd_storage_filters_;
   ObPushdownFilter pd_storage_index_back_filters_;
+  // runtime join filter built by the hash join above in the same thread
+  ObJoinFilterUseInfo join_filter_info_;
 };
 
 class ObTableScanOp : public ObOperator {
@@ -251,6 +254,7 @@ public:
   int switch_iterator() override;
   int bnl_switch_iterator();
   int inner_get_next_row() override;
+  int inner_get_next_batch(const int64_t max_row_cnt) override;
   int inner_close() override;
   void destroy() override;
 
@@ -309,6 +313,8 @@ protected:
 
   // TODO : to be removed after expr_ctx_ not needed.
   int init_old_expr_ctx();
+  // allocate columnar datums for vectorized execution
+  int init_batch_datums();
 
   int prune_query_range_by_partition_id(common::ObIArray<common::ObNewRange>& scan_ranges);
   int can_prune_by_partition_id(share::schema::ObSchemaGetterGuard& schema_guard, const int64_t partition_id,
@@ -325,6 +331,7 @@ protected:
 
 private:
   int get_next_row_with_mode();
+  int check_join_filter(bool& is_filtered);
 
 protected:
   common::ObNewRowIterator* result_;
@@ -357,6 +364,13 @@ protected:
   ObPushdownFilterExecutor* index_back_filter_executor_;
 
   const uint64_t* cur_trace_id_;
+
+  // Columnar datums of storage_output_ for vectorized execution, datums of the i-th
+  // expression are stored in [i * max_batch_size_, (i + 1) * max_batch_size_).
+  common::ObDatum* batch_datums_;
+  // Deep copy memory of %batch_datums_, reused for every batch.
+  common::ObArenaAllocator batch_alloc_;
+  ObJoinFilterProbeCtx join_filter_ctx_;
 };
 
 }  // end namespace sql
@@ -0,0 +1,321 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_PC
+#include "sql/plan_cache/ob_fast_parser_cache.h"
+#include "common/data_buffer.h"
+#include "lib/hash_func/murmur_hash.h"
+
+namespace oceanbase {
+using namespace common;
+namespace sql {
+
+static inline int64_t fp_cache_align(const int64_t size)
+{
+  return (size + 7) & ~7L;
+}
+
+ObFastParserCache::ObFastParserCache()
+    : is_inited_(false), allocator_(NULL), slots_(NULL), entry_cnt_(0), hit_cnt_(0), access_cnt_(0)
+{}
+
+ObFastParserCache::~ObFastParserCache()
+{
+  destroy();
+}
+
+int ObFastParserCache::init(ObIAllocator& allocator)
+{
+  int ret = OB_SUCCESS;
+  void* buf = NULL;
+  if (OB_UNLIKELY(is_inited_)) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("fast parser cache has been inited", K(ret));
+  } else if (OB_ISNULL(buf = allocator.alloc(sizeof(Slot) * SLOT_CNT))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to alloc fast parser cache slots", K(ret));
+  } else {
+    slots_ = static_cast<Slot*>(buf);
+    for (int64_t i = 0; i < SLOT_CNT; ++i) {
+      Slot* slot = new (&slots_[i]) Slot();
+      slot->entry_ = NULL;
+      slot->missed_hash_ = 0;
+    }
+    allocator_ = &allocator;
+    is_inited_ = true;
+  }
+  return ret;
+}
+
+void ObFastParserCache::destroy()
+{
+  if (is_inited_) {
+    clear();
+    for (int64_t i = 0; i < SLOT_CNT; ++i) {
+      slots_[i].~Slot();
+    }
+    allocator_->free(slots_);
+    slots_ = NULL;
+    allocator_ = NULL;
+    is_inited_ = false;
+  }
+}
+
+uint64_t ObFastParserCache::calc_hash(const ObString& sql, const ObSQLMode sql_mode, const ObCollationType conn_coll,
+    const bool enable_batched_multi_stmt)
+{
+  uint64_t hash = murmurhash(sql.ptr(), sql.length(), 0);
+  hash = murmurhash(&sql_mode, sizeof(sql_mode), hash);
+  hash = murmurhash(&conn_coll, sizeof(conn_coll), hash);
+  return murmurhash(&enable_batched_multi_stmt, sizeof(enable_batched_multi_stmt), hash);
+}
+
+bool ObFastParserCache::is_match(const Entry& entry, const uint64_t hash, const ObString& sql,
+    const ObSQLMode sql_mode, const ObCollationType conn_coll, const bool enable_batched_multi_stmt)
+{
+  return hash == entry.hash_ && sql_mode == entry.sql_mode_ && conn_coll == entry.conn_coll_ &&
+         enable_batched_multi_stmt == entry.enable_batched_multi_stmt_ && sql.length() == entry.sql_.length() &&
+         0 == MEMCMP(sql.ptr(), entry.sql_.ptr(), sql.length());
+}
+
+int64_t ObFastParserCache::get_node_size(const ParseNode* node)
+{
+  int64_t size = 0;
+  if (NULL != node) {
+    size = fp_cache_align(sizeof(ParseNode));
+    if (NULL != node->str_value_) {
+      size += fp_cache_align(node->str_len_ + 1);
+    }
+    if (NULL != node->raw_text_) {
+      size += fp_cache_align(node->text_len_ + 1);
+    }
+    if (node->num_child_ > 0 && NULL != node->children_) {
+      size += fp_cache_align(node->num_child_ * sizeof(ParseNode*));
+      for (int64_t i = 0; i < node->num_child_; ++i) {
+        size += get_node_size(node->children_[i]);
+      }
+    }
+  }
+  return size;
+}
+
+int ObFastParserCache::deep_copy_node(ObIAllocator& allocator, const ParseNode* src, ParseNode*& dst)
+{
+  int ret = OB_SUCCESS;
+  dst = NULL;
+  char* str = NULL;
+  if (NULL == src) {
+    // do nothing
+  } else if (OB_ISNULL(dst = static_cast<ParseNode*>(allocator.alloc(fp_cache_align(sizeof(ParseNode)))))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to alloc parse node", K(ret));
+  } else {
+    *dst = *src;
+    if (NULL != src->str_value_) {
+      if (OB_ISNULL(str = static_cast<char*>(allocator.alloc(fp_cache_align(src->str_len_ + 1))))) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("fail to alloc str value", K(ret), K(src->str_len_));
+      } else {
+        MEMCPY(str, src->str_value_, src->str_len_);
+        str[src->str_len_] = '\0';
+        dst->str_value_ = str;
+      }
+    }
+    if (OB_SUCC(ret) && NULL != src->raw_text_) {
+      if (OB_ISNULL(str = static_cast<char*>(allocator.alloc(fp_cache_align(src->text_len_ + 1))))) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("fail to alloc raw text", K(ret), K(src->text_len_));
+      } else {
+        MEMCPY(str, src->raw_text_, src->text_len_);
+        str[src->text_len_] = '\0';
+        dst->raw_text_ = str;
+      }
+    }
+    if (OB_SUCC(ret) && src->num_child_ > 0 && NULL != src->children_) {
+      if (OB_ISNULL(dst->children_ = static_cast<ParseNode**>(
+                        allocator.alloc(fp_cache_align(src->num_child_ * sizeof(ParseNode*)))))) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("fail to alloc children", K(ret), K(src->num_child_));
+      }
+      for (int64_t i = 0; OB_SUCC(ret) && i < src->num_child_; ++i) {
+        if (OB_FAIL(deep_copy_node(allocator, src->children_[i], dst->children_[i]))) {
+          LOG_WARN("fail to copy child", K(ret), K(i));
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+int ObFastParserCache::get(const ObString& sql, const ObSQLMode sql_mode, const ObCollationType conn_coll,
+    const bool enable_batched_multi_stmt, ObIAllocator& allocator, ObFastParserResult& fp_result)
+{
+  int ret = OB_ENTRY_NOT_EXIST;
+  if (is_inited_ && !sql.empty() && sql.length() <= MAX_SQL_LEN) {
+    const uint64_t hash = calc_hash(sql, sql_mode, conn_coll, enable_batched_multi_stmt);
+    Slot& slot = slots_[hash % SLOT_CNT];
+    ObString no_param_sql;
+    ObPCParam* pc_params = NULL;
+    int64_t param_cnt = 0;
+    ATOMIC_INC(&access_cnt_);
+    {
+      SpinRLockGuard guard(slot.lock_);
+      const Entry* entry = slot.entry_;
+      if (NULL != entry && is_match(*entry, hash, sql, sql_mode, conn_coll, enable_batched_multi_stmt)) {
+        param_cnt = entry->param_cnt_;
+        if (OB_FAIL(ob_write_string(allocator, entry->no_param_sql_, no_param_sql, true /*c_style*/))) {
+          LOG_WARN("fail to copy no param sql", K(ret));
+        } else if (param_cnt > 0 &&
+                   OB_ISNULL(pc_params = static_cast<ObPCParam*>(allocator.alloc(param_cnt * sizeof(ObPCParam))))) {
+          ret = OB_ALLOCATE_MEMORY_FAILED;
+          LOG_WARN("fail to alloc pc params", K(ret), K(param_cnt));
+        }
+        for (int64_t i = 0; OB_SUCC(ret) && i < param_cnt; ++i) {
+          ObPCParam* pc_param = new (&pc_params[i]) ObPCParam();
+          if (OB_FAIL(deep_copy_node(allocator, entry->params_[i], pc_param->node_))) {
+            LOG_WARN("fail to copy raw param", K(ret), K(i));
+          }
+        }
+      }
+    }
+    if (OB_SUCC(ret)) {
+      (void)fp_result.pc_key_.name_.assign_ptr(no_param_sql.ptr(), no_param_sql.length());
+      if (param_cnt > 0) {
+        fp_result.raw_params_.set_allocator(&allocator);
+        fp_result.raw_params_.set_capacity(param_cnt);
+      }
+      for (int64_t i = 0; OB_SUCC(ret) && i < param_cnt; ++i) {
+        if (OB_FAIL(fp_result.raw_params_.push_back(&pc_params[i]))) {
+          LOG_WARN("fail to push back raw param", K(ret));
+        }
+      }
+      if (OB_SUCC(ret)) {
+        ATOMIC_INC(&hit_cnt_);
+      } else {
+        fp_result.pc_key_.name_.reset();
+        fp_result.raw_params_.reuse();
+      }
+    }
+  }
+  return ret;
+}
+
+int ObFastParserCache::put(const ObString& sql, const ObSQLMode sql_mode, const ObCollationType conn_coll,
+    const bool enable_batched_multi_stmt, const ObFastParserResult& fp_result)
+{
+  int ret = OB_SUCCESS;
+  const uint64_t hash = calc_hash(sql, sql_mode, conn_coll, enable_batched_multi_stmt);
+  const ObString& no_param_sql = fp_result.pc_key_.name_;
+  const int64_t param_cnt = fp_result.raw_params_.count();
+  int64_t size = fp_cache_align(sizeof(Entry)) + fp_cache_align(sql.length()) +
+                 fp_cache_align(no_param_sql.length() + 1) + fp_cache_align(param_cnt * sizeof(ParseNode*));
+  for (int64_t i = 0; i < param_cnt && size <= MAX_ENTRY_SIZE; ++i) {
+    if (NULL != fp_result.raw_params_.at(i)) {
+      size += get_node_size(fp_result.raw_params_.at(i)->node_);
+    }
+  }
+  if (!is_inited_ || sql.empty() || sql.length() > MAX_SQL_LEN || size > MAX_ENTRY_SIZE) {
+    // do nothing
+  } else {
+    Slot& slot = slots_[hash % SLOT_CNT];
+    bool need_put = false;
+    {
+      SpinWLockGuard guard(slot.lock_);
+      // admit the text only if it is the last one missed on this slot
+      need_put = (hash == slot.missed_hash_);
+      slot.missed_hash_ = hash;
+    }
+    char* buf = NULL;
+    Entry* entry = NULL;
+    if (!need_put) {
+    } else if (OB_ISNULL(buf = static_cast<char*>(allocator_->alloc(size)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("fail to alloc fast parser cache entry", K(ret), K(size));
+    } else {
+      ObDataBuffer data_buf(buf + fp_cache_align(sizeof(Entry)), size - fp_cache_align(sizeof(Entry)));
+      entry = new (buf) Entry();
+      entry->hash_ = hash;
+      entry->sql_mode_ = sql_mode;
+      entry->conn_coll_ = conn_coll;
+      entry->enable_batched_multi_stmt_ = enable_batched_multi_stmt;
+      entry->param_cnt_ = param_cnt;
+      entry->params_ = NULL;
+      char* sql_buf = static_cast<char*>(data_buf.alloc(fp_cache_align(sql.length())));
+      char* no_param_sql_buf = static_cast<char*>(data_buf.alloc(fp_cache_align(no_param_sql.length() + 1)));
+      if (param_cnt > 0) {
+        entry->params_ = static_cast<ParseNode**>(data_buf.alloc(fp_cache_align(param_cnt * sizeof(ParseNode*))));
+      }
+      if (OB_ISNULL(sql_buf) || OB_ISNULL(no_param_sql_buf) || (param_cnt > 0 && OB_ISNULL(entry->params_))) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("entry size is not enough", K(ret), K(size));
+      } else {
+        MEMCPY(sql_buf, sql.ptr(), sql.length());
+        entry->sql_.assign_ptr(sql_buf, sql.length());
+        MEMCPY(no_param_sql_buf, no_param_sql.ptr(), no_param_sql.length());
+        no_param_sql_buf[no_param_sql.length()] = '\0';
+        entry->no_param_sql_.assign_ptr(no_param_sql_buf, no_param_sql.length());
+      }
+      for (int64_t i = 0; OB_SUCC(ret) && i < param_cnt; ++i) {
+        const ObPCParam* pc_param = fp_result.raw_params_.at(i);
+        if (OB_ISNULL(pc_param)) {
+          ret = OB_ERR_UNEXPECTED;
+          LOG_WARN("raw param is null", K(ret), K(i));
+        } else if (OB_FAIL(deep_copy_node(data_buf, pc_param->node_, entry->params_[i]))) {
+          LOG_WARN("fail to copy raw param", K(ret), K(i));
+        }
+      }
+      if (OB_SUCC(ret)) {
+        SpinWLockGuard guard(slot.lock_);
+        Entry* old_entry = slot.entry_;
+        slot.entry_ = entry;
+        slot.missed_hash_ = 0;
+        entry = old_entry;
+        if (NULL == old_entry) {
+          ATOMIC_INC(&entry_cnt_);
+        }
+      }
+      free_entry(entry);
+    }
+  }
+  return ret;
+}
+
+void ObFastParserCache::clear()
+{
+  if (is_inited_) {
+    for (int64_t i = 0; i < SLOT_CNT; ++i) {
+      Entry* entry = NULL;
+      {
+        SpinWLockGuard guard(slots_[i].lock_);
+        entry = slots_[i].entry_;
+        slots_[i].entry_ = NULL;
+        slots_[i].missed_hash_ = 0;
+      }
+      if (NULL != entry) {
+        ATOMIC_DEC(&entry_cnt_);
+        free_entry(entry);
+      }
+    }
+  }
+}
+
+void ObFastParserCache::free_entry(Entry*& entry)
+{
+  if (NULL != entry) {
+    entry->~Entry();
+    allocator_->free(entry);
+    entry = NULL;
+  }
+}
+
+}  // end namespace sql
+}  // end namespace oceanbase
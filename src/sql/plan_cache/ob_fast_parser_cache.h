@@ -0,0 +1,98 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_SQL_PLAN_CACHE_OB_FAST_PARSER_CACHE_
+#define OCEANBASE_SQL_PLAN_CACHE_OB_FAST_PARSER_CACHE_
+
+#include "lib/lock/ob_spin_rwlock.h"
+#include "sql/plan_cache/ob_plan_cache_util.h"
+
+namespace oceanbase {
+namespace sql {
+
+// Results of ObSqlParameterization::fast_parser keyed by the raw sql text, so a statement text
+// submitted again gets its parameterized sql and raw params without being tokenized.
+//
+// The result only depends on the text, the sql mode, the connection collation and whether batched
+// multi-stmt is handled, not on schema, so an entry never goes stale. It is dropped together with the
+// plans when the plan cache is flushed or evicted by memory.
+//
+// Slots are direct mapped by the hash of the text. A text is cached when it misses twice in a row on
+// its slot, so statements that never repeat (literals inlined) do not churn the cache.
+// Raw param nodes are modified by the later parameterization, a hit returns a deep copy.
+class ObFastParserCache {
+public:
+  static const int64_t SLOT_CNT = 1024;
+  static const int64_t MAX_SQL_LEN = 2048;
+  static const int64_t MAX_ENTRY_SIZE = 8 * 1024;
+
+  ObFastParserCache();
+  ~ObFastParserCache();
+  int init(common::ObIAllocator& allocator);
+  void destroy();
+  // OB_ENTRY_NOT_EXIST if not cached, otherwise pc_key_.name_ and raw_params_ of %fp_result are set,
+  // allocated by %allocator.
+  int get(const common::ObString& sql, const ObSQLMode sql_mode, const common::ObCollationType conn_coll,
+      const bool enable_batched_multi_stmt, common::ObIAllocator& allocator, ObFastParserResult& fp_result);
+  // cache the fast parser result of %sql
+  int put(const common::ObString& sql, const ObSQLMode sql_mode, const common::ObCollationType conn_coll,
+      const bool enable_batched_multi_stmt, const ObFastParserResult& fp_result);
+  void clear();
+  int64_t get_access_cnt() const
+  {
+    return ATOMIC_LOAD(&access_cnt_);
+  }
+  int64_t get_hit_cnt() const
+  {
+    return ATOMIC_LOAD(&hit_cnt_);
+  }
+  TO_STRING_KV(K_(is_inited), K_(entry_cnt), K_(hit_cnt), K_(access_cnt));
+
+private:
+  struct Entry {
+    uint64_t hash_;
+    ObSQLMode sql_mode_;
+    common::ObCollationType conn_coll_;
+    bool enable_batched_multi_stmt_;
+    common::ObString sql_;
+    common::ObString no_param_sql_;
+    int64_t param_cnt_;
+    ParseNode** params_;
+  };
+  struct Slot {
+    common::SpinRWLock lock_;
+    Entry* entry_;
+    uint64_t missed_hash_;
+  };
+
+  static uint64_t calc_hash(const common::ObString& sql, const ObSQLMode sql_mode,
+      const common::ObCollationType conn_coll, const bool enable_batched_multi_stmt);
+  static bool is_match(const Entry& entry, const uint64_t hash, const common::ObString& sql,
+      const ObSQLMode sql_mode, const common::ObCollationType conn_coll, const bool enable_batched_multi_stmt);
+  static int64_t get_node_size(const ParseNode* node);
+  static int deep_copy_node(common::ObIAllocator& allocator, const ParseNode* src, ParseNode*& dst);
+  void free_entry(Entry*& entry);
+
+private:
+  bool is_inited_;
+  common::ObIAllocator* allocator_;
+  Slot* slots_;
+  int64_t entry_cnt_;
+  int64_t hit_cnt_;
+  int64_t access_cnt_;
+  DISALLOW_COPY_AND_ASSIGN(ObFastParserCache);
+};
+
+}  // end namespace sql
+}  // end namespace oceanbase
+
+#endif  // OCEANBASE_SQL_PLAN_CACHE_OB_FAST_PARSER_CACHE_
@@ -249,7 +249,8 @@ ObPlanCache::ObPlanCache()
       location_cache_(NULL),
       plan_id_(0),
       ref_count_(0),
-      ref_handle_mgr_()
+      ref_handle_mgr_(),
+      fp_cache_()
 {}
 
 ObPlanCache::~ObPlanCache()
@@ -266,6 +267,7 @@ void ObPlanCache::destroy()
     if (OB_SUCCESS != (cache_evict_all_pl())) {
       SQL_PC_LOG(WARN, "fail to evict all pl cache");
     }
+    fp_cache_.destroy();
     inited_ = false;
   }
 }
@@ -294,13 +296,17 @@ int ObPlanCache::init(
       ObMemAttr attr = get_mem_attr();
       attr.tenant_id_ = tenant_id;
       inner_allocator_.set_attr(attr);
-      set_location_cache(location_cache);
-      set_host(addr);
-      bucket_num_ = hash::cal_next_prime(hash_bucket);
-      tenant_id_ = tenant_id;
-      ref_handle_mgr_.set_tenant_id(tenant_id_);
-      inited_ = true;
-      valid_ = true;
+      if (OB_FAIL(fp_cache_.init(inner_allocator_))) {
+        SQL_PC_LOG(WARN, "failed to init fast parser cache", K(ret));
+      } else {
+        set_location_cache(location_cache);
+        set_host(addr);
+        bucket_num_ = hash::cal_next_prime(hash_bucket);
+        tenant_id_ = tenant_id;
+        ref_handle_mgr_.set_tenant_id(tenant_id_);
+        inited_ = true;
+        valid_ = true;
+      }
     }
   }
 
@@ -379,7 +385,7 @@ int ObPlanCache::get_plan(
       pc_ctx.fp_result_ = pc_ctx.multi_stmt_fp_results_.at(0);
     }
   } else {
-    if (OB_FAIL(construct_fast_parser_result(allocator, pc_ctx, pc_ctx.raw_sql_, pc_ctx.fp_result_))) {
+    if (OB_FAIL(construct_fast_parser_result(allocator, pc_ctx, pc_ctx.raw_sql_, pc_ctx.fp_result_, &fp_cache_))) {
       LOG_WARN("failed to construct fast parser results", K(ret));
     } else { /*do nothing*/
     }
@@ -449,7 +455,7 @@ int ObPlanCache::construct_multi_stmt_fast_parser_result(common::ObIAllocator& a
 }
 
 int ObPlanCache::construct_fast_parser_result(common::ObIAllocator& allocator, ObPlanCacheCtx& pc_ctx,
-    const common::ObString& raw_sql, ObFastParserResult& fp_result)
+    const common::ObString& raw_sql, ObFastParserResult& fp_result, ObFastParserCache* fp_cache)
 
 {
   int ret = OB_SUCCESS;
@@ -459,13 +465,25 @@ int ObPlanCache::construct_fast_parser_result(common::ObIAllocator& allocator, O
   } else {
     ObSQLMode sql_mode = pc_ctx.sql_ctx_.session_info_->get_sql_mode();
     ObCollationType conn_coll = pc_ctx.sql_ctx_.session_info_->get_local_collation_connection();
+    bool enable_batched_multi_stmt = pc_ctx.sql_ctx_.handle_batched_multi_stmt();
+    bool is_cached = false;
     fp_result.cache_params_ = &(pc_ctx.exec_ctx_.get_physical_plan_ctx()->get_param_store_for_update());
     if (OB_FAIL(construct_plan_cache_key(*pc_ctx.sql_ctx_.session_info_, NS_CRSR, fp_result.pc_key_))) {
       LOG_WARN("failed to construct plan cache key", K(ret));
+    } else if (NULL != fp_cache) {
+      int tmp_ret = fp_cache->get(raw_sql, sql_mode, conn_coll, enable_batched_multi_stmt, allocator, fp_result);
+      if (OB_SUCCESS == tmp_ret) {
+        is_cached = true;
+      } else if (OB_ENTRY_NOT_EXIST != tmp_ret) {
+        LOG_WARN("failed to get fast parser result from cache", K(tmp_ret));
+      }
+    }
+    if (OB_FAIL(ret) || is_cached) {
     } else if (OB_FAIL(ObSqlParameterization::fast_parser(
-                   allocator, sql_mode, conn_coll, raw_sql, pc_ctx.sql_ctx_.handle_batched_multi_stmt(), fp_result))) {
+                   allocator, sql_mode, conn_coll, raw_sql, enable_batched_multi_stmt, fp_result))) {
       LOG_WARN("failed to fast parser", K(ret), K(sql_mode), K(pc_ctx.raw_sql_));
-    } else { /*do nothing*/
+    } else if (NULL != fp_cache) {
+      (void)fp_cache->put(raw_sql, sql_mode, conn_coll, enable_batched_multi_stmt, fp_result);
     }
   }
   return ret;
@@ -844,6 +862,7 @@ int ObPlanCache::cache_evict_all_plan()
   int ret = OB_SUCCESS;
   ObGlobalReqTimeService::check_req_timeinfo();
   SQL_PC_LOG(DEBUG, "cache evict all plan start");
+  fp_cache_.clear();
   PCKeyValueArray to_evict_keys;
   ObGetAllSqlIdOp get_ids_op(&to_evict_keys, PCV_GET_PLAN_KEY_HANDLE);
   if (OB_FAIL(sql_pcvs_map_.foreach_refactored(get_ids_op))) {
@@ -925,6 +944,7 @@ int ObPlanCache::cache_evict()
   (void)evict_expired_plan();
   if (get_mem_hold() > get_mem_high()) {
     int64_t plan_cache_evict_num = 0;
+    fp_cache_.clear();
     if (calc_evict_num(plan_cache_evict_num)) {
       PCKeyValueArray to_evict;
       if (OB_FAIL(calc_evict_keys(plan_cache_evict_num, to_evict))) {
@@ -21,6 +21,7 @@
 #include "sql/plan_cache/ob_sql_parameterization.h"
 #include "sql/plan_cache/ob_prepare_stmt_struct.h"
 #include "sql/plan_cache/ob_pc_ref_handle.h"
+#include "sql/plan_cache/ob_fast_parser_cache.h"
 
 namespace oceanbase {
 namespace share {
@@ -284,8 +285,9 @@ public:
   }
   int add_exists_pcv_set_by_new_stmt_id(ObCacheObject* cache_obj, ObPlanCacheCtx& pc_ctx);
   int add_exists_pcv_set_by_sql(ObCacheObject* cache_obj, ObPlanCacheCtx& pc_ctx);
+  // %fp_cache is looked up before the fast parser if it is not NULL
   static int construct_fast_parser_result(common::ObIAllocator& allocator, ObPlanCacheCtx& pc_ctx,
-      const common::ObString& raw_sql, ObFastParserResult& fp_result);
+      const common::ObString& raw_sql, ObFastParserResult& fp_result, ObFastParserCache* fp_cache = NULL);
   static int construct_multi_stmt_fast_parser_result(common::ObIAllocator& allocator, ObPlanCacheCtx& pc_ctx);
   PlanStatMap& get_deleted_map()
   {
@@ -313,6 +315,10 @@ public:
   {
     return ref_handle_mgr_;
   }
+  const ObFastParserCache& get_fp_cache() const
+  {
+    return fp_cache_;
+  }
 
 private:
   DISALLOW_COPY_AND_ASSIGN(ObPlanCache);
@@ -366,6 +372,8 @@ private:
   // ObSqlParameterization sql_parameterization_;
   // ref handle infos
   ObCacheRefHandleMgr ref_handle_mgr_;
+  // raw sql --> fast parser result, allocated by inner_allocator_
+  ObFastParserCache fp_cache_;
 };
 
 }  // end namespace sql
@@ -104,7 +104,7 @@ int ObBlockCacheWorkingSet::get_allocator(ObIAllocator*& allocator)
   return ret;
 }
 
-int ObBlockCacheWorkingSet::put(const Key& key, const Value& value, bool overwrite)
+int ObBlockCacheWorkingSet::put(const Key& key, const Value& value, bool overwrite, const enum ObKVCachePolicy policy)
 {
   int ret = OB_SUCCESS;
   BaseBlockCache* cache = NULL;
@@ -113,7 +113,7 @@ int ObBlockCacheWorkingSet::put(const Key& key, const Value& value, bool overwri
     LOG_WARN("not init", K(ret));
   } else if (OB_FAIL(get_cache(cache))) {
     LOG_WARN("get_cache failed", K(ret));
-  } else if (OB_FAIL(cache->put(key, value, overwrite))) {
+  } else if (OB_FAIL(cache->put(key, value, overwrite, policy))) {
     LOG_WARN("cache put failed", K(ret));
   } else {
     const int64_t put_size = ObKVStoreMemBlock::get_align_size(key, value);
@@ -124,8 +124,8 @@ int ObBlockCacheWorkingSet::put(const Key& key, const Value& value, bool overwri
   return ret;
 }
 
-int ObBlockCacheWorkingSet::put_and_fetch(
-    const Key& key, const Value& value, const Value*& pvalue, ObKVCacheHandle& handle, bool overwrite)
+int ObBlockCacheWorkingSet::put_and_fetch(const Key& key, const Value& value, const Value*& pvalue,
+    ObKVCacheHandle& handle, bool overwrite, const enum ObKVCachePolicy policy)
 {
   int ret = OB_SUCCESS;
   BaseBlockCache* cache = NULL;
@@ -134,7 +134,7 @@ int ObBlockCacheWorkingSet::put_and_fetch(
     LOG_WARN("not init", K(ret));
   } else if (OB_FAIL(get_cache(cache))) {
     LOG_WARN("get_cache failed", K(ret));
-  } else if (OB_FAIL(cache->put_and_fetch(key, value, pvalue, handle, overwrite))) {
+  } else if (OB_FAIL(cache->put_and_fetch(key, value, pvalue, handle, overwrite, policy))) {
     LOG_WARN("cache put failed", K(ret));
   } else {
     const int64_t put_size = ObKVStoreMemBlock::get_align_size(key, value);
@@ -202,7 +202,8 @@ int ObBlockCacheWorkingSet::create_working_set_if_need()
 }
 
 int ObBlockCacheWorkingSet::alloc(const uint64_t tenant_id, const int64_t key_size, const int64_t value_size,
-    ObKVCachePair*& kvpair, ObKVCacheHandle& handle, ObKVCacheInstHandle& inst_handle)
+    ObKVCachePair*& kvpair, ObKVCacheHandle& handle, ObKVCacheInstHandle& inst_handle,
+    const enum ObKVCachePolicy policy)
 {
   int ret = OB_SUCCESS;
   BaseBlockCache* cache = nullptr;
@@ -211,7 +212,7 @@ int ObBlockCacheWorkingSet::alloc(const uint64_t tenant_id, const int64_t key_si
     LOG_WARN("not init", K(ret));
   } else if (OB_FAIL(get_cache(cache))) {
     LOG_WARN("get_cache failed", K(ret));
-  } else if (OB_FAIL(cache->alloc(tenant_id, key_size, value_size, kvpair, handle, inst_handle))) {
+  } else if (OB_FAIL(cache->alloc(tenant_id, key_size, value_size, kvpair, handle, inst_handle, policy))) {
     LOG_WARN("cache put failed", K(ret));
   } else {
     const int64_t put_size = ObKVStoreMemBlock::get_align_size(key_size, value_size);
@@ -38,13 +38,15 @@ public:
   virtual int get_cache(BaseBlockCache*& cache) override;
   virtual int get_allocator(common::ObIAllocator*& allocator) override;
 
-  virtual int put(const Key& key, const Value& value, bool overwrite = true) override;
+  virtual int put(const Key& key, const Value& value, bool overwrite = true,
+      const enum common::ObKVCachePolicy policy = common::LRU) override;
   virtual int put_and_fetch(const Key& key, const Value& value, const Value*& pvalue, common::ObKVCacheHandle& handle,
-      bool overwrite = true) override;
+      bool overwrite = true, const enum common::ObKVCachePolicy policy = common::LRU) override;
   virtual int get(const Key& key, const Value*& pvalue, common::ObKVCacheHandle& handle) override;
   virtual int erase(const Key& key) override;
   virtual int alloc(const uint64_t tenant_id, const int64_t key_size, const int64_t value_size, ObKVCachePair*& kvpair,
-      ObKVCacheHandle& handle, ObKVCacheInstHandle& inst_handle) override;
+      ObKVCacheHandle& handle, ObKVCacheInstHandle& inst_handle,
+      const enum common::ObKVCachePolicy policy = common::LRU) override;
 
 private:
   int create_working_set_if_need();
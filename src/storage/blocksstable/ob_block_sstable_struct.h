@@ -1678,7 +1678,7 @@ public:
   }
   inline int32_t get_endkey_size() const
   {
-    return 0 == micro_block_mark_deletion_offset_ ? occupy_size_ - micro_block_endkey_offset_
+    return 0 == micro_block_mark_deletion_offset_ ? get_index_section_end() - micro_block_endkey_offset_
                                                   : micro_block_mark_deletion_offset_ - micro_block_endkey_offset_;
   }
   inline int32_t get_micro_block_mark_deletion_size() const
@@ -1687,7 +1687,11 @@ public:
   }
   inline int32_t get_micro_block_delta_size() const
   {
-    return 0 == micro_block_delta_offset_ ? 0 : occupy_size_ - micro_block_delta_offset_;
+    return 0 == micro_block_delta_offset_ ? 0 : get_index_section_end() - micro_block_delta_offset_;
+  }
+  inline int32_t get_micro_block_skip_index_size() const
+  {
+    return 0 == micro_block_skip_index_offset_ ? 0 : occupy_size_ - micro_block_skip_index_offset_;
   }
   NEED_SERIALIZE_AND_DESERIALIZE;
   OB_INLINE bool is_data_block() const
@@ -1721,6 +1725,12 @@ public:
 
 private:
   int64_t get_meta_content_serialize_size() const;
+  // end of the sections addressed by micro block index, the skip index is always the last one.
+  // occupy_size_ without skip index, as computed by observers not knowing it
+  inline int32_t get_index_section_end() const
+  {
+    return 0 == micro_block_skip_index_offset_ ? occupy_size_ : micro_block_skip_index_offset_;
+  }
 
 public:
   // For compatibility, the variables in this struct MUST NOT be deleted or moved.
@@ -1775,6 +1785,8 @@ public:
   char encrypt_key_[share::OB_MAX_TABLESPACE_ENCRYPT_KEY_LENGTH];
   bool contain_uncommitted_row_;
   int64_t max_merged_trans_version_;
+  int32_t micro_block_skip_index_offset_;  // skip_index_size = occupy_size - micro_block_skip_index_offset_,
+                                           // 0 if the macro block has no skip index
 };
 
 struct ObFullMacroBlockMeta final {
@@ -22,10 +22,16 @@
 #include "ob_row_reader.h"
 
 namespace oceanbase {
+namespace common {
+class ObBitmap;
+}  // namespace common
 namespace storage {
 class ObStoreRow;
 struct ObStoreRowLockState;
 }  // namespace storage
+namespace sql {
+class ObWhiteFilterExecutor;
+}  // namespace sql
 
 namespace memtable {
 class ObIMvccCtx;
@@ -207,6 +213,12 @@ public:
   virtual int exist_row(const uint64_t tenant_id, const ObMicroBlockData& block_data,
       const common::ObStoreRowkey& rowkey, const ObFullMacroBlockMeta& macro_meta,
       const storage::ObSSTableRowkeyHelper* rowkey_helper, bool& exist, bool& found) = 0;
+  // The next get_row reads the micro block of the last one in the same buffer, readers which prepare
+  // the whole block before locating the row can skip it.
+  virtual void set_same_block(const bool is_same_block)
+  {
+    UNUSED(is_same_block);
+  }
   virtual int check_row_locked(memtable::ObIMvccCtx& ctx, const transaction::ObTransStateTableGuard& trans_table_guard,
       const transaction::ObTransID& read_trans_id, const ObMicroBlockData& block_data,
       const common::ObStoreRowkey& rowkey, const ObFullMacroBlockMeta& full_meta,
@@ -256,6 +268,19 @@ public:
   int locate_rowkey(const common::ObStoreRowkey& rowkey, int64_t& row_idx);
   int locate_range(const common::ObStoreRange& range, const bool is_left_border, const bool is_right_border,
       int64_t& begin_idx, int64_t& end_idx);
+  // evaluate white filter on request column @col_idx of rows [begin_index, begin_index + row_count),
+  // bit i of @result_bitmap is set if row (begin_index + i) qualifies.
+  // readers which can not evaluate filters on stored data return OB_NOT_SUPPORTED
+  virtual int filter_pushdown_filter(const sql::ObWhiteFilterExecutor& filter, const int64_t col_idx,
+      const int64_t begin_index, const int64_t row_count, common::ObBitmap& result_bitmap)
+  {
+    UNUSED(filter);
+    UNUSED(col_idx);
+    UNUSED(begin_index);
+    UNUSED(row_count);
+    UNUSED(result_bitmap);
+    return common::OB_NOT_SUPPORTED;
+  }
 
   inline bool is_inited() const
   {
@@ -301,7 +326,7 @@ public:
   inline bool is_valid() const
   {
     return range_.is_valid() && data_.is_valid() && NULL != column_map_ &&
-           common::ObStoreFormat::is_row_store_type_valid(row_store_type_) && meta_.is_valid();
+           common::ObStoreFormat::is_block_row_store_type_valid(row_store_type_) && meta_.is_valid();
   }
 
   TO_STRING_KV(K_(range), K_(data), K_(column_map), K_(row_store_type), K_(row_count), K_(column_cnt),
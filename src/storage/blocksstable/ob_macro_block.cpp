@@ -48,8 +48,13 @@ int ObDataStoreDesc::cal_row_store_type(const share::schema::ObTableSchema& tabl
     } else {
       row_store_type_ = FLAT_ROW_STORE;
     }
+  } else if (RESERVED_ROW_STORE == table_schema.get_row_store_type() && !need_index_tree_ &&
+             GCONF._enable_micro_block_encoding && GET_MIN_CLUSTER_VERSION() >= CLUSTER_VERSION_313) {
+    // tables of DYNAMIC, COMPRESSED, QUERY and ARCHIVE format are column-wise encoded by major merge on opt-in,
+    // once every observer reads encoded blocks. Blocks of index tree are always read back by flat reader
+    row_store_type_ = ENCODING_ROW_STORE;
   } else {
-    // major merge support flat only
+    // others are flat in major merge
     row_store_type_ = FLAT_ROW_STORE;
   }
   STORAGE_LOG(DEBUG, "row store type", K(row_store_type_), K(merge_type));
@@ -179,6 +184,13 @@ int ObDataStoreDesc::init(const ObTableSchema& table_schema, const int64_t data_
     } else if (is_major_ && OB_FAIL(get_major_working_cluster_version())) {
       STORAGE_LOG(WARN, "Failed to get major working cluster version", K(ret));
     } else {
+      // only scans of major sstable skip micro blocks, and old observers take the section as part of the
+      // endkeys or delta, so it is written on opt-in once every observer reads it
+      need_skip_index_ = is_major_ && !enable_sparse_format() && GCONF._enable_micro_block_skip_index &&
+                         GET_MIN_CLUSTER_VERSION() >= CLUSTER_VERSION_313;
+      if (need_skip_index_) {
+        micro_block_size_limit_ -= ObSkipIndexAggregator::MAX_HEADER_SIZE + ObSkipIndexAggregator::MAX_ENTRY_SIZE;
+      }
       ObSEArray<ObColDesc, OB_DEFAULT_SE_ARRAY_COUNT> column_list;
       if (OB_NOT_NULL(multi_version_row_info) && multi_version_row_info->is_valid()) {
         ObMultiVersionColDescGenerate multi_version_col_desc_gen;
@@ -265,6 +277,7 @@ void ObDataStoreDesc::reset()
   major_working_cluster_version_ = 0;
   iter_complement_ = false;
   is_unique_index_ = false;
+  need_skip_index_ = false;
 }
 
 int ObDataStoreDesc::assign(const ObDataStoreDesc& desc)
@@ -305,6 +318,7 @@ int ObDataStoreDesc::assign(const ObDataStoreDesc& desc)
   need_check_order_ = desc.need_check_order_;
   major_working_cluster_version_ = desc.major_working_cluster_version_;
   is_unique_index_ = desc.is_unique_index_;
+  need_skip_index_ = desc.need_skip_index_;
   if (OB_FAIL(file_handle_.assign(desc.file_handle_))) {
     STORAGE_LOG(WARN, "failed to assign file handle", K(ret), K(desc.file_handle_));
   }
@@ -432,6 +446,7 @@ void ObMicroBlockDesc::reset()
   column_checksums_ = NULL;
   max_merged_trans_version_ = 0;
   contain_uncommitted_row_ = false;
+  skip_index_ = NULL;
 }
 
 /**
@@ -470,7 +485,8 @@ ObMacroBlock::~ObMacroBlock()
 int ObMacroBlock::init_row_reader(const ObRowStoreType row_store_type)
 {
   int ret = OB_SUCCESS;
-  if (FLAT_ROW_STORE == row_store_type) {
+  if (FLAT_ROW_STORE == row_store_type || ENCODING_ROW_STORE == row_store_type) {
+    // rowkeys of encoding macro block are stored in flat format
     row_reader_ = &flat_row_reader_;
   } else if (SPARSE_ROW_STORE == row_store_type) {
     row_reader_ = &sparse_row_reader_;
@@ -551,6 +567,24 @@ int ObMacroBlock::write_micro_record_header(const ObMicroBlockDesc& micro_block_
   return ret;
 }
 
+int ObMacroBlock::write_skip_index_entry(const ObMicroBlockDesc& micro_block_desc)
+{
+  int ret = OB_SUCCESS;
+  ObSkipIndexAggregator* skip_index = micro_block_desc.skip_index_;
+  const char* entry = NULL;
+  int64_t entry_size = 0;
+  if (OB_ISNULL(skip_index)) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "invalid arguments", K(ret), K(micro_block_desc));
+  } else if (OB_FAIL(skip_index->get_entry(micro_block_desc.row_count_, entry, entry_size))) {
+    STORAGE_LOG(WARN, "fail to get skip index entry", K(ret), K(*skip_index));
+  } else if (OB_FAIL(index_.add_skip_index_entry(
+                 skip_index->get_header(), skip_index->get_header_size(), entry, entry_size))) {
+    STORAGE_LOG(WARN, "fail to add skip index entry", K(ret), K(*skip_index));
+  }
+  return ret;
+}
+
 int ObMacroBlock::write_micro_block(const ObMicroBlockDesc& micro_block_desc, int64_t& data_offset)
 {
   int ret = OB_SUCCESS;
@@ -564,7 +598,13 @@ int ObMacroBlock::write_micro_block(const ObMicroBlockDesc& micro_block_desc, in
         spec_->store_micro_block_column_checksum_ ? RECORD_HEADER_VERSION_V3 : RECORD_HEADER_VERSION_V2;
     const int64_t record_header_size =
         ObRecordHeaderV3::get_serialize_size(header_version, micro_block_desc.column_count_);
-    if (micro_block_desc.buf_size_ + entry_size + record_header_size + micro_block_desc.last_rowkey_.length() >
+    int64_t skip_index_size = 0;
+    if (NULL != micro_block_desc.skip_index_) {
+      skip_index_size = micro_block_desc.skip_index_->get_entry_size() +
+                        (index_.has_skip_index() ? 0 : micro_block_desc.skip_index_->get_header_size());
+    }
+    if (micro_block_desc.buf_size_ + entry_size + record_header_size + micro_block_desc.last_rowkey_.length() +
+            skip_index_size >
         get_remain_size()) {
       ret = OB_BUF_NOT_ENOUGH;
     }
@@ -585,6 +625,8 @@ int ObMacroBlock::write_micro_block(const ObMicroBlockDesc& micro_block_desc, in
           K(data_offset),
           K(micro_block_desc.can_mark_deletion_),
           K(micro_block_desc.row_count_delta_));
+    } else if (NULL != micro_block_desc.skip_index_ && OB_FAIL(write_skip_index_entry(micro_block_desc))) {
+      STORAGE_LOG(WARN, "fail to write skip index entry", K(ret), K(micro_block_desc));
     } else if (OB_FAIL(write_micro_record_header(micro_block_desc))) {
       STORAGE_LOG(WARN, "fail to write micro record header", K(ret), K(micro_block_desc));
     } else {
@@ -911,6 +953,17 @@ int ObMacroBlock::build_index()
           index_.get_delta().length());
     }
   }
+  if (OB_SUCC(ret) && index_.has_skip_index()) {
+    if (OB_FAIL(data_.write(index_.get_skip_index().data(), index_.get_skip_index().length()))) {
+      STORAGE_LOG(WARN,
+          "macro block fail to copy skip index",
+          K(ret),
+          "skip index ptr",
+          OB_P(index_.get_skip_index().data()),
+          "skip index size",
+          index_.get_skip_index().length());
+    }
+  }
   return ret;
 }
 
@@ -967,6 +1020,11 @@ int ObMacroBlock::build_macro_meta(ObFullMacroBlockMeta& full_meta)
     mbi.progressive_merge_round_ = spec_->progressive_merge_round_;
     mbi.max_merged_trans_version_ = max_merged_trans_version_;
     mbi.contain_uncommitted_row_ = contain_uncommitted_row_;
+    mbi.micro_block_skip_index_offset_ =
+        index_.has_skip_index()
+            ? header_->micro_block_endkey_offset_ + header_->micro_block_endkey_size_ +
+                  static_cast<int32_t>(index_.get_mark_deletion().length() + index_.get_delta().length())
+            : 0;
 
     schema.column_number_ = static_cast<int16_t>(header_->column_count_);
     schema.rowkey_column_number_ = static_cast<int16_t>(header_->rowkey_column_count_);
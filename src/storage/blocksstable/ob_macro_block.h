@@ -16,6 +16,7 @@
 #include "lib/compress/ob_compressor.h"
 #include "storage/ob_multi_version_col_desc_generate.h"
 #include "ob_micro_block_index_writer.h"
+#include "ob_micro_block_skip_index.h"
 #include "ob_block_sstable_struct.h"
 #include "storage/ob_tenant_file_struct.h"
 #include "ob_block_mark_deletion_maker.h"
@@ -75,6 +76,7 @@ struct ObDataStoreDesc {
   int64_t major_working_cluster_version_;
   bool iter_complement_;
   bool is_unique_index_;
+  bool need_skip_index_;  // store min/max/null count of micro blocks behind the micro block index
   common::ObArenaAllocator allocator_;
   
   ObDataStoreDesc()
@@ -104,7 +106,8 @@ struct ObDataStoreDesc {
       K_(store_micro_block_column_checksum), K_(snapshot_version), K_(need_calc_physical_checksum), K_(need_index_tree),
       K_(need_prebuild_bloomfilter), K_(bloomfilter_rowkey_prefix), KP_(rowkey_helper), "column_types",
       common::ObArrayWrap<common::ObObjMeta>(column_types_, row_column_count_), K_(pg_key), K_(file_handle),
-      K_(need_check_order), K_(need_index_tree), K_(major_working_cluster_version), K_(iter_complement), K_(is_unique_index));
+      K_(need_check_order), K_(need_index_tree), K_(major_working_cluster_version), K_(iter_complement),
+      K_(is_unique_index), K_(need_skip_index));
 
 private:
   int cal_row_store_type(const share::schema::ObTableSchema& table_schema, const storage::ObMergeType merge_type);
@@ -143,6 +146,7 @@ struct ObMicroBlockDesc {
   int64_t* column_checksums_;
   int64_t max_merged_trans_version_;
   bool contain_uncommitted_row_;
+  ObSkipIndexAggregator* skip_index_;
 
   ObMicroBlockDesc()
   {
@@ -154,7 +158,7 @@ struct ObMicroBlockDesc {
   // last_rowkey is byte stream, don't print it
   TO_STRING_KV(K_(last_rowkey), KP_(buf), K_(buf_size), K_(data_size), K_(row_count), K_(column_count),
       K_(row_count_delta), K_(can_mark_deletion), KP_(column_checksums), K_(max_merged_trans_version),
-      K_(contain_uncommitted_row));
+      K_(contain_uncommitted_row), KP_(skip_index));
 };
 
 class ObMacroBlock {
@@ -208,6 +212,7 @@ public:
 
 private:
   int write_micro_record_header(const ObMicroBlockDesc& micro_block_desc);
+  int write_skip_index_entry(const ObMicroBlockDesc& micro_block_desc);
   int reserve_header(const ObDataStoreDesc& spec);
   int build_header(const int64_t cur_macro_seq);
   int build_macro_meta(ObFullMacroBlockMeta& full_meta);
@@ -41,6 +41,8 @@ ObMacroBlockWriter::ObMacroBlockWriter()
       flat_writer_(),
       row_writer_(),
       flat_reader_(),
+      encoding_writer_(),
+      encoding_reader_(),
       sstable_index_writer_(NULL),
       task_index_writer_(NULL),
       current_index_(0),
@@ -56,6 +58,7 @@ ObMacroBlockWriter::ObMacroBlockWriter()
       has_lob_(false),
       lob_writer_(),
       curr_micro_column_checksum_(NULL),
+      skip_index_aggr_(),
       allocator_("MacrBlocWriter"),
       macro_reader_(),
       micro_rowkey_hashs_(),
@@ -88,6 +91,8 @@ void ObMacroBlockWriter::reset()
   micro_writer_ = &flat_writer_;
   flat_writer_.reuse();
   flat_reader_.reset();
+  encoding_writer_.reset();
+  encoding_reader_.reset();
   sstable_index_writer_ = NULL;
   task_index_writer_ = NULL;
   macro_blocks_[0].reset();
@@ -109,8 +114,10 @@ void ObMacroBlockWriter::reset()
   lob_writer_.reset();
   check_flat_reader_.reset();
   check_sparse_reader_.reset();
+  check_encoding_reader_.reset();
   micro_rowkey_hashs_.reset();
   rowkey_helper_ = nullptr;
+  skip_index_aggr_.reset();
   allocator_.reuse();
 }
 
@@ -184,7 +191,17 @@ int ObMacroBlockWriter::open(ObDataStoreDesc& data_store_desc, const ObMacroData
       } else if (OB_FAIL(build_column_map(index_store_desc_, index_column_map_))) {
         STORAGE_LOG(WARN, "failed to build index column map", K(data_store_desc), K(ret));
       }
-      if (OB_SUCC(ret)) {
+      if (OB_FAIL(ret)) {
+      } else if (ENCODING_ROW_STORE == data_store_desc_->row_store_type_) {
+        if (OB_FAIL(encoding_writer_.init(data_store_desc_->micro_block_size_limit_,
+                data_store_desc_->rowkey_column_count_,
+                data_store_desc_->row_column_count_,
+                data_store_desc_->column_types_))) {
+          STORAGE_LOG(WARN, "Fail to init micro block encoding writer, ", K(ret));
+        } else {
+          micro_writer_ = &encoding_writer_;
+        }
+      } else {
         if (OB_FAIL(flat_writer_.init(data_store_desc_->micro_block_size_limit_,
                 data_store_desc_->rowkey_column_count_,
                 data_store_desc_->row_column_count_))) {
@@ -215,6 +232,14 @@ int ObMacroBlockWriter::open(ObDataStoreDesc& data_store_desc, const ObMacroData
         }
       }
 
+      if (OB_SUCC(ret) && data_store_desc_->need_skip_index_) {
+        if (OB_FAIL(skip_index_aggr_.init(data_store_desc_->column_ids_,
+                data_store_desc_->column_types_,
+                data_store_desc_->row_column_count_))) {
+          STORAGE_LOG(WARN, "fail to init skip index aggregator", K(ret));
+        }
+      }
+
       if (OB_SUCC(ret) && data_store_desc_->need_prebuild_bloomfilter_ && data_store_desc_->bloomfilter_size_ > 0) {
         if (OB_FAIL(open_bf_cache_writer(*data_store_desc_))) {
           STORAGE_LOG(WARN, "Failed to open bloomfilter cache writer, ", K(ret));
@@ -290,6 +315,8 @@ int ObMacroBlockWriter::append_row(const ObStoreRow& row, const int64_t split_si
           STORAGE_LOG(ERROR, "Fail to append row to micro block, ", K(ret), K(row));
         } else if (data_store_desc_->need_calc_column_checksum_ && OB_FAIL(add_row_checksum(row_to_append->row_val_))) {
           STORAGE_LOG(WARN, "fail to add column checksum", K(ret));
+        } else if (NULL != get_skip_index_aggr() && OB_FAIL(skip_index_aggr_.update(row_to_append->row_val_))) {
+          STORAGE_LOG(WARN, "fail to update skip index", K(ret));
         }
         if (OB_SUCC(ret) && data_store_desc_->need_prebuild_bloomfilter_) {
           const ObStoreRowkey rowkey(row_to_append->row_val_.cells_, data_store_desc_->bloomfilter_rowkey_prefix_);
@@ -313,6 +340,8 @@ int ObMacroBlockWriter::append_row(const ObStoreRow& row, const int64_t split_si
       }
       if (data_store_desc_->need_calc_column_checksum_ && OB_FAIL(add_row_checksum(row_to_append->row_val_))) {
         STORAGE_LOG(WARN, "fail to add column checksum", K(ret));
+      } else if (NULL != get_skip_index_aggr() && OB_FAIL(skip_index_aggr_.update(row_to_append->row_val_))) {
+        STORAGE_LOG(WARN, "fail to update skip index", K(ret));
       } else if (micro_writer_->get_block_size() >= split_size) {
         if (OB_FAIL(build_micro_block())) {
           STORAGE_LOG(WARN, "Fail to build micro block, ", K(ret));
@@ -916,6 +945,7 @@ int ObMacroBlockWriter::build_micro_block(const bool force_split)
     micro_block_desc.can_mark_deletion_ = mark_deletion;
     micro_block_desc.column_checksums_ =
         data_store_desc_->need_calc_column_checksum_ ? curr_micro_column_checksum_ : NULL;
+    micro_block_desc.skip_index_ = get_skip_index_aggr();
     if (data_store_desc_->is_multi_version_minor_sstable()) {
       micro_block_desc.max_merged_trans_version_ = micro_writer_->get_max_merged_trans_version();
       micro_block_desc.contain_uncommitted_row_ = micro_writer_->is_contain_uncommitted_row();
@@ -984,6 +1014,8 @@ int ObMacroBlockWriter::build_micro_block_desc_with_reuse(
     micro_block_desc.column_checksums_ = micro_block.column_checksums_;
     micro_block_desc.buf_size_ = micro_block.payload_data_.get_buf_size();
     micro_block_desc.buf_ = micro_block.payload_data_.get_buf();
+    // rows of the reused micro block are not iterated, its skip index entry has no aggregates
+    micro_block_desc.skip_index_ = get_skip_index_aggr();
   }
   STORAGE_LOG(
       DEBUG, "build micro block desc reuse", K(data_store_desc_->table_id_), K(micro_block_desc), "lbt", lbt(), K(ret));
@@ -1046,6 +1078,11 @@ int ObMacroBlockWriter::build_micro_block_desc_with_rewrite(
           STORAGE_LOG(WARN, "fail to calc micro block column checksum", K(ret));
         }
       }
+      if (OB_SUCC(ret) && NULL != (micro_block_desc.skip_index_ = get_skip_index_aggr())) {
+        if (OB_FAIL(calc_micro_skip_index(*reader))) {
+          STORAGE_LOG(WARN, "fail to calc micro block skip index", K(ret));
+        }
+      }
     }
   }
   STORAGE_LOG(DEBUG,
@@ -1121,6 +1158,10 @@ int ObMacroBlockWriter::write_micro_block(const ObMicroBlockDesc& micro_block_de
     MEMSET(curr_micro_column_checksum_, 0, sizeof(int64_t) * data_store_desc_->row_column_count_);
   }
 
+  if (OB_SUCC(ret) && NULL != get_skip_index_aggr()) {
+    skip_index_aggr_.reuse();
+  }
+
   return ret;
 }
 
@@ -1307,7 +1348,10 @@ int ObMacroBlockWriter::check_micro_block_need_merge(const ObMicroBlock& micro_b
     ret = OB_INVALID_ARGUMENT;
     STORAGE_LOG(WARN, "invalid micro_block", K(micro_block), K(ret));
   } else {
-    if (micro_writer_->get_row_count() <= 0 &&
+    if (micro_block.row_store_type_ != data_store_desc_->row_store_type_) {
+      // all micro blocks of one macro block share the same row store type
+      need_merge = true;
+    } else if (micro_writer_->get_row_count() <= 0 &&
         micro_block.origin_data_size_ > data_store_desc_->micro_block_size_ / 2) {
       need_merge = false;
     } else if (micro_writer_->get_block_size() > data_store_desc_->micro_block_size_ / 2 &&
@@ -1494,6 +1538,24 @@ int ObMacroBlockWriter::calc_micro_column_checksum(
   return ret;
 }
 
+int ObMacroBlockWriter::calc_micro_skip_index(ObIMicroBlockReader& reader)
+{
+  int ret = OB_SUCCESS;
+  ObStoreRow row;
+  skip_index_aggr_.reuse();
+  for (int64_t iter = reader.begin(); OB_SUCC(ret) && iter != reader.end(); ++iter) {
+    row.row_val_.cells_ = reinterpret_cast<ObObj*>(checker_obj_buf_);
+    row.row_val_.count_ = OB_ROW_MAX_COLUMNS_COUNT;
+    row.capacity_ = OB_ROW_MAX_COLUMNS_COUNT;
+    if (OB_FAIL(reader.get_row(iter, row))) {
+      STORAGE_LOG(WARN, "fail to get row", K(ret), K(iter));
+    } else if (OB_FAIL(skip_index_aggr_.update(row.row_val_))) {
+      STORAGE_LOG(WARN, "fail to update skip index", K(ret), K(row));
+    }
+  }
+  return ret;
+}
+
 OB_INLINE ObIMicroBlockReader* ObMacroBlockWriter::get_micro_block_reader(const int64_t row_store_type)
 {
   ObIMicroBlockReader* reader = NULL;
@@ -1506,6 +1568,10 @@ OB_INLINE ObIMicroBlockReader* ObMacroBlockWriter::get_micro_block_reader(const
       reader = &sparse_reader_;
       break;
     }
+    case ENCODING_ROW_STORE: {
+      reader = &encoding_reader_;
+      break;
+    }
     default:
       STORAGE_LOG(WARN, "invalid store type", K(row_store_type));
       break;
@@ -1569,6 +1635,10 @@ int ObMacroBlockWriter::prepare_micro_block_reader(
       micro_reader = static_cast<ObIMicroBlockReader*>(&check_sparse_reader_);
       read_out_type = SPARSE_ROW_STORE;  // read row type is sparse row
       column_map_ptr = nullptr;          // make reader read full sparse row
+    } else if (ENCODING_ROW_STORE == data_store_desc_->row_store_type_) {
+      micro_reader = static_cast<ObIMicroBlockReader*>(&check_encoding_reader_);
+      read_out_type = FLAT_ROW_STORE;
+      column_map_ptr = &column_map_;
     } else {
       ret = OB_NOT_SUPPORTED;
       STORAGE_LOG(WARN, "Unexpeceted row store type", K(ret), K(data_store_desc_->row_store_type_));
@@ -30,6 +30,8 @@
 #include "storage/blocksstable/ob_store_file_system.h"
 #include "storage/blocksstable/ob_macro_block_reader.h"
 #include "storage/blocksstable/ob_sparse_micro_block_reader.h"
+#include "storage/blocksstable/ob_micro_block_encoder.h"
+#include "storage/blocksstable/ob_micro_block_decoder.h"
 #include "storage/ob_pg_mgr.h"
 #include "ob_block_index_intermediate.h"
 
@@ -124,6 +126,11 @@ private:
   int save_pre_micro_last_key(const ObStoreRowkey& pre_micro_last_key);
   int add_row_checksum(const common::ObNewRow& row);
   int calc_micro_column_checksum(const int64_t column_cnt, ObIMicroBlockReader& reader, int64_t* column_checksum);
+  int calc_micro_skip_index(ObIMicroBlockReader& reader);
+  OB_INLINE ObSkipIndexAggregator* get_skip_index_aggr()
+  {
+    return skip_index_aggr_.is_inited() && skip_index_aggr_.get_column_count() > 0 ? &skip_index_aggr_ : NULL;
+  }
   int flush_reuse_macro_block(const ObMacroBlockCtx& macro_block_ctx);
   ObIMicroBlockReader* get_micro_block_reader(const int64_t row_store_type);
   inline bool enable_sparse_format() const
@@ -182,6 +189,8 @@ private:
   char rowkey_buf_[common::OB_MAX_ROW_KEY_LENGTH];
   ObMicroBlockReader flat_reader_;
   ObSparseMicroBlockReader sparse_reader_;
+  ObMicroBlockEncoder encoding_writer_;
+  ObMicroBlockDecoder encoding_reader_;
   ObMacroBlockWriter* sstable_index_writer_;
   ObMacroBlockWriter* task_index_writer_;
   ObMacroBlock macro_blocks_[2];
@@ -202,6 +211,7 @@ private:
   bool has_lob_;
   blocksstable::ObLobMergeWriter lob_writer_;
   int64_t* curr_micro_column_checksum_;
+  ObSkipIndexAggregator skip_index_aggr_;  // min/max/null count of the current micro block
   common::ObArenaAllocator allocator_;
   ObColumnMap column_map_;
   ObColumnMap index_column_map_;
@@ -211,6 +221,7 @@ private:
                                                                                     // NOT use same buf of data row
   ObMicroBlockReader check_flat_reader_;
   ObSparseMicroBlockReader check_sparse_reader_;
+  ObMicroBlockDecoder check_encoding_reader_;
   common::ObArray<uint32_t> micro_rowkey_hashs_;
   storage::ObSSTableRowkeyHelper* rowkey_helper_;
   ObSSTableMacroBlockChecker macro_block_checker_;
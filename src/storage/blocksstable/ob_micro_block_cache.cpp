@@ -17,6 +17,7 @@
 #include "lib/stat/ob_diagnose_info.h"
 #include "storage/ob_sstable.h"
 #include "storage/ob_partition_service.h"
+#include "ob_storage_cache_suite.h"
 
 namespace oceanbase {
 using namespace common;
@@ -255,6 +256,7 @@ int ObIMicroBlockCache::prefetch(const uint64_t table_id, const ObMacroBlockCtx&
     callback.offset_ = offset;
     callback.size_ = size;
     callback.use_block_cache_ = flag.is_use_block_cache();
+    callback.is_bulk_read_ = flag.is_bulk_read();
     // fill read info
     read_info.macro_block_ctx_ = &block_ctx;
     read_info.io_desc_.category_ = flag.is_prewarm() ? PREWARM_IO
@@ -309,6 +311,7 @@ int ObIMicroBlockCache::prefetch(const uint64_t table_id, const ObMacroBlockCtx&
     callback.offset_ = offset;
     callback.size_ = size;
     callback.use_block_cache_ = flag.is_use_block_cache();
+    callback.is_bulk_read_ = flag.is_bulk_read();
     // fill read info
     ObMacroBlockReadInfo read_info;
     read_info.io_callback_ = &callback;
@@ -351,9 +354,18 @@ int ObIMicroBlockCache::get_cache_block(const uint64_t table_id, const MacroBloc
     STORAGE_LOG(WARN, "get_cache failed", K(ret));
   } else {
     ObMicroBlockCacheKey key(table_id, block_id, file_id, offset, size);
+    ObMicroBlockDiskCache& disk_cache = OB_STORE_CACHE.get_micro_block_disk_cache();
     if (OB_FAIL(cache->get(key, handle.micro_block_, handle.handle_))) {
       if (OB_ENTRY_NOT_EXIST != ret) {
         STORAGE_LOG(WARN, "Fail to get micro block from block cache, ", K(ret));
+      } else if (disk_cache.is_enabled()) {
+        // read through the disk tier, the micro block is put back into memory on hit
+        if (OB_FAIL(disk_cache.get(key, *cache, handle.micro_block_, handle.handle_))) {
+          if (OB_ENTRY_NOT_EXIST != ret) {
+            STORAGE_LOG(WARN, "Fail to get micro block from disk cache, ", K(ret));
+            ret = OB_ENTRY_NOT_EXIST;
+          }
+        }
       }
       EVENT_INC(ObStatEventIds::BLOCK_CACHE_MISS);
     } else {
@@ -432,7 +444,8 @@ ObIMicroBlockCache::ObIMicroBlockIOCallback::ObIMicroBlockIOCallback()
       file_id_(0),
       offset_(0),
       size_(0),
-      use_block_cache_(true)
+      use_block_cache_(true),
+      is_bulk_read_(false)
 {
   static_assert(sizeof(*this) <= CALLBACK_BUF_SIZE, "IOCallback buf size not enough");
 }
@@ -493,7 +506,8 @@ int ObIMicroBlockCache::ObIMicroBlockIOCallback::put_cache_and_fetch(const ObFul
                  value_size,
                  kvpair,
                  handle,
-                 inst_handle))) {
+                 inst_handle,
+                 is_bulk_read_ ? SCAN : LRU))) {
     LOG_WARN("failed to alloc cache buf", K(ret));
   } else {
     char* block_buf = reinterpret_cast<char*>(kvpair->value_) + sizeof(ObMicroBlockCacheValue);
@@ -503,6 +517,8 @@ int ObIMicroBlockCache::ObIMicroBlockIOCallback::put_cache_and_fetch(const ObFul
     if (OB_FAIL(reader.decompress_data_with_prealloc_buf(
             meta.schema_->compressor_, payload_buf, payload_size, block_buf, common_header->data_length_))) {
       LOG_WARN("failed to decompress_data_with_prealloc_buf", K(ret));
+      // never put, keep it away from the wash listener
+      kvpair->value_ = nullptr;
     } else {
       micro_block = cache_value;
       if (OB_FAIL(cache_->put_kvpair(inst_handle, kvpair, handle, overwrite))) {
@@ -607,6 +623,7 @@ int ObIMicroBlockCache::ObIMicroBlockIOCallback::assign(const ObIMicroBlockIOCal
   offset_ = other.offset_;
   size_ = other.size_;
   use_block_cache_ = other.use_block_cache_;
+  is_bulk_read_ = other.is_bulk_read_;
   if (OB_FAIL(table_handle_.assign(other.table_handle_))) {
     STORAGE_LOG(WARN, "fail to assign table handle", K(ret));
   }
@@ -37,6 +37,26 @@ public:
   virtual int deep_copy(char* buf, const int64_t buf_len, ObIKVCacheKey*& key) const;
   void set(const uint64_t table_id, const MacroBlockId& block_id, const int64_t file_id, const int64_t offset,
       const int64_t size);
+  inline uint64_t get_table_id() const
+  {
+    return table_id_;
+  }
+  inline const MacroBlockId& get_block_id() const
+  {
+    return block_id_;
+  }
+  inline int64_t get_file_id() const
+  {
+    return file_id_;
+  }
+  inline int64_t get_offset() const
+  {
+    return offset_;
+  }
+  inline int64_t get_size() const
+  {
+    return size_;
+  }
   TO_STRING_KV(K_(table_id), K_(block_id), K_(file_id), K_(offset), K_(size));
 
 private:
@@ -206,6 +226,7 @@ public:
     int64_t offset_;
     int64_t size_;
     bool use_block_cache_;
+    bool is_bulk_read_;  // put into SCAN memblocks, see ObKVCachePolicy
     storage::ObTableHandle table_handle_;
   };
   class ObMicroBlockIOCallback : public ObIMicroBlockIOCallback {
@@ -0,0 +1,1144 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX STORAGE
+
+#include "ob_micro_block_decoder.h"
+#include <algorithm>
+#include "ob_row_reader.h"
+#include "lib/container/ob_bitmap.h"
+#include "storage/ob_sstable_rowkey_helper.h"
+#include "sql/engine/basic/ob_pushdown_filter.h"
+
+namespace oceanbase {
+using namespace common;
+using namespace storage;
+namespace blocksstable {
+/**
+ * -------------------------------------------------------ObColumnDecoder--------------------------------------------------------------
+ */
+ObColumnDecoder::ObColumnDecoder()
+{
+  reset();
+}
+
+void ObColumnDecoder::reset()
+{
+  header_.reset();
+  row_count_ = 0;
+  null_bitmap_ = NULL;
+  payload_ = NULL;
+  payload_len_ = 0;
+  base_ = 0;
+  width_ = 0;
+  packed_ = NULL;
+  ref_width_ = 0;
+  refs_ = NULL;
+  entry_count_ = 0;
+  run_ends_ = NULL;
+  offsets_ = NULL;
+  bytes_ = NULL;
+}
+
+int ObColumnDecoder::parse_packed(
+    const char*& pos, const char* end, const int64_t count, uint64_t& base, int64_t& width, const char*& packed)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(pos + sizeof(uint64_t) + sizeof(uint8_t) > end)) {
+    ret = OB_INVALID_DATA;
+    LOG_WARN("packed values out of column data", K(ret), KP(pos), KP(end));
+  } else {
+    MEMCPY(&base, pos, sizeof(base));
+    width = *reinterpret_cast<const uint8_t*>(pos + sizeof(uint64_t));
+    packed = pos + sizeof(uint64_t) + sizeof(uint8_t);
+    pos = packed + ObEncodingUtil::get_packed_size(count, width);
+    if (OB_UNLIKELY(width > 64 || pos > end)) {
+      ret = OB_INVALID_DATA;
+      LOG_WARN("invalid packed values", K(ret), K(width), K(count), KP(pos), KP(end));
+    }
+  }
+  return ret;
+}
+
+int ObColumnDecoder::init(
+    const char* block, const int64_t block_size, const ObEncodingColumnHeader& header, const int64_t row_count)
+{
+  int ret = OB_SUCCESS;
+  reset();
+  if (OB_ISNULL(block) || OB_UNLIKELY(!header.is_valid() || row_count <= 0 ||
+                                      header.offset_ + static_cast<int64_t>(header.length_) > block_size)) {
+    ret = OB_INVALID_DATA;
+    LOG_WARN("invalid column header", K(ret), KP(block), K(block_size), K(header), K(row_count));
+  } else {
+    header_ = header;
+    row_count_ = row_count;
+    const char* pos = block + header.offset_;
+    const char* end = pos + header.length_;
+    if (header.is_all_null()) {
+      // no payload
+    } else {
+      if (header.has_null()) {
+        null_bitmap_ = pos;
+        pos += ObEncodingUtil::get_bitmap_size(row_count);
+      }
+      payload_ = pos;
+      payload_len_ = end - pos;
+      const bool is_int = OB_DOMAIN_INT == header.domain_;
+      uint64_t ref_base = 0;
+      switch (header.type_) {
+        case OB_ENCODING_CONST: {
+          if (is_int) {
+            if (OB_UNLIKELY(payload_len_ < static_cast<int64_t>(sizeof(uint64_t)))) {
+              ret = OB_INVALID_DATA;
+            } else {
+              MEMCPY(&base_, pos, sizeof(base_));
+            }
+          } else {
+            offsets_ = pos;
+            bytes_ = pos + 2 * sizeof(uint32_t);
+          }
+          break;
+        }
+        case OB_ENCODING_INTEGER: {
+          ret = is_int ? parse_packed(pos, end, row_count, base_, width_, packed_) : OB_INVALID_DATA;
+          break;
+        }
+        case OB_ENCODING_DICT: {
+          entry_count_ = ObEncodingUtil::read_uint32(pos, 0);
+          pos += sizeof(uint32_t);
+          if (is_int) {
+            ret = parse_packed(pos, end, entry_count_, base_, width_, packed_);
+          } else {
+            offsets_ = pos;
+            bytes_ = offsets_ + sizeof(uint32_t) * (entry_count_ + 1);
+            pos = bytes_ + ObEncodingUtil::read_uint32(offsets_, entry_count_);
+          }
+          if (OB_SUCC(ret)) {
+            ret = parse_packed(pos, end, row_count, ref_base, ref_width_, refs_);
+          }
+          break;
+        }
+        case OB_ENCODING_RLE: {
+          entry_count_ = ObEncodingUtil::read_uint32(pos, 0);
+          run_ends_ = pos + sizeof(uint32_t);
+          pos = run_ends_ + sizeof(uint32_t) * entry_count_;
+          if (is_int) {
+            ret = parse_packed(pos, end, entry_count_, base_, width_, packed_);
+          } else {
+            offsets_ = pos;
+            bytes_ = offsets_ + sizeof(uint32_t) * (entry_count_ + 1);
+          }
+          break;
+        }
+        case OB_ENCODING_RAW:
+        case OB_ENCODING_PREFIX: {
+          if (is_int || (OB_ENCODING_PREFIX == header.type_ && OB_DOMAIN_STRING != header.domain_)) {
+            ret = OB_INVALID_DATA;
+          } else {
+            offsets_ = pos;
+            bytes_ = offsets_ + sizeof(uint32_t) * (row_count + 1);
+          }
+          break;
+        }
+        default: {
+          ret = OB_INVALID_DATA;
+          break;
+        }
+      }
+      if (OB_SUCC(ret) && OB_UNLIKELY(bytes_ > end)) {
+        ret = OB_INVALID_DATA;
+      }
+      if (OB_FAIL(ret)) {
+        LOG_WARN("invalid encoded column", K(ret), K(header), K(row_count), K_(payload_len));
+      }
+    }
+  }
+  return ret;
+}
+
+OB_INLINE int64_t ObColumnDecoder::find_run(const int64_t row_idx) const
+{
+  // first run whose end is larger than row_idx
+  int64_t low = 0;
+  int64_t high = entry_count_ - 1;
+  while (low < high) {
+    const int64_t mid = (low + high) >> 1;
+    if (ObEncodingUtil::read_uint32(run_ends_, mid) > row_idx) {
+      high = mid;
+    } else {
+      low = mid + 1;
+    }
+  }
+  return low;
+}
+
+OB_INLINE uint64_t ObColumnDecoder::get_int(const int64_t row_idx) const
+{
+  uint64_t value = base_;
+  switch (header_.type_) {
+    case OB_ENCODING_INTEGER: {
+      value += ObEncodingUtil::unpack(packed_, row_idx, width_);
+      break;
+    }
+    case OB_ENCODING_DICT: {
+      value += ObEncodingUtil::unpack(packed_, ObEncodingUtil::unpack(refs_, row_idx, ref_width_), width_);
+      break;
+    }
+    case OB_ENCODING_RLE: {
+      value += ObEncodingUtil::unpack(packed_, find_run(row_idx), width_);
+      break;
+    }
+    default: {
+      // const
+      break;
+    }
+  }
+  return value;
+}
+
+int ObColumnDecoder::get_bytes(const int64_t row_idx, ObIAllocator& allocator, const char*& ptr, int64_t& len) const
+{
+  int ret = OB_SUCCESS;
+  if (OB_ENCODING_PREFIX == header_.type_) {
+    // rebuild the value from the nearest restart point
+    const int64_t restart = row_idx - row_idx % ObEncodingUtil::PREFIX_RESTART_INTERVAL;
+    int64_t max_len = 0;
+    for (int64_t i = restart; i <= row_idx; ++i) {
+      const uint32_t start = ObEncodingUtil::read_uint32(offsets_, i);
+      const uint32_t end = ObEncodingUtil::read_uint32(offsets_, i + 1);
+      uint16_t prefix = 0;
+      MEMCPY(&prefix, bytes_ + start, sizeof(prefix));
+      max_len = std::max(max_len, static_cast<int64_t>(prefix + end - start - sizeof(uint16_t)));
+    }
+    char* buf = NULL;
+    if (0 == max_len) {
+      ptr = bytes_;
+      len = 0;
+    } else if (OB_ISNULL(buf = static_cast<char*>(allocator.alloc(max_len)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("fail to allocate prefix buffer", K(ret), K(max_len));
+    } else {
+      for (int64_t i = restart; i <= row_idx; ++i) {
+        const uint32_t start = ObEncodingUtil::read_uint32(offsets_, i);
+        const uint32_t end = ObEncodingUtil::read_uint32(offsets_, i + 1);
+        const int64_t suffix_len = end - start - sizeof(uint16_t);
+        uint16_t prefix = 0;
+        MEMCPY(&prefix, bytes_ + start, sizeof(prefix));
+        MEMCPY(buf + prefix, bytes_ + start + sizeof(uint16_t), suffix_len);
+        len = prefix + suffix_len;
+      }
+      ptr = buf;
+    }
+  } else {
+    int64_t idx = 0;
+    switch (header_.type_) {
+      case OB_ENCODING_RAW: {
+        idx = row_idx;
+        break;
+      }
+      case OB_ENCODING_DICT: {
+        idx = ObEncodingUtil::unpack(refs_, row_idx, ref_width_);
+        break;
+      }
+      case OB_ENCODING_RLE: {
+        idx = find_run(row_idx);
+        break;
+      }
+      default: {
+        // const
+        break;
+      }
+    }
+    const uint32_t start = ObEncodingUtil::read_uint32(offsets_, idx);
+    ptr = bytes_ + start;
+    len = ObEncodingUtil::read_uint32(offsets_, idx + 1) - start;
+  }
+  return ret;
+}
+
+int ObColumnDecoder::bytes_to_obj(const char* ptr, const int64_t len, ObObj& obj) const
+{
+  int ret = OB_SUCCESS;
+  if (OB_DOMAIN_STRING == header_.domain_) {
+    obj.set_meta_type(header_.meta_);
+    obj.v_.string_ = ptr;
+    obj.val_len_ = static_cast<int32_t>(len);
+  } else {
+    int64_t pos = 0;
+    if (OB_FAIL(obj.deserialize(ptr, len, pos))) {
+      LOG_WARN("fail to deserialize cell", K(ret), K(len));
+    }
+  }
+  return ret;
+}
+
+int ObColumnDecoder::decode(const int64_t row_idx, ObIAllocator& allocator, ObObj& obj) const
+{
+  int ret = OB_SUCCESS;
+  if (header_.is_all_null() || is_null(row_idx)) {
+    obj.set_null();
+  } else if (OB_DOMAIN_INT == header_.domain_) {
+    ObEncodingUtil::set_int_value(header_.meta_, get_int(row_idx), obj);
+  } else {
+    const char* ptr = NULL;
+    int64_t len = 0;
+    if (OB_FAIL(get_bytes(row_idx, allocator, ptr, len))) {
+      LOG_WARN("fail to get bytes", K(ret), K(row_idx));
+    } else if (OB_FAIL(bytes_to_obj(ptr, len, obj))) {
+      LOG_WARN("fail to decode bytes", K(ret), K(row_idx));
+    }
+  }
+  return ret;
+}
+
+int ObColumnDecoder::batch_decode(
+    const int64_t* row_ids, const int64_t row_cnt, ObIAllocator& allocator, ObObj* objs) const
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(row_ids) || OB_ISNULL(objs)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(row_ids), KP(objs));
+  } else if (header_.is_all_null()) {
+    for (int64_t i = 0; i < row_cnt; ++i) {
+      objs[i].set_null();
+    }
+  } else if (OB_DOMAIN_INT == header_.domain_) {
+    // dispatch once per batch instead of once per cell
+    const ObObjMeta& meta = header_.meta_;
+    switch (header_.type_) {
+      case OB_ENCODING_CONST: {
+        for (int64_t i = 0; i < row_cnt; ++i) {
+          ObEncodingUtil::set_int_value(meta, base_, objs[i]);
+        }
+        break;
+      }
+      case OB_ENCODING_INTEGER: {
+        for (int64_t i = 0; i < row_cnt; ++i) {
+          ObEncodingUtil::set_int_value(meta, base_ + ObEncodingUtil::unpack(packed_, row_ids[i], width_), objs[i]);
+        }
+        break;
+      }
+      default: {
+        for (int64_t i = 0; i < row_cnt; ++i) {
+          ObEncodingUtil::set_int_value(meta, get_int(row_ids[i]), objs[i]);
+        }
+        break;
+      }
+    }
+    if (NULL != null_bitmap_) {
+      for (int64_t i = 0; i < row_cnt; ++i) {
+        if (is_null(row_ids[i])) {
+          objs[i].set_null();
+        }
+      }
+    }
+  } else {
+    for (int64_t i = 0; OB_SUCC(ret) && i < row_cnt; ++i) {
+      if (OB_FAIL(decode(row_ids[i], allocator, objs[i]))) {
+        LOG_WARN("fail to decode cell", K(ret), K(i), K(row_ids[i]));
+      }
+    }
+  }
+  return ret;
+}
+
+int ObColumnDecoder::decode_entry(const int64_t entry_idx, ObObj& obj) const
+{
+  int ret = OB_SUCCESS;
+  if (OB_DOMAIN_INT == header_.domain_) {
+    uint64_t value = base_;
+    if (OB_ENCODING_CONST != header_.type_) {
+      value += ObEncodingUtil::unpack(packed_, entry_idx, width_);
+    }
+    ObEncodingUtil::set_int_value(header_.meta_, value, obj);
+  } else {
+    const uint32_t start = ObEncodingUtil::read_uint32(offsets_, entry_idx);
+    const int64_t len = ObEncodingUtil::read_uint32(offsets_, entry_idx + 1) - start;
+    if (OB_FAIL(bytes_to_obj(bytes_ + start, len, obj))) {
+      LOG_WARN("fail to decode entry", K(ret), K(entry_idx));
+    }
+  }
+  return ret;
+}
+
+int ObColumnDecoder::filter_entries(const sql::ObWhiteFilterExecutor& filter, const int64_t begin_index,
+    const int64_t row_count, ObIAllocator& allocator, ObBitmap& result_bitmap) const
+{
+  int ret = OB_SUCCESS;
+  ObObj cell;
+  bool null_filtered = true;
+  bool filtered = true;
+  cell.set_null();
+  if (OB_FAIL(filter.filter(cell, null_filtered))) {
+    LOG_WARN("fail to filter null cell", K(ret));
+  } else if (header_.is_all_null()) {
+    for (int64_t i = 0; OB_SUCC(ret) && !null_filtered && i < row_count; ++i) {
+      ret = result_bitmap.set(i);
+    }
+  } else if (OB_ENCODING_CONST == header_.type_) {
+    if (OB_FAIL(decode_entry(0, cell))) {
+      LOG_WARN("fail to decode const entry", K(ret));
+    } else if (OB_FAIL(filter.filter(cell, filtered))) {
+      LOG_WARN("fail to filter const entry", K(ret), K(cell));
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && i < row_count; ++i) {
+      if (!(is_null(begin_index + i) ? null_filtered : filtered)) {
+        ret = result_bitmap.set(i);
+      }
+    }
+  } else if (OB_ENCODING_DICT == header_.type_) {
+    bool* entry_filtered = NULL;
+    if (OB_ISNULL(entry_filtered = static_cast<bool*>(allocator.alloc(sizeof(bool) * entry_count_)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("fail to allocate dict filter result", K(ret), K_(entry_count));
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && i < entry_count_; ++i) {
+      if (OB_FAIL(decode_entry(i, cell))) {
+        LOG_WARN("fail to decode dict entry", K(ret), K(i));
+      } else if (OB_FAIL(filter.filter(cell, entry_filtered[i]))) {
+        LOG_WARN("fail to filter dict entry", K(ret), K(i), K(cell));
+      }
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && i < row_count; ++i) {
+      const int64_t row_idx = begin_index + i;
+      if (is_null(row_idx) ? !null_filtered : !entry_filtered[ObEncodingUtil::unpack(refs_, row_idx, ref_width_)]) {
+        ret = result_bitmap.set(i);
+      }
+    }
+  } else if (OB_ENCODING_RLE == header_.type_) {
+    int64_t run = find_run(begin_index);
+    int64_t run_end = -1;
+    for (int64_t i = 0; OB_SUCC(ret) && i < row_count; ++i) {
+      const int64_t row_idx = begin_index + i;
+      if (row_idx >= run_end) {
+        // first row or entering the next run
+        run += run_end < 0 ? 0 : 1;
+        run_end = ObEncodingUtil::read_uint32(run_ends_, run);
+        if (OB_FAIL(decode_entry(run, cell))) {
+          LOG_WARN("fail to decode rle entry", K(ret), K(run));
+        } else if (OB_FAIL(filter.filter(cell, filtered))) {
+          LOG_WARN("fail to filter rle entry", K(ret), K(run), K(cell));
+        }
+      }
+      if (OB_SUCC(ret) && !(is_null(row_idx) ? null_filtered : filtered)) {
+        ret = result_bitmap.set(i);
+      }
+    }
+  } else {
+    ret = OB_NOT_SUPPORTED;
+  }
+  return ret;
+}
+
+/**
+ * -------------------------------------------------------ObMicroBlockDecoder--------------------------------------------------------------
+ */
+class ObEncodingRowkeyCompare {
+public:
+  ObEncodingRowkeyCompare(int& ret, bool& equal, ObMicroBlockDecoder& decoder, const int64_t compare_column_count)
+      : ret_(ret), equal_(equal), decoder_(decoder), compare_column_count_(compare_column_count)
+  {}
+  inline bool operator()(const int64_t row_idx, const ObStoreRowkey& rowkey)
+  {
+    return compare(row_idx, rowkey, true);
+  }
+  inline bool operator()(const ObStoreRowkey& rowkey, const int64_t row_idx)
+  {
+    return compare(row_idx, rowkey, false);
+  }
+
+private:
+  inline bool compare(const int64_t row_idx, const ObStoreRowkey& rowkey, const bool lower_bound)
+  {
+    bool bret = false;
+    int& ret = ret_;
+    int32_t compare_result = 0;
+    ObObj cell;
+    for (int64_t i = 0; OB_SUCC(ret) && 0 == compare_result && i < compare_column_count_; ++i) {
+      if (OB_FAIL(decoder_.get_cell(row_idx, i, cell))) {
+        LOG_WARN("fail to get rowkey cell", K(ret), K(row_idx), K(i));
+      } else {
+        compare_result = cell.compare(rowkey.get_obj_ptr()[i], common::CS_TYPE_INVALID);
+      }
+    }
+    if (OB_SUCC(ret)) {
+      bret = lower_bound ? compare_result < 0 : compare_result > 0;
+      // binary search will keep searching after find the first equal item,
+      // if we need the equal reuslt, must prevent it from being modified again
+      if (0 == compare_result && !equal_) {
+        equal_ = true;
+      }
+    }
+    return bret;
+  }
+
+private:
+  int& ret_;
+  bool& equal_;
+  ObMicroBlockDecoder& decoder_;
+  int64_t compare_column_count_;
+};
+
+ObMicroBlockDecoder::ObMicroBlockDecoder()
+    : header_(NULL),
+      column_count_(0),
+      decoders_(NULL),
+      row_header_(),
+      allocator_(ObModIds::OB_STORE_ROW_GETTER),
+      decoder_allocator_(ObModIds::OB_STORE_ROW_GETTER)
+{}
+
+ObMicroBlockDecoder::~ObMicroBlockDecoder()
+{
+  reset();
+}
+
+void ObMicroBlockDecoder::reset()
+{
+  ObIMicroBlockReader::reset();
+  header_ = NULL;
+  column_count_ = 0;
+  decoders_ = NULL;
+  allocator_.reuse();
+  decoder_allocator_.reuse();
+}
+
+int ObMicroBlockDecoder::base_init(const ObMicroBlockData& block_data)
+{
+  int ret = OB_SUCCESS;
+  void* buf = NULL;
+  if (OB_UNLIKELY(!block_data.is_valid() || block_data.get_buf_size() < static_cast<int64_t>(sizeof(ObMicroBlockHeader)))) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("argument is invalid", K(ret), K(block_data));
+  } else {
+    const char* block = block_data.get_buf();
+    const int64_t block_size = block_data.get_buf_size();
+    header_ = reinterpret_cast<const ObMicroBlockHeader*>(block);
+    column_count_ = header_->column_count_;
+    const int64_t header_count = column_count_ + 1;
+    if (OB_UNLIKELY(MICRO_BLOCK_HEADER_MAGIC != header_->magic_ || column_count_ <= 0 ||
+                    header_->header_size_ + static_cast<int64_t>(sizeof(ObEncodingColumnHeader)) * header_count >
+                        block_size)) {
+      ret = OB_INVALID_DATA;
+      LOG_WARN("invalid encoding micro block header", K(ret), KPC_(header), K(block_size));
+    } else if (OB_ISNULL(buf = decoder_allocator_.alloc(sizeof(ObColumnDecoder) * header_count))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("fail to allocate column decoders", K(ret), K(header_count));
+    } else {
+      decoders_ = static_cast<ObColumnDecoder*>(buf);
+      const char* column_headers = block + header_->header_size_;
+      for (int64_t i = 0; OB_SUCC(ret) && i < header_count; ++i) {
+        ObEncodingColumnHeader column_header;
+        MEMCPY(&column_header, column_headers + i * sizeof(ObEncodingColumnHeader), sizeof(column_header));
+        new (decoders_ + i) ObColumnDecoder();
+        if (OB_FAIL(decoders_[i].init(block, block_size, column_header, header_->row_count_))) {
+          LOG_WARN("fail to init column decoder", K(ret), K(i), K(column_header));
+        }
+      }
+      if (OB_SUCC(ret)) {
+        begin_ = 0;
+        end_ = header_->row_count_;
+      }
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockDecoder::init(
+    const ObMicroBlockData& block_data, const ObColumnMap* column_map, const ObRowStoreType out_type)
+{
+  int ret = OB_SUCCESS;
+  if (is_inited_) {
+    reset();
+  }
+  if (OB_UNLIKELY(NULL == column_map || !column_map->is_valid())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("column_map is invalid", K(ret), KP(column_map));
+  } else if (OB_UNLIKELY(FLAT_ROW_STORE != out_type)) {
+    ret = OB_NOT_SUPPORTED;
+    LOG_WARN("encoding micro block only outputs flat row", K(ret), K(out_type));
+  } else if (OB_FAIL(base_init(block_data))) {
+    LOG_WARN("fail to init, ", K(ret));
+  } else {
+    column_map_ = column_map;
+    output_row_type_ = out_type;
+    is_inited_ = true;
+  }
+  return ret;
+}
+
+int ObMicroBlockDecoder::init(const ObMicroBlockData& block_data)
+{
+  int ret = OB_SUCCESS;
+  if (is_inited_) {
+    reset();
+  }
+  if (OB_FAIL(base_init(block_data))) {
+    LOG_WARN("fail to init, ", K(ret));
+  } else {
+    output_row_type_ = FLAT_ROW_STORE;
+    is_inited_ = true;
+  }
+  return ret;
+}
+
+int ObMicroBlockDecoder::decode_row_header(const int64_t row_idx, ObRowHeader& row_header)
+{
+  int ret = OB_SUCCESS;
+  ObObj value;
+  if (OB_FAIL(decoders_[column_count_].decode(row_idx, allocator_, value))) {
+    LOG_WARN("fail to decode row header", K(ret), K(row_idx));
+  } else {
+    const uint64_t v = value.v_.uint64_;
+    row_header.set_row_flag(static_cast<int8_t>(v & 0xFF));
+    row_header.set_row_dml(static_cast<int8_t>((v >> 8) & 0xFF));
+    row_header.set_row_type_flag(static_cast<int8_t>((v >> 16) & 0xFF));
+    row_header.set_version(ObRowHeader::RHV_NO_TRANS_ID);
+    row_header.set_column_index_bytes(0);
+    row_header.set_column_count(static_cast<int16_t>(column_count_));
+  }
+  return ret;
+}
+
+int ObMicroBlockDecoder::fill_row_header(const int64_t row_idx, ObStoreRow& row)
+{
+  int ret = OB_SUCCESS;
+  ObRowHeader row_header;
+  if (OB_FAIL(decode_row_header(row_idx, row_header))) {
+    LOG_WARN("fail to decode row header", K(ret), K(row_idx));
+  } else {
+    row.is_sparse_row_ = false;
+    row.flag_ = row_header.get_row_flag();
+    row.set_dml_val(row_header.get_row_dml());
+    row.row_type_flag_.flag_ = row_header.get_row_type_flag();
+  }
+  return ret;
+}
+
+OB_INLINE int ObMicroBlockDecoder::cast_cell(const ObColumnIndexItem& column_index, ObObj& obj)
+{
+  int ret = OB_SUCCESS;
+  if (!obj.is_null() && !obj.is_nop_value() && column_index.request_column_type_ != obj.get_meta()) {
+    if (OB_FAIL(ObIRowReader::cast_obj(column_index.request_column_type_, allocator_, obj))) {
+      LOG_WARN("fail to cast cell", K(ret), K(column_index), K(obj));
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockDecoder::get_row(const int64_t index, ObStoreRow& row)
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("should init reader first, ", K(ret));
+  } else if (OB_ISNULL(column_map_)) {
+    ret = OB_ERR_SYS;
+    LOG_WARN("no column map specified", K(ret), K(row));
+  } else if (OB_UNLIKELY(index < 0 || index >= end() || !row.row_val_.is_valid() ||
+                         column_map_->get_request_count() > row.row_val_.count_)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(index), K(row.row_val_), K(column_map_->get_request_count()));
+  } else if (OB_FAIL(fill_row_header(index, row))) {
+    LOG_WARN("fail to fill row header", K(ret), K(index));
+  } else {
+    const ObColumnIndexItem* column_idx = column_map_->get_column_indexs();
+    const int64_t column_cnt = column_map_->get_request_count();
+    row.row_val_.count_ = column_cnt;
+    for (int64_t i = 0; OB_SUCC(ret) && i < column_cnt; ++i) {
+      const int64_t store_idx = column_idx[i].store_index_;
+      ObObj& cell = row.row_val_.cells_[i];
+      if (store_idx < 0) {
+        cell.set_nop_value();
+      } else if (OB_UNLIKELY(store_idx >= column_count_)) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("store index out of block", K(ret), K(i), K(column_idx[i]), K_(column_count));
+      } else if (OB_FAIL(decoders_[store_idx].decode(index, allocator_, cell))) {
+        LOG_WARN("fail to decode cell", K(ret), K(index), K(i), K(column_idx[i]));
+      } else if (OB_FAIL(cast_cell(column_idx[i], cell))) {
+        LOG_WARN("fail to cast cell", K(ret), K(index), K(i));
+      }
+    }
+    if (OB_SUCC(ret) && 0 == index) {
+      row.row_pos_flag_.set_micro_first(true);
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockDecoder::get_rows(const int64_t begin_index, const int64_t end_index, const int64_t row_capacity,
+    ObStoreRow* rows, int64_t& row_count)
+{
+  int ret = OB_SUCCESS;
+  row_count = 0;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_UNLIKELY((begin_index == end_index) ||
+                         (begin_index < end_index && !(begin_index >= begin() && end_index <= end())) ||
+                         (begin_index > end_index && !(end_index >= begin() - 1 && begin_index <= end() - 1)) ||
+                         NULL == rows || row_capacity <= 0 || NULL == column_map_)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument",
+        K(ret),
+        K(begin_index),
+        K(end_index),
+        K(begin()),
+        K(end()),
+        KP(rows),
+        K(row_capacity),
+        KP_(column_map));
+  } else {
+    // decode column by column, OB_MAX_BATCH_ROW_COUNT rows at a time
+    const int64_t step = begin_index < end_index ? 1 : -1;
+    const int64_t total = std::min(row_capacity, (end_index - begin_index) * step);
+    const int64_t out_column_count = column_map_->get_request_count();
+    const ObColumnIndexItem* column_idx = column_map_->get_column_indexs();
+    for (int64_t offset = 0; OB_SUCC(ret) && offset < total; offset += OB_MAX_BATCH_ROW_COUNT) {
+      const int64_t batch = std::min(static_cast<int64_t>(OB_MAX_BATCH_ROW_COUNT), total - offset);
+      ObStoreRow* batch_rows = rows + offset;
+      for (int64_t k = 0; OB_SUCC(ret) && k < batch; ++k) {
+        row_ids_[k] = begin_index + (offset + k) * step;
+        if (OB_UNLIKELY(NULL == batch_rows[k].row_val_.cells_ || batch_rows[k].row_val_.count_ < out_column_count)) {
+          ret = OB_INVALID_ARGUMENT;
+          LOG_WARN("invalid argument", K(ret), K(batch_rows[k].row_val_), K(out_column_count));
+        } else if (OB_FAIL(fill_row_header(row_ids_[k], batch_rows[k]))) {
+          LOG_WARN("fail to fill row header", K(ret), K(row_ids_[k]));
+        } else {
+          batch_rows[k].row_val_.count_ = out_column_count;
+        }
+      }
+      for (int64_t i = 0; OB_SUCC(ret) && i < out_column_count; ++i) {
+        const int64_t store_idx = column_idx[i].store_index_;
+        if (store_idx < 0) {
+          for (int64_t k = 0; k < batch; ++k) {
+            batch_rows[k].row_val_.cells_[i].set_nop_value();
+          }
+        } else if (OB_UNLIKELY(store_idx >= column_count_)) {
+          ret = OB_ERR_UNEXPECTED;
+          LOG_WARN("store index out of block", K(ret), K(i), K(column_idx[i]), K_(column_count));
+        } else if (OB_FAIL(decoders_[store_idx].batch_decode(row_ids_, batch, allocator_, cells_))) {
+          LOG_WARN("fail to batch decode column", K(ret), K(i), K(store_idx));
+        } else {
+          for (int64_t k = 0; OB_SUCC(ret) && k < batch; ++k) {
+            batch_rows[k].row_val_.cells_[i] = cells_[k];
+            if (OB_FAIL(cast_cell(column_idx[i], batch_rows[k].row_val_.cells_[i]))) {
+              LOG_WARN("fail to cast cell", K(ret), K(i), K(k));
+            }
+          }
+        }
+      }
+    }
+
+    if (OB_SUCC(ret)) {
+      row_count = total;
+      rows[0].row_pos_flag_.reset();
+      if (0 == begin_index) {
+        rows[0].row_pos_flag_.set_micro_first(true);
+      }
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockDecoder::get_column(
+    const int64_t store_idx, const int64_t begin_index, const int64_t end_index, ObObj* objs)
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_UNLIKELY(store_idx < 0 || store_idx >= column_count_ || begin_index < begin() ||
+                         end_index > end() || begin_index >= end_index || NULL == objs)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(store_idx), K_(column_count), K(begin_index), K(end_index), KP(objs));
+  } else {
+    for (int64_t offset = begin_index; OB_SUCC(ret) && offset < end_index; offset += OB_MAX_BATCH_ROW_COUNT) {
+      const int64_t batch = std::min(static_cast<int64_t>(OB_MAX_BATCH_ROW_COUNT), end_index - offset);
+      for (int64_t k = 0; k < batch; ++k) {
+        row_ids_[k] = offset + k;
+      }
+      if (OB_FAIL(decoders_[store_idx].batch_decode(row_ids_, batch, allocator_, objs + offset - begin_index))) {
+        LOG_WARN("fail to batch decode column", K(ret), K(store_idx), K(offset));
+      }
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockDecoder::filter_pushdown_filter(const sql::ObWhiteFilterExecutor& filter, const int64_t col_idx,
+    const int64_t begin_index, const int64_t row_count, ObBitmap& result_bitmap)
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_UNLIKELY(NULL == column_map_ || col_idx < 0 || col_idx >= column_map_->get_request_count() ||
+                         begin_index < begin() || row_count <= 0 || begin_index + row_count > end() ||
+                         result_bitmap.size() < row_count)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP_(column_map), K(col_idx), K(begin_index), K(row_count),
+        K(result_bitmap.size()));
+  } else {
+    const ObColumnIndexItem& column_index = column_map_->get_column_indexs()[col_idx];
+    const int64_t store_idx = column_index.store_index_;
+    if (store_idx < 0) {
+      // column added after this block was written, rows are filled with the default value later
+      result_bitmap.reuse(true);
+    } else if (OB_UNLIKELY(store_idx >= column_count_)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("store index out of block", K(ret), K(col_idx), K(column_index), K_(column_count));
+    } else {
+      bool entry_filtered = false;
+      if (column_index.request_column_type_ == decoders_[store_idx].get_meta()) {
+        if (OB_SUCC(decoders_[store_idx].filter_entries(filter, begin_index, row_count, allocator_, result_bitmap))) {
+          entry_filtered = true;
+        } else if (OB_NOT_SUPPORTED == ret) {
+          ret = OB_SUCCESS;
+        } else {
+          LOG_WARN("fail to filter column entries", K(ret), K(store_idx));
+        }
+      }
+      // evaluate cell by cell
+      bool filtered = true;
+      for (int64_t offset = 0; OB_SUCC(ret) && !entry_filtered && offset < row_count;
+           offset += OB_MAX_BATCH_ROW_COUNT) {
+        const int64_t batch = std::min(static_cast<int64_t>(OB_MAX_BATCH_ROW_COUNT), row_count - offset);
+        for (int64_t k = 0; k < batch; ++k) {
+          row_ids_[k] = begin_index + offset + k;
+        }
+        if (OB_FAIL(decoders_[store_idx].batch_decode(row_ids_, batch, allocator_, cells_))) {
+          LOG_WARN("fail to batch decode column", K(ret), K(store_idx), K(offset));
+        }
+        for (int64_t k = 0; OB_SUCC(ret) && k < batch; ++k) {
+          if (OB_FAIL(cast_cell(column_index, cells_[k]))) {
+            LOG_WARN("fail to cast cell", K(ret), K(k));
+          } else if (OB_FAIL(filter.filter(cells_[k], filtered))) {
+            LOG_WARN("fail to filter cell", K(ret), K(cells_[k]));
+          } else if (!filtered && OB_FAIL(result_bitmap.set(offset + k))) {
+            LOG_WARN("fail to set result bitmap", K(ret), K(offset), K(k));
+          }
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockDecoder::get_cell(const int64_t row_idx, const int64_t store_idx, ObObj& obj)
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_UNLIKELY(row_idx < begin() || row_idx >= end() || store_idx < 0 || store_idx >= column_count_)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(row_idx), K(store_idx), K_(column_count));
+  } else if (OB_FAIL(decoders_[store_idx].decode(row_idx, allocator_, obj))) {
+    LOG_WARN("fail to decode cell", K(ret), K(row_idx), K(store_idx));
+  }
+  return ret;
+}
+
+int ObMicroBlockDecoder::get_full_row(const int64_t row_idx, ObStoreRow& row)
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_UNLIKELY(row_idx < begin() || row_idx >= end() || NULL == row.row_val_.cells_ ||
+                         row.row_val_.count_ > column_count_)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(row_idx), K(row.row_val_), K_(column_count));
+  } else if (OB_FAIL(fill_row_header(row_idx, row))) {
+    LOG_WARN("fail to fill row header", K(ret), K(row_idx));
+  } else {
+    for (int64_t i = 0; OB_SUCC(ret) && i < row.row_val_.count_; ++i) {
+      if (OB_FAIL(decoders_[i].decode(row_idx, allocator_, row.row_val_.cells_[i]))) {
+        LOG_WARN("fail to decode cell", K(ret), K(row_idx), K(i));
+      }
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockDecoder::get_row_flag(const int64_t row_idx, int64_t& flag)
+{
+  int ret = OB_SUCCESS;
+  ObRowHeader row_header;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_UNLIKELY(row_idx < begin() || row_idx >= end())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(row_idx));
+  } else if (OB_FAIL(decode_row_header(row_idx, row_header))) {
+    LOG_WARN("fail to decode row header", K(ret), K(row_idx));
+  } else {
+    flag = row_header.get_row_flag();
+  }
+  return ret;
+}
+
+int ObMicroBlockDecoder::find_bound(const ObStoreRowkey& key, const bool lower_bound, const int64_t begin_idx,
+    const int64_t end_idx, int64_t& row_idx, bool& equal)
+{
+  int ret = OB_SUCCESS;
+  equal = false;
+  row_idx = ObIMicroBlockReader::INVALID_ROW_INDEX;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init");
+  } else if (OB_UNLIKELY(!key.is_valid() || begin_idx < begin() || end_idx > end() ||
+                         key.get_obj_cnt() > column_count_)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(key), K(begin_idx), K(begin()), K(end_idx), K(end()), K_(column_count));
+  } else {
+    ObEncodingRowkeyCompare compare(ret, equal, *this, key.get_obj_cnt());
+    ObRowIndexIterator begin_iter(begin_idx);
+    ObRowIndexIterator end_iter(end_idx);
+    ObRowIndexIterator found_iter;
+    if (lower_bound) {
+      found_iter = std::lower_bound(begin_iter, end_iter, key, compare);
+    } else {
+      found_iter = std::upper_bound(begin_iter, end_iter, key, compare);
+    }
+    if (OB_FAIL(ret)) {
+      LOG_WARN("fail to lower bound rowkey", K(ret));
+    } else {
+      row_idx = *found_iter;
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockDecoder::get_row_count(int64_t& row_count)
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else {
+    row_count = header_->row_count_;
+  }
+  return ret;
+}
+
+int ObMicroBlockDecoder::get_row_header(const int64_t row_idx, const ObRowHeader*& row_header)
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("reader not init", K(ret));
+  } else if (OB_UNLIKELY(row_idx < begin() || row_idx >= end())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(row_idx));
+  } else if (OB_FAIL(decode_row_header(row_idx, row_header_))) {
+    LOG_WARN("fail to decode row header", K(ret), K(row_idx));
+  } else {
+    row_header = &row_header_;
+  }
+  return ret;
+}
+
+int ObMicroBlockDecoder::get_multi_version_info(const int64_t row_idx, const int64_t version_column_idx,
+    const int64_t sql_sequence_idx, ObMultiVersionRowFlag& flag, transaction::ObTransID& trans_id,
+    int64_t& trans_version, int64_t& sql_sequence)
+{
+  int ret = OB_SUCCESS;
+  ObRowHeader row_header;
+  ObObj cell;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_UNLIKELY(row_idx < begin() || row_idx >= end() || version_column_idx < 0 ||
+                         version_column_idx >= column_count_ || sql_sequence_idx >= column_count_)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(row_idx), K(version_column_idx), K(sql_sequence_idx), K_(column_count));
+  } else if (OB_FAIL(decode_row_header(row_idx, row_header))) {
+    LOG_WARN("fail to decode row header", K(ret), K(row_idx));
+  } else {
+    // transaction id is not kept in encoded block, which only holds committed rows
+    trans_id.reset();
+    flag.flag_ = row_header.get_row_type_flag();
+    if (!flag.is_uncommitted_row()) {
+      sql_sequence = 0;
+      if (OB_FAIL(decoders_[version_column_idx].decode(row_idx, allocator_, cell))) {
+        LOG_WARN("fail to read version column", K(ret));
+      } else if (OB_FAIL(cell.get_int(trans_version))) {
+        LOG_WARN("fail to convert version cell to int", K(ret), K(cell));
+      } else {
+        trans_version = -trans_version;
+      }
+    } else {
+      trans_version = INT64_MAX;
+      if (sql_sequence_idx < 0) {
+        sql_sequence = 0;
+      } else if (OB_FAIL(decoders_[sql_sequence_idx].decode(row_idx, allocator_, cell))) {
+        LOG_WARN("fail to read sql sequence column", K(ret));
+      } else if (OB_FAIL(cell.get_int(sql_sequence))) {
+        LOG_WARN("fail to convert sql sequence cell to int", K(ret), K(cell));
+      } else {
+        sql_sequence = -sql_sequence;
+      }
+    }
+  }
+  return ret;
+}
+
+/**
+ * -------------------------------------------------------ObMicroBlockEncodingGetReader--------------------------------------------------------------
+ */
+ObMicroBlockEncodingGetReader::ObMicroBlockEncodingGetReader()
+    : decoder_(), is_same_block_(false), block_buf_(NULL), column_map_(NULL)
+{}
+
+ObMicroBlockEncodingGetReader::~ObMicroBlockEncodingGetReader()
+{}
+
+int ObMicroBlockEncodingGetReader::init_decoder(const ObMicroBlockData& block_data, const ObColumnMap* column_map)
+{
+  int ret = OB_SUCCESS;
+  if (is_same_block_ && decoder_.is_inited() && block_buf_ == block_data.get_buf() && column_map_ == column_map) {
+    // column decoders of this block are ready
+  } else {
+    block_buf_ = NULL;
+    if (OB_FAIL(NULL == column_map ? decoder_.init(block_data) : decoder_.init(block_data, column_map))) {
+      LOG_WARN("fail to init decoder", K(ret), K(block_data));
+    } else {
+      block_buf_ = block_data.get_buf();
+      column_map_ = column_map;
+    }
+  }
+  is_same_block_ = false;
+  return ret;
+}
+
+int ObMicroBlockEncodingGetReader::locate_row(
+    const ObStoreRowkey& rowkey, const ObSSTableRowkeyHelper* rowkey_helper, int64_t& row_idx)
+{
+  int ret = OB_SUCCESS;
+  const int64_t rowkey_cnt = rowkey.get_obj_cnt();
+  const ObObj* rowkey_obj = rowkey.get_obj_ptr();
+  int64_t row_count = 0;
+  int64_t low = 0;
+  int64_t high = 0;
+  int32_t cmp_result = 0;
+  ObObj cell;
+  if (OB_FAIL(decoder_.get_row_count(row_count))) {
+    LOG_WARN("fail to get row count", K(ret));
+  } else {
+    high = row_count - 1;
+  }
+  // binary search
+  while (OB_SUCC(ret) && low <= high) {
+    row_idx = (low + high) >> 1;
+    cmp_result = 0;
+    for (int64_t i = 0; OB_SUCC(ret) && 0 == cmp_result && i < rowkey_cnt; ++i) {
+      if (OB_FAIL(decoder_.get_cell(row_idx, i, cell))) {
+        LOG_WARN("fail to get rowkey cell", K(ret), K(row_idx), K(i));
+      } else if (OB_NOT_NULL(rowkey_helper)) {
+        if (OB_FAIL(rowkey_helper->compare_rowkey_obj(i, cell, rowkey_obj[i], cmp_result))) {
+          LOG_ERROR("fail to compare column, ", K(ret), K(rowkey_cnt), K(i));
+        }
+      } else {
+        cmp_result = cell.compare(rowkey_obj[i], common::CS_TYPE_INVALID);
+      }
+    }
+    if (OB_SUCC(ret)) {
+      if (cmp_result > 0) {
+        high = row_idx - 1;
+      } else if (cmp_result < 0) {
+        low = row_idx + 1;
+      } else {
+        // found row
+        break;
+      }
+    }
+  }
+  if (OB_SUCC(ret) && low > high) {
+    // not found
+    ret = OB_BEYOND_THE_RANGE;
+  }
+  return ret;
+}
+
+int ObMicroBlockEncodingGetReader::get_row(const uint64_t tenant_id, const ObMicroBlockData& block_data,
+    const ObStoreRowkey& rowkey, const ObColumnMap& column_map, const ObFullMacroBlockMeta& macro_meta,
+    const ObSSTableRowkeyHelper* rowkey_helper, ObStoreRow& row)
+{
+  UNUSED(tenant_id);
+  int ret = OB_SUCCESS;
+  int64_t row_idx = 0;
+  if (OB_FAIL(init_decoder(block_data, &column_map))) {
+    LOG_WARN("fail to init decoder", K(ret), K(block_data));
+  } else if (OB_FAIL(locate_row(rowkey, rowkey_helper, row_idx))) {
+    if (OB_BEYOND_THE_RANGE != ret) {
+      LOG_WARN("fail to locate row, ", K(ret), K(rowkey));
+    }
+  } else if (OB_FAIL(decoder_.get_row(row_idx, row))) {
+    LOG_WARN("fail to read row, ", K(ret), K(rowkey), K(macro_meta));
+  }
+  return ret;
+}
+
+int ObMicroBlockEncodingGetReader::get_row(const uint64_t tenant_id, const ObMicroBlockData& block_data,
+    const ObStoreRowkey& rowkey, const ObFullMacroBlockMeta& macro_meta, const ObSSTableRowkeyHelper* rowkey_helper,
+    ObStoreRow& row)
+{
+  UNUSED(tenant_id);
+  int ret = OB_SUCCESS;
+  int64_t row_idx = 0;
+  if (OB_FAIL(init_decoder(block_data, NULL))) {
+    LOG_WARN("fail to init decoder", K(ret), K(block_data));
+  } else if (OB_FAIL(locate_row(rowkey, rowkey_helper, row_idx))) {
+    if (OB_BEYOND_THE_RANGE != ret) {
+      LOG_WARN("fail to locate row, ", K(ret), K(rowkey), K(macro_meta));
+    }
+  } else {
+    row.row_val_.count_ = macro_meta.meta_->column_number_;
+    if (OB_FAIL(decoder_.get_full_row(row_idx, row))) {
+      LOG_WARN("fail to read full row, ", K(ret), K(rowkey), K(macro_meta));
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockEncodingGetReader::exist_row(const uint64_t tenant_id, const ObMicroBlockData& block_data,
+    const ObStoreRowkey& rowkey, const ObFullMacroBlockMeta& macro_meta, const ObSSTableRowkeyHelper* rowkey_helper,
+    bool& exist, bool& found)
+{
+  UNUSED(tenant_id);
+  int ret = OB_SUCCESS;
+  int64_t row_idx = 0;
+  int64_t flag = 0;
+  exist = false;
+  found = false;
+  if (OB_FAIL(init_decoder(block_data, NULL))) {
+    LOG_WARN("fail to init decoder", K(ret), K(block_data));
+  } else if (OB_FAIL(locate_row(rowkey, rowkey_helper, row_idx))) {
+    if (OB_BEYOND_THE_RANGE == ret) {
+      ret = OB_SUCCESS;
+    } else {
+      LOG_WARN("fail to locate row, ", K(ret), K(rowkey), K(macro_meta));
+    }
+  } else if (OB_FAIL(decoder_.get_row_flag(row_idx, flag))) {
+    LOG_WARN("fail to get row flag", K(ret), K(row_idx));
+  } else {
+    exist = ObActionFlag::OP_DEL_ROW != flag;
+    found = true;
+  }
+  return ret;
+}
+
+}  // end namespace blocksstable
+}  // end namespace oceanbase
@@ -0,0 +1,163 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_STORAGE_BLOCKSSTABLE_OB_MICRO_BLOCK_DECODER_H_
+#define OCEANBASE_STORAGE_BLOCKSSTABLE_OB_MICRO_BLOCK_DECODER_H_
+
+#include "lib/allocator/page_arena.h"
+#include "ob_imicro_block_reader.h"
+#include "ob_micro_block_encoding.h"
+#include "ob_column_map.h"
+#include "storage/ob_i_store.h"
+
+namespace oceanbase {
+namespace blocksstable {
+// decoder of one encoded column, decodes cells without touching other columns
+class ObColumnDecoder {
+public:
+  ObColumnDecoder();
+  ~ObColumnDecoder()
+  {}
+  int init(const char* block, const int64_t block_size, const ObEncodingColumnHeader& header, const int64_t row_count);
+  void reset();
+  // decode one cell, strings and numbers may point into the block
+  int decode(const int64_t row_idx, common::ObIAllocator& allocator, common::ObObj& obj) const;
+  // decode cells of @row_ids into @objs
+  int batch_decode(const int64_t* row_ids, const int64_t row_cnt, common::ObIAllocator& allocator,
+      common::ObObj* objs) const;
+  // evaluate @filter once per distinct value of const, dict and rle columns,
+  // OB_NOT_SUPPORTED for the other encodings
+  int filter_entries(const sql::ObWhiteFilterExecutor& filter, const int64_t begin_index, const int64_t row_count,
+      common::ObIAllocator& allocator, common::ObBitmap& result_bitmap) const;
+  OB_INLINE const common::ObObjMeta& get_meta() const
+  {
+    return header_.meta_;
+  }
+  TO_STRING_KV(K_(header), K_(row_count), K_(payload_len));
+
+private:
+  OB_INLINE bool is_null(const int64_t row_idx) const
+  {
+    return NULL != null_bitmap_ && ObEncodingUtil::bitmap_test(null_bitmap_, row_idx);
+  }
+  OB_INLINE int64_t find_run(const int64_t row_idx) const;
+  OB_INLINE uint64_t get_int(const int64_t row_idx) const;
+  // decode the @entry_idx-th distinct value of const, dict and rle columns
+  int decode_entry(const int64_t entry_idx, common::ObObj& obj) const;
+  int get_bytes(const int64_t row_idx, common::ObIAllocator& allocator, const char*& ptr, int64_t& len) const;
+  int bytes_to_obj(const char* ptr, const int64_t len, common::ObObj& obj) const;
+  int parse_packed(const char*& pos, const char* end, const int64_t count, uint64_t& base, int64_t& width,
+      const char*& packed);
+
+private:
+  ObEncodingColumnHeader header_;
+  int64_t row_count_;
+  const char* null_bitmap_;
+  const char* payload_;
+  int64_t payload_len_;
+  // int domain
+  uint64_t base_;
+  int64_t width_;
+  const char* packed_;
+  // dict refs
+  int64_t ref_width_;
+  const char* refs_;
+  // rle runs and dict entries
+  int64_t entry_count_;
+  const char* run_ends_;
+  // bytes domain
+  const char* offsets_;
+  const char* bytes_;
+};
+
+class ObMicroBlockDecoder : public ObIMicroBlockReader {
+public:
+  ObMicroBlockDecoder();
+  virtual ~ObMicroBlockDecoder();
+  virtual int init(const ObMicroBlockData& block_data, const ObColumnMap* column_map,
+      const common::ObRowStoreType out_type = common::FLAT_ROW_STORE) override;
+  // init without column map, only the cell and full row interfaces are usable
+  int init(const ObMicroBlockData& block_data);
+  virtual void reset() override;
+  virtual int get_row(const int64_t index, storage::ObStoreRow& row) override;
+  virtual int get_rows(const int64_t begin_index, const int64_t end_index, const int64_t row_capacity,
+      storage::ObStoreRow* rows, int64_t& row_count) override;
+  virtual int get_row_count(int64_t& row_count) override;
+  virtual int get_row_header(const int64_t row_idx, const ObRowHeader*& row_header) override;
+  virtual int get_multi_version_info(const int64_t row_idx, const int64_t version_column_idx,
+      const int64_t sql_sequence_idx, storage::ObMultiVersionRowFlag& flag, transaction::ObTransID& trans_id,
+      int64_t& version, int64_t& sql_sequence) override;
+
+  // decode column @store_idx of rows [begin_index, end_index) into @objs, other columns are not touched
+  int get_column(const int64_t store_idx, const int64_t begin_index, const int64_t end_index, common::ObObj* objs);
+  int get_cell(const int64_t row_idx, const int64_t store_idx, common::ObObj& obj);
+  int get_full_row(const int64_t row_idx, storage::ObStoreRow& row);
+  int get_row_flag(const int64_t row_idx, int64_t& flag);
+  virtual int filter_pushdown_filter(const sql::ObWhiteFilterExecutor& filter, const int64_t col_idx,
+      const int64_t begin_index, const int64_t row_count, common::ObBitmap& result_bitmap) override;
+
+protected:
+  virtual int find_bound(const common::ObStoreRowkey& key, const bool lower_bound, const int64_t begin_idx,
+      const int64_t end_idx, int64_t& row_idx, bool& equal) override;
+
+private:
+  int base_init(const ObMicroBlockData& block_data);
+  int decode_row_header(const int64_t row_idx, ObRowHeader& row_header);
+  int fill_row_header(const int64_t row_idx, storage::ObStoreRow& row);
+  int cast_cell(const ObColumnIndexItem& column_index, common::ObObj& obj);
+
+private:
+  const ObMicroBlockHeader* header_;
+  int64_t column_count_;
+  ObColumnDecoder* decoders_;  // column_count_ + 1, the last one is row header meta column
+  ObRowHeader row_header_;
+  common::ObArenaAllocator allocator_;
+  common::ObArenaAllocator decoder_allocator_;
+  int64_t row_ids_[OB_MAX_BATCH_ROW_COUNT];
+  common::ObObj cells_[OB_MAX_BATCH_ROW_COUNT];
+};
+
+class ObMicroBlockEncodingGetReader : public ObIMicroBlockGetReader {
+public:
+  ObMicroBlockEncodingGetReader();
+  virtual ~ObMicroBlockEncodingGetReader();
+  virtual int get_row(const uint64_t tenant_id, const ObMicroBlockData& block_data, const common::ObStoreRowkey& rowkey,
+      const ObColumnMap& column_map, const ObFullMacroBlockMeta& macro_meta,
+      const storage::ObSSTableRowkeyHelper* rowkey_helper, storage::ObStoreRow& row) override;
+  virtual int get_row(const uint64_t tenant_id, const ObMicroBlockData& block_data, const common::ObStoreRowkey& rowkey,
+      const ObFullMacroBlockMeta& macro_meta, const storage::ObSSTableRowkeyHelper* rowkey_helper,
+      storage::ObStoreRow& row) override;
+  virtual int exist_row(const uint64_t tenant_id, const ObMicroBlockData& block_data,
+      const common::ObStoreRowkey& rowkey, const ObFullMacroBlockMeta& macro_meta,
+      const storage::ObSSTableRowkeyHelper* rowkey_helper, bool& exist, bool& found) override;
+  virtual void set_same_block(const bool is_same_block) override
+  {
+    is_same_block_ = is_same_block;
+  }
+
+private:
+  int init_decoder(const ObMicroBlockData& block_data, const ObColumnMap* column_map);
+  int locate_row(
+      const common::ObStoreRowkey& rowkey, const storage::ObSSTableRowkeyHelper* rowkey_helper, int64_t& row_idx);
+
+private:
+  ObMicroBlockDecoder decoder_;
+  // the decoder is kept for the next get in the same block
+  bool is_same_block_;
+  const char* block_buf_;
+  const ObColumnMap* column_map_;  // NULL if inited for full row
+};
+
+}  // end namespace blocksstable
+}  // end namespace oceanbase
+
+#endif  // OCEANBASE_STORAGE_BLOCKSSTABLE_OB_MICRO_BLOCK_DECODER_H_
@@ -0,0 +1,719 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX STORAGE
+#include "ob_micro_block_disk_cache.h"
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include "lib/checksum/ob_crc64.h"
+#include "lib/hash_func/murmur_hash.h"
+#include "lib/thread/ob_thread_name.h"
+#include "lib/time/ob_time_utility.h"
+#include "ob_store_file.h"
+
+namespace oceanbase {
+using namespace common;
+namespace blocksstable {
+
+void ObMicroBlockDiskCache::DiskKey::set(const ObMicroBlockCacheKey& key)
+{
+  MEMSET(this, 0, sizeof(*this));
+  table_id_ = key.get_table_id();
+  block_id_[0] = key.get_block_id().first_id();
+  block_id_[1] = key.get_block_id().second_id();
+  block_id_[2] = key.get_block_id().third_id();
+  block_id_[3] = key.get_block_id().fourth_id();
+  file_id_ = key.get_file_id();
+  offset_ = key.get_offset();
+  size_ = key.get_size();
+}
+
+uint64_t ObMicroBlockDiskCache::DiskKey::hash() const
+{
+  return murmurhash(this, sizeof(*this), 0);
+}
+
+ObMicroBlockDiskCache::ObMicroBlockDiskCache()
+    : is_inited_(false),
+      is_enabled_(false),
+      fd_(-1),
+      format_id_(0),
+      segment_cnt_(0),
+      next_segment_id_(0),
+      seq_(0),
+      segment_seqs_(NULL),
+      gen_buf_(NULL),
+      gens_(NULL),
+      gen_seq_(0),
+      index_(),
+      cur_buf_(0),
+      meta_buf_(NULL),
+      buf_lock_(),
+      write_lock_(),
+      gen_lock_(),
+      cond_(),
+      allocator_(ObModIds::OB_SSTABLE_MICRO_BLOCK_ALLOCATOR),
+      get_cnt_(0),
+      hit_cnt_(0),
+      put_cnt_(0),
+      drop_cnt_(0),
+      skip_cnt_(0),
+      segment_write_cnt_(0)
+{}
+
+ObMicroBlockDiskCache::~ObMicroBlockDiskCache()
+{
+  destroy();
+}
+
+int ObMicroBlockDiskCache::open(const char* file_path, const int64_t file_size, const int64_t data_file_id)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(is_inited_)) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("micro block disk cache has been opened", K(ret));
+  } else if (OB_ISNULL(file_path) || OB_UNLIKELY(0 == STRLEN(file_path) || file_size < MIN_FILE_SIZE)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(file_path), K(file_size));
+  } else if (OB_FAIL(cond_.init(ObWaitEventIds::DEFAULT_COND_WAIT))) {
+    LOG_WARN("fail to init cond", K(ret));
+  } else if ((fd_ = ::open(file_path, O_RDWR | O_CREAT, S_IRUSR | S_IWUSR)) < 0) {
+    ret = OB_IO_ERROR;
+    LOG_WARN("fail to open micro block disk cache file", K(ret), K(file_path), KERRMSG);
+  } else if (0 != ::fallocate(fd_, 0, 0, file_size)) {
+    ret = OB_IO_ERROR;
+    LOG_WARN("fail to allocate micro block disk cache file", K(ret), K(file_path), K(file_size), KERRMSG);
+  } else {
+    segment_cnt_ = (file_size - FIRST_SEGMENT_OFFSET) / SEGMENT_SIZE;
+    for (int64_t i = 0; OB_SUCC(ret) && i < ARRAYSIZEOF(seg_bufs_); ++i) {
+      if (OB_ISNULL(seg_bufs_[i].buf_ = static_cast<char*>(allocator_.alloc(SEGMENT_SIZE))) ||
+          OB_ISNULL(seg_bufs_[i].block_ids_ =
+                        static_cast<MacroBlockId*>(allocator_.alloc(MAX_ENTRY_CNT * sizeof(MacroBlockId))))) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("fail to alloc segment buffer", K(ret));
+      }
+    }
+    if (OB_FAIL(ret)) {
+    } else if (OB_ISNULL(gen_buf_ = static_cast<char*>(allocator_.alloc(GEN_TABLE_SIZE))) ||
+               OB_ISNULL(meta_buf_ = static_cast<char*>(allocator_.alloc(DATA_OFFSET))) ||
+               OB_ISNULL(segment_seqs_ = static_cast<int64_t*>(allocator_.alloc(segment_cnt_ * sizeof(int64_t))))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("fail to alloc memory", K(ret), K_(segment_cnt));
+    } else if (OB_FAIL(index_.create(segment_cnt_ * (SEGMENT_SIZE / OB_DEFAULT_SSTABLE_BLOCK_SIZE),
+                   ObModIds::OB_SSTABLE_MICRO_BLOCK_ALLOCATOR))) {
+      LOG_WARN("fail to create index", K(ret), K_(segment_cnt));
+    } else {
+      gens_ = reinterpret_cast<uint32_t*>(gen_buf_ + ALIGN_SIZE);
+      MEMSET(segment_seqs_, 0, segment_cnt_ * sizeof(int64_t));
+      if (OB_FAIL(load_or_format(data_file_id))) {
+        LOG_WARN("fail to load micro block disk cache", K(ret), K(file_path));
+      } else if (OB_FAIL(start())) {
+        LOG_WARN("fail to start micro block disk cache thread", K(ret));
+      } else {
+        is_inited_ = true;
+        is_enabled_ = true;
+        LOG_INFO("micro block disk cache opened", K(file_path), K(file_size), "index_cnt", index_.size(), K(*this));
+      }
+    }
+  }
+  if (OB_FAIL(ret)) {
+    destroy();
+  }
+  return ret;
+}
+
+void ObMicroBlockDiskCache::destroy()
+{
+  int ret = OB_SUCCESS;
+  if (is_inited_) {
+    stop();
+    wait();
+    if (ATOMIC_BCAS(&is_enabled_, true, false) && OB_FAIL(flush())) {
+      LOG_WARN("fail to flush micro block disk cache", K(ret));
+    }
+  }
+  if (fd_ >= 0) {
+    ::close(fd_);
+    fd_ = -1;
+  }
+  is_inited_ = false;
+  is_enabled_ = false;
+  index_.destroy();
+  cond_.destroy();
+  for (int64_t i = 0; i < ARRAYSIZEOF(seg_bufs_); ++i) {
+    seg_bufs_[i] = SegmentBuffer();
+  }
+  cur_buf_ = 0;
+  segment_seqs_ = NULL;
+  gen_buf_ = NULL;
+  gens_ = NULL;
+  meta_buf_ = NULL;
+  allocator_.reset();
+  format_id_ = 0;
+  segment_cnt_ = 0;
+  next_segment_id_ = 0;
+  seq_ = 0;
+  gen_seq_ = 0;
+}
+
+int ObMicroBlockDiskCache::get(const ObMicroBlockCacheKey& key, BaseBlockCache& cache,
+    const ObMicroBlockCacheValue*& micro_block, ObKVCacheHandle& handle)
+{
+  int ret = OB_SUCCESS;
+  DiskKey disk_key;
+  Location loc;
+  micro_block = NULL;
+  if (!is_enabled()) {
+    ret = OB_ENTRY_NOT_EXIST;
+  } else {
+    disk_key.set(key);
+    const int64_t gen_slot = get_gen_slot(key.get_block_id().block_index());
+    ATOMIC_INC(&get_cnt_);
+    if (OB_FAIL(index_.get_refactored(disk_key.hash(), loc))) {
+      if (OB_HASH_NOT_EXIST == ret) {
+        ret = OB_ENTRY_NOT_EXIST;
+      } else {
+        LOG_WARN("fail to get from index", K(ret), K(key));
+      }
+    } else if (loc.gen_ != ATOMIC_LOAD(&gens_[gen_slot]) ||
+               loc.seq_ != ATOMIC_LOAD(&segment_seqs_[loc.segment_id_])) {
+      ret = OB_ENTRY_NOT_EXIST;
+    } else {
+      ObKVCachePair* kvpair = NULL;
+      ObKVCacheInstHandle inst_handle;
+      if (OB_FAIL(cache.alloc(key.get_tenant_id(),
+              sizeof(ObMicroBlockCacheKey),
+              sizeof(ObMicroBlockCacheValue) + loc.size_,
+              kvpair,
+              handle,
+              inst_handle))) {
+        LOG_WARN("fail to alloc cache buf", K(ret), K(key));
+      } else {
+        DiskKey read_key;
+        char* block_buf = reinterpret_cast<char*>(kvpair->value_) + sizeof(ObMicroBlockCacheValue);
+        new (kvpair->key_) ObMicroBlockCacheKey(key);
+        ObMicroBlockCacheValue* cache_value = new (kvpair->value_) ObMicroBlockCacheValue(block_buf, loc.size_);
+        struct iovec iov[2];
+        iov[0].iov_base = &read_key;
+        iov[0].iov_len = sizeof(read_key);
+        iov[1].iov_base = block_buf;
+        iov[1].iov_len = loc.size_;
+        const int64_t read_size = ::preadv(fd_, iov, 2, get_segment_offset(loc.segment_id_) + loc.offset_);
+        if (OB_UNLIKELY(read_size != static_cast<int64_t>(sizeof(read_key) + loc.size_))) {
+          ret = OB_IO_ERROR;
+          LOG_WARN("fail to read micro block", K(ret), K(read_size), K(key), K(loc.segment_id_), KERRMSG);
+        } else if (loc.seq_ != ATOMIC_LOAD(&segment_seqs_[loc.segment_id_])) {
+          // the segment is overwritten
+          ret = OB_ENTRY_NOT_EXIST;
+        } else if (0 != MEMCMP(&read_key, &disk_key, sizeof(disk_key))) {
+          // another key of the same hash
+          ret = OB_ENTRY_NOT_EXIST;
+        } else if (loc.checksum_ != ob_crc64(ob_crc64(&read_key, sizeof(read_key)), block_buf, loc.size_)) {
+          ret = OB_ENTRY_NOT_EXIST;
+          LOG_WARN("micro block checksum error", K(key), K(loc.segment_id_), K(loc.offset_), K(loc.size_));
+        } else if (OB_FAIL(cache.put_kvpair(inst_handle, kvpair, handle, false /*overwrite*/))) {
+          if (OB_ENTRY_EXIST != ret) {
+            LOG_WARN("fail to put micro block cache", K(ret), K(key));
+          } else {
+            ret = OB_SUCCESS;
+          }
+        }
+        if (OB_SUCC(ret)) {
+          micro_block = cache_value;
+          ATOMIC_INC(&hit_cnt_);
+        } else {
+          // never put, keep it away from the wash listener
+          kvpair->value_ = NULL;
+          handle.reset();
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+// Only copies the micro block into the segment buffer, it runs in the wash path. Whether the macro block
+// is still alive or the micro block is already on disk is checked by the background thread, see
+// prepare_segment.
+int ObMicroBlockDiskCache::put(const ObMicroBlockCacheKey& key, const char* buf, const int64_t size)
+{
+  int ret = OB_SUCCESS;
+  DiskKey disk_key;
+  const int64_t record_size = ObKVStoreMemBlock::upper_align(sizeof(DiskKey) + size, sizeof(int64_t));
+  bool need_signal = false;
+  if (OB_UNLIKELY(!is_enabled())) {
+    ret = OB_NOT_INIT;
+  } else if (OB_ISNULL(buf) || OB_UNLIKELY(size <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(buf), K(size));
+  } else if (DATA_OFFSET + record_size > SEGMENT_SIZE) {
+    ret = OB_SIZE_OVERFLOW;
+  } else {
+    disk_key.set(key);
+    // load the generation before the block is checked, a block freed after the check has a newer one
+    const uint32_t gen = ATOMIC_LOAD(&gens_[get_gen_slot(key.get_block_id().block_index())]);
+    if (OB_SUCCESS != buf_lock_.trylock()) {
+      ret = OB_EAGAIN;
+    } else {
+      SegmentBuffer* seg_buf = &seg_bufs_[cur_buf_];
+      if (seg_buf->entry_cnt_ >= MAX_ENTRY_CNT || DATA_OFFSET + seg_buf->data_size_ + record_size > SEGMENT_SIZE) {
+        SegmentBuffer& next_buf = seg_bufs_[1 - cur_buf_];
+        if (ATOMIC_LOAD(&next_buf.is_sealed_)) {
+          // still being written
+          ret = OB_EAGAIN;
+        } else {
+          ATOMIC_STORE(&seg_buf->is_sealed_, true);
+          cur_buf_ = 1 - cur_buf_;
+          seg_buf = &next_buf;
+          need_signal = true;
+        }
+      }
+      if (OB_SUCC(ret)) {
+        const int64_t offset = DATA_OFFSET + seg_buf->data_size_;
+        Entry& entry = reinterpret_cast<Entry*>(seg_buf->buf_ + ENTRY_OFFSET)[seg_buf->entry_cnt_];
+        MEMCPY(seg_buf->buf_ + offset, &disk_key, sizeof(disk_key));
+        MEMCPY(seg_buf->buf_ + offset + sizeof(disk_key), buf, size);
+        entry.key_hash_ = disk_key.hash();
+        entry.gen_ = gen;
+        entry.offset_ = static_cast<uint32_t>(offset);
+        entry.size_ = static_cast<uint32_t>(size);
+        entry.reserved_ = 0;
+        entry.checksum_ = 0;
+        seg_buf->block_ids_[seg_buf->entry_cnt_] = key.get_block_id();
+        seg_buf->entry_cnt_++;
+        seg_buf->data_size_ += record_size;
+      }
+      buf_lock_.unlock();
+    }
+    if (need_signal) {
+      ObThreadCondGuard guard(cond_);
+      cond_.signal();
+    }
+    if (OB_SUCC(ret)) {
+      ATOMIC_INC(&put_cnt_);
+    } else if (OB_EAGAIN == ret) {
+      ATOMIC_INC(&drop_cnt_);
+    }
+  }
+  return ret;
+}
+
+void ObMicroBlockDiskCache::invalidate_blocks(const ObIArray<uint32_t>& block_indexes)
+{
+  int ret = OB_SUCCESS;
+  if (is_enabled() && block_indexes.count() > 0) {
+    lib::ObMutexGuard guard(gen_lock_);
+    for (int64_t i = 0; i < block_indexes.count(); ++i) {
+      ATOMIC_INC(&gens_[get_gen_slot(block_indexes.at(i))]);
+    }
+    if (OB_FAIL(write_gen_table())) {
+      LOG_ERROR("fail to persist macro block generations, disable micro block disk cache", K(ret));
+      disable();
+    }
+  }
+}
+
+int ObMicroBlockDiskCache::flush()
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("micro block disk cache is not opened", K(ret));
+  } else if (OB_FAIL(flush_sealed_buffers())) {
+    LOG_WARN("fail to flush sealed buffers", K(ret));
+  } else {
+    {
+      ObSpinLockGuard guard(buf_lock_);
+      SegmentBuffer& seg_buf = seg_bufs_[cur_buf_];
+      if (seg_buf.entry_cnt_ > 0) {
+        ATOMIC_STORE(&seg_buf.is_sealed_, true);
+        cur_buf_ = 1 - cur_buf_;
+      }
+    }
+    if (OB_FAIL(flush_sealed_buffers())) {
+      LOG_WARN("fail to flush sealed buffers", K(ret));
+    }
+  }
+  return ret;
+}
+
+void ObMicroBlockDiskCache::on_wash(const ObIKVCacheKey& key, const ObIKVCacheValue& value)
+{
+  const ObMicroBlockData& block_data = static_cast<const ObMicroBlockCacheValue&>(value).get_block_data();
+  if (is_enabled() && NULL == block_data.get_extra_buf() && block_data.is_valid()) {
+    (void)put(static_cast<const ObMicroBlockCacheKey&>(key), block_data.get_buf(), block_data.get_buf_size());
+  }
+}
+
+void ObMicroBlockDiskCache::run1()
+{
+  int ret = OB_SUCCESS;
+  int64_t last_print_time = 0;
+  lib::set_thread_name("MicroDiskCache");
+  while (!has_set_stop()) {
+    {
+      ObThreadCondGuard guard(cond_);
+      if (!ATOMIC_LOAD(&seg_bufs_[0].is_sealed_) && !ATOMIC_LOAD(&seg_bufs_[1].is_sealed_)) {
+        cond_.wait(FLUSH_INTERVAL_MS);
+      }
+    }
+    if (is_enabled() && OB_FAIL(flush_sealed_buffers())) {
+      LOG_WARN("fail to flush sealed buffers", K(ret));
+    }
+    const int64_t now = ObTimeUtility::current_time();
+    if (now - last_print_time >= PRINT_STAT_INTERVAL_US) {
+      LOG_INFO("micro block disk cache stat", K(*this), "index_cnt", index_.size());
+      last_print_time = now;
+    }
+  }
+}
+
+bool ObMicroBlockDiskCache::is_block_alive(const MacroBlockId& block_id) const
+{
+  ObMacroBlockInfo block_info;
+  return OB_SUCCESS == OB_STORE_FILE.get_macro_block_info(block_id.block_index(), block_info) &&
+         !block_info.is_free_ && block_info.write_seq_ == block_id.write_seq();
+}
+
+int ObMicroBlockDiskCache::load_or_format(const int64_t data_file_id)
+{
+  int ret = OB_SUCCESS;
+  SuperBlock super_block;
+  MEMSET(&super_block, 0, sizeof(super_block));
+  const int64_t read_size = ::pread(fd_, &super_block, sizeof(super_block), 0);
+  const uint64_t checksum = super_block.checksum_;
+  super_block.checksum_ = 0;
+  if (read_size != sizeof(super_block) || SUPER_BLOCK_MAGIC != super_block.magic_ || VERSION != super_block.version_ ||
+      checksum != ob_crc64(&super_block, sizeof(super_block)) || data_file_id != super_block.data_file_id_ ||
+      SEGMENT_SIZE != super_block.segment_size_ || segment_cnt_ != super_block.segment_cnt_ ||
+      GEN_SLOT_CNT != super_block.gen_slot_cnt_) {
+    LOG_INFO("micro block disk cache file not match, format it", K(read_size), K(data_file_id), K_(segment_cnt));
+    ret = format(data_file_id);
+  } else {
+    format_id_ = super_block.format_id_;
+    if (OB_FAIL(load_gen_table())) {
+      if (OB_ENTRY_NOT_EXIST == ret) {
+        LOG_INFO("no valid macro block generations, format micro block disk cache", K_(format_id));
+        ret = format(data_file_id);
+      } else {
+        LOG_WARN("fail to load macro block generations", K(ret));
+      }
+    } else if (OB_FAIL(load_segments())) {
+      LOG_WARN("fail to load segments", K(ret));
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockDiskCache::format(const int64_t data_file_id)
+{
+  int ret = OB_SUCCESS;
+  SuperBlock super_block;
+  MEMSET(&super_block, 0, sizeof(super_block));
+  // segments and generation tables of the old format are ignored since then
+  format_id_ = ObTimeUtility::current_time();
+  MEMSET(gens_, 0, GEN_SLOT_CNT * sizeof(uint32_t));
+  gen_seq_ = 0;
+  seq_ = 0;
+  next_segment_id_ = 0;
+  MEMSET(segment_seqs_, 0, segment_cnt_ * sizeof(int64_t));
+  index_.clear();
+  super_block.magic_ = SUPER_BLOCK_MAGIC;
+  super_block.version_ = VERSION;
+  super_block.data_file_id_ = data_file_id;
+  super_block.format_id_ = format_id_;
+  super_block.segment_size_ = SEGMENT_SIZE;
+  super_block.segment_cnt_ = segment_cnt_;
+  super_block.gen_slot_cnt_ = GEN_SLOT_CNT;
+  super_block.checksum_ = ob_crc64(&super_block, sizeof(super_block));
+  if (OB_FAIL(write_gen_table())) {
+    LOG_WARN("fail to write macro block generations", K(ret));
+  } else if (sizeof(super_block) != ::pwrite(fd_, &super_block, sizeof(super_block), 0) || 0 != ::fdatasync(fd_)) {
+    ret = OB_IO_ERROR;
+    LOG_WARN("fail to write super block", K(ret), KERRMSG);
+  } else {
+    LOG_INFO("micro block disk cache formatted", K(data_file_id), K_(format_id), K_(segment_cnt));
+  }
+  return ret;
+}
+
+int ObMicroBlockDiskCache::load_gen_table()
+{
+  int ret = OB_SUCCESS;
+  int64_t valid_copy = -1;
+  int64_t valid_seq = 0;
+  GenTableHeader* header = reinterpret_cast<GenTableHeader*>(gen_buf_);
+  for (int64_t i = 0; OB_SUCC(ret) && i < 2; ++i) {
+    const int64_t read_size = ::pread(fd_, gen_buf_, GEN_TABLE_SIZE, ALIGN_SIZE + i * GEN_TABLE_SIZE);
+    if (read_size < 0) {
+      ret = OB_IO_ERROR;
+      LOG_WARN("fail to read macro block generations", K(ret), K(i), KERRMSG);
+    } else if (GEN_TABLE_SIZE == read_size && GEN_TABLE_MAGIC == header->magic_ && format_id_ == header->format_id_ &&
+               header->checksum_ == ob_crc64(gens_, GEN_SLOT_CNT * sizeof(uint32_t)) && header->seq_ > valid_seq) {
+      valid_copy = i;
+      valid_seq = header->seq_;
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (valid_copy < 0) {
+    ret = OB_ENTRY_NOT_EXIST;
+  } else if (1 != valid_copy &&
+             GEN_TABLE_SIZE != ::pread(fd_, gen_buf_, GEN_TABLE_SIZE, ALIGN_SIZE + valid_copy * GEN_TABLE_SIZE)) {
+    ret = OB_IO_ERROR;
+    LOG_WARN("fail to read macro block generations", K(ret), K(valid_copy), KERRMSG);
+  } else {
+    gen_seq_ = valid_seq;
+  }
+  return ret;
+}
+
+int ObMicroBlockDiskCache::write_gen_table()
+{
+  int ret = OB_SUCCESS;
+  const int64_t seq = gen_seq_ + 1;
+  GenTableHeader* header = reinterpret_cast<GenTableHeader*>(gen_buf_);
+  header->magic_ = GEN_TABLE_MAGIC;
+  header->format_id_ = format_id_;
+  header->seq_ = seq;
+  header->checksum_ = ob_crc64(gens_, GEN_SLOT_CNT * sizeof(uint32_t));
+  // write the older copy, the newer one stays valid if this write is torn
+  if (GEN_TABLE_SIZE != ::pwrite(fd_, gen_buf_, GEN_TABLE_SIZE, ALIGN_SIZE + (seq % 2) * GEN_TABLE_SIZE) ||
+      0 != ::fdatasync(fd_)) {
+    ret = OB_IO_ERROR;
+    LOG_WARN("fail to write macro block generations", K(ret), K(seq), KERRMSG);
+  } else {
+    gen_seq_ = seq;
+  }
+  return ret;
+}
+
+int ObMicroBlockDiskCache::load_segments()
+{
+  int ret = OB_SUCCESS;
+  SegmentHeader header;
+  const Entry* entries = NULL;
+  Location loc;
+  Location old_loc;
+  int64_t max_seq = 0;
+  for (int64_t id = 0; OB_SUCC(ret) && id < segment_cnt_; ++id) {
+    if (OB_FAIL(read_segment_header(id, header, entries))) {
+      if (OB_INVALID_DATA == ret) {
+        // never written, or torn by a crash
+        ret = OB_SUCCESS;
+      } else {
+        LOG_WARN("fail to read segment header", K(ret), K(id));
+      }
+    } else {
+      segment_seqs_[id] = header.seq_;
+      if (header.seq_ > max_seq) {
+        max_seq = header.seq_;
+        next_segment_id_ = (id + 1) % segment_cnt_;
+      }
+      for (int64_t i = 0; OB_SUCC(ret) && i < header.entry_cnt_; ++i) {
+        const Entry& entry = entries[i];
+        loc.segment_id_ = id;
+        loc.seq_ = header.seq_;
+        loc.gen_ = entry.gen_;
+        loc.offset_ = entry.offset_;
+        loc.size_ = entry.size_;
+        loc.checksum_ = entry.checksum_;
+        if (OB_SUCCESS == index_.get_refactored(entry.key_hash_, old_loc) && old_loc.seq_ > loc.seq_) {
+          // keep the newer one
+        } else if (OB_FAIL(index_.set_refactored(entry.key_hash_, loc, 1 /*overwrite*/))) {
+          LOG_WARN("fail to set index", K(ret), K(id));
+        }
+      }
+    }
+  }
+  if (OB_SUCC(ret)) {
+    seq_ = max_seq;
+  }
+  return ret;
+}
+
+// Drop the records of freed macro blocks and of micro blocks already on disk, and checksum the others.
+void ObMicroBlockDiskCache::prepare_segment(SegmentBuffer& seg_buf)
+{
+  Entry* entries = reinterpret_cast<Entry*>(seg_buf.buf_ + ENTRY_OFFSET);
+  int64_t entry_cnt = 0;
+  int64_t data_size = 0;
+  Location loc;
+  for (int64_t i = 0; i < seg_buf.entry_cnt_; ++i) {
+    Entry entry = entries[i];
+    const int64_t record_size = ObKVStoreMemBlock::upper_align(sizeof(DiskKey) + entry.size_, sizeof(int64_t));
+    if (!is_block_alive(seg_buf.block_ids_[i]) ||
+        (OB_SUCCESS == index_.get_refactored(entry.key_hash_, loc) && entry.gen_ == loc.gen_ &&
+            loc.seq_ == ATOMIC_LOAD(&segment_seqs_[loc.segment_id_]))) {
+      ++skip_cnt_;
+    } else {
+      const int64_t offset = DATA_OFFSET + data_size;
+      char* record = seg_buf.buf_ + offset;
+      if (offset != entry.offset_) {
+        MEMMOVE(record, seg_buf.buf_ + entry.offset_, record_size);
+      }
+      entry.offset_ = static_cast<uint32_t>(offset);
+      entry.checksum_ = ob_crc64(ob_crc64(record, sizeof(DiskKey)), record + sizeof(DiskKey), entry.size_);
+      entries[entry_cnt++] = entry;
+      data_size += record_size;
+    }
+  }
+  seg_buf.entry_cnt_ = entry_cnt;
+  seg_buf.data_size_ = data_size;
+}
+
+int ObMicroBlockDiskCache::write_segment(SegmentBuffer& seg_buf)
+{
+  int ret = OB_SUCCESS;
+  prepare_segment(seg_buf);
+  const int64_t id = next_segment_id_;
+  const int64_t seq = seq_ + 1;
+  const int64_t write_size = DATA_OFFSET + seg_buf.data_size_;
+  SegmentHeader* header = reinterpret_cast<SegmentHeader*>(seg_buf.buf_);
+  const Entry* entries = reinterpret_cast<const Entry*>(seg_buf.buf_ + ENTRY_OFFSET);
+  Location loc;
+  if (0 == seg_buf.entry_cnt_) {
+    // nothing left to write
+  } else if (OB_FAIL(erase_segment_entries(id))) {
+    LOG_WARN("fail to erase segment entries", K(ret), K(id));
+  } else {
+    // readers of the old data check the seq after read
+    ATOMIC_STORE(&segment_seqs_[id], seq);
+    header->magic_ = SEGMENT_MAGIC;
+    header->format_id_ = format_id_;
+    header->seq_ = seq;
+    header->entry_cnt_ = seg_buf.entry_cnt_;
+    header->data_size_ = seg_buf.data_size_;
+    header->checksum_ = calc_segment_checksum(*header, entries);
+    if (write_size != ::pwrite(fd_, seg_buf.buf_, write_size, get_segment_offset(id))) {
+      ret = OB_IO_ERROR;
+      LOG_WARN("fail to write segment", K(ret), K(id), K(write_size), KERRMSG);
+      ATOMIC_STORE(&segment_seqs_[id], 0);
+    } else {
+      seq_ = seq;
+      next_segment_id_ = (id + 1) % segment_cnt_;
+      ++segment_write_cnt_;
+      for (int64_t i = 0; OB_SUCC(ret) && i < seg_buf.entry_cnt_; ++i) {
+        loc.segment_id_ = id;
+        loc.seq_ = seq;
+        loc.gen_ = entries[i].gen_;
+        loc.offset_ = entries[i].offset_;
+        loc.size_ = entries[i].size_;
+        loc.checksum_ = entries[i].checksum_;
+        if (OB_FAIL(index_.set_refactored(entries[i].key_hash_, loc, 1 /*overwrite*/))) {
+          LOG_WARN("fail to set index", K(ret), K(id));
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockDiskCache::erase_segment_entries(const int64_t segment_id)
+{
+  int ret = OB_SUCCESS;
+  SegmentHeader header;
+  const Entry* entries = NULL;
+  Location loc;
+  if (0 == segment_seqs_[segment_id]) {
+    // nothing valid in it
+  } else if (OB_FAIL(read_segment_header(segment_id, header, entries))) {
+    if (OB_INVALID_DATA == ret) {
+      ret = OB_SUCCESS;
+    } else {
+      LOG_WARN("fail to read segment header", K(ret), K(segment_id));
+    }
+  } else {
+    for (int64_t i = 0; OB_SUCC(ret) && i < header.entry_cnt_; ++i) {
+      if (OB_SUCCESS == index_.get_refactored(entries[i].key_hash_, loc) && segment_id == loc.segment_id_) {
+        if (OB_FAIL(index_.erase_refactored(entries[i].key_hash_))) {
+          LOG_WARN("fail to erase index", K(ret), K(segment_id));
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockDiskCache::read_segment_header(const int64_t segment_id, SegmentHeader& header, const Entry*& entries)
+{
+  int ret = OB_SUCCESS;
+  const int64_t offset = get_segment_offset(segment_id);
+  int64_t read_size = ::pread(fd_, meta_buf_, ALIGN_SIZE, offset);
+  entries = reinterpret_cast<const Entry*>(meta_buf_ + ENTRY_OFFSET);
+  if (read_size < 0) {
+    ret = OB_IO_ERROR;
+    LOG_WARN("fail to read segment header", K(ret), K(segment_id), KERRMSG);
+  } else if (ALIGN_SIZE != read_size) {
+    ret = OB_INVALID_DATA;
+  } else {
+    MEMCPY(&header, meta_buf_, sizeof(header));
+    if (SEGMENT_MAGIC != header.magic_ || format_id_ != header.format_id_ || header.seq_ <= 0 ||
+        header.entry_cnt_ < 0 || header.entry_cnt_ > MAX_ENTRY_CNT || header.data_size_ < 0 ||
+        DATA_OFFSET + header.data_size_ > SEGMENT_SIZE) {
+      ret = OB_INVALID_DATA;
+    } else {
+      const int64_t entries_size = header.entry_cnt_ * sizeof(Entry);
+      read_size = ::pread(fd_, meta_buf_ + ENTRY_OFFSET, entries_size, offset + ENTRY_OFFSET);
+      if (read_size < 0) {
+        ret = OB_IO_ERROR;
+        LOG_WARN("fail to read segment entries", K(ret), K(segment_id), KERRMSG);
+      } else if (entries_size != read_size || header.checksum_ != calc_segment_checksum(header, entries)) {
+        ret = OB_INVALID_DATA;
+      }
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockDiskCache::flush_sealed_buffers()
+{
+  int ret = OB_SUCCESS;
+  lib::ObMutexGuard guard(write_lock_);
+  for (int64_t i = 0; i < ARRAYSIZEOF(seg_bufs_); ++i) {
+    SegmentBuffer& seg_buf = seg_bufs_[i];
+    if (ATOMIC_LOAD(&seg_buf.is_sealed_)) {
+      int tmp_ret = OB_SUCCESS;
+      if (OB_SUCCESS != (tmp_ret = write_segment(seg_buf))) {
+        // micro blocks of the buffer are dropped
+        LOG_WARN("fail to write segment", K(tmp_ret));
+        ret = OB_SUCCESS == ret ? tmp_ret : ret;
+      }
+      ObSpinLockGuard buf_guard(buf_lock_);
+      seg_buf.entry_cnt_ = 0;
+      seg_buf.data_size_ = 0;
+      ATOMIC_STORE(&seg_buf.is_sealed_, false);
+    }
+  }
+  return ret;
+}
+
+void ObMicroBlockDiskCache::disable()
+{
+  SuperBlock super_block;
+  MEMSET(&super_block, 0, sizeof(super_block));
+  ATOMIC_STORE(&is_enabled_, false);
+  // the file is formatted at the next open, if this write succeeds
+  if (sizeof(super_block) != ::pwrite(fd_, &super_block, sizeof(super_block), 0) || 0 != ::fdatasync(fd_)) {
+    LOG_ERROR("fail to clear micro block disk cache super block", KERRMSG);
+  }
+}
+
+uint64_t ObMicroBlockDiskCache::calc_segment_checksum(const SegmentHeader& header, const Entry* entries)
+{
+  SegmentHeader tmp_header = header;
+  tmp_header.checksum_ = 0;
+  return ob_crc64(ob_crc64(&tmp_header, sizeof(tmp_header)), entries, header.entry_cnt_ * sizeof(Entry));
+}
+
+}  // end namespace blocksstable
+}  // end namespace oceanbase
@@ -0,0 +1,210 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_STORAGE_BLOCKSSTABLE_OB_MICRO_BLOCK_DISK_CACHE_H_
+#define OCEANBASE_STORAGE_BLOCKSSTABLE_OB_MICRO_BLOCK_DISK_CACHE_H_
+
+#include "lib/hash/ob_hashmap.h"
+#include "lib/lock/ob_mutex.h"
+#include "lib/lock/ob_spin_lock.h"
+#include "lib/lock/ob_thread_cond.h"
+#include "share/ob_thread_pool.h"
+#include "ob_micro_block_cache.h"
+
+namespace oceanbase {
+namespace blocksstable {
+
+// Second tier of the user block cache, kept in a file on a local fast device and reused after restart.
+//
+// File layout:
+//   | SuperBlock | generation table copy 0 | generation table copy 1 | segment 0 | segment 1 | ...
+//
+// Micro blocks washed out of the memory cache are appended to an in-memory segment buffer, a full
+// buffer is written as a whole by the background thread into the next segment, round robin, so the
+// oldest segment is evicted first. The two segment buffers are the only queue between the wash path
+// and the background thread: the wash path just copies, blocks are dropped while both buffers are
+// full, and the background thread skips the records of freed macro blocks and of micro blocks already
+// on disk before it writes the segment. A segment is:
+//   | SegmentHeader | Entry[MAX_ENTRY_CNT] | record | record | ...       record: | DiskKey | micro block |
+// The header checksum covers the entries and every entry checksum covers its record, a segment torn
+// by a crash is ignored when the index is rebuilt from the segment headers on open, and a record is
+// checked against its entry and its key on every read.
+//
+// A macro block id is reused once the block is freed. Each entry records the generation of its macro
+// block (block index hashed into the generation table), mark and sweep bumps the generation of the
+// blocks it is going to free and persists the table before freeing them, so the records of a reused
+// block are never read again, even after a crash.
+class ObMicroBlockDiskCache : public common::ObIKVCacheWashListener, public share::ObThreadPool {
+public:
+  typedef common::ObIKVCache<ObMicroBlockCacheKey, ObMicroBlockCacheValue> BaseBlockCache;
+  static const int64_t SEGMENT_SIZE = 2 * 1024 * 1024;
+  static const int64_t MIN_FILE_SIZE = 64 * 1024 * 1024;
+
+  ObMicroBlockDiskCache();
+  virtual ~ObMicroBlockDiskCache();
+  // The file is formatted if it was not made by this version, of this size, or for data file %data_file_id.
+  int open(const char* file_path, const int64_t file_size, const int64_t data_file_id);
+  // write the buffered micro blocks and close the file
+  void destroy();
+  inline bool is_enabled() const
+  {
+    return ATOMIC_LOAD(&is_enabled_);
+  }
+  // Read micro block %key and put it into %cache, OB_ENTRY_NOT_EXIST if it is not in the disk cache.
+  int get(const ObMicroBlockCacheKey& key, BaseBlockCache& cache, const ObMicroBlockCacheValue*& micro_block,
+      common::ObKVCacheHandle& handle);
+  // Buffer micro block %key for the next segment, dropped with OB_EAGAIN if the buffers are busy.
+  int put(const ObMicroBlockCacheKey& key, const char* buf, const int64_t size);
+  // Persist new generations of macro blocks %block_indexes before they are freed.
+  void invalidate_blocks(const common::ObIArray<uint32_t>& block_indexes);
+  // write the segment buffers now
+  int flush();
+  virtual void on_wash(const common::ObIKVCacheKey& key, const common::ObIKVCacheValue& value) override;
+  void run1() override;
+  TO_STRING_KV(K_(is_inited), K_(is_enabled), K_(fd), K_(format_id), K_(segment_cnt), K_(next_segment_id), K_(seq),
+      K_(gen_seq), K_(get_cnt), K_(hit_cnt), K_(put_cnt), K_(drop_cnt), K_(skip_cnt), K_(segment_write_cnt));
+
+protected:
+  // whether %block_id still holds the data it had when it was cached, see ObStoreFile::free_block
+  virtual bool is_block_alive(const MacroBlockId& block_id) const;
+
+private:
+  static const uint64_t SUPER_BLOCK_MAGIC = 0x4d424443535550UL;
+  static const uint64_t GEN_TABLE_MAGIC = 0x4d42444347454eUL;
+  static const uint64_t SEGMENT_MAGIC = 0x4d424443534547UL;
+  static const int64_t VERSION = 1;
+  static const int64_t ALIGN_SIZE = 4096;
+  static const int64_t GEN_SLOT_CNT = 1L << 20;
+  static const int64_t GEN_TABLE_SIZE = ALIGN_SIZE + GEN_SLOT_CNT * sizeof(uint32_t);
+  static const int64_t FIRST_SEGMENT_OFFSET = ALIGN_SIZE + 2 * GEN_TABLE_SIZE;
+  static const int64_t MAX_ENTRY_CNT = 1024;
+  static const int64_t ENTRY_OFFSET = ALIGN_SIZE;
+  static const int64_t DATA_OFFSET = ENTRY_OFFSET + MAX_ENTRY_CNT * 32;
+  static const int64_t FLUSH_INTERVAL_MS = 1000;
+  static const int64_t PRINT_STAT_INTERVAL_US = 10 * 1000 * 1000;
+
+  struct SuperBlock {
+    uint64_t magic_;
+    int64_t version_;
+    int64_t data_file_id_;
+    int64_t format_id_;
+    int64_t segment_size_;
+    int64_t segment_cnt_;
+    int64_t gen_slot_cnt_;
+    uint64_t checksum_;
+  };
+  struct GenTableHeader {
+    uint64_t magic_;
+    int64_t format_id_;
+    int64_t seq_;
+    uint64_t checksum_;
+  };
+  struct SegmentHeader {
+    uint64_t magic_;
+    int64_t format_id_;
+    int64_t seq_;
+    int64_t entry_cnt_;
+    int64_t data_size_;
+    uint64_t checksum_;
+  };
+  struct DiskKey {
+    uint64_t table_id_;
+    int64_t block_id_[4];
+    int64_t file_id_;
+    int64_t offset_;
+    int64_t size_;
+    void set(const ObMicroBlockCacheKey& key);
+    uint64_t hash() const;
+  };
+  struct Entry {
+    uint64_t key_hash_;
+    uint32_t gen_;
+    uint32_t offset_;  // of the record in segment
+    uint32_t size_;    // of the micro block
+    uint32_t reserved_;
+    uint64_t checksum_;
+  };
+  STATIC_ASSERT(sizeof(Entry) == 32, "size of Entry is part of the file format");
+  struct Location {
+    int64_t segment_id_;
+    int64_t seq_;
+    uint32_t gen_;
+    uint32_t offset_;
+    uint32_t size_;
+    uint64_t checksum_;
+  };
+  struct SegmentBuffer {
+    SegmentBuffer() : buf_(NULL), block_ids_(NULL), entry_cnt_(0), data_size_(0), is_sealed_(false)
+    {}
+    char* buf_;
+    MacroBlockId* block_ids_;  // macro block of each entry, checked before the segment is written
+    int64_t entry_cnt_;
+    int64_t data_size_;
+    bool is_sealed_;
+  };
+  typedef common::hash::ObHashMap<uint64_t, Location> IndexMap;
+
+  int load_or_format(const int64_t data_file_id);
+  int format(const int64_t data_file_id);
+  int load_gen_table();
+  int write_gen_table();
+  int load_segments();
+  void prepare_segment(SegmentBuffer& seg_buf);
+  int write_segment(SegmentBuffer& seg_buf);
+  int erase_segment_entries(const int64_t segment_id);
+  int read_segment_header(const int64_t segment_id, SegmentHeader& header, const Entry*& entries);
+  int flush_sealed_buffers();
+  void disable();
+  inline int64_t get_segment_offset(const int64_t segment_id) const
+  {
+    return FIRST_SEGMENT_OFFSET + segment_id * SEGMENT_SIZE;
+  }
+  inline static int64_t get_gen_slot(const int64_t block_index)
+  {
+    return block_index % GEN_SLOT_CNT;
+  }
+  static uint64_t calc_segment_checksum(const SegmentHeader& header, const Entry* entries);
+
+private:
+  bool is_inited_;
+  bool is_enabled_;
+  int fd_;
+  int64_t format_id_;
+  int64_t segment_cnt_;
+  int64_t next_segment_id_;
+  int64_t seq_;
+  int64_t* segment_seqs_;  // seq of the segment data on disk, readers check it after read
+  char* gen_buf_;          // GenTableHeader page followed by the generations
+  uint32_t* gens_;
+  int64_t gen_seq_;
+  IndexMap index_;
+  SegmentBuffer seg_bufs_[2];
+  int64_t cur_buf_;
+  char* meta_buf_;  // read SegmentHeader and entries of the segment to write
+  common::ObSpinLock buf_lock_;
+  lib::ObMutex write_lock_;
+  lib::ObMutex gen_lock_;
+  common::ObThreadCond cond_;
+  common::ObArenaAllocator allocator_;
+  int64_t get_cnt_;
+  int64_t hit_cnt_;
+  int64_t put_cnt_;
+  int64_t drop_cnt_;
+  int64_t skip_cnt_;  // records of freed macro blocks or already on disk, skipped by the background thread
+  int64_t segment_write_cnt_;
+  DISALLOW_COPY_AND_ASSIGN(ObMicroBlockDiskCache);
+};
+
+}  // end namespace blocksstable
+}  // end namespace oceanbase
+
+#endif  // OCEANBASE_STORAGE_BLOCKSSTABLE_OB_MICRO_BLOCK_DISK_CACHE_H_
@@ -0,0 +1,679 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX STORAGE
+
+#include "ob_micro_block_encoder.h"
+#include <algorithm>
+#include "ob_row_reader.h"
+#include "storage/ob_i_store.h"
+
+namespace oceanbase {
+using namespace common;
+using namespace storage;
+namespace blocksstable {
+
+struct ObEncodingStringIdxCompare {
+  explicit ObEncodingStringIdxCompare(const ObString* values) : values_(values)
+  {}
+  bool operator()(const int64_t l, const int64_t r) const
+  {
+    const int cmp = values_[l].compare(values_[r]);
+    return cmp < 0 || (0 == cmp && l < r);
+  }
+  const ObString* values_;
+};
+
+ObMicroBlockEncoder::ObMicroBlockEncoder()
+    : flat_writer_(),
+      column_types_(),
+      allocator_("MicrBlocEncoder"),
+      cells_(NULL),
+      row_flags_(NULL),
+      row_dmls_(NULL),
+      row_type_flags_(NULL),
+      data_buffer_(0, "MicrBlocEncoder", false),
+      is_built_(false),
+      is_inited_(false)
+{}
+
+ObMicroBlockEncoder::~ObMicroBlockEncoder()
+{}
+
+int ObMicroBlockEncoder::init(const int64_t micro_block_size_limit, const int64_t rowkey_column_count,
+    const int64_t column_count, const ObObjMeta* column_types)
+{
+  int ret = OB_SUCCESS;
+  if (is_inited_) {
+    reset();
+  }
+  if (OB_ISNULL(column_types) || OB_UNLIKELY(column_count <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "invalid argument", K(ret), KP(column_types), K(column_count));
+  } else if (OB_FAIL(flat_writer_.init(micro_block_size_limit, rowkey_column_count, column_count))) {
+    STORAGE_LOG(WARN, "fail to init staging writer", K(ret), K(micro_block_size_limit), K(rowkey_column_count));
+  } else if (OB_FAIL(data_buffer_.ensure_space(DEFAULT_DATA_BUFFER_SIZE))) {
+    STORAGE_LOG(WARN, "data buffer fail to ensure space.", K(ret));
+  } else {
+    for (int64_t i = 0; OB_SUCC(ret) && i < column_count; ++i) {
+      if (OB_FAIL(column_types_.push_back(column_types[i]))) {
+        STORAGE_LOG(WARN, "fail to push back column type", K(ret), K(i));
+      }
+    }
+    if (OB_SUCC(ret)) {
+      is_inited_ = true;
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockEncoder::append_row(const ObStoreRow& row)
+{
+  int ret = OB_SUCCESS;
+  if (!is_inited_) {
+    ret = OB_NOT_INIT;
+    STORAGE_LOG(WARN, "should init encoder before append row", K(ret));
+  } else if (OB_UNLIKELY(is_built_)) {
+    ret = OB_ERR_UNEXPECTED;
+    STORAGE_LOG(WARN, "micro block is already built", K(ret));
+  } else if (OB_UNLIKELY(row.is_sparse_row_ || row.row_type_flag_.is_uncommitted_row())) {
+    // transaction id of uncommitted row is not kept in encoded block
+    ret = OB_NOT_SUPPORTED;
+    STORAGE_LOG(WARN, "encoding micro block only supports committed flat row", K(ret), K(row));
+  } else if (OB_FAIL(flat_writer_.append_row(row))) {
+    if (OB_BUF_NOT_ENOUGH != ret) {
+      STORAGE_LOG(WARN, "fail to stage row", K(ret), K(row));
+    }
+  } else {
+    cal_delta(row);
+    if (need_cal_row_checksum()) {
+      micro_block_checksum_ = cal_row_checksum(row, micro_block_checksum_);
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockEncoder::build_block(char*& buf, int64_t& size)
+{
+  int ret = OB_SUCCESS;
+  char* flat_buf = NULL;
+  int64_t flat_size = 0;
+  ObEncodingColumnHeader* headers = NULL;
+  const int64_t column_count = get_column_count();
+  const int64_t header_count = column_count + 1;
+  if (!is_inited_) {
+    ret = OB_NOT_INIT;
+    STORAGE_LOG(WARN, "should init encoder before build block", K(ret));
+  } else if (OB_UNLIKELY(get_row_count() <= 0)) {
+    ret = OB_INNER_STAT_ERROR;
+    STORAGE_LOG(WARN, "no row to build", K(ret));
+  } else if (OB_FAIL(flat_writer_.build_block(flat_buf, flat_size))) {
+    STORAGE_LOG(WARN, "fail to build staging block", K(ret));
+  } else if (OB_FAIL(read_staged_rows(flat_buf, flat_size))) {
+    STORAGE_LOG(WARN, "fail to read staged rows", K(ret));
+  } else if (OB_ISNULL(headers = static_cast<ObEncodingColumnHeader*>(
+                           allocator_.alloc(sizeof(ObEncodingColumnHeader) * header_count)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    STORAGE_LOG(WARN, "fail to allocate column headers", K(ret), K(header_count));
+  } else {
+    ObMicroBlockHeader block_header;
+    block_header.header_size_ = static_cast<int32_t>(sizeof(ObMicroBlockHeader));
+    block_header.version_ = MICRO_BLOCK_HEADER_VERSION;
+    block_header.magic_ = MICRO_BLOCK_HEADER_MAGIC;
+    block_header.attr_ = 0;
+    block_header.column_count_ = static_cast<int32_t>(column_count);
+    block_header.row_count_ = static_cast<int32_t>(get_row_count());
+    data_buffer_.reuse();
+    if (OB_FAIL(data_buffer_.write_pod(block_header))) {
+      STORAGE_LOG(WARN, "fail to write block header", K(ret));
+    }
+    // reserve space of column headers, filled after all columns are encoded
+    for (int64_t i = 0; OB_SUCC(ret) && i < header_count; ++i) {
+      new (headers + i) ObEncodingColumnHeader();
+      if (OB_FAIL(data_buffer_.write_pod(headers[i]))) {
+        STORAGE_LOG(WARN, "fail to reserve column header", K(ret), K(i));
+      }
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && i < header_count; ++i) {
+      const int64_t offset = data_buffer_.length();
+      headers[i].offset_ = static_cast<uint32_t>(offset);
+      if (i < column_count) {
+        ret = encode_column(i, headers[i]);
+      } else {
+        ret = encode_row_header_column(headers[i]);
+      }
+      if (OB_FAIL(ret)) {
+        STORAGE_LOG(WARN, "fail to encode column", K(ret), K(i));
+      } else {
+        headers[i].length_ = static_cast<uint32_t>(data_buffer_.length() - offset);
+      }
+    }
+    if (OB_SUCC(ret)) {
+      ObMicroBlockHeader* header = reinterpret_cast<ObMicroBlockHeader*>(data_buffer_.data());
+      header->row_index_offset_ = static_cast<int32_t>(data_buffer_.length());
+      MEMCPY(data_buffer_.data() + sizeof(ObMicroBlockHeader), headers, sizeof(ObEncodingColumnHeader) * header_count);
+      buf = data_buffer_.data();
+      size = data_buffer_.length();
+      is_built_ = true;
+      STORAGE_LOG(DEBUG, "build encoding micro block", K(flat_size), K(size), K(get_row_count()));
+    }
+  }
+  return ret;
+}
+
+void ObMicroBlockEncoder::reuse()
+{
+  ObIMicroBlockWriter::reuse();
+  flat_writer_.reuse();
+  allocator_.reuse();
+  cells_ = NULL;
+  row_flags_ = NULL;
+  row_dmls_ = NULL;
+  row_type_flags_ = NULL;
+  data_buffer_.reuse();
+  is_built_ = false;
+}
+
+void ObMicroBlockEncoder::reset()
+{
+  ObIMicroBlockWriter::reuse();
+  flat_writer_.reset();
+  column_types_.reset();
+  allocator_.reset();
+  cells_ = NULL;
+  row_flags_ = NULL;
+  row_dmls_ = NULL;
+  row_type_flags_ = NULL;
+  data_buffer_.reuse();
+  is_built_ = false;
+  is_inited_ = false;
+}
+
+int ObMicroBlockEncoder::read_staged_rows(const char* block, const int64_t block_size)
+{
+  int ret = OB_SUCCESS;
+  const ObMicroBlockHeader* header = reinterpret_cast<const ObMicroBlockHeader*>(block);
+  const int64_t row_count = get_row_count();
+  const int64_t column_count = get_column_count();
+  void* buf = NULL;
+  allocator_.reuse();
+  if (OB_ISNULL(block) || OB_UNLIKELY(block_size < static_cast<int64_t>(sizeof(ObMicroBlockHeader)) ||
+                                       block_size < header->row_index_offset_)) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "invalid staging block", K(ret), KP(block), K(block_size));
+  } else if (OB_ISNULL(buf = allocator_.alloc(sizeof(ObObj) * row_count * column_count + 3 * row_count))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    STORAGE_LOG(WARN, "fail to allocate staged cells", K(ret), K(row_count), K(column_count));
+  } else {
+    cells_ = static_cast<ObObj*>(buf);
+    for (int64_t i = 0; i < row_count * column_count; ++i) {
+      new (cells_ + i) ObObj();
+    }
+    row_flags_ = reinterpret_cast<int8_t*>(cells_ + row_count * column_count);
+    row_dmls_ = row_flags_ + row_count;
+    row_type_flags_ = row_dmls_ + row_count;
+
+    const char* data_begin = block + header->header_size_;
+    const int32_t* index_data = reinterpret_cast<const int32_t*>(block + header->row_index_offset_);
+    ObFlatRowReader row_reader;
+    ObStoreRow row;
+    for (int64_t i = 0; OB_SUCC(ret) && i < row_count; ++i) {
+      row.row_val_.cells_ = cells_ + i * column_count;
+      row.row_val_.count_ = column_count;
+      row.capacity_ = column_count;
+      if (OB_FAIL(row_reader.read_full_row(
+              data_begin, index_data[i + 1], index_data[i], &column_types_.at(0), allocator_, row))) {
+        STORAGE_LOG(WARN, "fail to read staged row", K(ret), K(i));
+      } else {
+        row_flags_[i] = static_cast<int8_t>(row.flag_);
+        row_dmls_[i] = row.get_dml_val();
+        row_type_flags_[i] = row.row_type_flag_.flag_;
+      }
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockEncoder::encode_column(const int64_t column_idx, ObEncodingColumnHeader& header)
+{
+  int ret = OB_SUCCESS;
+  const int64_t row_count = get_row_count();
+  const int64_t column_count = get_column_count();
+  const ObObj* first = NULL;
+  bool has_null = false;
+  bool uniform = true;  // all not null cells share the same meta
+  for (int64_t i = 0; i < row_count; ++i) {
+    const ObObj& cell = cells_[i * column_count + column_idx];
+    if (cell.is_null()) {
+      has_null = true;
+    } else if (cell.is_ext()) {
+      uniform = false;
+    } else if (NULL == first) {
+      first = &cell;
+    } else if (first->get_meta() != cell.get_meta() || first->get_scale() != cell.get_scale()) {
+      uniform = false;
+    }
+  }
+
+  header.meta_ = column_types_.at(column_idx);
+  if (NULL == first && uniform) {
+    header.type_ = OB_ENCODING_CONST;
+    header.domain_ = OB_DOMAIN_INT;
+    header.attr_ = ObEncodingColumnHeader::HAS_NULL | ObEncodingColumnHeader::ALL_NULL;
+  } else {
+    char* null_bitmap = NULL;
+    const ObObjTypeClass tc = NULL == first ? ObMaxTC : first->get_type_class();
+    if (uniform && (ObEncodingUtil::is_int_domain(tc) || ObEncodingUtil::is_string_domain(tc))) {
+      header.meta_ = first->get_meta();
+      header.domain_ = ObEncodingUtil::is_int_domain(tc) ? OB_DOMAIN_INT : OB_DOMAIN_STRING;
+      if (has_null) {
+        const int64_t bitmap_size = ObEncodingUtil::get_bitmap_size(row_count);
+        header.attr_ |= ObEncodingColumnHeader::HAS_NULL;
+        if (OB_ISNULL(null_bitmap = static_cast<char*>(allocator_.alloc(bitmap_size)))) {
+          ret = OB_ALLOCATE_MEMORY_FAILED;
+          STORAGE_LOG(WARN, "fail to allocate null bitmap", K(ret), K(bitmap_size));
+        } else {
+          MEMSET(null_bitmap, 0, bitmap_size);
+          for (int64_t i = 0; i < row_count; ++i) {
+            if (cells_[i * column_count + column_idx].is_null()) {
+              ObEncodingUtil::bitmap_set(null_bitmap, i);
+            }
+          }
+          if (OB_FAIL(data_buffer_.write(null_bitmap, bitmap_size))) {
+            STORAGE_LOG(WARN, "fail to write null bitmap", K(ret));
+          }
+        }
+      }
+    } else {
+      header.domain_ = OB_DOMAIN_OBJ;
+    }
+
+    if (OB_FAIL(ret)) {
+    } else if (OB_DOMAIN_INT == header.domain_) {
+      // null cells take the value of the first not null cell, so they never widen the value range
+      const uint64_t placeholder = ObEncodingUtil::get_int_value(*first);
+      uint64_t* values = static_cast<uint64_t*>(allocator_.alloc(sizeof(uint64_t) * row_count));
+      if (OB_ISNULL(values)) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        STORAGE_LOG(WARN, "fail to allocate int values", K(ret), K(row_count));
+      } else {
+        for (int64_t i = 0; i < row_count; ++i) {
+          const ObObj& cell = cells_[i * column_count + column_idx];
+          values[i] = cell.is_null() ? placeholder : ObEncodingUtil::get_int_value(cell);
+        }
+        ret = encode_int_column(values, header);
+      }
+    } else {
+      ObString* values = static_cast<ObString*>(allocator_.alloc(sizeof(ObString) * row_count));
+      if (OB_ISNULL(values)) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        STORAGE_LOG(WARN, "fail to allocate string values", K(ret), K(row_count));
+      }
+      for (int64_t i = 0; OB_SUCC(ret) && i < row_count; ++i) {
+        const ObObj& cell = cells_[i * column_count + column_idx];
+        new (values + i) ObString();
+        if (OB_DOMAIN_STRING == header.domain_) {
+          if (!cell.is_null()) {
+            values[i].assign_ptr(cell.v_.string_, cell.val_len_);
+          }
+        } else {
+          const int64_t serialize_size = cell.get_serialize_size();
+          int64_t pos = 0;
+          char* buf = static_cast<char*>(allocator_.alloc(serialize_size));
+          if (OB_ISNULL(buf)) {
+            ret = OB_ALLOCATE_MEMORY_FAILED;
+            STORAGE_LOG(WARN, "fail to allocate serialize buffer", K(ret), K(serialize_size));
+          } else if (OB_FAIL(cell.serialize(buf, serialize_size, pos))) {
+            STORAGE_LOG(WARN, "fail to serialize cell", K(ret), K(cell));
+          } else {
+            values[i].assign_ptr(buf, static_cast<int32_t>(pos));
+          }
+        }
+      }
+      if (OB_SUCC(ret)) {
+        ret = encode_bytes_column(values, OB_DOMAIN_STRING == header.domain_, header);
+      }
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockEncoder::encode_row_header_column(ObEncodingColumnHeader& header)
+{
+  int ret = OB_SUCCESS;
+  const int64_t row_count = get_row_count();
+  uint64_t* values = static_cast<uint64_t*>(allocator_.alloc(sizeof(uint64_t) * row_count));
+  if (OB_ISNULL(values)) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    STORAGE_LOG(WARN, "fail to allocate row header values", K(ret), K(row_count));
+  } else {
+    for (int64_t i = 0; i < row_count; ++i) {
+      values[i] = static_cast<uint64_t>(static_cast<uint8_t>(row_flags_[i])) |
+                  static_cast<uint64_t>(static_cast<uint8_t>(row_dmls_[i])) << 8 |
+                  static_cast<uint64_t>(static_cast<uint8_t>(row_type_flags_[i])) << 16;
+    }
+    header.meta_.set_uint64();
+    header.domain_ = OB_DOMAIN_INT;
+    ret = encode_int_column(values, header);
+  }
+  return ret;
+}
+
+int ObMicroBlockEncoder::encode_int_column(const uint64_t* values, ObEncodingColumnHeader& header)
+{
+  int ret = OB_SUCCESS;
+  const int64_t row_count = get_row_count();
+  uint64_t* sorted = static_cast<uint64_t*>(allocator_.alloc(sizeof(uint64_t) * row_count));
+  uint64_t* run_values = static_cast<uint64_t*>(allocator_.alloc(sizeof(uint64_t) * row_count));
+  uint32_t* run_ends = static_cast<uint32_t*>(allocator_.alloc(sizeof(uint32_t) * row_count));
+  if (OB_ISNULL(sorted) || OB_ISNULL(run_values) || OB_ISNULL(run_ends)) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    STORAGE_LOG(WARN, "fail to allocate encoding buffer", K(ret), K(row_count));
+  } else {
+    // signed and unsigned value ranges, the narrower one is used as frame of reference
+    int64_t smin = static_cast<int64_t>(values[0]);
+    int64_t smax = smin;
+    uint64_t umin = values[0];
+    uint64_t umax = umin;
+    int64_t run_count = 0;
+    for (int64_t i = 0; i < row_count; ++i) {
+      const int64_t sv = static_cast<int64_t>(values[i]);
+      smin = std::min(smin, sv);
+      smax = std::max(smax, sv);
+      umin = std::min(umin, values[i]);
+      umax = std::max(umax, values[i]);
+      sorted[i] = values[i];
+      if (0 == i || values[i] != values[i - 1]) {
+        run_values[run_count++] = values[i];
+      }
+      run_ends[run_count - 1] = static_cast<uint32_t>(i + 1);
+    }
+    const uint64_t srange = static_cast<uint64_t>(smax) - static_cast<uint64_t>(smin);
+    const uint64_t urange = umax - umin;
+    const uint64_t base = srange < urange ? static_cast<uint64_t>(smin) : umin;
+    const int64_t width = ObEncodingUtil::get_bit_width(std::min(srange, urange));
+
+    std::sort(sorted, sorted + row_count);
+    const int64_t dict_count = std::unique(sorted, sorted + row_count) - sorted;
+    const int64_t dict_width = ObEncodingUtil::get_bit_width(sorted[dict_count - 1] - sorted[0]);
+    const int64_t ref_width = ObEncodingUtil::get_bit_width(dict_count - 1);
+
+    const int64_t packed_header_size = sizeof(uint64_t) + sizeof(uint8_t);
+    const int64_t integer_size = packed_header_size + ObEncodingUtil::get_packed_size(row_count, width);
+    const int64_t dict_size = sizeof(uint32_t) + 2 * packed_header_size +
+                              ObEncodingUtil::get_packed_size(dict_count, dict_width) +
+                              ObEncodingUtil::get_packed_size(row_count, ref_width);
+    const int64_t rle_size = sizeof(uint32_t) * (run_count + 1) + packed_header_size +
+                             ObEncodingUtil::get_packed_size(run_count, width);
+    int64_t best_size = integer_size;
+    header.type_ = OB_ENCODING_INTEGER;
+    if (1 == dict_count) {
+      header.type_ = OB_ENCODING_CONST;
+      best_size = sizeof(uint64_t);
+    }
+    if (dict_size < best_size) {
+      header.type_ = OB_ENCODING_DICT;
+      best_size = dict_size;
+    }
+    if (rle_size < best_size) {
+      header.type_ = OB_ENCODING_RLE;
+      best_size = rle_size;
+    }
+
+    switch (header.type_) {
+      case OB_ENCODING_CONST: {
+        ret = data_buffer_.write_pod(values[0]);
+        break;
+      }
+      case OB_ENCODING_INTEGER: {
+        ret = write_packed(values, row_count, base, width);
+        break;
+      }
+      case OB_ENCODING_DICT: {
+        // refs are written over run_values, which is not used by dict encoding
+        uint64_t* refs = run_values;
+        for (int64_t i = 0; i < row_count; ++i) {
+          refs[i] = std::lower_bound(sorted, sorted + dict_count, values[i]) - sorted;
+        }
+        if (OB_FAIL(data_buffer_.write_pod(static_cast<uint32_t>(dict_count)))) {
+        } else if (OB_FAIL(write_packed(sorted, dict_count, sorted[0], dict_width))) {
+        } else {
+          ret = write_packed(refs, row_count, 0, ref_width);
+        }
+        break;
+      }
+      case OB_ENCODING_RLE: {
+        if (OB_FAIL(data_buffer_.write_pod(static_cast<uint32_t>(run_count)))) {
+        } else if (OB_FAIL(data_buffer_.write(reinterpret_cast<const char*>(run_ends), sizeof(uint32_t) * run_count))) {
+        } else {
+          ret = write_packed(run_values, run_count, base, width);
+        }
+        break;
+      }
+      default: {
+        ret = OB_ERR_UNEXPECTED;
+        break;
+      }
+    }
+    if (OB_FAIL(ret)) {
+      STORAGE_LOG(WARN, "fail to write int column", K(ret), K(header));
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockEncoder::encode_bytes_column(
+    const ObString* values, const bool enable_prefix, ObEncodingColumnHeader& header)
+{
+  int ret = OB_SUCCESS;
+  const int64_t row_count = get_row_count();
+  int64_t* idx = static_cast<int64_t*>(allocator_.alloc(sizeof(int64_t) * row_count));
+  uint64_t* refs = static_cast<uint64_t*>(allocator_.alloc(sizeof(uint64_t) * row_count));
+  ObString* dict_values = static_cast<ObString*>(allocator_.alloc(sizeof(ObString) * row_count));
+  ObString* run_values = static_cast<ObString*>(allocator_.alloc(sizeof(ObString) * row_count));
+  uint32_t* run_ends = static_cast<uint32_t*>(allocator_.alloc(sizeof(uint32_t) * row_count));
+  if (OB_ISNULL(idx) || OB_ISNULL(refs) || OB_ISNULL(dict_values) || OB_ISNULL(run_values) || OB_ISNULL(run_ends)) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    STORAGE_LOG(WARN, "fail to allocate encoding buffer", K(ret), K(row_count));
+  } else {
+    int64_t total_bytes = 0;
+    int64_t run_count = 0;
+    int64_t run_bytes = 0;
+    int64_t prefix_size = sizeof(uint32_t) * (row_count + 1);
+    for (int64_t i = 0; i < row_count; ++i) {
+      const ObString& value = values[i];
+      idx[i] = i;
+      total_bytes += value.length();
+      if (0 == i || value != values[i - 1]) {
+        new (run_values + run_count) ObString(value);
+        run_bytes += value.length();
+        ++run_count;
+      }
+      run_ends[run_count - 1] = static_cast<uint32_t>(i + 1);
+      int64_t prefix = 0;
+      if (0 != i % ObEncodingUtil::PREFIX_RESTART_INTERVAL) {
+        const ObString& prev = values[i - 1];
+        const int64_t max_prefix = std::min(static_cast<int64_t>(std::min(prev.length(), value.length())),
+            static_cast<int64_t>(ObEncodingUtil::MAX_PREFIX_LENGTH));
+        while (prefix < max_prefix && prev.ptr()[prefix] == value.ptr()[prefix]) {
+          ++prefix;
+        }
+      }
+      prefix_size += sizeof(uint16_t) + value.length() - prefix;
+    }
+
+    std::sort(idx, idx + row_count, ObEncodingStringIdxCompare(values));
+    int64_t dict_count = 0;
+    int64_t dict_bytes = 0;
+    for (int64_t i = 0; i < row_count; ++i) {
+      if (0 == i || values[idx[i]] != dict_values[dict_count - 1]) {
+        new (dict_values + dict_count) ObString(values[idx[i]]);
+        dict_bytes += values[idx[i]].length();
+        ++dict_count;
+      }
+      refs[idx[i]] = dict_count - 1;
+    }
+    const int64_t ref_width = ObEncodingUtil::get_bit_width(dict_count - 1);
+
+    const int64_t raw_size = sizeof(uint32_t) * (row_count + 1) + total_bytes;
+    const int64_t const_size = sizeof(uint32_t) * 2 + values[0].length();
+    const int64_t dict_size = sizeof(uint32_t) * (dict_count + 2) + dict_bytes + sizeof(uint64_t) +
+                              sizeof(uint8_t) + ObEncodingUtil::get_packed_size(row_count, ref_width);
+    const int64_t rle_size = sizeof(uint32_t) * (2 * run_count + 2) + run_bytes;
+    int64_t best_size = raw_size;
+    header.type_ = OB_ENCODING_RAW;
+    if (1 == dict_count && const_size <= best_size) {
+      header.type_ = OB_ENCODING_CONST;
+      best_size = const_size;
+    }
+    if (dict_size < best_size) {
+      header.type_ = OB_ENCODING_DICT;
+      best_size = dict_size;
+    }
+    if (rle_size < best_size) {
+      header.type_ = OB_ENCODING_RLE;
+      best_size = rle_size;
+    }
+    if (enable_prefix && prefix_size < best_size) {
+      header.type_ = OB_ENCODING_PREFIX;
+      best_size = prefix_size;
+    }
+
+    switch (header.type_) {
+      case OB_ENCODING_RAW: {
+        ret = write_offsets_and_bytes(values, row_count);
+        break;
+      }
+      case OB_ENCODING_CONST: {
+        ret = write_offsets_and_bytes(values, 1);
+        break;
+      }
+      case OB_ENCODING_DICT: {
+        if (OB_FAIL(data_buffer_.write_pod(static_cast<uint32_t>(dict_count)))) {
+        } else if (OB_FAIL(write_offsets_and_bytes(dict_values, dict_count))) {
+        } else {
+          ret = write_packed(refs, row_count, 0, ref_width);
+        }
+        break;
+      }
+      case OB_ENCODING_RLE: {
+        if (OB_FAIL(data_buffer_.write_pod(static_cast<uint32_t>(run_count)))) {
+        } else if (OB_FAIL(data_buffer_.write(reinterpret_cast<const char*>(run_ends), sizeof(uint32_t) * run_count))) {
+        } else {
+          ret = write_offsets_and_bytes(run_values, run_count);
+        }
+        break;
+      }
+      case OB_ENCODING_PREFIX: {
+        ret = write_prefix(values);
+        break;
+      }
+      default: {
+        ret = OB_ERR_UNEXPECTED;
+        break;
+      }
+    }
+    if (OB_FAIL(ret)) {
+      STORAGE_LOG(WARN, "fail to write bytes column", K(ret), K(header));
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockEncoder::write_packed(const uint64_t* values, const int64_t count, const uint64_t base, const int64_t width)
+{
+  int ret = OB_SUCCESS;
+  const int64_t packed_size = ObEncodingUtil::get_packed_size(count, width);
+  char* packed = NULL;
+  if (OB_FAIL(data_buffer_.write_pod(base))) {
+    STORAGE_LOG(WARN, "fail to write base", K(ret));
+  } else if (OB_FAIL(data_buffer_.write_pod(static_cast<uint8_t>(width)))) {
+    STORAGE_LOG(WARN, "fail to write width", K(ret));
+  } else if (0 == packed_size) {
+    // all values equal to base
+  } else if (OB_ISNULL(packed = static_cast<char*>(allocator_.alloc(packed_size)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    STORAGE_LOG(WARN, "fail to allocate packed buffer", K(ret), K(packed_size));
+  } else {
+    MEMSET(packed, 0, packed_size);
+    for (int64_t i = 0; i < count; ++i) {
+      ObEncodingUtil::pack(packed, i, width, values[i] - base);
+    }
+    if (OB_FAIL(data_buffer_.write(packed, packed_size))) {
+      STORAGE_LOG(WARN, "fail to write packed values", K(ret), K(packed_size));
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockEncoder::write_offsets_and_bytes(const ObString* values, const int64_t count)
+{
+  int ret = OB_SUCCESS;
+  uint32_t offset = 0;
+  for (int64_t i = 0; OB_SUCC(ret) && i <= count; ++i) {
+    if (OB_FAIL(data_buffer_.write_pod(offset))) {
+      STORAGE_LOG(WARN, "fail to write offset", K(ret), K(i));
+    } else if (i < count) {
+      offset += static_cast<uint32_t>(values[i].length());
+    }
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < count; ++i) {
+    if (OB_FAIL(data_buffer_.write(values[i].ptr(), values[i].length()))) {
+      STORAGE_LOG(WARN, "fail to write bytes", K(ret), K(i));
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockEncoder::write_prefix(const ObString* values)
+{
+  int ret = OB_SUCCESS;
+  const int64_t row_count = get_row_count();
+  uint16_t* prefixes = static_cast<uint16_t*>(allocator_.alloc(sizeof(uint16_t) * row_count));
+  if (OB_ISNULL(prefixes)) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    STORAGE_LOG(WARN, "fail to allocate prefix buffer", K(ret), K(row_count));
+  } else {
+    uint32_t offset = 0;
+    for (int64_t i = 0; OB_SUCC(ret) && i < row_count; ++i) {
+      int64_t prefix = 0;
+      if (0 != i % ObEncodingUtil::PREFIX_RESTART_INTERVAL) {
+        const ObString& prev = values[i - 1];
+        const int64_t max_prefix = std::min(static_cast<int64_t>(std::min(prev.length(), values[i].length())),
+            static_cast<int64_t>(ObEncodingUtil::MAX_PREFIX_LENGTH));
+        while (prefix < max_prefix && prev.ptr()[prefix] == values[i].ptr()[prefix]) {
+          ++prefix;
+        }
+      }
+      prefixes[i] = static_cast<uint16_t>(prefix);
+      if (OB_FAIL(data_buffer_.write_pod(offset))) {
+        STORAGE_LOG(WARN, "fail to write offset", K(ret), K(i));
+      } else {
+        offset += static_cast<uint32_t>(sizeof(uint16_t) + values[i].length() - prefix);
+      }
+    }
+    if (OB_SUCC(ret) && OB_FAIL(data_buffer_.write_pod(offset))) {
+      STORAGE_LOG(WARN, "fail to write last offset", K(ret));
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && i < row_count; ++i) {
+      if (OB_FAIL(data_buffer_.write_pod(prefixes[i]))) {
+        STORAGE_LOG(WARN, "fail to write prefix length", K(ret), K(i));
+      } else if (OB_FAIL(data_buffer_.write(values[i].ptr() + prefixes[i], values[i].length() - prefixes[i]))) {
+        STORAGE_LOG(WARN, "fail to write suffix", K(ret), K(i));
+      }
+    }
+  }
+  return ret;
+}
+
+}  // end namespace blocksstable
+}  // end namespace oceanbase
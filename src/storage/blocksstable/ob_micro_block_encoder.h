@@ -0,0 +1,90 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_STORAGE_BLOCKSSTABLE_OB_MICRO_BLOCK_ENCODER_H_
+#define OCEANBASE_STORAGE_BLOCKSSTABLE_OB_MICRO_BLOCK_ENCODER_H_
+
+#include "lib/allocator/page_arena.h"
+#include "lib/container/ob_array.h"
+#include "ob_micro_block_encoding.h"
+#include "ob_micro_block_writer.h"
+
+namespace oceanbase {
+namespace blocksstable {
+// Writer of ENCODING_ROW_STORE micro blocks.
+//
+// Rows are staged in a flat micro block, so that the split size, the last rowkey and
+// the row count of an encoded micro block are exactly the same as the flat one.
+// When the block is built, every column is encoded independently with the cheapest of
+// const / integer / dict / rle / prefix / raw encoding.
+class ObMicroBlockEncoder : public ObIMicroBlockWriter {
+  static const int64_t DEFAULT_DATA_BUFFER_SIZE = common::OB_DEFAULT_MACRO_BLOCK_SIZE;
+
+public:
+  ObMicroBlockEncoder();
+  virtual ~ObMicroBlockEncoder();
+  int init(const int64_t micro_block_size_limit, const int64_t rowkey_column_count, const int64_t column_count,
+      const common::ObObjMeta* column_types);
+  virtual int append_row(const storage::ObStoreRow& row) override;
+  virtual int build_block(char*& buf, int64_t& size) override;
+  virtual void reuse() override;
+
+  virtual int64_t get_block_size() const override
+  {
+    return flat_writer_.get_block_size();
+  }
+  virtual int64_t get_row_count() const override
+  {
+    return flat_writer_.get_row_count();
+  }
+  // size of the encoded block once built, otherwise size of staged rows
+  virtual int64_t get_data_size() const override
+  {
+    return is_built_ ? data_buffer_.length() : flat_writer_.get_data_size();
+  }
+  virtual int64_t get_column_count() const override
+  {
+    return flat_writer_.get_column_count();
+  }
+  virtual common::ObString get_last_rowkey() const override
+  {
+    return flat_writer_.get_last_rowkey();
+  }
+  void reset();
+
+private:
+  int read_staged_rows(const char* block, const int64_t block_size);
+  int encode_column(const int64_t column_idx, ObEncodingColumnHeader& header);
+  int encode_row_header_column(ObEncodingColumnHeader& header);
+  int encode_int_column(const uint64_t* values, ObEncodingColumnHeader& header);
+  int encode_bytes_column(const common::ObString* values, const bool enable_prefix, ObEncodingColumnHeader& header);
+  int write_packed(const uint64_t* values, const int64_t count, const uint64_t base, const int64_t width);
+  int write_offsets_and_bytes(const common::ObString* values, const int64_t count);
+  int write_prefix(const common::ObString* values);
+
+private:
+  ObMicroBlockWriter flat_writer_;
+  common::ObArray<common::ObObjMeta> column_types_;
+  common::ObArenaAllocator allocator_;  // staged cells of the building block
+  common::ObObj* cells_;                // row_count * column_count, row major
+  int8_t* row_flags_;
+  int8_t* row_dmls_;
+  int8_t* row_type_flags_;
+  ObSelfBufferWriter data_buffer_;
+  bool is_built_;
+  bool is_inited_;
+};
+
+}  // end namespace blocksstable
+}  // end namespace oceanbase
+
+#endif  // OCEANBASE_STORAGE_BLOCKSSTABLE_OB_MICRO_BLOCK_ENCODER_H_
@@ -0,0 +1,237 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_STORAGE_BLOCKSSTABLE_OB_MICRO_BLOCK_ENCODING_H_
+#define OCEANBASE_STORAGE_BLOCKSSTABLE_OB_MICRO_BLOCK_ENCODING_H_
+
+#include "lib/utility/ob_print_utils.h"
+#include "common/object/ob_object.h"
+
+namespace oceanbase {
+namespace blocksstable {
+// Layout of a column-wise encoded micro block (ENCODING_ROW_STORE):
+//
+//  |- ObMicroBlockHeader
+//  |- ObEncodingColumnHeader[column_count + 1]
+//  |- column data of column 0
+//  |     |- null bitmap (only if HAS_NULL)
+//  |     |- encoded payload
+//  |- ...
+//  |- column data of the row header meta column
+//
+// The last column header describes a hidden column which keeps row flag, dml and
+// multi version row flag of every row, so the row header can be restored without
+// touching any user column.
+enum ObColumnEncodingType {
+  OB_ENCODING_RAW = 0,
+  OB_ENCODING_CONST = 1,
+  OB_ENCODING_INTEGER = 2,  // frame of reference + bit packing
+  OB_ENCODING_DICT = 3,
+  OB_ENCODING_RLE = 4,
+  OB_ENCODING_PREFIX = 5,
+  OB_ENCODING_MAX
+};
+
+// how cell values of a column are represented inside the payload
+enum ObEncodingValueDomain {
+  OB_DOMAIN_INT = 0,     // fixed length values kept in 64 bits, decoded with column meta
+  OB_DOMAIN_STRING = 1,  // string bytes, decoded with column meta
+  OB_DOMAIN_OBJ = 2,     // serialized ObObj, for all the other types or mixed metas
+  OB_DOMAIN_MAX
+};
+
+struct ObEncodingColumnHeader {
+  static const uint8_t HAS_NULL = 0x1;
+  static const uint8_t ALL_NULL = 0x2;
+
+  uint8_t type_;
+  uint8_t domain_;
+  uint8_t attr_;
+  uint8_t reserved_;
+  common::ObObjMeta meta_;
+  uint32_t offset_;  // offset of column data from the beginning of the block
+  uint32_t length_;  // length of column data, including null bitmap
+
+  ObEncodingColumnHeader()
+  {
+    reset();
+  }
+  void reset()
+  {
+    type_ = OB_ENCODING_MAX;
+    domain_ = OB_DOMAIN_MAX;
+    attr_ = 0;
+    reserved_ = 0;
+    meta_.reset();
+    offset_ = 0;
+    length_ = 0;
+  }
+  bool is_valid() const
+  {
+    return type_ < OB_ENCODING_MAX && domain_ < OB_DOMAIN_MAX;
+  }
+  OB_INLINE bool has_null() const
+  {
+    return attr_ & HAS_NULL;
+  }
+  OB_INLINE bool is_all_null() const
+  {
+    return attr_ & ALL_NULL;
+  }
+  TO_STRING_KV(K_(type), K_(domain), K_(attr), K_(meta), K_(offset), K_(length));
+} __attribute__((packed));
+
+// encoding helpers shared by ObMicroBlockEncoder and ObMicroBlockDecoder
+class ObEncodingUtil {
+public:
+  static const int64_t PREFIX_RESTART_INTERVAL = 16;
+  static const int64_t MAX_PREFIX_LENGTH = UINT16_MAX;
+
+  static bool is_int_domain(const common::ObObjTypeClass tc)
+  {
+    return common::ObIntTC == tc || common::ObUIntTC == tc || common::ObFloatTC == tc || common::ObDoubleTC == tc ||
+           common::ObDateTimeTC == tc || common::ObDateTC == tc || common::ObTimeTC == tc ||
+           common::ObYearTC == tc || common::ObBitTC == tc || common::ObEnumSetTC == tc;
+  }
+  static bool is_string_domain(const common::ObObjTypeClass tc)
+  {
+    return common::ObStringTC == tc;
+  }
+
+  // normalize the value of an int domain cell to 64 bits
+  OB_INLINE static uint64_t get_int_value(const common::ObObj& obj)
+  {
+    uint64_t value = 0;
+    switch (obj.get_type_class()) {
+      case common::ObFloatTC: {
+        uint32_t bits = 0;
+        MEMCPY(&bits, &obj.v_.float_, sizeof(bits));
+        value = bits;
+        break;
+      }
+      case common::ObDateTC: {
+        value = static_cast<uint64_t>(static_cast<int64_t>(obj.v_.date_));
+        break;
+      }
+      case common::ObYearTC: {
+        value = obj.v_.year_;
+        break;
+      }
+      default: {
+        value = obj.v_.uint64_;
+        break;
+      }
+    }
+    return value;
+  }
+
+  OB_INLINE static void set_int_value(const common::ObObjMeta& meta, const uint64_t value, common::ObObj& obj)
+  {
+    obj.set_meta_type(meta);
+    obj.val_len_ = 0;
+    obj.v_.uint64_ = 0;
+    switch (meta.get_type_class()) {
+      case common::ObFloatTC: {
+        const uint32_t bits = static_cast<uint32_t>(value);
+        MEMCPY(&obj.v_.float_, &bits, sizeof(bits));
+        break;
+      }
+      case common::ObDateTC: {
+        obj.v_.date_ = static_cast<int32_t>(value);
+        break;
+      }
+      case common::ObYearTC: {
+        obj.v_.year_ = static_cast<uint8_t>(value);
+        break;
+      }
+      default: {
+        obj.v_.uint64_ = value;
+        break;
+      }
+    }
+  }
+
+  OB_INLINE static int64_t get_bit_width(const uint64_t max_value)
+  {
+    return 0 == max_value ? 0 : 64 - __builtin_clzll(max_value);
+  }
+
+  OB_INLINE static int64_t get_packed_size(const int64_t count, const int64_t width)
+  {
+    return (count * width + 63) / 64 * static_cast<int64_t>(sizeof(uint64_t));
+  }
+
+  // @buf must be zeroed and have get_packed_size() bytes
+  OB_INLINE static void pack(char* buf, const int64_t idx, const int64_t width, const uint64_t value)
+  {
+    if (width > 0) {
+      const int64_t bit_pos = idx * width;
+      const int64_t shift = bit_pos & 63;
+      char* word_ptr = buf + (bit_pos >> 6) * sizeof(uint64_t);
+      uint64_t word = 0;
+      MEMCPY(&word, word_ptr, sizeof(word));
+      word |= value << shift;
+      MEMCPY(word_ptr, &word, sizeof(word));
+      if (shift + width > 64) {
+        MEMCPY(&word, word_ptr + sizeof(uint64_t), sizeof(word));
+        word |= value >> (64 - shift);
+        MEMCPY(word_ptr + sizeof(uint64_t), &word, sizeof(word));
+      }
+    }
+  }
+
+  OB_INLINE static uint64_t unpack(const char* buf, const int64_t idx, const int64_t width)
+  {
+    uint64_t value = 0;
+    if (width > 0) {
+      const int64_t bit_pos = idx * width;
+      const int64_t shift = bit_pos & 63;
+      const char* word_ptr = buf + (bit_pos >> 6) * sizeof(uint64_t);
+      uint64_t word = 0;
+      MEMCPY(&word, word_ptr, sizeof(word));
+      value = word >> shift;
+      if (shift + width > 64) {
+        MEMCPY(&word, word_ptr + sizeof(uint64_t), sizeof(word));
+        value |= word << (64 - shift);
+      }
+      if (width < 64) {
+        value &= (1ULL << width) - 1;
+      }
+    }
+    return value;
+  }
+
+  OB_INLINE static uint32_t read_uint32(const char* buf, const int64_t idx)
+  {
+    uint32_t value = 0;
+    MEMCPY(&value, buf + idx * sizeof(uint32_t), sizeof(value));
+    return value;
+  }
+
+  OB_INLINE static int64_t get_bitmap_size(const int64_t row_count)
+  {
+    return (row_count + 7) / 8;
+  }
+  OB_INLINE static bool bitmap_test(const char* bitmap, const int64_t idx)
+  {
+    return bitmap[idx >> 3] & (1 << (idx & 7));
+  }
+  OB_INLINE static void bitmap_set(char* bitmap, const int64_t idx)
+  {
+    bitmap[idx >> 3] = static_cast<char>(bitmap[idx >> 3] | (1 << (idx & 7)));
+  }
+};
+
+}  // end namespace blocksstable
+}  // end namespace oceanbase
+
+#endif  // OCEANBASE_STORAGE_BLOCKSSTABLE_OB_MICRO_BLOCK_ENCODING_H_
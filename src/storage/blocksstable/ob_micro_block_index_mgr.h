@@ -16,6 +16,7 @@
 #include "common/object/ob_object.h"
 #include "share/cache/ob_kv_storecache.h"
 #include "storage/blocksstable/ob_block_sstable_struct.h"
+#include "storage/blocksstable/ob_micro_block_skip_index.h"
 
 namespace oceanbase {
 namespace storage {
@@ -176,6 +177,11 @@ public:
       int64_t& logical_row_count, int64_t& physical_row_count, bool& need_check_micro_block) const;
   // calculate row count can be purged in this macro block
   int cal_macro_purged_row_count(int64_t& purged_row_count) const;
+  OB_INLINE bool has_skip_index() const
+  {
+    return NULL != skip_index_buf_;
+  }
+  int get_skip_index(ObMicroBlockSkipIndex& skip_index) const;
 
 private:
   void get_bound(Bound& bound) const;
@@ -204,12 +210,14 @@ private:
   char* extra_space_base_;  // reserved space for deep copy string and number
   bool* mark_deletion_array_;
   int32_t* delta_array_;
+  char* skip_index_buf_;
 
   int32_t micro_index_size_;
   int32_t node_array_size_;
   int32_t extra_space_size_;
   int32_t mark_deletion_flags_size_;
   int32_t delta_size_;
+  int32_t skip_index_size_;
 
   int32_t micro_count_;
   int32_t rowkey_column_count_;
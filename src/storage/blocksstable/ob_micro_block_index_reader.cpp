@@ -23,6 +23,8 @@ ObMicroBlockIndexReader::ObMicroBlockIndexReader()
       endkey_stream_(nullptr),
       mark_deletion_stream_(nullptr),
       delta_array_(nullptr),
+      skip_index_stream_(nullptr),
+      skip_index_size_(0),
       block_count_(0),
       row_key_column_cnt_(0),
       data_base_offset_(0),
@@ -39,6 +41,8 @@ void ObMicroBlockIndexReader::reset()
   micro_indexes_ = nullptr;
   endkey_stream_ = nullptr;
   mark_deletion_stream_ = nullptr;
+  skip_index_stream_ = nullptr;
+  skip_index_size_ = 0;
   block_count_ = 0;
   row_key_column_cnt_ = 0;
   data_base_offset_ = 0;
@@ -63,6 +67,7 @@ int ObMicroBlockIndexReader::init(const ObFullMacroBlockMeta& meta, const char*
         meta.meta_->get_endkey_size(),
         meta.meta_->get_micro_block_mark_deletion_size(),
         meta.meta_->get_micro_block_delta_size(),
+        meta.meta_->get_micro_block_skip_index_size(),
         meta.meta_->micro_block_data_offset_,
         (ObRowStoreType)meta.meta_->row_store_type_);
   }
@@ -89,6 +94,7 @@ int ObMicroBlockIndexReader::init(
         header.micro_block_endkey_size_,
         0, /*mark_deletion_buf_size*/
         0, /*delta_buf_size*/
+        0, /*skip_index_buf_size*/
         header.micro_block_data_offset_,
         (ObRowStoreType)(header.row_store_type_));
   }
@@ -99,7 +105,8 @@ int ObMicroBlockIndexReader::init(
 int ObMicroBlockIndexReader::init_row_reader(const ObRowStoreType row_store_type)
 {
   int ret = OB_SUCCESS;
-  if (FLAT_ROW_STORE == row_store_type) {
+  if (FLAT_ROW_STORE == row_store_type || ENCODING_ROW_STORE == row_store_type) {
+    // endkeys of encoding micro blocks are stored in flat format
     row_reader_ = &flat_row_reader_;
   } else if (SPARSE_ROW_STORE == row_store_type) {
     row_reader_ = &sparse_row_reader_;
@@ -113,7 +120,7 @@ int ObMicroBlockIndexReader::init_row_reader(const ObRowStoreType row_store_type
 int ObMicroBlockIndexReader::init(const char* index_buf, const common::ObObjMeta* column_type_array,
     const int32_t row_key_column_cnt, const int32_t micro_block_cnt, const int32_t index_buf_size,
     const int32_t endkey_buf_size, const int32_t mark_deletion_buf_size, const int32_t delta_buf_size,
-    const int32_t data_base_offset, const ObRowStoreType row_store_type)
+    const int32_t skip_index_buf_size, const int32_t data_base_offset, const ObRowStoreType row_store_type)
 {
   int ret = OB_SUCCESS;
   if (is_inited_) {
@@ -121,7 +128,7 @@ int ObMicroBlockIndexReader::init(const char* index_buf, const common::ObObjMeta
     STORAGE_LOG(WARN, "ObMicroBlockIndexReader is inited twice", K(ret));
   } else if (OB_ISNULL(index_buf) || OB_ISNULL(column_type_array) || row_key_column_cnt < 0 || micro_block_cnt < 0 ||
              index_buf_size < 0 || endkey_buf_size < 0 || mark_deletion_buf_size < 0 || delta_buf_size < 0 ||
-             data_base_offset < 0 || MAX_ROW_STORE == row_store_type) {
+             skip_index_buf_size < 0 || data_base_offset < 0 || MAX_ROW_STORE == row_store_type) {
     ret = OB_INVALID_ARGUMENT;
     STORAGE_LOG(WARN,
         "invalid argument",
@@ -134,6 +141,7 @@ int ObMicroBlockIndexReader::init(const char* index_buf, const common::ObObjMeta
         K(endkey_buf_size),
         K(mark_deletion_buf_size),
         K(delta_buf_size),
+        K(skip_index_buf_size),
         K(data_base_offset),
         K(row_store_type));
   } else if ((0 != delta_buf_size && delta_buf_size / sizeof(int32_t) != micro_block_cnt) ||
@@ -155,6 +163,11 @@ int ObMicroBlockIndexReader::init(const char* index_buf, const common::ObObjMeta
     delta_array_ = (0 == delta_buf_size) ? nullptr
                                          : reinterpret_cast<const int32_t*>(
                                                index_buf + index_buf_size + endkey_buf_size + mark_deletion_buf_size);
+    skip_index_stream_ =
+        (0 == skip_index_buf_size)
+            ? nullptr
+            : index_buf + index_buf_size + endkey_buf_size + mark_deletion_buf_size + delta_buf_size;
+    skip_index_size_ = skip_index_buf_size;
     block_count_ = micro_block_cnt;
     row_key_column_cnt_ = row_key_column_cnt;
     data_base_offset_ = data_base_offset;
@@ -211,6 +224,21 @@ int ObMicroBlockIndexReader::get_all_deltas(int32_t* delta_array)
   return ret;
 }
 
+int ObMicroBlockIndexReader::get_skip_index(char* skip_index_buf)
+{
+  int ret = OB_SUCCESS;
+
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    STORAGE_LOG(WARN, "MicroBlockIndexReader is not inited", K(ret));
+  } else if (OB_ISNULL(skip_index_stream_)) {
+    // block index without skip index
+  } else {
+    MEMCPY(skip_index_buf, skip_index_stream_, skip_index_size_);
+  }
+  return ret;
+}
+
 int ObMicroBlockIndexReader::get_end_key(const uint64_t index, ObObj* objs)
 {
   int ret = OB_SUCCESS;
@@ -151,12 +151,17 @@ public:
   {
     return nullptr == delta_array_ ? 0 : sizeof(int32_t) * block_count_;
   }
+  int get_skip_index(char* skip_index_buf);
+  inline int64_t get_skip_index_size() const
+  {
+    return skip_index_size_;
+  }
 
 private:
   int init(const char* index_buf, const common::ObObjMeta* column_type_array, const int32_t row_key_column_cnt,
       const int32_t micro_block_cnt, const int32_t index_buf_size, const int32_t endkey_buf_size,
-      const int32_t mark_deletion_buf_size, const int32_t delta_buf_size, const int32_t data_base_offset,
-      const common::ObRowStoreType row_store_type);
+      const int32_t mark_deletion_buf_size, const int32_t delta_buf_size, const int32_t skip_index_buf_size,
+      const int32_t data_base_offset, const common::ObRowStoreType row_store_type);
   class ObBlockIndexCompare {
   public:
     ObBlockIndexCompare(ObMicroBlockIndexReader& index_reader, common::ObObj* objs, const int64_t row_key_column_number)
@@ -211,6 +216,8 @@ private:
   const char* endkey_stream_;               // address of the endkey stream
   const char* mark_deletion_stream_;        // address of the mark deletion stream
   const int32_t* delta_array_;
+  const char* skip_index_stream_;  // address of the skip index, see ObMicroBlockSkipIndex
+  int32_t skip_index_size_;
   int32_t block_count_;  // the count of the micro blocks
   int32_t row_key_column_cnt_;
   int32_t data_base_offset_;
@@ -383,6 +383,7 @@ int ObMicroBlockIndexTransformer::create_block_index_mgr(
         "extra_space_size", node_array_.get_extra_space_size(),
         "mark_deletion_flag size", index_reader_.get_mark_deletion_flags_size(),
         "delta size", index_reader_.get_delta_size(),
+        "skip index size", index_reader_.get_skip_index_size(),
         K(rowkey_column_count_), K(data_offset_), K(meta));
   } else if (OB_FAIL(fill_block_index_mgr(buffer, size))) {
     STORAGE_LOG(WARN, "transformer fail to fill block index mgr.", K(ret));
@@ -494,6 +495,26 @@ int ObMicroBlockIndexTransformer::fill_block_index_mgr(char* buffer, int64_t siz
         }
       }
     }
+
+    // skip index
+    if (OB_SUCC(ret)) {
+      if (index_reader_.get_skip_index_size() > 0) {
+        if (pos + index_reader_.get_skip_index_size() > size) {
+          ret = OB_BUF_NOT_ENOUGH;
+          STORAGE_LOG(WARN,
+              "buffer is not enough for skip index",
+              K(ret),
+              K(pos),
+              K(size),
+              "skip index size",
+              index_reader_.get_skip_index_size());
+        } else if (OB_FAIL(index_reader_.get_skip_index(buffer + pos))) {
+          STORAGE_LOG(WARN, "failed to get skip index", K(ret));
+        } else {
+          pos += index_reader_.get_skip_index_size();
+        }
+      }
+    }
   }
   return ret;
 }
@@ -502,7 +523,8 @@ int64_t ObMicroBlockIndexTransformer::get_transformer_size() const
 {
   return sizeof(ObMicroBlockIndexMgr) + (block_count_ + 1) * sizeof(ObMicroBlockIndex) +
          node_array_.get_node_array_size() + node_array_.get_extra_space_size() +
-         index_reader_.get_mark_deletion_flags_size() + index_reader_.get_delta_size();
+         index_reader_.get_mark_deletion_flags_size() + index_reader_.get_delta_size() +
+         index_reader_.get_skip_index_size();
 }
 
 }  // end namespace blocksstable
@@ -18,13 +18,20 @@ namespace oceanbase {
 using namespace common;
 namespace blocksstable {
 ObMicroBlockIndexWriter::ObMicroBlockIndexWriter()
-    : ObCommonMicroBlockIndexWriter<4L>(), is_multi_version_minor_merge_(false)
+    : ObCommonMicroBlockIndexWriter<5L>(), is_multi_version_minor_merge_(false), skip_index_header_size_(0)
 {}
 
 void ObMicroBlockIndexWriter::reset()
 {
   BaseWriter::reset();
   is_multi_version_minor_merge_ = false;
+  skip_index_header_size_ = 0;
+}
+
+void ObMicroBlockIndexWriter::reuse()
+{
+  BaseWriter::reuse();
+  skip_index_header_size_ = 0;
 }
 
 int ObMicroBlockIndexWriter::init(int64_t max_buffer_size, bool is_multi_version_minor_merge)
@@ -74,6 +81,32 @@ int ObMicroBlockIndexWriter::add_entry(
   return ret;
 }
 
+int ObMicroBlockIndexWriter::add_skip_index_entry(
+    const char* header, const int64_t header_size, const char* entry, const int64_t entry_size)
+{
+  int ret = OB_SUCCESS;
+  ObSelfBufferWriter& skip_index_buffer = buffer_[SKIP_INDEX_BUFFER_IDX];
+  if (!is_inited_) {
+    ret = OB_NOT_INIT;
+    STORAGE_LOG(WARN, "The ObMicroBlockIndexWriter has not been inited.", K(ret));
+  } else if (OB_ISNULL(header) || OB_ISNULL(entry) || OB_UNLIKELY(header_size <= 0 || entry_size <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "invalid skip index entry", K(ret), KP(header), K(header_size), KP(entry), K(entry_size));
+  } else if (OB_UNLIKELY(has_skip_index() ? header_size != skip_index_header_size_ : 1 != micro_block_cnt_)) {
+    // every micro block of the macro block must have a skip index entry
+    ret = OB_ERR_UNEXPECTED;
+    STORAGE_LOG(WARN, "unexpected skip index entry", K(ret), K(header_size), K_(skip_index_header_size),
+        K_(micro_block_cnt));
+  } else if (!has_skip_index() && OB_FAIL(skip_index_buffer.write(header, header_size))) {
+    STORAGE_LOG(WARN, "fail to write skip index header", K(ret), K(header_size));
+  } else if (OB_FAIL(skip_index_buffer.write(entry, entry_size))) {
+    STORAGE_LOG(WARN, "fail to write skip index entry", K(ret), K(entry_size));
+  } else {
+    skip_index_header_size_ = header_size;
+  }
+  return ret;
+}
+
 int ObMicroBlockIndexWriter::get_last_rowkey(ObString& rowkey)
 {
   int ret = OB_SUCCESS;
@@ -138,10 +171,19 @@ int ObMicroBlockIndexWriter::merge(const int64_t data_end_offset, const ObMicroB
   const ObSelfBufferWriter& other_endkey_buffer = writer.buffer_[ENDKEY_BUFFER_IDX];
   const ObSelfBufferWriter& other_mark_buffer = writer.buffer_[MARK_DELETE_BUFFER_IDX];
   const ObSelfBufferWriter& other_delta_buffer = writer.buffer_[DELTA_BUFFER_IDX];
+  const ObSelfBufferWriter& other_skip_index_buffer = writer.buffer_[SKIP_INDEX_BUFFER_IDX];
 
   if (!is_inited_) {
     ret = OB_NOT_INIT;
     STORAGE_LOG(WARN, "The ObMicroBlockIndexWriter has not been inited.", K(ret));
+  } else if (OB_UNLIKELY(has_skip_index() != writer.has_skip_index() ||
+                         skip_index_header_size_ != writer.skip_index_header_size_)) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN,
+        "can not merge micro block index with different skip index",
+        K(ret),
+        K_(skip_index_header_size),
+        K(writer.skip_index_header_size_));
   } else if (0 == other_endkey_buffer.length()) {
     ret = OB_INVALID_ARGUMENT;
     STORAGE_LOG(ERROR, "writer.endkey_buffer_.length must not 0", K(ret));
@@ -170,6 +212,10 @@ int ObMicroBlockIndexWriter::merge(const int64_t data_end_offset, const ObMicroB
           K(other_mark_buffer.length()));
     } else if (OB_FAIL(buffer_[DELTA_BUFFER_IDX].write(other_delta_buffer.data(), other_delta_buffer.length()))) {
       STORAGE_LOG(WARN, "failed to write delta buffer", K(ret), K(other_delta_buffer.length()));
+    } else if (writer.has_skip_index() &&
+               OB_FAIL(buffer_[SKIP_INDEX_BUFFER_IDX].write(other_skip_index_buffer.data() + skip_index_header_size_,
+                   other_skip_index_buffer.length() - skip_index_header_size_))) {
+      STORAGE_LOG(WARN, "failed to write skip index buffer", K(ret), K(other_skip_index_buffer.length()));
     }
   }
   return ret;
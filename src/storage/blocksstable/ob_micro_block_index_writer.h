@@ -127,7 +127,7 @@ int ObCommonMicroBlockIndexWriter<BUFFER_COUNT>::write(const int64_t buffer_idx,
   return ret;
 }
 
-class ObMicroBlockIndexWriter : public ObCommonMicroBlockIndexWriter<4L> {
+class ObMicroBlockIndexWriter : public ObCommonMicroBlockIndexWriter<5L> {
 public:
   static const int64_t INDEX_ENTRY_SIZE = sizeof(int32_t) * 2;
   static const int64_t MARK_DELETION_ENRTRY_SIZE = sizeof(uint8_t);
@@ -141,8 +141,12 @@ public:
   {}
 
   void reset();
+  void reuse();
   int init(const int64_t max_buffer_size, bool is_multi_version_minor_merge);
   int add_entry(const common::ObString& rowkey, const int64_t data_offset, bool can_mark_deletion, const int32_t delta);
+  // the skip index header is written before the entry of the first micro block
+  int add_skip_index_entry(
+      const char* header, const int64_t header_size, const char* entry, const int64_t entry_size);
   int get_last_rowkey(common::ObString& rowkey);
   int add_last_entry(const int64_t data_offset);
   int merge(const int64_t data_end_offset, const ObMicroBlockIndexWriter& writer);
@@ -167,25 +171,39 @@ public:
   {
     return buffer_[DELTA_BUFFER_IDX];
   }
+  inline const ObSelfBufferWriter& get_skip_index() const
+  {
+    return buffer_[SKIP_INDEX_BUFFER_IDX];
+  }
+  inline bool has_skip_index() const
+  {
+    return skip_index_header_size_ > 0;
+  }
+  inline int64_t get_skip_index_header_size() const
+  {
+    return skip_index_header_size_;
+  }
   inline int64_t get_block_size() const;
   static int64_t get_entry_size(bool is_multi_version_minor_merge);
 
 protected:
   bool is_multi_version_minor_merge_;
+  int64_t skip_index_header_size_;
 
 private:
   DISALLOW_COPY_AND_ASSIGN(ObMicroBlockIndexWriter);
-  typedef ObCommonMicroBlockIndexWriter<4L> BaseWriter;
+  typedef ObCommonMicroBlockIndexWriter<5L> BaseWriter;
   static const int64_t ENDKEY_BUFFER_IDX = 0;
   static const int64_t INDEX_BUFFER_IDX = 1;
   static const int64_t MARK_DELETE_BUFFER_IDX = 2;
   static const int64_t DELTA_BUFFER_IDX = 3;
+  static const int64_t SKIP_INDEX_BUFFER_IDX = 4;
 };
 
 inline int64_t ObMicroBlockIndexWriter::get_block_size() const
 {
   return get_data().length() + get_index().length() + get_mark_deletion().length() + get_delta().length() +
-         INDEX_ENTRY_SIZE;
+         get_skip_index().length() + INDEX_ENTRY_SIZE;
 }
 inline int64_t ObMicroBlockIndexWriter::get_entry_size(bool is_multi_version_minor_merge)
 {
@@ -30,6 +30,7 @@ ObIMicroBlockRowFetcher::ObIMicroBlockRowFetcher()
       flat_reader_(NULL),
       multi_version_reader_(NULL),
       sparse_reader_(NULL),
+      encoding_reader_(NULL),
       is_multi_version_(false),
       is_inited_(false)
 {}
@@ -48,6 +49,10 @@ ObIMicroBlockRowFetcher::~ObIMicroBlockRowFetcher()
     sparse_reader_->~ObSparseMicroBlockGetReader();
     sparse_reader_ = NULL;
   }
+  if (NULL != encoding_reader_) {
+    encoding_reader_->~ObMicroBlockEncodingGetReader();
+    encoding_reader_ = NULL;
+  }
 }
 
 int ObIMicroBlockRowFetcher::init(
@@ -65,6 +70,7 @@ int ObIMicroBlockRowFetcher::init(
     flat_reader_ = NULL;
     multi_version_reader_ = NULL;
     sparse_reader_ = NULL;
+    encoding_reader_ = NULL;
     is_multi_version_ = sstable->is_multi_version_minor_sstable();
     is_inited_ = true;
   }
@@ -93,6 +99,11 @@ int ObIMicroBlockRowFetcher::prepare_reader(const ObFullMacroBlockMeta& macro_me
       sparse_reader_ = OB_NEWx(ObSparseMicroBlockGetReader, context_->allocator_);
     }
     reader_ = sparse_reader_;
+  } else if (ENCODING_ROW_STORE == store_type) {  // column-wise encoding, major sstable only
+    if (NULL == encoding_reader_) {
+      encoding_reader_ = OB_NEWx(ObMicroBlockEncodingGetReader, context_->allocator_);
+    }
+    reader_ = encoding_reader_;
   } else {
     ret = OB_NOT_SUPPORTED;
     LOG_WARN("not supported row store type", K(ret), K(store_type));
@@ -155,7 +166,7 @@ int ObMicroBlockRowGetter::init(const ObTableIterParam& param, ObTableAccessCont
 
 int ObMicroBlockRowGetter::get_row(const ObStoreRowkey& rowkey, const MacroBlockId macro_id, const int64_t file_id,
     const ObFullMacroBlockMeta& macro_meta, const ObMicroBlockData& block_data,
-    const storage::ObSSTableRowkeyHelper* rowkey_helper, const storage::ObStoreRow*& row)
+    const storage::ObSSTableRowkeyHelper* rowkey_helper, const storage::ObStoreRow*& row, const bool is_same_block)
 {
   int ret = OB_SUCCESS;
   if (OB_UNLIKELY(!is_inited_)) {
@@ -170,6 +181,7 @@ int ObMicroBlockRowGetter::get_row(const ObStoreRowkey& rowkey, const MacroBlock
     row_.row_val_.cells_ = reinterpret_cast<ObObj*>(obj_buf_);
     row_.row_val_.count_ = OB_ROW_MAX_COLUMNS_COUNT;
     row_.capacity_ = OB_ROW_MAX_COLUMNS_COUNT;
+    reader_->set_same_block(is_same_block);
     if (!context_->enable_put_row_cache()) {
       if (OB_FAIL(reader_->get_row(
               context_->pkey_.get_tenant_id(), block_data, rowkey, column_map_, macro_meta, rowkey_helper, row_))) {
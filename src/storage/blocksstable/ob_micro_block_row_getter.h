@@ -17,6 +17,7 @@
 #include "storage/blocksstable/ob_micro_block_row_scanner.h"
 #include "storage/blocksstable/ob_imicro_block_reader.h"
 #include "storage/blocksstable/ob_sparse_micro_block_reader.h"
+#include "storage/blocksstable/ob_micro_block_decoder.h"
 
 namespace oceanbase {
 namespace blocksstable {
@@ -36,6 +37,7 @@ protected:
   ObMicroBlockGetReader* flat_reader_;
   ObMultiVersionBlockGetReader* multi_version_reader_;
   ObSparseMicroBlockGetReader* sparse_reader_;
+  ObMicroBlockEncodingGetReader* encoding_reader_;
   bool is_multi_version_;
   bool is_inited_;
 };
@@ -46,9 +48,11 @@ public:
   virtual ~ObMicroBlockRowGetter();
   virtual int init(const storage::ObTableIterParam& param, storage::ObTableAccessContext& context,
       const storage::ObSSTable* sstable);
+  // %is_same_block: %block_data is the micro block of the last call, in the same buffer
   int get_row(const common::ObStoreRowkey& rowkey, const MacroBlockId macro_id, const int64_t file_id,
       const ObFullMacroBlockMeta& macro_meta, const ObMicroBlockData& block_data,
-      const storage::ObSSTableRowkeyHelper* rowkey_helper, const storage::ObStoreRow*& row);
+      const storage::ObSSTableRowkeyHelper* rowkey_helper, const storage::ObStoreRow*& row,
+      const bool is_same_block = false);
   int get_cached_row(const common::ObStoreRowkey& rowkey, const ObFullMacroBlockMeta& macro_meta,
       const ObRowCacheValue& value, const storage::ObStoreRow*& row);
   int get_not_exist_row(const common::ObStoreRowkey& rowkey, const storage::ObStoreRow*& row);
@@ -17,6 +17,7 @@
 #include "storage/blocksstable/ob_micro_block_reader.h"
 #include "storage/transaction/ob_trans_service.h"
 #include "storage/transaction/ob_trans_part_ctx.h"
+#include "sql/engine/basic/ob_pushdown_filter.h"
 
 using namespace oceanbase;
 using namespace common;
@@ -178,6 +179,10 @@ int ObIMicroBlockRowScanner::set_reader(const ObRowStoreType store_type)
       reader_ = &sparse_reader_;
       break;
     }
+    case ENCODING_ROW_STORE: {
+      reader_ = &encoding_reader_;
+      break;
+    }
     default:
       ret = OB_NOT_SUPPORTED;
       STORAGE_LOG(WARN, "not supported row store type", K(ret), K(store_type));
@@ -461,7 +466,120 @@ int ObMicroBlockRowScanner::init(const ObTableIterParam& param, ObTableAccessCon
       row.row_val_.count_ = OB_ROW_MAX_COLUMNS_COUNT;
       row.capacity_ = OB_ROW_MAX_COLUMNS_COUNT;
     }
-    is_inited_ = true;
+    pd_filter_ = nullptr;
+    filter_bitmap_ = nullptr;
+    bool can_pushdown = nullptr != param_->pd_storage_filters_ && nullptr != sstable_ &&
+                        sstable_->is_major_sstable() && !context_->query_flag_.is_multi_version_minor_merge();
+    if (can_pushdown && OB_FAIL(init_pushdown_filter(*param_->pd_storage_filters_, column_id_map, can_pushdown))) {
+      STORAGE_LOG(WARN, "fail to init pushdown filter", K(ret));
+    } else if (can_pushdown) {
+      pd_filter_ = param_->pd_storage_filters_;
+    }
+    if (OB_SUCC(ret)) {
+      is_inited_ = true;
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockRowScanner::init_pushdown_filter(
+    sql::ObPushdownFilterExecutor& filter, const share::schema::ColumnMap* column_id_map, bool& can_pushdown)
+{
+  int ret = OB_SUCCESS;
+  if (filter.is_filter_white_node()) {
+    ObIArray<uint64_t>& col_ids = filter.get_col_ids();
+    int32_t col_idx = -1;
+    if (OB_ISNULL(column_id_map) || OB_ISNULL(param_->out_cols_param_)) {
+      can_pushdown = false;
+    }
+    for (int64_t i = 0; can_pushdown && i < col_ids.count(); ++i) {
+      if (OB_SUCCESS != column_id_map->get(col_ids.at(i), col_idx)) {
+        // filter column is not projected, leave it to the op filters
+        can_pushdown = false;
+      }
+    }
+    if (can_pushdown && OB_FAIL(filter.init_filter_param(column_id_map, param_->out_cols_param_, false))) {
+      STORAGE_LOG(WARN, "fail to init filter param", K(ret));
+    }
+  } else if (filter.is_logic_op_node()) {
+    sql::ObPushdownFilterExecutor** childs = filter.get_childs();
+    for (uint32_t i = 0; OB_SUCC(ret) && can_pushdown && i < filter.get_child_count(); ++i) {
+      if (OB_ISNULL(childs[i])) {
+        ret = OB_ERR_UNEXPECTED;
+        STORAGE_LOG(WARN, "unexpected null child filter", K(ret), K(i));
+      } else if (OB_FAIL(init_pushdown_filter(*childs[i], column_id_map, can_pushdown))) {
+        STORAGE_LOG(WARN, "fail to init child filter", K(ret), K(i));
+      }
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockRowScanner::filter_pushdown_filter(
+    sql::ObPushdownFilterExecutor& filter, const int64_t begin_index, const int64_t row_count, ObBitmap*& bitmap)
+{
+  int ret = OB_SUCCESS;
+  bitmap = nullptr;
+  if (OB_FAIL(filter.init_bitmap(row_count, bitmap))) {
+    STORAGE_LOG(WARN, "fail to init filter bitmap", K(ret), K(row_count));
+  } else if (filter.is_filter_white_node()) {
+    if (OB_FAIL(reader_->filter_pushdown_filter(static_cast<const sql::ObWhiteFilterExecutor&>(filter),
+            filter.get_col_offsets()[0],
+            begin_index,
+            row_count,
+            *bitmap))) {
+      if (OB_UNLIKELY(OB_NOT_SUPPORTED != ret)) {
+        STORAGE_LOG(WARN, "fail to filter micro block", K(ret), K(begin_index), K(row_count));
+      }
+    }
+  } else if (filter.is_logic_op_node()) {
+    sql::ObPushdownFilterExecutor** childs = filter.get_childs();
+    ObBitmap* child_bitmap = nullptr;
+    for (uint32_t i = 0; OB_SUCC(ret) && i < filter.get_child_count(); ++i) {
+      if (OB_FAIL(filter_pushdown_filter(*childs[i], begin_index, row_count, child_bitmap))) {
+        if (OB_UNLIKELY(OB_NOT_SUPPORTED != ret)) {
+          STORAGE_LOG(WARN, "fail to filter child", K(ret), K(i));
+        }
+      } else if (filter.is_logic_and_node()) {
+        if (OB_FAIL(bitmap->bit_and(*child_bitmap))) {
+          STORAGE_LOG(WARN, "fail to merge child bitmap", K(ret), K(i));
+        } else if (bitmap->is_all_false()) {
+          break;
+        }
+      } else if (OB_FAIL(bitmap->bit_or(*child_bitmap))) {
+        STORAGE_LOG(WARN, "fail to merge child bitmap", K(ret), K(i));
+      }
+    }
+  } else {
+    // black filters are evaluated by the op filters on output rows
+    bitmap->reuse(true);
+  }
+  return ret;
+}
+
+int ObMicroBlockRowScanner::apply_pushdown_filter()
+{
+  int ret = OB_SUCCESS;
+  ObBitmap* bitmap = nullptr;
+  filter_bitmap_ = nullptr;
+  if (nullptr != pd_filter_ && context_->enable_pd_filter_ && ObIMicroBlockReader::INVALID_ROW_INDEX != current_) {
+    filter_begin_ = MIN(start_, last_);
+    const int64_t row_count = MAX(start_, last_) - filter_begin_ + 1;
+    if (OB_FAIL(filter_pushdown_filter(*pd_filter_, filter_begin_, row_count, bitmap))) {
+      if (OB_NOT_SUPPORTED == ret) {
+        // block format can not evaluate filters, fall back to scan every row
+        ret = OB_SUCCESS;
+      } else {
+        STORAGE_LOG(WARN, "fail to filter micro block", K(ret), K_(start), K_(last), K_(macro_id));
+      }
+    } else if (bitmap->is_all_false()) {
+      // no row in range can pass the filters, skip the whole block
+      current_ = ObIMicroBlockReader::INVALID_ROW_INDEX;
+      start_ = ObIMicroBlockReader::INVALID_ROW_INDEX;
+      last_ = ObIMicroBlockReader::INVALID_ROW_INDEX;
+    } else {
+      filter_bitmap_ = bitmap;
+    }
   }
   return ret;
 }
@@ -476,6 +594,8 @@ int ObMicroBlockRowScanner::open(const MacroBlockId& macro_id, const ObFullMacro
     STORAGE_LOG(WARN, "failed to init micro block reader", K(ret), K(macro_id));
   } else if (OB_FAIL(set_base_scan_param(is_left_border, is_right_border))) {
     STORAGE_LOG(WARN, "failed to set base scan param", K(ret), K(is_left_border), K(is_right_border), K(macro_id));
+  } else if (OB_FAIL(apply_pushdown_filter())) {
+    STORAGE_LOG(WARN, "failed to apply pushdown filter", K(ret), K(macro_id));
   }
   return ret;
 }
@@ -494,7 +614,10 @@ int ObMicroBlockRowScanner::inner_get_next_row(const ObStoreRow*& row)
 {
   int ret = OB_SUCCESS;
   row = NULL;
-  if (OB_FAIL(end_of_block())) {
+  while (OB_SUCC(end_of_block()) && is_row_filtered()) {
+    current_ += step_;
+  }
+  if (OB_FAIL(ret)) {
     if (OB_UNLIKELY(OB_ITER_END != ret)) {
       STORAGE_LOG(WARN, "fail to judge end of block or not, ", K(ret));
     }
@@ -524,6 +647,15 @@ int ObMicroBlockRowScanner::inner_get_next_rows(const storage::ObStoreRow*& rows
       if (OB_UNLIKELY(OB_ITER_END != ret)) {
         STORAGE_LOG(WARN, "fail to judge end of block or not, ", K(ret));
       }
+    } else if (nullptr != filter_bitmap_) {
+      // cursor is moved inside, only rows that may pass the filters are materialized
+      if (OB_FAIL(get_filtered_rows(count))) {
+        if (OB_UNLIKELY(OB_ITER_END != ret)) {
+          STORAGE_LOG(WARN, "fail to get filtered rows", K(ret), K(current_), K(start_), K(last_), K(macro_id_));
+        }
+      } else {
+        rows = rows_;
+      }
     } else if (OB_FAIL(reader_->get_rows(
                    current_, last_ + step_, ObIMicroBlockReader::OB_MAX_BATCH_ROW_COUNT, rows_, count))) {
       STORAGE_LOG(WARN, "fail to get rows", K(ret), K(current_), K(start_), K(last_), K(macro_id_), K(*sstable_));
@@ -547,7 +679,34 @@ int ObMicroBlockRowScanner::inner_get_next_rows(const storage::ObStoreRow*& rows
     if (context_->query_flag_.is_multi_version_minor_merge()) {
       compat_old_dump_sstable_row(const_cast<ObStoreRow*>(rows), count);
     }
-    current_ += step_ * count;
+    if (nullptr == filter_bitmap_) {
+      current_ += step_ * count;
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockRowScanner::get_filtered_rows(int64_t& count)
+{
+  int ret = OB_SUCCESS;
+  count = 0;
+  while (OB_SUCC(ret) && count < ObIMicroBlockReader::OB_MAX_BATCH_ROW_COUNT) {
+    if (OB_FAIL(end_of_block())) {
+    } else if (is_row_filtered()) {
+      current_ += step_;
+    } else {
+      ObStoreRow& dest_row = rows_[count];
+      dest_row.row_val_.count_ = OB_ROW_MAX_COLUMNS_COUNT;
+      if (OB_FAIL(reader_->get_row(current_, dest_row))) {
+        STORAGE_LOG(WARN, "micro block reader fail to get row.", K(ret), K(current_), K(macro_id_));
+      } else {
+        ++count;
+        current_ += step_;
+      }
+    }
+  }
+  if (OB_ITER_END == ret && count > 0) {
+    ret = OB_SUCCESS;
   }
   return ret;
 }
@@ -555,6 +714,9 @@ int ObMicroBlockRowScanner::inner_get_next_rows(const storage::ObStoreRow*& rows
 void ObMicroBlockRowScanner::reset()
 {
   ObIMicroBlockRowScanner::reset();
+  pd_filter_ = nullptr;
+  filter_bitmap_ = nullptr;
+  filter_begin_ = 0;
 }
 
 int ObMultiVersionMicroBlockRowScanner::init(
@@ -14,6 +14,7 @@
 #define OB_MICRO_BLOCK_ROW_SCANNER_H_
 
 #include "lib/container/ob_raw_se_array.h"
+#include "lib/container/ob_bitmap.h"
 #include "ob_row_queue.h"
 #include "storage/ob_sstable.h"
 #include "storage/ob_row_fuse.h"
@@ -21,6 +22,7 @@
 #include "storage/blocksstable/ob_macro_block_reader.h"
 #include "storage/blocksstable/ob_imicro_block_reader.h"
 #include "storage/blocksstable/ob_sparse_micro_block_reader.h"
+#include "storage/blocksstable/ob_micro_block_decoder.h"
 #include "storage/blocksstable/ob_lob_data_reader.h"
 #include "storage/transaction/ob_trans_define.h"
 
@@ -29,6 +31,9 @@ namespace storage {
 class ObTableIterParam;
 class ObTableAccessContext;
 }  // namespace storage
+namespace sql {
+class ObPushdownFilterExecutor;
+}  // namespace sql
 namespace blocksstable {
 
 class ObColumnMap;
@@ -100,6 +105,7 @@ protected:
   ObIMicroBlockReader* reader_;
   ObMicroBlockReader flat_reader_;
   ObSparseMicroBlockReader sparse_reader_;
+  ObMicroBlockDecoder encoding_reader_;
   int64_t current_;  // current cursor
   int64_t start_;    // start of scan, inclusive.
   int64_t last_;     // end of scan, inclusive.
@@ -116,7 +122,7 @@ protected:
 // major sstable micro block scanner for query and merge
 class ObMicroBlockRowScanner : public ObIMicroBlockRowScanner {
 public:
-  ObMicroBlockRowScanner()
+  ObMicroBlockRowScanner() : pd_filter_(nullptr), filter_bitmap_(nullptr), filter_begin_(0)
   {}
   virtual ~ObMicroBlockRowScanner()
   {}
@@ -130,7 +136,24 @@ protected:
   virtual int inner_get_next_row(const storage::ObStoreRow*& row) override;
   virtual int inner_get_next_rows(const storage::ObStoreRow*& rows, int64_t& count) override;
 
+private:
+  int init_pushdown_filter(sql::ObPushdownFilterExecutor& filter, const share::schema::ColumnMap* column_id_map,
+      bool& can_pushdown);
+  int filter_pushdown_filter(sql::ObPushdownFilterExecutor& filter, const int64_t begin_index, const int64_t row_count,
+      common::ObBitmap*& bitmap);
+  int apply_pushdown_filter();
+  int get_filtered_rows(int64_t& count);
+  OB_INLINE bool is_row_filtered() const
+  {
+    return nullptr != filter_bitmap_ && !filter_bitmap_->test(current_ - filter_begin_);
+  }
+
 protected:
+  // white filters evaluated on the micro block before rows are materialized
+  sql::ObPushdownFilterExecutor* pd_filter_;
+  // bit i is set if row (filter_begin_ + i) of the opened block may pass the filters
+  const common::ObBitmap* filter_bitmap_;
+  int64_t filter_begin_;
   storage::ObStoreRow rows_[ObIMicroBlockReader::OB_MAX_BATCH_ROW_COUNT];
   char obj_buf_[common::OB_ROW_MAX_COLUMNS_COUNT * sizeof(ObObj) * ObIMicroBlockReader::OB_MAX_BATCH_ROW_COUNT];
 };
@@ -85,6 +85,10 @@ int ObMicroBlockScanner::set_reader(const ObRowStoreType store_type)
       reader_ = &sparse_reader_;
       break;
     }
+    case ENCODING_ROW_STORE: {
+      reader_ = &encoding_reader_;
+      break;
+    }
     default:
       ret = OB_NOT_SUPPORTED;
       LOG_WARN("not supported row store type", K(ret), K(store_type));
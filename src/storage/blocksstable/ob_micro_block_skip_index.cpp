@@ -0,0 +1,421 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX STORAGE
+
+#include "ob_micro_block_skip_index.h"
+#include "sql/engine/basic/ob_pushdown_filter.h"
+
+namespace oceanbase {
+using namespace common;
+using namespace sql;
+namespace blocksstable {
+
+static OB_INLINE void make_obj(const ObObjMeta& meta, const int64_t raw_value, ObObj& obj)
+{
+  obj.reset();
+  obj.meta_ = meta;
+  obj.v_.int64_ = raw_value;
+}
+
+void ObSkipIndexColumnStat::reset()
+{
+  row_count_ = 0;
+  null_count_ = 0;
+  has_min_max_ = false;
+  min_.reset();
+  max_.reset();
+}
+
+ObSkipIndexAggregator::ObSkipIndexAggregator() : is_inited_(false), column_count_(0), row_count_(0)
+{
+  MEMSET(column_idxs_, 0, sizeof(column_idxs_));
+  MEMSET(&header_, 0, sizeof(header_));
+  MEMSET(&entry_, 0, sizeof(entry_));
+}
+
+bool ObSkipIndexAggregator::is_column_supported(const uint64_t column_id, const ObObjMeta& column_type)
+{
+  bool bret = false;
+  if (column_id >= OB_APP_MIN_COLUMN_ID) {
+    switch (column_type.get_type_class()) {
+      case ObIntTC:
+      case ObUIntTC:
+      case ObFloatTC:
+      case ObDoubleTC:
+      case ObDateTimeTC:
+      case ObDateTC:
+      case ObTimeTC:
+      case ObYearTC:
+        bret = true;
+        break;
+      default:
+        break;
+    }
+  }
+  return bret;
+}
+
+int ObSkipIndexAggregator::init(const uint64_t* column_ids, const ObObjMeta* column_types, const int64_t column_count)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(is_inited_)) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("skip index aggregator init twice", K(ret));
+  } else if (OB_ISNULL(column_ids) || OB_ISNULL(column_types) || OB_UNLIKELY(column_count <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(column_ids), KP(column_types), K(column_count));
+  } else {
+    MEMSET(&header_, 0, sizeof(header_));
+    header_.header_.version_ = ObSkipIndexHeader::SKIP_INDEX_VERSION;
+    column_count_ = 0;
+    for (int64_t i = 0; i < column_count && column_count_ < MAX_COLUMN_COUNT; ++i) {
+      if (is_column_supported(column_ids[i], column_types[i])) {
+        header_.columns_[column_count_].column_id_ = column_ids[i];
+        header_.columns_[column_count_].meta_ = column_types[i];
+        column_idxs_[column_count_] = i;
+        ++column_count_;
+      }
+    }
+    header_.header_.column_count_ = static_cast<int16_t>(column_count_);
+    reuse();
+    is_inited_ = true;
+  }
+  return ret;
+}
+
+void ObSkipIndexAggregator::reset()
+{
+  is_inited_ = false;
+  column_count_ = 0;
+  row_count_ = 0;
+  MEMSET(&header_, 0, sizeof(header_));
+  MEMSET(&entry_, 0, sizeof(entry_));
+}
+
+void ObSkipIndexAggregator::reuse()
+{
+  row_count_ = 0;
+  entry_.header_.row_count_ = 0;
+  entry_.header_.flag_ = 0;
+  for (int64_t i = 0; i < column_count_; ++i) {
+    entry_.aggrs_[i].reset();
+  }
+}
+
+int ObSkipIndexAggregator::update(const ObNewRow& row)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("skip index aggregator not init", K(ret));
+  } else {
+    int cmp = 0;
+    ObObj bound;
+    for (int64_t i = 0; OB_SUCC(ret) && i < column_count_; ++i) {
+      ObSkipIndexColumnAggr& aggr = entry_.aggrs_[i];
+      const ObObjMeta& column_meta = header_.columns_[i].meta_;
+      if (!aggr.is_valid()) {
+      } else if (column_idxs_[i] >= row.count_) {
+        aggr.flag_ = ObSkipIndexColumnAggr::INVALID;
+      } else {
+        const ObObj& cell = row.cells_[column_idxs_[i]];
+        if (cell.is_null()) {
+          ++aggr.null_count_;
+        } else if (cell.is_ext() || cell.get_type_class() != column_meta.get_type_class()) {
+          aggr.flag_ = ObSkipIndexColumnAggr::INVALID;
+        } else if (!aggr.has_min_max()) {
+          aggr.min_ = cell.v_.int64_;
+          aggr.max_ = cell.v_.int64_;
+          aggr.flag_ |= ObSkipIndexColumnAggr::HAS_MIN_MAX;
+        } else {
+          make_obj(cell.meta_, aggr.min_, bound);
+          if (OB_FAIL(cell.compare(bound, cmp))) {
+            LOG_WARN("failed to compare with min value", K(ret), K(cell), K(bound));
+          } else if (cmp < 0) {
+            aggr.min_ = cell.v_.int64_;
+          } else {
+            make_obj(cell.meta_, aggr.max_, bound);
+            if (OB_FAIL(cell.compare(bound, cmp))) {
+              LOG_WARN("failed to compare with max value", K(ret), K(cell), K(bound));
+            } else if (cmp > 0) {
+              aggr.max_ = cell.v_.int64_;
+            }
+          }
+        }
+      }
+    }
+    if (OB_SUCC(ret)) {
+      ++row_count_;
+    }
+  }
+  return ret;
+}
+
+int ObSkipIndexAggregator::get_entry(const int64_t micro_row_count, const char*& buf, int64_t& buf_len)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("skip index aggregator not init", K(ret));
+  } else {
+    entry_.header_.row_count_ = static_cast<int32_t>(micro_row_count);
+    entry_.header_.flag_ =
+        (micro_row_count > 0 && micro_row_count == row_count_) ? ObSkipIndexMicroHeader::AGGR_VALID : 0;
+    buf = reinterpret_cast<const char*>(&entry_);
+    buf_len = get_entry_size();
+  }
+  return ret;
+}
+
+ObMicroBlockSkipIndex::ObMicroBlockSkipIndex()
+    : columns_(NULL), entries_(NULL), column_count_(0), micro_block_count_(0), entry_size_(0)
+{}
+
+void ObMicroBlockSkipIndex::reset()
+{
+  columns_ = NULL;
+  entries_ = NULL;
+  column_count_ = 0;
+  micro_block_count_ = 0;
+  entry_size_ = 0;
+}
+
+int ObMicroBlockSkipIndex::init(const char* buf, const int64_t buf_len, const int64_t micro_block_count)
+{
+  int ret = OB_SUCCESS;
+  ObSkipIndexHeader header;
+  reset();
+  if (OB_ISNULL(buf) || OB_UNLIKELY(buf_len < static_cast<int64_t>(sizeof(header)) || micro_block_count <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(buf), K(buf_len), K(micro_block_count));
+  } else {
+    MEMCPY(&header, buf, sizeof(header));
+    const int64_t header_size = sizeof(header) + header.column_count_ * sizeof(ObSkipIndexColumnMeta);
+    const int64_t entry_size = sizeof(ObSkipIndexMicroHeader) + header.column_count_ * sizeof(ObSkipIndexColumnAggr);
+    if (OB_UNLIKELY(ObSkipIndexHeader::SKIP_INDEX_VERSION != header.version_ || header.column_count_ < 0 ||
+                    header_size + entry_size * micro_block_count != buf_len)) {
+      ret = OB_INVALID_DATA;
+      LOG_WARN("invalid skip index", K(ret), K(header), K(buf_len), K(micro_block_count));
+    } else {
+      columns_ = buf + sizeof(header);
+      entries_ = buf + header_size;
+      column_count_ = header.column_count_;
+      micro_block_count_ = micro_block_count;
+      entry_size_ = entry_size;
+    }
+  }
+  return ret;
+}
+
+int64_t ObMicroBlockSkipIndex::find_column(const uint64_t column_id) const
+{
+  int64_t col_idx = -1;
+  ObSkipIndexColumnMeta column_meta;
+  for (int64_t i = 0; i < column_count_ && col_idx < 0; ++i) {
+    MEMCPY(&column_meta, columns_ + i * sizeof(ObSkipIndexColumnMeta), sizeof(column_meta));
+    if (column_id == column_meta.column_id_) {
+      col_idx = i;
+    }
+  }
+  return col_idx;
+}
+
+int ObMicroBlockSkipIndex::fill_column_stat(
+    const int64_t micro_block_idx, const int64_t col_idx, ObSkipIndexColumnStat& stat) const
+{
+  int ret = OB_SUCCESS;
+  ObSkipIndexMicroHeader micro_header;
+  ObSkipIndexColumnAggr aggr;
+  ObSkipIndexColumnMeta column_meta;
+  const char* entry = entries_ + micro_block_idx * entry_size_;
+  stat.reset();
+  MEMCPY(&micro_header, entry, sizeof(micro_header));
+  MEMCPY(&aggr, entry + sizeof(micro_header) + col_idx * sizeof(aggr), sizeof(aggr));
+  if (!micro_header.is_valid() || !aggr.is_valid()) {
+    ret = OB_ENTRY_NOT_EXIST;
+  } else {
+    MEMCPY(&column_meta, columns_ + col_idx * sizeof(column_meta), sizeof(column_meta));
+    stat.row_count_ = micro_header.row_count_;
+    stat.null_count_ = aggr.null_count_;
+    stat.has_min_max_ = aggr.has_min_max();
+    if (stat.has_min_max_) {
+      make_obj(column_meta.meta_, aggr.min_, stat.min_);
+      make_obj(column_meta.meta_, aggr.max_, stat.max_);
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockSkipIndex::get_column_stat(
+    const int64_t micro_block_idx, const uint64_t column_id, ObSkipIndexColumnStat& stat, bool& found) const
+{
+  int ret = OB_SUCCESS;
+  int64_t col_idx = -1;
+  found = false;
+  if (OB_UNLIKELY(!is_valid())) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("skip index not init", K(ret));
+  } else if (OB_UNLIKELY(micro_block_idx < 0 || micro_block_idx >= micro_block_count_)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid micro block idx", K(ret), K(micro_block_idx), K_(micro_block_count));
+  } else if ((col_idx = find_column(column_id)) < 0) {
+  } else if (OB_FAIL(fill_column_stat(micro_block_idx, col_idx, stat))) {
+    if (OB_ENTRY_NOT_EXIST == ret) {
+      ret = OB_SUCCESS;
+    }
+  } else {
+    found = true;
+  }
+  return ret;
+}
+
+int ObMicroBlockSkipIndex::get_macro_column_stat(
+    const uint64_t column_id, ObSkipIndexColumnStat& stat, bool& found) const
+{
+  int ret = OB_SUCCESS;
+  int64_t col_idx = -1;
+  int cmp = 0;
+  ObSkipIndexColumnStat micro_stat;
+  found = false;
+  stat.reset();
+  if (OB_UNLIKELY(!is_valid())) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("skip index not init", K(ret));
+  } else if ((col_idx = find_column(column_id)) >= 0) {
+    found = true;
+    for (int64_t i = 0; OB_SUCC(ret) && found && i < micro_block_count_; ++i) {
+      if (OB_FAIL(fill_column_stat(i, col_idx, micro_stat))) {
+        if (OB_ENTRY_NOT_EXIST == ret) {
+          ret = OB_SUCCESS;
+          found = false;
+        }
+      } else {
+        stat.row_count_ += micro_stat.row_count_;
+        stat.null_count_ += micro_stat.null_count_;
+        if (!micro_stat.has_min_max_) {
+        } else if (!stat.has_min_max_) {
+          stat.has_min_max_ = true;
+          stat.min_ = micro_stat.min_;
+          stat.max_ = micro_stat.max_;
+        } else if (OB_FAIL(micro_stat.min_.compare(stat.min_, cmp))) {
+          LOG_WARN("failed to compare min value", K(ret), K(micro_stat), K(stat));
+        } else if (FALSE_IT(stat.min_ = cmp < 0 ? micro_stat.min_ : stat.min_)) {
+        } else if (OB_FAIL(micro_stat.max_.compare(stat.max_, cmp))) {
+          LOG_WARN("failed to compare max value", K(ret), K(micro_stat), K(stat));
+        } else if (cmp > 0) {
+          stat.max_ = micro_stat.max_;
+        }
+      }
+    }
+    if (OB_FAIL(ret) || !found) {
+      stat.reset();
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockSkipIndex::check_skip(
+    const int64_t micro_block_idx, ObPushdownFilterExecutor& filter, bool& can_skip) const
+{
+  int ret = OB_SUCCESS;
+  can_skip = false;
+  if (OB_UNLIKELY(!is_valid())) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("skip index not init", K(ret));
+  } else if (OB_UNLIKELY(micro_block_idx < 0 || micro_block_idx >= micro_block_count_)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid micro block idx", K(ret), K(micro_block_idx), K_(micro_block_count));
+  } else if (filter.is_filter_white_node()) {
+    ret = check_skip_white_filter(micro_block_idx, static_cast<ObWhiteFilterExecutor&>(filter), can_skip);
+  } else if (filter.is_logic_op_node()) {
+    // AND skips if any child skips, OR skips only if all children skip
+    const bool is_and = filter.is_logic_and_node();
+    ObPushdownFilterExecutor** childs = filter.get_childs();
+    const uint32_t child_count = filter.get_child_count();
+    bool child_skip = false;
+    can_skip = !is_and && child_count > 0;
+    for (uint32_t i = 0; OB_SUCC(ret) && i < child_count && can_skip != is_and; ++i) {
+      if (OB_ISNULL(childs[i])) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("unexpected null child filter", K(ret), K(i));
+      } else if (OB_FAIL(check_skip(micro_block_idx, *childs[i], child_skip))) {
+        LOG_WARN("failed to check child filter", K(ret), K(i));
+      } else {
+        can_skip = is_and ? child_skip : (can_skip && child_skip);
+      }
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockSkipIndex::check_skip_white_filter(
+    const int64_t micro_block_idx, ObWhiteFilterExecutor& filter, bool& can_skip) const
+{
+  int ret = OB_SUCCESS;
+  int64_t col_idx = -1;
+  ObSkipIndexColumnStat stat;
+  can_skip = false;
+  if (1 != filter.get_col_ids().count() || (col_idx = find_column(filter.get_col_ids().at(0))) < 0) {
+  } else if (OB_FAIL(fill_column_stat(micro_block_idx, col_idx, stat))) {
+    if (OB_ENTRY_NOT_EXIST == ret) {
+      ret = OB_SUCCESS;
+    }
+  } else {
+    const ObWhiteFilterOperatorType op_type = filter.get_op_type();
+    const ObObj& param = filter.get_param();
+    int cmp_min = 0;
+    int cmp_max = 0;
+    if (WHITE_OP_NU == op_type) {
+      can_skip = 0 == stat.null_count_;
+    } else if (WHITE_OP_NN == op_type) {
+      can_skip = stat.null_count_ == stat.row_count_;
+    } else if (stat.null_count_ == stat.row_count_ || param.is_null()) {
+      // comparison with null is never true
+      can_skip = true;
+    } else if (!stat.has_min_max_ || param.get_type_class() != stat.min_.get_type_class()) {
+    } else if (OB_FAIL(stat.min_.compare(param, param.get_collation_type(), cmp_min))) {
+      LOG_WARN("failed to compare min value with filter param", K(ret), K(stat), K(param));
+    } else if (OB_FAIL(stat.max_.compare(param, param.get_collation_type(), cmp_max))) {
+      LOG_WARN("failed to compare max value with filter param", K(ret), K(stat), K(param));
+    } else {
+      switch (op_type) {
+        case WHITE_OP_EQ:
+          can_skip = cmp_min > 0 || cmp_max < 0;
+          break;
+        case WHITE_OP_NE:
+          can_skip = 0 == cmp_min && 0 == cmp_max;
+          break;
+        case WHITE_OP_LT:
+          can_skip = cmp_min >= 0;
+          break;
+        case WHITE_OP_LE:
+          can_skip = cmp_min > 0;
+          break;
+        case WHITE_OP_GT:
+          can_skip = cmp_max <= 0;
+          break;
+        case WHITE_OP_GE:
+          can_skip = cmp_max < 0;
+          break;
+        default:
+          ret = OB_ERR_UNEXPECTED;
+          LOG_WARN("unexpected white filter operator", K(ret), K(op_type));
+          break;
+      }
+    }
+  }
+  return ret;
+}
+
+}  // end namespace blocksstable
+}  // end namespace oceanbase
@@ -0,0 +1,214 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_STORAGE_BLOCKSSTABLE_OB_MICRO_BLOCK_SKIP_INDEX_H_
+#define OCEANBASE_STORAGE_BLOCKSSTABLE_OB_MICRO_BLOCK_SKIP_INDEX_H_
+
+#include "common/object/ob_object.h"
+#include "common/row/ob_row.h"
+
+namespace oceanbase {
+namespace sql {
+class ObPushdownFilterExecutor;
+class ObWhiteFilterExecutor;
+}  // namespace sql
+namespace blocksstable {
+
+// The skip index is the last section behind the micro block index of a macro block:
+//
+//   ObSkipIndexHeader | ObSkipIndexColumnMeta[column_count] |
+//   micro block 0: ObSkipIndexMicroHeader | ObSkipIndexColumnAggr[column_count] |
+//   micro block 1: ...
+//
+// Only fixed length columns are indexed, min and max keep the raw value of the ObObj.
+struct ObSkipIndexHeader {
+  static const int16_t SKIP_INDEX_VERSION = 1;
+  int16_t version_;
+  int16_t column_count_;
+  int32_t reserved_;
+  ObSkipIndexHeader() : version_(SKIP_INDEX_VERSION), column_count_(0), reserved_(0)
+  {}
+  TO_STRING_KV(K_(version), K_(column_count));
+};
+
+struct ObSkipIndexColumnMeta {
+  uint64_t column_id_;
+  common::ObObjMeta meta_;
+  int32_t reserved_;
+  ObSkipIndexColumnMeta() : column_id_(common::OB_INVALID_ID), meta_(), reserved_(0)
+  {}
+  TO_STRING_KV(K_(column_id), K_(meta));
+};
+
+struct ObSkipIndexMicroHeader {
+  static const int32_t AGGR_VALID = 1;
+  int32_t row_count_;
+  int32_t flag_;  // micro blocks reused without iterating rows have no aggregates
+  ObSkipIndexMicroHeader() : row_count_(0), flag_(0)
+  {}
+  OB_INLINE bool is_valid() const
+  {
+    return AGGR_VALID == flag_;
+  }
+  TO_STRING_KV(K_(row_count), K_(flag));
+};
+
+struct ObSkipIndexColumnAggr {
+  static const int32_t HAS_MIN_MAX = 1;
+  static const int32_t INVALID = 2;  // met values that can not be aggregated, e.g. nop
+  int32_t null_count_;
+  int32_t flag_;
+  int64_t min_;
+  int64_t max_;
+  ObSkipIndexColumnAggr() : null_count_(0), flag_(0), min_(0), max_(0)
+  {}
+  void reset()
+  {
+    null_count_ = 0;
+    flag_ = 0;
+    min_ = 0;
+    max_ = 0;
+  }
+  OB_INLINE bool has_min_max() const
+  {
+    return HAS_MIN_MAX == (flag_ & HAS_MIN_MAX);
+  }
+  OB_INLINE bool is_valid() const
+  {
+    return 0 == (flag_ & INVALID);
+  }
+  TO_STRING_KV(K_(null_count), K_(flag), K_(min), K_(max));
+};
+
+// decoded aggregate of one column, answers COUNT/MIN/MAX without reading rows
+struct ObSkipIndexColumnStat {
+  int64_t row_count_;
+  int64_t null_count_;
+  bool has_min_max_;
+  common::ObObj min_;
+  common::ObObj max_;
+  ObSkipIndexColumnStat()
+  {
+    reset();
+  }
+  void reset();
+  OB_INLINE int64_t get_not_null_count() const
+  {
+    return row_count_ - null_count_;
+  }
+  TO_STRING_KV(K_(row_count), K_(null_count), K_(has_min_max), K_(min), K_(max));
+};
+
+// collects the aggregates of the current micro block while rows are appended
+class ObSkipIndexAggregator {
+public:
+  static const int64_t MAX_COLUMN_COUNT = 32;
+  static const int64_t MAX_HEADER_SIZE =
+      sizeof(ObSkipIndexHeader) + MAX_COLUMN_COUNT * sizeof(ObSkipIndexColumnMeta);
+  static const int64_t MAX_ENTRY_SIZE =
+      sizeof(ObSkipIndexMicroHeader) + MAX_COLUMN_COUNT * sizeof(ObSkipIndexColumnAggr);
+
+public:
+  ObSkipIndexAggregator();
+  ~ObSkipIndexAggregator()
+  {}
+  int init(const uint64_t* column_ids, const common::ObObjMeta* column_types, const int64_t column_count);
+  void reset();
+  void reuse();
+  int update(const common::ObNewRow& row);
+  // entry of the current micro block, the aggregates are valid only if every row of it was updated
+  int get_entry(const int64_t micro_row_count, const char*& buf, int64_t& buf_len);
+  OB_INLINE const char* get_header() const
+  {
+    return reinterpret_cast<const char*>(&header_);
+  }
+  OB_INLINE int64_t get_header_size() const
+  {
+    return sizeof(ObSkipIndexHeader) + column_count_ * sizeof(ObSkipIndexColumnMeta);
+  }
+  OB_INLINE int64_t get_entry_size() const
+  {
+    return sizeof(ObSkipIndexMicroHeader) + column_count_ * sizeof(ObSkipIndexColumnAggr);
+  }
+  OB_INLINE int64_t get_column_count() const
+  {
+    return column_count_;
+  }
+  OB_INLINE bool is_inited() const
+  {
+    return is_inited_;
+  }
+  static bool is_column_supported(const uint64_t column_id, const common::ObObjMeta& column_type);
+  TO_STRING_KV(K_(is_inited), K_(column_count), K_(row_count));
+
+private:
+  struct Header {
+    ObSkipIndexHeader header_;
+    ObSkipIndexColumnMeta columns_[MAX_COLUMN_COUNT];
+  };
+  struct Entry {
+    ObSkipIndexMicroHeader header_;
+    ObSkipIndexColumnAggr aggrs_[MAX_COLUMN_COUNT];
+  };
+
+private:
+  bool is_inited_;
+  int64_t column_count_;
+  int64_t row_count_;
+  int64_t column_idxs_[MAX_COLUMN_COUNT];  // store index of the indexed columns
+  Header header_;
+  Entry entry_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(ObSkipIndexAggregator);
+};
+
+// read only view over the skip index section of one macro block
+class ObMicroBlockSkipIndex {
+public:
+  ObMicroBlockSkipIndex();
+  ~ObMicroBlockSkipIndex()
+  {}
+  int init(const char* buf, const int64_t buf_len, const int64_t micro_block_count);
+  void reset();
+  OB_INLINE bool is_valid() const
+  {
+    return NULL != entries_;
+  }
+  // @found is false if the column is not indexed or the micro block has no aggregates
+  int get_column_stat(
+      const int64_t micro_block_idx, const uint64_t column_id, ObSkipIndexColumnStat& stat, bool& found) const;
+  // merged aggregate of all micro blocks of the macro block
+  int get_macro_column_stat(const uint64_t column_id, ObSkipIndexColumnStat& stat, bool& found) const;
+  // @can_skip is true if no row of the micro block can satisfy @filter
+  int check_skip(const int64_t micro_block_idx, sql::ObPushdownFilterExecutor& filter, bool& can_skip) const;
+  TO_STRING_KV(K_(column_count), K_(micro_block_count), K_(entry_size), KP_(columns), KP_(entries));
+
+private:
+  int64_t find_column(const uint64_t column_id) const;
+  int fill_column_stat(const int64_t micro_block_idx, const int64_t col_idx, ObSkipIndexColumnStat& stat) const;
+  int check_skip_white_filter(
+      const int64_t micro_block_idx, sql::ObWhiteFilterExecutor& filter, bool& can_skip) const;
+
+private:
+  // the section is not aligned inside the macro block, values are copied out before use
+  const char* columns_;
+  const char* entries_;
+  int64_t column_count_;
+  int64_t micro_block_count_;
+  int64_t entry_size_;
+};
+
+}  // end namespace blocksstable
+}  // end namespace oceanbase
+
+#endif  // OCEANBASE_STORAGE_BLOCKSSTABLE_OB_MICRO_BLOCK_SKIP_INDEX_H_
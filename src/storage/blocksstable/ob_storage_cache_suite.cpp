@@ -11,13 +11,20 @@
  */
 
 #include "ob_storage_cache_suite.h"
+#include "share/config/ob_server_config.h"
 
 using namespace oceanbase::common;
 
 namespace oceanbase {
 namespace blocksstable {
 ObStorageCacheSuite::ObStorageCacheSuite()
-    : block_index_cache_(), user_block_cache_(), user_row_cache_(), bf_cache_(), fuse_row_cache_(), is_inited_(false)
+    : block_index_cache_(),
+      user_block_cache_(),
+      user_row_cache_(),
+      bf_cache_(),
+      fuse_row_cache_(),
+      micro_block_disk_cache_(),
+      is_inited_(false)
 {}
 
 ObStorageCacheSuite::~ObStorageCacheSuite()
@@ -91,8 +98,32 @@ int ObStorageCacheSuite::set_bf_cache_miss_count_threshold(const int64_t bf_cach
   return ret;
 }
 
+int ObStorageCacheSuite::open_micro_block_disk_cache(const int64_t data_file_id)
+{
+  int ret = OB_SUCCESS;
+  const char* file_path = GCONF._micro_block_disk_cache_path.str();
+  const int64_t file_size = GCONF._micro_block_disk_cache_size;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    STORAGE_LOG(WARN, "The cache suite has not been inited, ", K(ret));
+  } else if (OB_ISNULL(file_path) || 0 == STRLEN(file_path)) {
+    // disabled
+  } else if (OB_FAIL(micro_block_disk_cache_.open(file_path, file_size, data_file_id))) {
+    // not fatal, run with the memory cache only
+    STORAGE_LOG(ERROR, "fail to open micro block disk cache", K(ret), K(file_path), K(file_size));
+    ret = OB_SUCCESS;
+  } else if (OB_FAIL(user_block_cache_.set_wash_listener(&micro_block_disk_cache_))) {
+    STORAGE_LOG(WARN, "fail to set wash listener of user block cache", K(ret));
+  }
+  return ret;
+}
+
 void ObStorageCacheSuite::destroy()
 {
+  if (is_inited_) {
+    (void)user_block_cache_.set_wash_listener(NULL);
+  }
+  micro_block_disk_cache_.destroy();
   block_index_cache_.destroy();
   user_block_cache_.destroy();
   user_row_cache_.destroy();
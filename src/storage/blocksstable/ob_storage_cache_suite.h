@@ -16,6 +16,7 @@
 #include "share/schema/ob_table_schema.h"
 #include "ob_micro_block_index_cache.h"
 #include "ob_micro_block_cache.h"
+#include "ob_micro_block_disk_cache.h"
 #include "ob_block_cache_working_set.h"
 #include "ob_row_cache.h"
 #include "ob_fuse_row_cache.h"
@@ -36,10 +37,17 @@ public:
   int reset_priority(const int64_t index_cache_priority, const int64_t user_block_cache_priority,
       const int64_t user_row_cache_priority, const int64_t fuse_row_cache_priority, const int64_t bf_cache_priority);
   int set_bf_cache_miss_count_threshold(const int64_t bf_cache_miss_count_threshold);
+  // Open the disk tier of the user block cache if _micro_block_disk_cache_path is set,
+  // %data_file_id identifies the data file the cached micro blocks come from.
+  int open_micro_block_disk_cache(const int64_t data_file_id);
   ObMicroBlockCache& get_block_cache()
   {
     return user_block_cache_;
   }
+  ObMicroBlockDiskCache& get_micro_block_disk_cache()
+  {
+    return micro_block_disk_cache_;
+  }
   ObMicroBlockIndexCache& get_micro_index_cache()
   {
     return block_index_cache_;
@@ -72,6 +80,7 @@ private:
   ObRowCache user_row_cache_;
   ObBloomFilterCache bf_cache_;
   ObFuseRowCache fuse_row_cache_;
+  ObMicroBlockDiskCache micro_block_disk_cache_;
   bool is_inited_;
 
 private:
@@ -1138,8 +1138,11 @@ void ObStoreFile::mark_and_sweep()
 
     // sweep
     begin_time = end_time;
+    ObArray<uint32_t> sweep_blocks;
     if (OB_SUCC(ret)) {
-      for (int64_t i = 0; i < store_file_system_->get_total_macro_block_count() && is_mark_sweep_enabled(); ++i) {
+      for (int64_t i = 0;
+           OB_SUCC(ret) && i < store_file_system_->get_total_macro_block_count() && is_mark_sweep_enabled();
+           ++i) {
         if (bitmap_test(i)) {
           // block is marked
           if (macro_block_info_[i].is_free_) {
@@ -1149,17 +1152,8 @@ void ObStoreFile::mark_and_sweep()
         } else {
           // block is not marked
           if (0 == ATOMIC_LOAD(&(macro_block_info_[i].ref_cnt_))) {
-            if (!macro_block_info_[i].is_free_) {
-              free_block((uint32_t)i, is_freed);
-              if (is_freed) {
-                ++free_cnt;
-                if (OB_SUCCESS != databuff_printf(print_buffer_, print_buffer_size_, print_pos, "%ld,", i)) {
-                  print_buffer_[print_pos] = '\0';
-                  STORAGE_LOG(INFO, "mark_and_sweep free blocks.", K(print_buffer_));
-                  print_pos = 0;
-                  databuff_printf(print_buffer_, print_buffer_size_, print_pos, ",%ld,", i);
-                }
-              }
+            if (!macro_block_info_[i].is_free_ && OB_FAIL(sweep_blocks.push_back((uint32_t)i))) {
+              STORAGE_LOG(WARN, "Fail to push back sweep block, ", K(ret), K(i));
             }
           } else {
             // unmark but is using
@@ -1168,6 +1162,24 @@ void ObStoreFile::mark_and_sweep()
         }
       }
     }
+    if (OB_SUCC(ret) && sweep_blocks.count() > 0) {
+      // the micro blocks of these blocks kept in the disk cache must be invalid on disk before the blocks
+      // can be reused
+      OB_STORE_CACHE.get_micro_block_disk_cache().invalidate_blocks(sweep_blocks);
+      for (int64_t i = 0; i < sweep_blocks.count() && is_mark_sweep_enabled(); ++i) {
+        const uint32_t block_idx = sweep_blocks.at(i);
+        free_block(block_idx, is_freed);
+        if (is_freed) {
+          ++free_cnt;
+          if (OB_SUCCESS != databuff_printf(print_buffer_, print_buffer_size_, print_pos, "%u,", block_idx)) {
+            print_buffer_[print_pos] = '\0';
+            STORAGE_LOG(INFO, "mark_and_sweep free blocks.", K(print_buffer_));
+            print_pos = 0;
+            databuff_printf(print_buffer_, print_buffer_size_, print_pos, ",%u,", block_idx);
+          }
+        }
+      }
+    }
     end_time = ObTimeUtility::current_time();
     sweep_cost_time_ = end_time - begin_time;
 
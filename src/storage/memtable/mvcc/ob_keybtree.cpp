@@ -23,6 +23,10 @@ namespace oceanbase {
 namespace keybtree {
 using namespace oceanbase::common;
 
+STATIC_ASSERT(sizeof(BtreeNode) <= NODE_SIZE, "btree node exceeds NODE_SIZE");
+STATIC_ASSERT(sizeof(HazardLessIterator) <= sizeof(TScanHandle::buf_), "iterator exceeds scan handle buffer");
+STATIC_ASSERT(sizeof(Iterator) <= sizeof(TScanRawHandle::buf_), "iterator exceeds raw scan handle buffer");
+
 // ob_keybtree_deps.h begin
 
 bool RWLock::try_rdlock()
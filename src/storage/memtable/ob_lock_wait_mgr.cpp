@@ -53,6 +53,8 @@ static inline uint64_t hash_trans(const uint32_t ctx_desc)
 ObLockWaitMgr::ObLockWaitMgr() : is_inited_(false), hash_(hash_buf_, sizeof(hash_buf_)), mt_id_map_(NULL)
 {
   memset(sequence_, 0, sizeof(sequence_));
+  memset(row_waiter_cnt_, 0, sizeof(row_waiter_cnt_));
+  memset(hotspot_slots_, 0, sizeof(hotspot_slots_));
 }
 
 ObLockWaitMgr::~ObLockWaitMgr()
@@ -157,6 +159,9 @@ bool ObLockWaitMgr::wait(Node* node)
       while (-EAGAIN == (err = hash_.insert(node)))
         ;
       assert(0 == err);
+      if (0 == (hash & TRANS_MARK)) {
+        check_hotspot(*node, inc_row_waiter_cnt(hash));
+      }
 
       // 2. double checkcheck_wakeup_seq
       if (!is_standalone_task && check_wakeup_seq(hash, last_lock_seq, is_standalone_task)) {
@@ -172,6 +177,7 @@ bool ObLockWaitMgr::wait(Node* node)
           wait_succ = true;  // maybe repost by checktimeout
           node = NULL;
         } else {
+          dec_row_waiter_cnt(hash);
           node->try_lock_times_--;
         }
       } else {
@@ -200,6 +206,41 @@ void ObLockWaitMgr::wakeup(uint64_t hash)
   }
 }
 
+int64_t ObLockWaitMgr::inc_row_waiter_cnt(const uint64_t hash)
+{
+  return 0 != (hash & TRANS_MARK) ? 0 : ATOMIC_AAF(&row_waiter_cnt_[(hash >> 1) % LOCK_BUCKET_COUNT], 1);
+}
+
+void ObLockWaitMgr::dec_row_waiter_cnt(const uint64_t hash)
+{
+  if (0 == (hash & TRANS_MARK)) {
+    ATOMIC_DEC(&row_waiter_cnt_[(hash >> 1) % LOCK_BUCKET_COUNT]);
+  }
+}
+
+void ObLockWaitMgr::check_hotspot(const Node& node, const int64_t waiter_cnt)
+{
+  if (waiter_cnt >= HOTSPOT_ROW_WAITER_COUNT) {
+    const uint64_t tenant_id = extract_tenant_id(node.table_id_);
+    uint64_t& slot = hotspot_slots_[tenant_id % HOTSPOT_SLOT_COUNT];
+    const uint64_t new_slot = make_hotspot_slot(tenant_id, ObClockGenerator::getClock() / HOTSPOT_SLOT_TS_UNIT_US);
+    // refreshed at most once a second, the slot is read by every transaction of the tenant
+    if (ATOMIC_LOAD(&slot) != new_slot) {
+      ATOMIC_STORE(&slot, new_slot);
+      TRANS_LOG(INFO, "LOCK_MGR: hotspot row found", K(tenant_id), K(waiter_cnt), K(node));
+    }
+  }
+}
+
+bool ObLockWaitMgr::is_hotspot_tenant(const uint64_t tenant_id) const
+{
+  // tenant and time are read together, a slot taken by another tenant meanwhile is never mixed up
+  const uint64_t slot = ATOMIC_LOAD(&hotspot_slots_[tenant_id % HOTSPOT_SLOT_COUNT]);
+  const int64_t hot_ts = static_cast<int64_t>(slot & HOTSPOT_SLOT_TS_MASK) * HOTSPOT_SLOT_TS_UNIT_US;
+  return 0 != slot && (slot >> HOTSPOT_SLOT_TS_BITS) == tenant_id &&
+         ObClockGenerator::getClock() - hot_ts < HOTSPOT_EXPIRE_US;
+}
+
 ObLockWaitMgr::Node* ObLockWaitMgr::next(Node*& iter, Node* target)
 {
   CriticalGuard(get_qs());
@@ -239,6 +280,7 @@ ObLockWaitMgr::Node* ObLockWaitMgr::fetch_waiter(uint64_t hash)
           if (0 != err) {
             ret = NULL;
           } else {
+            dec_row_waiter_cnt(hash);
             break;
           }
         }
@@ -378,6 +420,7 @@ void ObLockWaitMgr::retire_node(ObLink*& tail, Node* node)
   while (-EAGAIN == (err = hash_.del(node, tmp_node)))
     ;
   if (0 == err) {
+    dec_row_waiter_cnt(node->hash());
     node->retire_link_.next_ = tail;
     tail = &node->retire_link_;
   }
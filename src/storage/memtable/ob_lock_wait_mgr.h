@@ -37,7 +37,11 @@ public:
   friend class observer::ObAllVirtualLockWaitStat;
 
 public:
-  enum { LOCK_BUCKET_COUNT = 65536 };
+  enum { LOCK_BUCKET_COUNT = 65536, HOTSPOT_SLOT_COUNT = 256 };
+  // a row is hot if so many requests are waiting for its lock
+  static const int64_t HOTSPOT_ROW_WAITER_COUNT = 8;
+  // a tenant stays in hotspot mode for a while after its last hot row is found
+  static const int64_t HOTSPOT_EXPIRE_US = 10 * 1000 * 1000;
   typedef ObMemtableKey Key;
   typedef rpc::ObLockWaitNode Node;
   typedef FixedHash2<Node> Hash;
@@ -84,6 +88,9 @@ public:
   void wakeup(const Key& key);
   // wakeup the request waiting on the transaction
   void wakeup(const uint32_t ctx_desc);
+  // whether a hot row of the tenant is found recently. With _enable_hotspot_early_lock_release, early lock
+  // release is only used by such tenants, where the updates of a hot row wait for the clog commit otherwise.
+  bool is_hotspot_tenant(const uint64_t tenant_id) const;
 
 protected:
   // obtain the request waiting on the row or transaction
@@ -102,6 +109,11 @@ private:
   Node* next(Node*& iter, Node* target);
   Node* get(uint64_t hash);
   void wakeup(uint64_t hash);
+  // record the tenant of %node if %waiter_cnt requests are waiting on its row
+  void check_hotspot(const Node& node, const int64_t waiter_cnt);
+  // requests waiting on rows are counted by bucket like sequence_, rows sharing a bucket are counted together
+  int64_t inc_row_waiter_cnt(const uint64_t hash);
+  void dec_row_waiter_cnt(const uint64_t hash);
 
 private:
   Node*& get_thread_node()
@@ -148,10 +160,22 @@ private:
     return ATOMIC_LOAD(&sequence_[(hash >> 1) % LOCK_BUCKET_COUNT]);
   }
 
+  // A hotspot slot packs the tenant id and the time, in seconds, its last hot row was found into one word,
+  // so they are read and written atomically. Tenant ids fit in 24 bits, see extract_tenant_id.
+  static const int64_t HOTSPOT_SLOT_TS_BITS = 40;
+  static const uint64_t HOTSPOT_SLOT_TS_MASK = (1ULL << HOTSPOT_SLOT_TS_BITS) - 1;
+  static const int64_t HOTSPOT_SLOT_TS_UNIT_US = 1000 * 1000;
+  static uint64_t make_hotspot_slot(const uint64_t tenant_id, const int64_t hot_ts)
+  {
+    return (tenant_id << HOTSPOT_SLOT_TS_BITS) | (static_cast<uint64_t>(hot_ts) & HOTSPOT_SLOT_TS_MASK);
+  }
+
 private:
   bool is_inited_;
   Hash hash_;
   int64_t sequence_[LOCK_BUCKET_COUNT];
+  int32_t row_waiter_cnt_[LOCK_BUCKET_COUNT];
+  uint64_t hotspot_slots_[HOTSPOT_SLOT_COUNT];
   char hash_buf_[sizeof(SpHashNode) * LOCK_BUCKET_COUNT];
 
 public:
@@ -31,6 +31,7 @@
 #include "storage/memtable/ob_memtable_util.h"
 #include "storage/memtable/ob_memtable_context.h"
 #include "storage/memtable/ob_lock_wait_mgr.h"
+#include "storage/memtable/ob_replay_row_prefetcher.h"
 
 #include "storage/transaction/ob_trans_define.h"
 #include "storage/transaction/ob_trans_part_ctx.h"
@@ -1362,6 +1363,19 @@ int ObMemtable::replay(const ObStoreCtx& ctx, const char* data, const int64_t da
       } else {
         ObStoreRowkey rowkey;
         ObRowData row;
+        // rows of a large redo log are decoded before replay to be prefetched, then replayed from replay_rows
+        ObArray<ObReplayRow> replay_rows;
+        int64_t replay_row_idx = 0;
+        const bool use_replay_rows = &tmp_mmi == mmi && !mmi->is_big_row() &&
+                                     mmi->get_meta().get_row_count() >= ObReplayRowPrefetcher::MIN_ROW_CNT;
+        if (use_replay_rows) {
+          int tmp_ret = OB_SUCCESS;
+          if (OB_FAIL(decode_replay_rows_(*mmi, replay_rows))) {
+            TRANS_LOG(WARN, "decode replay rows failed", K(ret), K(data_len));
+          } else if (OB_SUCCESS != (tmp_ret = prefetch_replay_rows_(replay_rows))) {
+            TRANS_LOG(DEBUG, "prefetch replay rows failed", K(tmp_ret), K(data_len));
+          }
+        }
         while (OB_SUCCESS == ret) {
           uint64_t table_id = OB_INVALID_ID;
           int64_t table_version = 0;
@@ -1373,8 +1387,27 @@ int ObMemtable::replay(const ObStoreCtx& ctx, const char* data, const int64_t da
           ObRowDml dml_type = T_DML_UNKNOWN;
           rowkey.reset();
           row.reset();
-          if (OB_FAIL(mmi->get_next_row(
-                  table_id, rowkey, table_version, row, dml_type, modify_count, acc_checksum, version, sql_no, flag))) {
+          if (use_replay_rows) {
+            if (replay_row_idx >= replay_rows.count()) {
+              ret = OB_ITER_END;
+            } else {
+              const ObReplayRow& replay_row = replay_rows.at(replay_row_idx++);
+              table_id = replay_row.table_id_;
+              rowkey = replay_row.rowkey_;
+              table_version = replay_row.table_version_;
+              row = replay_row.row_;
+              dml_type = replay_row.dml_type_;
+              modify_count = replay_row.modify_count_;
+              acc_checksum = replay_row.acc_checksum_;
+              version = replay_row.version_;
+              sql_no = replay_row.sql_no_;
+              flag = replay_row.flag_;
+            }
+          } else {
+            ret = mmi->get_next_row(
+                table_id, rowkey, table_version, row, dml_type, modify_count, acc_checksum, version, sql_no, flag);
+          }
+          if (OB_FAIL(ret)) {
             if (OB_ITER_END != ret) {
               TRANS_LOG(WARN, "get next row error", K(ret));
             }
@@ -1475,6 +1508,98 @@ int ObMemtable::replay(const ObStoreCtx& ctx, const char* data, const int64_t da
   return ret;
 }
 
+int ObMemtable::prefetch_replay_row(const ObMemtableKey& key)
+{
+  int ret = OB_SUCCESS;
+  ObMemtableKey stored_key;
+  ObMvccRow* value = NULL;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+  } else if (OB_FAIL(mvcc_engine_.create_kv(&key, &stored_key, value))) {
+    TRANS_LOG(WARN, "create kv failed", K(ret), K(key));
+  } else {
+    ObRowLatchGuard guard(value->latch_);
+    if (OB_FAIL(query_engine_.ensure(&stored_key, value))) {
+      TRANS_LOG(WARN, "ensure row failed", K(ret), K(stored_key));
+    }
+  }
+  return ret;
+}
+
+// Decode all the rows of a redo log, so that a large redo log is not decoded twice for its prefetch and its
+// replay. The iterator decodes the rowkey of every row into the same obj array, the objs are copied into the sql
+// arena, which is reset after replay. Strings of the rowkeys and the row data still point to the redo log.
+int ObMemtable::decode_replay_rows_(ObMemtableMutatorIterator& mmi, ObIArray<ObReplayRow>& rows)
+{
+  int ret = OB_SUCCESS;
+  ObIAllocator& allocator = THIS_WORKER.get_sql_arena_allocator();
+  if (OB_FAIL(rows.reserve(mmi.get_meta().get_row_count()))) {
+    TRANS_LOG(WARN, "reserve replay rows failed", K(ret), "row_count", mmi.get_meta().get_row_count());
+  }
+  while (OB_SUCC(ret)) {
+    ObReplayRow row;
+    ObStoreRowkey rowkey;
+    ObObj* objs = NULL;
+    if (OB_FAIL(mmi.get_next_row(row.table_id_,
+            rowkey,
+            row.table_version_,
+            row.row_,
+            row.dml_type_,
+            row.modify_count_,
+            row.acc_checksum_,
+            row.version_,
+            row.sql_no_,
+            row.flag_))) {
+      if (OB_ITER_END != ret) {
+        TRANS_LOG(WARN, "get next row error", K(ret));
+      }
+    } else if (OB_ISNULL(objs = static_cast<ObObj*>(allocator.alloc(sizeof(ObObj) * rowkey.get_obj_cnt())))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      TRANS_LOG(WARN, "alloc rowkey failed", K(ret), K(rowkey));
+    } else {
+      MEMCPY(objs, rowkey.get_obj_ptr(), sizeof(ObObj) * rowkey.get_obj_cnt());
+      row.rowkey_.assign(objs, rowkey.get_obj_cnt());
+      if (OB_FAIL(rows.push_back(row))) {
+        TRANS_LOG(WARN, "push back replay row failed", K(ret));
+      }
+    }
+  }
+  if (OB_ITER_END == ret) {
+    ret = OB_SUCCESS;
+  }
+  return ret;
+}
+
+// Let ObReplayRowPrefetcher locate the rows of a redo log in parallel before they are replayed.
+// Nothing is prefetched if a row would not pass the schema check of replay, rows are not created in the
+// memtable before replay is sure to apply them.
+int ObMemtable::prefetch_replay_rows_(const ObIArray<ObReplayRow>& rows)
+{
+  int ret = OB_SUCCESS;
+  ObSEArray<ObMemtableKey, ObReplayRowPrefetcher::MIN_ROW_CNT> keys;
+  if (OB_FAIL(keys.reserve(rows.count()))) {
+    TRANS_LOG(WARN, "reserve keys failed", K(ret), "row_count", rows.count());
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < rows.count(); ++i) {
+    const ObReplayRow& row = rows.at(i);
+    ObMemtableKey mtk;
+    if (OB_FAIL(ObPartitionService::get_instance().check_standby_cluster_schema_condition(
+            key_.get_partition_key(), row.table_version_))) {
+      TRANS_LOG(DEBUG, "schema condition not ready, skip prefetch", K(ret), K(row));
+    } else if (0 != row.flag_) {
+      // rollback to savepoint
+    } else if (OB_FAIL(mtk.encode(row.table_id_, &row.rowkey_))) {
+      TRANS_LOG(WARN, "mtk encode fail", K(ret), K(row));
+    } else if (OB_FAIL(keys.push_back(mtk))) {
+      TRANS_LOG(WARN, "push back key failed", K(ret));
+    }
+  }
+  if (OB_SUCC(ret) && keys.count() >= ObReplayRowPrefetcher::MIN_ROW_CNT) {
+    ret = ObReplayRowPrefetcher::get_instance().prefetch(*this, keys);
+  }
+  return ret;
+}
+
 int ObMemtable::estimate_get_row_count(const common::ObQueryFlag query_flag, const uint64_t table_id,
     const common::ObIArray<common::ObExtStoreRowkey>& rowkeys, storage::ObPartitionEst& part_est)
 {
@@ -34,6 +34,7 @@ class ObVersion;
 };  // namespace common
 namespace memtable {
 class ObMemtableCompactWriter;
+class ObMemtableMutatorIterator;
 class ObMemtableScanIterator;
 class ObMemtableGetIterator;
 
@@ -189,6 +190,8 @@ public:
       uint32_t& modify_count, uint32_t& acc_checksum);
   virtual int replay(const storage::ObStoreCtx& ctx, const char* data, const int64_t data_len);
   virtual int replay_schema_version_change_log(const int64_t schema_version);
+  // Locate or create the row of %key before its replay, used by ObReplayRowPrefetcher.
+  int prefetch_replay_row(const ObMemtableKey& key);
 
   ObQueryEngine& get_query_engine()
   {
@@ -383,6 +386,35 @@ private:
       const char* data, const int64_t data_len, const storage::ObRowDml dml_type, const uint32_t modify_count,
       const uint32_t acc_checksum, const int64_t version, const int32_t sql_no, const int32_t flag,
       const int64_t log_timestamp);
+  // a row of redo log, decoded once for both its prefetch and its replay
+  struct ObReplayRow {
+    ObReplayRow()
+        : table_id_(common::OB_INVALID_ID),
+          rowkey_(),
+          table_version_(0),
+          row_(),
+          dml_type_(storage::T_DML_UNKNOWN),
+          modify_count_(0),
+          acc_checksum_(0),
+          version_(0),
+          sql_no_(0),
+          flag_(0)
+    {}
+    TO_STRING_KV(K_(table_id), K_(rowkey), K_(table_version), K_(row), K_(dml_type), K_(modify_count),
+        K_(acc_checksum), K_(version), K_(sql_no), K_(flag));
+    uint64_t table_id_;
+    common::ObStoreRowkey rowkey_;
+    int64_t table_version_;
+    ObRowData row_;
+    storage::ObRowDml dml_type_;
+    uint32_t modify_count_;
+    uint32_t acc_checksum_;
+    int64_t version_;
+    int32_t sql_no_;
+    int32_t flag_;
+  };
+  int decode_replay_rows_(ObMemtableMutatorIterator& mmi, common::ObIArray<ObReplayRow>& rows);
+  int prefetch_replay_rows_(const common::ObIArray<ObReplayRow>& rows);
   int m_prepare_kv(const storage::ObStoreCtx& ctx, const ObMemtableKey* key, ObMemtableKey* stored_key,
       ObMvccRow*& value, RowHeaderGetter& getter, const bool is_replay,
       const ObIArray<share::schema::ObColDesc>& columns, bool& is_new_add, bool& is_new_locked);
@@ -0,0 +1,157 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include "ob_replay_row_prefetcher.h"
+#include "ob_memtable.h"
+#include "share/ob_thread_mgr.h"
+
+namespace oceanbase {
+using namespace common;
+
+namespace memtable {
+ObReplayRowPrefetcher& ObReplayRowPrefetcher::get_instance()
+{
+  static ObReplayRowPrefetcher instance;
+  return instance;
+}
+
+// Called by every init of the replay engine, a prefetcher already started is kept.
+int ObReplayRowPrefetcher::init()
+{
+  int ret = OB_SUCCESS;
+  if (is_inited_) {
+    // already started
+  } else if (OB_FAIL(TG_SET_HANDLER_AND_START(lib::TGDefIDs::ReplayRowPrefetch, *this))) {
+    TRANS_LOG(WARN, "replay row prefetcher thread pool start failed", K(ret));
+  } else {
+    is_inited_ = true;
+    TRANS_LOG(INFO, "replay row prefetcher init success");
+  }
+  return ret;
+}
+
+void ObReplayRowPrefetcher::stop()
+{
+  TG_STOP(lib::TGDefIDs::ReplayRowPrefetch);
+}
+
+void ObReplayRowPrefetcher::wait()
+{
+  // the thread pool is released once its threads exit, init starts a new one
+  TG_WAIT(lib::TGDefIDs::ReplayRowPrefetch);
+  is_inited_ = false;
+}
+
+void ObReplayRowPrefetcher::destroy()
+{
+  if (is_inited_) {
+    stop();
+    wait();
+  }
+}
+
+int ObReplayRowPrefetcher::prefetch(ObMemtable& memtable, const ObIArray<ObMemtableKey>& keys)
+{
+  int ret = OB_SUCCESS;
+  const int64_t group_cnt = std::min(MAX_GROUP_CNT, keys.count() / MIN_GROUP_ROW_CNT);
+  void* buf = NULL;
+  Batch* batch = NULL;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+  } else if (keys.count() < MIN_ROW_CNT || group_cnt < 2) {
+    // not worth the handoff
+  } else if (OB_ISNULL(buf = ob_malloc(sizeof(Batch), "ReplayPrefetch"))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    TRANS_LOG(WARN, "alloc replay prefetch batch failed", K(ret));
+  } else {
+    batch = new (buf) Batch();
+    batch->memtable_ = &memtable;
+    batch->keys_ = &keys;
+    batch->group_cnt_ = group_cnt;
+    batch->running_cnt_ = 0;
+    batch->ref_cnt_ = 1;
+    for (int64_t i = 0; i < group_cnt; ++i) {
+      batch->groups_[i].batch_ = batch;
+      batch->groups_[i].idx_ = i;
+      batch->groups_[i].is_claimed_ = false;
+    }
+    // the first group is left to this thread
+    for (int64_t i = 1; i < group_cnt; ++i) {
+      ATOMIC_INC(&batch->ref_cnt_);
+      if (OB_SUCCESS != TG_PUSH_TASK(lib::TGDefIDs::ReplayRowPrefetch, &batch->groups_[i])) {
+        ATOMIC_DEC(&batch->ref_cnt_);
+      }
+    }
+    for (int64_t i = 0; i < group_cnt; ++i) {
+      if (claim_group_(batch->groups_[i])) {
+        handle_group_(batch->groups_[i]);
+      }
+    }
+    // the memtable and the keys belong to the caller, wait for the groups started by workers
+    while (ATOMIC_LOAD(&batch->running_cnt_) > 0) {
+      const uint32_t seq = batch->cond_.get_seq();
+      if (ATOMIC_LOAD(&batch->running_cnt_) > 0) {
+        (void)batch->cond_.wait(seq, WAIT_GROUP_TIMEOUT_US);
+      }
+    }
+    dec_ref_(batch);
+    batch = NULL;
+  }
+  return ret;
+}
+
+void ObReplayRowPrefetcher::handle(void* task)
+{
+  if (OB_NOT_NULL(task)) {
+    Group* group = static_cast<Group*>(task);
+    Batch* batch = group->batch_;
+    // counted before claiming, the replay thread sees it once the group can not be claimed by itself
+    ATOMIC_INC(&batch->running_cnt_);
+    if (claim_group_(*group)) {
+      handle_group_(*group);
+    }
+    if (0 == ATOMIC_AAF(&batch->running_cnt_, -1)) {
+      batch->cond_.signal();
+    }
+    dec_ref_(batch);
+  }
+}
+
+bool ObReplayRowPrefetcher::claim_group_(Group& group)
+{
+  return ATOMIC_BCAS(&group.is_claimed_, false, true);
+}
+
+void ObReplayRowPrefetcher::handle_group_(Group& group)
+{
+  int ret = OB_SUCCESS;
+  const Batch& batch = *group.batch_;
+  const ObIArray<ObMemtableKey>& keys = *batch.keys_;
+  for (int64_t i = 0; OB_SUCC(ret) && i < keys.count(); ++i) {
+    const ObMemtableKey& key = keys.at(i);
+    if (group.idx_ == static_cast<int64_t>(key.hash() % batch.group_cnt_)) {
+      // best effort, the replay of the row does it again if failed
+      ret = batch.memtable_->prefetch_replay_row(key);
+    }
+  }
+}
+
+void ObReplayRowPrefetcher::dec_ref_(Batch* batch)
+{
+  if (0 == ATOMIC_AAF(&batch->ref_cnt_, -1)) {
+    batch->~Batch();
+    ob_free(batch);
+  }
+}
+
+}  // namespace memtable
+}  // namespace oceanbase
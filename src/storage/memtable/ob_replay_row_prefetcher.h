@@ -0,0 +1,89 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_MEMTABLE_OB_REPLAY_ROW_PREFETCHER_
+#define OCEANBASE_MEMTABLE_OB_REPLAY_ROW_PREFETCHER_
+
+#include "lib/container/ob_iarray.h"
+#include "lib/lock/ob_fcond.h"
+#include "lib/thread/thread_mgr_interface.h"
+#include "ob_memtable_key.h"
+
+namespace oceanbase {
+namespace memtable {
+class ObMemtable;
+
+// A redo log is replayed by the replay thread of its transaction row by row, and most of the time of a
+// row is spent on locating it in the memtable: the keyhash lookup and, for a new row, the keybtree insert.
+// For a large redo log this part is spread over the worker threads before the rows are applied, so the
+// replay thread only finds rows which already exist.
+//
+// Rows are split into groups by the hash of their key, so all the mutations of a rowkey are handled by one
+// group in log order. Trans nodes, row callbacks and the order of transactions are still done by the replay
+// thread, the result of replay does not change. The replay thread takes the groups no worker has started,
+// so a redo log is never replayed slower than without workers because the workers are busy.
+class ObReplayRowPrefetcher : public lib::TGTaskHandler {
+public:
+  static const int64_t THREAD_NUM = 8;
+  static const int64_t MINI_MODE_THREAD_NUM = 1;
+  static const int64_t MAX_TASK_NUM = 64 * 1024;
+  // redo logs with less rows are replayed without prefetch
+  static const int64_t MIN_ROW_CNT = 64;
+  static const int64_t MIN_GROUP_ROW_CNT = 32;
+  static const int64_t MAX_GROUP_CNT = THREAD_NUM + 1;
+  static const int64_t WAIT_GROUP_TIMEOUT_US = 10 * 1000;
+
+  static ObReplayRowPrefetcher& get_instance();
+  ObReplayRowPrefetcher() : is_inited_(false)
+  {}
+  ~ObReplayRowPrefetcher()
+  {}
+  int init();
+  void stop();
+  void wait();
+  void destroy();
+  // Locate or create the rows of %keys in %memtable, returns after all of them are done.
+  int prefetch(ObMemtable& memtable, const common::ObIArray<ObMemtableKey>& keys);
+  virtual void handle(void* task) override;
+
+private:
+  struct Batch;
+  struct Group {
+    Batch* batch_;
+    int64_t idx_;
+    bool is_claimed_;
+  };
+  // shared by the replay thread and the workers it pushed groups to, the last one frees it
+  struct Batch {
+    ObMemtable* memtable_;
+    const common::ObIArray<ObMemtableKey>* keys_;
+    Group groups_[MAX_GROUP_CNT];
+    int64_t group_cnt_;
+    int64_t running_cnt_;  // groups being handled by workers
+    int64_t ref_cnt_;
+    common::ObFCond cond_;  // signaled when running_cnt_ drops to 0
+  };
+
+  // only the replay thread and the worker which claims a group touch the memtable and the keys
+  bool claim_group_(Group& group);
+  void handle_group_(Group& group);
+  void dec_ref_(Batch* batch);
+
+private:
+  bool is_inited_;
+  DISALLOW_COPY_AND_ASSIGN(ObReplayRowPrefetcher);
+};
+
+}  // namespace memtable
+}  // namespace oceanbase
+
+#endif  // OCEANBASE_MEMTABLE_OB_REPLAY_ROW_PREFETCHER_
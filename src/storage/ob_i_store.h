@@ -1093,7 +1093,8 @@ public:
   bool enable_fuse_row_cache() const;
   TO_STRING_KV(K_(table_id), K_(schema_version), K_(rowkey_cnt), KP_(out_cols), KP_(cols_id_map), KP_(projector),
       KP_(full_projector), KP_(out_cols_project), KP_(out_cols_param), KP_(full_out_cols_param),
-      K_(is_multi_version_minor_merge), KP_(full_out_cols), KP_(full_cols_id_map), K_(need_scn), K_(iter_mode));
+      K_(is_multi_version_minor_merge), KP_(full_out_cols), KP_(full_cols_id_map), K_(need_scn), K_(iter_mode),
+      KP_(pd_storage_filters));
 
 public:
   uint64_t table_id_;
@@ -1112,6 +1113,8 @@ public:
   const share::schema::ColumnMap* full_cols_id_map_;
   bool need_scn_;
   ObIterTransNodeMode iter_mode_;
+  // white filters evaluated on micro block data, the op filters are still applied on output rows
+  sql::ObPushdownFilterExecutor* pd_storage_filters_;
 };
 
 class ObColDescArrayParam final {
@@ -1369,7 +1372,7 @@ struct ObTableAccessContext {
   TO_STRING_KV(K_(is_inited), K_(timeout), K_(pkey), K_(query_flag), K_(sql_mode), KP_(store_ctx), KP_(expr_ctx),
       KP_(limit_param), KP_(stmt_allocator), KP_(allocator), KP_(table_scan_stat),
       KP_(block_cache_ws), K_(out_cnt), K_(is_end), K_(trans_version_range), KP_(row_filter), K_(merge_log_ts),
-      K_(read_out_type), K_(lob_locator_helper));
+      K_(read_out_type), K_(lob_locator_helper), K_(enable_pd_filter));
 
 private:
   int build_lob_locator_helper(ObTableScanParam& scan_param, const common::ObVersionRange& trans_version_range);
@@ -1406,6 +1409,8 @@ public:
   int64_t merge_log_ts_;
   common::ObRowStoreType read_out_type_;
   ObLobLocatorHelper* lob_locator_helper_;
+  // pushed down filters can only be applied when the scanned rows need no fuse with other tables
+  bool enable_pd_filter_;
 };
 
 struct ObRowsInfo final {
@@ -17,6 +17,7 @@
 #include "common/object/ob_obj_compare.h"
 #include "storage/ob_multiple_merge.h"
 #include "storage/memtable/ob_memtable_context.h"
+#include "storage/memtable/ob_memtable.h"
 #include "storage/ob_store_row_filter.h"
 #include "storage/ob_partition_store.h"
 #include "storage/ob_partition_service.h"
@@ -934,6 +935,23 @@ int ObMultipleMerge::prepare_read_tables()
       }
     }
   }
+  if (OB_SUCC(ret)) {
+    // filters can only be evaluated inside the major sstable when its rows are final,
+    // i.e. there is no other table holding data to fuse with
+    bool enable_pd_filter = nullptr != access_param_->iter_param_.pd_storage_filters_ && nullptr == row_filter_;
+    int64_t major_sstable_cnt = 0;
+    for (int64_t i = 0; enable_pd_filter && i < tables_handle_.get_count(); ++i) {
+      const ObITable* table = tables_handle_.get_table(i);
+      if (OB_ISNULL(table)) {
+        enable_pd_filter = false;
+      } else if (table->is_major_sstable()) {
+        ++major_sstable_cnt;
+      } else if (!table->is_memtable() || static_cast<const memtable::ObMemtable*>(table)->not_empty()) {
+        enable_pd_filter = false;
+      }
+    }
+    access_ctx_->enable_pd_filter_ = enable_pd_filter && 1 == major_sstable_cnt;
+  }
   return ret;
 }
 
@@ -298,6 +298,9 @@ int ObPartitionService::init(const blocksstable::ObStorageEnv& env, const ObAddr
     STORAGE_LOG(WARN, "Fail to init OB_STORE_CACHE, ", K(ret), K(env.data_dir_));
   } else if (OB_FAIL(ObStoreFileSystemWrapper::init(env, *this))) {
     STORAGE_LOG(WARN, "init store file system failed.", K(ret), K(env));
+  } else if (OB_FAIL(OB_STORE_CACHE.open_micro_block_disk_cache(
+                 OB_FILE_SYSTEM.get_server_super_block().content_.create_timestamp_))) {
+    STORAGE_LOG(WARN, "fail to open micro block disk cache", K(ret));
   } else if (OB_FAIL(OB_SERVER_FILE_MGR.init())) {
     STORAGE_LOG(WARN, "fail to init server file mgr", K(ret));
   } else if (OB_FAIL(SLOGGER.register_redo_module(OB_REDO_LOG_PARTITION, this))) {
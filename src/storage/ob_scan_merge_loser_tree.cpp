@@ -20,6 +20,7 @@ void ObScanMergeLoserTreeCmp::reset()
 {
   cmp_funcs_.reset();
   rowkey_size_ = 0;
+  prefix_type_ = ObMaxType;
   error_ = OB_SUCCESS;
   reverse_ = false;
   is_inited_ = false;
@@ -71,7 +72,9 @@ int ObScanMergeLoserTreeCmp::init(const int64_t rowkey_size, const ObColDescIArr
       make_rowkey_cmp_funcs<ObRowkeyObjComparer>(rowkey_size, col_descs, allocator);
     }
     if (OB_SUCC(ret)) {
+      const ObObjType first_col_type = col_descs.at(0).col_type_.get_type();
       rowkey_size_ = rowkey_size;
+      prefix_type_ = ob_is_int_tc(first_col_type) ? first_col_type : ObMaxType;
       reverse_ = reverse;
       is_inited_ = true;
     }
@@ -107,9 +110,14 @@ int64_t ObScanMergeLoserTreeCmp::operator()(const ObScanMergeLoserTreeItem& l, c
   } else {
     cmp_result = static_cast<int32_t>(l.row_->scan_index_ - r.row_->scan_index_);
     if (0 == cmp_result) {
-      if (OB_SUCCESS != (error_ = compare_rowkey(*l.row_, *r.row_, rowkey_size_, cmp_funcs_, cmp_result))) {
+      if (ObMaxType != prefix_type_ && ObStoreRowkey::NO_NORMALIZED_VALUE != l.prefix_ &&
+          ObStoreRowkey::NO_NORMALIZED_VALUE != r.prefix_ && l.prefix_ != r.prefix_) {
+        // decided by the first rowkey column, both objs are of the signed integer type of the column
+        cmp_result = l.prefix_ < r.prefix_ ? -1 : 1;
+      } else if (OB_SUCCESS != (error_ = compare_rowkey(*l.row_, *r.row_, rowkey_size_, cmp_funcs_, cmp_result))) {
         LOG_WARN("compare rowkey error", K(error_));
-      } else if (reverse_) {
+      }
+      if (OB_SUCCESS == error_ && reverse_) {
         cmp_result = -cmp_result;
       }
     }
@@ -182,8 +190,12 @@ int ObScanMergeLoserTree::push(const ObScanMergeLoserTreeItem& player)
   } else if (has_king_ && cur_free_cnt_ <= 1) {
     ret = OB_SIZE_OVERFLOW;
     LOG_WARN("player is full", K(ret), K(player_cnt_), K(cur_free_cnt_), K(has_king_));
-  } else if (OB_FAIL(ObScanMergeLoserTreeBase::push(player))) {
-    LOG_WARN("push base tree fail", K(ret));
+  } else {
+    ObScanMergeLoserTreeItem item = player;
+    item.build_prefix(cmp_.get_prefix_type());
+    if (OB_FAIL(ObScanMergeLoserTreeBase::push(item))) {
+      LOG_WARN("push base tree fail", K(ret));
+    }
   }
   return ret;
 }
@@ -219,6 +231,8 @@ int ObScanMergeLoserTree::rebuild()
 int ObScanMergeLoserTree::push_top(const ObScanMergeLoserTreeItem& player)
 {
   int ret = OB_SUCCESS;
+  ObScanMergeLoserTreeItem item = player;
+  item.build_prefix(cmp_.get_prefix_type());
   if (!IS_INIT) {
     ret = OB_NOT_INIT;
     LOG_WARN("not init", K(ret));
@@ -232,7 +246,7 @@ int ObScanMergeLoserTree::push_top(const ObScanMergeLoserTreeItem& player)
     ret = OB_ERR_UNEXPECTED;
     LOG_WARN("tree need rebuild", K(ret), K(need_rebuild_));
   } else if (0 == ObScanMergeLoserTreeBase::count()) {
-    king_ = player;
+    king_ = item;
     has_king_ = true;
     is_king_eq_champion_ = false;
   } else {
@@ -240,29 +254,29 @@ int ObScanMergeLoserTree::push_top(const ObScanMergeLoserTreeItem& player)
     if (champion < 0 || champion > player_cnt_) {
       ret = OB_ERR_UNEXPECTED;
       LOG_WARN("invalid champion idx", K(ret), K(champion), K(player_cnt_), K(cur_free_cnt_));
-    } else if (player.iter_idx_ == players_[champion].iter_idx_) {
+    } else if (item.iter_idx_ == players_[champion].iter_idx_) {
       ret = OB_ERR_UNEXPECTED;
-      LOG_WARN("rows from same iterator", K(ret), K(player.iter_idx_), K(players_[champion].iter_idx_));
+      LOG_WARN("rows from same iterator", K(ret), K(item.iter_idx_), K(players_[champion].iter_idx_));
     }
 
     // if left only one player, we can compare them by rebuild directly without trying
     // thus can save one time compare
     if (OB_SUCC(ret) && ObScanMergeLoserTreeBase::count() > 1) {
-      const int64_t king_cmp = cmp_(players_[champion], player);
+      const int64_t king_cmp = cmp_(players_[champion], item);
       if (OB_FAIL(cmp_.get_error_code())) {
         LOG_WARN("compare champion fail",
             K(ret),
             K(players_[champion].iter_idx_),
-            K(player.iter_idx_),
+            K(item.iter_idx_),
             K(*players_[champion].row_),
-            K(*player.row_));
+            K(*item.row_));
       } else {
         if (king_cmp > 0) {
-          king_ = player;
+          king_ = item;
           has_king_ = true;
           is_king_eq_champion_ = false;
-        } else if (0 == king_cmp && player.iter_idx_ < players_[champion].iter_idx_) {
-          king_ = player;
+        } else if (0 == king_cmp && item.iter_idx_ < players_[champion].iter_idx_) {
+          king_ = item;
           has_king_ = true;
           is_king_eq_champion_ = true;
         }
@@ -270,7 +284,7 @@ int ObScanMergeLoserTree::push_top(const ObScanMergeLoserTreeItem& player)
     }
 
     if (OB_SUCC(ret) && !has_king_) {
-      if (OB_FAIL(ObScanMergeLoserTreeBase::push(player))) {
+      if (OB_FAIL(ObScanMergeLoserTreeBase::push(item))) {
         LOG_WARN("push player fail", K(ret));
       } else if (OB_FAIL(ObScanMergeLoserTreeBase::rebuild())) {
         LOG_WARN("build base tree fail", K(ret));
@@ -23,7 +23,11 @@ struct ObScanMergeLoserTreeItem {
   const ObStoreRow* row_;
   int64_t iter_idx_;
   uint8_t iter_flag_;
-  ObScanMergeLoserTreeItem() : row_(NULL), iter_idx_(0), iter_flag_(0)
+  // normalized first rowkey column of row_, set when pushed into the tree, see
+  // ObStoreRowkey::get_normalized_value and ObScanMergeLoserTreeCmp::get_prefix_type
+  uint64_t prefix_;
+  ObScanMergeLoserTreeItem()
+      : row_(NULL), iter_idx_(0), iter_flag_(0), prefix_(common::ObStoreRowkey::NO_NORMALIZED_VALUE)
   {}
   ~ObScanMergeLoserTreeItem() = default;
   void reset()
@@ -31,15 +35,29 @@ struct ObScanMergeLoserTreeItem {
     row_ = NULL;
     iter_idx_ = 0;
     iter_flag_ = 0;
+    prefix_ = common::ObStoreRowkey::NO_NORMALIZED_VALUE;
   }
-  TO_STRING_KV(K_(iter_idx), K_(iter_flag), KPC(row_));
+  // only a first rowkey column of %prefix_type is normalized
+  OB_INLINE void build_prefix(const common::ObObjType prefix_type)
+  {
+    prefix_ = (NULL != row_ && row_->row_val_.count_ > 0 && NULL != row_->row_val_.cells_ &&
+                  prefix_type == row_->row_val_.cells_[0].get_type())
+                  ? common::ObStoreRowkey::get_normalized_value(row_->row_val_.cells_[0])
+                  : common::ObStoreRowkey::NO_NORMALIZED_VALUE;
+  }
+  TO_STRING_KV(K_(iter_idx), K_(iter_flag), K_(prefix), KPC(row_));
 };
 
 class ObScanMergeLoserTreeCmp {
 public:
   typedef common::ObFixedArray<ObRowkeyObjComparer*, common::ObIAllocator> RowkeyCmpFuncArray;
   ObScanMergeLoserTreeCmp()
-      : cmp_funcs_(), rowkey_size_(0), error_(common::OB_SUCCESS), reverse_(false), is_inited_(false)
+      : cmp_funcs_(),
+        rowkey_size_(0),
+        prefix_type_(common::ObMaxType),
+        error_(common::OB_SUCCESS),
+        reverse_(false),
+        is_inited_(false)
   {}
   ~ObScanMergeLoserTreeCmp() = default;
   void reset();
@@ -50,6 +68,12 @@ public:
   {
     return error_;
   }
+  // Rows are compared by the prefixes of their items only if the first rowkey column is a signed integer
+  // column and the objs are of its type, ObMaxType otherwise.
+  OB_INLINE common::ObObjType get_prefix_type() const
+  {
+    return prefix_type_;
+  }
   static int compare_rowkey(const ObStoreRow& l_row, const ObStoreRow& r_row, const int64_t& rowkey_size,
       RowkeyCmpFuncArray& cmp_funcs, int32_t& cmp_result);
 
@@ -59,6 +83,7 @@ private:
 
   RowkeyCmpFuncArray cmp_funcs_;
   int64_t rowkey_size_;
+  common::ObObjType prefix_type_;
   int error_;
   bool reverse_;
   bool is_inited_;
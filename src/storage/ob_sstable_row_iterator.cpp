@@ -158,6 +158,13 @@ int ObSSTableMicroBlockInfoIterator::open(ObSSTableRowIterator* iter, ObSSTableR
       if (OB_BEYOND_THE_RANGE != ret) {
         STORAGE_LOG(WARN, "Fail to search blocks, ", K(ret), K(read_handle));
       }
+    } else if (NULL != iter->get_skip_index_filter()) {
+      if (OB_FAIL(filter_micro_blocks(*handle, *iter->get_skip_index_filter()))) {
+        STORAGE_LOG(WARN, "Fail to filter micro blocks by skip index, ", K(ret), K(read_handle));
+      } else if (micro_block_infos_.empty()) {
+        // no row of the macro block can satisfy the filters
+        ret = OB_BEYOND_THE_RANGE;
+      }
     }
   }
 
@@ -180,6 +187,41 @@ int ObSSTableMicroBlockInfoIterator::open(ObSSTableRowIterator* iter, ObSSTableR
   return ret;
 }
 
+int ObSSTableMicroBlockInfoIterator::filter_micro_blocks(
+    ObMicroBlockIndexHandle& handle, sql::ObPushdownFilterExecutor& filter)
+{
+  int ret = OB_SUCCESS;
+  const ObMicroBlockIndexMgr* index_mgr = NULL;
+  ObMicroBlockSkipIndex skip_index;
+  if (OB_FAIL(handle.get_block_index_mgr(index_mgr))) {
+    STORAGE_LOG(WARN, "Fail to get block index mgr, ", K(ret));
+  } else if (OB_ISNULL(index_mgr)) {
+    ret = OB_ERR_UNEXPECTED;
+    STORAGE_LOG(WARN, "Unexpected null block index mgr, ", K(ret));
+  } else if (!index_mgr->has_skip_index()) {
+    // macro block written without skip index
+  } else if (OB_FAIL(index_mgr->get_skip_index(skip_index))) {
+    STORAGE_LOG(WARN, "Fail to get skip index, ", K(ret));
+  } else {
+    int64_t keep_cnt = 0;
+    bool can_skip = false;
+    for (int64_t i = 0; OB_SUCC(ret) && i < micro_block_infos_.count(); ++i) {
+      if (OB_FAIL(skip_index.check_skip(micro_block_infos_.at(i).index_, filter, can_skip))) {
+        STORAGE_LOG(WARN, "Fail to check skip index, ", K(ret), K(i), K(micro_block_infos_.at(i)));
+      } else if (!can_skip) {
+        if (keep_cnt != i) {
+          micro_block_infos_.at(keep_cnt) = micro_block_infos_.at(i);
+        }
+        ++keep_cnt;
+      }
+    }
+    while (OB_SUCC(ret) && micro_block_infos_.count() > keep_cnt) {
+      micro_block_infos_.pop_back();
+    }
+  }
+  return ret;
+}
+
 int ObSSTableMicroBlockInfoIterator::get_next_micro(ObSSTableMicroBlockInfo& sstable_micro)
 {
   int ret = OB_SUCCESS;
@@ -428,7 +470,10 @@ ObSSTableRowIterator::ObSSTableRowIterator()
       io_micro_infos_(),
       micro_info_iter_(),
       prefetch_handle_depth_(DEFAULT_PREFETCH_HANDLE_DEPTH),
-      prefetch_micro_depth_(DEFAULT_PREFETCH_MICRO_DEPTH)
+      prefetch_micro_depth_(DEFAULT_PREFETCH_MICRO_DEPTH),
+      last_get_macro_id_(),
+      last_get_micro_offset_(-1),
+      last_get_block_buf_(NULL)
 {}
 
 ObSSTableRowIterator::~ObSSTableRowIterator()
@@ -489,6 +534,10 @@ int ObSSTableRowIterator::inner_open(
     micro_info_iter_.set_reverse(access_ctx_->query_flag_.is_reverse_scan());
     table_store_stat_.pkey_ = access_ctx_->pkey_;
     block_cache_ = &(ObStorageCacheSuite::get_instance().get_block_cache());
+    if (is_batch_prefetch()) {
+      prefetch_handle_depth_ = read_handle_cnt_;
+      prefetch_micro_depth_ = micro_handle_cnt_;
+    }
     if (OB_FAIL(ret)) {
     } else if (OB_ISNULL(storage_file_ = sstable_->get_storage_file_handle().get_storage_file())) {
       ret = OB_ERR_UNEXPECTED;
@@ -638,6 +687,9 @@ void ObSSTableRowIterator::reset()
   storage_file_ = nullptr;
   prefetch_handle_depth_ = DEFAULT_PREFETCH_HANDLE_DEPTH;
   prefetch_micro_depth_ = DEFAULT_PREFETCH_MICRO_DEPTH;
+  last_get_macro_id_.reset();
+  last_get_micro_offset_ = -1;
+  last_get_block_buf_ = NULL;
 }
 
 void ObSSTableRowIterator::reuse()
@@ -671,6 +723,9 @@ void ObSSTableRowIterator::reuse()
   storage_file_ = nullptr;
   prefetch_handle_depth_ = DEFAULT_PREFETCH_HANDLE_DEPTH;
   prefetch_micro_depth_ = DEFAULT_PREFETCH_MICRO_DEPTH;
+  last_get_macro_id_.reset();
+  last_get_micro_offset_ = -1;
+  last_get_block_buf_ = NULL;
 }
 
 int ObSSTableRowIterator::get_read_handle(const ObExtStoreRowkey& ext_rowkey, ObSSTableReadHandle& read_handle)
@@ -984,7 +1039,8 @@ int ObSSTableRowIterator::prefetch_block(const int64_t sstable_micro_cnt)
     prev_offset = 0;
     read_size = 0;
     last_macro_ctx.reset();
-    MicroInfoArray& sstable_micro_infos = use_multiblock_io ? sorted_sstable_micro_infos_ : sstable_micro_infos_;
+    MicroInfoArray& sstable_micro_infos =
+        (use_multiblock_io || is_batch_prefetch()) ? sorted_sstable_micro_infos_ : sstable_micro_infos_;
 
     for (int64_t i = 0; OB_SUCC(ret) && i < sstable_micro_cnt; ++i) {
       const ObSSTableMicroBlockInfo& sstable_micro = sstable_micro_infos[i];
@@ -1009,7 +1065,9 @@ int ObSSTableRowIterator::prefetch_block(const int64_t sstable_micro_cnt)
               K(sstable_micro.micro_info_));
           if (last_macro_ctx.get_macro_block_id() == sstable_micro.macro_ctx_.get_macro_block_id()) {
             // same macro block
-            if (sstable_micro.micro_info_.offset_ >= prev_offset) {
+            if (sstable_micro.micro_info_.offset_ == io_micro_infos_.at(io_param.block_count_ - 1).offset_) {
+              // same micro block as the last one to read, shares its io, see submit_block_io
+            } else if (sstable_micro.micro_info_.offset_ >= prev_offset) {
               // different micro block
               gap_size += sstable_micro.micro_info_.offset_ - prev_offset;
               read_size += sstable_micro.micro_info_.size_ + (sstable_micro.micro_info_.offset_ - prev_offset);
@@ -1300,15 +1358,28 @@ int ObSSTableRowIterator::get_block_row(ObSSTableReadHandle& read_handle, const
   bool found = false;
   int64_t row_cache_put_cnt = access_ctx_->access_stat_.row_cache_put_cnt_;
   for (int64_t i = read_handle.micro_begin_idx_; OB_SUCC(ret) && !found && i <= read_handle.micro_end_idx_; ++i) {
+    bool is_same_block = false;
     if (OB_FAIL(get_block_data(i, block_data))) {
       STORAGE_LOG(WARN, "Fail to get block data, ", K(ret), K(read_handle));
+    } else {
+      // keys of a multi get in one micro block are read one after another from the same buffer
+      const ObMicroBlockDataHandle& micro_handle = micro_handles_[i % micro_handle_cnt_];
+      is_same_block = last_get_block_buf_ == block_data.get_buf() &&
+                      last_get_micro_offset_ == micro_handle.micro_info_.offset_ &&
+                      last_get_macro_id_ == read_handle.get_macro_block_id();
+      last_get_macro_id_ = read_handle.get_macro_block_id();
+      last_get_micro_offset_ = micro_handle.micro_info_.offset_;
+      last_get_block_buf_ = block_data.get_buf();
+    }
+    if (OB_FAIL(ret)) {
     } else if (OB_FAIL(micro_getter_->get_row(read_handle.ext_rowkey_->get_store_rowkey(),
                    read_handle.get_macro_block_id(),
                    storage_file_->get_file_id(),
                    read_handle.full_meta_,
                    block_data,
                    read_handle.rowkey_helper_,
-                   store_row))) {
+                   store_row,
+                   is_same_block))) {
       if (OB_ITER_END == ret) {
         ret = OB_SUCCESS;
       } else {
@@ -1677,6 +1748,17 @@ const ObIArray<ObRowkeyObjComparer*>* ObSSTableRowIterator::get_rowkey_cmp_funcs
   return cmp_funcs;
 }
 
+sql::ObPushdownFilterExecutor* ObSSTableRowIterator::get_skip_index_filter()
+{
+  sql::ObPushdownFilterExecutor* filter = nullptr;
+  if (OB_NOT_NULL(iter_param_) && OB_NOT_NULL(access_ctx_) && OB_NOT_NULL(sstable_) &&
+      access_ctx_->enable_pd_filter_ && sstable_->is_major_sstable() &&
+      !access_ctx_->query_flag_.is_multi_version_minor_merge()) {
+    filter = iter_param_->pd_storage_filters_;
+  }
+  return filter;
+}
+
 int ObSSTableRowIterator::init_handle_mgr(
     const ObTableIterParam& iter_param, ObTableAccessContext& access_ctx, const void* query_range)
 {
@@ -143,6 +143,7 @@ private:
   {
     return !is_get_ ? micro_block_infos_.at(idx) : micro_info_;
   }
+  int filter_micro_blocks(ObMicroBlockIndexHandle& handle, sql::ObPushdownFilterExecutor& filter);
 
 private:
   bool is_reverse_;
@@ -327,6 +328,8 @@ public:
   virtual int get_gap_end(int64_t& range_idx, const common::ObStoreRowkey*& gap_key, int64_t& gap_size) override;
   virtual int report_stat() override;
   virtual const common::ObIArray<ObRowkeyObjComparer*>* get_rowkey_cmp_funcs();
+  // storage filters which can prune micro blocks by the skip index, NULL if they can not be applied
+  sql::ObPushdownFilterExecutor* get_skip_index_filter();
   int get_cur_micro_row_count(int64_t& row_count);
   int get_cur_read_handle(ObSSTableReadHandle*& read_handle);
   int get_cur_micro_idx_in_macro(int64_t& micro_idx);
@@ -344,6 +347,12 @@ protected:
   virtual int prefetch_read_handle(ObSSTableReadHandle& read_handle) = 0;
   virtual int fetch_row(ObSSTableReadHandle& read_handle, const ObStoreRow*& store_row) = 0;
   virtual int get_range_count(const void* query_range, int64_t& range_count) const = 0;
+  // All ranges are known when opened, prefetch a full window at once and read the micro blocks of a
+  // prefetch in (macro block, offset) order.
+  virtual bool is_batch_prefetch() const
+  {
+    return false;
+  }
   int get_read_handle(const common::ObExtStoreRowkey& ext_rowkey, ObSSTableReadHandle& read_handle);
   int get_row(ObSSTableReadHandle& read_handle, const ObStoreRow*& store_row);
   int exist_row(ObSSTableReadHandle& read_handle, ObStoreRow& store_row);
@@ -423,6 +432,10 @@ private:
   ObSSTableMicroBlockInfoIterator micro_info_iter_;
   int64_t prefetch_handle_depth_;
   int64_t prefetch_micro_depth_;
+  // micro block last read by micro_getter_, which keeps it decoded for the next key in it
+  blocksstable::MacroBlockId last_get_macro_id_;
+  int64_t last_get_micro_offset_;
+  const char* last_get_block_buf_;
 };
 
 }  // namespace storage
@@ -30,6 +30,10 @@ protected:
   virtual int get_handle_cnt(const void* query_range, int64_t& read_handle_cnt, int64_t& micro_handle_cnt) override;
   virtual int prefetch_read_handle(ObSSTableReadHandle& read_handle) override;
   virtual int get_range_count(const void* query_range, int64_t& range_count) const override;
+  virtual bool is_batch_prefetch() const override
+  {
+    return true;
+  }
   virtual int get_skip_range_ctx(
       ObSSTableReadHandle& read_handle, const int64_t cur_micro_idx, ObSSTableSkipRangeCtx*& ctx) override;
 
@@ -22,6 +22,7 @@
 #include "share/allocator/ob_memstore_allocator_mgr.h"
 #include "storage/ob_pg_storage.h"
 #include "storage/ob_replay_status.h"
+#include "storage/memtable/ob_replay_row_prefetcher.h"
 #include "storage/transaction/ob_trans_service.h"
 #include "share/ob_multi_cluster_util.h"
 #include "clog/ob_partition_log_service.h"
@@ -79,6 +80,8 @@ int ObLogReplayEngine::init(
     REPLAY_LOG(WARN, "ObSimpleThreadPool init error", K(ret));
   } else if (OB_FAIL(TG_SET_ADAPTIVE_STRATEGY(tg_id_, adaptive_strategy))) {
     REPLAY_LOG(WARN, "set adaptive strategy failed", K(ret));
+  } else if (OB_FAIL(memtable::ObReplayRowPrefetcher::get_instance().init())) {
+    REPLAY_LOG(WARN, "replay row prefetcher init failed", K(ret));
   } else {
     trans_replay_service_ = trans_replay_service;
     partition_service_ = partition_service;
@@ -106,6 +109,7 @@ void ObLogReplayEngine::destroy()
     TG_WAIT(tg_id_);
     tg_id_ = -1;
   }
+  memtable::ObReplayRowPrefetcher::get_instance().destroy();
   total_task_num_ = 0;
   trans_replay_service_ = NULL;
   partition_service_ = NULL;
@@ -775,6 +779,8 @@ void ObLogReplayEngine::wait()
   TG_STOP(tg_id_);
   TG_WAIT(tg_id_);
   REPLAY_LOG(INFO, "Replay Engine SimpleQueue destroy finish");
+  memtable::ObReplayRowPrefetcher::get_instance().stop();
+  memtable::ObReplayRowPrefetcher::get_instance().wait();
   REPLAY_LOG(INFO, "Replay Engine wait finish");
   return;
 }
@@ -19,6 +19,8 @@
 #include "lib/utility/ob_tracepoint.h"
 #include "ob_trans_part_ctx.h"
 #include "ob_location_adapter.h"
+#include "lib/container/ob_array_wrap.h"
+#include "share/config/ob_server_config.h"
 
 namespace oceanbase {
 using namespace common;
@@ -37,6 +39,23 @@ void ObGtsStatistics::reset()
   try_get_gts_with_stc_cnt_ = 0;
   wait_gts_elapse_cnt_ = 0;
   try_wait_gts_elapse_cnt_ = 0;
+  deferred_gts_rpc_cnt_ = 0;
+  MEMSET(get_gts_wait_hist_, 0, sizeof(get_gts_wait_hist_));
+  MEMSET(wait_gts_elapse_hist_, 0, sizeof(wait_gts_elapse_hist_));
+}
+
+const int64_t ObGtsSource::MAX_QUERY_DEFER_US = obrpc::ObGtsRpcResult::OB_GTS_RPC_TIMEOUT;
+
+const int64_t ObGtsStatistics::WAIT_HIST_BOUNDS_US[WAIT_HIST_BUCKET_CNT - 1] = {
+    100, 200, 500, 1000, 2000, 5000, 10000, 100000, 1000000};
+
+int64_t ObGtsStatistics::get_wait_hist_bucket_(const int64_t wait_us)
+{
+  int64_t bucket = 0;
+  while (bucket < WAIT_HIST_BUCKET_CNT - 1 && wait_us >= WAIT_HIST_BOUNDS_US[bucket]) {
+    ++bucket;
+  }
+  return bucket;
 }
 
 int ObGtsStatistics::init(const uint64_t tenant_id)
@@ -71,7 +90,15 @@ void ObGtsStatistics::statistics()
           "wait_gts_elapse_cnt",
           ATOMIC_LOAD(&wait_gts_elapse_cnt_),
           "try_wait_gts_elapse_cnt",
-          ATOMIC_LOAD(&try_wait_gts_elapse_cnt_));
+          ATOMIC_LOAD(&try_wait_gts_elapse_cnt_),
+          "deferred_gts_rpc_cnt",
+          ATOMIC_LOAD(&deferred_gts_rpc_cnt_),
+          "wait_hist_bounds_us",
+          ObArrayWrap<int64_t>(WAIT_HIST_BOUNDS_US, WAIT_HIST_BUCKET_CNT - 1),
+          "get_gts_wait_hist",
+          ObArrayWrap<int64_t>(get_gts_wait_hist_, WAIT_HIST_BUCKET_CNT),
+          "wait_gts_elapse_hist",
+          ObArrayWrap<int64_t>(wait_gts_elapse_hist_, WAIT_HIST_BUCKET_CNT));
       ATOMIC_STORE(&gts_rpc_cnt_, 0);
       ATOMIC_STORE(&get_gts_cache_cnt_, 0);
       ATOMIC_STORE(&get_gts_with_stc_cnt_, 0);
@@ -79,6 +106,11 @@ void ObGtsStatistics::statistics()
       ATOMIC_STORE(&try_get_gts_with_stc_cnt_, 0);
       ATOMIC_STORE(&wait_gts_elapse_cnt_, 0);
       ATOMIC_STORE(&try_wait_gts_elapse_cnt_, 0);
+      ATOMIC_STORE(&deferred_gts_rpc_cnt_, 0);
+      for (int64_t i = 0; i < WAIT_HIST_BUCKET_CNT; ++i) {
+        ATOMIC_STORE(&get_gts_wait_hist_[i], 0);
+        ATOMIC_STORE(&wait_gts_elapse_hist_[i], 0);
+      }
     }
   }
 }
@@ -92,6 +124,7 @@ void ObGtsSource::reset()
   gts_local_cache_.reset();
   server_.reset();
   gts_request_rpc_ = NULL;
+  has_deferred_query_ = false;
   location_adapter_ = NULL;
   for (int64_t i = 0; i < TOTAL_GTS_QUEUE_COUNT; ++i) {
     queue_[i].reset();
@@ -115,11 +148,11 @@ int ObGtsSource::init(const uint64_t tenant_id, const ObAddr& server, ObIGtsRequ
   } else {
     for (int64_t i = 0; OB_SUCCESS == ret && i < TOTAL_GTS_QUEUE_COUNT; ++i) {
       if (i < GET_GTS_QUEUE_COUNT) {
-        if (OB_FAIL(queue_[i].init(GET_GTS))) {
+        if (OB_FAIL(queue_[i].init(GET_GTS, &gts_statistics_))) {
           TRANS_LOG(WARN, "gts queue init error", KR(ret));
         }
       } else if (i < GET_GTS_QUEUE_COUNT + WAIT_GTS_QUEUE_COUNT) {
-        if (OB_FAIL(queue_[i].init(WAIT_GTS_ELAPSING))) {
+        if (OB_FAIL(queue_[i].init(WAIT_GTS_ELAPSING, &gts_statistics_))) {
           TRANS_LOG(WARN, "wait gts elapsing queue init error", KR(ret));
         }
       } else {
@@ -249,7 +282,7 @@ int ObGtsSource::get_gts(const MonotonicTs stc, ObTsCbTask* task, int64_t& gts,
       }
     } else {
       // If not in local, refresh gts
-      if (need_send_rpc) {
+      if (need_send_rpc && !defer_query_gts_()) {
         if (OB_SUCCESS != (tmp_ret = query_gts_(leader))) {
           TRANS_LOG(WARN, "query gts fail", K(tmp_ret), K(leader));
         }
@@ -358,7 +391,7 @@ int ObGtsSource::get_local_trans_version(
       }
     } else {
       // If not in local, refresh gts
-      if (need_send_rpc) {
+      if (need_send_rpc && !defer_query_gts_()) {
         if (OB_SUCCESS != (tmp_ret = query_gts_(leader))) {
           TRANS_LOG(WARN, "query gts fail", K(tmp_ret), K(leader));
         }
@@ -763,6 +796,50 @@ int ObGtsSource::query_gts_(const ObAddr& leader)
   return ret;
 }
 
+bool ObGtsSource::is_query_gts_lost_()
+{
+  const int64_t latest_srr = gts_local_cache_.get_latest_srr().mts_;
+  return gts_local_cache_.get_srr().mts_ < latest_srr &&
+         MonotonicTs::current_time().mts_ - latest_srr >= MAX_QUERY_DEFER_US;
+}
+
+// In batching mode a tenant keeps at most one gts request in flight. A waiter which needs a newer request than
+// the outstanding one marks it instead of sending, and the request is sent by update_gts once the outstanding one
+// returns, so all the waiters arrived meanwhile share it. An outstanding request not returned in
+// MAX_QUERY_DEFER_US is taken as lost: the next waiter sends again, and the deferred request is sent when the
+// rpc times out, see refresh_gts_location.
+bool ObGtsSource::defer_query_gts_()
+{
+  bool bool_ret = false;
+  if (GCONF._enable_gts_request_batching) {
+    const int64_t latest_srr = gts_local_cache_.get_latest_srr().mts_;
+    if (gts_local_cache_.get_srr().mts_ < latest_srr &&
+        MonotonicTs::current_time().mts_ - latest_srr < MAX_QUERY_DEFER_US) {
+      ATOMIC_STORE(&has_deferred_query_, true);
+      // the outstanding request may return before the mark is seen, then the mark is taken back here
+      bool_ret = !(gts_local_cache_.get_srr().mts_ >= latest_srr && ATOMIC_BCAS(&has_deferred_query_, true, false));
+      if (bool_ret) {
+        gts_statistics_.inc_deferred_gts_rpc_cnt();
+      }
+    }
+  }
+  return bool_ret;
+}
+
+int ObGtsSource::refresh_gts_location()
+{
+  int ret = refresh_gts_location_();
+  // the outstanding request is lost, send the deferred one instead of leaving its waiters to the periodic refresh
+  if (ATOMIC_LOAD(&has_deferred_query_) && is_query_gts_lost_() && ATOMIC_BCAS(&has_deferred_query_, true, false)) {
+    int tmp_ret = OB_SUCCESS;
+    const bool need_refresh_gts_location = false;
+    if (OB_SUCCESS != (tmp_ret = refresh_gts_(need_refresh_gts_location))) {
+      TRANS_LOG(WARN, "resend deferred gts request failed", K(tmp_ret), K_(tenant_id));
+    }
+  }
+  return ret;
+}
+
 int ObGtsSource::refresh_gts_location_()
 {
   int ret = OB_SUCCESS;
@@ -816,6 +893,14 @@ int ObGtsSource::update_gts(const MonotonicTs srr, const int64_t gts, const Mono
   } else {
     //(void)verify_publish_version_(gts);
     TRANS_LOG(DEBUG, "gts local cache update success", K(srr), K(gts));
+    // send the request deferred while this one was outstanding
+    if (ATOMIC_LOAD(&has_deferred_query_) && ATOMIC_BCAS(&has_deferred_query_, true, false)) {
+      int tmp_ret = OB_SUCCESS;
+      const bool need_refresh_gts_location = false;
+      if (OB_SUCCESS != (tmp_ret = refresh_gts_(need_refresh_gts_location))) {
+        TRANS_LOG(WARN, "send deferred gts request failed", K(tmp_ret), K_(tenant_id));
+      }
+    }
   }
 
   return ret;
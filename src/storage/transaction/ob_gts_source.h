@@ -74,8 +74,29 @@ public:
   {
     ATOMIC_INC(&try_wait_gts_elapse_cnt_);
   }
+  void inc_deferred_gts_rpc_cnt()
+  {
+    ATOMIC_INC(&deferred_gts_rpc_cnt_);
+  }
+  // time a queued task waited for gts, from being queued to its callback
+  void add_get_gts_wait_time(const int64_t wait_us)
+  {
+    ATOMIC_INC(&get_gts_wait_hist_[get_wait_hist_bucket_(wait_us)]);
+  }
+  void add_wait_gts_elapse_time(const int64_t wait_us)
+  {
+    ATOMIC_INC(&wait_gts_elapse_hist_[get_wait_hist_bucket_(wait_us)]);
+  }
   void statistics();
 
+public:
+  // upper bounds of the wait time histogram buckets, the last bucket has no bound
+  static const int64_t WAIT_HIST_BUCKET_CNT = 10;
+  static const int64_t WAIT_HIST_BOUNDS_US[WAIT_HIST_BUCKET_CNT - 1];
+
+private:
+  static int64_t get_wait_hist_bucket_(const int64_t wait_us);
+
 private:
   uint64_t tenant_id_;
   int64_t last_stat_ts_;
@@ -88,6 +109,10 @@ private:
 
   int64_t wait_gts_elapse_cnt_;
   int64_t try_wait_gts_elapse_cnt_;
+  int64_t deferred_gts_rpc_cnt_;
+
+  int64_t get_gts_wait_hist_[WAIT_HIST_BUCKET_CNT];
+  int64_t wait_gts_elapse_hist_[WAIT_HIST_BUCKET_CNT];
 };
 
 class ObGtsSource : public ObITsSource {
@@ -134,10 +159,8 @@ public:
   }
   int update_publish_version(const int64_t publish_version);
   int get_publish_version(int64_t& publish_version);
-  int refresh_gts_location()
-  {
-    return refresh_gts_location_();
-  }
+  // called when a gts rpc times out or fails
+  int refresh_gts_location();
   TO_STRING_KV(K_(tenant_id), K_(gts_pkey), K_(gts_local_cache), K_(server));
 
 private:
@@ -146,6 +169,8 @@ private:
   int refresh_gts_location_();
   int refresh_gts_(const bool need_refresh);
   int query_gts_(const common::ObAddr& leader);
+  bool is_query_gts_lost_();
+  bool defer_query_gts_();
   void statistics_();
   int get_gts_from_local_timestamp_service_(common::ObAddr& leader, int64_t& gts, MonotonicTs& receive_gts_ts);
   int get_gts_from_local_timestamp_service_(common::ObAddr& leader, int64_t& gts);
@@ -156,6 +181,8 @@ public:
   static const int64_t WAIT_GTS_QUEUE_COUNT = 1;
   static const int64_t WAIT_GTS_QUEUE_START_INDEX = GET_GTS_QUEUE_COUNT;
   static const int64_t TOTAL_GTS_QUEUE_COUNT = GET_GTS_QUEUE_COUNT + WAIT_GTS_QUEUE_COUNT;
+  // an outstanding gts request not returned within the gts rpc timeout is taken as lost
+  static const int64_t MAX_QUERY_DEFER_US;
 
 private:
   bool is_inited_;
@@ -171,6 +198,8 @@ private:
   ObGtsStatistics gts_statistics_;
   common::ObTimeInterval log_interval_;
   common::ObAddr gts_cache_leader_;
+  // a gts request is waited to be sent once the outstanding one returns
+  bool has_deferred_query_;
 };
 
 }  // namespace transaction
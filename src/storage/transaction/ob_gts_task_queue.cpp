@@ -12,6 +12,7 @@
 
 #include "ob_gts_local_cache.h"
 #include "ob_gts_task_queue.h"
+#include "ob_gts_source.h"
 #include "ob_ts_mgr.h"
 #include "ob_trans_event.h"
 
@@ -21,7 +22,7 @@ using namespace common;
 
 namespace transaction {
 
-int ObGTSTaskQueue::init(const ObGTSCacheTaskType& type)
+int ObGTSTaskQueue::init(const ObGTSCacheTaskType& type, ObGtsStatistics* gts_statistics)
 {
   int ret = OB_SUCCESS;
   if (is_inited_) {
@@ -32,6 +33,7 @@ int ObGTSTaskQueue::init(const ObGTSCacheTaskType& type)
     TRANS_LOG(WARN, "invalid gts task type", KR(ret), K(type));
   } else {
     task_type_ = type;
+    gts_statistics_ = gts_statistics;
     is_inited_ = true;
     TRANS_LOG(INFO, "gts task queue init success", KP(this), K(type));
   }
@@ -49,6 +51,7 @@ void ObGTSTaskQueue::reset()
 {
   is_inited_ = false;
   task_type_ = INVALID_GTS_TASK_TYPE;
+  gts_statistics_ = NULL;
 }
 
 int ObGTSTaskQueue::foreach_task(
@@ -104,10 +107,16 @@ int ObGTSTaskQueue::foreach_task(
             const int64_t total_used = ObTimeUtility::current_time() - request_ts;
             ObTransStatistic::get_instance().add_gts_acquire_total_time(tenant_id, total_used);
             ObTransStatistic::get_instance().add_gts_acquire_total_wait_count(tenant_id, 1);
+            if (NULL != gts_statistics_) {
+              gts_statistics_->add_get_gts_wait_time(total_used);
+            }
           } else if (WAIT_GTS_ELAPSING == task_type_) {
             const int64_t total_used = ObTimeUtility::current_time() - request_ts;
             ObTransStatistic::get_instance().add_gts_wait_elapse_total_time(tenant_id, total_used);
             ObTransStatistic::get_instance().add_gts_wait_elapse_total_wait_count(tenant_id, 1);
+            if (NULL != gts_statistics_) {
+              gts_statistics_->add_wait_gts_elapse_time(total_used);
+            }
           } else {
             // do nothing
           }
@@ -22,16 +22,18 @@
 namespace oceanbase {
 namespace transaction {
 class ObTsCbTask;
+class ObGtsStatistics;
 
 class ObGTSTaskQueue {
 public:
-  ObGTSTaskQueue() : is_inited_(false), task_type_(INVALID_GTS_TASK_TYPE)
+  ObGTSTaskQueue() : is_inited_(false), task_type_(INVALID_GTS_TASK_TYPE), gts_statistics_(NULL)
   {}
   ~ObGTSTaskQueue()
   {
     destroy();
   }
-  int init(const ObGTSCacheTaskType& type);
+  // wait time of the tasks is added to %gts_statistics if not NULL
+  int init(const ObGTSCacheTaskType& type, ObGtsStatistics* gts_statistics = NULL);
   void destroy();
   void reset();
   int foreach_task(
@@ -48,6 +50,7 @@ private:
 private:
   bool is_inited_;
   ObGTSCacheTaskType task_type_;
+  ObGtsStatistics* gts_statistics_;
   common::ObLinkQueue queue_;
 };
 
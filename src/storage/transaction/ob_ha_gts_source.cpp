@@ -53,11 +53,11 @@ int ObHaGtsSource::init(const uint64_t tenant_id, const ObAddr& server, ObILocat
   } else {
     for (int64_t i = 0; OB_SUCCESS == ret && i < TOTAL_GTS_QUEUE_COUNT; ++i) {
       if (i < GET_GTS_QUEUE_COUNT) {
-        if (OB_FAIL(queue_[i].init(GET_GTS))) {
+        if (OB_FAIL(queue_[i].init(GET_GTS, &gts_statistics_))) {
           TRANS_LOG(WARN, "gts queue init error", KR(ret));
         }
       } else if (i < GET_GTS_QUEUE_COUNT + WAIT_GTS_QUEUE_COUNT) {
-        if (OB_FAIL(queue_[i].init(WAIT_GTS_ELAPSING))) {
+        if (OB_FAIL(queue_[i].init(WAIT_GTS_ELAPSING, &gts_statistics_))) {
           TRANS_LOG(WARN, "wait gts elapsing queue init error", KR(ret));
         }
       } else {
@@ -39,6 +39,7 @@
 #include "sql/session/ob_basic_session_info.h"
 #include "ob_weak_read_util.h"  // ObWeakReadUtil
 #include "storage/memtable/ob_memtable_context.h"
+#include "storage/memtable/ob_lock_wait_mgr.h"
 #include "ob_trans_msg2.h"
 
 namespace oceanbase {
@@ -439,7 +440,10 @@ int ObTransService::start_trans(const uint64_t tenant_id, const uint64_t cluster
       if (OB_LIKELY(tenant_config.is_valid())) {
         const int64_t max_dependent_trans_count = GCONF._max_elr_dependent_trx_count;
         if (!trans_desc.is_readonly() && max_dependent_trans_count > 0 && OB_SYS_TENANT_ID != tenant_id) {
-          enable_elr = tenant_config->enable_early_lock_release;
+          // the hotspot switch only narrows early lock release to tenants with hot rows
+          enable_elr = tenant_config->enable_early_lock_release &&
+                       (!tenant_config->_enable_hotspot_early_lock_release ||
+                           get_global_lock_wait_mgr().is_hotspot_tenant(tenant_id));
         }
         // need_record_rollback_trans_log = tenant_config->_enable_record_rollback_trans_log;
       }
@@ -389,6 +389,51 @@ TEST_F(TestCLogWriter, border)
   log_cache.destroy();
 }
 
+TEST_F(TestCLogWriter, group_commit)
+{
+  int ret = OB_SUCCESS;
+  file_id_t file_id = 1;
+  offset_t offset = 0;
+  const int64_t item_cnt = 32;
+  const int64_t item_buf_size = 64 * 1024;
+  MyCLogItem log_items[item_cnt];
+  ObLogBlockMetaV2 block;
+  const int64_t block_meta_size = block.get_serialize_size();
+
+  // group size exceeds limit
+  ObCLogWriterCfg log_cfg = clog_cfg_;
+  log_cfg.base_cfg_.group_commit_max_item_cnt_ = ObCLogWriter::MAX_GROUP_COMMIT_ITEM_CNT + 1;
+  clog_writer_.destroy();
+  ret = clog_writer_.init(log_cfg);
+  ASSERT_NE(OB_SUCCESS, ret);
+
+  log_cfg.base_cfg_.group_commit_max_item_cnt_ = ObCLogWriter::MAX_GROUP_COMMIT_ITEM_CNT;
+  ret = clog_writer_.init(log_cfg);
+  ASSERT_EQ(OB_SUCCESS, ret);
+  ret = clog_writer_.start(file_id, offset);
+  ASSERT_EQ(OB_SUCCESS, ret);
+
+  // items queued together are flushed together, and written contiguously in append order
+  for (int64_t i = 0; i < item_cnt; ++i) {
+    log_items[i].buf_ = log_buf_ + i * item_buf_size + block_meta_size;
+    log_items[i].data_len_ = ObRandom::rand(1, item_buf_size - block_meta_size);
+    memset(log_items[i].buf_, (uint8_t)ObRandom::rand(100, 132), log_items[i].data_len_);
+    ret = clog_writer_.append_log(log_items[i]);
+    ASSERT_EQ(OB_SUCCESS, ret);
+  }
+  for (int64_t i = 0; i < item_cnt; ++i) {
+    log_items[i].wait();
+    ASSERT_EQ(OB_SUCCESS, log_items[i].err_code_);
+    ASSERT_EQ(file_id, log_items[i].file_id_);
+    ASSERT_EQ(offset + static_cast<offset_t>(block_meta_size), log_items[i].offset_);
+    offset += (uint32_t)log_items[i].data_len_ + static_cast<offset_t>(block_meta_size);
+  }
+  ASSERT_EQ(offset, log_file_writer_.get_cur_file_len());
+
+  clog_writer_.destroy();
+  log_file_writer_.reset();
+}
+
 TEST_F(TestCLogWriter, errsim_aio_timeout)
 {
   int ret = OB_SUCCESS;
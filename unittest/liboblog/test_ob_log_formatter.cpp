@@ -0,0 +1,170 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX OBLOG_FORMATTER
+
+#include <gtest/gtest.h>
+#include "lib/random/ob_random.h"
+#include "liboblog/src/ob_log_formatter.h"
+#include "liboblog/src/ob_log_part_trans_task.h"
+#include "liboblog/src/ob_log_binlog_record.h"
+#include "liboblog/src/ob_log_config.h"
+
+using namespace oceanbase;
+using namespace common;
+using namespace liboblog;
+
+namespace oceanbase
+{
+namespace unittest
+{
+
+static const int64_t STMT_COUNT = 1000;
+static const int64_t THREAD_NUM = 4;
+
+// Formats a statement by copying its row number into the log entry arena, then finishes it
+// like ObLogFormatter::finish_format_: the thread formatting the last statement links the rows
+class MockFormatter : public ObLogFormatter
+{
+public:
+  MockFormatter() : done_(false), thread_used_cnt_(0)
+  {
+    memset(values_, 0, sizeof(values_));
+    memset(thread_used_, 0, sizeof(thread_used_));
+  }
+
+  int handle(void *data, const int64_t thread_index, volatile bool &stop_flag)
+  {
+    UNUSED(stop_flag);
+    int ret = OB_SUCCESS;
+    DmlStmtTask *stmt_task = static_cast<DmlStmtTask *>(static_cast<IStmtTask *>(data));
+    ObLogEntryTask &log_entry_task = stmt_task->get_redo_log_entry_task();
+    ObLogRowDataIndex &row_data_index = stmt_task->get_row_data_index();
+    ObLogBR *br = row_data_index.get_binlog_record();
+    const uint64_t row_no = row_data_index.get_row_no();
+    char *value = static_cast<char *>(log_entry_task.alloc(sizeof(int64_t)));
+
+    // finish statements out of order
+    usleep(static_cast<useconds_t>(ObRandom::rand(0, 20)));
+    if (OB_ISNULL(value) || OB_ISNULL(br)) {
+      ret = OB_ERR_UNEXPECTED;
+    } else {
+      MEMCPY(value, &row_no, sizeof(row_no));
+      br->set_is_valid(true);
+      values_[row_no] = value;
+      if (! ATOMIC_LOAD(&thread_used_[thread_index])) {
+        ATOMIC_STORE(&thread_used_[thread_index], true);
+        ATOMIC_INC(&thread_used_cnt_);
+      }
+      if (log_entry_task.inc_formatted_stmt_num() >= log_entry_task.get_stmt_num()) {
+        ret = log_entry_task.link_row_list();
+        ATOMIC_STORE(&done_, true);
+      }
+    }
+    return ret;
+  }
+
+public:
+  bool done_;
+  int64_t thread_used_cnt_;
+  bool thread_used_[THREAD_NUM];
+  const char *values_[STMT_COUNT];
+};
+
+class TestObLogFormatter : public ::testing::Test
+{
+public:
+  TestObLogFormatter() : allocator_(ObModIds::TEST) {}
+  virtual void SetUp() {}
+  virtual void TearDown() {}
+
+protected:
+  ObArenaAllocator allocator_;
+};
+
+TEST_F(TestObLogFormatter, parallel_stmt_order)
+{
+  MockFormatter formatter;
+  ObObj2strHelper obj2str_helper;
+  ObLogHbaseUtil hbase_util;
+  // not used by the mocked handle
+  char dummy[8];
+  ASSERT_EQ(OB_SUCCESS, formatter.init(THREAD_NUM, 10000, MEMORY_MODE, &obj2str_helper,
+      reinterpret_cast<IObLogBRPool *>(dummy), reinterpret_cast<IObLogMetaManager *>(dummy),
+      reinterpret_cast<IObLogSchemaGetter *>(dummy), reinterpret_cast<IObLogStorager *>(dummy),
+      reinterpret_cast<IObLogErrHandler *>(dummy), false, false, hbase_util, false, false));
+  ASSERT_EQ(OB_SUCCESS, formatter.start());
+
+  // a log entry of STMT_COUNT statements, pushed in batches of 7 to the formatter threads
+  TCONF.formatter_batch_stmt_count.set_value("7");
+  PartTransTask part_trans_task;
+  DmlRedoLogMetaNode meta_node;
+  ObLogEntryTask log_entry_task;
+  ObPartitionKey pkey(combine_id(1001, 3001), 0, 1);
+  char redo_data[16];
+  ASSERT_EQ(OB_SUCCESS, log_entry_task.init(pkey, transaction::ObTransID(), 1, 0, &meta_node,
+      redo_data, sizeof(redo_data), sizeof(redo_data)));
+
+  ObLogBR *brs = new ObLogBR[STMT_COUNT];
+  ObLogRowDataIndex *row_data_indexes = new ObLogRowDataIndex[STMT_COUNT];
+  for (int64_t i = 0; i < STMT_COUNT; ++i) {
+    ASSERT_EQ(OB_SUCCESS, row_data_indexes[i].init(1001, "pkey", 1, 0, i, false, 0));
+    row_data_indexes[i].set_binlog_record(brs + i);
+    MutatorRow *row = new (allocator_.alloc(sizeof(MutatorRow))) MutatorRow(allocator_);
+    DmlStmtTask *stmt_task = new (allocator_.alloc(sizeof(DmlStmtTask)))
+        DmlStmtTask(part_trans_task, log_entry_task, row_data_indexes[i], *row);
+    ASSERT_EQ(OB_SUCCESS, log_entry_task.add_stmt(i, stmt_task));
+  }
+
+  volatile bool stop_flag = false;
+  ASSERT_EQ(OB_SUCCESS, formatter.push(log_entry_task.get_stmt_list().head_, stop_flag));
+  for (int64_t i = 0; i < 10 * 1000 && ! ATOMIC_LOAD(&formatter.done_); ++i) {
+    usleep(1000);
+  }
+  ASSERT_TRUE(ATOMIC_LOAD(&formatter.done_));
+  // batches are spread over the threads
+  ASSERT_LT(1, ATOMIC_LOAD(&formatter.thread_used_cnt_));
+
+  // rows are linked in statement order, each with its own formatted value
+  int64_t valid_row_num = 0;
+  ASSERT_EQ(OB_SUCCESS, log_entry_task.get_valid_row_num(valid_row_num));
+  ASSERT_EQ(STMT_COUNT, valid_row_num);
+  ObLogRowDataIndex *row_data_index = meta_node.get_row_head();
+  for (int64_t i = 0; i < STMT_COUNT; ++i) {
+    ASSERT_TRUE(NULL != row_data_index);
+    ASSERT_EQ(static_cast<uint64_t>(i), row_data_index->get_row_no());
+    ASSERT_TRUE(NULL != formatter.values_[i]);
+    int64_t value = -1;
+    MEMCPY(&value, formatter.values_[i], sizeof(value));
+    ASSERT_EQ(i, value);
+    row_data_index = row_data_index->get_next();
+  }
+  ASSERT_TRUE(NULL == row_data_index);
+
+  formatter.stop();
+  formatter.destroy();
+  TCONF.formatter_batch_stmt_count.set_value("100");
+  log_entry_task.get_stmt_list().reset();
+  delete[] row_data_indexes;
+  delete[] brs;
+}
+
+}
+}
+
+int main(int argc, char **argv)
+{
+  OB_LOGGER.set_file_name("test_ob_log_formatter.log", true);
+  OB_LOGGER.set_log_level(OB_LOG_LEVEL_INFO);
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
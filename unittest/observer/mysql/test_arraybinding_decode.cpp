@@ -0,0 +1,155 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include "lib/allocator/page_arena.h"
+#include "rpc/obmysql/ob_mysql_util.h"
+#include "observer/mysql/obmp_stmt_execute.h"
+
+namespace oceanbase {
+namespace unittest {
+using namespace common;
+using namespace obmysql;
+using namespace sql;
+using namespace observer;
+
+class TestArraybindingDecode : public ::testing::Test {
+public:
+  TestArraybindingDecode() : allocator_(ObModIds::TEST), params_(ObWrapperAllocator(allocator_)), pos_(0)
+  {}
+  virtual void SetUp()
+  {
+    pos_ = 0;
+    params_.reset();
+    param_types_.reset();
+  }
+  virtual void TearDown()
+  {}
+
+protected:
+  // a row of (bigint, varchar), NULL if %str is NULL
+  void append_row(const int64_t value, const char* str)
+  {
+    ASSERT_EQ(OB_SUCCESS, ObMySQLUtil::store_int1(buf_, BUF_LEN, NULL == str ? 2 : 0, pos_));
+    ASSERT_EQ(OB_SUCCESS, ObMySQLUtil::store_int8(buf_, BUF_LEN, value, pos_));
+    if (NULL != str) {
+      ASSERT_EQ(OB_SUCCESS, ObMySQLUtil::store_obstr(buf_, BUF_LEN, ObString::make_string(str), pos_));
+    }
+  }
+  int decode(const int64_t len)
+  {
+    return ObMPStmtExecute::decode_arraybinding_rows(allocator_,
+        param_types_,
+        CHARSET_UTF8MB4,
+        CS_TYPE_UTF8MB4_GENERAL_CI,
+        CS_TYPE_UTF8MB4_GENERAL_CI,
+        NULL,
+        buf_,
+        buf_ + len,
+        params_);
+  }
+
+protected:
+  static const int64_t BUF_LEN = 1024;
+  ObArenaAllocator allocator_;
+  ParamStore params_;
+  ParamTypeArray param_types_;
+  char buf_[BUF_LEN];
+  int64_t pos_;
+};
+
+TEST_F(TestArraybindingDecode, decode)
+{
+  ASSERT_EQ(OB_SUCCESS, param_types_.push_back(MYSQL_TYPE_LONGLONG));
+  ASSERT_EQ(OB_SUCCESS, param_types_.push_back(MYSQL_TYPE_VAR_STRING));
+  append_row(1, "a");
+  append_row(2, NULL);
+  append_row(3, "ccc");
+  ASSERT_EQ(OB_SUCCESS, decode(pos_));
+  ASSERT_EQ(6, params_.count());
+  ASSERT_EQ(1, params_.at(0).get_int());
+  ASSERT_TRUE(ObString::make_string("a") == params_.at(1).get_string());
+  ASSERT_EQ(2, params_.at(2).get_int());
+  ASSERT_TRUE(params_.at(3).is_null());
+  ASSERT_EQ(3, params_.at(4).get_int());
+  ASSERT_TRUE(ObString::make_string("ccc") == params_.at(5).get_string());
+
+  // no more rows
+  params_.reset();
+  ASSERT_EQ(OB_SUCCESS, decode(0));
+  ASSERT_EQ(0, params_.count());
+}
+
+TEST_F(TestArraybindingDecode, malformed_bitmap)
+{
+  // 9 parameters take a 2 bytes null bitmap
+  for (int64_t i = 0; i < 9; ++i) {
+    ASSERT_EQ(OB_SUCCESS, param_types_.push_back(MYSQL_TYPE_TINY));
+  }
+  // a row of all NULL
+  buf_[pos_++] = static_cast<char>(0xff);
+  buf_[pos_++] = 0x01;
+  ASSERT_EQ(OB_SUCCESS, decode(pos_));
+  ASSERT_EQ(9, params_.count());
+
+  // the bitmap of the next row is cut short
+  buf_[pos_++] = static_cast<char>(0xff);
+  params_.reset();
+  ASSERT_EQ(OB_ERR_MALFORMED_PACKET, decode(pos_));
+}
+
+TEST_F(TestArraybindingDecode, malformed_value)
+{
+  ASSERT_EQ(OB_SUCCESS, param_types_.push_back(MYSQL_TYPE_LONGLONG));
+  ASSERT_EQ(OB_SUCCESS, param_types_.push_back(MYSQL_TYPE_VAR_STRING));
+  append_row(1, "hello");
+  const int64_t row_len = pos_;
+  for (int64_t len = 1; len < row_len; ++len) {
+    params_.reset();
+    ASSERT_EQ(OB_ERR_MALFORMED_PACKET, decode(len)) << len;
+  }
+  params_.reset();
+  ASSERT_EQ(OB_SUCCESS, decode(row_len));
+
+  // a length coded string longer than the packet
+  pos_ = 0;
+  ASSERT_EQ(OB_SUCCESS, ObMySQLUtil::store_int1(buf_, BUF_LEN, 0, pos_));
+  ASSERT_EQ(OB_SUCCESS, ObMySQLUtil::store_int8(buf_, BUF_LEN, 1, pos_));
+  ASSERT_EQ(OB_SUCCESS, ObMySQLUtil::store_length(buf_, BUF_LEN, 1 << 20, pos_));
+  params_.reset();
+  ASSERT_EQ(OB_ERR_MALFORMED_PACKET, decode(pos_ + 16));
+}
+
+TEST_F(TestArraybindingDecode, value_len)
+{
+  const char datetime[] = {7, 0x07, static_cast<char>(0xe5), 1, 2, 3, 4, 5};
+  ASSERT_EQ(OB_SUCCESS,
+      ObMPStmtExecute::check_basic_param_value_len(MYSQL_TYPE_DATETIME, datetime, datetime + sizeof(datetime)));
+  ASSERT_EQ(OB_ERR_MALFORMED_PACKET,
+      ObMPStmtExecute::check_basic_param_value_len(MYSQL_TYPE_DATETIME, datetime, datetime + sizeof(datetime) - 1));
+  ASSERT_EQ(OB_SUCCESS, ObMPStmtExecute::check_basic_param_value_len(MYSQL_TYPE_LONG, datetime, datetime + 4));
+  ASSERT_EQ(
+      OB_ERR_MALFORMED_PACKET, ObMPStmtExecute::check_basic_param_value_len(MYSQL_TYPE_LONG, datetime, datetime + 3));
+  ASSERT_EQ(OB_ERR_MALFORMED_PACKET, ObMPStmtExecute::check_basic_param_value_len(MYSQL_TYPE_TINY, datetime, datetime));
+}
+
+}  // namespace unittest
+}  // namespace oceanbase
+
+int main(int argc, char** argv)
+{
+  oceanbase::common::ObLogger& logger = oceanbase::common::ObLogger::get_logger();
+  logger.set_file_name("test_arraybinding_decode.log", true);
+  logger.set_log_level(OB_LOG_LEVEL_INFO);
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -352,6 +352,50 @@ TEST_F(TestKVCache, test_wash)
   ASSERT_TRUE(cache.size(tenant_id_) < upper_mem_limit_);
 }
 
+TEST_F(TestKVCache, scan_policy_and_ghost)
+{
+  static const int64_t K_SIZE = 16;
+  static const int64_t V_SIZE = 2 * 1024 * 1024;
+  typedef TestKVCacheKey<K_SIZE> TestKey;
+  typedef TestKVCacheValue<V_SIZE> TestValue;
+
+  ObKVCache<TestKey, TestValue> cache;
+  TestKey key;
+  TestValue value;
+  const TestValue* pvalue = NULL;
+  ObKVCacheHandle handle;
+  key.v_ = 1234;
+  key.tenant_id_ = tenant_id_;
+  value.v_ = 4321;
+  ASSERT_EQ(OB_SUCCESS, cache.init("test"));
+
+  // kv put by bulk read stays in SCAN memblock however often it is hit
+  ASSERT_EQ(OB_SUCCESS, cache.put(key, value, true, SCAN));
+  for (int64_t i = 0; i < 10; ++i) {
+    ASSERT_EQ(OB_SUCCESS, cache.get(key, pvalue, handle));
+    ASSERT_EQ(SCAN, handle.mb_handle_->policy_);
+  }
+  ObKVCacheInstKey inst_key(cache.get_cache_id(), tenant_id_);
+  ObKVCacheInstHandle inst_handle;
+  ASSERT_EQ(OB_SUCCESS, ObKVGlobalCache::get_instance().insts_.get_cache_inst(inst_key, inst_handle));
+  const ObKVCacheStatus& status = inst_handle.get_inst()->status_;
+  ASSERT_EQ(1, status.scan_mb_cnt_);
+  ASSERT_EQ(1, status.total_scan_put_cnt_.value());
+
+  // wash it, the map node left behind is the ghost of the key
+  ObKVMemBlockHandle* mb_handle = handle.mb_handle_;
+  handle.reset();
+  ObKVGlobalCache::get_instance().store_.wash_mb(mb_handle);
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, cache.get(key, pvalue, handle));
+
+  // read again soon by normal query, kv goes to the protected segment
+  ASSERT_EQ(OB_SUCCESS, cache.put(key, value));
+  ASSERT_EQ(1, status.ghost_hit_cnt_);
+  ASSERT_EQ(OB_SUCCESS, cache.get(key, pvalue, handle));
+  ASSERT_EQ(LFU, handle.mb_handle_->policy_);
+  ASSERT_EQ(value.v_, pvalue->v_);
+}
+
 TEST_F(TestKVCache, test_hold_size)
 {
   static const int64_t K_SIZE = 16;
@@ -0,0 +1,148 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_DTL
+#include <gtest/gtest.h>
+#include "sql/dtl/ob_dtl_column_batch.h"
+#include "lib/allocator/page_arena.h"
+
+namespace oceanbase {
+namespace sql {
+namespace dtl {
+using namespace common;
+
+class TestDtlColumnBatch : public ::testing::Test {
+public:
+  static const int64_t COL_CNT = 4;
+  static const int64_t BUF_SIZE = 64 * 1024;
+  TestDtlColumnBatch() : blk_(NULL), buf_(NULL)
+  {}
+  virtual void SetUp()
+  {
+    buf_ = static_cast<char*>(alloc_.alloc(BUF_SIZE));
+    ASSERT_TRUE(NULL != buf_);
+    ASSERT_EQ(OB_SUCCESS, ObChunkDatumStore::init_block_buffer(buf_, BUF_SIZE, blk_));
+  }
+  virtual void TearDown()
+  {
+    alloc_.reset();
+  }
+
+protected:
+  // column 0: int with null, 1: repeated string, 2: distinct string, 3: always null
+  void make_datums(const int64_t idx, ObDatum* datums, int64_t& int_val, char* str_buf)
+  {
+    static const char* strs[] = {"beijing", "hangzhou", "shanghai", "shenzhen"};
+    datums[0].int_ = &int_val;
+    if (0 == idx % 7) {
+      datums[0].set_null();
+    } else {
+      int_val = idx * 1000;
+      datums[0].set_int(int_val);
+    }
+    datums[1].set_string(ObString::make_string(strs[idx % ARRAYSIZEOF(strs)]));
+    const int64_t len = snprintf(str_buf, 32, "value_%ld", idx);
+    datums[2].set_string(str_buf, static_cast<int32_t>(len));
+    datums[3].set_null();
+  }
+
+  void fill_block(const int64_t cnt)
+  {
+    for (int64_t i = 0; i < cnt; i++) {
+      ObDatum datums[COL_CNT];
+      int64_t int_val = 0;
+      char str_buf[32];
+      make_datums(i, datums, int_val, str_buf);
+      const int64_t row_size = ObChunkDatumStore::row_copy_size(datums, COL_CNT);
+      const int64_t head_size = sizeof(ObChunkDatumStore::StoredRow);
+      char* buf = static_cast<char*>(alloc_.alloc(head_size + row_size));
+      ASSERT_TRUE(NULL != buf);
+      ObChunkDatumStore::StoredRow* sr = new (buf) ObChunkDatumStore::StoredRow();
+      ASSERT_EQ(OB_SUCCESS, sr->copy_datums(datums, COL_CNT, buf + head_size, row_size, row_size, 0));
+      sr->row_size_ = static_cast<uint32_t>(head_size + row_size);
+      ASSERT_EQ(OB_SUCCESS, blk_->copy_stored_row(*sr, NULL));
+    }
+  }
+
+  void verify(const ObDtlColumnBatchReader& reader, const int64_t cnt)
+  {
+    ASSERT_EQ(cnt, reader.get_rows());
+    ASSERT_EQ(COL_CNT, reader.get_col_cnt());
+    for (int64_t i = 0; i < cnt; i++) {
+      ObDatum datums[COL_CNT];
+      int64_t int_val = 0;
+      char str_buf[32];
+      make_datums(i, datums, int_val, str_buf);
+      for (int64_t col = 0; col < COL_CNT; col++) {
+        ObDatum d;
+        reader.get_datum(col, i, d);
+        ASSERT_TRUE(ObDatum::binary_equal(datums[col], d)) << "row " << i << " col " << col;
+      }
+    }
+  }
+
+protected:
+  ObArenaAllocator alloc_;
+  ObChunkDatumStore::Block* blk_;
+  char* buf_;
+};
+
+TEST_F(TestDtlColumnBatch, encode_decode)
+{
+  const int64_t cnt = 500;
+  fill_block(cnt);
+  ObDtlColumnBatchEncoder encoder;
+  char* buf = NULL;
+  int64_t size = 0;
+  const int64_t data_size = blk_->data_size();
+  ASSERT_EQ(OB_SUCCESS, encoder.prepare_buf(OB_SYS_TENANT_ID, data_size, buf));
+  ASSERT_EQ(OB_SUCCESS, encoder.encode(blk_, buf, data_size, size));
+  // datum headers are gone, repeated strings are in dictionary
+  ASSERT_LT(size, data_size / 2);
+  LOG_INFO("column batch size", K(data_size), K(size));
+
+  ObDtlColumnBatchReader reader;
+  ASSERT_EQ(OB_SUCCESS, reader.init(buf, size));
+  verify(reader, cnt);
+
+  // truncated batch is rejected
+  ASSERT_NE(OB_SUCCESS, reader.init(buf, size / 2));
+}
+
+TEST_F(TestDtlColumnBatch, small_batch)
+{
+  // too few rows to build dictionary
+  const int64_t cnt = 3;
+  fill_block(cnt);
+  ObDtlColumnBatchEncoder encoder;
+  char* buf = NULL;
+  int64_t size = 0;
+  const int64_t data_size = blk_->data_size();
+  ASSERT_EQ(OB_SUCCESS, encoder.prepare_buf(OB_SYS_TENANT_ID, data_size, buf));
+  ASSERT_EQ(OB_SUCCESS, encoder.encode(blk_, buf, data_size, size));
+  ObDtlColumnBatchReader reader;
+  ASSERT_EQ(OB_SUCCESS, reader.init(buf, size));
+  verify(reader, cnt);
+
+  // not smaller than the row format
+  ASSERT_EQ(OB_SIZE_OVERFLOW, encoder.encode(blk_, buf, 64, size));
+}
+
+}  // namespace dtl
+}  // namespace sql
+}  // namespace oceanbase
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
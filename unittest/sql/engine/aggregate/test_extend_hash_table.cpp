@@ -0,0 +1,186 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+
+#include "sql/engine/aggregate/ob_exec_hash_struct.h"
+#include "sql/engine/aggregate/ob_aggregate_processor.h"
+#include "lib/allocator/page_arena.h"
+
+namespace oceanbase {
+namespace sql {
+using namespace common;
+
+struct TestHashItem {
+  TestHashItem() : key_(0), hash_val_(0)
+  {}
+  uint64_t hash() const
+  {
+    return hash_val_;
+  }
+  bool operator==(const TestHashItem& other) const
+  {
+    return key_ == other.key_;
+  }
+  TO_STRING_KV(K_(key), K_(hash_val));
+
+  int64_t key_;
+  uint64_t hash_val_;
+};
+
+typedef ObExtendHashTable<TestHashItem> TestHashTable;
+
+class TestExtendHashTable : public ::testing::Test {
+public:
+  TestExtendHashTable() : profile_(ObSqlWorkAreaType::HASH_WORK_AREA), sql_mem_processor_(profile_)
+  {}
+  virtual void SetUp()
+  {
+    sql_mem_processor_.set_default_usable_mem_size(1L << 30);
+  }
+  virtual void TearDown()
+  {
+    alloc_.reset();
+  }
+
+protected:
+  TestHashItem* make_items(const int64_t cnt, const uint64_t hash_mask)
+  {
+    TestHashItem* items = static_cast<TestHashItem*>(alloc_.alloc(sizeof(TestHashItem) * cnt));
+    for (int64_t i = 0; NULL != items && i < cnt; i++) {
+      new (&items[i]) TestHashItem();
+      items[i].key_ = i;
+      items[i].hash_val_ = murmurhash(&i, sizeof(i), 0) & hash_mask;
+    }
+    return items;
+  }
+
+  void check_table(TestHashTable& table, TestHashItem* items, const int64_t cnt)
+  {
+    ASSERT_EQ(cnt, table.size());
+    for (int64_t i = 0; i < cnt; i++) {
+      const TestHashItem* item = table.get(items[i]);
+      ASSERT_TRUE(NULL != item);
+      ASSERT_EQ(&items[i], item);
+    }
+    TestHashItem not_exist;
+    not_exist.key_ = cnt;
+    not_exist.hash_val_ = items[0].hash_val_;
+    ASSERT_TRUE(NULL == table.get(not_exist));
+  }
+
+protected:
+  ObArenaAllocator alloc_;
+  ObSqlWorkAreaProfile profile_;
+  ObSqlMemMgrProcessor sql_mem_processor_;
+};
+
+TEST_F(TestExtendHashTable, set_get)
+{
+  TestHashTable table;
+  lib::ObMemAttr attr(OB_SERVER_TENANT_ID, "TestHashTable");
+  ASSERT_EQ(OB_SUCCESS, table.init(&alloc_, attr, &sql_mem_processor_, 16));
+  const int64_t cnt = 10000;
+  TestHashItem* items = make_items(cnt, UINT64_MAX);
+  ASSERT_TRUE(NULL != items);
+  for (int64_t i = 0; i < cnt; i++) {
+    ASSERT_EQ(OB_SUCCESS, table.set(items[i]));
+  }
+  check_table(table, items, cnt);
+  // at most half filled
+  ASSERT_GE(table.get_bucket_num(), cnt * TestHashTable::SIZE_BUCKET_SCALE);
+
+  int64_t visit_cnt = 0;
+  auto cb = [&](TestHashItem&) {
+    visit_cnt++;
+    return OB_SUCCESS;
+  };
+  ASSERT_EQ(OB_SUCCESS, table.foreach (cb));
+  ASSERT_EQ(cnt, visit_cnt);
+
+  table.reuse();
+  ASSERT_EQ(0, table.size());
+  ASSERT_TRUE(NULL == table.get(items[0]));
+  table.destroy();
+}
+
+TEST_F(TestExtendHashTable, hash_collision)
+{
+  TestHashTable table;
+  lib::ObMemAttr attr(OB_SERVER_TENANT_ID, "TestHashTable");
+  ASSERT_EQ(OB_SUCCESS, table.init(&alloc_, attr, &sql_mem_processor_));
+  // only 8 distinct hash values, items are located by probing and key comparison
+  const int64_t cnt = 1000;
+  TestHashItem* items = make_items(cnt, 0x7);
+  ASSERT_TRUE(NULL != items);
+  for (int64_t i = 0; i < cnt; i++) {
+    ASSERT_EQ(OB_SUCCESS, table.set(items[i]));
+  }
+  check_table(table, items, cnt);
+
+  // probe with custom comparison
+  int64_t cmp_cnt = 0;
+  auto equal = [&](const TestHashItem& item) {
+    cmp_cnt++;
+    return item.key_ == items[cnt - 1].key_;
+  };
+  ASSERT_EQ(&items[cnt - 1], table.probe(items[cnt - 1].hash_val_, equal));
+  ASSERT_GT(cmp_cnt, 0);
+  table.destroy();
+}
+
+TEST_F(TestExtendHashTable, extend_beyond_mem_bound)
+{
+  TestHashTable table;
+  lib::ObMemAttr attr(OB_SERVER_TENANT_ID, "TestHashTable");
+  // memory bound only allows the minimal bucket count
+  sql_mem_processor_.set_default_usable_mem_size(1024);
+  ASSERT_EQ(OB_SUCCESS, table.init(&alloc_, attr, &sql_mem_processor_));
+  ASSERT_EQ(TestHashTable::INITIAL_SIZE, table.get_bucket_num());
+  const int64_t cnt = 1000;
+  TestHashItem* items = make_items(cnt, UINT64_MAX);
+  ASSERT_TRUE(NULL != items);
+  for (int64_t i = 0; i < cnt; i++) {
+    ASSERT_EQ(OB_SUCCESS, table.set(items[i]));
+    ASSERT_LE(table.size() * 100, table.get_bucket_num() * TestHashTable::MAX_LOAD_PERCENT);
+  }
+  check_table(table, items, cnt);
+  table.destroy();
+}
+
+TEST_F(TestExtendHashTable, int_key_hash)
+{
+  ObDatum datum;
+  int64_t v = 0;
+  datum.int_ = &v;
+  datum.len_ = sizeof(v);
+  datum.null_ = 0;
+  const uint64_t zero_hash = ObGroupRowHashTable::calc_int_key_hash(datum);
+  v = 1;
+  const uint64_t one_hash = ObGroupRowHashTable::calc_int_key_hash(datum);
+  v = -1;
+  const uint64_t minus_one_hash = ObGroupRowHashTable::calc_int_key_hash(datum);
+  ASSERT_NE(zero_hash, one_hash);
+  ASSERT_NE(one_hash, minus_one_hash);
+  ASSERT_NE(zero_hash, minus_one_hash);
+  datum.set_null();
+  ASSERT_EQ(ObGroupRowHashTable::NULL_INT_KEY_HASH, ObGroupRowHashTable::calc_int_key_hash(datum));
+}
+
+}  // end namespace sql
+}  // end namespace oceanbase
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -787,6 +787,43 @@ TEST_F(TestChunkDatumStore, test_only_disk_data1)
   rs.reset();
 }
 
+TEST_F(TestChunkDatumStore, compressed_disk)
+{
+  int64_t cnt = 20000;
+  ObChunkDatumStore raw_rs;
+  ObChunkDatumStore rs;
+  ObChunkDatumStore::Iterator it;
+  ASSERT_EQ(OB_SUCCESS, raw_rs.init(0, tenant_id_, ctx_id_, label_));
+  ASSERT_EQ(OB_SUCCESS, raw_rs.alloc_dir_id());
+  raw_rs.set_compressor_type(NONE_COMPRESSOR);
+  ASSERT_EQ(OB_SUCCESS, rs.init(0, tenant_id_, ctx_id_, label_));
+  ASSERT_EQ(OB_SUCCESS, rs.alloc_dir_id());
+  rs.set_compressor_type(LZ4_COMPRESSOR);
+  raw_rs.set_mem_limit(1L << 20);
+  rs.set_mem_limit(1L << 20);
+  // same rows for both stores
+  srandom(0);
+  CALL(append_rows, raw_rs, cnt);
+  srandom(0);
+  CALL(append_rows, rs, cnt);
+  ASSERT_EQ(OB_SUCCESS, raw_rs.finish_add_row());
+  ASSERT_EQ(OB_SUCCESS, rs.finish_add_row());
+  LOG_INFO("compressed dump", K(raw_rs.get_file_size()), K(rs.get_file_size()), K(rs.get_dump_saved_size()));
+  ASSERT_GT(rs.get_file_size(), 0);
+  ASSERT_EQ(raw_rs.get_file_size(), rs.get_file_size() + rs.get_dump_saved_size());
+  ASSERT_LT(rs.get_file_size(), raw_rs.get_file_size());
+
+  // chunk read size is ignored for compressed blocks
+  CALL(verify_n_rows, rs, it, rs.get_row_cnt(), true);
+  it.reset();
+  CALL(verify_n_rows, rs, it, rs.get_row_cnt(), true, ObChunkDatumStore::BLOCK_SIZE);
+  it.reset();
+  CALL(verify_n_rows, rs, it, rs.get_row_cnt(), true, 16L << 20);
+  it.reset();
+  rs.reset();
+  raw_rs.reset();
+}
+
 }  // end namespace sql
 }  // end namespace oceanbase
 
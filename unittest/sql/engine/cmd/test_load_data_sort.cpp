@@ -0,0 +1,139 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include "lib/allocator/page_arena.h"
+#include "sql/engine/cmd/ob_load_data_impl.h"
+
+namespace oceanbase {
+namespace unittest {
+using namespace common;
+using namespace sql;
+
+static const int64_t KEY_CNT = 2;
+
+class TestLoadDataSort : public ::testing::Test {
+public:
+  TestLoadDataSort() : allocator_(ObModIds::TEST)
+  {}
+  virtual void SetUp()
+  {}
+  virtual void TearDown()
+  {
+    rows_.reset();
+    allocator_.reset();
+  }
+
+protected:
+  // rowkey (c1 bigint, c2 varchar collate %cs_type), values are taken from the file fields in order
+  void init_generator(const ObCollationType cs_type)
+  {
+    ObLoadSortKeyColumn int_column;
+    int_column.value_idx_ = 0;
+    int_column.meta_.set_int();
+    ObLoadSortKeyColumn str_column;
+    str_column.value_idx_ = 1;
+    str_column.meta_.set_varchar();
+    str_column.meta_.set_collation_type(cs_type);
+    ASSERT_EQ(OB_SUCCESS, generator_.add_sort_key_column(int_column));
+    ASSERT_EQ(OB_SUCCESS, generator_.add_sort_key_column(str_column));
+  }
+  void add_row(const int64_t part_id, const char* c1, const char* c2)
+  {
+    // the file buffer is reused for the next line
+    char buf[64];
+    ObSEArray<ObString, KEY_CNT> values;
+    const int64_t c1_len = strlen(c1);
+    MEMCPY(buf, c1, c1_len);
+    MEMCPY(buf + c1_len, c2, strlen(c2));
+    ASSERT_EQ(OB_SUCCESS, values.push_back(ObString(c1_len, buf)));
+    ASSERT_EQ(OB_SUCCESS, values.push_back(ObString(strlen(c2), buf + c1_len)));
+    ObLoadSortRow row;
+    bool is_valid = false;
+    row.part_id_ = part_id;
+    row.line_num_ = rows_.count();
+    row.key_objs_ = static_cast<ObObj*>(allocator_.alloc(sizeof(ObObj) * KEY_CNT));
+    ASSERT_TRUE(NULL != row.key_objs_);
+    new (row.key_objs_) ObObj[KEY_CNT];
+    ASSERT_EQ(OB_SUCCESS, generator_.gen_sort_key(values, allocator_, row.key_objs_, is_valid));
+    ASSERT_TRUE(is_valid);
+    MEMSET(buf, 0, sizeof(buf));
+    ASSERT_EQ(OB_SUCCESS, rows_.push_back(row));
+  }
+  void sort_and_check(const int64_t* expected_lines, const int64_t cnt)
+  {
+    int ret = OB_SUCCESS;
+    ObLoadSortRowCompare compare(generator_.get_sort_key_columns(), ret);
+    std::sort(rows_.begin(), rows_.end(), compare);
+    ASSERT_EQ(OB_SUCCESS, ret);
+    ASSERT_EQ(cnt, rows_.count());
+    for (int64_t i = 0; i < cnt; ++i) {
+      ASSERT_EQ(expected_lines[i], rows_.at(i).line_num_) << i;
+    }
+  }
+  void add_rows()
+  {
+    add_row(0, "1", "b");
+    add_row(0, "1", "A");
+    add_row(0, "1", "a");
+    add_row(0, "\xff", "z");  // NULL
+    add_row(0, "1", "B");
+    add_row(0, "0", "z");
+    add_row(0, "1", "a");
+  }
+
+protected:
+  ObArenaAllocator allocator_;
+  ObInsertValueGenerator generator_;
+  ObArray<ObLoadSortRow> rows_;
+};
+
+TEST_F(TestLoadDataSort, case_insensitive)
+{
+  init_generator(CS_TYPE_UTF8MB4_GENERAL_CI);
+  add_rows();
+  // 'a' and 'A' are duplicates in the column collation and keep the file order
+  const int64_t expected_lines[] = {3, 5, 1, 2, 6, 0, 4};
+  sort_and_check(expected_lines, ARRAYSIZEOF(expected_lines));
+}
+
+TEST_F(TestLoadDataSort, binary)
+{
+  init_generator(CS_TYPE_UTF8MB4_BIN);
+  add_rows();
+  const int64_t expected_lines[] = {3, 5, 1, 4, 2, 6, 0};
+  sort_and_check(expected_lines, ARRAYSIZEOF(expected_lines));
+}
+
+TEST_F(TestLoadDataSort, partition_first)
+{
+  init_generator(CS_TYPE_UTF8MB4_GENERAL_CI);
+  add_row(1, "0", "a");
+  add_row(0, "2", "a");
+  add_row(1, "0", "A");
+  add_row(0, "1", "a");
+  const int64_t expected_lines[] = {3, 1, 0, 2};
+  sort_and_check(expected_lines, ARRAYSIZEOF(expected_lines));
+}
+
+}  // namespace unittest
+}  // namespace oceanbase
+
+int main(int argc, char** argv)
+{
+  oceanbase::common::ObLogger& logger = oceanbase::common::ObLogger::get_logger();
+  logger.set_file_name("test_load_data_sort.log", true);
+  logger.set_log_level(OB_LOG_LEVEL_INFO);
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
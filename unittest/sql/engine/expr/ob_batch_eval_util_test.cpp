@@ -0,0 +1,211 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include <float.h>
+#include <stdlib.h>
+
+#include "sql/engine/expr/ob_batch_eval_util.h"
+
+namespace oceanbase {
+namespace sql {
+using namespace common;
+
+class ObBatchEvalUtilTest : public ::testing::Test {
+public:
+  ObBatchEvalUtilTest()
+  {}
+  ~ObBatchEvalUtilTest()
+  {}
+  virtual void SetUp()
+  {}
+  virtual void TearDown()
+  {}
+
+protected:
+  const static int64_t N = ObBatchEvalUtil::CHUNK_SIZE;
+
+  template <typename T>
+  static bool cmp(const T l, const T r, const ObCmpOp op)
+  {
+    bool res = false;
+    switch (op) {
+      case CO_EQ:
+        res = l == r;
+        break;
+      case CO_LE:
+        res = l <= r;
+        break;
+      case CO_LT:
+        res = l < r;
+        break;
+      case CO_GE:
+        res = l >= r;
+        break;
+      case CO_GT:
+        res = l > r;
+        break;
+      case CO_NE:
+        res = l != r;
+        break;
+      default:
+        break;
+    }
+    return res;
+  }
+
+  template <typename T>
+  void check_cmp(const ObBatchValueClass vc, const T* l, const T* r, const int64_t n)
+  {
+    int64_t res[N];
+    for (int level = OB_SIMD_NONE; level <= ObBatchEvalUtil::get_simd_level(); level++) {
+      for (int op = CO_EQ; op < CO_CMP; op++) {
+        ObBatchEvalUtil::CmpKernel kernel =
+            ObBatchEvalUtil::get_cmp_kernel(vc, static_cast<ObCmpOp>(op), static_cast<ObSimdLevel>(level));
+        ASSERT_TRUE(NULL != kernel);
+        kernel(l, r, res, n);
+        for (int64_t i = 0; i < n; i++) {
+          ASSERT_EQ(cmp(l[i], r[i], static_cast<ObCmpOp>(op)), res[i]) << "level: " << level << " op: " << op
+                                                                      << " idx: " << i;
+        }
+      }
+    }
+  }
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(ObBatchEvalUtilTest);
+};
+
+TEST_F(ObBatchEvalUtilTest, value_class)
+{
+  EXPECT_EQ(OB_BVC_INT64, ObBatchEvalUtil::get_value_class(ObIntType));
+  EXPECT_EQ(OB_BVC_INT64, ObBatchEvalUtil::get_value_class(ObTinyIntType));
+  EXPECT_EQ(OB_BVC_INT64, ObBatchEvalUtil::get_value_class(ObDateTimeType));
+  EXPECT_EQ(OB_BVC_UINT64, ObBatchEvalUtil::get_value_class(ObUInt64Type));
+  EXPECT_EQ(OB_BVC_DOUBLE, ObBatchEvalUtil::get_value_class(ObDoubleType));
+  EXPECT_EQ(OB_BVC_FLOAT, ObBatchEvalUtil::get_value_class(ObFloatType));
+  EXPECT_EQ(OB_BVC_INT32, ObBatchEvalUtil::get_value_class(ObDateType));
+  EXPECT_EQ(OB_BVC_INVALID, ObBatchEvalUtil::get_value_class(ObNumberType));
+  EXPECT_EQ(OB_BVC_INVALID, ObBatchEvalUtil::get_value_class(ObVarcharType));
+
+  EXPECT_TRUE(NULL == ObBatchEvalUtil::get_cmp_kernel(OB_BVC_INVALID, CO_EQ));
+  EXPECT_TRUE(NULL == ObBatchEvalUtil::get_cmp_kernel(OB_BVC_INT64, CO_CMP));
+  EXPECT_TRUE(NULL == ObBatchEvalUtil::get_add_kernel(OB_BVC_INT32));
+  EXPECT_TRUE(NULL != ObBatchEvalUtil::get_add_kernel(OB_BVC_INT64));
+  EXPECT_STRNE("UNKNOWN", ObBatchEvalUtil::get_simd_level_str(ObBatchEvalUtil::get_simd_level()));
+}
+
+TEST_F(ObBatchEvalUtilTest, cmp_kernel)
+{
+  int64_t li[N];
+  int64_t ri[N];
+  uint64_t lu[N];
+  uint64_t ru[N];
+  double ld[N];
+  double rd[N];
+  float lf[N];
+  float rf[N];
+  int32_t l32[N];
+  int32_t r32[N];
+  srandom(0);
+  for (int64_t i = 0; i < N; i++) {
+    li[i] = random() % 16 - 8;
+    ri[i] = random() % 16 - 8;
+    lu[i] = (0 == i % 7) ? UINT64_MAX - random() % 4 : random() % 16;
+    ru[i] = (0 == i % 5) ? UINT64_MAX - random() % 4 : random() % 16;
+    ld[i] = static_cast<double>(li[i]) / 4;
+    rd[i] = static_cast<double>(ri[i]) / 4;
+    lf[i] = static_cast<float>(ld[i]);
+    rf[i] = static_cast<float>(rd[i]);
+    l32[i] = static_cast<int32_t>(li[i]);
+    r32[i] = static_cast<int32_t>(ri[i]);
+  }
+  li[0] = INT64_MIN;
+  ri[1] = INT64_MAX;
+  // the tail not aligned with vector width is checked too.
+  const int64_t sizes[] = {1, 3, 17, N - 1, N};
+  for (int64_t i = 0; i < ARRAYSIZEOF(sizes); i++) {
+    check_cmp(OB_BVC_INT64, li, ri, sizes[i]);
+    check_cmp(OB_BVC_UINT64, lu, ru, sizes[i]);
+    check_cmp(OB_BVC_DOUBLE, ld, rd, sizes[i]);
+    check_cmp(OB_BVC_FLOAT, lf, rf, sizes[i]);
+    check_cmp(OB_BVC_INT32, l32, r32, sizes[i]);
+  }
+}
+
+TEST_F(ObBatchEvalUtilTest, add_kernel)
+{
+  int64_t li[N];
+  int64_t ri[N];
+  int64_t resi[N];
+  uint64_t lu[N];
+  uint64_t ru[N];
+  uint64_t resu[N];
+  double ld[N];
+  double rd[N];
+  double resd[N];
+  for (int64_t i = 0; i < N; i++) {
+    li[i] = i - N / 2;
+    ri[i] = i * 3;
+    lu[i] = i;
+    ru[i] = i * 3;
+    ld[i] = static_cast<double>(i) / 3;
+    rd[i] = static_cast<double>(i) * 5;
+  }
+  for (int level = OB_SIMD_NONE; level <= ObBatchEvalUtil::get_simd_level(); level++) {
+    const ObSimdLevel simd = static_cast<ObSimdLevel>(level);
+    ObBatchEvalUtil::AddKernel add_int = ObBatchEvalUtil::get_add_kernel(OB_BVC_INT64, simd);
+    ObBatchEvalUtil::AddKernel add_uint = ObBatchEvalUtil::get_add_kernel(OB_BVC_UINT64, simd);
+    ObBatchEvalUtil::AddKernel add_double = ObBatchEvalUtil::get_add_kernel(OB_BVC_DOUBLE, simd);
+    ASSERT_TRUE(NULL != add_int && NULL != add_uint && NULL != add_double);
+
+    ASSERT_FALSE(add_int(li, ri, resi, N));
+    ASSERT_FALSE(add_uint(lu, ru, resu, N));
+    ASSERT_FALSE(add_double(ld, rd, resd, N));
+    for (int64_t i = 0; i < N; i++) {
+      ASSERT_EQ(li[i] + ri[i], resi[i]);
+      ASSERT_EQ(lu[i] + ru[i], resu[i]);
+      ASSERT_EQ(ld[i] + rd[i], resd[i]);
+    }
+
+    // overflow of any element is detected
+    const int64_t idx = N - 3;
+    li[idx] = INT64_MAX;
+    ASSERT_TRUE(add_int(li, ri, resi, N));
+    li[idx] = INT64_MIN;
+    ri[idx] = -1;
+    ASSERT_TRUE(add_int(li, ri, resi, N));
+    ASSERT_FALSE(add_int(li, ri, resi, idx));
+    li[idx] = idx - N / 2;
+    ri[idx] = idx * 3;
+
+    lu[idx] = UINT64_MAX;
+    ASSERT_TRUE(add_uint(lu, ru, resu, N));
+    lu[idx] = idx;
+
+    ld[idx] = DBL_MAX;
+    rd[idx] = DBL_MAX;
+    ASSERT_TRUE(add_double(ld, rd, resd, N));
+    ld[idx] = static_cast<double>(idx) / 3;
+    rd[idx] = static_cast<double>(idx) * 5;
+  }
+}
+
+}  // namespace sql
+}  // namespace oceanbase
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  int ret = RUN_ALL_TESTS();
+  return ret;
+}
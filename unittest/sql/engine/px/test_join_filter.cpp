@@ -0,0 +1,126 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_ENG
+#include <gtest/gtest.h>
+
+#include "sql/engine/px/datahub/components/ob_dh_join_filter.h"
+
+using namespace oceanbase;
+using namespace oceanbase::common;
+using namespace oceanbase::sql;
+
+class TestJoinFilter : public ::testing::Test {
+public:
+  TestJoinFilter() = default;
+  virtual ~TestJoinFilter() = default;
+  virtual void SetUp(){};
+  virtual void TearDown(){};
+
+protected:
+  static uint64_t hash(const int64_t v)
+  {
+    return murmurhash(&v, sizeof(v), ObJoinFilterData::HASH_SEED) & ObJoinFilterData::HASH_VAL_MASK;
+  }
+  // insert [begin, end)
+  static void fill(ObJoinFilterData& filter, const int64_t begin, const int64_t end)
+  {
+    for (int64_t i = begin; i < end; i++) {
+      filter.insert(hash(i));
+      filter.update_range(i);
+    }
+  }
+  static int64_t count_false_positive(const ObJoinFilterData& filter, const int64_t begin, const int64_t end)
+  {
+    int64_t cnt = 0;
+    for (int64_t i = begin; i < end; i++) {
+      cnt += filter.might_contain(hash(i));
+    }
+    return cnt;
+  }
+};
+
+TEST_F(TestJoinFilter, insert_and_check)
+{
+  ObJoinFilterData filter;
+  const int64_t cnt = 10000;
+  ASSERT_EQ(OB_SUCCESS, filter.init(cnt, true));
+  ASSERT_TRUE(filter.is_valid());
+  fill(filter, 0, cnt);
+  ASSERT_EQ(cnt, filter.get_row_cnt());
+  for (int64_t i = 0; i < cnt; i++) {
+    ASSERT_TRUE(filter.might_contain(hash(i)));
+  }
+  ASSERT_TRUE(filter.in_range(0));
+  ASSERT_TRUE(filter.in_range(cnt - 1));
+  ASSERT_FALSE(filter.in_range(-1));
+  ASSERT_FALSE(filter.in_range(cnt));
+  // 8 bits per row and 3 hash functions, false positive rate is about 3%
+  ASSERT_LT(count_false_positive(filter, cnt, 2 * cnt), cnt / 10);
+}
+
+TEST_F(TestJoinFilter, merge_different_size)
+{
+  ObJoinFilterData small;
+  ObJoinFilterData large;
+  ASSERT_EQ(OB_SUCCESS, small.init(100, false));
+  ASSERT_EQ(OB_SUCCESS, large.init(100000, false));
+  ASSERT_LT(small.get_word_cnt(), large.get_word_cnt());
+  fill(small, 0, 100);
+  fill(large, 100, 1000);
+
+  ObJoinFilterData merged;
+  ASSERT_EQ(OB_SUCCESS, merged.merge(large));
+  ASSERT_EQ(OB_SUCCESS, merged.merge(small));
+  // larger filter is folded to the smaller one
+  ASSERT_EQ(small.get_word_cnt(), merged.get_word_cnt());
+  ASSERT_EQ(1000, merged.get_row_cnt());
+  for (int64_t i = 0; i < 1000; i++) {
+    ASSERT_TRUE(merged.might_contain(hash(i)));
+  }
+
+  ObJoinFilterData with_range;
+  ASSERT_EQ(OB_SUCCESS, with_range.init(100, true));
+  ASSERT_NE(OB_SUCCESS, merged.merge(with_range));
+}
+
+TEST_F(TestJoinFilter, serialize)
+{
+  ObJoinFilterData filter;
+  ASSERT_EQ(OB_SUCCESS, filter.init(1000, true));
+  fill(filter, 10, 1000);
+  const int64_t len = filter.get_serialize_size();
+  char* buf = static_cast<char*>(ob_malloc(len, ObModIds::TEST));
+  ASSERT_TRUE(NULL != buf);
+  int64_t pos = 0;
+  ASSERT_EQ(OB_SUCCESS, filter.serialize(buf, len, pos));
+  ASSERT_EQ(len, pos);
+
+  ObJoinFilterData other;
+  pos = 0;
+  ASSERT_EQ(OB_SUCCESS, other.deserialize(buf, len, pos));
+  ASSERT_EQ(len, pos);
+  ASSERT_EQ(filter.get_word_cnt(), other.get_word_cnt());
+  ASSERT_EQ(filter.get_row_cnt(), other.get_row_cnt());
+  ASSERT_TRUE(other.has_range());
+  ASSERT_FALSE(other.in_range(9));
+  for (int64_t i = 10; i < 1000; i++) {
+    ASSERT_TRUE(other.might_contain(hash(i)));
+  }
+  ob_free(buf);
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,206 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_ENG
+
+#include <gtest/gtest.h>
+#include "sql/engine/sort/ob_sort_op_impl.h"
+#include "share/datum/ob_datum_funcs.h"
+#include "lib/allocator/page_arena.h"
+
+namespace oceanbase {
+namespace sql {
+using namespace common;
+
+class TestSortKeyNormalizer : public ::testing::Test {
+public:
+  static const int64_t MAX_COL_CNT = 4;
+  TestSortKeyNormalizer() : col_cnt_(0)
+  {}
+  virtual void TearDown()
+  {
+    alloc_.reset();
+  }
+
+protected:
+  void add_column(const ObObjType type, const ObCollationType cs_type, const bool asc, const ObCmpNullPos null_pos)
+  {
+    ObExpr* expr = &exprs_buf_[col_cnt_];
+    expr->datum_meta_ = ObDatumMeta(type, cs_type, 0);
+    ASSERT_EQ(OB_SUCCESS, exprs_.push_back(expr));
+    ASSERT_EQ(OB_SUCCESS, collations_.push_back(ObSortFieldCollation(col_cnt_, cs_type, asc, null_pos)));
+    ObSortCmpFunc cmp_func;
+    cmp_func.cmp_func_ = ObDatumFuncs::get_nullsafe_cmp_func(type, type, null_pos, cs_type, false);
+    ASSERT_TRUE(NULL != cmp_func.cmp_func_);
+    ASSERT_EQ(OB_SUCCESS, cmp_funcs_.push_back(cmp_func));
+    col_cnt_++;
+  }
+
+  ObChunkDatumStore::StoredRow* make_row(ObDatum* datums)
+  {
+    ObChunkDatumStore::StoredRow* sr = NULL;
+    const int64_t row_size = ObChunkDatumStore::row_copy_size(datums, col_cnt_);
+    const int64_t head_size = sizeof(ObChunkDatumStore::StoredRow);
+    char* buf = static_cast<char*>(alloc_.alloc(head_size + row_size));
+    if (NULL != buf) {
+      sr = new (buf) ObChunkDatumStore::StoredRow();
+      if (OB_SUCCESS != sr->copy_datums(datums, col_cnt_, buf + head_size, row_size, row_size, 0)) {
+        sr = NULL;
+      }
+    }
+    return sr;
+  }
+
+  // random int and string rows with many duplicated values and nulls
+  void make_rows(const int64_t cnt, ObIArray<ObChunkDatumStore::StoredRow*>& rows)
+  {
+    static const char* strs[] = {"",
+        "a",
+        "A",
+        "a ",
+        "a\x01",
+        "ab",
+        "aB ",
+        "b",
+        "abcdefghijklmnopq",
+        "abcdefghijklmnopr",
+        "\xc3\xa9",
+        "E",
+        "e",
+        "\xe4\xb8\xad\xe6\x96\x87",
+        "zzz"};
+    for (int64_t i = 0; i < cnt; i++) {
+      ObDatum datums[MAX_COL_CNT];
+      int64_t ints[MAX_COL_CNT];
+      for (int64_t j = 0; j < col_cnt_; j++) {
+        datums[j].int_ = &ints[j];
+        if (0 == random() % 10) {
+          datums[j].set_null();
+        } else {
+          switch (ob_obj_type_class(exprs_.at(j)->datum_meta_.type_)) {
+            case ObIntTC:
+              datums[j].set_int(random() % 21 - 10 + (0 == random() % 50 ? INT64_MIN / 2 : 0));
+              break;
+            case ObDateTC:
+              datums[j].set_date(static_cast<int32_t>(random() % 11 - 5));
+              break;
+            case ObStringTC:
+              datums[j].set_string(ObString::make_string(strs[random() % ARRAYSIZEOF(strs)]));
+              break;
+            default:
+              datums[j].set_null();
+              break;
+          }
+        }
+      }
+      ObChunkDatumStore::StoredRow* sr = make_row(datums);
+      ASSERT_TRUE(NULL != sr);
+      ASSERT_EQ(OB_SUCCESS, rows.push_back(sr));
+    }
+  }
+
+  void check_sort(const bool expect_complete)
+  {
+    ObSortKeyNormalizer normalizer;
+    ObSortOpImpl::Compare cmp;
+    ASSERT_EQ(OB_SUCCESS, normalizer.init(collations_, exprs_));
+    ASSERT_TRUE(normalizer.is_enabled());
+    ASSERT_EQ(expect_complete, normalizer.is_complete());
+    ASSERT_EQ(OB_SUCCESS, cmp.init(&collations_, &cmp_funcs_));
+
+    ObArray<ObChunkDatumStore::StoredRow*> rows;
+    const int64_t cnt = 3000;
+    make_rows(cnt, rows);
+    ObSortKeyNormalizer::Item* items =
+        static_cast<ObSortKeyNormalizer::Item*>(alloc_.alloc(sizeof(ObSortKeyNormalizer::Item) * cnt * 2));
+    ASSERT_TRUE(NULL != items);
+    for (int64_t i = 0; i < cnt; i++) {
+      bool is_valid = false;
+      normalizer.encode(rows.at(i)->cells(), items[i].key_, is_valid);
+      ASSERT_TRUE(is_valid);
+      items[i].row_ = rows.at(i);
+    }
+
+    // key order never conflicts with the compare functions
+    for (int64_t i = 1; i < cnt; i++) {
+      const ObSortKeyNormalizer::Item& l = items[i - 1];
+      const ObSortKeyNormalizer::Item& r = items[i];
+      if (l.key_ < r.key_) {
+        ASSERT_FALSE(cmp(r.row_, l.row_));
+      } else if (r.key_ < l.key_) {
+        ASSERT_FALSE(cmp(l.row_, r.row_));
+      } else if (expect_complete) {
+        ASSERT_FALSE(cmp(l.row_, r.row_));
+        ASSERT_FALSE(cmp(r.row_, l.row_));
+      }
+    }
+
+    normalizer.sort(items, items + cnt, cnt, cmp);
+    ASSERT_EQ(OB_SUCCESS, cmp.ret_);
+    for (int64_t i = 1; i < cnt; i++) {
+      ASSERT_FALSE(cmp(items[i].row_, items[i - 1].row_));
+    }
+  }
+
+protected:
+  ObArenaAllocator alloc_;
+  int64_t col_cnt_;
+  ObExpr exprs_buf_[MAX_COL_CNT];
+  ObSEArray<ObExpr*, MAX_COL_CNT> exprs_;
+  ObSEArray<ObSortFieldCollation, MAX_COL_CNT> collations_;
+  ObSEArray<ObSortCmpFunc, MAX_COL_CNT> cmp_funcs_;
+};
+
+TEST_F(TestSortKeyNormalizer, fixed_len_complete)
+{
+  add_column(ObIntType, CS_TYPE_BINARY, true, NULL_FIRST);
+  add_column(ObDateType, CS_TYPE_BINARY, false, NULL_LAST);
+  check_sort(true);
+}
+
+TEST_F(TestSortKeyNormalizer, int_prefix)
+{
+  add_column(ObIntType, CS_TYPE_BINARY, false, NULL_FIRST);
+  add_column(ObIntType, CS_TYPE_BINARY, true, NULL_LAST);
+  check_sort(false);
+}
+
+TEST_F(TestSortKeyNormalizer, bin_string)
+{
+  add_column(ObVarcharType, CS_TYPE_UTF8MB4_BIN, true, NULL_FIRST);
+  check_sort(false);
+}
+
+TEST_F(TestSortKeyNormalizer, weight_string)
+{
+  add_column(ObIntType, CS_TYPE_BINARY, true, NULL_LAST);
+  add_column(ObVarcharType, CS_TYPE_UTF8MB4_GENERAL_CI, false, NULL_FIRST);
+  check_sort(false);
+}
+
+TEST_F(TestSortKeyNormalizer, unsupported_column)
+{
+  ObSortKeyNormalizer normalizer;
+  add_column(ObDoubleType, CS_TYPE_BINARY, true, NULL_FIRST);
+  add_column(ObIntType, CS_TYPE_BINARY, true, NULL_FIRST);
+  ASSERT_EQ(OB_SUCCESS, normalizer.init(collations_, exprs_));
+  ASSERT_FALSE(normalizer.is_enabled());
+}
+
+}  // end namespace sql
+}  // end namespace oceanbase
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,172 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+
+#include "sql/engine/ob_bit_vector.h"
+#include "lib/allocator/page_arena.h"
+
+namespace oceanbase {
+namespace sql {
+using namespace common;
+
+class ObTestBitVector : public ::testing::Test {
+public:
+  ObTestBitVector()
+  {}
+  ~ObTestBitVector()
+  {}
+  virtual void SetUp()
+  {}
+  virtual void TearDown()
+  {}
+
+protected:
+  ObBitVector* alloc_bit_vector(const int64_t size)
+  {
+    ObBitVector* bv = to_bit_vector(alloc_.alloc(ObBitVector::memory_size(size)));
+    if (NULL != bv) {
+      bv->reset(size);
+    }
+    return bv;
+  }
+
+  ObArenaAllocator alloc_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(ObTestBitVector);
+};
+
+TEST_F(ObTestBitVector, basic)
+{
+  const int64_t size = 130;
+  EXPECT_EQ(3, ObBitVector::word_count(size));
+  EXPECT_EQ(24, ObBitVector::memory_size(size));
+
+  ObBitVector* bv = alloc_bit_vector(size);
+  ASSERT_TRUE(NULL != bv);
+  EXPECT_EQ(0, bv->accumulate_bit_cnt(size));
+
+  bv->set(0);
+  bv->set(63);
+  bv->set(64);
+  bv->set(129);
+  EXPECT_TRUE(bv->at(0));
+  EXPECT_TRUE(bv->at(63));
+  EXPECT_TRUE(bv->at(64));
+  EXPECT_TRUE(bv->at(129));
+  EXPECT_FALSE(bv->at(1));
+  EXPECT_FALSE(bv->at(128));
+  EXPECT_EQ(4, bv->accumulate_bit_cnt(size));
+  EXPECT_EQ(2, bv->accumulate_bit_cnt(64));
+
+  bv->unset(63);
+  bv->change(1, true);
+  bv->change(0, false);
+  EXPECT_FALSE(bv->at(63));
+  EXPECT_TRUE(bv->at(1));
+  EXPECT_FALSE(bv->at(0));
+  EXPECT_EQ(3, bv->accumulate_bit_cnt(size));
+
+  bv->set_all(size);
+  EXPECT_TRUE(bv->is_all_true(size));
+  EXPECT_EQ(size, bv->accumulate_bit_cnt(size));
+  // tail bits beyond size are cleared
+  EXPECT_FALSE(bv->at(130));
+  EXPECT_FALSE(bv->at(191));
+
+  bv->reset(size);
+  EXPECT_EQ(0, bv->accumulate_bit_cnt(size));
+}
+
+TEST_F(ObTestBitVector, bit_op)
+{
+  const int64_t size = 100;
+  ObBitVector* left = alloc_bit_vector(size);
+  ObBitVector* right = alloc_bit_vector(size);
+  ASSERT_TRUE(NULL != left && NULL != right);
+  for (int64_t i = 0; i < size; i++) {
+    if (0 == i % 2) {
+      left->set(i);
+    }
+    if (0 == i % 3) {
+      right->set(i);
+    }
+  }
+
+  ObBitVector* res = alloc_bit_vector(size);
+  ASSERT_TRUE(NULL != res);
+  res->deep_copy(*left, size);
+  res->bit_and(*right, size);
+  for (int64_t i = 0; i < size; i++) {
+    EXPECT_EQ(0 == i % 6, res->at(i));
+  }
+
+  res->deep_copy(*left, size);
+  res->bit_or(*right, size);
+  for (int64_t i = 0; i < size; i++) {
+    EXPECT_EQ(0 == i % 2 || 0 == i % 3, res->at(i));
+  }
+}
+
+TEST_F(ObTestBitVector, foreach_unset)
+{
+  const int64_t size = 200;
+  ObBitVector* skip = alloc_bit_vector(size);
+  ASSERT_TRUE(NULL != skip);
+  for (int64_t i = 0; i < size; i++) {
+    if (0 != i % 7) {
+      skip->set(i);
+    }
+  }
+  int64_t cnt = 0;
+  int64_t last = -1;
+  int ret = skip->foreach_unset(size, [&](int64_t idx) {
+    EXPECT_EQ(0, idx % 7);
+    EXPECT_LT(last, idx);
+    last = idx;
+    cnt++;
+    return OB_SUCCESS;
+  });
+  EXPECT_EQ(OB_SUCCESS, ret);
+  EXPECT_EQ((size + 6) / 7, cnt);
+
+  // stop at failure
+  cnt = 0;
+  ret = skip->foreach_unset(size, [&](int64_t idx) {
+    UNUSED(idx);
+    return ++cnt >= 3 ? OB_ITER_END : OB_SUCCESS;
+  });
+  EXPECT_EQ(OB_ITER_END, ret);
+  EXPECT_EQ(3, cnt);
+
+  // no bits beyond size iterated
+  skip->reset(size);
+  cnt = 0;
+  ret = skip->foreach_unset(size - 1, [&](int64_t idx) {
+    EXPECT_LT(idx, size - 1);
+    cnt++;
+    return OB_SUCCESS;
+  });
+  EXPECT_EQ(OB_SUCCESS, ret);
+  EXPECT_EQ(size - 1, cnt);
+}
+
+}  // namespace sql
+}  // namespace oceanbase
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  int ret = RUN_ALL_TESTS();
+  return ret;
+}
@@ -0,0 +1,115 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include "sql/plan_cache/ob_fast_parser_cache.h"
+#include "sql/plan_cache/ob_sql_parameterization.h"
+#include "lib/allocator/page_arena.h"
+
+using namespace oceanbase;
+using namespace common;
+using namespace sql;
+
+class TestFastParserCache : public ::testing::Test {
+public:
+  TestFastParserCache() : allocator_(ObModIds::TEST)
+  {}
+  virtual void SetUp()
+  {
+    ASSERT_EQ(OB_SUCCESS, cache_.init(allocator_));
+  }
+  virtual void TearDown()
+  {
+    cache_.destroy();
+  }
+
+protected:
+  int fast_parse(const ObString& sql, ObFastParserResult& fp_result)
+  {
+    return ObSqlParameterization::fast_parser(
+        allocator_, SMO_DEFAULT, ObCharset::get_system_collation(), sql, false, fp_result);
+  }
+  int get(const ObString& sql, ObFastParserResult& fp_result)
+  {
+    return cache_.get(sql, SMO_DEFAULT, ObCharset::get_system_collation(), false, allocator_, fp_result);
+  }
+  int put(const ObString& sql, const ObFastParserResult& fp_result)
+  {
+    return cache_.put(sql, SMO_DEFAULT, ObCharset::get_system_collation(), false, fp_result);
+  }
+
+protected:
+  ObArenaAllocator allocator_;
+  ObFastParserCache cache_;
+};
+
+TEST_F(TestFastParserCache, get_and_put)
+{
+  ObString sql = ObString::make_string("select * from t1 where c1 = 3 and c2 = 'abc' order by 1");
+  ObFastParserResult fp_result;
+  ObFastParserResult cached_result;
+  ASSERT_EQ(OB_SUCCESS, fast_parse(sql, fp_result));
+  ASSERT_EQ(3, fp_result.raw_params_.count());
+
+  // cached on the second miss
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, get(sql, cached_result));
+  ASSERT_EQ(OB_SUCCESS, put(sql, fp_result));
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, get(sql, cached_result));
+  ASSERT_EQ(OB_SUCCESS, put(sql, fp_result));
+  ASSERT_EQ(OB_SUCCESS, get(sql, cached_result));
+  ASSERT_EQ(3, cache_.get_access_cnt());
+  ASSERT_EQ(1, cache_.get_hit_cnt());
+
+  ASSERT_EQ(fp_result.pc_key_.name_, cached_result.pc_key_.name_);
+  ASSERT_EQ(fp_result.raw_params_.count(), cached_result.raw_params_.count());
+  for (int64_t i = 0; i < fp_result.raw_params_.count(); ++i) {
+    const ParseNode* node = fp_result.raw_params_.at(i)->node_;
+    const ParseNode* cached_node = cached_result.raw_params_.at(i)->node_;
+    ASSERT_NE(node, cached_node);
+    ASSERT_EQ(node->type_, cached_node->type_);
+    ASSERT_EQ(node->value_, cached_node->value_);
+    ASSERT_EQ(node->str_len_, cached_node->str_len_);
+    ASSERT_EQ(0, MEMCMP(node->str_value_, cached_node->str_value_, node->str_len_));
+    ASSERT_EQ(node->pos_, cached_node->pos_);
+  }
+
+  // other sql mode is another entry
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST,
+      cache_.get(sql, SMO_ORACLE, ObCharset::get_system_collation(), false, allocator_, cached_result));
+
+  cache_.clear();
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, get(sql, cached_result));
+  // counted since init, like the plan cache hit count
+  ASSERT_EQ(5, cache_.get_access_cnt());
+  ASSERT_EQ(1, cache_.get_hit_cnt());
+}
+
+TEST_F(TestFastParserCache, too_long)
+{
+  char buf[ObFastParserCache::MAX_SQL_LEN + 64];
+  int64_t pos = snprintf(buf, sizeof(buf), "select * from t1 where c1 = 'a");
+  MEMSET(buf + pos, 'a', sizeof(buf) - pos);
+  buf[sizeof(buf) - 2] = '\'';
+  ObString sql(sizeof(buf) - 1, buf);
+  ObFastParserResult fp_result;
+  ObFastParserResult cached_result;
+  ASSERT_EQ(OB_SUCCESS, fast_parse(sql, fp_result));
+  ASSERT_EQ(OB_SUCCESS, put(sql, fp_result));
+  ASSERT_EQ(OB_SUCCESS, put(sql, fp_result));
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, get(sql, cached_result));
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
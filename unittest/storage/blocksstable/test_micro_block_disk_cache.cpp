@@ -0,0 +1,238 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+#define private public
+#include "storage/blocksstable/ob_micro_block_disk_cache.h"
+#undef private
+
+namespace oceanbase {
+using namespace common;
+using namespace blocksstable;
+namespace unittest {
+
+// no store file in this test, every macro block but %dead_block_index_ is alive
+class MockMicroBlockDiskCache : public ObMicroBlockDiskCache {
+public:
+  MockMicroBlockDiskCache() : dead_block_index_(-1)
+  {}
+  int64_t dead_block_index_;
+
+protected:
+  virtual bool is_block_alive(const MacroBlockId& block_id) const override
+  {
+    return block_id.block_index() != dead_block_index_;
+  }
+};
+
+class TestMicroBlockDiskCache : public ::testing::Test {
+public:
+  static const int64_t FILE_SIZE = 64 * 1024 * 1024;
+  static const int64_t DATA_FILE_ID = 1000;
+  static const int64_t MICRO_BLOCK_SIZE = 16 * 1024;
+  static const int64_t BLOCK_CNT = 200;
+  TestMicroBlockDiskCache()
+  {
+    snprintf(file_path_, sizeof(file_path_), "./test_micro_block_disk_cache_%d.dat", getpid());
+  }
+  virtual void SetUp()
+  {
+    ::unlink(file_path_);
+    ASSERT_EQ(OB_SUCCESS, ObKVGlobalCache::get_instance().init(1024, 512L * 1024L * 1024L));
+    ASSERT_EQ(OB_SUCCESS, block_cache_.init("test_micro_disk_cache", 1));
+  }
+  virtual void TearDown()
+  {
+    block_cache_.destroy();
+    ObKVGlobalCache::get_instance().destroy();
+    ::unlink(file_path_);
+  }
+
+protected:
+  void make_key(const int64_t i, ObMicroBlockCacheKey& key)
+  {
+    key.set(combine_id(1, 3001), MacroBlockId(0, 0, 1, static_cast<int32_t>(1 + i / 8)), 0,
+        (i % 8) * MICRO_BLOCK_SIZE, MICRO_BLOCK_SIZE);
+  }
+  void make_block(const int64_t i, char* buf)
+  {
+    for (int64_t j = 0; j < MICRO_BLOCK_SIZE; ++j) {
+      buf[j] = static_cast<char>((i * 31 + j) & 0xFF);
+    }
+  }
+  void put_blocks(ObMicroBlockDiskCache& disk_cache)
+  {
+    char buf[MICRO_BLOCK_SIZE];
+    ObMicroBlockCacheKey key;
+    for (int64_t i = 0; i < BLOCK_CNT; ++i) {
+      make_key(i, key);
+      make_block(i, buf);
+      int ret = OB_EAGAIN;
+      // dropped if the background thread is switching the segment buffers
+      while (OB_EAGAIN == (ret = disk_cache.put(key, buf, MICRO_BLOCK_SIZE))) {
+        usleep(1000);
+      }
+      ASSERT_EQ(OB_SUCCESS, ret);
+    }
+    ASSERT_EQ(OB_SUCCESS, disk_cache.flush());
+  }
+  // %hit_cnt blocks are read from disk cache and put into memory cache
+  void check_blocks(ObMicroBlockDiskCache& disk_cache, int64_t& hit_cnt)
+  {
+    char buf[MICRO_BLOCK_SIZE];
+    ObMicroBlockCacheKey key;
+    hit_cnt = 0;
+    for (int64_t i = 0; i < BLOCK_CNT; ++i) {
+      const ObMicroBlockCacheValue* micro_block = NULL;
+      ObKVCacheHandle handle;
+      make_key(i, key);
+      make_block(i, buf);
+      const int ret = disk_cache.get(key, block_cache_, micro_block, handle);
+      if (OB_SUCCESS == ret) {
+        ASSERT_TRUE(NULL != micro_block);
+        ASSERT_EQ(MICRO_BLOCK_SIZE, micro_block->get_block_data().get_buf_size());
+        ASSERT_EQ(0, MEMCMP(buf, micro_block->get_block_data().get_buf(), MICRO_BLOCK_SIZE));
+        ++hit_cnt;
+        const ObMicroBlockCacheValue* cached = NULL;
+        ObKVCacheHandle cache_handle;
+        ASSERT_EQ(OB_SUCCESS, block_cache_.get(key, cached, cache_handle));
+        ASSERT_EQ(0, MEMCMP(buf, cached->get_block_data().get_buf(), MICRO_BLOCK_SIZE));
+        ASSERT_EQ(OB_SUCCESS, block_cache_.erase(key));
+      } else {
+        ASSERT_EQ(OB_ENTRY_NOT_EXIST, ret);
+      }
+    }
+  }
+
+protected:
+  char file_path_[128];
+  ObMicroBlockCache block_cache_;
+};
+
+TEST_F(TestMicroBlockDiskCache, put_and_get)
+{
+  MockMicroBlockDiskCache disk_cache;
+  int64_t hit_cnt = 0;
+  ASSERT_EQ(OB_INVALID_ARGUMENT, disk_cache.open(file_path_, FILE_SIZE / 2, DATA_FILE_ID));
+  ASSERT_FALSE(disk_cache.is_enabled());
+  ASSERT_EQ(OB_SUCCESS, disk_cache.open(file_path_, FILE_SIZE, DATA_FILE_ID));
+  ASSERT_TRUE(disk_cache.is_enabled());
+  ASSERT_EQ(OB_INIT_TWICE, disk_cache.open(file_path_, FILE_SIZE, DATA_FILE_ID));
+  check_blocks(disk_cache, hit_cnt);
+  ASSERT_EQ(0, hit_cnt);
+  put_blocks(disk_cache);
+  check_blocks(disk_cache, hit_cnt);
+  ASSERT_EQ(BLOCK_CNT, hit_cnt);
+
+  // put again is skipped by the background thread, nothing is written
+  char buf[MICRO_BLOCK_SIZE];
+  ObMicroBlockCacheKey key;
+  const int64_t segment_write_cnt = disk_cache.segment_write_cnt_;
+  make_key(0, key);
+  make_block(0, buf);
+  ASSERT_EQ(OB_SUCCESS, disk_cache.put(key, buf, MICRO_BLOCK_SIZE));
+  ASSERT_EQ(OB_SUCCESS, disk_cache.flush());
+  ASSERT_EQ(1, disk_cache.skip_cnt_);
+  ASSERT_EQ(segment_write_cnt, disk_cache.segment_write_cnt_);
+  disk_cache.destroy();
+}
+
+TEST_F(TestMicroBlockDiskCache, reopen)
+{
+  int64_t hit_cnt = 0;
+  {
+    MockMicroBlockDiskCache disk_cache;
+    ASSERT_EQ(OB_SUCCESS, disk_cache.open(file_path_, FILE_SIZE, DATA_FILE_ID));
+    put_blocks(disk_cache);
+  }
+  {
+    MockMicroBlockDiskCache disk_cache;
+    ASSERT_EQ(OB_SUCCESS, disk_cache.open(file_path_, FILE_SIZE, DATA_FILE_ID));
+    check_blocks(disk_cache, hit_cnt);
+    ASSERT_EQ(BLOCK_CNT, hit_cnt);
+  }
+  {
+    // made for another data file
+    MockMicroBlockDiskCache disk_cache;
+    ASSERT_EQ(OB_SUCCESS, disk_cache.open(file_path_, FILE_SIZE, DATA_FILE_ID + 1));
+    check_blocks(disk_cache, hit_cnt);
+    ASSERT_EQ(0, hit_cnt);
+  }
+}
+
+TEST_F(TestMicroBlockDiskCache, invalidate_blocks)
+{
+  int64_t hit_cnt = 0;
+  ObArray<uint32_t> block_indexes;
+  // 8 micro blocks in every macro block
+  ASSERT_EQ(OB_SUCCESS, block_indexes.push_back(1));
+  ASSERT_EQ(OB_SUCCESS, block_indexes.push_back(2));
+  {
+    MockMicroBlockDiskCache disk_cache;
+    ASSERT_EQ(OB_SUCCESS, disk_cache.open(file_path_, FILE_SIZE, DATA_FILE_ID));
+    put_blocks(disk_cache);
+    disk_cache.invalidate_blocks(block_indexes);
+    check_blocks(disk_cache, hit_cnt);
+    ASSERT_EQ(BLOCK_CNT - 16, hit_cnt);
+  }
+  {
+    // generations are persisted
+    MockMicroBlockDiskCache disk_cache;
+    ASSERT_EQ(OB_SUCCESS, disk_cache.open(file_path_, FILE_SIZE, DATA_FILE_ID));
+    check_blocks(disk_cache, hit_cnt);
+    ASSERT_EQ(BLOCK_CNT - 16, hit_cnt);
+  }
+}
+
+TEST_F(TestMicroBlockDiskCache, skip_dead_blocks)
+{
+  MockMicroBlockDiskCache disk_cache;
+  int64_t hit_cnt = 0;
+  ASSERT_EQ(OB_SUCCESS, disk_cache.open(file_path_, FILE_SIZE, DATA_FILE_ID));
+  // macro block 2 is freed after its micro blocks are buffered, they are not written
+  disk_cache.dead_block_index_ = 2;
+  put_blocks(disk_cache);
+  ASSERT_EQ(8, disk_cache.skip_cnt_);
+  disk_cache.dead_block_index_ = -1;
+  check_blocks(disk_cache, hit_cnt);
+  ASSERT_EQ(BLOCK_CNT - 8, hit_cnt);
+}
+
+TEST_F(TestMicroBlockDiskCache, on_wash)
+{
+  MockMicroBlockDiskCache disk_cache;
+  int64_t hit_cnt = 0;
+  char buf[MICRO_BLOCK_SIZE];
+  ObMicroBlockCacheKey key;
+  ASSERT_EQ(OB_SUCCESS, disk_cache.open(file_path_, FILE_SIZE, DATA_FILE_ID));
+  // fit in one segment buffer, none is dropped
+  for (int64_t i = 0; i < BLOCK_CNT / 2; ++i) {
+    make_key(i, key);
+    make_block(i, buf);
+    ObMicroBlockCacheValue value(buf, MICRO_BLOCK_SIZE);
+    disk_cache.on_wash(key, value);
+  }
+  ASSERT_EQ(OB_SUCCESS, disk_cache.flush());
+  check_blocks(disk_cache, hit_cnt);
+  ASSERT_EQ(BLOCK_CNT / 2, hit_cnt);
+}
+
+}  // end namespace unittest
+}  // end namespace oceanbase
+
+int main(int argc, char** argv)
+{
+  OB_LOGGER.set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,358 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+
+#define private public
+#define protected public
+#include "storage/blocksstable/ob_micro_block_encoder.h"
+#include "storage/blocksstable/ob_micro_block_decoder.h"
+#include "storage/blocksstable/ob_column_map.h"
+#include "storage/blocksstable/ob_macro_block.h"
+#include "share/ob_cluster_version.h"
+#include "share/config/ob_server_config.h"
+#include "storage/ob_i_store.h"
+#include "sql/engine/basic/ob_pushdown_filter.h"
+#include "lib/container/ob_bitmap.h"
+
+namespace oceanbase {
+using namespace common;
+using namespace blocksstable;
+using namespace storage;
+using namespace share::schema;
+
+namespace unittest {
+class TestMicroBlockEncoding : public ::testing::Test {
+public:
+  static const int64_t rowkey_column_count = 1;
+  static const int64_t column_num = 6;
+  static const int64_t row_num = 200;
+  static const int64_t macro_block_size = 2L * 1024 * 1024L;
+
+public:
+  TestMicroBlockEncoding() : allocator_(ObModIds::TEST)
+  {}
+  void SetUp();
+  virtual void TearDown()
+  {}
+  // c0: rowkey, c1: const, c2: common prefix, c3: few distinct strings, c4: nullable, c5: long runs
+  void make_row(const int64_t i, ObStoreRow& row);
+  void build_block(char*& buf, int64_t& size);
+  void check_filter(ObMicroBlockDecoder& decoder, const int64_t col_idx, const sql::ObWhiteFilterOperatorType op,
+      const ObObj& param, const int64_t begin, const int64_t count);
+
+protected:
+  ObObjMeta column_types_[column_num];
+  ObColumnMap column_map_;
+  ObArenaAllocator allocator_;
+  ObMicroBlockEncoder encoder_;
+  ObObj objs_[column_num];
+  char str_buf_[row_num][32];
+};
+
+void TestMicroBlockEncoding::SetUp()
+{
+  ObArray<ObColDesc> columns;
+  ObColDesc col_desc;
+  for (int64_t i = 0; i < column_num; ++i) {
+    if (2 == i || 3 == i) {
+      column_types_[i].set_varchar();
+      column_types_[i].set_collation_type(CS_TYPE_UTF8MB4_GENERAL_CI);
+    } else {
+      column_types_[i].set_int();
+    }
+    col_desc.col_id_ = static_cast<int32_t>(i + OB_APP_MIN_COLUMN_ID);
+    col_desc.col_type_ = column_types_[i];
+    ASSERT_EQ(OB_SUCCESS, columns.push_back(col_desc));
+  }
+  ASSERT_EQ(OB_SUCCESS, column_map_.init(allocator_, 1, rowkey_column_count, column_num, columns));
+}
+
+void TestMicroBlockEncoding::make_row(const int64_t i, ObStoreRow& row)
+{
+  static const char* dict[] = {"beijing", "hangzhou", "shanghai"};
+  row.flag_ = ObActionFlag::OP_ROW_EXIST;
+  row.row_val_.cells_ = objs_;
+  row.row_val_.count_ = column_num;
+  objs_[0].set_int(1000 + i * 3);
+  objs_[1].set_int(7);
+  snprintf(str_buf_[i], sizeof(str_buf_[i]), "user_name_%08ld", i);
+  objs_[2].set_varchar(str_buf_[i], static_cast<int32_t>(strlen(str_buf_[i])));
+  objs_[2].set_collation_type(CS_TYPE_UTF8MB4_GENERAL_CI);
+  objs_[3].set_varchar(dict[i % 3], static_cast<int32_t>(strlen(dict[i % 3])));
+  objs_[3].set_collation_type(CS_TYPE_UTF8MB4_GENERAL_CI);
+  if (0 == i % 3) {
+    objs_[4].set_null();
+  } else {
+    objs_[4].set_int(-i);
+  }
+  objs_[5].set_int(i / 50);
+}
+
+void TestMicroBlockEncoding::build_block(char*& buf, int64_t& size)
+{
+  ObStoreRow row;
+  ASSERT_EQ(OB_SUCCESS, encoder_.init(macro_block_size, rowkey_column_count, column_num, column_types_));
+  for (int64_t i = 0; i < row_num; ++i) {
+    make_row(i, row);
+    ASSERT_EQ(OB_SUCCESS, encoder_.append_row(row));
+  }
+  ASSERT_EQ(OB_SUCCESS, encoder_.build_block(buf, size));
+  ASSERT_EQ(row_num, encoder_.get_row_count());
+}
+
+void TestMicroBlockEncoding::check_filter(ObMicroBlockDecoder& decoder, const int64_t col_idx,
+    const sql::ObWhiteFilterOperatorType op, const ObObj& param, const int64_t begin, const int64_t count)
+{
+  sql::ObPushdownWhiteFilterNode node(allocator_);
+  node.op_type_ = op;
+  sql::ObWhiteFilterExecutor filter(allocator_, node);
+  filter.param_ = param;
+  ObBitmap bitmap(allocator_);
+  ObStoreRow expect;
+  bool filtered = false;
+  ASSERT_EQ(OB_SUCCESS, bitmap.init(count));
+  ASSERT_EQ(OB_SUCCESS, decoder.filter_pushdown_filter(filter, col_idx, begin, count, bitmap));
+  for (int64_t i = 0; i < count; ++i) {
+    make_row(begin + i, expect);
+    ASSERT_EQ(OB_SUCCESS, filter.filter(expect.row_val_.cells_[col_idx], filtered));
+    ASSERT_EQ(!filtered, bitmap.test(i)) << "row: " << begin + i << " column: " << col_idx;
+  }
+}
+
+TEST_F(TestMicroBlockEncoding, test_column_encoding_type)
+{
+  char* buf = NULL;
+  int64_t size = 0;
+  build_block(buf, size);
+  ObMicroBlockDecoder decoder;
+  ASSERT_EQ(OB_SUCCESS, decoder.init(ObMicroBlockData(buf, size), &column_map_));
+  ASSERT_EQ(column_num, decoder.column_count_);
+  ASSERT_EQ(OB_ENCODING_INTEGER, decoder.decoders_[0].header_.type_);
+  ASSERT_EQ(OB_ENCODING_CONST, decoder.decoders_[1].header_.type_);
+  ASSERT_EQ(OB_ENCODING_PREFIX, decoder.decoders_[2].header_.type_);
+  ASSERT_EQ(OB_ENCODING_DICT, decoder.decoders_[3].header_.type_);
+  ASSERT_TRUE(decoder.decoders_[4].header_.has_null());
+  ASSERT_EQ(OB_ENCODING_RLE, decoder.decoders_[5].header_.type_);
+  // encoded block should be much smaller than the flat one
+  ASSERT_LT(size, encoder_.flat_writer_.get_data_size());
+}
+
+TEST_F(TestMicroBlockEncoding, test_get_row)
+{
+  char* buf = NULL;
+  int64_t size = 0;
+  build_block(buf, size);
+  ObMicroBlockDecoder decoder;
+  ASSERT_EQ(OB_SUCCESS, decoder.init(ObMicroBlockData(buf, size), &column_map_));
+  int64_t row_count = 0;
+  ASSERT_EQ(OB_SUCCESS, decoder.get_row_count(row_count));
+  ASSERT_EQ(row_num, row_count);
+
+  ObObj cells[column_num];
+  ObStoreRow row;
+  ObStoreRow expect;
+  for (int64_t i = 0; i < row_num; ++i) {
+    row.row_val_.cells_ = cells;
+    row.row_val_.count_ = column_num;
+    ASSERT_EQ(OB_SUCCESS, decoder.get_row(i, row));
+    make_row(i, expect);
+    ASSERT_EQ(ObActionFlag::OP_ROW_EXIST, row.flag_);
+    for (int64_t j = 0; j < column_num; ++j) {
+      ASSERT_TRUE(expect.row_val_.cells_[j] == row.row_val_.cells_[j]) << "row: " << i << " column: " << j;
+    }
+  }
+}
+
+TEST_F(TestMicroBlockEncoding, test_get_rows_and_column)
+{
+  char* buf = NULL;
+  int64_t size = 0;
+  build_block(buf, size);
+  ObMicroBlockDecoder decoder;
+  ASSERT_EQ(OB_SUCCESS, decoder.init(ObMicroBlockData(buf, size), &column_map_));
+
+  ObObj cells[row_num][column_num];
+  ObStoreRow rows[row_num];
+  for (int64_t i = 0; i < row_num; ++i) {
+    rows[i].row_val_.cells_ = cells[i];
+    rows[i].row_val_.count_ = column_num;
+  }
+  int64_t row_count = 0;
+  ObStoreRow expect;
+  ASSERT_EQ(OB_SUCCESS, decoder.get_rows(0, row_num, row_num, rows, row_count));
+  ASSERT_EQ(row_num, row_count);
+  for (int64_t i = 0; i < row_num; ++i) {
+    make_row(i, expect);
+    for (int64_t j = 0; j < column_num; ++j) {
+      ASSERT_TRUE(expect.row_val_.cells_[j] == rows[i].row_val_.cells_[j]) << "row: " << i << " column: " << j;
+    }
+  }
+
+  // reverse
+  ASSERT_EQ(OB_SUCCESS, decoder.get_rows(row_num - 1, -1, row_num, rows, row_count));
+  ASSERT_EQ(row_num, row_count);
+  for (int64_t i = 0; i < row_num; ++i) {
+    make_row(row_num - 1 - i, expect);
+    ASSERT_TRUE(expect.row_val_.cells_[0] == rows[i].row_val_.cells_[0]);
+  }
+
+  // single column
+  ObObj column[row_num];
+  ASSERT_EQ(OB_SUCCESS, decoder.get_column(2, 10, row_num, column));
+  for (int64_t i = 10; i < row_num; ++i) {
+    make_row(i, expect);
+    ASSERT_TRUE(expect.row_val_.cells_[2] == column[i - 10]);
+  }
+  ASSERT_EQ(OB_INVALID_ARGUMENT, decoder.get_column(column_num, 0, row_num, column));
+}
+
+TEST_F(TestMicroBlockEncoding, test_locate_rowkey)
+{
+  char* buf = NULL;
+  int64_t size = 0;
+  build_block(buf, size);
+  ObMicroBlockEncodingGetReader get_reader;
+  ObMicroBlockData block(buf, size);
+  ObObj rowkey_obj;
+  int64_t row_idx = 0;
+
+  ASSERT_EQ(OB_SUCCESS, get_reader.decoder_.init(block));
+  rowkey_obj.set_int(1000 + 77 * 3);
+  ASSERT_EQ(OB_SUCCESS, get_reader.locate_row(ObStoreRowkey(&rowkey_obj, 1), NULL, row_idx));
+  ASSERT_EQ(77, row_idx);
+  rowkey_obj.set_int(1000 + 77 * 3 + 1);
+  ASSERT_EQ(OB_BEYOND_THE_RANGE, get_reader.locate_row(ObStoreRowkey(&rowkey_obj, 1), NULL, row_idx));
+
+  ObMicroBlockDecoder decoder;
+  bool equal = false;
+  ASSERT_EQ(OB_SUCCESS, decoder.init(block, &column_map_));
+  ASSERT_EQ(OB_SUCCESS, decoder.find_bound(ObStoreRowkey(&rowkey_obj, 1), true, 0, row_num, row_idx, equal));
+  ASSERT_EQ(78, row_idx);
+  ASSERT_FALSE(equal);
+}
+
+TEST_F(TestMicroBlockEncoding, test_filter_pushdown)
+{
+  char* buf = NULL;
+  int64_t size = 0;
+  build_block(buf, size);
+  ObMicroBlockDecoder decoder;
+  ASSERT_EQ(OB_SUCCESS, decoder.init(ObMicroBlockData(buf, size), &column_map_));
+
+  ObObj param;
+  // const column
+  param.set_int(7);
+  check_filter(decoder, 1, sql::WHITE_OP_EQ, param, 0, row_num);
+  check_filter(decoder, 1, sql::WHITE_OP_NE, param, 0, row_num);
+  // dict column
+  param.set_varchar("hangzhou");
+  param.set_collation_type(CS_TYPE_UTF8MB4_GENERAL_CI);
+  check_filter(decoder, 3, sql::WHITE_OP_EQ, param, 0, row_num);
+  check_filter(decoder, 3, sql::WHITE_OP_GT, param, 17, 100);
+  // rle column, range starts in the middle of a run
+  param.set_int(2);
+  check_filter(decoder, 5, sql::WHITE_OP_LT, param, 33, 150);
+  check_filter(decoder, 5, sql::WHITE_OP_GE, param, 0, row_num);
+  // nullable column
+  param.set_int(-100);
+  check_filter(decoder, 4, sql::WHITE_OP_LE, param, 0, row_num);
+  check_filter(decoder, 4, sql::WHITE_OP_NU, param, 0, row_num);
+  check_filter(decoder, 4, sql::WHITE_OP_NN, param, 5, 60);
+  // prefix column is evaluated cell by cell
+  param.set_varchar("user_name_00000150");
+  param.set_collation_type(CS_TYPE_UTF8MB4_GENERAL_CI);
+  check_filter(decoder, 2, sql::WHITE_OP_GE, param, 0, row_num);
+
+  ObBitmap bitmap(allocator_);
+  sql::ObPushdownWhiteFilterNode node(allocator_);
+  sql::ObWhiteFilterExecutor filter(allocator_, node);
+  ASSERT_EQ(OB_SUCCESS, bitmap.init(row_num));
+  ASSERT_EQ(OB_INVALID_ARGUMENT, decoder.filter_pushdown_filter(filter, column_num, 0, row_num, bitmap));
+  ASSERT_EQ(OB_INVALID_ARGUMENT, decoder.filter_pushdown_filter(filter, 1, 1, row_num, bitmap));
+}
+
+TEST_F(TestMicroBlockEncoding, test_all_null_column)
+{
+  ObStoreRow row;
+  ObMicroBlockEncoder encoder;
+  ASSERT_EQ(OB_SUCCESS, encoder.init(macro_block_size, rowkey_column_count, column_num, column_types_));
+  for (int64_t i = 0; i < 10; ++i) {
+    make_row(i, row);
+    objs_[4].set_null();
+    ASSERT_EQ(OB_SUCCESS, encoder.append_row(row));
+  }
+  char* buf = NULL;
+  int64_t size = 0;
+  ASSERT_EQ(OB_SUCCESS, encoder.build_block(buf, size));
+  ObMicroBlockDecoder decoder;
+  ObObj cell;
+  ASSERT_EQ(OB_SUCCESS, decoder.init(ObMicroBlockData(buf, size)));
+  ASSERT_TRUE(decoder.decoders_[4].header_.is_all_null());
+  for (int64_t i = 0; i < 10; ++i) {
+    ASSERT_EQ(OB_SUCCESS, decoder.get_cell(i, 4, cell));
+    ASSERT_TRUE(cell.is_null());
+  }
+}
+
+TEST_F(TestMicroBlockEncoding, test_row_store_type)
+{
+  // legacy encoding formats keep the reserved type in schema, encoding is a block type only
+  ASSERT_EQ(RESERVED_ROW_STORE, ObStoreFormat::get_row_store_type(OB_STORE_FORMAT_RESERVED1_MYSQL));
+  ASSERT_EQ(RESERVED_ROW_STORE, ObStoreFormat::get_row_store_type(OB_STORE_FORMAT_RESERVED1_ORACLE));
+  ASSERT_FALSE(ObStoreFormat::is_row_store_type_valid(ENCODING_ROW_STORE));
+  ASSERT_TRUE(ObStoreFormat::is_block_row_store_type_valid(ENCODING_ROW_STORE));
+  ObRowStoreType row_store_type = MAX_ROW_STORE;
+  ASSERT_NE(OB_SUCCESS,
+      ObStoreFormat::find_row_store_type(ObString::make_string("encoding_row_store"), row_store_type));
+
+  ObTableSchema table_schema;
+  table_schema.set_table_id(combine_id(1, 3001));
+  table_schema.set_row_store_type(RESERVED_ROW_STORE);
+  ObDataStoreDesc* desc = new ObDataStoreDesc();
+  desc->need_index_tree_ = false;
+  // off by default
+  ASSERT_EQ(OB_SUCCESS, desc->cal_row_store_type(table_schema, MAJOR_MERGE));
+  ASSERT_EQ(FLAT_ROW_STORE, desc->row_store_type_);
+
+  // not before every observer reads encoded blocks
+  GCONF._enable_micro_block_encoding.set_value("True");
+  ObClusterVersion::get_instance().update_cluster_version(CLUSTER_VERSION_312);
+  ASSERT_EQ(OB_SUCCESS, desc->cal_row_store_type(table_schema, MAJOR_MERGE));
+  ASSERT_EQ(FLAT_ROW_STORE, desc->row_store_type_);
+
+  ObClusterVersion::get_instance().update_cluster_version(CLUSTER_VERSION_313);
+  ASSERT_EQ(OB_SUCCESS, desc->cal_row_store_type(table_schema, MAJOR_MERGE));
+  ASSERT_EQ(ENCODING_ROW_STORE, desc->row_store_type_);
+  // index tree and tables of other formats stay flat
+  desc->need_index_tree_ = true;
+  ASSERT_EQ(OB_SUCCESS, desc->cal_row_store_type(table_schema, MAJOR_MERGE));
+  ASSERT_EQ(FLAT_ROW_STORE, desc->row_store_type_);
+  desc->need_index_tree_ = false;
+  table_schema.set_row_store_type(FLAT_ROW_STORE);
+  ASSERT_EQ(OB_SUCCESS, desc->cal_row_store_type(table_schema, MAJOR_MERGE));
+  ASSERT_EQ(FLAT_ROW_STORE, desc->row_store_type_);
+  GCONF._enable_micro_block_encoding.set_value("False");
+  delete desc;
+}
+
+}  // end namespace unittest
+}  // end namespace oceanbase
+
+int main(int argc, char** argv)
+{
+  system("rm -f test_micro_block_encoding.log*");
+  OB_LOGGER.set_file_name("test_micro_block_encoding.log");
+  OB_LOGGER.set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
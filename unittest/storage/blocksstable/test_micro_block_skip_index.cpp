@@ -0,0 +1,292 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#define private public
+#define protected public
+#include "storage/blocksstable/ob_micro_block_skip_index.h"
+#include "storage/blocksstable/ob_data_buffer.h"
+#include "storage/blocksstable/ob_block_sstable_struct.h"
+#include "sql/engine/basic/ob_pushdown_filter.h"
+
+namespace oceanbase {
+using namespace common;
+using namespace blocksstable;
+
+namespace unittest {
+class TestMicroBlockSkipIndex : public ::testing::Test {
+public:
+  // c0: hidden column, c1: int rowkey, c2: nullable double, c3: varchar (not indexed)
+  static const int64_t column_num = 4;
+  static const int64_t micro_row_num = 100;
+  static const int64_t micro_block_num = 3;
+
+public:
+  TestMicroBlockSkipIndex() : allocator_(ObModIds::TEST), buf_(0, "TestSkipIndex")
+  {}
+  void SetUp();
+  virtual void TearDown()
+  {}
+  void make_row(const int64_t i, ObNewRow& row);
+  void check_skip(const int64_t micro_idx, const uint64_t column_id, const sql::ObWhiteFilterOperatorType op,
+      const ObObj& param, const bool expect_skip);
+
+protected:
+  uint64_t column_ids_[column_num];
+  ObObjMeta column_types_[column_num];
+  ObObj cells_[column_num];
+  ObArenaAllocator allocator_;
+  ObSelfBufferWriter buf_;
+  ObMicroBlockSkipIndex skip_index_;
+};
+
+void TestMicroBlockSkipIndex::SetUp()
+{
+  ObSkipIndexAggregator aggr;
+  ObNewRow row;
+  const char* entry = NULL;
+  int64_t entry_size = 0;
+  column_ids_[0] = OB_HIDDEN_TRANS_VERSION_COLUMN_ID;
+  column_ids_[1] = OB_APP_MIN_COLUMN_ID;
+  column_ids_[2] = OB_APP_MIN_COLUMN_ID + 1;
+  column_ids_[3] = OB_APP_MIN_COLUMN_ID + 2;
+  column_types_[0].set_int();
+  column_types_[1].set_int();
+  column_types_[2].set_double();
+  column_types_[3].set_varchar();
+  column_types_[3].set_collation_type(CS_TYPE_UTF8MB4_BIN);
+
+  ASSERT_EQ(OB_SUCCESS, aggr.init(column_ids_, column_types_, column_num));
+  ASSERT_EQ(2, aggr.get_column_count());
+  ASSERT_EQ(OB_SUCCESS, buf_.ensure_space(OB_DEFAULT_MACRO_BLOCK_SIZE));
+  ASSERT_EQ(OB_SUCCESS, buf_.write(aggr.get_header(), aggr.get_header_size()));
+  for (int64_t micro_idx = 0; micro_idx < micro_block_num; ++micro_idx) {
+    // the last micro block is reused by merge and its rows are not iterated
+    const bool is_reused = micro_block_num - 1 == micro_idx;
+    for (int64_t i = 0; !is_reused && i < micro_row_num; ++i) {
+      make_row(micro_idx * micro_row_num + i, row);
+      ASSERT_EQ(OB_SUCCESS, aggr.update(row));
+    }
+    ASSERT_EQ(OB_SUCCESS, aggr.get_entry(micro_row_num, entry, entry_size));
+    ASSERT_EQ(aggr.get_entry_size(), entry_size);
+    ASSERT_EQ(OB_SUCCESS, buf_.write(entry, entry_size));
+    aggr.reuse();
+  }
+  ASSERT_EQ(OB_SUCCESS, skip_index_.init(buf_.data(), buf_.length(), micro_block_num));
+}
+
+void TestMicroBlockSkipIndex::make_row(const int64_t i, ObNewRow& row)
+{
+  cells_[0].set_int(-i);
+  cells_[1].set_int(i);
+  // c2 is null in the first micro block
+  if (i < micro_row_num) {
+    cells_[2].set_null();
+  } else {
+    cells_[2].set_double(static_cast<double>(i % micro_row_num) / 2);
+  }
+  cells_[3].set_varchar("hangzhou");
+  cells_[3].set_collation_type(CS_TYPE_UTF8MB4_BIN);
+  row.cells_ = cells_;
+  row.count_ = column_num;
+}
+
+void TestMicroBlockSkipIndex::check_skip(const int64_t micro_idx, const uint64_t column_id,
+    const sql::ObWhiteFilterOperatorType op, const ObObj& param, const bool expect_skip)
+{
+  sql::ObPushdownWhiteFilterNode node(allocator_);
+  node.op_type_ = op;
+  ASSERT_EQ(OB_SUCCESS, node.col_ids_.init(1));
+  ASSERT_EQ(OB_SUCCESS, node.col_ids_.push_back(column_id));
+  sql::ObWhiteFilterExecutor filter(allocator_, node);
+  filter.set_type(sql::WHITE_FILTER_EXECUTOR);
+  filter.param_ = param;
+  bool can_skip = !expect_skip;
+  ASSERT_EQ(OB_SUCCESS, skip_index_.check_skip(micro_idx, filter, can_skip));
+  ASSERT_EQ(expect_skip, can_skip) << "micro: " << micro_idx << " column: " << column_id << " op: " << op;
+}
+
+TEST_F(TestMicroBlockSkipIndex, test_column_stat)
+{
+  ObSkipIndexColumnStat stat;
+  bool found = false;
+  // hidden and varchar columns are not indexed
+  ASSERT_EQ(OB_SUCCESS, skip_index_.get_column_stat(0, OB_HIDDEN_TRANS_VERSION_COLUMN_ID, stat, found));
+  ASSERT_FALSE(found);
+  ASSERT_EQ(OB_SUCCESS, skip_index_.get_column_stat(0, OB_APP_MIN_COLUMN_ID + 2, stat, found));
+  ASSERT_FALSE(found);
+
+  ASSERT_EQ(OB_SUCCESS, skip_index_.get_column_stat(1, OB_APP_MIN_COLUMN_ID, stat, found));
+  ASSERT_TRUE(found);
+  ASSERT_EQ(micro_row_num, stat.row_count_);
+  ASSERT_EQ(0, stat.null_count_);
+  ASSERT_TRUE(stat.has_min_max_);
+  ASSERT_EQ(micro_row_num, stat.min_.get_int());
+  ASSERT_EQ(2 * micro_row_num - 1, stat.max_.get_int());
+
+  ASSERT_EQ(OB_SUCCESS, skip_index_.get_column_stat(0, OB_APP_MIN_COLUMN_ID + 1, stat, found));
+  ASSERT_TRUE(found);
+  ASSERT_EQ(micro_row_num, stat.null_count_);
+  ASSERT_FALSE(stat.has_min_max_);
+
+  // reused micro block has no aggregates
+  ASSERT_EQ(OB_SUCCESS, skip_index_.get_column_stat(2, OB_APP_MIN_COLUMN_ID, stat, found));
+  ASSERT_FALSE(found);
+  ASSERT_EQ(OB_SUCCESS, skip_index_.get_macro_column_stat(OB_APP_MIN_COLUMN_ID, stat, found));
+  ASSERT_FALSE(found);
+}
+
+TEST_F(TestMicroBlockSkipIndex, test_macro_column_stat)
+{
+  ObSkipIndexColumnStat stat;
+  bool found = false;
+  ObMicroBlockSkipIndex skip_index;
+  // the first two micro blocks only
+  const int64_t size = skip_index_.entries_ - buf_.data() + 2 * skip_index_.entry_size_;
+  ASSERT_EQ(OB_SUCCESS, skip_index.init(buf_.data(), size, 2));
+  ASSERT_EQ(OB_SUCCESS, skip_index.get_macro_column_stat(OB_APP_MIN_COLUMN_ID, stat, found));
+  ASSERT_TRUE(found);
+  ASSERT_EQ(2 * micro_row_num, stat.row_count_);
+  ASSERT_EQ(0, stat.min_.get_int());
+  ASSERT_EQ(2 * micro_row_num - 1, stat.max_.get_int());
+  ASSERT_EQ(OB_SUCCESS, skip_index.get_macro_column_stat(OB_APP_MIN_COLUMN_ID + 1, stat, found));
+  ASSERT_TRUE(found);
+  ASSERT_EQ(micro_row_num, stat.null_count_);
+  ASSERT_EQ(micro_row_num, stat.get_not_null_count());
+  ASSERT_EQ(0, stat.min_.get_double());
+  ASSERT_EQ(static_cast<double>(micro_row_num - 1) / 2, stat.max_.get_double());
+
+  ASSERT_NE(OB_SUCCESS, skip_index.init(buf_.data(), size - 1, 2));
+}
+
+TEST_F(TestMicroBlockSkipIndex, test_check_skip)
+{
+  ObObj param;
+  // micro block 1 holds c1 in [100, 199]
+  param.set_int(99);
+  check_skip(1, OB_APP_MIN_COLUMN_ID, sql::WHITE_OP_EQ, param, true);
+  check_skip(1, OB_APP_MIN_COLUMN_ID, sql::WHITE_OP_LT, param, true);
+  check_skip(1, OB_APP_MIN_COLUMN_ID, sql::WHITE_OP_LE, param, true);
+  check_skip(1, OB_APP_MIN_COLUMN_ID, sql::WHITE_OP_GT, param, false);
+  check_skip(1, OB_APP_MIN_COLUMN_ID, sql::WHITE_OP_NE, param, false);
+  param.set_int(100);
+  check_skip(1, OB_APP_MIN_COLUMN_ID, sql::WHITE_OP_EQ, param, false);
+  check_skip(1, OB_APP_MIN_COLUMN_ID, sql::WHITE_OP_LT, param, true);
+  check_skip(1, OB_APP_MIN_COLUMN_ID, sql::WHITE_OP_LE, param, false);
+  param.set_int(199);
+  check_skip(1, OB_APP_MIN_COLUMN_ID, sql::WHITE_OP_GT, param, true);
+  check_skip(1, OB_APP_MIN_COLUMN_ID, sql::WHITE_OP_GE, param, false);
+  param.set_int(200);
+  check_skip(1, OB_APP_MIN_COLUMN_ID, sql::WHITE_OP_GE, param, true);
+  check_skip(1, OB_APP_MIN_COLUMN_ID, sql::WHITE_OP_NU, param, true);
+  check_skip(1, OB_APP_MIN_COLUMN_ID, sql::WHITE_OP_NN, param, false);
+
+  // c2 is all null in micro block 0
+  param.set_double(1.0);
+  check_skip(0, OB_APP_MIN_COLUMN_ID + 1, sql::WHITE_OP_NU, param, false);
+  check_skip(0, OB_APP_MIN_COLUMN_ID + 1, sql::WHITE_OP_NN, param, true);
+  check_skip(0, OB_APP_MIN_COLUMN_ID + 1, sql::WHITE_OP_NE, param, true);
+  check_skip(1, OB_APP_MIN_COLUMN_ID + 1, sql::WHITE_OP_EQ, param, false);
+  // a different type never skips
+  param.set_int(1000);
+  check_skip(1, OB_APP_MIN_COLUMN_ID + 1, sql::WHITE_OP_EQ, param, false);
+  // comparison with null is never true
+  param.set_null();
+  check_skip(1, OB_APP_MIN_COLUMN_ID, sql::WHITE_OP_EQ, param, true);
+
+  // not indexed column and reused micro block
+  param.set_varchar("shanghai");
+  check_skip(1, OB_APP_MIN_COLUMN_ID + 2, sql::WHITE_OP_EQ, param, false);
+  param.set_int(-1);
+  check_skip(2, OB_APP_MIN_COLUMN_ID, sql::WHITE_OP_EQ, param, false);
+}
+
+TEST_F(TestMicroBlockSkipIndex, test_logic_filter)
+{
+  sql::ObPushdownWhiteFilterNode lt_node(allocator_);
+  sql::ObPushdownWhiteFilterNode gt_node(allocator_);
+  sql::ObPushdownAndFilterNode and_node(allocator_);
+  sql::ObPushdownOrFilterNode or_node(allocator_);
+  lt_node.op_type_ = sql::WHITE_OP_LT;
+  gt_node.op_type_ = sql::WHITE_OP_GT;
+  ASSERT_EQ(OB_SUCCESS, lt_node.col_ids_.init(1));
+  ASSERT_EQ(OB_SUCCESS, lt_node.col_ids_.push_back(OB_APP_MIN_COLUMN_ID));
+  ASSERT_EQ(OB_SUCCESS, gt_node.col_ids_.init(1));
+  ASSERT_EQ(OB_SUCCESS, gt_node.col_ids_.push_back(OB_APP_MIN_COLUMN_ID));
+  sql::ObWhiteFilterExecutor lt_filter(allocator_, lt_node);
+  sql::ObWhiteFilterExecutor gt_filter(allocator_, gt_node);
+  sql::ObAndFilterExecutor and_filter(allocator_, and_node);
+  sql::ObOrFilterExecutor or_filter(allocator_, or_node);
+  sql::ObPushdownFilterExecutor* childs[2] = {&lt_filter, &gt_filter};
+  lt_filter.set_type(sql::WHITE_FILTER_EXECUTOR);
+  gt_filter.set_type(sql::WHITE_FILTER_EXECUTOR);
+  and_filter.set_type(sql::AND_FILTER_EXECUTOR);
+  or_filter.set_type(sql::OR_FILTER_EXECUTOR);
+  and_filter.set_childs(2, childs);
+  or_filter.set_childs(2, childs);
+
+  bool can_skip = false;
+  // c1 < 150 and c1 > 250: micro block 1 only fails the second one
+  lt_filter.param_.set_int(150);
+  gt_filter.param_.set_int(250);
+  ASSERT_EQ(OB_SUCCESS, skip_index_.check_skip(1, and_filter, can_skip));
+  ASSERT_TRUE(can_skip);
+  ASSERT_EQ(OB_SUCCESS, skip_index_.check_skip(1, or_filter, can_skip));
+  ASSERT_FALSE(can_skip);
+  // c1 < 50 or c1 > 250
+  lt_filter.param_.set_int(50);
+  ASSERT_EQ(OB_SUCCESS, skip_index_.check_skip(1, or_filter, can_skip));
+  ASSERT_TRUE(can_skip);
+  ASSERT_EQ(OB_SUCCESS, skip_index_.check_skip(0, or_filter, can_skip));
+  ASSERT_FALSE(can_skip);
+
+  // children are owned by the stack
+  and_filter.set_childs(0, nullptr);
+  or_filter.set_childs(0, nullptr);
+}
+
+TEST_F(TestMicroBlockSkipIndex, test_meta_section_size)
+{
+  ObMacroBlockMetaV2 meta;
+  meta.occupy_size_ = 1000;
+  meta.micro_block_index_offset_ = 600;
+  meta.micro_block_endkey_offset_ = 700;
+  // without skip index, sizes are the ones old observers compute
+  ASSERT_EQ(300, meta.get_endkey_size());
+  ASSERT_EQ(0, meta.get_micro_block_skip_index_size());
+  meta.micro_block_mark_deletion_offset_ = 800;
+  meta.micro_block_delta_offset_ = 850;
+  ASSERT_EQ(100, meta.get_endkey_size());
+  ASSERT_EQ(50, meta.get_micro_block_mark_deletion_size());
+  ASSERT_EQ(150, meta.get_micro_block_delta_size());
+
+  // the skip index is the last section
+  meta.micro_block_skip_index_offset_ = 900;
+  ASSERT_EQ(100, meta.get_micro_block_skip_index_size());
+  ASSERT_EQ(50, meta.get_micro_block_delta_size());
+  meta.micro_block_mark_deletion_offset_ = 0;
+  meta.micro_block_delta_offset_ = 0;
+  ASSERT_EQ(200, meta.get_endkey_size());
+  ASSERT_EQ(0, meta.get_micro_block_delta_size());
+}
+
+}  // end namespace unittest
+}  // end namespace oceanbase
+
+int main(int argc, char** argv)
+{
+  system("rm -rf test_micro_block_skip_index.log");
+  OB_LOGGER.set_file_name("test_micro_block_skip_index.log");
+  oceanbase::common::ObLogger::get_logger().set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,136 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#define private public
+#include "storage/memtable/ob_lock_wait_mgr.h"
+#undef private
+
+namespace oceanbase {
+namespace unittest {
+using namespace common;
+using namespace memtable;
+
+static const uint64_t TENANT_ID = 1001;
+static const uint64_t HOT_ROW_HASH = 0x1234560;
+static const uint64_t COLD_ROW_HASH = 0x7654320;
+
+class TestLockWaitMgrHotspot : public ::testing::Test {
+public:
+  virtual void SetUp()
+  {
+    // too large for the stack
+    mgr_ = new ObLockWaitMgr();
+  }
+  virtual void TearDown()
+  {
+    delete mgr_;
+    mgr_ = NULL;
+  }
+  // %node starts to wait for the lock of row %hash of %tenant_id
+  void wait(ObLockWaitMgr::Node& node, const uint64_t tenant_id, const uint64_t hash)
+  {
+    node.set(NULL, hash, 0, INT64_MAX, combine_id(tenant_id, 3001), 0, "", 0);
+    ASSERT_EQ(0, mgr_->hash_.insert(&node));
+    mgr_->check_hotspot(node, mgr_->inc_row_waiter_cnt(node.hash()));
+  }
+  void wakeup(ObLockWaitMgr::Node& node)
+  {
+    ObLockWaitMgr::Node* deleted = NULL;
+    ASSERT_EQ(0, mgr_->hash_.del(&node, deleted));
+    mgr_->dec_row_waiter_cnt(node.hash());
+  }
+  int64_t get_row_waiter_cnt(const uint64_t hash)
+  {
+    return mgr_->row_waiter_cnt_[(hash >> 1) % ObLockWaitMgr::LOCK_BUCKET_COUNT];
+  }
+
+protected:
+  ObLockWaitMgr* mgr_;
+};
+
+TEST_F(TestLockWaitMgrHotspot, detect)
+{
+  const int64_t WAITER_CNT = ObLockWaitMgr::HOTSPOT_ROW_WAITER_COUNT;
+  ObLockWaitMgr::Node hot_nodes[WAITER_CNT];
+  ObLockWaitMgr::Node cold_nodes[WAITER_CNT];
+  ASSERT_FALSE(mgr_->is_hotspot_tenant(TENANT_ID));
+
+  // requests waiting on different rows do not make a hot row
+  for (int64_t i = 0; i < WAITER_CNT - 1; ++i) {
+    wait(hot_nodes[i], TENANT_ID, HOT_ROW_HASH);
+    wait(cold_nodes[i], TENANT_ID, COLD_ROW_HASH + (i << 8));
+    ASSERT_FALSE(mgr_->is_hotspot_tenant(TENANT_ID));
+  }
+  wait(hot_nodes[WAITER_CNT - 1], TENANT_ID, HOT_ROW_HASH);
+  ASSERT_TRUE(mgr_->is_hotspot_tenant(TENANT_ID));
+  // other tenants are not hot, even sharing the slot
+  ASSERT_FALSE(mgr_->is_hotspot_tenant(TENANT_ID + 1));
+  ASSERT_FALSE(mgr_->is_hotspot_tenant(TENANT_ID + ObLockWaitMgr::HOTSPOT_SLOT_COUNT));
+
+  // the tenant stays hot after the waiters are gone
+  for (int64_t i = 0; i < WAITER_CNT - 1; ++i) {
+    wakeup(hot_nodes[i]);
+    wakeup(cold_nodes[i]);
+  }
+  wakeup(hot_nodes[WAITER_CNT - 1]);
+  ASSERT_TRUE(mgr_->is_hotspot_tenant(TENANT_ID));
+  ASSERT_EQ(0, get_row_waiter_cnt(HOT_ROW_HASH));
+  ASSERT_EQ(0, get_row_waiter_cnt(COLD_ROW_HASH));
+
+  // waiters on a row are counted again once they leave, one less does not make a hot row
+  mgr_->hotspot_slots_[TENANT_ID % ObLockWaitMgr::HOTSPOT_SLOT_COUNT] = 0;
+  for (int64_t i = 0; i < WAITER_CNT - 1; ++i) {
+    wait(hot_nodes[i], TENANT_ID, HOT_ROW_HASH);
+  }
+  ASSERT_EQ(WAITER_CNT - 1, get_row_waiter_cnt(HOT_ROW_HASH));
+  ASSERT_FALSE(mgr_->is_hotspot_tenant(TENANT_ID));
+  for (int64_t i = 0; i < WAITER_CNT - 1; ++i) {
+    wakeup(hot_nodes[i]);
+  }
+}
+
+TEST_F(TestLockWaitMgrHotspot, expire_and_replace)
+{
+  const int64_t WAITER_CNT = ObLockWaitMgr::HOTSPOT_ROW_WAITER_COUNT;
+  const uint64_t OTHER_TENANT_ID = TENANT_ID + ObLockWaitMgr::HOTSPOT_SLOT_COUNT;
+  uint64_t& slot = mgr_->hotspot_slots_[TENANT_ID % ObLockWaitMgr::HOTSPOT_SLOT_COUNT];
+  ObLockWaitMgr::Node nodes[WAITER_CNT];
+
+  // found long ago
+  const int64_t expired_ts = ObClockGenerator::getClock() - ObLockWaitMgr::HOTSPOT_EXPIRE_US - 1000 * 1000;
+  slot = ObLockWaitMgr::make_hotspot_slot(TENANT_ID, expired_ts / ObLockWaitMgr::HOTSPOT_SLOT_TS_UNIT_US);
+  ASSERT_FALSE(mgr_->is_hotspot_tenant(TENANT_ID));
+
+  // a hot row of a tenant sharing the slot takes it over
+  for (int64_t i = 0; i < WAITER_CNT; ++i) {
+    wait(nodes[i], OTHER_TENANT_ID, HOT_ROW_HASH);
+  }
+  ASSERT_TRUE(mgr_->is_hotspot_tenant(OTHER_TENANT_ID));
+  ASSERT_FALSE(mgr_->is_hotspot_tenant(TENANT_ID));
+  ASSERT_EQ(OTHER_TENANT_ID, slot >> ObLockWaitMgr::HOTSPOT_SLOT_TS_BITS);
+  for (int64_t i = 0; i < WAITER_CNT; ++i) {
+    wakeup(nodes[i]);
+  }
+}
+
+}  // namespace unittest
+}  // namespace oceanbase
+
+int main(int argc, char** argv)
+{
+  oceanbase::common::ObLogger& logger = oceanbase::common::ObLogger::get_logger();
+  logger.set_file_name("test_lock_wait_mgr_hotspot.log", true);
+  logger.set_log_level(OB_LOG_LEVEL_INFO);
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,193 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include <vector>
+#define private public
+#include "storage/memtable/ob_replay_row_prefetcher.h"
+#include "storage/memtable/ob_memtable.h"
+#undef private
+#include "lib/container/ob_se_array.h"
+#include "rpc/frame/ob_req_transport.h"
+#include "share/config/ob_server_config.h"
+#include "share/ob_common_rpc_proxy.h"
+#include "share/ob_rs_mgr.h"
+#include "share/ob_srv_rpc_proxy.h"
+#include "share/ob_tenant_mgr.h"
+
+namespace oceanbase {
+namespace unittest {
+using namespace common;
+using namespace memtable;
+
+static const ObPartitionKey PKEY(combine_id(1, 3001), 0, 1);
+
+class TestReplayRowPrefetcher : public ::testing::Test {
+public:
+  static void SetUpTestCase()
+  {
+    ObTenantManager& tm = ObTenantManager::get_instance();
+    ObAddr self;
+    self.set_ip_addr("127.0.0.1", 8086);
+    rpc::frame::ObReqTransport req_transport(NULL, NULL);
+    obrpc::ObSrvRpcProxy rpc_proxy;
+    obrpc::ObCommonRpcProxy common_rpc_proxy;
+    share::ObRsMgr rs_mgr;
+    ASSERT_EQ(OB_SUCCESS,
+        tm.init(self, rpc_proxy, common_rpc_proxy, rs_mgr, &req_transport, &ObServerConfig::get_instance()));
+    ASSERT_EQ(OB_SUCCESS, tm.add_tenant(OB_SYS_TENANT_ID));
+    ASSERT_EQ(OB_SUCCESS, tm.set_tenant_mem_limit(OB_SYS_TENANT_ID, 16LL << 30, 8LL << 30));
+  }
+  virtual void SetUp()
+  {
+    storage::ObITable::TableKey table_key;
+    table_key.table_type_ = storage::ObITable::MEMTABLE;
+    table_key.pkey_ = PKEY;
+    table_key.table_id_ = PKEY.table_id_;
+    table_key.version_ = 1;
+    table_key.trans_version_range_.base_version_ = 0;
+    table_key.trans_version_range_.multi_version_start_ = 0;
+    table_key.trans_version_range_.snapshot_version_ = INT64_MAX - 2;
+    ASSERT_EQ(OB_SUCCESS, memtable_.init(table_key));
+  }
+  virtual void TearDown()
+  {
+    memtable_.destroy();
+  }
+  // %row_cnt keys over %distinct_cnt rowkeys, a rowkey appears several times like rows updated twice
+  void build_keys(const int64_t row_cnt, const int64_t distinct_cnt)
+  {
+    objs_.resize(distinct_cnt);
+    rowkeys_.resize(distinct_cnt);
+    keys_.reset();
+    for (int64_t i = 0; i < distinct_cnt; ++i) {
+      objs_[i].set_int(i);
+      rowkeys_[i].assign(&objs_[i], 1);
+    }
+    for (int64_t i = 0; i < row_cnt; ++i) {
+      ObMemtableKey key;
+      ASSERT_EQ(OB_SUCCESS, key.encode(PKEY.table_id_, &rowkeys_[i % distinct_cnt]));
+      ASSERT_EQ(OB_SUCCESS, keys_.push_back(key));
+    }
+  }
+  bool is_located(const ObMemtableKey& key)
+  {
+    ObMvccRow* value = NULL;
+    ObMemtableKey stored_key;
+    return OB_SUCCESS == memtable_.query_engine_.get(&key, value, &stored_key) && NULL != value;
+  }
+  int64_t located_cnt()
+  {
+    int64_t cnt = 0;
+    for (int64_t i = 0; i < static_cast<int64_t>(rowkeys_.size()); ++i) {
+      if (is_located(keys_.at(i))) {
+        ++cnt;
+      }
+    }
+    return cnt;
+  }
+
+protected:
+  ObMemtable memtable_;
+  std::vector<ObObj> objs_;
+  std::vector<ObStoreRowkey> rowkeys_;
+  ObSEArray<ObMemtableKey, 64> keys_;
+};
+
+TEST_F(TestReplayRowPrefetcher, min_row_cnt)
+{
+  const int64_t ROW_CNT = ObReplayRowPrefetcher::MIN_ROW_CNT - 1;
+  ObReplayRowPrefetcher prefetcher;
+  build_keys(ROW_CNT, ROW_CNT);
+  ASSERT_EQ(OB_NOT_INIT, prefetcher.prefetch(memtable_, keys_));
+
+  // small redo logs are not worth the handoff, replay creates the rows
+  prefetcher.is_inited_ = true;
+  ASSERT_EQ(OB_SUCCESS, prefetcher.prefetch(memtable_, keys_));
+  ASSERT_EQ(0, located_cnt());
+  prefetcher.is_inited_ = false;
+}
+
+TEST_F(TestReplayRowPrefetcher, group)
+{
+  const int64_t ROW_CNT = 1000;
+  const int64_t DISTINCT_CNT = 300;
+  const int64_t GROUP_CNT = 4;
+  build_keys(ROW_CNT, DISTINCT_CNT);
+  ObReplayRowPrefetcher::Batch batch;
+  batch.memtable_ = &memtable_;
+  batch.keys_ = &keys_;
+  batch.group_cnt_ = GROUP_CNT;
+  ObReplayRowPrefetcher::Group group;
+  group.batch_ = &batch;
+  group.idx_ = 1;
+  group.is_claimed_ = false;
+
+  // a group is handled once, by the thread which claims it
+  ObReplayRowPrefetcher prefetcher;
+  ASSERT_TRUE(prefetcher.claim_group_(group));
+  ASSERT_FALSE(prefetcher.claim_group_(group));
+  prefetcher.handle_group_(group);
+  // only the rows of the group are located, so the rows of a rowkey are all located by one thread
+  for (int64_t i = 0; i < DISTINCT_CNT; ++i) {
+    ASSERT_EQ(group.idx_ == static_cast<int64_t>(keys_.at(i).hash() % GROUP_CNT), is_located(keys_.at(i)));
+  }
+}
+
+TEST_F(TestReplayRowPrefetcher, caller_locates_all)
+{
+  const int64_t ROW_CNT = 1000;
+  const int64_t DISTINCT_CNT = 300;
+  // the thread pool is not started, no group can be pushed to a worker
+  ObReplayRowPrefetcher prefetcher;
+  build_keys(ROW_CNT, DISTINCT_CNT);
+  prefetcher.is_inited_ = true;
+  ASSERT_EQ(OB_SUCCESS, prefetcher.prefetch(memtable_, keys_));
+  ASSERT_EQ(DISTINCT_CNT, located_cnt());
+  // located rows are found again
+  ASSERT_EQ(OB_SUCCESS, prefetcher.prefetch(memtable_, keys_));
+  ASSERT_EQ(DISTINCT_CNT, located_cnt());
+  prefetcher.is_inited_ = false;
+}
+
+TEST_F(TestReplayRowPrefetcher, workers)
+{
+  const int64_t ROW_CNT = 4000;
+  const int64_t DISTINCT_CNT = 1000;
+  ObReplayRowPrefetcher& prefetcher = ObReplayRowPrefetcher::get_instance();
+  build_keys(ROW_CNT, DISTINCT_CNT);
+  ASSERT_EQ(OB_SUCCESS, prefetcher.init());
+  // every init of the replay engine inits the prefetcher
+  ASSERT_EQ(OB_SUCCESS, prefetcher.init());
+  ASSERT_EQ(OB_SUCCESS, prefetcher.prefetch(memtable_, keys_));
+  ASSERT_EQ(DISTINCT_CNT, located_cnt());
+
+  // the replay engine is destroyed and inited again
+  prefetcher.destroy();
+  ASSERT_EQ(OB_NOT_INIT, prefetcher.prefetch(memtable_, keys_));
+  ASSERT_EQ(OB_SUCCESS, prefetcher.init());
+  ASSERT_EQ(OB_SUCCESS, prefetcher.prefetch(memtable_, keys_));
+  ASSERT_EQ(DISTINCT_CNT, located_cnt());
+  prefetcher.destroy();
+}
+
+}  // namespace unittest
+}  // namespace oceanbase
+
+int main(int argc, char** argv)
+{
+  oceanbase::common::ObLogger& logger = oceanbase::common::ObLogger::get_logger();
+  logger.set_file_name("test_replay_row_prefetcher.log", true);
+  logger.set_log_level(OB_LOG_LEVEL_INFO);
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -30,6 +30,7 @@ public:
   void test_multi_block_read_small_io(const bool is_reverse_scan, const int64_t limit);
   void test_multi_block_read_big_continue_io(const bool is_reverse_scan, const int64_t limit);
   void test_multi_block_read_big_discrete_io(const bool is_reverse_scan, const int64_t limit);
+  void test_shared_micro_block(const bool is_reverse_scan, const int64_t limit);
   void test_one_case(const ObIArray<int64_t>& seeds, const int64_t hit_mode, const bool is_reverse_scan);
   virtual ~TestSSTableMultiGet();
 };
@@ -391,6 +392,46 @@ void TestSSTableMultiGet::test_multi_block_read_big_discrete_io(const bool is_re
   destroy_query_param();
 }
 
+void TestSSTableMultiGet::test_shared_micro_block(const bool is_reverse_scan, const int64_t limit)
+{
+  int ret = OB_SUCCESS;
+  ObArray<int64_t> seeds;
+  ret = prepare_query_param(is_reverse_scan, limit);
+  ASSERT_EQ(OB_SUCCESS, ret);
+
+  // groups of adjacent rows in one micro block, each followed by a row not exist
+  seeds.reuse();
+  for (int64_t i = 0; i < row_cnt_ && seeds.count() + 6 <= TEST_MULTI_GET_CNT; i += 40) {
+    for (int64_t j = 0; j < 4 && i + j < row_cnt_; ++j) {
+      ret = seeds.push_back(i + j);
+      ASSERT_EQ(OB_SUCCESS, ret);
+    }
+    ret = seeds.push_back(i + row_cnt_);
+    ASSERT_EQ(OB_SUCCESS, ret);
+  }
+  // the same row twice
+  ret = seeds.push_back(1);
+  ASSERT_EQ(OB_SUCCESS, ret);
+
+  // micro blocks read by one io, or by one io each
+  GCONF.multiblock_read_size = 10 * 1024;
+  GCONF.multiblock_read_gap_size = 5 * 1024;
+  destroy_all_cache();
+  test_one_case(seeds, HIT_NONE, is_reverse_scan);
+  GCONF.multiblock_read_gap_size = 0;
+  destroy_all_cache();
+  test_one_case(seeds, HIT_NONE, is_reverse_scan);
+
+  // rows are returned in the order of the rowkeys, not the order of micro blocks
+  std::random_shuffle(seeds.begin(), seeds.end());
+  destroy_all_cache();
+  test_one_case(seeds, HIT_NONE, is_reverse_scan);
+  for (int64_t i = HIT_ALL; i < HIT_MAX; ++i) {
+    test_one_case(seeds, i, is_reverse_scan);
+  }
+  destroy_query_param();
+}
+
 TEST_F(TestSSTableMultiGet, test_border)
 {
   const bool is_reverse_scan = false;
@@ -516,6 +557,16 @@ TEST_F(TestSSTableMultiGet, test_multi_block_read_big_discrete_io_limit_reverse_
   test_multi_block_read_big_discrete_io(true, 1);
 }
 
+TEST_F(TestSSTableMultiGet, test_shared_micro_block)
+{
+  test_shared_micro_block(false, -1);
+}
+
+TEST_F(TestSSTableMultiGet, test_shared_micro_block_reverse_scan)
+{
+  test_shared_micro_block(true, -1);
+}
+
 }  // end namespace unittest
 }  // end namespace oceanbase
 
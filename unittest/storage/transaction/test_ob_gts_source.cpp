@@ -0,0 +1,293 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include "share/ob_errno.h"
+#include "lib/oblog/ob_log.h"
+#include "lib/net/ob_addr.h"
+#include "share/config/ob_server_config.h"
+#define private public
+#include "storage/transaction/ob_gts_source.h"
+#undef private
+#include "storage/transaction/ob_gts_rpc.h"
+#include "storage/transaction/ob_location_adapter.h"
+
+namespace oceanbase {
+using namespace common;
+using namespace transaction;
+namespace unittest {
+
+// counts the gts requests posted
+class MockGtsRequestRpc : public ObIGtsRequestRpc {
+public:
+  MockGtsRequestRpc() : post_cnt_(0)
+  {}
+  int start()
+  {
+    return OB_SUCCESS;
+  }
+  int stop()
+  {
+    return OB_SUCCESS;
+  }
+  int wait()
+  {
+    return OB_SUCCESS;
+  }
+  void destroy()
+  {}
+  int post(const uint64_t tenant_id, const ObAddr& server, const ObGtsRequest& msg)
+  {
+    UNUSEDx(tenant_id, server);
+    ++post_cnt_;
+    last_srr_ = msg.get_srr();
+    return OB_SUCCESS;
+  }
+
+public:
+  int64_t post_cnt_;
+  MonotonicTs last_srr_;
+};
+
+// the gts leader is always %leader_
+class MockLocationAdapter : public ObILocationAdapter {
+public:
+  int init(share::ObIPartitionLocationCache* location_cache, share::schema::ObMultiVersionSchemaService* schema_service)
+  {
+    UNUSEDx(location_cache, schema_service);
+    return OB_SUCCESS;
+  }
+  void destroy()
+  {}
+  int get_strong_leader(const ObPartitionKey& partition, ObAddr& server)
+  {
+    UNUSED(partition);
+    server = leader_;
+    return OB_SUCCESS;
+  }
+  int nonblock_get_strong_leader(const ObPartitionKey& partition, ObAddr& server)
+  {
+    UNUSED(partition);
+    server = leader_;
+    return OB_SUCCESS;
+  }
+  int nonblock_renew(const ObPartitionKey& partition, const int64_t expire_renew_time)
+  {
+    UNUSEDx(partition, expire_renew_time);
+    return OB_SUCCESS;
+  }
+  int nonblock_get(const uint64_t table_id, const int64_t partition_id, share::ObPartitionLocation& location)
+  {
+    UNUSEDx(table_id, partition_id, location);
+    return OB_NOT_SUPPORTED;
+  }
+
+public:
+  ObAddr leader_;
+};
+
+class MockTsCbTask : public ObTsCbTask {
+public:
+  explicit MockTsCbTask(const int64_t request_ts) : request_ts_(request_ts), callback_cnt_(0)
+  {}
+  int get_gts_callback(const MonotonicTs srr, const int64_t ts, const MonotonicTs receive_gts_ts)
+  {
+    UNUSEDx(srr, ts, receive_gts_ts);
+    ++callback_cnt_;
+    return OB_SUCCESS;
+  }
+  int gts_elapse_callback(const MonotonicTs srr, const int64_t ts)
+  {
+    UNUSEDx(srr, ts);
+    ++callback_cnt_;
+    return OB_SUCCESS;
+  }
+  MonotonicTs get_stc() const
+  {
+    return MonotonicTs(request_ts_);
+  }
+  uint64_t hash() const
+  {
+    return 0;
+  }
+  int64_t get_request_ts() const
+  {
+    return request_ts_;
+  }
+  uint64_t get_tenant_id() const
+  {
+    return OB_SYS_TENANT_ID;
+  }
+
+public:
+  int64_t request_ts_;
+  int64_t callback_cnt_;
+};
+
+class TestObGtsSource : public ::testing::Test {
+public:
+  virtual void SetUp()
+  {
+    // the gts leader is another server, gts is requested by rpc
+    server_ = ObAddr(ObAddr::IPV4, "10.0.0.1", 20000);
+    location_adapter_.leader_ = ObAddr(ObAddr::IPV4, "10.0.0.2", 20000);
+    GCONF._enable_gts_request_batching.set_value("True");
+    EXPECT_EQ(OB_SUCCESS, gts_source_.init(OB_SYS_TENANT_ID, server_, &request_rpc_, &location_adapter_, NULL));
+  }
+  virtual void TearDown()
+  {
+    gts_source_.destroy();
+    GCONF._enable_gts_request_batching.set_value("False");
+  }
+
+protected:
+  // a waiter newer than every request sent
+  int get_gts(ObTsCbTask* task = NULL)
+  {
+    int64_t gts = 0;
+    MonotonicTs receive_gts_ts;
+    usleep(10);
+    return gts_source_.get_gts(MonotonicTs::current_time(), task, gts, receive_gts_ts);
+  }
+
+protected:
+  ObAddr server_;
+  MockGtsRequestRpc request_rpc_;
+  MockLocationAdapter location_adapter_;
+  ObGtsSource gts_source_;
+};
+
+TEST_F(TestObGtsSource, one_request_in_flight)
+{
+  TRANS_LOG(INFO, "called", "func", test_info_->name());
+  bool update = false;
+  ASSERT_EQ(OB_EAGAIN, get_gts());
+  ASSERT_EQ(1, request_rpc_.post_cnt_);
+  const MonotonicTs first_srr = request_rpc_.last_srr_;
+
+  // waiters arrived while the request is outstanding do not send
+  for (int64_t i = 0; i < 10; ++i) {
+    ASSERT_EQ(OB_EAGAIN, get_gts());
+  }
+  ASSERT_EQ(1, request_rpc_.post_cnt_);
+  ASSERT_EQ(10, gts_source_.gts_statistics_.deferred_gts_rpc_cnt_);
+  ASSERT_TRUE(gts_source_.has_deferred_query_);
+
+  // the deferred request is sent once the outstanding one returns, and serves all of them
+  ASSERT_EQ(OB_SUCCESS, gts_source_.update_gts(first_srr, ObTimeUtility::current_time(), first_srr, update));
+  ASSERT_TRUE(update);
+  ASSERT_EQ(2, request_rpc_.post_cnt_);
+  ASSERT_FALSE(gts_source_.has_deferred_query_);
+  ASSERT_LT(first_srr.mts_, request_rpc_.last_srr_.mts_);
+
+  // no waiter meanwhile, nothing is sent after the next response
+  const MonotonicTs second_srr = request_rpc_.last_srr_;
+  ASSERT_EQ(OB_SUCCESS, gts_source_.update_gts(second_srr, ObTimeUtility::current_time(), second_srr, update));
+  ASSERT_EQ(2, request_rpc_.post_cnt_);
+}
+
+TEST_F(TestObGtsSource, lost_request)
+{
+  TRANS_LOG(INFO, "called", "func", test_info_->name());
+  ASSERT_EQ(OB_EAGAIN, get_gts());
+  ASSERT_EQ(OB_EAGAIN, get_gts());
+  ASSERT_EQ(1, request_rpc_.post_cnt_);
+  // a request not returned in time is taken as lost, the next waiter sends again
+  usleep(ObGtsSource::MAX_QUERY_DEFER_US + 1000);
+  ASSERT_EQ(OB_EAGAIN, get_gts());
+  ASSERT_EQ(2, request_rpc_.post_cnt_);
+}
+
+TEST_F(TestObGtsSource, resend_on_rpc_timeout)
+{
+  TRANS_LOG(INFO, "called", "func", test_info_->name());
+  ASSERT_EQ(OB_EAGAIN, get_gts());
+  ASSERT_EQ(OB_EAGAIN, get_gts());
+  ASSERT_EQ(1, request_rpc_.post_cnt_);
+  ASSERT_TRUE(gts_source_.has_deferred_query_);
+  // the request is still within the rpc timeout, the deferred request is kept
+  ASSERT_EQ(OB_SUCCESS, gts_source_.refresh_gts_location());
+  ASSERT_EQ(1, request_rpc_.post_cnt_);
+  ASSERT_TRUE(gts_source_.has_deferred_query_);
+  // the rpc timed out, the deferred request is sent without waiting for another waiter
+  usleep(ObGtsSource::MAX_QUERY_DEFER_US + 1000);
+  ASSERT_EQ(OB_SUCCESS, gts_source_.refresh_gts_location());
+  ASSERT_EQ(2, request_rpc_.post_cnt_);
+  ASSERT_FALSE(gts_source_.has_deferred_query_);
+  // the resent request is outstanding, later waiters are deferred to it again
+  ASSERT_EQ(OB_EAGAIN, get_gts());
+  ASSERT_EQ(2, request_rpc_.post_cnt_);
+}
+
+TEST_F(TestObGtsSource, batching_disabled)
+{
+  TRANS_LOG(INFO, "called", "func", test_info_->name());
+  GCONF._enable_gts_request_batching.set_value("False");
+  for (int64_t i = 0; i < 10; ++i) {
+    ASSERT_EQ(OB_EAGAIN, get_gts());
+  }
+  ASSERT_EQ(10, request_rpc_.post_cnt_);
+  ASSERT_EQ(0, gts_source_.gts_statistics_.deferred_gts_rpc_cnt_);
+  ASSERT_FALSE(gts_source_.has_deferred_query_);
+}
+
+TEST_F(TestObGtsSource, wait_histogram)
+{
+  TRANS_LOG(INFO, "called", "func", test_info_->name());
+  ASSERT_EQ(0, ObGtsStatistics::get_wait_hist_bucket_(0));
+  ASSERT_EQ(0, ObGtsStatistics::get_wait_hist_bucket_(99));
+  ASSERT_EQ(1, ObGtsStatistics::get_wait_hist_bucket_(100));
+  ASSERT_EQ(5, ObGtsStatistics::get_wait_hist_bucket_(2000));
+  ASSERT_EQ(ObGtsStatistics::WAIT_HIST_BUCKET_CNT - 1, ObGtsStatistics::get_wait_hist_bucket_(INT64_MAX));
+
+  // queued waiters are counted by the time they waited once served
+  const int64_t TASK_CNT = 4;
+  bool update = false;
+  MockTsCbTask* tasks[TASK_CNT];
+  for (int64_t i = 0; i < TASK_CNT; ++i) {
+    tasks[i] = new MockTsCbTask(ObTimeUtility::current_time() - 3000);
+    ASSERT_EQ(OB_EAGAIN, get_gts(tasks[i]));
+  }
+  const MonotonicTs srr = request_rpc_.last_srr_;
+  ASSERT_EQ(OB_SUCCESS, gts_source_.update_gts(srr, ObTimeUtility::current_time(), srr, update));
+  ASSERT_EQ(OB_SUCCESS, gts_source_.handle_gts_result(OB_SYS_TENANT_ID, 0));
+  int64_t served_cnt = 0;
+  for (int64_t i = 0; i < ObGtsStatistics::WAIT_HIST_BUCKET_CNT; ++i) {
+    // every task waited at least 3ms
+    if (i < ObGtsStatistics::WAIT_HIST_BUCKET_CNT - 1 && ObGtsStatistics::WAIT_HIST_BOUNDS_US[i] <= 2000) {
+      ASSERT_EQ(0, gts_source_.gts_statistics_.get_gts_wait_hist_[i]);
+    }
+    served_cnt += gts_source_.gts_statistics_.get_gts_wait_hist_[i];
+  }
+  ASSERT_EQ(TASK_CNT, served_cnt);
+  for (int64_t i = 0; i < TASK_CNT; ++i) {
+    ASSERT_EQ(1, tasks[i]->callback_cnt_);
+    delete tasks[i];
+  }
+}
+
+}  // namespace unittest
+}  // namespace oceanbase
+
+using namespace oceanbase;
+using namespace oceanbase::common;
+
+int main(int argc, char** argv)
+{
+  int ret = 1;
+  ObLogger& logger = ObLogger::get_logger();
+  logger.set_file_name("test_ob_gts_source.log", true);
+  logger.set_log_level(OB_LOG_LEVEL_INFO);
+  testing::InitGoogleTest(&argc, argv);
+  ret = RUN_ALL_TESTS();
+  return ret;
+}
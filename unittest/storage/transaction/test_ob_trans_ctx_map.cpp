@@ -0,0 +1,187 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include <thread>
+#define private public
+#include "storage/transaction/ob_trans_ctx_mgr.h"
+#include "storage/transaction/ob_trans_factory.h"
+#include "storage/transaction/ob_trans_functor.h"
+#undef private
+#include "lib/oblog/ob_log.h"
+
+namespace oceanbase {
+using namespace common;
+using namespace transaction;
+namespace unittest {
+typedef ObPartitionTransCtxMgr::CtxMapMgr CtxMapMgr;
+
+class CountCtxFunctor {
+public:
+  CountCtxFunctor() : count_(0)
+  {}
+  bool operator()(const ObTransID& trans_id, ObTransCtx* ctx)
+  {
+    UNUSED(trans_id);
+    UNUSED(ctx);
+    ++count_;
+    return true;
+  }
+  int64_t count_;
+};
+
+class TestObTransCtxMap : public ::testing::Test {
+public:
+  static const int64_t THREAD_CNT = 8;
+  static const int64_t OP_CNT = 10000;
+
+  virtual void SetUp()
+  {
+    ctx_map_ = new CtxMap(1 << 10);
+    ASSERT_EQ(OB_SUCCESS, ctx_map_->init(ObModIds::OB_HASH_BUCKET_TRANS_CTX));
+    server_.set_ip_addr("127.0.0.1", 8080);
+  }
+  virtual void TearDown()
+  {
+    ctx_map_->destroy();
+    delete ctx_map_;
+    ctx_map_ = NULL;
+  }
+
+  ObTransID make_trans_id(const int64_t inc)
+  {
+    return ObTransID(server_, inc, 1);
+  }
+  int create_ctx(CtxMapMgr& mgr, const ObTransID& trans_id)
+  {
+    int ret = OB_SUCCESS;
+    ObTransCtx* ctx = NULL;
+    if (OB_ISNULL(ctx = ObTransCtxFactory::alloc(ObTransCtxType::COORDINATOR))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+    } else if (OB_FAIL(mgr.insert_and_get(trans_id, ctx))) {
+      ObTransCtxFactory::release(ctx);
+    } else {
+      mgr.revert(ctx);
+    }
+    return ret;
+  }
+  int64_t count_ctx(CtxMapMgr& mgr)
+  {
+    CountCtxFunctor count_fn;
+    EXPECT_EQ(OB_SUCCESS, mgr.foreach_ctx(count_fn));
+    return count_fn.count_;
+  }
+
+protected:
+  CtxMap* ctx_map_;
+  ObAddr server_;
+};
+
+TEST_F(TestObTransCtxMap, partitions_share_map)
+{
+  const ObPartitionKey pkey1(combine_id(1, 3001), 0, 1);
+  const ObPartitionKey pkey2(combine_id(1, 3002), 0, 1);
+  const int64_t CTX_CNT = 1000;
+  CtxMapMgr mgr1;
+  CtxMapMgr mgr2;
+  ObTransCtx* ctx = NULL;
+  ASSERT_EQ(OB_SUCCESS, mgr1.init(pkey1, ctx_map_));
+  ASSERT_EQ(OB_SUCCESS, mgr2.init(pkey2, ctx_map_));
+
+  for (int64_t i = 0; i < CTX_CNT; ++i) {
+    ASSERT_EQ(OB_SUCCESS, create_ctx(mgr1, make_trans_id(i)));
+  }
+  // the same trans id on another partition is another context
+  ASSERT_EQ(OB_SUCCESS, create_ctx(mgr2, make_trans_id(0)));
+  ASSERT_EQ(OB_ENTRY_EXIST, create_ctx(mgr1, make_trans_id(0)));
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, mgr2.get(make_trans_id(1), ctx));
+
+  // iteration only visits the contexts of its own partition
+  ASSERT_EQ(CTX_CNT + 1, ctx_map_->count());
+  ASSERT_EQ(CTX_CNT, count_ctx(mgr1));
+  ASSERT_EQ(1, count_ctx(mgr2));
+
+  ASSERT_EQ(OB_SUCCESS, mgr1.get(make_trans_id(1), ctx));
+  ASSERT_EQ(make_trans_id(1), ctx->hash_node_->hash_link_.key_.get_trans_id());
+  mgr1.revert(ctx);
+  ASSERT_EQ(OB_SUCCESS, mgr1.del(make_trans_id(1)));
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, mgr1.get(make_trans_id(1), ctx));
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, mgr1.del(make_trans_id(1)));
+  ASSERT_EQ(CTX_CNT - 1, count_ctx(mgr1));
+
+  // remove_if of a partition leaves the contexts of other partitions in the map
+  ObRemoveAllCtxFunctor remove_fn;
+  ASSERT_EQ(OB_SUCCESS, mgr1.remove_if(remove_fn));
+  ASSERT_EQ(0, count_ctx(mgr1));
+  ASSERT_EQ(1, ctx_map_->count());
+  ASSERT_EQ(OB_SUCCESS, mgr2.get(make_trans_id(0), ctx));
+  mgr2.revert(ctx);
+  ASSERT_EQ(OB_SUCCESS, mgr2.remove_if(remove_fn));
+  ASSERT_EQ(0, ctx_map_->count());
+}
+
+TEST_F(TestObTransCtxMap, concurrent_create_get_erase)
+{
+  const ObPartitionKey pkey(combine_id(1, 3001), 0, 1);
+  CtxMapMgr mgr;
+  ASSERT_EQ(OB_SUCCESS, mgr.init(pkey, ctx_map_));
+
+  // every thread creates, gets and erases contexts of its own trans ids on the same partition, and keeps
+  // every other context alive so that the map holds contexts of all threads while they run
+  std::thread threads[THREAD_CNT];
+  for (int64_t i = 0; i < THREAD_CNT; ++i) {
+    threads[i] = std::thread([this, &mgr, i]() {
+      ObTransCtx* ctx = NULL;
+      for (int64_t j = 0; j < OP_CNT; ++j) {
+        const ObTransID trans_id = make_trans_id(i * OP_CNT + j);
+        EXPECT_EQ(OB_SUCCESS, create_ctx(mgr, trans_id));
+        EXPECT_EQ(OB_ENTRY_EXIST, create_ctx(mgr, trans_id));
+        EXPECT_EQ(OB_SUCCESS, mgr.get(trans_id, ctx));
+        EXPECT_EQ(trans_id, ctx->hash_node_->hash_link_.key_.get_trans_id());
+        mgr.revert(ctx);
+        if (0 == j % 2) {
+          EXPECT_EQ(OB_SUCCESS, mgr.del(trans_id));
+          EXPECT_EQ(OB_ENTRY_NOT_EXIST, mgr.get(trans_id, ctx));
+        }
+      }
+    });
+  }
+  for (int64_t i = 0; i < THREAD_CNT; ++i) {
+    threads[i].join();
+  }
+
+  ObTransCtx* ctx = NULL;
+  ASSERT_EQ(THREAD_CNT * OP_CNT / 2, count_ctx(mgr));
+  for (int64_t i = 0; i < THREAD_CNT * OP_CNT; ++i) {
+    if (0 == i % OP_CNT % 2) {
+      ASSERT_EQ(OB_ENTRY_NOT_EXIST, mgr.get(make_trans_id(i), ctx));
+    } else {
+      ASSERT_EQ(OB_SUCCESS, mgr.get(make_trans_id(i), ctx));
+      mgr.revert(ctx);
+    }
+  }
+  ObRemoveAllCtxFunctor remove_fn;
+  ASSERT_EQ(OB_SUCCESS, mgr.remove_if(remove_fn));
+  ASSERT_EQ(0, count_ctx(mgr));
+}
+
+}  // namespace unittest
+}  // namespace oceanbase
+
+int main(int argc, char** argv)
+{
+  oceanbase::common::ObLogger& logger = oceanbase::common::ObLogger::get_logger();
+  logger.set_file_name("test_ob_trans_ctx_map.log", true);
+  logger.set_log_level(OB_LOG_LEVEL_INFO);
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}